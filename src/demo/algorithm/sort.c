@@ -259,6 +259,99 @@ static tb_void_t tb_sort_int_test_perf_heap(tb_size_t n)
     // free
     tb_free(data);
 }
+static tb_void_t tb_sort_int_test_perf_intro(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_array_iterator_init_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_intro_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_intro_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_radix(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_array_iterator_init_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_radix_sort_all(iterator);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_radix_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_vector(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // the debug vector only can hold less than 65536 items
+#ifdef __tb_debug__
+    n = tb_min(n, TB_MAXU16);
+#endif
+
+    // init vector
+    tb_vector_ref_t vector = tb_vector_init(n, tb_element_uint32());
+    tb_assert_and_check_return(vector);
+
+    // make
+    for (i = 0; i < n; i++) tb_vector_insert_tail(vector, tb_u2p(tb_random_range(0, TB_MAXS32)));
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_sort_all(vector, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_sort_vector_uint32_all: %lld ms", time);
+
+    // check
+    tb_size_t prev = 0;
+    tb_for_all (tb_size_t, item, vector)
+    {
+        tb_assert_and_check_break(prev <= item);
+        prev = item;
+    }
+
+    // exit vector
+    tb_vector_exit(vector);
+}
 static tb_void_t tb_sort_int_test_func_heap()
 {
     // init
@@ -475,6 +568,42 @@ static tb_void_t tb_sort_str_test_perf_heap(tb_size_t n)
     for (i = 0; i < n; i++) tb_free(data[i]);
     tb_free(data);
 }
+static tb_void_t tb_sort_str_test_perf_intro(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_char_t** data = (tb_char_t**)tb_nalloc0(n, sizeof(tb_char_t*));
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_array_iterator_init_str(&array_iterator, data, n);
+
+    // make
+    tb_char_t s[256] = {0};
+    for (i = 0; i < n; i++)
+    {
+        tb_long_t r = tb_snprintf(s, 256, "%ld", tb_random_value());
+        s[r] = '\0';
+        data[i] = tb_strdup(s);
+    }
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_intro_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_intro_sort_str_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(tb_strcmp(data[i - 1], data[i]) <= 0);
+
+    // free data
+    for (i = 0; i < n; i++) tb_free(data[i]);
+    tb_free(data);
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -490,13 +619,30 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_perf(1000);
     tb_sort_int_test_perf_heap(1000);
     tb_sort_int_test_perf_quick(1000);
+    tb_sort_int_test_perf_intro(1000);
+    tb_sort_int_test_perf_radix(1000);
     tb_sort_int_test_perf_bubble(1000);
     tb_sort_int_test_perf_insert(1000);
     tb_sort_str_test_perf(1000);
     tb_sort_str_test_perf_heap(1000);
     tb_sort_str_test_perf_quick(1000);
+    tb_sort_str_test_perf_intro(1000);
     tb_sort_str_test_perf_bubble(1000);
     tb_sort_str_test_perf_insert(1000);
 
+    // perf for the large data, .e.g 1000000
+    if (argc > 1)
+    {
+        tb_size_t n = tb_atoi(argv[1]);
+        tb_sort_int_test_perf(n);
+        tb_sort_int_test_perf_heap(n);
+        tb_sort_int_test_perf_intro(n);
+        tb_sort_int_test_perf_radix(n);
+        tb_sort_int_test_perf_vector(n);
+        tb_sort_str_test_perf(n);
+        tb_sort_str_test_perf_heap(n);
+        tb_sort_str_test_perf_intro(n);
+    }
+
     return 0;
 }
@@ -0,0 +1,241 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef __tb_debug__
+#   define tb_flat_hash_map_test_dump(h)            tb_flat_hash_map_dump(h)
+#else
+#   define tb_flat_hash_map_test_dump(h)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_flat_hash_map_test_s2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(8, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert items
+    tb_size_t i = 0;
+    tb_char_t s[256] = {0};
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_flat_hash_map_insert(hash, s, (tb_pointer_t)i);
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 1000);
+
+    // replace items
+    tb_flat_hash_map_insert(hash, "10", (tb_pointer_t)12345);
+    tb_assert((tb_size_t)tb_flat_hash_map_get(hash, "10") == 12345);
+    tb_flat_hash_map_insert(hash, "10", (tb_pointer_t)10);
+
+    // get items
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_assert((tb_size_t)tb_flat_hash_map_get(hash, s) == i);
+    }
+    tb_assert(!tb_flat_hash_map_find(hash, "1000"));
+
+    // remove the odd items
+    for (i = 1; i < 1000; i += 2)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_flat_hash_map_remove(hash, s);
+        tb_assert(!tb_flat_hash_map_find(hash, s));
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 500);
+
+    // walk items
+    tb_size_t count = 0;
+    tb_for_all (tb_flat_hash_map_item_ref_t, item, hash)
+    {
+        tb_assert(!(((tb_size_t)item->data) & 1) && (tb_size_t)tb_atoi((tb_char_t const*)item->name) == (tb_size_t)item->data);
+        tb_used(&item);
+        count++;
+    }
+    tb_assert(count == 500);
+
+    // dump and clear
+    tb_flat_hash_map_clear(hash);
+    tb_flat_hash_map_test_dump(hash);
+    tb_assert(!tb_flat_hash_map_size(hash));
+
+    // exit hash
+    tb_flat_hash_map_exit(hash);
+}
+static tb_bool_t tb_flat_hash_map_test_remove_pred(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    // remove the items which can be divided by 3
+    return !(((tb_size_t)((tb_flat_hash_map_item_ref_t)item)->name) % 3);
+}
+static tb_void_t tb_flat_hash_map_test_i2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_assert_and_check_return(hash);
+
+    // insert and remove items repeatly for making many deleted slots
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (j = 0; j < 16; j++)
+    {
+        for (i = 0; i < 10000; i++) tb_flat_hash_map_insert(hash, (tb_pointer_t)(i + j * 10000), (tb_pointer_t)i);
+        for (i = 0; i < 10000; i += 2) tb_flat_hash_map_remove(hash, (tb_pointer_t)(i + j * 10000));
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 16 * 5000);
+
+    // check items
+    for (j = 0; j < 16; j++)
+    {
+        for (i = 0; i < 10000; i++)
+        {
+            tb_size_t itor = tb_flat_hash_map_find(hash, (tb_pointer_t)(i + j * 10000));
+            tb_assert((i & 1)? itor != tb_iterator_tail(hash) : itor == tb_iterator_tail(hash));
+            tb_used(&itor);
+        }
+    }
+
+    // remove items by the iterator
+    tb_remove_if(hash, tb_flat_hash_map_test_remove_pred, tb_null);
+    tb_for_all (tb_flat_hash_map_item_ref_t, item, hash)
+    {
+        tb_assert(((tb_size_t)item->name) % 3);
+        tb_used(&item);
+    }
+
+    // trace
+    tb_trace_i("i2i: size: %lu, maxn: %lu", tb_flat_hash_map_size(hash), tb_flat_hash_map_maxn(hash));
+
+    // exit hash
+    tb_flat_hash_map_exit(hash);
+}
+static tb_void_t tb_flat_hash_map_test_s2i_perf(tb_size_t count)
+{
+    // init names
+    tb_char_t** names = tb_nalloc_type(count, tb_char_t*);
+    tb_assert_and_check_return(names);
+
+    // make names
+    tb_size_t i = 0;
+    tb_char_t s[256] = {0};
+    for (i = 0; i < count; i++)
+    {
+        tb_snprintf(s, sizeof(s), "/session/%lx/%lu", tb_random_value(), i);
+        names[i] = tb_strdup(s);
+    }
+
+    // init hash
+    tb_hash_map_ref_t       hash_map = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_size());
+    tb_flat_hash_map_ref_t  flat_hash_map = tb_flat_hash_map_init(0, tb_element_str(tb_true), tb_element_size());
+    if (hash_map && flat_hash_map)
+    {
+        // insert items
+        tb_hong_t t1 = tb_mclock();
+        for (i = 0; i < count; i++) tb_hash_map_insert(hash_map, names[i], (tb_pointer_t)i);
+        t1 = tb_mclock() - t1;
+        tb_hong_t t2 = tb_mclock();
+        for (i = 0; i < count; i++) tb_flat_hash_map_insert(flat_hash_map, names[i], (tb_pointer_t)i);
+        t2 = tb_mclock() - t2;
+        tb_trace_i("s2i: insert: %lu items, hash_map: %lld ms, flat_hash_map: %lld ms", count, t1, t2);
+
+        // lookup items
+        __tb_volatile__ tb_size_t sum1 = 0;
+        __tb_volatile__ tb_size_t sum2 = 0;
+        t1 = tb_mclock();
+        for (i = 0; i < count; i++) sum1 += (tb_size_t)tb_hash_map_get(hash_map, names[count - i - 1]);
+        t1 = tb_mclock() - t1;
+        t2 = tb_mclock();
+        for (i = 0; i < count; i++) sum2 += (tb_size_t)tb_flat_hash_map_get(flat_hash_map, names[count - i - 1]);
+        t2 = tb_mclock() - t2;
+        tb_trace_i("s2i: lookup: %lu items, hash_map: %lld ms, flat_hash_map: %lld ms", count, t1, t2);
+        tb_assert(sum1 == sum2);
+    }
+
+    // exit hash
+    if (hash_map) tb_hash_map_exit(hash_map);
+    if (flat_hash_map) tb_flat_hash_map_exit(flat_hash_map);
+
+    // exit names
+    for (i = 0; i < count; i++) tb_free(names[i]);
+    tb_free(names);
+}
+static tb_void_t tb_flat_hash_map_test_i2i_perf(tb_size_t count)
+{
+    // init hash
+    tb_hash_map_ref_t       hash_map = tb_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_flat_hash_map_ref_t  flat_hash_map = tb_flat_hash_map_init(0, tb_element_size(), tb_element_size());
+    if (hash_map && flat_hash_map)
+    {
+        // insert items
+        tb_size_t i = 0;
+        tb_random_reset(tb_true);
+        tb_hong_t t1 = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            tb_size_t name = tb_random_value();
+            tb_hash_map_insert(hash_map, (tb_pointer_t)name, (tb_pointer_t)name);
+        }
+        t1 = tb_mclock() - t1;
+        tb_random_reset(tb_true);
+        tb_hong_t t2 = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            tb_size_t name = tb_random_value();
+            tb_flat_hash_map_insert(flat_hash_map, (tb_pointer_t)name, (tb_pointer_t)name);
+        }
+        t2 = tb_mclock() - t2;
+        tb_trace_i("i2i: insert: %lu items, hash_map: %lld ms, flat_hash_map: %lld ms", count, t1, t2);
+
+        // lookup items
+        __tb_volatile__ tb_size_t sum1 = 0;
+        __tb_volatile__ tb_size_t sum2 = 0;
+        tb_random_reset(tb_true);
+        t1 = tb_mclock();
+        for (i = 0; i < count; i++) sum1 += (tb_size_t)tb_hash_map_get(hash_map, (tb_pointer_t)tb_random_value());
+        t1 = tb_mclock() - t1;
+        tb_random_reset(tb_true);
+        t2 = tb_mclock();
+        for (i = 0; i < count; i++) sum2 += (tb_size_t)tb_flat_hash_map_get(flat_hash_map, (tb_pointer_t)tb_random_value());
+        t2 = tb_mclock() - t2;
+        tb_trace_i("i2i: lookup: %lu items, hash_map: %lld ms, flat_hash_map: %lld ms", count, t1, t2);
+        tb_assert(sum1 == sum2);
+    }
+
+    // exit hash
+    if (hash_map) tb_hash_map_exit(hash_map);
+    if (flat_hash_map) tb_flat_hash_map_exit(flat_hash_map);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_flat_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+#if 1
+    tb_flat_hash_map_test_s2i_func();
+    tb_flat_hash_map_test_i2i_func();
+#endif
+
+#if 1
+    tb_flat_hash_map_test_s2i_perf(100000);
+    tb_flat_hash_map_test_i2i_perf(100000);
+#endif
+
+    // test the performance with the given items count, .e.g 1000000
+    if (argc > 1)
+    {
+        tb_flat_hash_map_test_s2i_perf(tb_atoi(argv[1]));
+        tb_flat_hash_map_test_i2i_perf(tb_atoi(argv[1]));
+    }
+
+    return 0;
+}
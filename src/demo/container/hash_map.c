@@ -584,6 +584,57 @@ static tb_void_t tb_hash_map_test_walk_perf()
     tb_hash_map_exit(hash);
 }
 
+static tb_void_t tb_hash_map_test_grow_perf(tb_size_t count)
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_assert_and_check_return(hash);
+
+    // trace
+    tb_trace_i("grow: count: %lu", count);
+
+    // insert items and report the curve for each step
+    tb_size_t i = 0;
+    tb_size_t step = count / 10;
+    __tb_volatile__ tb_size_t sum = 0;
+    tb_random_reset(tb_true);
+    tb_hong_t t = tb_mclock();
+    tb_hong_t d = t;
+    for (i = 0; i < count; i++)
+    {
+        tb_size_t name = tb_random_value();
+        tb_hash_map_insert(hash, (tb_pointer_t)name, (tb_pointer_t)name);
+        sum += name;
+        if (step && !((i + 1) % step))
+        {
+            tb_hong_t e = tb_mclock();
+            tb_trace_i("grow: insert: %lu items, time: %lld ms, total: %lld ms", i + 1, e - d, e - t);
+            d = e;
+        }
+    }
+
+    // lookup items and report the curve for each step
+    tb_random_reset(tb_true);
+    t = tb_mclock();
+    d = t;
+    for (i = 0; i < count; i++)
+    {
+        sum -= (tb_size_t)tb_hash_map_get(hash, (tb_pointer_t)tb_random_value());
+        if (step && !((i + 1) % step))
+        {
+            tb_hong_t e = tb_mclock();
+            tb_trace_i("grow: lookup: %lu items, time: %lld ms, total: %lld ms", i + 1, e - d, e - t);
+            d = e;
+        }
+    }
+
+    // check
+    tb_assert(!sum && tb_hash_map_size(hash) <= count);
+
+    // exit hash
+    tb_hash_map_exit(hash);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -609,5 +660,8 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
     tb_hash_map_test_walk_perf();
 #endif
 
+    // test the grow curve with the given items count, .e.g 1000000, 10000000
+    if (argc > 1) tb_hash_map_test_grow_perf(tb_atoi(argv[1]));
+
     return 0;
 }
@@ -0,0 +1,374 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the queue maxn
+#define TB_DEMO_QUEUE_MAXN          (1024)
+
+// the batch maxn
+#define TB_DEMO_QUEUE_BATCH_MAXN    (32)
+
+// the exit item
+#define TB_DEMO_QUEUE_EXIT          ((tb_pointer_t)(tb_size_t)-1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the queue kind
+typedef enum __tb_demo_queue_kind_e
+{
+    TB_DEMO_QUEUE_KIND_MPMC     = 0
+,   TB_DEMO_QUEUE_KIND_SPSC     = 1
+,   TB_DEMO_QUEUE_KIND_CIRCLE   = 2
+
+}tb_demo_queue_kind_e;
+
+// the queue bench type
+typedef struct __tb_demo_queue_bench_t
+{
+    // the queue kind
+    tb_size_t                   kind;
+
+    // the batch size
+    tb_size_t                   batch;
+
+    // the items count of each putter
+    tb_size_t                   count;
+
+    // the mpmc queue
+    tb_mpmc_queue_ref_t         mpmc;
+
+    // the spsc queue
+    tb_spsc_queue_ref_t         spsc;
+
+    // the circle queue and lock
+    tb_circle_queue_ref_t       circle;
+    tb_spinlock_t               lock;
+
+    // the sum of all got items
+    tb_atomic_t                 sum;
+
+}tb_demo_queue_bench_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * bench
+ */
+static tb_size_t tb_demo_queue_put(tb_demo_queue_bench_t* bench, tb_cpointer_t const* data, tb_size_t size)
+{
+    tb_size_t n = 0;
+    switch (bench->kind)
+    {
+    case TB_DEMO_QUEUE_KIND_MPMC:
+        if (size == 1) n = tb_mpmc_queue_put_wait(bench->mpmc, data[0], -1) > 0? 1 : 0;
+        else n = tb_mpmc_queue_put_n(bench->mpmc, data, size);
+        break;
+    case TB_DEMO_QUEUE_KIND_SPSC:
+        if (size == 1) n = tb_spsc_queue_put_wait(bench->spsc, data[0], -1) > 0? 1 : 0;
+        else n = tb_spsc_queue_put_n(bench->spsc, data, size);
+        break;
+    case TB_DEMO_QUEUE_KIND_CIRCLE:
+        tb_spinlock_enter(&bench->lock);
+        while (n < size && !tb_circle_queue_full(bench->circle))
+            tb_circle_queue_put(bench->circle, data[n++]);
+        tb_spinlock_leave(&bench->lock);
+        break;
+    default:
+        break;
+    }
+    return n;
+}
+static tb_size_t tb_demo_queue_get(tb_demo_queue_bench_t* bench, tb_pointer_t* data, tb_size_t maxn)
+{
+    tb_size_t n = 0;
+    switch (bench->kind)
+    {
+    case TB_DEMO_QUEUE_KIND_MPMC:
+        if (maxn == 1) n = tb_mpmc_queue_get_wait(bench->mpmc, data, -1) > 0? 1 : 0;
+        else n = tb_mpmc_queue_get_n(bench->mpmc, data, maxn);
+        break;
+    case TB_DEMO_QUEUE_KIND_SPSC:
+        if (maxn == 1) n = tb_spsc_queue_get_wait(bench->spsc, data, -1) > 0? 1 : 0;
+        else n = tb_spsc_queue_get_n(bench->spsc, data, maxn);
+        break;
+    case TB_DEMO_QUEUE_KIND_CIRCLE:
+        tb_spinlock_enter(&bench->lock);
+        while (n < maxn && !tb_circle_queue_null(bench->circle))
+        {
+            data[n++] = tb_circle_queue_get(bench->circle);
+            tb_circle_queue_pop(bench->circle);
+        }
+        tb_spinlock_leave(&bench->lock);
+        break;
+    default:
+        break;
+    }
+    return n;
+}
+static tb_int_t tb_demo_queue_putter(tb_cpointer_t priv)
+{
+    // the bench
+    tb_demo_queue_bench_t* bench = (tb_demo_queue_bench_t*)priv;
+
+    // put items: [1, count]
+    tb_size_t       i = 1;
+    tb_cpointer_t   data[TB_DEMO_QUEUE_BATCH_MAXN];
+    while (i <= bench->count)
+    {
+        // make items
+        tb_size_t n = 0;
+        for (n = 0; n < bench->batch && i + n <= bench->count; n++)
+            data[n] = (tb_cpointer_t)(i + n);
+
+        // put them
+        tb_size_t m = 0;
+        while (m < n)
+        {
+            tb_size_t real = tb_demo_queue_put(bench, data + m, n - m);
+            if (real) m += real;
+            else tb_sched_yield();
+        }
+        i += n;
+    }
+    return 0;
+}
+static tb_int_t tb_demo_queue_getter(tb_cpointer_t priv)
+{
+    // the bench
+    tb_demo_queue_bench_t* bench = (tb_demo_queue_bench_t*)priv;
+
+    // get items until the exit item
+    tb_size_t       sum = 0;
+    tb_bool_t       stop = tb_false;
+    tb_pointer_t    data[TB_DEMO_QUEUE_BATCH_MAXN];
+    while (!stop)
+    {
+        // get items
+        tb_size_t n = tb_demo_queue_get(bench, data, bench->batch);
+        if (!n)
+        {
+            tb_sched_yield();
+            continue;
+        }
+
+        // sum them
+        tb_size_t i = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (data[i] == TB_DEMO_QUEUE_EXIT) stop = tb_true;
+            else sum += (tb_size_t)data[i];
+        }
+    }
+    tb_atomic_fetch_and_add(&bench->sum, sum);
+
+    // pass the exit item to the other getters
+    tb_cpointer_t item = TB_DEMO_QUEUE_EXIT;
+    while (!tb_demo_queue_put(bench, &item, 1)) tb_sched_yield();
+    return 0;
+}
+static tb_void_t tb_demo_queue_bench(tb_char_t const* name, tb_size_t kind, tb_size_t putters, tb_size_t getters, tb_size_t batch, tb_size_t count)
+{
+    // init bench
+    tb_demo_queue_bench_t bench;
+    tb_memset(&bench, 0, sizeof(bench));
+    bench.kind  = kind;
+    bench.batch = batch;
+    bench.count = count;
+    tb_atomic_init(&bench.sum, 0);
+    tb_spinlock_init(&bench.lock);
+    switch (kind)
+    {
+    case TB_DEMO_QUEUE_KIND_MPMC:   bench.mpmc = tb_mpmc_queue_init(TB_DEMO_QUEUE_MAXN); break;
+    case TB_DEMO_QUEUE_KIND_SPSC:   bench.spsc = tb_spsc_queue_init(TB_DEMO_QUEUE_MAXN); break;
+    case TB_DEMO_QUEUE_KIND_CIRCLE: bench.circle = tb_circle_queue_init(TB_DEMO_QUEUE_MAXN, tb_element_ptr(tb_null, tb_null)); break;
+    default: break;
+    }
+
+    // start threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[32] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < getters; i++) threads[i] = tb_thread_init(tb_null, tb_demo_queue_getter, &bench, 0);
+    for (i = 0; i < putters; i++) threads[getters + i] = tb_thread_init(tb_null, tb_demo_queue_putter, &bench, 0);
+
+    // wait putters
+    for (i = 0; i < putters; i++)
+    {
+        tb_thread_wait(threads[getters + i], -1, tb_null);
+        tb_thread_exit(threads[getters + i]);
+    }
+
+    // stop getters, the exit item will be passed to all getters
+    tb_cpointer_t item = TB_DEMO_QUEUE_EXIT;
+    while (!tb_demo_queue_put(&bench, &item, 1)) tb_sched_yield();
+
+    // wait getters
+    for (i = 0; i < getters; i++)
+    {
+        tb_thread_wait(threads[i], -1, tb_null);
+        tb_thread_exit(threads[i]);
+    }
+    time = tb_mclock() - time;
+
+    // check sum
+    tb_size_t sum = (tb_size_t)tb_atomic_get(&bench.sum);
+    tb_size_t expected = putters * (count * (count + 1) / 2);
+
+    // trace
+    tb_trace_i("%s: putters: %lu, getters: %lu, batch: %lu, items: %lu, %lld ms, %lld items/ms, %s"
+        , name, putters, getters, batch, putters * count, time, (tb_hong_t)(putters * count) / tb_max(time, 1), sum == expected? "ok" : "failed");
+
+    // exit queues
+    if (bench.mpmc) tb_mpmc_queue_exit(bench.mpmc);
+    if (bench.spsc) tb_spsc_queue_exit(bench.spsc);
+    if (bench.circle) tb_circle_queue_exit(bench.circle);
+    tb_spinlock_exit(&bench.lock);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_mpmc_queue_test_func()
+{
+    // init queue
+    tb_mpmc_queue_ref_t queue = tb_mpmc_queue_init(10);
+    tb_assert_and_check_return(queue);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // the maxn is aligned to pow2
+        tb_check_break(tb_mpmc_queue_maxn(queue) == 16);
+
+        // put items until full
+        tb_size_t i = 0;
+        for (i = 0; i < 16; i++)
+        {
+            if (!tb_mpmc_queue_put(queue, (tb_cpointer_t)(i + 1))) break;
+        }
+        tb_check_break(i == 16 && !tb_mpmc_queue_put(queue, (tb_cpointer_t)100));
+        tb_check_break(tb_mpmc_queue_size(queue) == 16);
+
+        // get some items
+        tb_pointer_t data[16];
+        tb_check_break(tb_mpmc_queue_get_n(queue, data, 5) == 5);
+        tb_check_break(data[0] == (tb_pointer_t)1 && data[4] == (tb_pointer_t)5);
+
+        // put more items, only 5 cells are free
+        tb_cpointer_t more[6] = {(tb_cpointer_t)17, (tb_cpointer_t)18, (tb_cpointer_t)19, (tb_cpointer_t)20, (tb_cpointer_t)21, (tb_cpointer_t)22};
+        tb_check_break(tb_mpmc_queue_put_n(queue, more, 6) == 5);
+
+        // get all items
+        tb_check_break(tb_mpmc_queue_get_n(queue, data, 16) == 16);
+        tb_check_break(data[0] == (tb_pointer_t)6 && data[15] == (tb_pointer_t)21);
+        tb_check_break(!tb_mpmc_queue_size(queue));
+
+        // wait timeout
+        tb_pointer_t item = tb_null;
+        tb_check_break(tb_mpmc_queue_get_wait(queue, &item, 10) == 0);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_i("mpmc_queue: func: %s", ok? "ok" : "failed");
+
+    // exit queue
+    tb_mpmc_queue_exit(queue);
+}
+
+static tb_void_t tb_demo_spsc_queue_test_func()
+{
+    // init queue
+    tb_spsc_queue_ref_t queue = tb_spsc_queue_init(10);
+    tb_assert_and_check_return(queue);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // the maxn is aligned to pow2
+        tb_check_break(tb_spsc_queue_maxn(queue) == 16);
+
+        // put items until full
+        tb_size_t i = 0;
+        for (i = 0; i < 16; i++)
+        {
+            if (!tb_spsc_queue_put(queue, (tb_cpointer_t)(i + 1))) break;
+        }
+        tb_check_break(i == 16 && !tb_spsc_queue_put(queue, (tb_cpointer_t)100));
+        tb_check_break(tb_spsc_queue_size(queue) == 16);
+
+        // get some items
+        tb_pointer_t data[16];
+        tb_check_break(tb_spsc_queue_get_n(queue, data, 5) == 5);
+        tb_check_break(data[0] == (tb_pointer_t)1 && data[4] == (tb_pointer_t)5);
+
+        // put more items, only 5 cells are free
+        tb_cpointer_t more[6] = {(tb_cpointer_t)17, (tb_cpointer_t)18, (tb_cpointer_t)19, (tb_cpointer_t)20, (tb_cpointer_t)21, (tb_cpointer_t)22};
+        tb_check_break(tb_spsc_queue_put_n(queue, more, 6) == 5);
+
+        // get all items
+        tb_check_break(tb_spsc_queue_get_n(queue, data, 16) == 16);
+        tb_check_break(data[0] == (tb_pointer_t)6 && data[15] == (tb_pointer_t)21);
+        tb_check_break(!tb_spsc_queue_size(queue));
+
+        // wait timeout
+        tb_pointer_t item = tb_null;
+        tb_check_break(tb_spsc_queue_get_wait(queue, &item, 10) == 0);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_i("spsc_queue: func: %s", ok? "ok" : "failed");
+
+    // exit queue
+    tb_spsc_queue_exit(queue);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_mpmc_queue_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the items count of each putter
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 1000000;
+
+#if 1
+    tb_demo_mpmc_queue_test_func();
+    tb_demo_spsc_queue_test_func();
+#endif
+
+#if 1
+    // 1 putter => 1 getter
+    tb_demo_queue_bench("circle", TB_DEMO_QUEUE_KIND_CIRCLE, 1, 1, 1, count);
+    tb_demo_queue_bench("mpmc  ", TB_DEMO_QUEUE_KIND_MPMC, 1, 1, 1, count);
+    tb_demo_queue_bench("spsc  ", TB_DEMO_QUEUE_KIND_SPSC, 1, 1, 1, count);
+
+    // 1 putter => 1 getter, batch
+    tb_demo_queue_bench("circle", TB_DEMO_QUEUE_KIND_CIRCLE, 1, 1, TB_DEMO_QUEUE_BATCH_MAXN, count);
+    tb_demo_queue_bench("mpmc  ", TB_DEMO_QUEUE_KIND_MPMC, 1, 1, TB_DEMO_QUEUE_BATCH_MAXN, count);
+    tb_demo_queue_bench("spsc  ", TB_DEMO_QUEUE_KIND_SPSC, 1, 1, TB_DEMO_QUEUE_BATCH_MAXN, count);
+
+    // 4 putters => 4 getters
+    tb_demo_queue_bench("circle", TB_DEMO_QUEUE_KIND_CIRCLE, 4, 4, 1, count);
+    tb_demo_queue_bench("mpmc  ", TB_DEMO_QUEUE_KIND_MPMC, 4, 4, 1, count);
+
+    // 4 putters => 4 getters, batch
+    tb_demo_queue_bench("circle", TB_DEMO_QUEUE_KIND_CIRCLE, 4, 4, TB_DEMO_QUEUE_BATCH_MAXN, count);
+    tb_demo_queue_bench("mpmc  ", TB_DEMO_QUEUE_KIND_MPMC, 4, 4, TB_DEMO_QUEUE_BATCH_MAXN, count);
+#endif
+
+    return 0;
+}
@@ -34,15 +34,7 @@ static tb_void_t tb_demo_coroutine_echo(tb_cpointer_t priv)
         tb_trace_i("connecting(%p): %{ipaddr} ..", sock, &addr);
 
         // connect socket
-        tb_long_t ok;
-        while (!(ok = tb_socket_connect(sock, &addr)))
-        {
-            // wait it
-            if (tb_socket_wait(sock, TB_SOCKET_EVENT_CONN, TB_DEMO_TIMEOUT) <= 0) break;
-        }
-
-        // connect ok?
-        tb_check_break(ok > 0);
+        tb_check_break(tb_socket_wconnect(sock, &addr, TB_DEMO_TIMEOUT) > 0);
 
         // loop
         tb_byte_t data[8192] = {0};
@@ -87,8 +79,11 @@ tb_int_t tb_demo_coroutine_echo_client_main(tb_int_t argc, tb_char_t** argv)
     // the request count
     tb_size_t reqt_count = argc > 2? tb_atoi(argv[2]) : 10000;
 
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    // the threads count, uses the cpu count if be zero
+    tb_size_t threads = argc > 3? tb_atoi(argv[3]) : 0;
+
+    // init the multi-threaded scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_mt(threads);
     if (scheduler)
     {
         // start echo
@@ -100,13 +95,13 @@ tb_int_t tb_demo_coroutine_echo_client_main(tb_int_t argc, tb_char_t** argv)
         tb_hong_t startime = tb_mclock();
 
         // run scheduler
-        tb_co_scheduler_loop(scheduler, tb_true);
+        tb_co_scheduler_loop(scheduler, tb_false);
 
         // compute the spent time
         tb_hong_t spent = tb_mclock() - startime;
 
         // trace
-        tb_trace_i("echo: clients: %lu, request: %lu, spent: %lld ms", count, reqt_count, spent);
+        tb_trace_i("echo: clients: %lu, request: %lu, threads: %lu, spent: %lld ms", count, reqt_count, threads, spent);
 
         // exit scheduler
         tb_co_scheduler_exit(scheduler);
@@ -70,14 +70,10 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
 
         // accept client sockets
         tb_socket_ref_t client = tb_null;
-        while (1)
+        while ((client = tb_socket_waccept(sock, tb_null, TB_DEMO_TIMEOUT)))
         {
-            // accept and start client connection
-            if ((client = tb_socket_accept(sock, tb_null)))
-            {
-                if (!tb_coroutine_start(tb_null, tb_demo_coroutine_client, client, 0)) break;
-            }
-            else if (tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, TB_DEMO_TIMEOUT) < 0) break;
+            // start client connection
+            if (!tb_coroutine_start(tb_null, tb_demo_coroutine_client, client, 0)) break;
         }
 
     } while (0);
@@ -92,15 +88,18 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
  */
 tb_int_t tb_demo_coroutine_echo_server_main(tb_int_t argc, tb_char_t** argv)
 {
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    // the threads count, uses the cpu count if be zero
+    tb_size_t threads = argc > 1? tb_atoi(argv[1]) : 0;
+
+    // init the multi-threaded scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_mt(threads);
     if (scheduler)
     {
         // start listening
         tb_coroutine_start(scheduler, tb_demo_coroutine_listen, tb_null, 0);
 
         // run scheduler
-        tb_co_scheduler_loop(scheduler, tb_true);
+        tb_co_scheduler_loop(scheduler, tb_false);
 
         // exit scheduler
         tb_co_scheduler_exit(scheduler);
@@ -57,6 +57,11 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(xml_reader)
 ,   TB_DEMO_MAIN_ITEM(xml_writer)
 ,   TB_DEMO_MAIN_ITEM(xml_document)
+#endif
+
+    // json
+#ifdef TB_CONFIG_MODULE_HAVE_JSON
+,   TB_DEMO_MAIN_ITEM(json_reader)
 #endif
 
     // regex
@@ -107,6 +112,7 @@ static tb_demo_t g_demo[] =
 #ifdef TB_CONFIG_MODULE_HAVE_OBJECT
 ,   TB_DEMO_MAIN_ITEM(object_jcat)
 ,   TB_DEMO_MAIN_ITEM(object_json)
+,   TB_DEMO_MAIN_ITEM(object_json_bench)
 ,   TB_DEMO_MAIN_ITEM(object_bin)
 ,   TB_DEMO_MAIN_ITEM(object_xml)
 ,   TB_DEMO_MAIN_ITEM(object_bplist)
@@ -135,12 +141,14 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_default_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_memops)
 ,   TB_DEMO_MAIN_ITEM(memory_buffer)
+,   TB_DEMO_MAIN_ITEM(memory_iobuf)
 ,   TB_DEMO_MAIN_ITEM(memory_queue_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_static_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_impl_static_fixed_pool)
 
     // network
 ,   TB_DEMO_MAIN_ITEM(network_dns)
+,   TB_DEMO_MAIN_ITEM(network_dns_resolver)
 ,   TB_DEMO_MAIN_ITEM(network_url)
 ,   TB_DEMO_MAIN_ITEM(network_ipv4)
 ,   TB_DEMO_MAIN_ITEM(network_ipv6)
@@ -151,6 +159,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(network_ipaddr)
 ,   TB_DEMO_MAIN_ITEM(network_hwaddr)
 ,   TB_DEMO_MAIN_ITEM(network_http)
+,   TB_DEMO_MAIN_ITEM(network_http_pool)
 ,   TB_DEMO_MAIN_ITEM(network_whois)
 ,   TB_DEMO_MAIN_ITEM(network_cookies)
 ,   TB_DEMO_MAIN_ITEM(network_impl_date)
@@ -167,6 +176,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(platform_process)
 ,   TB_DEMO_MAIN_ITEM(platform_ifaddrs)
 ,   TB_DEMO_MAIN_ITEM(platform_filelock)
+,   TB_DEMO_MAIN_ITEM(platform_filemap)
 ,   TB_DEMO_MAIN_ITEM(platform_addrinfo)
 ,   TB_DEMO_MAIN_ITEM(platform_hostname)
 ,   TB_DEMO_MAIN_ITEM(platform_backtrace)
@@ -201,9 +211,11 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_flat_hash_map)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
+,   TB_DEMO_MAIN_ITEM(container_mpmc_queue)
 ,   TB_DEMO_MAIN_ITEM(container_list)
 ,   TB_DEMO_MAIN_ITEM(container_list_entry)
 ,   TB_DEMO_MAIN_ITEM(container_single_list)
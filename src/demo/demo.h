@@ -50,6 +50,9 @@ TB_DEMO_MAIN_DECL(xml_reader);
 TB_DEMO_MAIN_DECL(xml_writer);
 TB_DEMO_MAIN_DECL(xml_document);
 
+// json
+TB_DEMO_MAIN_DECL(json_reader);
+
 // libc
 TB_DEMO_MAIN_DECL(libc_time);
 TB_DEMO_MAIN_DECL(libc_wchar);
@@ -97,6 +100,7 @@ TB_DEMO_MAIN_DECL(other_charset);
 // object
 TB_DEMO_MAIN_DECL(object_jcat);
 TB_DEMO_MAIN_DECL(object_json);
+TB_DEMO_MAIN_DECL(object_json_bench);
 TB_DEMO_MAIN_DECL(object_bin);
 TB_DEMO_MAIN_DECL(object_xml);
 TB_DEMO_MAIN_DECL(object_xplist);
@@ -131,12 +135,14 @@ TB_DEMO_MAIN_DECL(memory_small_allocator);
 TB_DEMO_MAIN_DECL(memory_default_allocator);
 TB_DEMO_MAIN_DECL(memory_memops);
 TB_DEMO_MAIN_DECL(memory_buffer);
+TB_DEMO_MAIN_DECL(memory_iobuf);
 TB_DEMO_MAIN_DECL(memory_queue_buffer);
 TB_DEMO_MAIN_DECL(memory_static_buffer);
 TB_DEMO_MAIN_DECL(memory_impl_static_fixed_pool);
 
 // network
 TB_DEMO_MAIN_DECL(network_dns);
+TB_DEMO_MAIN_DECL(network_dns_resolver);
 TB_DEMO_MAIN_DECL(network_url);
 TB_DEMO_MAIN_DECL(network_ipv4);
 TB_DEMO_MAIN_DECL(network_ipv6);
@@ -147,6 +153,7 @@ TB_DEMO_MAIN_DECL(network_ping);
 TB_DEMO_MAIN_DECL(network_ipaddr);
 TB_DEMO_MAIN_DECL(network_hwaddr);
 TB_DEMO_MAIN_DECL(network_http);
+TB_DEMO_MAIN_DECL(network_http_pool);
 TB_DEMO_MAIN_DECL(network_whois);
 TB_DEMO_MAIN_DECL(network_cookies);
 TB_DEMO_MAIN_DECL(network_impl_date);
@@ -167,6 +174,7 @@ TB_DEMO_MAIN_DECL(platform_stdfile);
 TB_DEMO_MAIN_DECL(platform_process);
 TB_DEMO_MAIN_DECL(platform_ifaddrs);
 TB_DEMO_MAIN_DECL(platform_filelock);
+TB_DEMO_MAIN_DECL(platform_filemap);
 TB_DEMO_MAIN_DECL(platform_addrinfo);
 TB_DEMO_MAIN_DECL(platform_hostname);
 TB_DEMO_MAIN_DECL(platform_pipe_pair);
@@ -193,9 +201,11 @@ TB_DEMO_MAIN_DECL(container_heap);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_flat_hash_map);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
+TB_DEMO_MAIN_DECL(container_mpmc_queue);
 TB_DEMO_MAIN_DECL(container_list);
 TB_DEMO_MAIN_DECL(container_list_entry);
 TB_DEMO_MAIN_DECL(container_single_list);
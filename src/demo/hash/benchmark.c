@@ -49,6 +49,17 @@ static tb_uint32_t tb_demo_blizzard_make(tb_byte_t const* data, tb_size_t size,
 {
     return (tb_uint32_t)tb_blizzard_make(data, size, seed);
 }
+static tb_uint32_t tb_demo_wyhash_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    return (tb_uint32_t)tb_wyhash_make(data, size, seed);
+}
+static tb_uint32_t tb_demo_wyhash128_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // uses the second hash
+    tb_uint64_t hash[2];
+    tb_wyhash_make128(data, size, seed, hash);
+    return (tb_uint32_t)hash[1];
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
@@ -64,9 +75,12 @@ static tb_demo_hash32_entry_t g_hash32_entries[] =
 ,   { "adler32 ",   tb_adler32_make         }
 ,   { "crc32   ",   tb_crc32_make           }
 ,   { "crc32-le",   tb_crc32_le_make        }
+,   { "crc32c  ",   tb_crc32c_make          }
 ,   { "bkdr    ",   tb_demo_bkdr_make       }
 ,   { "murmur  ",   tb_demo_murmur_make     }
 ,   { "blizzard",   tb_demo_blizzard_make   }
+,   { "wyhash  ",   tb_demo_wyhash_make     }
+,   { "wyhash2 ",   tb_demo_wyhash128_make  }
 ,   { tb_null,      tb_null                 }
 };
 
@@ -124,6 +138,45 @@ static tb_void_t tb_demo_hash32_test()
     // exit data
     tb_free(data);
 }
+static tb_void_t tb_demo_hash32_dist()
+{
+    // init buckets
+    tb_size_t       count = 65536;
+    tb_uint32_t*    buckets = tb_nalloc0_type(count, tb_uint32_t);
+    tb_assert_and_check_return(buckets);
+
+    // hash the url keys into the buckets, the empty buckets should be about count / e
+    tb_demo_hash32_entry_ref_t entry = g_hash32_entries;
+    for (; entry && entry->name; entry++)
+    {
+        // hash them
+        tb_size_t i = 0;
+        tb_char_t key[256];
+        tb_memset(buckets, 0, count * sizeof(tb_uint32_t));
+        for (i = 0; i < count; i++)
+        {
+            tb_long_t size = tb_snprintf(key, sizeof(key), "http://www.tboox.org/%lu/index.html?id=%lu", i & 0xff, i >> 8);
+            buckets[entry->hash((tb_byte_t const*)key, size, 0) & (count - 1)]++;
+        }
+
+        // compute the empty buckets, the maximum bucket size and chi-square
+        tb_size_t   empty = 0;
+        tb_size_t   maxn = 0;
+        tb_hize_t   chi2 = 0;
+        for (i = 0; i < count; i++)
+        {
+            if (!buckets[i]) empty++;
+            if (buckets[i] > maxn) maxn = buckets[i];
+            chi2 += (tb_hize_t)(((tb_long_t)buckets[i] - 1) * ((tb_long_t)buckets[i] - 1));
+        }
+
+        // trace, chi2 / n should be about 1.000
+        tb_trace_i("[hash(url)]: %s: empty: %lu (%lu), max: %lu, chi2 / n: %llu / 1000", entry->name, empty, (count * 368) / 1000, maxn, (chi2 * 1000) / count);
+    }
+
+    // exit buckets
+    tb_free(buckets);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -131,5 +184,6 @@ static tb_void_t tb_demo_hash32_test()
 tb_int_t tb_demo_hash_benchmark_main(tb_int_t argc, tb_char_t** argv)
 {
     tb_demo_hash32_test();
+    tb_demo_hash32_dist();
     return 0;
 }
@@ -3,6 +3,37 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the known-answer vectors
+static struct
+{
+    tb_size_t           mode;
+    tb_char_t const*    data;
+    tb_size_t           repeat;
+    tb_char_t const*    sha;
+
+}g_sha_vectors[] =
+{
+    { TB_SHA_MODE_SHA1_160, "",         1,          "da39a3ee5e6b4b0d3255bfef95601890afd80709"                          }
+,   { TB_SHA_MODE_SHA1_160, "abc",      1,          "a9993e364706816aba3e25717850c26c9cd0d89d"                          }
+,   { TB_SHA_MODE_SHA1_160, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, "84983e441c3bd26ebaae4aa1f95129e5e54670f1" }
+,   { TB_SHA_MODE_SHA1_160, "a",        1000000,    "34aa973cd4c4daa4f61eeb2bdbad27316534016f"                          }
+,   { TB_SHA_MODE_SHA2_224, "",         1,          "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f"          }
+,   { TB_SHA_MODE_SHA2_224, "abc",      1,          "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"          }
+,   { TB_SHA_MODE_SHA2_224, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525" }
+,   { TB_SHA_MODE_SHA2_224, "a",        1000000,    "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67"          }
+,   { TB_SHA_MODE_SHA2_256, "",         1,          "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"  }
+,   { TB_SHA_MODE_SHA2_256, "abc",      1,          "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"  }
+,   { TB_SHA_MODE_SHA2_256, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" }
+,   { TB_SHA_MODE_SHA2_256, "a",        1000000,    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"  }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
 static tb_void_t tb_test_sha(tb_size_t mode, tb_char_t const* data)
 {
     tb_byte_t ob[32];
@@ -14,15 +45,137 @@ static tb_void_t tb_test_sha(tb_size_t mode, tb_char_t const* data)
     for (i = 0; i < on; ++i) tb_snprintf(sha + (i << 1), 3, "%02X", ob[i]);
     tb_printf("[sha]: %d = %s\n", mode, sha);
 }
+static tb_void_t tb_test_sha_vectors()
+{
+    tb_size_t i = 0;
+    tb_size_t errors = 0;
+    for (i = 0; i < tb_arrayn(g_sha_vectors); i++)
+    {
+        // make sha
+        tb_sha_t    sha;
+        tb_size_t   size = tb_strlen(g_sha_vectors[i].data);
+        tb_size_t   repeat = g_sha_vectors[i].repeat;
+        tb_sha_init(&sha, g_sha_vectors[i].mode);
+        while (repeat--) tb_sha_spak(&sha, (tb_byte_t const*)g_sha_vectors[i].data, size);
+
+        // check it
+        tb_size_t   j = 0;
+        tb_byte_t   ob[32];
+        tb_char_t   hex[65] = {0};
+        tb_sha_exit(&sha, ob, 32);
+        for (j = 0; j < (g_sha_vectors[i].mode >> 3); j++) tb_snprintf(hex + (j << 1), 3, "%02x", ob[j]);
+        if (tb_strcmp(hex, g_sha_vectors[i].sha))
+        {
+            tb_trace_e("[sha]: %lu: %s != %s", g_sha_vectors[i].mode, hex, g_sha_vectors[i].sha);
+            errors++;
+        }
+    }
+    tb_trace_i("[sha]: vectors: %lu, errors: %lu", tb_arrayn(g_sha_vectors), errors);
+}
+static tb_void_t tb_test_sha_multi(tb_size_t mode, tb_size_t size)
+{
+    // init messages
+    tb_size_t           i = 0;
+    tb_size_t           count = 4096;
+    tb_byte_t*          data = tb_malloc_bytes(count * size + 1);
+    tb_byte_t*          digests = tb_malloc_bytes(count * 64);
+    tb_byte_t const**   ibs = tb_nalloc_type(count, tb_byte_t const*);
+    tb_byte_t**         obs = tb_nalloc_type(count, tb_byte_t*);
+    tb_size_t*          ins = tb_nalloc_type(count, tb_size_t);
+    if (data && digests && ibs && obs && ins)
+    {
+        // make messages with the different sizes
+        for (i = 0; i < count * size; i++) data[i] = (tb_byte_t)tb_random_range(0, 0xff);
+        for (i = 0; i < count; i++)
+        {
+            ibs[i] = data + i * size;
+            ins[i] = size - (i & 7);
+            obs[i] = digests + (i << 6);
+        }
+
+        // make them one by one
+        tb_size_t   n = 100;
+        tb_hong_t   t = tb_mclock();
+        while (n--)
+        {
+            for (i = 0; i < count; i++) tb_sha_make(mode, ibs[i], ins[i], obs[i] + 32, 32);
+        }
+        tb_hong_t   t1 = tb_mclock() - t;
+
+        // make them in parallel
+        n = 100;
+        t = tb_mclock();
+        while (n--) tb_sha_make_multi(mode, ibs, ins, obs, count);
+        tb_hong_t   t2 = tb_mclock() - t;
+
+        // check them
+        tb_size_t errors = 0;
+        for (i = 0; i < count; i++)
+        {
+            if (tb_memcmp(obs[i], obs[i] + 32, mode >> 3)) errors++;
+        }
+
+        // trace
+        tb_trace_i("[sha]: %lu: %lu x %lu bytes: one by one: %lld ms, multi: %lld ms, errors: %lu", mode, count, size, t1, t2, errors);
+    }
+
+    // exit messages
+    if (data) tb_free(data);
+    if (digests) tb_free(digests);
+    if (ibs) tb_free(ibs);
+    if (obs) tb_free(obs);
+    if (ins) tb_free(ins);
+}
+static tb_void_t tb_test_sha_perf(tb_size_t mode)
+{
+    // init data
+    tb_size_t   size = 1024 * 1024;
+    tb_byte_t*  data = tb_malloc_bytes(size);
+    tb_assert_and_check_return(data);
+
+    // make data
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) data[i] = (tb_byte_t)tb_random_range(0, 0xff);
+
+    // make sha (256M)
+    tb_byte_t   ob[32];
+    tb_size_t   n = 256;
+    tb_hong_t   t = tb_mclock();
+    while (n--) tb_sha_make(mode, data, size, ob, 32);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("[sha]: %lu: 256M: %lld ms", mode, t);
+
+    // exit data
+    tb_free(data);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_hash_sha_main(tb_int_t argc, tb_char_t** argv)
 {
-    tb_test_sha(TB_SHA_MODE_SHA1_160, argv[1]);
-    tb_test_sha(TB_SHA_MODE_SHA2_224, argv[1]);
-    tb_test_sha(TB_SHA_MODE_SHA2_256, argv[1]);
+    // make sha of the given string
+    if (argc > 1 && argv[1])
+    {
+        tb_test_sha(TB_SHA_MODE_SHA1_160, argv[1]);
+        tb_test_sha(TB_SHA_MODE_SHA2_224, argv[1]);
+        tb_test_sha(TB_SHA_MODE_SHA2_256, argv[1]);
+        return 0;
+    }
+
+    // check the known-answer vectors
+    tb_test_sha_vectors();
+
+    // check and benchmark the multi-buffer sha
+    tb_test_sha_multi(TB_SHA_MODE_SHA1_160, 64);
+    tb_test_sha_multi(TB_SHA_MODE_SHA1_160, 1024);
+    tb_test_sha_multi(TB_SHA_MODE_SHA2_256, 64);
+    tb_test_sha_multi(TB_SHA_MODE_SHA2_256, 1024);
 
+    // benchmark the single sha
+    tb_test_sha_perf(TB_SHA_MODE_SHA1_160);
+    tb_test_sha_perf(TB_SHA_MODE_SHA2_256);
     return 0;
 }
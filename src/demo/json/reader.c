@@ -0,0 +1,96 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_char_t const* tb_demo_json_reader_text(tb_char_t const* data, tb_size_t size, tb_char_t* text, tb_size_t maxn)
+{
+    /* the data slice is not terminated, so we copy it to the terminated buffer
+     *
+     * we do not use tb_strlcpy() because it will find the end of the source string in the debug mode
+     */
+    tb_size_t n = tb_min(size, maxn - 1);
+    if (data && n) tb_memcpy(text, data, n);
+    text[n] = '\0';
+    return text;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_json_reader_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // goto
+            tb_bool_t ok = tb_true;
+            if (argv[2]) ok = tb_json_reader_goto(reader, argv[2]);
+
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            tb_size_t level = tb_json_reader_level(reader);
+            while (ok && (event = tb_json_reader_next(reader)))
+            {
+                // get data
+                tb_size_t           size = 0;
+                tb_char_t const*    data = tb_json_reader_data(reader, &size);
+                tb_char_t           text[256];
+
+                // the indent
+                tb_size_t t = tb_json_reader_level(reader);
+                if (event == TB_JSON_READER_EVENT_OBJECT_BEG || event == TB_JSON_READER_EVENT_ARRAY_BEG) t--;
+                while (t--) tb_printf("\t");
+
+                // trace it
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_OBJECT_BEG:
+                    tb_printf("{\n");
+                    break;
+                case TB_JSON_READER_EVENT_OBJECT_END:
+                    tb_printf("}\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_BEG:
+                    tb_printf("[\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_END:
+                    tb_printf("]\n");
+                    break;
+                case TB_JSON_READER_EVENT_KEY:
+                    tb_printf("key: %s\n", tb_demo_json_reader_text(data, size, text, sizeof(text)));
+                    break;
+                case TB_JSON_READER_EVENT_STRING:
+                    tb_printf("string: %s\n", tb_demo_json_reader_text(data, size, text, sizeof(text)));
+                    break;
+                case TB_JSON_READER_EVENT_NUMBER:
+                    tb_printf("number: %s, integer: %lld\n", tb_demo_json_reader_text(data, size, text, sizeof(text)), tb_json_reader_integer(reader));
+                    break;
+                case TB_JSON_READER_EVENT_BOOLEAN:
+                    tb_printf("boolean: %s\n", tb_json_reader_boolean(reader)? "true" : "false");
+                    break;
+                case TB_JSON_READER_EVENT_NULL:
+                    tb_printf("null\n");
+                    break;
+                default:
+                    break;
+                }
+
+                // only walk the value of the given path
+                if (argv[2] && tb_json_reader_level(reader) == level) break;
+            }
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+
+    return 0;
+}
@@ -3,9 +3,139 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread count
+#define TB_DEMO_THREAD_MAXN         (8)
+
+// the data count of each thread
+#define TB_DEMO_THREAD_DATA_MAXN    (256)
+
+// the loop count of each thread
+#ifdef __tb_debug__
+#   define TB_DEMO_THREAD_LOOP_MAXN (10000)
+#else
+#   define TB_DEMO_THREAD_LOOP_MAXN (1000000)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread context type
+typedef struct __tb_demo_thread_context_t
+{
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
+    // the data list, it may be allocated from the other thread
+    tb_pointer_t            list[TB_DEMO_THREAD_DATA_MAXN];
+
+}tb_demo_thread_context_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * demo
  */
+static tb_int_t tb_demo_default_allocator_thread(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_thread_context_t* context = (tb_demo_thread_context_t*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // malloc and free the small data randomly
+    tb_size_t i = 0;
+    tb_size_t rand = (tb_size_t)context;
+    tb_allocator_ref_t allocator = context->allocator;
+    for (i = 0; i < TB_DEMO_THREAD_LOOP_MAXN; i++)
+    {
+        // make rand
+        rand = (rand * 10807 + 1) & 0xffffffff;
+
+        // free the previous data, the first data may be allocated from the other thread
+        tb_size_t indx = (rand >> 4) % TB_DEMO_THREAD_DATA_MAXN;
+        if (context->list[indx]) tb_allocator_free(allocator, context->list[indx]);
+
+        // make data
+        context->list[indx] = tb_allocator_malloc(allocator, ((rand >> 12) & 511) + 1);
+        tb_assert_and_check_break(context->list[indx]);
+    }
+
+    // free all data
+    for (i = 0; i < TB_DEMO_THREAD_DATA_MAXN; i++)
+    {
+        if (context->list[i]) tb_allocator_free(allocator, context->list[i]);
+        context->list[i] = tb_null;
+    }
+    return 0;
+}
+static tb_hong_t tb_demo_default_allocator_threads_done(tb_allocator_ref_t allocator, tb_size_t count)
+{
+    // init contexts
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_demo_thread_context_t contexts[TB_DEMO_THREAD_MAXN];
+    for (i = 0; i < count; i++)
+    {
+        // the data list of this thread will be freed by the other thread
+        contexts[i].allocator = allocator;
+        for (j = 0; j < TB_DEMO_THREAD_DATA_MAXN; j++)
+            contexts[i].list[j] = tb_allocator_malloc(allocator, (j & 127) + 1);
+    }
+
+    // start threads
+    tb_hong_t       time = tb_mclock();
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    for (i = 0; i < count; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_default_allocator_thread, &contexts[i], 0);
+
+    // wait threads
+    for (i = 0; i < count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+
+    // ok
+    return tb_mclock() - time;
+}
+static tb_void_t tb_demo_default_allocator_threads()
+{
+    // done
+    tb_allocator_ref_t allocator = tb_null;
+    tb_allocator_ref_t large_allocator = tb_null;
+    do
+    {
+        // init a private default allocator without the thread caches
+        large_allocator = tb_large_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(large_allocator);
+
+        allocator = tb_default_allocator_init(large_allocator);
+        tb_assert_and_check_break(allocator);
+
+        // compare the global default allocator with the private one
+        tb_size_t count = 1;
+        for (count = 1; count <= TB_DEMO_THREAD_MAXN; count <<= 1)
+        {
+            tb_hong_t t1 = tb_demo_default_allocator_threads_done(tb_allocator(), count);
+            tb_hong_t t2 = tb_demo_default_allocator_threads_done(allocator, count);
+            tb_trace_i("threads: %lu, global: %lld ms, private: %lld ms", count, t1, t2);
+        }
+
+    } while (0);
+
+    // exit allocator
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+
+    // exit large allocator
+    if (large_allocator) tb_allocator_exit(large_allocator);
+    large_allocator = tb_null;
+}
 tb_void_t tb_demo_default_allocator_leak(tb_noarg_t);
 tb_void_t tb_demo_default_allocator_leak()
 {
@@ -221,6 +351,7 @@ tb_int_t tb_demo_memory_default_allocator_main(tb_int_t argc, tb_char_t** argv)
 {
 #if 1
     tb_demo_default_allocator_perf();
+    tb_demo_default_allocator_threads();
 #endif
 
 #if 0
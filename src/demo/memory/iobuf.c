@@ -0,0 +1,76 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_iobuf_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init iobufs with the small blocks
+    tb_iobuf_t a;
+    tb_iobuf_t b;
+    tb_iobuf_init(&a, 8);
+    tb_iobuf_init(&b, 8);
+
+    // "hello world!" => a: "world!", b: "hello "
+    tb_iobuf_writ(&a, (tb_byte_t const*)"hello world!", 12);
+    tb_iobuf_split(&a, 6, &b);
+    tb_trace_i("split: %lu bytes, %lu slices, %lu bytes, %lu slices", tb_iobuf_size(&a), tb_iobuf_slices(&a), tb_iobuf_size(&b), tb_iobuf_slices(&b));
+
+    // b: "hello world!", a: "" => a: "hello world! ok"
+    tb_iobuf_append(&b, &a);
+    tb_iobuf_writ(&a, (tb_byte_t const*)" ok", 3);
+    tb_iobuf_prepend(&a, &b);
+
+    // coalesce it
+    tb_size_t  size = tb_iobuf_size(&a);
+    tb_byte_t* data = tb_iobuf_coalesce(&a, size);
+    if (data) tb_trace_i("coalesce: %lu bytes, %lu slices", size, tb_iobuf_slices(&a));
+
+    // read it
+    tb_char_t d[64] = {0};
+    tb_iobuf_read(&a, (tb_byte_t*)d, sizeof(d) - 1);
+    tb_trace_i("read: %s, left: %lu", d, tb_iobuf_size(&a));
+
+    // copy the given url to the given file through the iobuf
+    if (argc > 2)
+    {
+        tb_stream_ref_t istream = tb_stream_init_from_url(argv[1]);
+        tb_stream_ref_t ostream = tb_stream_init_from_file(argv[2], TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        if (istream && ostream && tb_stream_open(istream) && tb_stream_open(ostream))
+        {
+            // init iobuf with the default block size
+            tb_iobuf_t c;
+            tb_iobuf_init(&c, 0);
+
+            tb_hize_t save = 0;
+            tb_hong_t time = tb_mclock();
+            while (!tb_stream_beof(istream))
+            {
+                // read data
+                tb_long_t real = tb_stream_read_iobuf(istream, &c, TB_STREAM_BLOCK_MAXN);
+                if (!real) real = tb_stream_wait(istream, TB_STREAM_WAIT_READ, tb_stream_timeout(istream));
+                tb_check_break(real > 0);
+
+                // writ data
+                save += tb_iobuf_size(&c);
+                if (!tb_stream_bwrit_iobuf(ostream, &c)) break;
+            }
+            tb_stream_sync(ostream, tb_true);
+            time = tb_mclock() - time;
+            tb_iobuf_exit(&c);
+
+            // trace
+            tb_trace_i("copy: %llu bytes, %lld ms", save, time);
+        }
+        if (istream) tb_stream_exit(istream);
+        if (ostream) tb_stream_exit(ostream);
+    }
+
+    // exit iobufs
+    tb_iobuf_exit(&a);
+    tb_iobuf_exit(&b);
+    return 0;
+}
@@ -3,6 +3,16 @@
  */
 #include "../demo.h"
 #include <string.h>
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+#   include <sys/mman.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the page size of the guarded buffer
+#define TB_DEMO_PAGE        (4096)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * check
@@ -56,6 +66,248 @@ static tb_bool_t check_memset_u32(tb_byte_t* dst, tb_uint32_t src, tb_size_t siz
     return tb_true;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * string check
+ */
+
+/* init the guarded buffers: | page 0 | guard | page 1 | guard |
+ *
+ * the strings are put at the page end, so we will get a hard fault if the simd kernels read the bytes after the page
+ */
+static tb_byte_t* tb_demo_string_guard_init()
+{
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    tb_byte_t* data = (tb_byte_t*)mmap(tb_null, TB_DEMO_PAGE << 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == (tb_byte_t*)MAP_FAILED) return tb_null;
+    mprotect(data + TB_DEMO_PAGE, TB_DEMO_PAGE, PROT_NONE);
+    mprotect(data + TB_DEMO_PAGE * 3, TB_DEMO_PAGE, PROT_NONE);
+    return data;
+#else
+    return (tb_byte_t*)tb_malloc0_bytes(TB_DEMO_PAGE << 2);
+#endif
+}
+static tb_void_t tb_demo_string_guard_exit(tb_byte_t* data)
+{
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    munmap(data, TB_DEMO_PAGE << 2);
+#else
+    tb_free(data);
+#endif
+}
+static tb_char_t* tb_demo_string_at_end(tb_byte_t* page, tb_char_t const* s, tb_size_t n)
+{
+    // put the data at the page end
+    tb_char_t* p = (tb_char_t*)page + TB_DEMO_PAGE - n;
+    tb_memcpy_(p, s, n);
+    return p;
+}
+static tb_char_t* tb_demo_string_strnchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
+{
+    for (; n && *s; s++, n--) if (*s == c) return (tb_char_t*)s;
+    return tb_null;
+}
+static tb_long_t tb_demo_string_sign(tb_long_t r)
+{
+    return r > 0? 1 : (r < 0? -1 : 0);
+}
+static tb_char_t* tb_demo_string_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_bool_t icase)
+{
+    tb_size_t i, k;
+    tb_size_t n2 = tb_strlen(s2);
+    for (i = 0; i + n2 <= n1; i++)
+    {
+        for (k = 0; k < n2; k++)
+        {
+            tb_byte_t c1 = (tb_byte_t)s1[i + k];
+            tb_byte_t c2 = (tb_byte_t)s2[k];
+            if (!c1 || (c1 != c2 && (!icase || tb_tolower(c1) != tb_tolower(c2)))) break;
+        }
+        if (k == n2) return (tb_char_t*)s1 + i;
+        if (!s1[i]) break;
+    }
+    return tb_null;
+}
+static tb_bool_t tb_demo_string_check()
+{
+    // init the guarded buffers
+    tb_byte_t* data = tb_demo_string_guard_init();
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // the pages
+    tb_byte_t*  page0 = data;
+    tb_byte_t*  page1 = data + TB_DEMO_PAGE * 2;
+    tb_char_t   temp[512];
+    tb_size_t   errors = 0;
+    tb_size_t   i, n, k;
+
+    // check strlen, strnlen, strnchr and strchr for all alignments and the page end
+    for (n = 0; n < 300; n++)
+    {
+        for (i = 0; i < n; i++) temp[i] = (tb_char_t)('a' + (i % 26));
+        temp[n] = '\0';
+
+        // the string is at the page end or after the aligned head
+        tb_size_t align;
+        for (align = 0; align <= 64; align++)
+        {
+            tb_char_t* s = align == 64? tb_demo_string_at_end(page0, temp, n + 1) : (tb_char_t*)tb_memcpy_(page1 + 64 + align, temp, n + 1);
+            if (tb_strlen(s) != n || tb_strnlen(s, (tb_size_t)-1) != n) errors++;
+            tb_size_t const limits[] = {0, 1, n? n - 1 : 0, n, n + 1, n + 33};
+            for (k = 0; k < tb_arrayn(limits); k++)
+            {
+                tb_size_t m = limits[k];
+                if (tb_strnlen(s, m) != tb_min(n, m)) errors++;
+                if (tb_strnchr(s, m, 'z') != tb_demo_string_strnchr(s, m, 'z')) errors++;
+                if (tb_strnchr(s, m, 'c') != tb_demo_string_strnchr(s, m, 'c')) errors++;
+            }
+            if (tb_strchr(s, 'y') != tb_demo_string_strnchr(s, (tb_size_t)-1, 'y')) errors++;
+            if (tb_strchr(s, '#')) errors++;
+        }
+    }
+
+    // check strcmp and memcmp for all different positions at the page end
+    for (n = 1; n < 300; n++)
+    {
+        for (i = 0; i < n; i++) temp[i] = (tb_char_t)('a' + (i % 26));
+        temp[n] = '\0';
+        tb_char_t* s1 = tb_demo_string_at_end(page0, temp, n + 1);
+        for (k = 0; k <= n; k++)
+        {
+            // make the different byte at k
+            tb_char_t* s2 = tb_demo_string_at_end(page1, temp, n + 1);
+            tb_long_t  r = 0;
+            if (k < n) s2[k] = (tb_char_t)(k & 1? 0xe0 : 'A');
+            if (tb_demo_string_sign(tb_strcmp(s1, s2)) != tb_demo_string_sign(k == n? 0 : (k & 1? -1 : 1))) errors++;
+            if (tb_demo_string_sign(tb_strcmp(s2, s1)) != -tb_demo_string_sign(k == n? 0 : (k & 1? -1 : 1))) errors++;
+            r = tb_memcmp_(s1, s2, n + 1);
+            if (tb_demo_string_sign(r) != tb_demo_string_sign(memcmp(s1, s2, n + 1))) errors++;
+            r = tb_memcmp_(s1 + 1, s2 + 1, n);
+            if (tb_demo_string_sign(r) != tb_demo_string_sign(memcmp(s1 + 1, s2 + 1, n))) errors++;
+
+            // the shorter string
+            s2[k] = '\0';
+            if (tb_strcmp(s1, s2) <= 0 && k < n) errors++;
+        }
+    }
+
+    // check the strstr functions with the random strings at the page end
+    tb_char_t const alphabet[] = "abAB";
+    tb_size_t times = 0;
+    for (times = 0; times < 200000; times++)
+    {
+        // make the string and the finded string
+        tb_size_t n1 = tb_random_range(0, 300);
+        tb_size_t n2 = tb_random_range(0, 6);
+        for (i = 0; i < n1; i++) temp[i] = alphabet[tb_random_range(0, 4)];
+        temp[n1] = '\0';
+        tb_char_t* s1 = tb_demo_string_at_end(page0, temp, n1 + 1);
+        for (i = 0; i < n2; i++) temp[i] = alphabet[tb_random_range(0, 4)];
+        temp[n2] = '\0';
+        tb_char_t* s2 = tb_demo_string_at_end(page1, temp, n2 + 1);
+
+        // check them
+        tb_size_t m = tb_random_range(1, 310);
+        if (tb_strstr(s1, s2) != tb_demo_string_strnstr(s1, (tb_size_t)-1, s2, tb_false)) errors++;
+        if (tb_stristr(s1, s2) != tb_demo_string_strnstr(s1, (tb_size_t)-1, s2, tb_true)) errors++;
+        if (tb_strnstr(s1, m, s2) != tb_demo_string_strnstr(s1, m, s2, tb_false)) errors++;
+        if (tb_strnistr(s1, m, s2) != tb_demo_string_strnstr(s1, m, s2, tb_true)) errors++;
+    }
+
+    // check the long string, the finded string may cross the search window
+    tb_char_t* s = (tb_char_t*)tb_malloc_bytes(20001);
+    if (s)
+    {
+        tb_memset(s, 'a', 20000);
+        s[20000] = '\0';
+        for (k = 4000; k < 4200; k += 7)
+        {
+            tb_memcpy_(s + k, "xYz", 3);
+            if (tb_strstr(s, "xYz") != s + k || tb_stristr(s, "XyZ") != s + k) errors++;
+            if (tb_strnstr(s, k + 3, "xYz") != s + k || tb_strnstr(s, k + 2, "xYz")) errors++;
+            if (tb_strnistr(s, 20000, "XYZ") != s + k) errors++;
+            tb_memset(s + k, 'a', 3);
+        }
+        if (tb_strstr(s, "ab") || tb_stristr(s, "aB") != tb_null || tb_strstr(s, "aaaa") != s) errors++;
+        tb_free(s);
+    }
+
+    // exit the guarded buffers
+    tb_demo_string_guard_exit(data);
+
+    // trace
+    tb_printf("string[check]: %s, errors: %lu\n", errors? "failed" : "ok", errors);
+    return !errors;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * string benchmark
+ */
+static tb_void_t tb_demo_string_bench()
+{
+    // init the string
+    tb_size_t   size = 1024;
+    tb_char_t*  s1 = (tb_char_t*)tb_malloc_bytes(size + 1);
+    tb_char_t*  s2 = (tb_char_t*)tb_malloc_bytes(size + 1);
+    tb_assert_and_check_return(s1 && s2);
+
+    // make the strings, "...aaaaZz"
+    tb_memset(s1, 'a', size);
+    s1[size - 2] = 'Z';
+    s1[size - 1] = 'z';
+    s1[size] = '\0';
+    tb_memcpy(s2, s1, size + 1);
+
+    // done
+    __tb_volatile__ tb_size_t   i = 0;
+    __tb_volatile__ tb_size_t   r = 0;
+    __tb_volatile__ tb_hong_t   dt = 0;
+    tb_size_t                   count = 1000000;
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += tb_strlen(s1);
+    tb_printf("strlen[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += tb_strnlen(s1, size + 1);
+    tb_printf("strnlen[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_strchr(s1, 'z');
+    tb_printf("strchr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_strnchr(s1, size, 'z');
+    tb_printf("strnchr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += tb_strcmp(s1, s2);
+    tb_printf("strcmp[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += tb_memcmp(s1, s2, size);
+    tb_printf("memcmp[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_strstr(s1, "aaZz");
+    tb_printf("strstr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_stristr(s1, "AazZ");
+    tb_printf("stristr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_strnstr(s1, size, "aaZz");
+    tb_printf("strnstr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    dt = tb_mclock();
+    for (i = 0; i < count; i++) r += (tb_size_t)tb_strnistr(s1, size, "AazZ");
+    tb_printf("strnistr[1k]: %lld ms\n", tb_mclock() - dt);
+
+    // exit the strings
+    tb_free(s1);
+    tb_free(s2);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -175,6 +427,12 @@ tb_int_t tb_demo_memory_memops_main(tb_int_t argc, tb_char_t** argv)
     tb_printf("memset_u32[1m]: %lld ms\n", dt);
     if (!check_memset_u32(data, 0xbeefbeaf, 1024 * 1024 + 3)) tb_printf("check failed\n");
 
+    // test: string
+    if (tb_demo_string_check()) tb_demo_string_bench();
+
+    // exit data
+    tb_free(data);
+    tb_free(data2);
 
     return 0;
 }
@@ -249,7 +249,14 @@ tb_int_t tb_demo_network_dns_main(tb_int_t argc, tb_char_t** argv)
     tb_trace_i("[demo]: done %lld ms", time);
 #else
     tb_dns_test_done(argv[1]);
+
+    // lookup it again from the cache
+    tb_dns_test_done(argv[1]);
 #endif
 
+    // dump the cache stat
+    tb_dns_cache_stat_t stat;
+    tb_dns_cache_stat(&stat);
+    tb_trace_i("cache: size: %lu/%lu, hit: %llu, hit_negative: %llu, miss: %llu, evict: %llu", stat.size, stat.maxn, stat.hit, stat.hit_negative, stat.miss, stat.evict);
     return 0;
 }
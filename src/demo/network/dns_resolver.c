@@ -0,0 +1,53 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_dns_resolver_func(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_ref_t addr, tb_cpointer_t priv)
+{
+    // the start time
+    tb_hong_t time = tb_mclock() - *((tb_hong_t const*)priv);
+
+    // trace
+    if (addr) tb_trace_i("lookup: %s => %{ipaddr}, %lld ms", name, addr, time);
+    else tb_trace_i("lookup: %s failed, %lld ms", name, time);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_dns_resolver_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc >= 2 && argv[1], -1);
+
+    // init resolver
+    tb_dns_resolver_ref_t resolver = tb_dns_resolver_init();
+    if (resolver)
+    {
+        // post all host names, all queries will be sent over one socket
+        tb_int_t  i = 0;
+        tb_hong_t time = tb_mclock();
+        for (i = 1; i < argc; i++)
+        {
+            if (!tb_dns_resolver_post(resolver, argv[i], tb_demo_dns_resolver_func, &time))
+                tb_trace_i("post: %s failed", argv[i]);
+        }
+
+        // wait them
+        while (tb_dns_resolver_spak(resolver) > 0)
+        {
+            if (tb_dns_resolver_wait(resolver, -1) < 0) break;
+        }
+
+        // trace
+        tb_trace_i("done %lld ms", tb_mclock() - time);
+
+        // exit resolver
+        tb_dns_resolver_exit(resolver);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_size_t tb_demo_http_pool_fetch(tb_char_t const* url, tb_size_t count, tb_http_pool_ref_t pool)
+{
+    // fetch the url using the new stream each time
+    tb_size_t i = 0;
+    tb_size_t ok = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_stream_ref_t stream = tb_stream_init_from_url(url);
+        if (stream)
+        {
+            // read all data
+            tb_size_t size = 0;
+            tb_byte_t* data = tb_null;
+            if (    tb_stream_ctrl(stream, TB_STREAM_CTRL_HTTP_SET_POOL, pool)
+                &&  tb_stream_open(stream)
+                &&  (data = (tb_byte_t*)tb_stream_bread_all(stream, tb_false, &size)))
+            {
+                tb_free(data);
+                ok++;
+            }
+            tb_stream_exit(stream);
+        }
+    }
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_http_pool_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc >= 2 && argv[1], -1);
+
+    // the fetched count
+    tb_size_t count = argv[2]? tb_atoi(argv[2]) : 100;
+
+    // fetch it without the pool
+    tb_hong_t time = tb_mclock();
+    tb_size_t ok = tb_demo_http_pool_fetch(argv[1], count, tb_null);
+    tb_trace_i("nopool: %lu/%lu, %lld ms", ok, count, tb_mclock() - time);
+
+    // fetch it with the pool
+    tb_http_pool_ref_t pool = tb_http_pool_init(0, 0, 0);
+    if (pool)
+    {
+        // fetch it
+        time = tb_mclock();
+        ok = tb_demo_http_pool_fetch(argv[1], count, pool);
+        tb_trace_i("pool: %lu/%lu, %lld ms", ok, count, tb_mclock() - time);
+
+        // trace stat
+        tb_http_pool_stat_t stat;
+        tb_http_pool_stat(pool, &stat);
+        tb_trace_i("pool: size: %lu, hosts: %lu, hit: %llu, miss: %llu, park: %llu, stale: %llu, evict: %llu"
+                    , stat.size, stat.hosts, stat.hit, stat.miss, stat.park, stat.stale, stat.evict);
+
+        // exit pool
+        tb_http_pool_exit(pool);
+    }
+    return 0;
+}
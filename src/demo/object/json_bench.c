@@ -0,0 +1,160 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default generated items count, we can pass a larger count (e.g. 50000) to run the full benchmark
+#define TB_DEMO_JSON_BENCH_ITEMN        (1000)
+
+// the loop count
+#define TB_DEMO_JSON_BENCH_LOOPN        (10)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t* tb_demo_json_bench_make(tb_size_t itemn, tb_size_t* psize)
+{
+    // init data, each item is less than 512 bytes
+    tb_size_t  maxn = itemn * 512;
+    tb_char_t* data = tb_malloc_cstr(maxn);
+    tb_assert_and_check_return_val(data, tb_null);
+
+    // make a pretty-printed array of the dictionaries
+    tb_size_t i = 0;
+    tb_size_t size = 0;
+    size += tb_snprintf(data + size, maxn - size, "[\n");
+    for (i = 0; i < itemn; i++)
+    {
+        size += tb_snprintf(data + size, maxn - size, "    {\n        \"id\": %lu,\n        \"name\": \"item %lu\",\n", i, i);
+        size += tb_snprintf(data + size, maxn - size, "        \"text\": \"The quick brown fox jumps over the lazy dog, \\\"escaped\\\" line\\n\",\n");
+        size += tb_snprintf(data + size, maxn - size, "        \"value\": -%lu.5,\n        \"valid\": %s,\n        \"extra\": null,\n", i, (i & 1)? "true" : "false");
+        size += tb_snprintf(data + size, maxn - size, "        \"tags\": [\"alpha\", \"beta\", \"gamma\", %lu, %lu]\n    }%s\n", i * 7, i * 13, i + 1 < itemn? "," : "");
+    }
+    size += tb_snprintf(data + size, maxn - size, "]\n");
+
+    // ok
+    if (psize) *psize = size;
+    return (tb_byte_t*)data;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_object_json_bench_main(tb_int_t argc, tb_char_t** argv)
+{
+    // load the given json file or make it with the given items count
+    tb_size_t  size = 0;
+    tb_byte_t* data = tb_null;
+    if (argc > 1 && !tb_isdigit(argv[1][0]))
+    {
+        tb_stream_ref_t stream = tb_stream_init_from_url(argv[1]);
+        if (stream)
+        {
+            if (tb_stream_open(stream)) data = tb_stream_bread_all(stream, tb_false, &size);
+            tb_stream_exit(stream);
+        }
+    }
+    else
+    {
+        tb_size_t itemn = argc > 1? tb_atoi(argv[1]) : TB_DEMO_JSON_BENCH_ITEMN;
+#ifdef __tb_debug__
+        // the debug vector only can hold less than 65536 items
+        itemn = tb_min(itemn, TB_MAXU16);
+#endif
+        data = tb_demo_json_bench_make(tb_max(itemn, 1), &size);
+    }
+    tb_assert_and_check_return_val(data && size, -1);
+
+    // read it
+    tb_size_t i = 0;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < TB_DEMO_JSON_BENCH_LOOPN; i++)
+    {
+        tb_object_ref_t object = tb_object_read_from_data(data, size);
+        if (!object)
+        {
+            tb_trace_i("read: failed");
+            break;
+        }
+        tb_object_exit(object);
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    if (i == TB_DEMO_JSON_BENCH_LOOPN)
+        tb_trace_i("read: %lu bytes x %d, %lld ms, %lld MB/s", size, TB_DEMO_JSON_BENCH_LOOPN, time, time > 0? ((tb_hong_t)size * TB_DEMO_JSON_BENCH_LOOPN * 1000 / (time << 20)) : 0);
+
+    // read it into the arena
+    time = tb_mclock();
+    for (i = 0; i < TB_DEMO_JSON_BENCH_LOOPN; i++)
+    {
+        tb_object_ref_t object = tb_object_read_arena_from_data(data, size);
+        if (!object)
+        {
+            tb_trace_i("read_arena: failed");
+            break;
+        }
+        tb_object_exit(object);
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    if (i == TB_DEMO_JSON_BENCH_LOOPN)
+        tb_trace_i("read_arena: %lu bytes x %d, %lld ms, %lld MB/s", size, TB_DEMO_JSON_BENCH_LOOPN, time, time > 0? ((tb_hong_t)size * TB_DEMO_JSON_BENCH_LOOPN * 1000 / (time << 20)) : 0);
+
+    // write it
+    tb_object_ref_t object = tb_object_read_from_data(data, size);
+    if (object)
+    {
+        // init the output data
+        tb_size_t  maxn = size << 1;
+        tb_byte_t* odata = tb_malloc_bytes(maxn);
+        if (odata)
+        {
+            // write it to the data stream
+            tb_long_t       writ = -1;
+            tb_stream_ref_t stream = tb_stream_init_from_data(odata, maxn);
+            time = tb_mclock();
+            for (i = 0; stream && i < TB_DEMO_JSON_BENCH_LOOPN; i++)
+            {
+                if (!tb_stream_open(stream)) break;
+                writ = tb_object_writ(object, stream, TB_OBJECT_FORMAT_JSON);
+                tb_stream_clos(stream);
+                if (writ < 0) break;
+            }
+            time = tb_mclock() - time;
+            if (stream) tb_stream_exit(stream);
+
+            // trace
+            if (i == TB_DEMO_JSON_BENCH_LOOPN)
+                tb_trace_i("writ: %ld bytes x %d, %lld ms, %lld MB/s", writ, TB_DEMO_JSON_BENCH_LOOPN, time, time > 0? ((tb_hong_t)writ * TB_DEMO_JSON_BENCH_LOOPN * 1000 / (time << 20)) : 0);
+
+            // write it to the data directly
+            time = tb_mclock();
+            for (i = 0; i < TB_DEMO_JSON_BENCH_LOOPN; i++)
+            {
+                writ = tb_object_writ_to_data(object, odata, maxn, TB_OBJECT_FORMAT_JSON);
+                if (writ < 0) break;
+            }
+            time = tb_mclock() - time;
+
+            // trace
+            if (i == TB_DEMO_JSON_BENCH_LOOPN)
+                tb_trace_i("writ_to_data: %ld bytes x %d, %lld ms, %lld MB/s", writ, TB_DEMO_JSON_BENCH_LOOPN, time, time > 0? ((tb_hong_t)writ * TB_DEMO_JSON_BENCH_LOOPN * 1000 / (time << 20)) : 0);
+
+            // exit the output data
+            tb_free(odata);
+        }
+
+        // exit object
+        tb_object_exit(object);
+    }
+
+    // exit data
+    tb_free(data);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_uint32_t tb_demo_filemap_read(tb_char_t const* path, tb_bool_t bmmap)
+{
+    // init stream
+    tb_uint32_t     hash = 2166136261u;
+    tb_stream_ref_t stream = tb_stream_init_from_file(path, TB_FILE_MODE_RO);
+    if (stream)
+    {
+        // map it?
+        tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_MMAP, bmmap);
+
+        // open it
+        if (tb_stream_open(stream))
+        {
+            // hash the file data block by block
+            tb_hong_t  time = tb_mclock();
+            tb_byte_t* data = tb_null;
+            while (1)
+            {
+                // peek data
+                tb_long_t real = tb_stream_peek(stream, &data, 4096);
+                if (real > 0)
+                {
+                    // hash it
+                    tb_long_t i = 0;
+                    for (i = 0; i < real; i++) hash = (hash ^ data[i]) * 16777619u;
+
+                    // skip it
+                    if (!tb_stream_skip(stream, real)) break;
+                }
+                // no data? wait it
+                else if (!real)
+                {
+                    if (tb_stream_wait(stream, TB_STREAM_WAIT_READ, -1) <= 0) break;
+                }
+                else break;
+            }
+            time = tb_mclock() - time;
+
+            // trace
+            tb_trace_i("read: mmap: %d, offset: %llu, hash: %x, time: %lld ms", bmmap, tb_stream_offset(stream), hash, time);
+        }
+
+        // exit stream
+        tb_stream_exit(stream);
+    }
+    return hash;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_platform_filemap_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc > 1, -1);
+
+    // map it
+    tb_filemap_ref_t filemap = tb_filemap_init(argv[1], TB_FILE_MODE_RO);
+    if (filemap)
+    {
+        // trace
+        tb_trace_i("filemap: %p, size: %lu", tb_filemap_data(filemap), tb_filemap_size(filemap));
+
+        // advise it
+        tb_filemap_advise(filemap, TB_FILEMAP_ADVICE_WILLNEED, 0, 0);
+
+        // exit it
+        tb_filemap_exit(filemap);
+    }
+
+    // read it with and without the mapping
+    tb_uint32_t hash0 = tb_demo_filemap_read(argv[1], tb_false);
+    tb_uint32_t hash1 = tb_demo_filemap_read(argv[1], tb_true);
+    tb_trace_i("compare: %s", hash0 == hash1? "ok" : "failed");
+    return 0;
+}
@@ -3,6 +3,13 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum pending tasks for the benchmark, the thread pool will reject too many waiting jobs
+#define TB_DEMO_BENCH_PENDING_MAXN      (1 << 14)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * test
  */
@@ -19,12 +26,93 @@ static tb_void_t tb_demo_task_time_exit(tb_thread_pool_worker_ref_t worker, tb_c
     // trace
     tb_trace_i("exit: %u ms", tb_p2u32(priv));
 }
+static tb_void_t tb_demo_task_count_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // count it
+    tb_atomic_fetch_and_add((tb_atomic_t*)priv, 1);
+}
+static tb_void_t tb_demo_task_spawn_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // post some short tasks from this worker, they will be pushed to the local deque and be stolen by the other workers
+    tb_size_t i = 0;
+    for (i = 0; i < 1000; i++)
+    {
+        // too many jobs? done it directly
+        if (!tb_thread_pool_task_post(tb_thread_pool(), tb_null, tb_demo_task_count_done, tb_null, priv, tb_false))
+            tb_demo_task_count_done(worker, priv);
+    }
+}
+static tb_void_t tb_demo_thread_pool_bench(tb_size_t worker_maxn, tb_size_t count)
+{
+    // init pool
+    tb_thread_pool_ref_t pool = tb_thread_pool_init(worker_maxn, 0);
+    tb_assert_and_check_return(pool);
+
+    // post the short tasks from the external thread
+    tb_atomic_t done = 0;
+    tb_hong_t   time = tb_mclock();
+    tb_size_t   i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // throttle it if there are too many pending tasks
+        while (i - (tb_size_t)tb_atomic_get(&done) >= TB_DEMO_BENCH_PENDING_MAXN) tb_sched_yield();
+
+        // post it, we only count the accepted tasks
+        if (!tb_thread_pool_task_post(pool, tb_null, tb_demo_task_count_done, tb_null, (tb_cpointer_t)&done, tb_false))
+            break;
+    }
+    count = i;
+
+    // wait them
+    while ((tb_size_t)tb_atomic_get(&done) < count) tb_sched_yield();
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("bench: workers: %lu, tasks: %lu, %lld ms, %lld tasks/ms", worker_maxn, count, time, time? (tb_hong_t)count / time : (tb_hong_t)count);
+
+    // exit pool
+    tb_thread_pool_exit(pool);
+}
+static tb_void_t tb_demo_thread_pool_bench_spawn(tb_size_t count)
+{
+    // post the spawning tasks, each task will post 1000 short tasks from the worker
+    tb_atomic_t done = 0;
+    tb_hong_t   time = tb_mclock();
+    tb_size_t   i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // throttle it if there are too many pending tasks
+        while (i * 1000 - (tb_size_t)tb_atomic_get(&done) >= TB_DEMO_BENCH_PENDING_MAXN) tb_sched_yield();
+
+        // post it, we only count the accepted tasks
+        if (!tb_thread_pool_task_post(tb_thread_pool(), tb_null, tb_demo_task_spawn_done, tb_null, (tb_cpointer_t)&done, tb_false))
+            break;
+    }
+    count = i;
+
+    // wait them
+    while ((tb_size_t)tb_atomic_get(&done) < count * 1000) tb_sched_yield();
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("bench: spawn: workers: %lu, tasks: %lu, %lld ms", tb_thread_pool_worker_size(tb_thread_pool()), count * 1000, time);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t tb_demo_platform_thread_pool_main(tb_int_t argc, tb_char_t** argv)
 {
+    // bench it?
+    if (argc > 1 && !tb_strcmp(argv[1], "bench"))
+    {
+        tb_size_t worker_maxn = 1;
+        for (worker_maxn = 1; worker_maxn <= (tb_cpu_count() << 1); worker_maxn <<= 1)
+            tb_demo_thread_pool_bench(worker_maxn, 1000000);
+        tb_demo_thread_pool_bench_spawn(1000);
+        return 0;
+    }
+
 #if 0
     // post task: 60s
     tb_thread_pool_task_post(tb_thread_pool(), "60000ms", tb_demo_task_time_done, tb_null, (tb_cpointer_t)60000, tb_false);
@@ -55,6 +55,11 @@ target("demo")
         add_files("xml/*.c")
     end
 
+    -- add the source files for the json module
+    if has_config("json") then
+        add_files("json/*.c")
+    end
+
     -- add the source files for the regex module
     if has_config("regex") then
         add_files("regex/*.c")
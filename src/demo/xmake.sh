@@ -30,6 +30,7 @@ target "demo"
     add_files "platform/event.c"
     add_files "platform/file.c"
     add_files "platform/filelock.c"
+    add_files "platform/filemap.c"
     add_files "platform/fwatcher.c"
     add_files "platform/hostname.c"
     add_files "platform/ifaddrs.c"
@@ -86,6 +87,11 @@ target "demo"
         add_files "xml/*.c"
     fi
 
+    # add the source files for the json module
+    if has_config "json"; then
+        add_files "json/*.c"
+    fi
+
     # add the source files for the regex module
     if has_config "regex"; then
         add_files "regex/*.c"
@@ -0,0 +1,456 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        intro_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "intro_sort.h"
+#include "heap_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the partition will be sorted by the insertion sorter if it's smaller than it
+#define TB_INTRO_SORT_INSERT_MAXN       (24)
+
+// the pivot will be the ninther if the partition is larger than it
+#define TB_INTRO_SORT_NINTHER_MINN      (128)
+
+// the maximum moved items count of the partial insertion sorter
+#define TB_INTRO_SORT_PARTIAL_MAXN      (8)
+
+// the stack maxn, the smaller partition is sorted first and the larger partition is pushed
+#define TB_INTRO_SORT_STACK_MAXN        (TB_CPU_BITSIZE)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the intro sorter type
+typedef struct __tb_intro_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the head
+    tb_size_t               head;
+
+    // the contiguous items from the head, we access them directly if exists
+    tb_byte_t*              data;
+
+    // the step
+    tb_size_t               step;
+
+    // is the reference item?
+    tb_bool_t               bref;
+
+    // the temporary item for the reference item
+    tb_pointer_t            temp;
+
+}tb_intro_sort_t;
+
+// the intro sorter partition type
+typedef struct __tb_intro_sort_part_t
+{
+    // the left, the partition is [l, r)
+    tb_size_t               l;
+
+    // the right
+    tb_size_t               r;
+
+    // the allowed count of the bad partitions before falling back to the heap sorter
+    tb_size_t               bad;
+
+    // is the leftmost partition?
+    tb_bool_t               leftmost;
+
+}tb_intro_sort_part_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_pointer_t tb_intro_sort_item(tb_intro_sort_t* sort, tb_size_t i)
+{
+    // the contiguous items?
+    if (sort->data)
+    {
+        tb_byte_t* p = sort->data + i * sort->step;
+        return sort->bref? (tb_pointer_t)p : *((tb_pointer_t*)p);
+    }
+
+    // the item
+    return tb_iterator_item(sort->iterator, sort->head + i);
+}
+static __tb_inline__ tb_void_t tb_intro_sort_copy(tb_intro_sort_t* sort, tb_size_t i, tb_cpointer_t item)
+{
+    // the contiguous items?
+    if (sort->data)
+    {
+        tb_byte_t* p = sort->data + i * sort->step;
+        if (sort->bref) tb_memcpy(p, item, sort->step);
+        else *((tb_cpointer_t*)p) = item;
+    }
+    // copy it
+    else tb_iterator_copy(sort->iterator, sort->head + i, item);
+}
+static __tb_inline__ tb_pointer_t tb_intro_sort_save(tb_intro_sort_t* sort, tb_size_t i)
+{
+    // the item
+    tb_pointer_t item = tb_intro_sort_item(sort, i);
+
+    // save the reference item to the temporary item, because its storage will be overwritten
+    if (sort->bref)
+    {
+        tb_memcpy(sort->temp, item, sort->step);
+        item = sort->temp;
+    }
+    return item;
+}
+static __tb_inline__ tb_long_t tb_intro_sort_comp(tb_intro_sort_t* sort, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return sort->comp(sort->iterator, litem, ritem);
+}
+static __tb_inline__ tb_bool_t tb_intro_sort_less(tb_intro_sort_t* sort, tb_size_t i, tb_size_t j)
+{
+    return tb_intro_sort_comp(sort, tb_intro_sort_item(sort, i), tb_intro_sort_item(sort, j)) < 0;
+}
+static __tb_inline__ tb_void_t tb_intro_sort_swap(tb_intro_sort_t* sort, tb_size_t i, tb_size_t j)
+{
+    tb_pointer_t item = tb_intro_sort_save(sort, i);
+    tb_intro_sort_copy(sort, i, tb_intro_sort_item(sort, j));
+    tb_intro_sort_copy(sort, j, item);
+}
+static __tb_inline__ tb_void_t tb_intro_sort_sort2(tb_intro_sort_t* sort, tb_size_t a, tb_size_t b)
+{
+    if (tb_intro_sort_less(sort, b, a)) tb_intro_sort_swap(sort, a, b);
+}
+static __tb_inline__ tb_void_t tb_intro_sort_sort3(tb_intro_sort_t* sort, tb_size_t a, tb_size_t b, tb_size_t c)
+{
+    tb_intro_sort_sort2(sort, a, b);
+    tb_intro_sort_sort2(sort, b, c);
+    tb_intro_sort_sort2(sort, a, b);
+}
+static tb_void_t tb_intro_sort_insert(tb_intro_sort_t* sort, tb_size_t l, tb_size_t r)
+{
+    tb_size_t i;
+    for (i = l + 1; i < r; i++)
+    {
+        // in order?
+        tb_check_continue(tb_intro_sort_less(sort, i, i - 1));
+
+        // move the larger items to the right and insert it
+        tb_size_t       j = i;
+        tb_pointer_t    item = tb_intro_sort_save(sort, i);
+        do
+        {
+            tb_intro_sort_copy(sort, j, tb_intro_sort_item(sort, j - 1));
+            j--;
+
+        } while (j > l && tb_intro_sort_comp(sort, item, tb_intro_sort_item(sort, j - 1)) < 0);
+        tb_intro_sort_copy(sort, j, item);
+    }
+}
+/* the partial insertion sorter
+ *
+ * it will be aborted if too many items are moved, so we can sort the nearly sorted partition quickly
+ *
+ * @return  tb_true if the partition has been sorted
+ */
+static tb_bool_t tb_intro_sort_insert_partial(tb_intro_sort_t* sort, tb_size_t l, tb_size_t r)
+{
+    tb_size_t i;
+    tb_size_t moved = 0;
+    for (i = l + 1; i < r; i++)
+    {
+        // in order?
+        tb_check_continue(tb_intro_sort_less(sort, i, i - 1));
+
+        // move the larger items to the right and insert it
+        tb_size_t       j = i;
+        tb_pointer_t    item = tb_intro_sort_save(sort, i);
+        do
+        {
+            tb_intro_sort_copy(sort, j, tb_intro_sort_item(sort, j - 1));
+            j--;
+
+        } while (j > l && tb_intro_sort_comp(sort, item, tb_intro_sort_item(sort, j - 1)) < 0);
+        tb_intro_sort_copy(sort, j, item);
+
+        // too many moved items?
+        moved += i - j;
+        if (moved > TB_INTRO_SORT_PARTIAL_MAXN) return tb_false;
+    }
+    return tb_true;
+}
+/* partition [l, r) by the pivot at l, the items equal to the pivot are put to the right partition
+ *
+ * @return  the pivot position
+ */
+static tb_size_t tb_intro_sort_partition_right(tb_intro_sort_t* sort, tb_size_t l, tb_size_t r, tb_bool_t* palready)
+{
+    // the pivot will be not moved before the partition has been finished
+    tb_pointer_t pivot = tb_intro_sort_item(sort, l);
+
+    // find the first item >= pivot, the median-of-three has put an item >= pivot to the end
+    tb_size_t i = l;
+    tb_size_t j = r;
+    while (tb_intro_sort_comp(sort, tb_intro_sort_item(sort, ++i), pivot) < 0) ;
+
+    // find the last item < pivot, it need be guarded if there are no items < pivot at the left
+    if (i - 1 == l)
+    {
+        while (i < j && !(tb_intro_sort_comp(sort, tb_intro_sort_item(sort, --j), pivot) < 0)) ;
+    }
+    else
+    {
+        while (!(tb_intro_sort_comp(sort, tb_intro_sort_item(sort, --j), pivot) < 0)) ;
+    }
+
+    // has been partitioned?
+    *palready = i >= j;
+
+    // swap the out of place items, they are the sentinels of the next finding
+    while (i < j)
+    {
+        tb_intro_sort_swap(sort, i, j);
+        while (tb_intro_sort_comp(sort, tb_intro_sort_item(sort, ++i), pivot) < 0) ;
+        while (!(tb_intro_sort_comp(sort, tb_intro_sort_item(sort, --j), pivot) < 0)) ;
+    }
+
+    // put the pivot to its position
+    tb_size_t p = i - 1;
+    if (p != l) tb_intro_sort_swap(sort, l, p);
+    return p;
+}
+/* partition [l, r) by the pivot at l, the items equal to the pivot are put to the left partition
+ *
+ * it's used for the many equal items, all items of the left partition are equal to the pivot
+ *
+ * @return  the pivot position
+ */
+static tb_size_t tb_intro_sort_partition_left(tb_intro_sort_t* sort, tb_size_t l, tb_size_t r)
+{
+    // the pivot will be not moved before the partition has been finished
+    tb_pointer_t pivot = tb_intro_sort_item(sort, l);
+
+    // find the last item <= pivot, the pivot is the sentinel
+    tb_size_t i = l;
+    tb_size_t j = r;
+    while (tb_intro_sort_comp(sort, pivot, tb_intro_sort_item(sort, --j)) < 0) ;
+
+    // find the first item > pivot, it need be guarded if there are no items > pivot at the right
+    if (j + 1 == r)
+    {
+        while (i < j && !(tb_intro_sort_comp(sort, pivot, tb_intro_sort_item(sort, ++i)) < 0)) ;
+    }
+    else
+    {
+        while (!(tb_intro_sort_comp(sort, pivot, tb_intro_sort_item(sort, ++i)) < 0)) ;
+    }
+
+    // swap the out of place items
+    while (i < j)
+    {
+        tb_intro_sort_swap(sort, i, j);
+        while (tb_intro_sort_comp(sort, pivot, tb_intro_sort_item(sort, --j)) < 0) ;
+        while (!(tb_intro_sort_comp(sort, pivot, tb_intro_sort_item(sort, ++i)) < 0)) ;
+    }
+
+    // put the pivot to its position
+    if (j != l) tb_intro_sort_swap(sort, l, j);
+    return j;
+}
+static tb_void_t tb_intro_sort_done(tb_intro_sort_t* sort, tb_size_t size)
+{
+    // the allowed bad partitions count: log2(size)
+    tb_size_t bad = 0;
+    tb_size_t n = size;
+    while (n >>= 1) bad++;
+
+    // done
+    tb_bool_t               pop = tb_false;
+    tb_size_t               top = 0;
+    tb_intro_sort_part_t    part = {0, size, bad, tb_true};
+    tb_intro_sort_part_t    stack[TB_INTRO_SORT_STACK_MAXN];
+    while (1)
+    {
+        // pop the next partition
+        if (pop)
+        {
+            tb_check_break(top);
+            part = stack[--top];
+            pop = tb_false;
+        }
+
+        // the small partition? sort it using the insertion sorter
+        tb_size_t l = part.l;
+        tb_size_t r = part.r;
+        tb_size_t m = l + ((r - l) >> 1);
+        n = r - l;
+        if (n < TB_INTRO_SORT_INSERT_MAXN)
+        {
+            tb_intro_sort_insert(sort, l, r);
+            pop = tb_true;
+            continue;
+        }
+
+        // choose the pivot and move it to l, the ninther is used for the large partition
+        if (n > TB_INTRO_SORT_NINTHER_MINN)
+        {
+            tb_intro_sort_sort3(sort, l, m, r - 1);
+            tb_intro_sort_sort3(sort, l + 1, m - 1, r - 2);
+            tb_intro_sort_sort3(sort, l + 2, m + 1, r - 3);
+            tb_intro_sort_sort3(sort, m - 1, m, m + 1);
+            tb_intro_sort_swap(sort, l, m);
+        }
+        else tb_intro_sort_sort3(sort, m, l, r - 1);
+
+        /* the pivot is equal to the previous item, the previous item is the pivot of the parent partition
+         * and it is not larger than all items of this partition, so we put the equal items to the left and skip them
+         */
+        if (!part.leftmost && !tb_intro_sort_less(sort, l - 1, l))
+        {
+            part.l = tb_intro_sort_partition_left(sort, l, r) + 1;
+            continue;
+        }
+
+        // partition it
+        tb_bool_t already = tb_false;
+        tb_size_t p = tb_intro_sort_partition_right(sort, l, r, &already);
+
+        // the bad partition?
+        tb_size_t ln = p - l;
+        tb_size_t rn = r - p - 1;
+        if (ln < (n >> 3) || rn < (n >> 3))
+        {
+            // too many bad partitions? fall back to the heap sorter
+            if (!--part.bad)
+            {
+                tb_heap_sort(sort->iterator, sort->head + l, sort->head + r, sort->comp);
+                pop = tb_true;
+                continue;
+            }
+
+            // break the patterns by swapping some items
+            if (ln >= TB_INTRO_SORT_INSERT_MAXN)
+            {
+                tb_intro_sort_swap(sort, l, l + (ln >> 2));
+                tb_intro_sort_swap(sort, p - 1, p - (ln >> 2));
+                if (ln > TB_INTRO_SORT_NINTHER_MINN)
+                {
+                    tb_intro_sort_swap(sort, l + 1, l + (ln >> 2) + 1);
+                    tb_intro_sort_swap(sort, l + 2, l + (ln >> 2) + 2);
+                    tb_intro_sort_swap(sort, p - 2, p - (ln >> 2) - 1);
+                    tb_intro_sort_swap(sort, p - 3, p - (ln >> 2) - 2);
+                }
+            }
+            if (rn >= TB_INTRO_SORT_INSERT_MAXN)
+            {
+                tb_intro_sort_swap(sort, p + 1, p + 1 + (rn >> 2));
+                tb_intro_sort_swap(sort, r - 1, r - (rn >> 2));
+                if (rn > TB_INTRO_SORT_NINTHER_MINN)
+                {
+                    tb_intro_sort_swap(sort, p + 2, p + 2 + (rn >> 2));
+                    tb_intro_sort_swap(sort, p + 3, p + 3 + (rn >> 2));
+                    tb_intro_sort_swap(sort, r - 2, r - 1 - (rn >> 2));
+                    tb_intro_sort_swap(sort, r - 3, r - 2 - (rn >> 2));
+                }
+            }
+        }
+        // has been partitioned? try to sort them using the partial insertion sorter
+        else if (   already
+                &&  tb_intro_sort_insert_partial(sort, l, p)
+                &&  tb_intro_sort_insert_partial(sort, p + 1, r))
+        {
+            pop = tb_true;
+            continue;
+        }
+
+        // sort the smaller partition first and push the larger partition, so the stack depth is less than log2(size)
+        tb_assert_and_check_break(top < TB_INTRO_SORT_STACK_MAXN);
+        if (ln < rn)
+        {
+            stack[top].l        = p + 1;
+            stack[top].r        = r;
+            stack[top].bad      = part.bad;
+            stack[top].leftmost = tb_false;
+            part.r              = p;
+        }
+        else
+        {
+            stack[top]          = part;
+            stack[top].r        = p;
+            part.l              = p + 1;
+            part.leftmost       = tb_false;
+        }
+        top++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_intro_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // get flag
+    tb_size_t step = tb_iterator_step(iterator);
+    tb_size_t flag = tb_iterator_flag(iterator);
+    if (!flag && step > sizeof(tb_pointer_t))
+        flag |= TB_ITERATOR_FLAG_ITEM_REF;
+
+    // init sorter
+    tb_intro_sort_t sort;
+    sort.iterator   = iterator;
+    sort.comp       = comp? comp : tb_iterator_comp;
+    sort.head       = head;
+    sort.step       = step;
+    sort.bref       = (flag & TB_ITERATOR_FLAG_ITEM_REF)? tb_true : tb_false;
+    sort.data       = (tb_byte_t*)tb_iterator_data(iterator, tb_null);
+    sort.temp       = sort.bref? tb_malloc(step) : tb_null;
+    tb_assert_and_check_return(!sort.bref || sort.temp);
+
+    // we access the contiguous items directly if the value item has the pointer size
+    if (sort.data)
+    {
+        if (sort.bref || step == sizeof(tb_pointer_t)) sort.data += head * step;
+        else sort.data = tb_null;
+    }
+
+    // sort it
+    tb_intro_sort_done(&sort, tail - head);
+
+    // free the temporary item
+    if (sort.temp) tb_free(sort.temp);
+}
+tb_void_t tb_intro_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_intro_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
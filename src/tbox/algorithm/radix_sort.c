@@ -0,0 +1,159 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        radix_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "radix_sort.h"
+#include "intro_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline_force__ tb_uint64_t tb_radix_sort_load(tb_byte_t const* p, tb_size_t step)
+{
+    switch (step)
+    {
+    case 1: return *((tb_uint8_t const*)p);
+    case 2: return *((tb_uint16_t const*)p);
+    case 4: return *((tb_uint32_t const*)p);
+    default: return *((tb_uint64_t const*)p);
+    }
+}
+static __tb_inline_force__ tb_void_t tb_radix_sort_save(tb_byte_t* p, tb_size_t step, tb_uint64_t value)
+{
+    switch (step)
+    {
+    case 1: *((tb_uint8_t*)p) = (tb_uint8_t)value; break;
+    case 2: *((tb_uint16_t*)p) = (tb_uint16_t)value; break;
+    case 4: *((tb_uint32_t*)p) = (tb_uint32_t)value; break;
+    default: *((tb_uint64_t*)p) = value; break;
+    }
+}
+/* sort the integers of the given step size
+ *
+ * the step is constant after inlining it, so the loops will be specialized for each integer size
+ *
+ * @param data      the integers
+ * @param temp      the temporary integers
+ * @param size      the integers count
+ * @param step      the integer size
+ * @param sign      the sign bit, we flip it to sort the signed integers as the unsigned integers
+ * @param counts    the counts of all digits, 256 counts for each byte
+ */
+static __tb_inline_force__ tb_void_t tb_radix_sort_done(tb_byte_t* data, tb_byte_t* temp, tb_size_t size, tb_size_t step, tb_uint64_t sign, tb_size_t* counts)
+{
+    // count all digits in one pass
+    tb_size_t           i = 0;
+    tb_size_t           d = 0;
+    tb_byte_t const*    p = data;
+    tb_memset(counts, 0, (step << 8) * sizeof(tb_size_t));
+    for (i = 0; i < size; i++, p += step)
+    {
+        tb_uint64_t value = tb_radix_sort_load(p, step) ^ sign;
+        for (d = 0; d < step; d++)
+            counts[(d << 8) + ((value >> (d << 3)) & 0xff)]++;
+    }
+
+    // sort them from the least significant digit
+    tb_byte_t*  src = data;
+    tb_byte_t*  dst = temp;
+    tb_uint64_t first = tb_radix_sort_load(data, step) ^ sign;
+    for (d = 0; d < step; d++)
+    {
+        // all items have the same digit? skip it
+        tb_size_t*  offsets = counts + (d << 8);
+        tb_size_t   shift = d << 3;
+        tb_check_continue(offsets[(first >> shift) & 0xff] != size);
+
+        // the counts => the offsets
+        tb_size_t j = 0;
+        tb_size_t sum = 0;
+        for (j = 0; j < 256; j++)
+        {
+            tb_size_t count = offsets[j];
+            offsets[j] = sum;
+            sum += count;
+        }
+
+        // scatter the items to the buckets
+        for (i = 0, p = src; i < size; i++, p += step)
+        {
+            tb_uint64_t value = tb_radix_sort_load(p, step);
+            tb_radix_sort_save(dst + offsets[((value ^ sign) >> shift) & 0xff]++ * step, step, value);
+        }
+
+        // swap the buffers
+        tb_byte_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    // copy the sorted items back
+    if (src != data) tb_memcpy(data, src, size * step);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // get the contiguous integers
+    tb_size_t   type = TB_ITERATOR_DATA_TYPE_NONE;
+    tb_size_t   step = tb_iterator_step(iterator);
+    tb_size_t   size = tail - head;
+    tb_byte_t*  data = (tb_byte_t*)tb_iterator_data(iterator, &type);
+    tb_byte_t*  temp = tb_null;
+    if (    data && type != TB_ITERATOR_DATA_TYPE_NONE
+        &&  (step == 1 || step == 2 || step == 4 || step == 8)
+        &&  (temp = (tb_byte_t*)tb_malloc((step << 8) * sizeof(tb_size_t) + size * step)))
+    {
+        // the sign bit
+        tb_uint64_t sign = type == TB_ITERATOR_DATA_TYPE_SINT? ((tb_uint64_t)1 << ((step << 3) - 1)) : 0;
+
+        // sort them, the digit counts are at the head of the temporary buffer
+        tb_size_t*  counts = (tb_size_t*)temp;
+        tb_byte_t*  items = temp + (step << 8) * sizeof(tb_size_t);
+        data += head * step;
+        switch (step)
+        {
+        case 1: tb_radix_sort_done(data, items, size, 1, sign, counts); break;
+        case 2: tb_radix_sort_done(data, items, size, 2, sign, counts); break;
+        case 4: tb_radix_sort_done(data, items, size, 4, sign, counts); break;
+        default: tb_radix_sort_done(data, items, size, 8, sign, counts); break;
+        }
+
+        // free the temporary buffer
+        tb_free(temp);
+    }
+    // uses the intro sorter for the other items or no enough memory
+    else tb_intro_sort(iterator, head, tail, tb_null);
+}
+tb_void_t tb_radix_sort_all(tb_iterator_ref_t iterator)
+{
+    tb_radix_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator));
+}
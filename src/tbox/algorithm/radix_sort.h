@@ -0,0 +1,62 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        radix_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_RADIX_SORT_H
+#define TB_ALGORITHM_RADIX_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the radix sorter, O(n)
+ *
+ * the lsd radix sorter for the contiguous integer items, see tb_iterator_data(),
+ * they are sorted by value and the comparer of the iterator will be not used.
+ *
+ * it will fall back to the intro sorter with the default comparer for the other items.
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ */
+tb_void_t           tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail);
+
+/*! the radix sorter for all
+ *
+ * @param iterator  the iterator
+ */
+tb_void_t           tb_radix_sort_all(tb_iterator_ref_t iterator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -27,10 +27,19 @@
 #include "distance.h"
 #include "heap_sort.h"
 #include "quick_sort.h"
+#include "intro_sort.h"
+#include "radix_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
 #include "../libc/libc.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the contiguous integers will be sorted by the radix sorter if they are not less than it
+#define TB_SORT_RADIX_MINN          (256)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -55,8 +64,12 @@ tb_void_t tb_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb
     // random access iterator?
     if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS)
     {
-        if (tb_distance(iterator, head, tail) > 100000) tb_heap_sort(iterator, head, tail, comp);
-        else tb_quick_sort(iterator, head, tail, comp); //!< @note the recursive stack size is limit
+        /* sort the contiguous integers by value using the radix sorter if the default comparer is used,
+         * and it will fall back to the intro sorter for the other items
+         */
+        if ((!comp || comp == tb_iterator_comp) && tb_distance(iterator, head, tail) >= TB_SORT_RADIX_MINN)
+            tb_radix_sort(iterator, head, tail);
+        else tb_intro_sort(iterator, head, tail, comp);
     }
     else tb_insert_sort(iterator, head, tail, comp);
 #endif
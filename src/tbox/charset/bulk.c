@@ -0,0 +1,594 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        bulk.c
+ * @ingroup     charset
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "charset.h"
+#include "../stream/stream.h"
+#include "../utils/utils.h"
+#if defined(TB_ARCH_AVX2)
+#   include <immintrin.h>
+#elif defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+
+// the gb2312 to ucs4 table, the index is the gb2312 character - 0xa1a1
+tb_uint16_t const*  tb_charset_gb2312_to_ucs4_table(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// the unit size of the charset for the ascii characters
+static __tb_inline_force__ tb_size_t tb_charset_bulk_unit(tb_size_t type)
+{
+    switch (type)
+    {
+    case TB_CHARSET_TYPE_UTF16:
+    case TB_CHARSET_TYPE_UCS2:
+        return 2;
+    case TB_CHARSET_TYPE_UTF32:
+    case TB_CHARSET_TYPE_UCS4:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+// get the unit value
+static __tb_inline_force__ tb_uint32_t tb_charset_bulk_unit_get(tb_size_t unit, tb_bool_t be, tb_byte_t const* p)
+{
+    if (unit == 1) return *p;
+    else if (unit == 2) return be? tb_bits_get_u16_be(p) : tb_bits_get_u16_le(p);
+    return be? tb_bits_get_u32_be(p) : tb_bits_get_u32_le(p);
+}
+
+// the size of the leading ascii characters in [p, e)
+static __tb_inline__ tb_size_t tb_charset_bulk_ascii_size(tb_byte_t const* p, tb_byte_t const* e)
+{
+    tb_byte_t const* b = p;
+#if defined(TB_ARCH_AVX2)
+    while (p + 32 <= e)
+    {
+        tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((__m256i const*)p));
+        if (m) return (p - b) + tb_bits_fb1_u32_le(m);
+        p += 32;
+    }
+#endif
+#if defined(TB_ARCH_SSE2)
+    while (p + 16 <= e)
+    {
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)p));
+        if (m) return (p - b) + tb_bits_fb1_u32_le(m);
+        p += 16;
+    }
+#else
+    while (p + 4 <= e && !(tb_bits_get_u32_ne(p) & 0x80808080)) p += 4;
+#endif
+    while (p < e && *p < 0x80) p++;
+    return p - b;
+}
+
+// convert the leading ascii characters
+static __tb_inline_force__ tb_void_t tb_charset_bulk_ascii(tb_size_t funit, tb_bool_t fbe, tb_size_t tunit, tb_bool_t tbe, tb_byte_t const** pp, tb_byte_t const* pe, tb_byte_t** pq, tb_byte_t* qe)
+{
+    // init
+    tb_byte_t const*    p = *pp;
+    tb_byte_t*          q = *pq;
+
+    // the byte charset to the byte charset? copy them
+    if (funit == 1 && tunit == 1)
+    {
+        tb_size_t n = tb_charset_bulk_ascii_size(p, p + tb_min(pe - p, qe - q));
+        tb_memcpy_(q, p, n);
+        p += n;
+        q += n;
+    }
+    // the byte charset to the wide charset? widen them
+    else if (funit == 1)
+    {
+#if defined(TB_ARCH_SSE2)
+        __m128i z = _mm_setzero_si128();
+        if (tunit == 2)
+        {
+            while (p + 16 <= pe && q + 32 <= qe)
+            {
+                __m128i v = _mm_loadu_si128((__m128i const*)p);
+                if (_mm_movemask_epi8(v)) break;
+                _mm_storeu_si128((__m128i*)q, tbe? _mm_unpacklo_epi8(z, v) : _mm_unpacklo_epi8(v, z));
+                _mm_storeu_si128((__m128i*)(q + 16), tbe? _mm_unpackhi_epi8(z, v) : _mm_unpackhi_epi8(v, z));
+                p += 16;
+                q += 32;
+            }
+        }
+        else
+        {
+            while (p + 16 <= pe && q + 64 <= qe)
+            {
+                __m128i v = _mm_loadu_si128((__m128i const*)p);
+                if (_mm_movemask_epi8(v)) break;
+                __m128i l = tbe? _mm_unpacklo_epi8(z, v) : _mm_unpacklo_epi8(v, z);
+                __m128i h = tbe? _mm_unpackhi_epi8(z, v) : _mm_unpackhi_epi8(v, z);
+                _mm_storeu_si128((__m128i*)q, tbe? _mm_unpacklo_epi16(z, l) : _mm_unpacklo_epi16(l, z));
+                _mm_storeu_si128((__m128i*)(q + 16), tbe? _mm_unpackhi_epi16(z, l) : _mm_unpackhi_epi16(l, z));
+                _mm_storeu_si128((__m128i*)(q + 32), tbe? _mm_unpacklo_epi16(z, h) : _mm_unpacklo_epi16(h, z));
+                _mm_storeu_si128((__m128i*)(q + 48), tbe? _mm_unpackhi_epi16(z, h) : _mm_unpackhi_epi16(h, z));
+                p += 16;
+                q += 64;
+            }
+        }
+#endif
+        while (p < pe && q + tunit <= qe && *p < 0x80)
+        {
+            tb_memset_(q, 0, tunit);
+            q[tbe? tunit - 1 : 0] = *p++;
+            q += tunit;
+        }
+    }
+    // the wide charset to the byte charset? narrow them
+    else if (tunit == 1)
+    {
+#if defined(TB_ARCH_SSE2)
+        if (funit == 2)
+        {
+            __m128i m = _mm_set1_epi16((tb_short_t)0xff80);
+            __m128i z = _mm_setzero_si128();
+            while (p + 32 <= pe && q + 16 <= qe)
+            {
+                __m128i a = _mm_loadu_si128((__m128i const*)p);
+                __m128i b = _mm_loadu_si128((__m128i const*)(p + 16));
+                if (fbe)
+                {
+                    a = _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8));
+                    b = _mm_or_si128(_mm_slli_epi16(b, 8), _mm_srli_epi16(b, 8));
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), m), z)) != 0xffff) break;
+                _mm_storeu_si128((__m128i*)q, _mm_packus_epi16(a, b));
+                p += 32;
+                q += 16;
+            }
+        }
+#endif
+        tb_uint32_t c;
+        while (p + funit <= pe && q < qe && (c = tb_charset_bulk_unit_get(funit, fbe, p)) < 0x80)
+        {
+            *q++ = (tb_byte_t)c;
+            p += funit;
+        }
+    }
+
+    // update
+    *pp = p;
+    *pq = q;
+}
+
+/* get the ucs4 character, it's same as tb_charset_xxx_get()
+ *
+ * @return      the character size, -size: skip the invalid character, 0: break it
+ */
+static __tb_inline_force__ tb_long_t tb_charset_bulk_get(tb_size_t type, tb_bool_t be, tb_byte_t const* p, tb_byte_t const* e, tb_uint32_t* ch)
+{
+    tb_size_t n = e - p;
+    switch (type)
+    {
+    case TB_CHARSET_TYPE_UTF8:
+        {
+            tb_byte_t b = *p;
+            if (!(b & 0x80))
+            {
+                *ch = b;
+                return 1;
+            }
+            else if ((b & 0xe0) == 0xc0)
+            {
+                tb_check_return_val(n > 1, 0);
+                *ch = ((((tb_uint32_t)(p[0] & 0x1f)) << 6) | (p[1] & 0x3f));
+                return 2;
+            }
+            else if ((b & 0xf0) == 0xe0)
+            {
+                tb_check_return_val(n > 2, 0);
+                *ch = ((((tb_uint32_t)(p[0] & 0x0f)) << 12) | (((tb_uint32_t)(p[1] & 0x3f)) << 6) | (p[2] & 0x3f));
+                return 3;
+            }
+            else if ((b & 0xf8) == 0xf0)
+            {
+                tb_check_return_val(n > 3, 0);
+                *ch = ((((tb_uint32_t)(p[0] & 0x07)) << 18) | (((tb_uint32_t)(p[1] & 0x3f)) << 12) | (((tb_uint32_t)(p[2] & 0x3f)) << 6) | (p[3] & 0x3f));
+                return 4;
+            }
+            else if ((b & 0xfc) == 0xf8)
+            {
+                tb_check_return_val(n > 4, 0);
+                *ch = ((((tb_uint32_t)(p[0] & 0x03)) << 24) | (((tb_uint32_t)(p[1] & 0x3f)) << 18) | (((tb_uint32_t)(p[2] & 0x3f)) << 12) | (((tb_uint32_t)(p[3] & 0x3f)) << 6) | (p[4] & 0x3f));
+                return 5;
+            }
+            else if ((b & 0xfe) == 0xfc)
+            {
+                tb_check_return_val(n > 5, 0);
+                *ch = ((((tb_uint32_t)(p[0] & 0x01)) << 30) | (((tb_uint32_t)(p[1] & 0x3f)) << 24) | (((tb_uint32_t)(p[2] & 0x3f)) << 18) | (((tb_uint32_t)(p[3] & 0x3f)) << 12) | (((tb_uint32_t)(p[4] & 0x3f)) << 6) | (p[5] & 0x3f));
+                return 6;
+            }
+
+            // skip the invalid character
+            return -1;
+        }
+    case TB_CHARSET_TYPE_UTF16:
+        {
+            tb_check_return_val(n > 1, 0);
+            tb_uint32_t c = be? tb_bits_get_u16_be(p) : tb_bits_get_u16_le(p);
+            if (c >= 0xd800 && c <= 0xdbff)
+            {
+                tb_check_return_val(n > 3, 0);
+                tb_uint32_t c2 = be? tb_bits_get_u16_be(p + 2) : tb_bits_get_u16_le(p + 2);
+                if (c2 >= 0xdc00 && c2 <= 0xdfff)
+                {
+                    *ch = ((c - 0xd800) << 10) + (c2 - 0xdc00) + 0x0010000;
+                    return 4;
+                }
+            }
+            *ch = c;
+            return 2;
+        }
+    case TB_CHARSET_TYPE_UCS2:
+        {
+            tb_check_return_val(n > 1, 0);
+            *ch = be? tb_bits_get_u16_be(p) : tb_bits_get_u16_le(p);
+            return 2;
+        }
+    case TB_CHARSET_TYPE_UCS4:
+    case TB_CHARSET_TYPE_UTF32:
+        {
+            tb_check_return_val(n > 3, 0);
+            *ch = be? tb_bits_get_u32_be(p) : tb_bits_get_u32_le(p);
+            return 4;
+        }
+    case TB_CHARSET_TYPE_GB2312:
+    case TB_CHARSET_TYPE_GBK:
+        {
+            if (*p <= 0x7f)
+            {
+                *ch = *p;
+                return 1;
+            }
+            tb_check_return_val(n > 1, 0);
+            tb_uint32_t c = be? tb_bits_get_u16_be(p) : tb_bits_get_u16_le(p);
+            *ch = (c >= 0xa1a1 && c <= 0xf7fe)? tb_charset_gb2312_to_ucs4_table()[c - 0xa1a1] : 0;
+            return 2;
+        }
+    default:
+        break;
+    }
+    return 0;
+}
+
+/* set the ucs4 character, it's same as tb_charset_xxx_set()
+ *
+ * @return      the character size, -1: break it
+ */
+static __tb_inline_force__ tb_long_t tb_charset_bulk_set(tb_size_t type, tb_bool_t be, tb_byte_t* q, tb_byte_t const* e, tb_uint32_t ch)
+{
+    tb_size_t n = e - q;
+    switch (type)
+    {
+    case TB_CHARSET_TYPE_UTF8:
+        {
+            if (ch <= 0x0000007f)
+            {
+                q[0] = (tb_byte_t)ch;
+                return 1;
+            }
+            else if (ch <= 0x000007ff)
+            {
+                tb_check_return_val(n > 1, -1);
+                q[0] = ((ch >> 6) & 0x1f) | 0xc0;
+                q[1] = (ch & 0x3f) | 0x80;
+                return 2;
+            }
+            else if (ch <= 0x0000ffff)
+            {
+                tb_check_return_val(n > 2, -1);
+                q[0] = ((ch >> 12) & 0x0f) | 0xe0;
+                q[1] = ((ch >> 6) & 0x3f) | 0x80;
+                q[2] = (ch & 0x3f) | 0x80;
+                return 3;
+            }
+            else if (ch <= 0x001fffff)
+            {
+                tb_check_return_val(n > 3, -1);
+                q[0] = ((ch >> 18) & 0x07) | 0xf0;
+                q[1] = ((ch >> 12) & 0x3f) | 0x80;
+                q[2] = ((ch >> 6) & 0x3f) | 0x80;
+                q[3] = (ch & 0x3f) | 0x80;
+                return 4;
+            }
+            else if (ch <= 0x03ffffff)
+            {
+                tb_check_return_val(n > 4, -1);
+                q[0] = ((ch >> 24) & 0x03) | 0xf8;
+                q[1] = ((ch >> 18) & 0x3f) | 0x80;
+                q[2] = ((ch >> 12) & 0x3f) | 0x80;
+                q[3] = ((ch >> 6) & 0x3f) | 0x80;
+                q[4] = (ch & 0x3f) | 0x80;
+                return 5;
+            }
+            else if (ch <= 0x7fffffff)
+            {
+                tb_check_return_val(n > 5, -1);
+                q[0] = ((ch >> 30) & 0x01) | 0xfc;
+                q[1] = ((ch >> 24) & 0x3f) | 0x80;
+                q[2] = ((ch >> 18) & 0x3f) | 0x80;
+                q[3] = ((ch >> 12) & 0x3f) | 0x80;
+                q[4] = ((ch >> 6) & 0x3f) | 0x80;
+                q[5] = (ch & 0x3f) | 0x80;
+                return 6;
+            }
+
+            // no character
+            return 0;
+        }
+    case TB_CHARSET_TYPE_UTF16:
+        {
+            tb_check_return_val(n > 1, -1);
+            if (ch > 0x0010ffff) ch = 0x0000fffd;
+            if (ch <= 0x0000ffff)
+            {
+                if (be) tb_bits_set_u16_be(q, ch);
+                else tb_bits_set_u16_le(q, ch);
+                return 2;
+            }
+            tb_check_return_val(n > 3, -1);
+            ch -= 0x0010000;
+            if (be)
+            {
+                tb_bits_set_u16_be(q, (ch >> 10) + 0xd800);
+                tb_bits_set_u16_be(q + 2, (ch & 0x3ff) + 0xdc00);
+            }
+            else
+            {
+                tb_bits_set_u16_le(q, (ch >> 10) + 0xd800);
+                tb_bits_set_u16_le(q + 2, (ch & 0x3ff) + 0xdc00);
+            }
+            return 4;
+        }
+    case TB_CHARSET_TYPE_UCS2:
+        {
+            tb_check_return_val(n > 1, -1);
+            if (ch > 0xffff) ch = 0xfffd;
+            if (be) tb_bits_set_u16_be(q, ch);
+            else tb_bits_set_u16_le(q, ch);
+            return 2;
+        }
+    case TB_CHARSET_TYPE_UCS4:
+    case TB_CHARSET_TYPE_UTF32:
+        {
+            tb_check_return_val(n > 3, -1);
+            if (be) tb_bits_set_u32_be(q, ch);
+            else tb_bits_set_u32_le(q, ch);
+            return 4;
+        }
+    default:
+        break;
+    }
+    return -1;
+}
+
+/* convert the characters of the given charsets until it need be done by tb_charset_t,
+ * e.g. not enough input or output data, and the results are same as tb_charset_t
+ */
+static __tb_inline_force__ tb_void_t tb_charset_bulk_done(tb_size_t ftype, tb_bool_t fbe, tb_size_t ttype, tb_bool_t tbe, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    // init
+    tb_byte_t const*    b = tb_static_stream_pos(fst);
+    tb_byte_t const*    p = b;
+    tb_byte_t const*    pe = p + tb_static_stream_left(fst);
+    tb_byte_t*          d = (tb_byte_t*)tb_static_stream_pos(tst);
+    tb_byte_t*          q = d;
+    tb_byte_t*          qe = q + tb_static_stream_left(tst);
+    tb_size_t           funit = tb_charset_bulk_unit(ftype);
+    tb_size_t           tunit = tb_charset_bulk_unit(ttype);
+
+    // done
+    tb_uint32_t ch;
+    while (p < pe && q < qe)
+    {
+        // convert the ascii characters
+        if (p + funit <= pe && tb_charset_bulk_unit_get(funit, fbe, p) < 0x80)
+        {
+            tb_charset_bulk_ascii(funit, fbe, tunit, tbe, &p, pe, &q, qe);
+            tb_check_break(p < pe && q < qe);
+        }
+
+        // get character
+        tb_long_t n = tb_charset_bulk_get(ftype, fbe, p, pe, &ch);
+        tb_check_break(n);
+
+        // invalid? skip it
+        if (n < 0)
+        {
+            p -= n;
+            continue;
+        }
+
+        // set character
+        tb_long_t m = tb_charset_bulk_set(ttype, tbe, q, qe, ch);
+        tb_check_break(m >= 0);
+
+        // next
+        p += n;
+        q += m;
+    }
+
+    // update streams
+    if (p > b) tb_static_stream_skip(fst, p - b);
+    if (q > d) tb_static_stream_skip(tst, q - d);
+}
+
+// convert the ascii characters between the byte charsets
+static tb_void_t tb_charset_bulk_done_ascii(tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    // init
+    tb_byte_t const*    b = tb_static_stream_pos(fst);
+    tb_byte_t const*    p = b;
+    tb_byte_t*          q = (tb_byte_t*)tb_static_stream_pos(tst);
+
+    // copy the ascii characters
+    tb_charset_bulk_ascii(1, tb_false, 1, tb_false, &p, p + tb_static_stream_left(fst), &q, q + tb_static_stream_left(tst));
+
+    // update streams
+    if (p > b)
+    {
+        tb_static_stream_skip(fst, p - b);
+        tb_static_stream_skip(tst, p - b);
+    }
+}
+
+// the utf8 character to the given wide charset
+static tb_void_t tb_charset_bulk_done_utf8_to(tb_size_t ttype, tb_bool_t fbe, tb_bool_t tbe, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    switch (ttype)
+    {
+    case TB_CHARSET_TYPE_UTF16: tb_charset_bulk_done(TB_CHARSET_TYPE_UTF8, fbe, TB_CHARSET_TYPE_UTF16, tbe, fst, tst); break;
+    case TB_CHARSET_TYPE_UCS2:  tb_charset_bulk_done(TB_CHARSET_TYPE_UTF8, fbe, TB_CHARSET_TYPE_UCS2, tbe, fst, tst); break;
+    default:                    tb_charset_bulk_done(TB_CHARSET_TYPE_UTF8, fbe, TB_CHARSET_TYPE_UCS4, tbe, fst, tst); break;
+    }
+}
+
+// the given wide charset to the utf8 character
+static tb_void_t tb_charset_bulk_done_to_utf8(tb_size_t ftype, tb_bool_t fbe, tb_bool_t tbe, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    switch (ftype)
+    {
+    case TB_CHARSET_TYPE_UTF16: tb_charset_bulk_done(TB_CHARSET_TYPE_UTF16, fbe, TB_CHARSET_TYPE_UTF8, tbe, fst, tst); break;
+    case TB_CHARSET_TYPE_UCS2:  tb_charset_bulk_done(TB_CHARSET_TYPE_UCS2, fbe, TB_CHARSET_TYPE_UTF8, tbe, fst, tst); break;
+    default:                    tb_charset_bulk_done(TB_CHARSET_TYPE_UCS4, fbe, TB_CHARSET_TYPE_UTF8, tbe, fst, tst); break;
+    }
+}
+
+// the gb2312 character to the given unicode charset
+static tb_void_t tb_charset_bulk_done_gb2312_to(tb_size_t ttype, tb_bool_t fbe, tb_bool_t tbe, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    switch (ttype)
+    {
+    case TB_CHARSET_TYPE_UTF8:  tb_charset_bulk_done(TB_CHARSET_TYPE_GB2312, fbe, TB_CHARSET_TYPE_UTF8, tbe, fst, tst); break;
+    case TB_CHARSET_TYPE_UTF16: tb_charset_bulk_done(TB_CHARSET_TYPE_GB2312, fbe, TB_CHARSET_TYPE_UTF16, tbe, fst, tst); break;
+    case TB_CHARSET_TYPE_UCS2:  tb_charset_bulk_done(TB_CHARSET_TYPE_GB2312, fbe, TB_CHARSET_TYPE_UCS2, tbe, fst, tst); break;
+    default:                    tb_charset_bulk_done(TB_CHARSET_TYPE_GB2312, fbe, TB_CHARSET_TYPE_UCS4, tbe, fst, tst); break;
+    }
+}
+
+// is the byte charset which is compatible with ascii?
+static __tb_inline__ tb_bool_t tb_charset_bulk_is_ascii(tb_size_t type)
+{
+    return type == TB_CHARSET_TYPE_ASCII || type == TB_CHARSET_TYPE_UTF8 || type == TB_CHARSET_TYPE_GB2312 || type == TB_CHARSET_TYPE_GBK || type == TB_CHARSET_TYPE_ISO8859;
+}
+
+// is the unicode wide charset?
+static __tb_inline__ tb_bool_t tb_charset_bulk_is_wide(tb_size_t type)
+{
+    return type == TB_CHARSET_TYPE_UTF16 || type == TB_CHARSET_TYPE_UCS2 || type == TB_CHARSET_TYPE_UTF32 || type == TB_CHARSET_TYPE_UCS4;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_charset_bulk_conv(tb_size_t ftype, tb_size_t ttype, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst);
+tb_bool_t tb_charset_bulk_conv(tb_size_t ftype, tb_size_t ttype, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst)
+{
+    // big endian?
+    tb_bool_t fbe = !(ftype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+    tb_bool_t tbe = !(ttype & TB_CHARSET_TYPE_LE)? tb_true : tb_false;
+
+    // the charsets
+    ftype = TB_CHARSET_TYPE(ftype);
+    ttype = TB_CHARSET_TYPE(ttype);
+
+    // utf8 => utf16, ucs2, ucs4, utf32
+    if (ftype == TB_CHARSET_TYPE_UTF8 && tb_charset_bulk_is_wide(ttype))
+        tb_charset_bulk_done_utf8_to(ttype, fbe, tbe, fst, tst);
+    // utf16, ucs2, ucs4, utf32 => utf8
+    else if (tb_charset_bulk_is_wide(ftype) && ttype == TB_CHARSET_TYPE_UTF8)
+        tb_charset_bulk_done_to_utf8(ftype, fbe, tbe, fst, tst);
+    // gb2312, gbk => utf8, utf16, ucs2, ucs4, utf32
+    else if ((ftype == TB_CHARSET_TYPE_GB2312 || ftype == TB_CHARSET_TYPE_GBK) && (ttype == TB_CHARSET_TYPE_UTF8 || tb_charset_bulk_is_wide(ttype)))
+        tb_charset_bulk_done_gb2312_to(ttype, fbe, tbe, fst, tst);
+    // the ascii characters between the byte charsets
+    else if (tb_charset_bulk_is_ascii(ftype) && tb_charset_bulk_is_ascii(ttype))
+        tb_charset_bulk_done_ascii(fst, tst);
+    // not supported
+    else return tb_false;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_charset_utf8_check(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data || !size, tb_false);
+
+    // done
+    tb_byte_t const* p = data;
+    tb_byte_t const* e = data + size;
+    while (p < e)
+    {
+        // skip the ascii characters
+        p += tb_charset_bulk_ascii_size(p, e);
+        tb_check_break(p < e);
+
+        // the sequence size and the valid range of the second byte
+        tb_byte_t   b = *p;
+        tb_size_t   n = 0;
+        tb_byte_t   lo = 0x80;
+        tb_byte_t   hi = 0xbf;
+        if (b >= 0xc2 && b <= 0xdf) n = 2;
+        else if (b >= 0xe0 && b <= 0xef)
+        {
+            // no overlong and surrogates
+            n = 3;
+            if (b == 0xe0) lo = 0xa0;
+            else if (b == 0xed) hi = 0x9f;
+        }
+        else if (b >= 0xf0 && b <= 0xf4)
+        {
+            // no overlong and > 0x10ffff
+            n = 4;
+            if (b == 0xf0) lo = 0x90;
+            else if (b == 0xf4) hi = 0x8f;
+        }
+        else return tb_false;
+
+        // check the continuation bytes
+        tb_check_return_val(p + n <= e && p[1] >= lo && p[1] <= hi, tb_false);
+        if (n > 2 && (p[2] & 0xc0) != 0x80) return tb_false;
+        if (n > 3 && (p[3] & 0xc0) != 0x80) return tb_false;
+        p += n;
+    }
+
+    // ok
+    return tb_true;
+}
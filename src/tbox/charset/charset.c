@@ -62,6 +62,9 @@ tb_long_t tb_charset_gb2312_set(tb_static_stream_ref_t sstream, tb_bool_t be, tb
 tb_long_t tb_charset_iso8859_get(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t* ch);
 tb_long_t tb_charset_iso8859_set(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t ch);
 
+// bulk
+tb_bool_t tb_charset_bulk_conv(tb_size_t ftype, tb_size_t ttype, tb_static_stream_ref_t fst, tb_static_stream_ref_t tst);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -178,9 +181,17 @@ tb_long_t tb_charset_conv_bst(tb_size_t ftype, tb_size_t ttype, tb_static_stream
 
     // walk
     tb_uint32_t         ch;
+    tb_bool_t           bulk = tb_true;
     tb_byte_t const*    tp = tb_static_stream_pos(tst);
     while (tb_static_stream_left(fst) && tb_static_stream_left(tst))
     {
+        // convert the common characters in bulk first, the left characters will be converted one by one
+        if (bulk)
+        {
+            bulk = tb_charset_bulk_conv(ftype, ttype, fst, tst);
+            if (!tb_static_stream_left(fst) || !tb_static_stream_left(tst)) break;
+        }
+
         // get ucs4 character
         tb_long_t ok = 0;
         if ((ok = fr->get(fst, fbe, &ch)) > 0)
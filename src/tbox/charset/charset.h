@@ -179,6 +179,17 @@ tb_long_t           tb_charset_conv_cstr(tb_size_t ftype, tb_size_t ttype, tb_ch
  */
 tb_long_t           tb_charset_conv_data(tb_size_t ftype, tb_size_t ttype, tb_byte_t const* idata, tb_size_t isize, tb_byte_t* odata, tb_size_t osize);
 
+/*! check whether the data is the valid utf8 string
+ *
+ * the overlong sequences, the surrogates and the characters larger than 0x10ffff are invalid.
+ *
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_charset_utf8_check(tb_byte_t const* data, tb_size_t size);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -66,6 +66,11 @@ static tb_uint32_t tb_charset_gb2312_to_ucs4(tb_uint32_t ch)
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+tb_uint16_t const* tb_charset_gb2312_to_ucs4_table(tb_noarg_t);
+tb_uint16_t const* tb_charset_gb2312_to_ucs4_table(tb_noarg_t)
+{
+    return g_charset_gb2312_to_ucs4_table_data;
+}
 tb_long_t tb_charset_gb2312_get(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t* ch);
 tb_long_t tb_charset_gb2312_get(tb_static_stream_ref_t sstream, tb_bool_t be, tb_uint32_t* ch)
 {
@@ -89,6 +89,17 @@ static tb_long_t tb_array_iterator_ptr_comp(tb_iterator_ref_t iterator, tb_cpoin
 {
     return (litem < ritem)? -1 : (litem > ritem);
 }
+static tb_pointer_t tb_array_iterator_ptr_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator);
+
+    // the pointers are compared as the unsigned integers
+    if (ptype) *ptype = TB_ITERATOR_DATA_TYPE_UINT;
+
+    // the items
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * iterator implementation for memory element
@@ -117,6 +128,14 @@ static tb_long_t tb_array_iterator_mem_comp(tb_iterator_ref_t iterator, tb_cpoin
     // compare it
     return tb_memcmp(litem, ritem, iterator->step);
 }
+static tb_pointer_t tb_array_iterator_mem_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator);
+
+    // the items
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * iterator implementation for c-string element
@@ -144,6 +163,17 @@ static tb_long_t tb_array_iterator_long_comp(tb_iterator_ref_t iterator, tb_cpoi
 {
     return ((tb_long_t)litem < (tb_long_t)ritem)? -1 : ((tb_long_t)litem > (tb_long_t)ritem);
 }
+static tb_pointer_t tb_array_iterator_long_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator);
+
+    // the signed integers
+    if (ptype) *ptype = TB_ITERATOR_DATA_TYPE_SINT;
+
+    // the items
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -167,6 +197,7 @@ tb_iterator_ref_t tb_array_iterator_init_ptr(tb_array_iterator_ref_t iterator, t
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_ptr_data
     };
 
     // init iterator
@@ -200,6 +231,7 @@ tb_iterator_ref_t tb_array_iterator_init_mem(tb_array_iterator_ref_t iterator, t
     ,   tb_array_iterator_mem_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_mem_data
     };
 
     // init
@@ -233,6 +265,7 @@ tb_iterator_ref_t tb_array_iterator_init_str(tb_array_iterator_ref_t iterator, t
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_mem_data
     };
 
     // init iterator
@@ -266,6 +299,7 @@ tb_iterator_ref_t tb_array_iterator_init_istr(tb_array_iterator_ref_t iterator,
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_mem_data
     };
 
     // init iterator
@@ -304,6 +338,7 @@ tb_iterator_ref_t tb_array_iterator_init_long(tb_array_iterator_ref_t iterator,
     ,   tb_array_iterator_ptr_copy
     ,   tb_null
     ,   tb_null
+    ,   tb_array_iterator_long_data
     };
 
     // init iterator
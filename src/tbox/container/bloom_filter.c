@@ -34,6 +34,7 @@
 #include "../libm/libm.h"
 #include "../math/math.h"
 #include "../utils/utils.h"
+#include "../hash/hash.h"
 #include "../memory/memory.h"
 #include "../stream/stream.h"
 #include "../platform/platform.h"
@@ -92,6 +93,59 @@ typedef struct __tb_bloom_filter_t
 
 }tb_bloom_filter_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* compute the two hashes of the double hashing, the bit index i is (hash0 + i * hash1) & mask
+ *
+ * so we only hash the data once by the 128-bits wyhash for any hash count, and hash1 is odd to walk all bits of the mask.
+ */
+static tb_void_t tb_bloom_filter_hash(tb_bloom_filter_t* filter, tb_cpointer_t data, tb_size_t* hash0, tb_size_t* hash1)
+{
+    // get the data bytes of the element
+    tb_byte_t const*    bytes = tb_null;
+    tb_size_t           size = 0;
+    switch (filter->element.type)
+    {
+    case TB_ELEMENT_TYPE_STR:
+        bytes = (tb_byte_t const*)data;
+        size = bytes? tb_strlen((tb_char_t const*)bytes) : 0;
+        break;
+    case TB_ELEMENT_TYPE_MEM:
+        bytes = (tb_byte_t const*)data;
+        size = filter->element.size;
+        break;
+    case TB_ELEMENT_TYPE_LONG:
+    case TB_ELEMENT_TYPE_SIZE:
+    case TB_ELEMENT_TYPE_UINT8:
+    case TB_ELEMENT_TYPE_UINT16:
+    case TB_ELEMENT_TYPE_UINT32:
+    case TB_ELEMENT_TYPE_PTR:
+        // the value is stored in the pointer
+        bytes = (tb_byte_t const*)&data;
+        size = sizeof(tb_cpointer_t);
+        break;
+    default:
+        break;
+    }
+
+    // make the two hashes from one 128-bits wyhash
+    if (bytes)
+    {
+        tb_uint64_t hash[2];
+        tb_wyhash_make128(bytes, size, 0, hash);
+        *hash0 = (tb_size_t)hash[0];
+        *hash1 = (tb_size_t)hash[1] | 1;
+    }
+    // the other elements (e.g. obj, user) only have the hash function, so we hash them twice
+    else
+    {
+        *hash0 = filter->element.hash(&filter->element, data, ~(tb_size_t)0, 0);
+        *hash1 = filter->element.hash(&filter->element, data, ~(tb_size_t)0, 1) | 1;
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -246,6 +300,11 @@ tb_bool_t tb_bloom_filter_set(tb_bloom_filter_ref_t self, tb_cpointer_t data)
     tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
     tb_assert_and_check_return_val(filter, tb_false);
 
+    // the double hashing
+    tb_size_t hash0 = 0;
+    tb_size_t hash1 = 0;
+    tb_bloom_filter_hash(filter, data, &hash0, &hash1);
+
     // walk
     tb_size_t i = 0;
     tb_size_t n = filter->hash_count;
@@ -253,7 +312,7 @@ tb_bool_t tb_bloom_filter_set(tb_bloom_filter_ref_t self, tb_cpointer_t data)
     for (i = 0; i < n; i++)
     {
         // compute the bit index
-        tb_size_t index = filter->element.hash(&filter->element, data, filter->mask, i);
+        tb_size_t index = (hash0 + i * hash1) & filter->mask;
         if (index >= (filter->size << 3)) index %= (filter->size << 3);
 
         // not exists?
@@ -276,13 +335,18 @@ tb_bool_t tb_bloom_filter_get(tb_bloom_filter_ref_t self, tb_cpointer_t data)
     tb_bloom_filter_t* filter = (tb_bloom_filter_t*)self;
     tb_assert_and_check_return_val(filter, tb_false);
 
+    // the double hashing
+    tb_size_t hash0 = 0;
+    tb_size_t hash1 = 0;
+    tb_bloom_filter_hash(filter, data, &hash0, &hash1);
+
     // walk
     tb_size_t i = 0;
     tb_size_t n = filter->hash_count;
     for (i = 0; i < n; i++)
     {
         // compute the bit index
-        tb_size_t index = filter->element.hash(&filter->element, data, filter->mask, i);
+        tb_size_t index = (hash0 + i * hash1) & filter->mask;
         if (index >= (filter->size << 3)) index %= (filter->size << 3);
 
         // not exists? break it
@@ -34,8 +34,11 @@
 #include "vector.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "flat_hash_map.h"
 #include "queue.h"
 #include "circle_queue.h"
+#include "mpmc_queue.h"
+#include "spsc_queue.h"
 #include "priority_queue.h"
 #include "list.h"
 #include "list_entry.h"
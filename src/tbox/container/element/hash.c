@@ -24,97 +24,6 @@
 #include "hash.h"
 #include "../../hash/hash.h"
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * data hash implementation
- */
-static tb_size_t tb_element_hash_data_func_0(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_bkdr_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_1(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_adler32_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_2(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_fnv32_1a_make(data, size, 0);
-}
-#if !defined(__tb_small__) && defined(TB_CONFIG_MODULE_HAVE_HASH)
-static tb_size_t tb_element_hash_data_func_3(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_ap_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_4(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_murmur_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_5(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_crc32_le_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_6(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_fnv32_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_7(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_djb2_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_8(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_blizzard_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_9(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_rs_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_10(tb_byte_t const* data, tb_size_t size)
-{
-    return tb_sdbm_make(data, size, 0);
-}
-static tb_size_t tb_element_hash_data_func_11(tb_byte_t const* data, tb_size_t size)
-{
-    // using md5, better but too slower
-    tb_byte_t b[16] = {0};
-    tb_md5_make(data, size, b, 16);
-    return tb_bits_get_u32_ne(b);
-}
-static tb_size_t tb_element_hash_data_func_12(tb_byte_t const* data, tb_size_t size)
-{
-    // using sha, better but too slower
-    tb_byte_t b[32] = {0};
-    tb_sha_make(TB_SHA_MODE_SHA1_160, data, size, b, 32);
-    return tb_bits_get_u32_ne(b);
-}
-static tb_size_t tb_element_hash_data_func_13(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-static tb_size_t tb_element_hash_data_func_14(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-static tb_size_t tb_element_hash_data_func_15(tb_byte_t const* data, tb_size_t size)
-{
-    tb_trace_noimpl();
-    return 0;
-}
-#endif
-
-/* //////////////////////////////////////////////////////////////////////////////////////
- * cstr hash implementation
- */
-static tb_size_t tb_element_hash_cstr_func_0(tb_char_t const* data)
-{
-    return tb_bkdr_make_from_cstr(data, 0);
-}
-static tb_size_t tb_element_hash_cstr_func_1(tb_char_t const* data)
-{
-    return tb_fnv32_1a_make_from_cstr(data, 0);
-}
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * uint8 hash implementation
  */
@@ -271,55 +180,24 @@ tb_size_t tb_element_hash_uint64(tb_uint64_t value, tb_size_t mask, tb_size_t in
 tb_size_t tb_element_hash_data(tb_byte_t const* data, tb_size_t size, tb_size_t mask, tb_size_t index)
 {
     // check
-    tb_assert_and_check_return_val(data && size && mask, 0);
+    tb_assert_and_check_return_val(data && mask, 0);
 
-    // the func
-    static tb_size_t (*s_func[])(tb_byte_t const* , tb_size_t) =
-    {
-        tb_element_hash_data_func_0
-    ,   tb_element_hash_data_func_1
-    ,   tb_element_hash_data_func_2
-#if !defined(__tb_small__) && defined(TB_CONFIG_MODULE_HAVE_HASH)
-    ,   tb_element_hash_data_func_3
-    ,   tb_element_hash_data_func_4
-    ,   tb_element_hash_data_func_5
-    ,   tb_element_hash_data_func_6
-    ,   tb_element_hash_data_func_7
-    ,   tb_element_hash_data_func_8
-    ,   tb_element_hash_data_func_9
-    ,   tb_element_hash_data_func_10
-    ,   tb_element_hash_data_func_11
-    ,   tb_element_hash_data_func_12
-    ,   tb_element_hash_data_func_13
-    ,   tb_element_hash_data_func_14
-    ,   tb_element_hash_data_func_15
-#endif
-    };
-    tb_assert_and_check_return_val(index < tb_arrayn(s_func), 0);
+    // the first hash
+    if (!index) return (tb_size_t)tb_wyhash_make(data, size, 0) & mask;
 
-    // done
-    return s_func[index](data, size) & mask;
+    /* the double hashing from the 128-bits hash, hash[0] + index * hash[1]
+     *
+     * hash[0] is the first hash and hash[1] is odd, so all slots of the power-of-2 mask can be walked
+     */
+    tb_uint64_t hash[2];
+    tb_wyhash_make128(data, size, 0, hash);
+    return (tb_size_t)(hash[0] + index * (hash[1] | 1)) & mask;
 }
 tb_size_t tb_element_hash_cstr(tb_char_t const* cstr, tb_size_t mask, tb_size_t index)
 {
     // check
     tb_assert_and_check_return_val(cstr && mask, 0);
 
-    // for optimization
-    if (index < 2)
-    {
-        // the func
-        static tb_size_t (*s_func[])(tb_char_t const*) =
-        {
-            tb_element_hash_cstr_func_0
-        ,   tb_element_hash_cstr_func_1
-        };
-        tb_assert_and_check_return_val(index < tb_arrayn(s_func), 0);
-
-        // done
-        return s_func[index](cstr) & mask;
-    }
-
-    // using the data hash
+    // get the length only once and hash it by words
     return tb_element_hash_data((tb_byte_t const*)cstr, tb_strlen(cstr), mask, index);
 }
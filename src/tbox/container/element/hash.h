@@ -76,6 +76,8 @@ tb_size_t           tb_element_hash_uint32(tb_uint32_t value, tb_size_t mask, tb
 tb_size_t           tb_element_hash_uint64(tb_uint64_t value, tb_size_t mask, tb_size_t index);
 
 /* compute the data hash
+ *
+ * the hashes of the non-zero index are made by the double hashing from one 128-bits wyhash
  *
  * @param data      the data
  * @param size      the size
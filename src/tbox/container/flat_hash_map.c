@@ -0,0 +1,685 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "flat_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../algorithm/algorithm.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the group size of the control bytes
+#define TB_FLAT_HASH_MAP_GROUP_SIZE             (16)
+
+// the control byte for the empty slot
+#define TB_FLAT_HASH_MAP_CTRL_EMPTY             (0x80)
+
+// the control byte for the deleted slot
+#define TB_FLAT_HASH_MAP_CTRL_DELETED           (0xfe)
+
+// is full slot? the control byte of the full slot is the 7-bits hash tag
+#define tb_flat_hash_map_ctrl_is_full(c)        (!((c) & 0x80))
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT   (16)
+#else
+#   define TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT   (64)
+#endif
+
+// the maximum load factor: 7/8
+#define tb_flat_hash_map_growth_maxn(capacity)  ((capacity) - ((capacity) >> 3))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the flat hash map type
+typedef struct __tb_flat_hash_map_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the control bytes, one byte for each slot
+    tb_byte_t*                      ctrl;
+
+    // the slots, the name and data are stored inline
+    tb_byte_t*                      slots;
+
+    // the slot capacity, it's the power of 2 and not less than the group size
+    tb_size_t                       capacity;
+
+    // the item size
+    tb_size_t                       item_size;
+
+    // the left item count for inserting before growing
+    tb_size_t                       growth_left;
+
+    // the current item for iterator
+    tb_flat_hash_map_item_t         item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_flat_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * group implementation
+ */
+#ifdef TB_ARCH_SSE2
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* group, tb_byte_t tag)
+{
+    __m128i ctrl = _mm_loadu_si128((__m128i const*)group);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((tb_char_t)tag), ctrl));
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_free(tb_byte_t const* group)
+{
+    // the empty and deleted control bytes have the highest bit
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)group));
+}
+#else
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* group, tb_byte_t tag)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_SIZE; i++)
+        if (group[i] == tag) m |= (1 << i);
+    return m;
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_free(tb_byte_t const* group)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t m = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_SIZE; i++)
+        if (group[i] & 0x80) m |= (1 << i);
+    return m;
+}
+#endif
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_empty(tb_byte_t const* group)
+{
+    return tb_flat_hash_map_group_match(group, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash(tb_flat_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    // compute the full hash value
+    tb_size_t hash = hash_map->element_name.hash(&hash_map->element_name, name, ~(tb_size_t)0, 0);
+
+    /* mix it, because the low bits are used for the hash tag and the high bits are used for the group index
+     * and some element hash functions are too weak, .e.g uint8
+     */
+#if TB_CPU_BIT64
+    hash ^= hash >> 33;
+    hash *= (tb_size_t)0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+#else
+    hash ^= hash >> 16;
+    hash *= (tb_size_t)0x85ebca6b;
+    hash ^= hash >> 13;
+#endif
+    return hash;
+}
+static __tb_inline__ tb_byte_t* tb_flat_hash_map_slot(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    return hash_map->slots + slot * (hash_map->element_name.size + hash_map->element_data.size);
+}
+static __tb_inline__ tb_pointer_t tb_flat_hash_map_slot_name(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    return hash_map->element_name.data(&hash_map->element_name, tb_flat_hash_map_slot(hash_map, slot));
+}
+static tb_bool_t tb_flat_hash_map_slot_find(tb_flat_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t hash, tb_size_t* pslot)
+{
+    // check
+    tb_assert(hash_map && hash_map->ctrl && hash_map->capacity);
+
+    // the hash tag
+    tb_byte_t tag = (tb_byte_t)(hash & 0x7f);
+
+    // probe the groups, we use the triangular numbers for probing all groups
+    tb_size_t i = 0;
+    tb_size_t mask = (hash_map->capacity / TB_FLAT_HASH_MAP_GROUP_SIZE) - 1;
+    tb_size_t group = (hash >> 7) & mask;
+    while (i <= mask)
+    {
+        // find the matched slots
+        tb_byte_t const*    ctrl = hash_map->ctrl + group * TB_FLAT_HASH_MAP_GROUP_SIZE;
+        tb_uint32_t         match = tb_flat_hash_map_group_match(ctrl, tag);
+        while (match)
+        {
+            // the slot
+            tb_size_t slot = group * TB_FLAT_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(match);
+
+            // is this?
+            if (!hash_map->element_name.comp(&hash_map->element_name, name, tb_flat_hash_map_slot_name(hash_map, slot)))
+            {
+                if (pslot) *pslot = slot;
+                return tb_true;
+            }
+
+            // next
+            match &= match - 1;
+        }
+
+        // end? the item will be placed to this group if not found
+        tb_check_break(!tb_flat_hash_map_group_match_empty(ctrl));
+
+        // the next group
+        group = (group + ++i) & mask;
+    }
+
+    // not found
+    return tb_false;
+}
+static tb_size_t tb_flat_hash_map_slot_free(tb_byte_t const* ctrl_list, tb_size_t capacity, tb_size_t hash)
+{
+    // probe the groups
+    tb_size_t i = 0;
+    tb_size_t mask = (capacity / TB_FLAT_HASH_MAP_GROUP_SIZE) - 1;
+    tb_size_t group = (hash >> 7) & mask;
+    while (1)
+    {
+        // find the first empty or deleted slot
+        tb_uint32_t match = tb_flat_hash_map_group_match_free(ctrl_list + group * TB_FLAT_HASH_MAP_GROUP_SIZE);
+        if (match) return group * TB_FLAT_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(match);
+
+        // the next group, the load factor is less than 1, so we always can find it
+        group = (group + ++i) & mask;
+        tb_assert(i <= mask);
+    }
+
+    // unreachable
+    return 0;
+}
+static tb_bool_t tb_flat_hash_map_resize(tb_flat_hash_map_t* hash_map, tb_size_t capacity)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && capacity >= TB_FLAT_HASH_MAP_GROUP_SIZE && tb_ispow2(capacity), tb_false);
+    tb_assert_and_check_return_val(tb_flat_hash_map_growth_maxn(capacity) >= hash_map->item_size, tb_false);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, tb_false);
+
+    // make the new control bytes and slots
+    tb_byte_t* ctrl = (tb_byte_t*)tb_malloc_bytes(capacity);
+    tb_byte_t* slots = (tb_byte_t*)tb_nalloc(capacity, step);
+    if (!ctrl || !slots)
+    {
+        if (ctrl) tb_free(ctrl);
+        if (slots) tb_free(slots);
+        return tb_false;
+    }
+    tb_memset(ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY, capacity);
+
+    // move all items to the new slots, the ownership of the item is moved with the raw bytes
+    if (hash_map->ctrl)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->capacity;
+        for (i = 0; i < n; i++)
+        {
+            // full?
+            tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[i]));
+
+            // the hash
+            tb_size_t hash = tb_flat_hash_map_hash(hash_map, tb_flat_hash_map_slot_name(hash_map, i));
+
+            // move it
+            tb_size_t slot = tb_flat_hash_map_slot_free(ctrl, capacity, hash);
+            ctrl[slot] = (tb_byte_t)(hash & 0x7f);
+            tb_memcpy(slots + slot * step, hash_map->slots + i * step, step);
+        }
+
+        // free the old control bytes and slots
+        tb_free(hash_map->ctrl);
+        tb_free(hash_map->slots);
+    }
+
+    // trace
+    tb_trace_d("resize: %lu => %lu, items: %lu", hash_map->capacity, capacity, hash_map->item_size);
+
+    // update the hash map
+    hash_map->ctrl          = ctrl;
+    hash_map->slots         = slots;
+    hash_map->capacity      = capacity;
+    hash_map->growth_left   = tb_flat_hash_map_growth_maxn(capacity) - hash_map->item_size;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_flat_hash_map_slot_remove(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    // check
+    tb_assert(hash_map && slot < hash_map->capacity && tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[slot]));
+
+    // free item
+    tb_byte_t* item = tb_flat_hash_map_slot(hash_map, slot);
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+
+    /* mark it as empty if this group has empty slots,
+     * because the probing will be stopped at this group and it will not break the probing sequence of other items
+     */
+    if (tb_flat_hash_map_group_match_empty(hash_map->ctrl + (slot & ~(TB_FLAT_HASH_MAP_GROUP_SIZE - 1))))
+    {
+        hash_map->ctrl[slot] = TB_FLAT_HASH_MAP_CTRL_EMPTY;
+        hash_map->growth_left++;
+    }
+    else hash_map->ctrl[slot] = TB_FLAT_HASH_MAP_CTRL_DELETED;
+
+    // update the item size
+    hash_map->item_size--;
+}
+static tb_size_t tb_flat_hash_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // the size
+    return hash_map->item_size;
+}
+static tb_size_t tb_flat_hash_map_itor_from(tb_flat_hash_map_t* hash_map, tb_size_t slot)
+{
+    // find the next full slot
+    tb_size_t n = hash_map->capacity;
+    for (; slot < n; slot++)
+    {
+        if (tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[slot]))
+            return slot + 1;
+    }
+
+    // tail
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // find the head
+    return tb_flat_hash_map_itor_from(hash_map, 0);
+}
+static tb_size_t tb_flat_hash_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->capacity);
+
+    // find the next
+    return tb_flat_hash_map_itor_from(hash_map, itor);
+}
+static tb_pointer_t tb_flat_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return_val(hash_map && itor && itor <= hash_map->capacity, tb_null);
+
+    // the slot
+    tb_size_t slot = itor - 1;
+    tb_assert_and_check_return_val(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[slot]), tb_null);
+
+    // get item
+    tb_byte_t* item = tb_flat_hash_map_slot(hash_map, slot);
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, item);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, item + hash_map->element_name.size);
+    return &(hash_map->item);
+}
+static tb_void_t tb_flat_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->capacity);
+
+    // the slot
+    tb_size_t slot = itor - 1;
+    tb_check_return(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[slot]));
+
+    // note: copy data only, will destroy hash_map index if copy name
+    hash_map->element_data.copy(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, slot) + hash_map->element_name.size, item);
+}
+static tb_long_t tb_flat_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && hash_map->element_name.comp && lelement && relement);
+
+    // done
+    return hash_map->element_name.comp(&hash_map->element_name, ((tb_flat_hash_map_item_ref_t)lelement)->name, ((tb_flat_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_flat_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->capacity);
+
+    // remove it, the other items will not be moved
+    tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+}
+static tb_void_t tb_flat_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // no size
+    tb_check_return(size);
+
+    // remove items: [itor, next)
+    tb_size_t itor = prev? tb_flat_hash_map_itor_next(iterator, prev) : tb_flat_hash_map_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        // the next item will not be changed after removing the current item
+        tb_size_t item_next = tb_flat_hash_map_itor_next(iterator, itor);
+
+        // remove it
+        tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+
+        // next
+        itor = item_next;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_flat_hash_map_ref_t tb_flat_hash_map_init(tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // check item maxn
+    if (!item_maxn) item_maxn = TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT;
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_flat_hash_map_t* hash_map = tb_null;
+    do
+    {
+        // make self
+        hash_map = tb_malloc0_type(tb_flat_hash_map_t);
+        tb_assert_and_check_break(hash_map);
+
+        // init self func
+        hash_map->element_name = element_name;
+        hash_map->element_data = element_data;
+
+        // init operation
+        static tb_iterator_op_t op =
+        {
+            tb_flat_hash_map_itor_size
+        ,   tb_flat_hash_map_itor_head
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_tail
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_next
+        ,   tb_flat_hash_map_itor_item
+        ,   tb_flat_hash_map_itor_comp
+        ,   tb_flat_hash_map_itor_copy
+        ,   tb_flat_hash_map_itor_remove
+        ,   tb_flat_hash_map_itor_nremove
+        };
+
+        // init iterator
+        hash_map->itor.priv = tb_null;
+        hash_map->itor.step = sizeof(tb_flat_hash_map_item_t);
+        hash_map->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.op   = &op;
+
+        // init the slots, the load factor is 7/8
+        tb_size_t capacity = tb_align_pow2(item_maxn + (item_maxn >> 3) + 1);
+        if (capacity < TB_FLAT_HASH_MAP_GROUP_SIZE) capacity = TB_FLAT_HASH_MAP_GROUP_SIZE;
+        if (!tb_flat_hash_map_resize(hash_map, capacity)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_flat_hash_map_exit((tb_flat_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_flat_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_flat_hash_map_exit(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // clear it
+    tb_flat_hash_map_clear(self);
+
+    // free the control bytes and slots
+    if (hash_map->ctrl) tb_free(hash_map->ctrl);
+    if (hash_map->slots) tb_free(hash_map->slots);
+
+    // free it
+    tb_free(hash_map);
+}
+tb_void_t tb_flat_hash_map_clear(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // no slots?
+    tb_check_return(hash_map->ctrl);
+
+    // free items
+    if (hash_map->item_size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->capacity;
+        for (i = 0; i < n; i++)
+        {
+            tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl[i]));
+
+            tb_byte_t* item = tb_flat_hash_map_slot(hash_map, i);
+            if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, item);
+            if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, item + hash_map->element_name.size);
+        }
+    }
+
+    // reset the control bytes
+    tb_memset(hash_map->ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY, hash_map->capacity);
+
+    // reset info
+    hash_map->item_size     = 0;
+    hash_map->growth_left   = tb_flat_hash_map_growth_maxn(hash_map->capacity);
+    tb_memset(&hash_map->item, 0, sizeof(tb_flat_hash_map_item_t));
+}
+tb_pointer_t tb_flat_hash_map_get(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_null);
+
+    // find it
+    tb_size_t slot = 0;
+    if (!tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &slot)) return tb_null;
+
+    // get data
+    return hash_map->element_data.data(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, slot) + hash_map->element_name.size);
+}
+tb_size_t tb_flat_hash_map_find(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tb_size_t slot = 0;
+    return tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &slot)? slot + 1 : 0;
+}
+tb_size_t tb_flat_hash_map_insert(tb_flat_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tb_size_t slot = 0;
+    tb_size_t hash = tb_flat_hash_map_hash(hash_map, name);
+    if (tb_flat_hash_map_slot_find(hash_map, name, hash, &slot))
+    {
+        // replace data
+        hash_map->element_data.repl(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, slot) + hash_map->element_name.size, data);
+    }
+    else
+    {
+        // find a free slot
+        slot = tb_flat_hash_map_slot_free(hash_map->ctrl, hash_map->capacity, hash);
+
+        // no space for the empty slot? grow it or drop the deleted slots
+        if (!hash_map->growth_left && hash_map->ctrl[slot] == TB_FLAT_HASH_MAP_CTRL_EMPTY)
+        {
+            // only rehash it in place if there are too many deleted slots
+            tb_size_t capacity = hash_map->capacity;
+            if (hash_map->item_size > (tb_flat_hash_map_growth_maxn(capacity) >> 1)) capacity <<= 1;
+            if (!tb_flat_hash_map_resize(hash_map, capacity)) return 0;
+
+            // find a free slot again
+            slot = tb_flat_hash_map_slot_free(hash_map->ctrl, hash_map->capacity, hash);
+        }
+
+        // update the growth left
+        if (hash_map->ctrl[slot] == TB_FLAT_HASH_MAP_CTRL_EMPTY)
+        {
+            tb_assert(hash_map->growth_left);
+            hash_map->growth_left--;
+        }
+
+        // dupl item
+        tb_byte_t* item = tb_flat_hash_map_slot(hash_map, slot);
+        hash_map->element_name.dupl(&hash_map->element_name, item, name);
+        hash_map->element_data.dupl(&hash_map->element_data, item + hash_map->element_name.size, data);
+
+        // mark it as full
+        hash_map->ctrl[slot] = (tb_byte_t)(hash & 0x7f);
+
+        // update the item size
+        hash_map->item_size++;
+    }
+
+    // ok?
+    return slot + 1;
+}
+tb_void_t tb_flat_hash_map_remove(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // find it
+    tb_size_t slot = 0;
+    if (tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &slot))
+        tb_flat_hash_map_slot_remove(hash_map, slot);
+}
+tb_size_t tb_flat_hash_map_size(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the size
+    return hash_map->item_size;
+}
+tb_size_t tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the maxn
+    return hash_map->capacity;
+}
+#ifdef __tb_debug__
+tb_void_t tb_flat_hash_map_dump(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->ctrl);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, capacity: %lu, growth_left: %lu", hash_map->item_size, hash_map->capacity, hash_map->growth_left);
+
+    // done
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_for_all_if (tb_flat_hash_map_item_ref_t, item, self, item)
+    {
+        // trace
+        if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+        {
+            tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else if (hash_map->element_name.cstr)
+        {
+            tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (hash_map->element_data.cstr)
+        {
+            tb_trace_i("    %x => %p", item->name, hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else
+        {
+            tb_trace_i("    %p => %p", item->name, item->data);
+        }
+    }
+}
+#endif
@@ -63,6 +63,27 @@
 // the self bucket maximum size
 #define TB_HASH_MAP_BUCKET_MAXN                         (1 << 16)
 
+/* the self bucket maximum size for growing
+ *
+ * the buckets of the old and new hash list are addressed by the same index when rehashing,
+ * so the total bucket count must be able to be stored to the buck field of the index
+ */
+#if TB_CPU_BIT64
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 30)
+#else
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 15)
+#endif
+
+// the self bucket load maximum size, will grow the hash list if the average items of the bucket exceed it
+#ifdef __tb_small__
+#   define TB_HASH_MAP_BUCKET_LOAD_MAXN                 (8)
+#else
+#   define TB_HASH_MAP_BUCKET_LOAD_MAXN                 (4)
+#endif
+
+// the self bucket count of migrating from the old hash list for each insert/remove
+#define TB_HASH_MAP_REHASH_STEP                         (8)
+
 // the self bucket item maximum size
 #define TB_HASH_MAP_BUCKET_ITEM_MAXN                    (1 << 16)
 
@@ -93,6 +114,15 @@ typedef struct __tb_hash_map_t
     // the hash list size
     tb_size_t                       hash_size;
 
+    // the old hash list, it will be migrated to the new hash list incrementally if be not null
+    tb_hash_map_item_list_t**       hash_list_old;
+
+    // the old hash list size
+    tb_size_t                       hash_size_old;
+
+    // the next bucket index of the old hash list for rehashing
+    tb_size_t                       rehash_index;
+
     // the current item for iterator
     tb_hash_map_item_t              item;
 
@@ -116,68 +146,38 @@ typedef struct __tb_hash_map_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-#if 0
-// linear finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
-{
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
-
-    // get step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, tb_false);
-
-    // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
-
-    // update buck
-    if (pbuck) *pbuck = buck;
 
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size, tb_false);
-
-    // find item
-    tb_long_t   r = 1;
-    tb_size_t   i = 0;
-    tb_size_t   n = list->size;
-    for (i = 0; i < n; i++)
-    {
-        // get item
-        tb_byte_t const* item = ((tb_byte_t*)&list[1]) + i * step;
-
-        // compare it
-        r = hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, item));
-        if (r <= 0) break;
-    }
-
-    // update item
-    if (pitem) *pitem = i;
+/* get the bucket list slot
+ *
+ * the buckets of the new hash list: [0, hash_size)
+ * the buckets of the old hash list: [hash_size, hash_size + hash_size_old)
+ */
+static __tb_inline__ tb_hash_map_item_list_t** tb_hash_map_list_slot(tb_hash_map_t* hash_map, tb_size_t buck)
+{
+    // in the new hash list?
+    if (buck < hash_map->hash_size) return &hash_map->hash_list[buck];
 
-    // ok?
-    return !r? tb_true : tb_false;
+    // in the old hash list
+    tb_assert(hash_map->hash_list_old && buck - hash_map->hash_size < hash_map->hash_size_old);
+    return &hash_map->hash_list_old[buck - hash_map->hash_size];
+}
+static __tb_inline__ tb_size_t tb_hash_map_buck_count(tb_hash_map_t* hash_map)
+{
+    return hash_map->hash_size + hash_map->hash_size_old;
 }
-#else
 // binary finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static tb_bool_t tb_hash_map_item_find_in(tb_hash_map_t* hash_map, tb_hash_map_item_list_t* list, tb_cpointer_t name, tb_size_t* pitem)
 {
-    // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
-
     // get step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
-    // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
-
-    // update buck
-    if (pbuck) *pbuck = buck;
-
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size, tb_false);
+    // empty list?
+    if (!list || !list->size)
+    {
+        if (pitem) *pitem = 0;
+        return tb_false;
+    }
 
     // find item
     tb_long_t   t = 1;
@@ -211,18 +211,277 @@ static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t na
     // ok?
     return !t? tb_true : tb_false;
 }
-#endif
+static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
+
+    // comupte hash_map from name
+    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
+
+    // find it from the new hash list
+    tb_size_t item = 0;
+    tb_bool_t ok = tb_hash_map_item_find_in(hash_map, hash_map->hash_list[buck], name, &item);
+
+    // not found? find it from the old hash list if be rehashing
+    if (!ok && hash_map->hash_list_old)
+    {
+        // comupte the old bucket
+        tb_size_t buck_old = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size_old - 1, 0);
+        tb_assert_and_check_return_val(buck_old < hash_map->hash_size_old, tb_false);
+
+        // found? update the bucket and item
+        tb_size_t item_old = 0;
+        if (tb_hash_map_item_find_in(hash_map, hash_map->hash_list_old[buck_old], name, &item_old))
+        {
+            buck    = hash_map->hash_size + buck_old;
+            item    = item_old;
+            ok      = tb_true;
+        }
+    }
+
+    /* update the bucket and item
+     *
+     * @note it will be the insert position in the new hash list if not found
+     */
+    if (pbuck) *pbuck = buck;
+    if (pitem) *pitem = item;
+
+    // ok?
+    return ok;
+}
+/* make a new item space at the given position in the bucket list of the new hash list
+ *
+ * @return the item space, the caller need init it
+ */
+static tb_byte_t* tb_hash_map_list_make_item(tb_hash_map_t* hash_map, tb_size_t buck, tb_size_t item)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && buck < hash_map->hash_size && hash_map->item_grow, tb_null);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, tb_null);
+
+    // get list
+    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    if (list)
+    {
+        // grow?
+        if (list->size >= list->maxn)
+        {
+            // resize maxn
+            tb_size_t maxn = tb_align_pow2(list->maxn + hash_map->item_grow);
+            tb_assert_and_check_return_val(maxn > list->maxn, tb_null);
+
+            // realloc it
+            list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);
+            tb_assert_and_check_return_val(list, tb_null);
+
+            // update the hash_map item maxn
+            hash_map->item_maxn += maxn - list->maxn;
+
+            // update maxn
+            list->maxn = maxn;
+
+            // reattach list
+            hash_map->hash_list[buck] = list;
+        }
+        tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, tb_null);
+
+        // move items
+        if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
+    }
+    // create list for adding item
+    else
+    {
+        // check
+        tb_assert_and_check_return_val(!item, tb_null);
+
+        // make list
+        list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + hash_map->item_grow * step);
+        tb_assert_and_check_return_val(list, tb_null);
+
+        // init list
+        list->size = 0;
+        list->maxn = hash_map->item_grow;
+
+        // attach list
+        hash_map->hash_list[buck] = list;
+
+        // update the hash_map item maxn
+        hash_map->item_maxn += list->maxn;
+    }
+
+    // update the list size
+    list->size++;
+
+    // ok
+    return ((tb_byte_t*)&list[1]) + item * step;
+}
+// migrate all items of the given bucket in the old hash list to the new hash list
+static tb_bool_t tb_hash_map_rehash_buck(tb_hash_map_t* hash_map, tb_size_t buck)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->hash_list_old && buck < hash_map->hash_size_old, tb_false);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, tb_false);
+
+    // get list
+    tb_hash_map_item_list_t* list = hash_map->hash_list_old[buck];
+    tb_check_return_val(list, tb_true);
+
+    /* move all items, the ownership of the item is moved with the raw bytes
+     *
+     * the items which will be placed to the same bucket index of the new hash list are kept in this list,
+     * and we reuse this list for the new hash list directly if the new bucket is empty
+     */
+    tb_size_t   i = 0;
+    tb_size_t   n = list->size;
+    tb_size_t   kept = 0;
+    tb_bool_t   reuse = !hash_map->hash_list[buck];
+    tb_byte_t*  data = (tb_byte_t*)&list[1];
+    for (i = 0; i < n; i++)
+    {
+        // the item name
+        tb_byte_t const* item = data + i * step;
+        tb_pointer_t name = hash_map->element_name.data(&hash_map->element_name, item);
+
+        // the new bucket
+        tb_size_t buck_new = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
+        tb_assert_and_check_break(buck_new < hash_map->hash_size);
+
+        // keep it in this list?
+        if (reuse && buck_new == buck)
+        {
+            if (kept != i) tb_memcpy(data + kept * step, item, step);
+            kept++;
+            continue;
+        }
+
+        /* find the insert position in the new hash list
+         *
+         * the items are sorted, so we append it directly if it's larger than the last item
+         */
+        tb_size_t item_new = 0;
+        tb_hash_map_item_list_t* list_new = hash_map->hash_list[buck_new];
+        if (list_new && list_new->size && hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, ((tb_byte_t*)&list_new[1]) + (list_new->size - 1) * step)) > 0)
+            item_new = list_new->size;
+        else if (tb_hash_map_item_find_in(hash_map, list_new, name, &item_new))
+        {
+            // the same name will never exist in both lists
+            tb_assert(0);
+            break;
+        }
+
+        // make and move item
+        tb_byte_t* space = tb_hash_map_list_make_item(hash_map, buck_new, item_new);
+        tb_check_break(space);
+        tb_memcpy(space, item, step);
+    }
+
+    // failed? keep the left items in the old list and try it again next time
+    if (i < n)
+    {
+        if (kept != i) tb_memmov(data + kept * step, data + i * step, (n - i) * step);
+        list->size = kept + n - i;
+        return tb_false;
+    }
+
+    // detach list
+    hash_map->hash_list_old[buck] = tb_null;
+
+    // reuse this list for the new hash list
+    if (kept)
+    {
+        list->size = kept;
+        hash_map->hash_list[buck] = list;
+    }
+    else
+    {
+        // update the hash_map item maxn
+        hash_map->item_maxn -= list->maxn;
+
+        // free list
+        tb_free(list);
+    }
+
+    // ok
+    return tb_true;
+}
+/* migrate some buckets from the old hash list to the new hash list
+ *
+ * we only migrate a few buckets for each insert/remove, so no single call will stall for rehashing all items
+ */
+static tb_void_t tb_hash_map_rehash_step(tb_hash_map_t* hash_map, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(hash_map);
+
+    // not rehashing?
+    tb_check_return(hash_map->hash_list_old);
+
+    // migrate buckets
+    while (count-- && hash_map->rehash_index < hash_map->hash_size_old)
+    {
+        if (!tb_hash_map_rehash_buck(hash_map, hash_map->rehash_index)) return;
+        hash_map->rehash_index++;
+    }
+
+    // finished? free the old hash list
+    if (hash_map->rehash_index >= hash_map->hash_size_old)
+    {
+        tb_free(hash_map->hash_list_old);
+        hash_map->hash_list_old = tb_null;
+        hash_map->hash_size_old = 0;
+        hash_map->rehash_index  = 0;
+    }
+}
+// grow the hash list and start rehashing if the load factor is too large
+static tb_void_t tb_hash_map_rehash_init(tb_hash_map_t* hash_map)
+{
+    // check
+    tb_assert_and_check_return(hash_map && hash_map->hash_list && hash_map->hash_size);
+
+    // be rehashing now?
+    tb_check_return(!hash_map->hash_list_old);
+
+    // need grow?
+    tb_check_return(hash_map->item_size > hash_map->hash_size * TB_HASH_MAP_BUCKET_LOAD_MAXN);
+    tb_check_return((hash_map->hash_size << 1) <= TB_HASH_MAP_BUCKET_GROW_MAXN);
+
+    // make the new hash list
+    tb_size_t                   hash_size = hash_map->hash_size << 1;
+    tb_hash_map_item_list_t**   hash_list = (tb_hash_map_item_list_t**)tb_nalloc0(hash_size, sizeof(tb_size_t));
+    tb_check_return(hash_list);
+
+    // start rehashing
+    hash_map->hash_list_old = hash_map->hash_list;
+    hash_map->hash_size_old = hash_map->hash_size;
+    hash_map->hash_list     = hash_list;
+    hash_map->hash_size     = hash_size;
+    hash_map->rehash_index  = 0;
+
+    // the average item count of the buckets will be limited after growing, so we need not reserve too many items for each list
+    if (hash_map->item_grow > (TB_HASH_MAP_BUCKET_LOAD_MAXN << 1)) hash_map->item_grow = TB_HASH_MAP_BUCKET_LOAD_MAXN << 1;
+
+    // trace
+    tb_trace_d("grow: %lu => %lu, items: %lu", hash_map->hash_size_old, hash_map->hash_size, hash_map->item_size);
+}
 static tb_bool_t tb_hash_map_item_at(tb_hash_map_t* hash_map, tb_size_t buck, tb_size_t item, tb_pointer_t* pname, tb_pointer_t* pdata)
 {
     // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size && buck < hash_map->hash_size, tb_false);
+    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size && buck < tb_hash_map_buck_count(hash_map), tb_false);
 
     // get step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, buck);
     tb_check_return_val(list && list->size && item < list->size, tb_false);
 
     // get name
@@ -251,10 +510,10 @@ static tb_size_t tb_hash_map_itor_head(tb_iterator_ref_t iterator)
 
     // find the head
     tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = tb_hash_map_buck_count(hash_map);
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
     return 0;
@@ -277,17 +536,18 @@ static tb_size_t tb_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t ito
     // compute index
     buck--;
     item--;
-    tb_assert(buck < hash_map->hash_size && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck < tb_hash_map_buck_count(hash_map) && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // find the next from the current buck first
-    if (hash_map->hash_list[buck] && item + 1 < hash_map->hash_list[buck]->size) return tb_hash_map_index_make(buck + 1, item + 2);
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, buck);
+    if (list && item + 1 < list->size) return tb_hash_map_index_make(buck + 1, item + 2);
 
     // find the next from the next buckets
     tb_size_t i;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = tb_hash_map_buck_count(hash_map);
     for (i = buck + 1; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        list = *tb_hash_map_list_slot(hash_map, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
 
@@ -320,14 +580,14 @@ static tb_void_t tb_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t ito
     tb_size_t b = tb_hash_map_index_buck(itor);
     tb_size_t i = tb_hash_map_index_item(itor);
     tb_assert(b && i); b--; i--;
-    tb_assert(b < hash_map->hash_size);
+    tb_assert(b < tb_hash_map_buck_count(hash_map));
 
     // step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert(step);
 
     // list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[b];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, b);
     tb_check_return(list && list->size && i < list->size);
 
     // note: copy data only, will destroy hash_map index if copy name
@@ -352,14 +612,15 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     tb_size_t buck = tb_hash_map_index_buck(itor);
     tb_size_t item = tb_hash_map_index_item(itor);
     tb_assert(buck && item); buck--; item--;
-    tb_assert(buck < hash_map->hash_size);
+    tb_assert(buck < tb_hash_map_buck_count(hash_map));
 
     // the step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert(step);
 
     // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    tb_hash_map_item_list_t** plist = tb_hash_map_list_slot(hash_map, buck);
+    tb_hash_map_item_list_t* list = *plist;
     tb_assert(list && list->size && item < list->size);
 
     // free item
@@ -378,11 +639,14 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     // remove list
     else
     {
+        // update the hash_map item maxn
+        hash_map->item_maxn -= list->maxn;
+
         // free it
         tb_free(list);
 
         // reset
-        hash_map->hash_list[buck] = tb_null;
+        *plist = tb_null;
     }
 
     // update the hash_map item size
@@ -412,7 +676,7 @@ static tb_void_t tb_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t
     // compute index
     buck_head--;
     item_head--;
-    tb_assert(buck_head < hash_map->hash_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck_head < tb_hash_map_buck_count(hash_map) && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // the last buck and the tail item
     tb_size_t buck_last;
@@ -427,11 +691,11 @@ static tb_void_t tb_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t
         // compute index
         buck_last--;
         item_tail--;
-        tb_assert(buck_last < hash_map->hash_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+        tb_assert(buck_last < tb_hash_map_buck_count(hash_map) && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
     }
     else
     {
-        buck_last = hash_map->hash_size - 1;
+        buck_last = tb_hash_map_buck_count(hash_map) - 1;
         item_tail = -1;
     }
 
@@ -443,7 +707,7 @@ static tb_void_t tb_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t
     for (buck = buck_head, item = item_head; buck <= buck_last; buck++, item = 0)
     {
         // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, buck);
         tb_check_continue(list && list->size);
 
         // the tail
@@ -561,6 +825,7 @@ tb_void_t tb_hash_map_exit(tb_hash_map_ref_t self)
 
     // free hash_map list
     if (hash_map->hash_list) tb_free(hash_map->hash_list);
+    if (hash_map->hash_list_old) tb_free(hash_map->hash_list_old);
 
     // free it
     tb_free(hash_map);
@@ -577,10 +842,11 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
 
     // clear hash_map
     tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = tb_hash_map_buck_count(hash_map);
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t** plist = tb_hash_map_list_slot(hash_map, i);
+        tb_hash_map_item_list_t* list = *plist;
         if (list)
         {
             // free items
@@ -599,9 +865,15 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
             // free list
             tb_free(list);
         }
-        hash_map->hash_list[i] = tb_null;
+        *plist = tb_null;
     }
 
+    // stop rehashing
+    if (hash_map->hash_list_old) tb_free(hash_map->hash_list_old);
+    hash_map->hash_list_old = tb_null;
+    hash_map->hash_size_old = 0;
+    hash_map->rehash_index  = 0;
+
     // reset info
     hash_map->item_size = 0;
     hash_map->item_maxn = 0;
@@ -643,16 +915,23 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, 0);
 
+    /* grow and migrate some buckets first
+     *
+     * @note we cannot do it after inserting, because it will change the returned itor
+     */
+    tb_hash_map_rehash_init(hash_map);
+    tb_hash_map_rehash_step(hash_map, TB_HASH_MAP_REHASH_STEP);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
     if (tb_hash_map_item_find(hash_map, name, &buck, &item))
     {
         // check
-        tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
+        tb_assert_and_check_return_val(buck < tb_hash_map_buck_count(hash_map), 0);
 
         // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, buck);
         tb_assert_and_check_return_val(list && list->size && item < list->size, 0);
 
         // replace data
@@ -660,71 +939,16 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
     }
     else
     {
-        // check
+        // check, the new item is always inserted to the new hash list
         tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
 
-        // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-
-        // insert item
-        if (list)
-        {
-            // grow?
-            if (list->size >= list->maxn)
-            {
-                // check
-                tb_assert_and_check_return_val(hash_map->item_grow, 0);
-
-                // resize maxn
-                tb_size_t maxn = tb_align_pow2(list->maxn + hash_map->item_grow);
-                tb_assert_and_check_return_val(maxn > list->maxn, 0);
-
-                // realloc it
-                list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);
-                tb_assert_and_check_return_val(list, 0);
-
-                // update the hash_map item maxn
-                hash_map->item_maxn += maxn - list->maxn;
-
-                // update maxn
-                list->maxn = maxn;
-
-                // reattach list
-                hash_map->hash_list[buck] = list;
-            }
-            tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, 0);
-
-            // move items
-            if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
-
-            // dupl item
-            list->size++;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]) + item * step, name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size, data);
+        // make item
+        tb_byte_t* space = tb_hash_map_list_make_item(hash_map, buck, item);
+        tb_assert_and_check_return_val(space, 0);
 
-        }
-        // create list for adding item
-        else
-        {
-            // check
-            tb_assert_and_check_return_val(hash_map->item_grow, 0);
-
-            // make list
-            list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + hash_map->item_grow * step);
-            tb_assert_and_check_return_val(list, 0);
-
-            // init list
-            list->size = 1;
-            list->maxn = hash_map->item_grow;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]), name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + hash_map->element_name.size, data);
-
-            // attach list
-            hash_map->hash_list[buck] = list;
-
-            // update the hash_map item maxn
-            hash_map->item_maxn += list->maxn;
-        }
+        // dupl item
+        hash_map->element_name.dupl(&hash_map->element_name, space, name);
+        hash_map->element_data.dupl(&hash_map->element_data, space + hash_map->element_name.size, data);
 
         // update the hash_map item size
         hash_map->item_size++;
@@ -739,6 +963,9 @@ tb_void_t tb_hash_map_remove(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return(hash_map);
 
+    // migrate some buckets first
+    tb_hash_map_rehash_step(hash_map, TB_HASH_MAP_REHASH_STEP);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -776,16 +1003,17 @@ tb_void_t tb_hash_map_dump(tb_hash_map_ref_t self)
 
     // trace
     tb_trace_i("");
-    tb_trace_i("self: size: %lu", tb_hash_map_size(self));
+    tb_trace_i("self: size: %lu, buckets: %lu, rehashing: %lu/%lu", tb_hash_map_size(self), hash_map->hash_size, hash_map->rehash_index, hash_map->hash_size_old);
 
     // done
     tb_size_t i = 0;
+    tb_size_t n = tb_hash_map_buck_count(hash_map);
     tb_char_t name[4096];
     tb_char_t data[4096];
-    for (i = 0; i < hash_map->hash_size; i++)
+    for (i = 0; i < n; i++)
     {
         // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_slot(hash_map, i);
         if (list)
         {
             // trace
@@ -88,6 +88,9 @@ typedef struct __tb_hash_map_item_t
  *
  * </pre>
  *
+ * the hash list will be grown automatically if the average item count of the buckets is too large,
+ * and the items are migrated to the new hash list incrementally, only a few buckets for each insert/remove.
+ *
  * @note the itor of the same item is mutable
  */
 typedef tb_iterator_ref_t tb_hash_map_ref_t;
@@ -98,7 +101,7 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
 
 /*! init hash map
  *
- * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param bucket_size   the initial hash bucket size, using the default size if be zero
  * @param element_name  the item for name
  * @param element_data  the item for data
  *
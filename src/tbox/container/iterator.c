@@ -99,4 +99,14 @@ tb_long_t tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_c
     tb_assert(iterator && iterator->op && iterator->op->comp);
     return iterator->op->comp(iterator, litem, ritem);
 }
+tb_pointer_t tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_assert(iterator && iterator->op);
+
+    // init type
+    if (ptype) *ptype = TB_ITERATOR_DATA_TYPE_NONE;
 
+    // the contiguous items
+    return iterator->op->data? iterator->op->data(iterator, ptype) : tb_null;
+}
@@ -55,6 +55,18 @@ typedef enum __tb_iterator_flag_e
 
 }tb_iterator_flag_e;
 
+/*! the iterator data type enum
+ *
+ * the value type of the contiguous items, the algorithms may access them directly, e.g. tb_sort
+ */
+typedef enum __tb_iterator_data_type_e
+{
+    TB_ITERATOR_DATA_TYPE_NONE      = 0     //!< the unknown value, it can be only compared by the comparer
+,   TB_ITERATOR_DATA_TYPE_SINT      = 1     //!< the signed integer of the step size, the default comparer compares it by value
+,   TB_ITERATOR_DATA_TYPE_UINT      = 2     //!< the unsigned integer of the step size, the default comparer compares it by value
+
+}tb_iterator_data_type_e;
+
 /// the iterator operation type
 struct __tb_iterator_t;
 typedef struct __tb_iterator_op_t
@@ -92,6 +104,9 @@ typedef struct __tb_iterator_op_t
     /// the iterator nremove
     tb_void_t               (*nremove)(struct __tb_iterator_t* iterator, tb_size_t prev, tb_size_t next, tb_size_t size);
 
+    /// the iterator data, optional, get the contiguous items and the data type
+    tb_pointer_t            (*data)(struct __tb_iterator_t* iterator, tb_size_t* ptype);
+
 }tb_iterator_op_t;
 
 /// the iterator operation ref type
@@ -241,6 +256,19 @@ tb_void_t           tb_iterator_copy(tb_iterator_ref_t iterator, tb_size_t itor,
  */
 tb_long_t           tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem);
 
+/*! the contiguous items of the iterator
+ *
+ * the item of the itor is stored at (data + itor * step),
+ * it is the storage address if the item is the reference (TB_ITERATOR_FLAG_ITEM_REF),
+ * otherwise it is the stored value, and the integer will be extended to the pointer size.
+ *
+ * @param iterator  the iterator
+ * @param ptype     the data type pointer, optional, see tb_iterator_data_type_e
+ *
+ * @return          the items data, return tb_null if the items are not contiguous
+ */
+tb_pointer_t        tb_iterator_data(tb_iterator_ref_t iterator, tb_size_t* ptype);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,455 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "mpmc_queue"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mpmc_queue.h"
+#include "../libc/libc.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default queue maxn
+#ifdef __tb_small__
+#   define TB_MPMC_QUEUE_MAXN_DEFAULT       (256)
+#else
+#   define TB_MPMC_QUEUE_MAXN_DEFAULT       (4096)
+#endif
+
+// the spin count before waiting on the semaphore
+#define TB_MPMC_QUEUE_SPIN_MAXN            (16)
+
+// the padding size for avoiding false sharing
+#define TB_MPMC_QUEUE_PADDING               tb_max(TB_L1_CACHE_BYTES, 64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mpmc queue cell type
+typedef struct __tb_mpmc_queue_cell_t
+{
+    // the sequence, it is the put position if be free, otherwise the put position + 1
+    tb_atomic_t             seq;
+
+    // the data
+    tb_cpointer_t           data;
+
+}tb_mpmc_queue_cell_t;
+
+// the mpmc queue type
+typedef struct __tb_mpmc_queue_t
+{
+    // the put position
+    tb_atomic_t             put_pos;
+
+    // the padding
+    tb_byte_t               pad0[TB_MPMC_QUEUE_PADDING];
+
+    // the get position
+    tb_atomic_t             get_pos;
+
+    // the padding
+    tb_byte_t               pad1[TB_MPMC_QUEUE_PADDING];
+
+    // the cells
+    tb_mpmc_queue_cell_t*   cells;
+
+    // the mask
+    tb_size_t               mask;
+
+    // the waiting count of the putters
+    tb_atomic32_t           put_waiting;
+
+    // the waiting count of the getters
+    tb_atomic32_t           get_waiting;
+
+    // the semaphore of the putters
+    tb_semaphore_ref_t      put_semaphore;
+
+    // the semaphore of the getters
+    tb_semaphore_ref_t      get_semaphore;
+
+}tb_mpmc_queue_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t tb_mpmc_queue_notify(tb_atomic32_t* waiting, tb_semaphore_ref_t semaphore, tb_size_t ready)
+{
+    /* the waiter increases the waiting count before checking the queue again,
+     * so we need a full barrier between publishing the items and loading the waiting count
+     */
+    tb_memory_barrier();
+
+    /* claim the waiters for all ready cells and wake them up, so we will not post them repeatedly before they run
+     *
+     * a batch may make many cells ready, so we need wake up min(ready, waiting) waiters at once
+     */
+    tb_int32_t count = tb_atomic32_get_explicit(waiting, TB_ATOMIC_RELAXED);
+    while (count > 0)
+    {
+        tb_int32_t claim = (tb_int32_t)tb_min((tb_size_t)count, ready);
+        if (tb_atomic32_compare_and_swap_weak(waiting, &count, count - claim))
+        {
+            tb_semaphore_post(semaphore, claim);
+            break;
+        }
+    }
+}
+static __tb_inline__ tb_void_t tb_mpmc_queue_cancel(tb_atomic32_t* waiting)
+{
+    /* decrease the waiting count if it has been not claimed by the notifier,
+     * otherwise the posted semaphore will be left and the next waiter will only check the queue again
+     */
+    tb_int32_t count = tb_atomic32_get_explicit(waiting, TB_ATOMIC_RELAXED);
+    while (count > 0)
+    {
+        if (tb_atomic32_compare_and_swap_weak(waiting, &count, count - 1)) break;
+    }
+}
+static __tb_inline__ tb_long_t tb_mpmc_queue_wait(tb_atomic32_t* waiting, tb_semaphore_ref_t semaphore, tb_long_t timeout)
+{
+    // wait it, the waiting count has been decreased by the notifier if ok
+    tb_long_t wait = tb_semaphore_wait(semaphore, timeout);
+
+    // timeout or failed? cancel it
+    if (wait <= 0) tb_mpmc_queue_cancel(waiting);
+    return wait;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_mpmc_queue_ref_t tb_mpmc_queue_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_mpmc_queue_t*    queue = tb_null;
+    do
+    {
+        // make queue
+        queue = tb_malloc0_type(tb_mpmc_queue_t);
+        tb_assert_and_check_break(queue);
+
+        // using the default maxn
+        if (!maxn) maxn = TB_MPMC_QUEUE_MAXN_DEFAULT;
+
+        // align maxn to pow2, it needs two cells at least
+        maxn = tb_align_pow2(tb_max(maxn, 2));
+        queue->mask = maxn - 1;
+
+        // make cells
+        queue->cells = tb_nalloc_type(maxn, tb_mpmc_queue_cell_t);
+        tb_assert_and_check_break(queue->cells);
+
+        // init cells
+        tb_size_t i = 0;
+        for (i = 0; i < maxn; i++)
+        {
+            tb_atomic_init(&queue->cells[i].seq, i);
+            queue->cells[i].data = tb_null;
+        }
+
+        // init positions
+        tb_atomic_init(&queue->put_pos, 0);
+        tb_atomic_init(&queue->get_pos, 0);
+
+        // init waiting count
+        tb_atomic32_init(&queue->put_waiting, 0);
+        tb_atomic32_init(&queue->get_waiting, 0);
+
+        // init semaphores
+        queue->put_semaphore = tb_semaphore_init(0);
+        queue->get_semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(queue->put_semaphore && queue->get_semaphore);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (queue) tb_mpmc_queue_exit((tb_mpmc_queue_ref_t)queue);
+        queue = tb_null;
+    }
+
+    // ok?
+    return (tb_mpmc_queue_ref_t)queue;
+}
+tb_void_t tb_mpmc_queue_exit(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // exit semaphores
+    if (queue->put_semaphore) tb_semaphore_exit(queue->put_semaphore);
+    if (queue->get_semaphore) tb_semaphore_exit(queue->get_semaphore);
+    queue->put_semaphore = tb_null;
+    queue->get_semaphore = tb_null;
+
+    // exit cells
+    if (queue->cells) tb_free(queue->cells);
+    queue->cells = tb_null;
+
+    // exit it
+    tb_free(queue);
+}
+tb_bool_t tb_mpmc_queue_put(tb_mpmc_queue_ref_t self, tb_cpointer_t data)
+{
+    // put it
+    return tb_mpmc_queue_put_n(self, &data, 1) == 1;
+}
+tb_size_t tb_mpmc_queue_put_n(tb_mpmc_queue_ref_t self, tb_cpointer_t const* data, tb_size_t size)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells && data, 0);
+
+    // claim the free cells
+    tb_size_t n = 0;
+    tb_size_t pos = (tb_size_t)tb_atomic_get_explicit(&queue->put_pos, TB_ATOMIC_RELAXED);
+    while (size)
+    {
+        // count the continuous free cells from the put position
+        for (n = 0; n < size && n <= queue->mask; n++)
+        {
+            tb_size_t seq = (tb_size_t)tb_atomic_get_explicit(&queue->cells[(pos + n) & queue->mask].seq, TB_ATOMIC_ACQUIRE);
+            if (seq != pos + n) break;
+        }
+
+        // no free cells?
+        if (!n)
+        {
+            // full? the cell is not got
+            tb_size_t seq = (tb_size_t)tb_atomic_get_explicit(&queue->cells[pos & queue->mask].seq, TB_ATOMIC_ACQUIRE);
+            if ((tb_long_t)(seq - pos) < 0) return 0;
+
+            // the put position has been claimed by other putters, reload it
+            pos = (tb_size_t)tb_atomic_get_explicit(&queue->put_pos, TB_ATOMIC_RELAXED);
+            continue;
+        }
+
+        // claim them, the position will be reloaded if failed
+        if (tb_atomic_compare_and_swap_weak_explicit(&queue->put_pos, &pos, pos + n, TB_ATOMIC_RELAXED, TB_ATOMIC_RELAXED)) break;
+    }
+    tb_check_return_val(n, 0);
+
+    // put items and publish them
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_mpmc_queue_cell_t* cell = &queue->cells[(pos + i) & queue->mask];
+        cell->data = data[i];
+        tb_atomic_set_explicit(&cell->seq, pos + i + 1, TB_ATOMIC_RELEASE);
+    }
+
+    // notify the waiting getters for all put cells
+    tb_mpmc_queue_notify(&queue->get_waiting, queue->get_semaphore, n);
+    return n;
+}
+tb_bool_t tb_mpmc_queue_get(tb_mpmc_queue_ref_t self, tb_pointer_t* pdata)
+{
+    // get it
+    return tb_mpmc_queue_get_n(self, pdata, 1) == 1;
+}
+tb_size_t tb_mpmc_queue_get_n(tb_mpmc_queue_ref_t self, tb_pointer_t* data, tb_size_t maxn)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells && data, 0);
+
+    // claim the put cells
+    tb_size_t n = 0;
+    tb_size_t pos = (tb_size_t)tb_atomic_get_explicit(&queue->get_pos, TB_ATOMIC_RELAXED);
+    while (maxn)
+    {
+        // count the continuous put cells from the get position
+        for (n = 0; n < maxn && n <= queue->mask; n++)
+        {
+            tb_size_t seq = (tb_size_t)tb_atomic_get_explicit(&queue->cells[(pos + n) & queue->mask].seq, TB_ATOMIC_ACQUIRE);
+            if (seq != pos + n + 1) break;
+        }
+
+        // no put cells?
+        if (!n)
+        {
+            // empty? the cell is not put
+            tb_size_t seq = (tb_size_t)tb_atomic_get_explicit(&queue->cells[pos & queue->mask].seq, TB_ATOMIC_ACQUIRE);
+            if ((tb_long_t)(seq - pos - 1) < 0) return 0;
+
+            // the get position has been claimed by other getters, reload it
+            pos = (tb_size_t)tb_atomic_get_explicit(&queue->get_pos, TB_ATOMIC_RELAXED);
+            continue;
+        }
+
+        // claim them, the position will be reloaded if failed
+        if (tb_atomic_compare_and_swap_weak_explicit(&queue->get_pos, &pos, pos + n, TB_ATOMIC_RELAXED, TB_ATOMIC_RELAXED)) break;
+    }
+    tb_check_return_val(n, 0);
+
+    // get items and free the cells for the next circle
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_mpmc_queue_cell_t* cell = &queue->cells[(pos + i) & queue->mask];
+        data[i] = (tb_pointer_t)cell->data;
+        tb_atomic_set_explicit(&cell->seq, pos + i + queue->mask + 1, TB_ATOMIC_RELEASE);
+    }
+
+    // notify the waiting putters for all free cells
+    tb_mpmc_queue_notify(&queue->put_waiting, queue->put_semaphore, n);
+    return n;
+}
+tb_long_t tb_mpmc_queue_put_wait(tb_mpmc_queue_ref_t self, tb_cpointer_t data, tb_long_t timeout)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->put_semaphore, -1);
+
+    // the start time
+    tb_size_t spin = 0;
+    tb_hong_t time = timeout > 0? tb_mclock() : 0;
+    while (1)
+    {
+        // put it directly if not full
+        if (tb_mpmc_queue_put(self, data)) return 1;
+        tb_check_return_val(timeout, 0);
+
+        // spin for a while first, the queue may be not full soon
+        if (spin < TB_MPMC_QUEUE_SPIN_MAXN)
+        {
+            spin++;
+            tb_sched_yield();
+            continue;
+        }
+
+        // mark it as waiting and check it again, the getter will see it after getting items
+        tb_atomic32_fetch_and_add(&queue->put_waiting, 1);
+        tb_memory_barrier();
+        if (tb_mpmc_queue_put(self, data))
+        {
+            tb_mpmc_queue_cancel(&queue->put_waiting);
+            return 1;
+        }
+
+        // the left time
+        tb_long_t left = timeout;
+        if (timeout > 0)
+        {
+            left = timeout - (tb_long_t)(tb_mclock() - time);
+            if (left < 0) left = 0;
+        }
+
+        // wait it, the waiting count will be decreased by the notifier or by itself after timeout
+        tb_long_t wait = tb_mpmc_queue_wait(&queue->put_waiting, queue->put_semaphore, left);
+        tb_check_return_val(wait >= 0, -1);
+
+        // timeout? try it for the last time
+        if (!wait) return tb_mpmc_queue_put(self, data)? 1 : 0;
+    }
+    return -1;
+}
+tb_long_t tb_mpmc_queue_get_wait(tb_mpmc_queue_ref_t self, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->get_semaphore, -1);
+
+    // the start time
+    tb_size_t spin = 0;
+    tb_hong_t time = timeout > 0? tb_mclock() : 0;
+    while (1)
+    {
+        // get it directly if not empty
+        if (tb_mpmc_queue_get(self, pdata)) return 1;
+        tb_check_return_val(timeout, 0);
+
+        // spin for a while first, the queue may be not empty soon
+        if (spin < TB_MPMC_QUEUE_SPIN_MAXN)
+        {
+            spin++;
+            tb_sched_yield();
+            continue;
+        }
+
+        // mark it as waiting and check it again, the putter will see it after putting items
+        tb_atomic32_fetch_and_add(&queue->get_waiting, 1);
+        tb_memory_barrier();
+        if (tb_mpmc_queue_get(self, pdata))
+        {
+            tb_mpmc_queue_cancel(&queue->get_waiting);
+            return 1;
+        }
+
+        // the left time
+        tb_long_t left = timeout;
+        if (timeout > 0)
+        {
+            left = timeout - (tb_long_t)(tb_mclock() - time);
+            if (left < 0) left = 0;
+        }
+
+        // wait it, the waiting count will be decreased by the notifier or by itself after timeout
+        tb_long_t wait = tb_mpmc_queue_wait(&queue->get_waiting, queue->get_semaphore, left);
+        tb_check_return_val(wait >= 0, -1);
+
+        // timeout? try it for the last time
+        if (!wait) return tb_mpmc_queue_get(self, pdata)? 1 : 0;
+    }
+    return -1;
+}
+tb_size_t tb_mpmc_queue_size(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the size snapshot
+    tb_long_t get_pos = tb_atomic_get_explicit(&queue->get_pos, TB_ATOMIC_RELAXED);
+    tb_long_t put_pos = tb_atomic_get_explicit(&queue->put_pos, TB_ATOMIC_RELAXED);
+    tb_long_t size = (tb_long_t)((tb_size_t)put_pos - (tb_size_t)get_pos);
+    return size > 0? tb_min((tb_size_t)size, queue->mask + 1) : 0;
+}
+tb_size_t tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t self)
+{
+    // check
+    tb_mpmc_queue_t* queue = (tb_mpmc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the maxn
+    return queue->mask + 1;
+}
@@ -0,0 +1,163 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_MPMC_QUEUE_H
+#define TB_CONTAINER_MPMC_QUEUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the lock-free bounded multi-producer/multi-consumer queue ref type
+ *
+ * <pre>
+ *
+ * cells: |seq|data|seq|data|seq|data|seq|data| ... |seq|data|    <= maxn = 2^n
+ *                   |                   |
+ *                 get pos             put pos
+ *
+ * the put/get positions are claimed by cas and each cell has a sequence number,
+ * so the producers and consumers only contend on the positions and never block each other.
+ *
+ * performance:
+ *
+ * put: O(1), lock-free
+ * get: O(1), lock-free
+ *
+ * </pre>
+ *
+ * @note the queue item is a pointer, and it's not iteratable
+ */
+typedef __tb_typeref__(mpmc_queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init queue
+ *
+ * @param maxn          the item maxn, it will be aligned to pow2, using the default maxn if be zero
+ *
+ * @return              the queue
+ */
+tb_mpmc_queue_ref_t     tb_mpmc_queue_init(tb_size_t maxn);
+
+/*! exit queue
+ *
+ * @param queue         the queue
+ */
+tb_void_t               tb_mpmc_queue_exit(tb_mpmc_queue_ref_t queue);
+
+/*! put the queue item
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false if the queue is full
+ */
+tb_bool_t               tb_mpmc_queue_put(tb_mpmc_queue_ref_t queue, tb_cpointer_t data);
+
+/*! put the queue items
+ *
+ * @param queue         the queue
+ * @param data          the items data
+ * @param size          the items count
+ *
+ * @return              the put count, it may be less than the given size if the queue is full
+ */
+tb_size_t               tb_mpmc_queue_put_n(tb_mpmc_queue_ref_t queue, tb_cpointer_t const* data, tb_size_t size);
+
+/*! get the queue item
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ *
+ * @return              tb_true or tb_false if the queue is empty
+ */
+tb_bool_t               tb_mpmc_queue_get(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata);
+
+/*! get the queue items
+ *
+ * @param queue         the queue
+ * @param data          the items data
+ * @param maxn          the items maxn
+ *
+ * @return              the got count
+ */
+tb_size_t               tb_mpmc_queue_get_n(tb_mpmc_queue_ref_t queue, tb_pointer_t* data, tb_size_t maxn);
+
+/*! put the queue item and wait it if the queue is full
+ *
+ * it only blocks on the semaphore if the queue is full
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_mpmc_queue_put_wait(tb_mpmc_queue_ref_t queue, tb_cpointer_t data, tb_long_t timeout);
+
+/*! get the queue item and wait it if the queue is empty
+ *
+ * it only blocks on the semaphore if the queue is empty
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              ok: 1, timeout: 0, failed: -1
+ */
+tb_long_t               tb_mpmc_queue_get_wait(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata, tb_long_t timeout);
+
+/*! the queue size, it's only a snapshot if other threads are using it
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue size
+ */
+tb_size_t               tb_mpmc_queue_size(tb_mpmc_queue_ref_t queue);
+
+/*! the queue maxn
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue maxn
+ */
+tb_size_t               tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
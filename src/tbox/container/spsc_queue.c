@@ -0,0 +1,400 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        spsc_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "spsc_queue"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "spsc_queue.h"
+#include "../libc/libc.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default queue maxn
+#ifdef __tb_small__
+#   define TB_SPSC_QUEUE_MAXN_DEFAULT       (256)
+#else
+#   define TB_SPSC_QUEUE_MAXN_DEFAULT       (4096)
+#endif
+
+// the spin count before waiting on the semaphore
+#define TB_SPSC_QUEUE_SPIN_MAXN            (16)
+
+// the padding size for avoiding false sharing
+#define TB_SPSC_QUEUE_PADDING               tb_max(TB_L1_CACHE_BYTES, 64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the spsc queue type
+typedef struct __tb_spsc_queue_t
+{
+    // the head, only be written by the getter
+    tb_atomic_t             head;
+
+    // the cached tail for the getter
+    tb_size_t               tail_cache;
+
+    // the padding
+    tb_byte_t               pad0[TB_SPSC_QUEUE_PADDING];
+
+    // the tail, only be written by the putter
+    tb_atomic_t             tail;
+
+    // the cached head for the putter
+    tb_size_t               head_cache;
+
+    // the padding
+    tb_byte_t               pad1[TB_SPSC_QUEUE_PADDING];
+
+    // the data
+    tb_cpointer_t*          data;
+
+    // the mask
+    tb_size_t               mask;
+
+    // the waiting count of the putter
+    tb_atomic32_t           put_waiting;
+
+    // the waiting count of the getter
+    tb_atomic32_t           get_waiting;
+
+    // the semaphore of the putter
+    tb_semaphore_ref_t      put_semaphore;
+
+    // the semaphore of the getter
+    tb_semaphore_ref_t      get_semaphore;
+
+}tb_spsc_queue_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t tb_spsc_queue_notify(tb_atomic32_t* waiting, tb_semaphore_ref_t semaphore)
+{
+    /* the waiter increases the waiting count before checking the queue again,
+     * so we need a full barrier between publishing the items and loading the waiting count
+     */
+    tb_memory_barrier();
+
+    // claim one waiter and wake it up, so we will not post it repeatedly before it runs
+    tb_int32_t count = tb_atomic32_get_explicit(waiting, TB_ATOMIC_RELAXED);
+    while (count > 0)
+    {
+        if (tb_atomic32_compare_and_swap_weak(waiting, &count, count - 1))
+        {
+            tb_semaphore_post(semaphore, 1);
+            break;
+        }
+    }
+}
+static __tb_inline__ tb_void_t tb_spsc_queue_cancel(tb_atomic32_t* waiting)
+{
+    /* decrease the waiting count if it has been not claimed by the notifier,
+     * otherwise the posted semaphore will be left and the next waiter will only check the queue again
+     */
+    tb_int32_t count = tb_atomic32_get_explicit(waiting, TB_ATOMIC_RELAXED);
+    while (count > 0)
+    {
+        if (tb_atomic32_compare_and_swap_weak(waiting, &count, count - 1)) break;
+    }
+}
+static __tb_inline__ tb_long_t tb_spsc_queue_wait(tb_atomic32_t* waiting, tb_semaphore_ref_t semaphore, tb_long_t timeout)
+{
+    // wait it, the waiting count has been decreased by the notifier if ok
+    tb_long_t wait = tb_semaphore_wait(semaphore, timeout);
+
+    // timeout or failed? cancel it
+    if (wait <= 0) tb_spsc_queue_cancel(waiting);
+    return wait;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_spsc_queue_ref_t tb_spsc_queue_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_spsc_queue_t*    queue = tb_null;
+    do
+    {
+        // make queue
+        queue = tb_malloc0_type(tb_spsc_queue_t);
+        tb_assert_and_check_break(queue);
+
+        // using the default maxn
+        if (!maxn) maxn = TB_SPSC_QUEUE_MAXN_DEFAULT;
+
+        // align maxn to pow2
+        maxn = tb_align_pow2(maxn);
+        queue->mask = maxn - 1;
+
+        // make data
+        queue->data = tb_nalloc0_type(maxn, tb_cpointer_t);
+        tb_assert_and_check_break(queue->data);
+
+        // init positions
+        tb_atomic_init(&queue->head, 0);
+        tb_atomic_init(&queue->tail, 0);
+
+        // init waiting count
+        tb_atomic32_init(&queue->put_waiting, 0);
+        tb_atomic32_init(&queue->get_waiting, 0);
+
+        // init semaphores
+        queue->put_semaphore = tb_semaphore_init(0);
+        queue->get_semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(queue->put_semaphore && queue->get_semaphore);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (queue) tb_spsc_queue_exit((tb_spsc_queue_ref_t)queue);
+        queue = tb_null;
+    }
+
+    // ok?
+    return (tb_spsc_queue_ref_t)queue;
+}
+tb_void_t tb_spsc_queue_exit(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // exit semaphores
+    if (queue->put_semaphore) tb_semaphore_exit(queue->put_semaphore);
+    if (queue->get_semaphore) tb_semaphore_exit(queue->get_semaphore);
+    queue->put_semaphore = tb_null;
+    queue->get_semaphore = tb_null;
+
+    // exit data
+    if (queue->data) tb_free(queue->data);
+    queue->data = tb_null;
+
+    // exit it
+    tb_free(queue);
+}
+tb_bool_t tb_spsc_queue_put(tb_spsc_queue_ref_t self, tb_cpointer_t data)
+{
+    // put it
+    return tb_spsc_queue_put_n(self, &data, 1) == 1;
+}
+tb_size_t tb_spsc_queue_put_n(tb_spsc_queue_ref_t self, tb_cpointer_t const* data, tb_size_t size)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->data && data, 0);
+
+    // the free count, we only load the head of the getter if the cached head is not enough
+    tb_size_t tail = (tb_size_t)tb_atomic_get_explicit(&queue->tail, TB_ATOMIC_RELAXED);
+    tb_size_t left = queue->mask + 1 - (tail - queue->head_cache);
+    if (left < size)
+    {
+        queue->head_cache = (tb_size_t)tb_atomic_get_explicit(&queue->head, TB_ATOMIC_ACQUIRE);
+        left = queue->mask + 1 - (tail - queue->head_cache);
+    }
+    tb_size_t n = tb_min(left, size);
+    tb_check_return_val(n, 0);
+
+    // put items
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+        queue->data[(tail + i) & queue->mask] = data[i];
+
+    // publish them
+    tb_atomic_set_explicit(&queue->tail, tail + n, TB_ATOMIC_RELEASE);
+
+    // notify the waiting getter
+    tb_spsc_queue_notify(&queue->get_waiting, queue->get_semaphore);
+    return n;
+}
+tb_bool_t tb_spsc_queue_get(tb_spsc_queue_ref_t self, tb_pointer_t* pdata)
+{
+    // get it
+    return tb_spsc_queue_get_n(self, pdata, 1) == 1;
+}
+tb_size_t tb_spsc_queue_get_n(tb_spsc_queue_ref_t self, tb_pointer_t* data, tb_size_t maxn)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->data && data, 0);
+
+    // the items count, we only load the tail of the putter if the cached tail is not enough
+    tb_size_t head = (tb_size_t)tb_atomic_get_explicit(&queue->head, TB_ATOMIC_RELAXED);
+    tb_size_t size = queue->tail_cache - head;
+    if (size < maxn)
+    {
+        queue->tail_cache = (tb_size_t)tb_atomic_get_explicit(&queue->tail, TB_ATOMIC_ACQUIRE);
+        size = queue->tail_cache - head;
+    }
+    tb_size_t n = tb_min(size, maxn);
+    tb_check_return_val(n, 0);
+
+    // get items
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+        data[i] = (tb_pointer_t)queue->data[(head + i) & queue->mask];
+
+    // free them
+    tb_atomic_set_explicit(&queue->head, head + n, TB_ATOMIC_RELEASE);
+
+    // notify the waiting putter
+    tb_spsc_queue_notify(&queue->put_waiting, queue->put_semaphore);
+    return n;
+}
+tb_long_t tb_spsc_queue_put_wait(tb_spsc_queue_ref_t self, tb_cpointer_t data, tb_long_t timeout)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->put_semaphore, -1);
+
+    // the start time
+    tb_size_t spin = 0;
+    tb_hong_t time = timeout > 0? tb_mclock() : 0;
+    while (1)
+    {
+        // put it directly if not full
+        if (tb_spsc_queue_put(self, data)) return 1;
+        tb_check_return_val(timeout, 0);
+
+        // spin for a while first, the queue may be not full soon
+        if (spin < TB_SPSC_QUEUE_SPIN_MAXN)
+        {
+            spin++;
+            tb_sched_yield();
+            continue;
+        }
+
+        // mark it as waiting and check it again, the getter will see it after getting items
+        tb_atomic32_fetch_and_add(&queue->put_waiting, 1);
+        tb_memory_barrier();
+        if (tb_spsc_queue_put(self, data))
+        {
+            tb_spsc_queue_cancel(&queue->put_waiting);
+            return 1;
+        }
+
+        // the left time
+        tb_long_t left = timeout;
+        if (timeout > 0)
+        {
+            left = timeout - (tb_long_t)(tb_mclock() - time);
+            if (left < 0) left = 0;
+        }
+
+        // wait it, the waiting count will be decreased by the notifier or by itself after timeout
+        tb_long_t wait = tb_spsc_queue_wait(&queue->put_waiting, queue->put_semaphore, left);
+        tb_check_return_val(wait >= 0, -1);
+
+        // timeout? try it for the last time
+        if (!wait) return tb_spsc_queue_put(self, data)? 1 : 0;
+    }
+    return -1;
+}
+tb_long_t tb_spsc_queue_get_wait(tb_spsc_queue_ref_t self, tb_pointer_t* pdata, tb_long_t timeout)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->get_semaphore, -1);
+
+    // the start time
+    tb_size_t spin = 0;
+    tb_hong_t time = timeout > 0? tb_mclock() : 0;
+    while (1)
+    {
+        // get it directly if not empty
+        if (tb_spsc_queue_get(self, pdata)) return 1;
+        tb_check_return_val(timeout, 0);
+
+        // spin for a while first, the queue may be not empty soon
+        if (spin < TB_SPSC_QUEUE_SPIN_MAXN)
+        {
+            spin++;
+            tb_sched_yield();
+            continue;
+        }
+
+        // mark it as waiting and check it again, the putter will see it after putting items
+        tb_atomic32_fetch_and_add(&queue->get_waiting, 1);
+        tb_memory_barrier();
+        if (tb_spsc_queue_get(self, pdata))
+        {
+            tb_spsc_queue_cancel(&queue->get_waiting);
+            return 1;
+        }
+
+        // the left time
+        tb_long_t left = timeout;
+        if (timeout > 0)
+        {
+            left = timeout - (tb_long_t)(tb_mclock() - time);
+            if (left < 0) left = 0;
+        }
+
+        // wait it, the waiting count will be decreased by the notifier or by itself after timeout
+        tb_long_t wait = tb_spsc_queue_wait(&queue->get_waiting, queue->get_semaphore, left);
+        tb_check_return_val(wait >= 0, -1);
+
+        // timeout? try it for the last time
+        if (!wait) return tb_spsc_queue_get(self, pdata)? 1 : 0;
+    }
+    return -1;
+}
+tb_size_t tb_spsc_queue_size(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the size snapshot
+    tb_size_t head = (tb_size_t)tb_atomic_get_explicit(&queue->head, TB_ATOMIC_RELAXED);
+    tb_size_t tail = (tb_size_t)tb_atomic_get_explicit(&queue->tail, TB_ATOMIC_RELAXED);
+    tb_long_t size = (tb_long_t)(tail - head);
+    return size > 0? tb_min((tb_size_t)size, queue->mask + 1) : 0;
+}
+tb_size_t tb_spsc_queue_maxn(tb_spsc_queue_ref_t self)
+{
+    // check
+    tb_spsc_queue_t* queue = (tb_spsc_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the maxn
+    return queue->mask + 1;
+}
@@ -178,6 +178,44 @@ static tb_void_t tb_vector_itor_nremove(tb_iterator_ref_t iterator, tb_size_t pr
     // remove the items
     if (size) tb_vector_nremove((tb_vector_ref_t)iterator, prev != vector->size? prev + 1 : 0, size);
 }
+static tb_pointer_t tb_vector_itor_data(tb_iterator_ref_t iterator, tb_size_t* ptype)
+{
+    // check
+    tb_vector_t* vector = (tb_vector_t*)iterator;
+    tb_assert(vector);
+
+    // the integer items are compared by value if the element comparer is not changed
+    tb_element_ref_t element = &vector->element;
+    switch (element->type)
+    {
+    case TB_ELEMENT_TYPE_LONG:
+        if (ptype && element->comp == tb_element_long().comp) *ptype = TB_ITERATOR_DATA_TYPE_SINT;
+        break;
+    case TB_ELEMENT_TYPE_SIZE:
+        if (ptype && element->comp == tb_element_size().comp) *ptype = TB_ITERATOR_DATA_TYPE_UINT;
+        break;
+    case TB_ELEMENT_TYPE_UINT8:
+        if (ptype && element->comp == tb_element_uint8().comp) *ptype = TB_ITERATOR_DATA_TYPE_UINT;
+        break;
+    case TB_ELEMENT_TYPE_UINT16:
+        if (ptype && element->comp == tb_element_uint16().comp) *ptype = TB_ITERATOR_DATA_TYPE_UINT;
+        break;
+    case TB_ELEMENT_TYPE_UINT32:
+        if (ptype && element->comp == tb_element_uint32().comp) *ptype = TB_ITERATOR_DATA_TYPE_UINT;
+        break;
+    case TB_ELEMENT_TYPE_STR:
+    case TB_ELEMENT_TYPE_PTR:
+    case TB_ELEMENT_TYPE_OBJ:
+    case TB_ELEMENT_TYPE_MEM:
+        break;
+    default:
+        // the items may be not stored as the values, e.g. true, user
+        return tb_null;
+    }
+
+    // the items
+    return vector->data;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -220,6 +258,7 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         ,   tb_vector_itor_copy
         ,   tb_vector_itor_remove
         ,   tb_vector_itor_nremove
+        ,   tb_vector_itor_data
         };
 
         // init iterator
@@ -42,7 +42,7 @@ tb_bool_t tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_coroutine_func_
     tb_assert_and_check_return_val(func, tb_false);
 
     // start it
-    return tb_co_scheduler_start((tb_co_scheduler_t*)scheduler, func, priv, stacksize);
+    return tb_co_scheduler_start((tb_co_scheduler_t*)scheduler, func, priv, stacksize, tb_false);
 }
 tb_bool_t tb_coroutine_yield()
 {
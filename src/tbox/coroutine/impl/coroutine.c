@@ -43,9 +43,12 @@
 // the stack guard magic
 #define TB_COROUTINE_STACK_GUARD            (0xbeef)
 
-// the default stack size, @note we will allocate it from large/virtual allocator if size >= TB_VIRTUAL_MEMORY_DATA_MINN
+// the default stack size, @note the stack pages will be committed lazily when they are touched first
 #define TB_COROUTINE_STACK_DEFSIZE          TB_VIRTUAL_MEMORY_DATA_MINN
 
+// the coroutine size in the top of stack, it need be aligned by 16 bytes for the stack pointer
+#define TB_COROUTINE_SIZE                   tb_align(sizeof(tb_coroutine_t), 16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -59,6 +62,9 @@ static tb_void_t tb_coroutine_entry(tb_context_from_t from)
     coroutine_from->context = from.context;
     tb_assert(from.context);
 
+    // leave the scheduler lock entered before switching to this coroutine
+    tb_co_scheduler_leave((tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine_from));
+
     // get the current coroutine
     tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_coroutine_self();
     tb_assert(coroutine);
@@ -107,41 +113,52 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
         stacksize <<= 1;
 #endif
 
-        /* make coroutine
+        /* make coroutine from the guarded virtual memory
          *
-         * TODO:
+         * the stack pages will be committed lazily, and we will get a hard fault
+         * from the guard page if the stack is overflow.
          *
-         * - segment stack
-         *
-         *  -----------------------------------------------
-         * | coroutine | guard | ... stacksize ... | guard |
-         *  -----------------------------------------------
+         *  ---------------------------------------------------------
+         * | guard page | guard | ... stacksize ... | coroutine       |
+         *  ---------------------------------------------------------
+         *                                         |
+         *                                     stackbase
          */
-        coroutine = (tb_coroutine_t*)tb_malloc_bytes(sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        tb_assert_and_check_break(coroutine);
+        tb_size_t  pagesize = tb_page_size();
+        tb_size_t  totalsize = tb_align(stacksize + TB_COROUTINE_SIZE, pagesize);
+        tb_byte_t* stackdata = (tb_byte_t*)tb_virtual_memory_guard_malloc(totalsize);
+        tb_assert_and_check_break(stackdata);
+
+        // init coroutine in the top of stack
+        coroutine = (tb_coroutine_t*)(stackdata + totalsize - TB_COROUTINE_SIZE);
 
         // save scheduler
         coroutine->scheduler = scheduler;
 
         // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
+        coroutine->stackbase = (tb_byte_t*)coroutine;
+        coroutine->stacksize = totalsize - TB_COROUTINE_SIZE;
 
         // fill guard
         coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
+#ifdef __tb_debug__
+        tb_bits_set_u16_ne(stackdata, TB_COROUTINE_STACK_GUARD);
+#endif
+
+        // init pinned
+        coroutine->pinned = 0;
 
         // init function and user private data
         coroutine->rs.func.func = func;
         coroutine->rs.func.priv = priv;
 
         // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
+        coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
         tb_assert_and_check_break(coroutine->context);
 
 #if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
         // register valgrind stack
-        coroutine->valgrind_stack_id = VALGRIND_STACK_REGISTER(coroutine->stackbase - stacksize, coroutine->stackbase);
+        coroutine->valgrind_stack_id = VALGRIND_STACK_REGISTER(coroutine->stackbase - coroutine->stacksize, coroutine->stackbase);
 #endif
 
 #ifdef __tb_debug__
@@ -188,38 +205,21 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
         tb_coroutine_check(coroutine);
 #endif
 
-#if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
-        // deregister valgrind stack
-        VALGRIND_STACK_DEREGISTER(coroutine->valgrind_stack_id);
-#endif
-
-        // remake coroutine
-        if (stacksize > coroutine->stacksize)
-            coroutine = (tb_coroutine_t*)tb_ralloc_bytes(coroutine, sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        else stacksize = coroutine->stacksize;
-        tb_assert_and_check_break(coroutine && coroutine->scheduler);
-
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
-
-        // fill guard
-        coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
+        /* the stack is too small? we need make a new coroutine
+         *
+         * @note we need not re-register the valgrind stack, because the stack is not changed
+         */
+        tb_check_break(stacksize <= coroutine->stacksize);
+        tb_assert_and_check_break(coroutine->scheduler);
 
         // init function and user private data
         coroutine->rs.func.func = func;
         coroutine->rs.func.priv = priv;
 
         // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
+        coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
         tb_assert_and_check_break(coroutine->context);
 
-#if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
-        // re-register valgrind stack
-        coroutine->valgrind_stack_id = VALGRIND_STACK_REGISTER(coroutine->stackbase - stacksize, coroutine->stackbase);
-#endif
-
         // ok
         ok = tb_true;
 
@@ -253,7 +253,24 @@ tb_void_t tb_coroutine_exit(tb_coroutine_t* coroutine)
 #endif
 
     // exit it
-    tb_free(coroutine);
+    tb_virtual_memory_guard_free(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize + TB_COROUTINE_SIZE);
+}
+tb_void_t tb_coroutine_purge(tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert_and_check_return(coroutine && !tb_coroutine_is_original(coroutine));
+
+    // trace
+    tb_trace_d("purge: %p", coroutine);
+
+    // purge the stack pages below the coroutine
+    tb_byte_t* stackdata = coroutine->stackbase - coroutine->stacksize;
+    tb_virtual_memory_purge(stackdata, coroutine->stacksize);
+
+#ifdef __tb_debug__
+    // refill guard
+    tb_bits_set_u16_ne(stackdata, TB_COROUTINE_STACK_GUARD);
+#endif
 }
 #ifdef __tb_debug__
 tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
@@ -278,13 +295,14 @@ tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
     }
 
     // check stack overflow
-    if (tb_bits_get_u16_ne(coroutine->stackbase) != TB_COROUTINE_STACK_GUARD)
+    tb_byte_t const* stackdata = coroutine->stackbase - coroutine->stacksize;
+    if (tb_bits_get_u16_ne(stackdata) != TB_COROUTINE_STACK_GUARD)
     {
         // trace
         tb_trace_e("this coroutine stack is overflow!");
 
         // dump stack
-        tb_dump_data(coroutine->stackbase - 64, 64 + 2);
+        tb_dump_data(stackdata, 64);
 
         // abort
         tb_abort();
@@ -95,7 +95,7 @@ typedef struct __tb_coroutine_t
     // the context
     tb_context_ref_t                context;
 
-    // the stack base (top)
+    // the stack base (top), the coroutine is placed in the top of its stack
     tb_byte_t*                      stackbase;
 
     // the stack size
@@ -121,6 +121,9 @@ typedef struct __tb_coroutine_t
     // the guard
     tb_uint16_t                     guard;
 
+    // is pinned? it will be never stolen by the other threads of the multi-threaded scheduler
+    tb_uint16_t                     pinned;
+
 #if defined(__tb_valgrind__) && defined(TB_CONFIG_VALGRIND_HAVE_VALGRIND_STACK_REGISTER)
     // the valgrind stack id, helo valgrind to understand coroutine
     tb_uint_t                       valgrind_stack_id;
@@ -150,7 +153,7 @@ tb_coroutine_t*         tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_co
  * @param priv          the passed user private data as the argument of function
  * @param stacksize     the stack size, uses the default stack size if be zero
  *
- * @return              the coroutine
+ * @return              the coroutine, it will return null if the stack of the given coroutine is too small
  */
 tb_coroutine_t*         tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
@@ -160,6 +163,12 @@ tb_coroutine_t*         tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_corout
  */
 tb_void_t               tb_coroutine_exit(tb_coroutine_t* coroutine);
 
+/* purge the stack pages of the dead coroutine and return them to the system
+ *
+ * @param coroutine     the coroutine
+ */
+tb_void_t               tb_coroutine_purge(tb_coroutine_t* coroutine);
+
 #ifdef __tb_debug__
 /* check coroutine
  *
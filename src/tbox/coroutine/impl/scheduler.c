@@ -44,6 +44,13 @@
 #   define TB_SCHEDULER_DEAD_CACHE_MAXN     (256)
 #endif
 
+// the high-water mark of the dead coroutines with hot stacks, we will purge the stack pages of the others
+#ifdef __tb_small__
+#   define TB_SCHEDULER_DEAD_HOT_MAXN       (8)
+#else
+#   define TB_SCHEDULER_DEAD_HOT_MAXN       (32)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -112,7 +119,7 @@ static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize, tb_bool_t pinned)
 {
     // check
     tb_assert(func);
@@ -129,23 +136,43 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         if (!scheduler) scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
         tb_assert_and_check_break(scheduler);
 
+        // uses the scheduler of the current thread if it's in the same group
+        if (scheduler->group)
+        {
+            tb_co_scheduler_t* scheduler_self = (tb_co_scheduler_t*)tb_co_scheduler_self();
+            if (scheduler_self && scheduler_self->group == scheduler->group)
+                scheduler = scheduler_self;
+        }
+
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
-        // reuses dead coroutines in init function
+        // reuses the newest dead coroutine in init function, its stack is still hot
+        tb_coroutine_t*             coroutine_dead = tb_null;
+        tb_list_entry_head_ref_t    coroutines_dead = tb_null;
+        tb_co_scheduler_enter(scheduler);
         if (tb_list_entry_size(&scheduler->coroutines_dead))
+            coroutines_dead = &scheduler->coroutines_dead;
+        else if (tb_list_entry_size(&scheduler->coroutines_purged))
+            coroutines_dead = &scheduler->coroutines_purged;
+        if (coroutines_dead)
         {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
-            tb_assert_and_check_break(entry);
+            // get the last entry
+            tb_list_entry_ref_t entry = tb_list_entry_last(coroutines_dead);
+            tb_assert(entry);
 
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // remove it from the dead coroutines
+            tb_list_entry_remove_last(coroutines_dead);
 
             // get the dead coroutine
-            tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
+            coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
+        }
+        tb_co_scheduler_leave(scheduler);
 
-            // reinit this coroutine
+        // reinit this coroutine
+        if (coroutine_dead)
+        {
+            // reinit it
             coroutine = tb_coroutine_reinit(coroutine_dead, func, priv, stacksize);
 
             // failed? exit this coroutine
@@ -156,23 +183,61 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         if (!coroutine) coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
         tb_assert_and_check_break(coroutine);
 
+        // pin it?
+        coroutine->pinned = pinned? 1 : 0;
+
+        // update the alive coroutines count of the group
+        if (scheduler->group && !pinned) tb_atomic32_fetch_and_add(&scheduler->group->coroutines, 1);
+
         // ready coroutine
+        tb_co_scheduler_enter(scheduler);
         tb_co_scheduler_make_ready(scheduler, coroutine);
+        tb_size_t ready_count = tb_co_scheduler_ready_count(scheduler);
+        tb_co_scheduler_leave(scheduler);
+
+        /* the hot dead coroutines is too much? purge the stack pages of the oldest coroutines
+         *
+         * we only purge the dead coroutines in start(), because the finished coroutine is still running on its stack in finish()
+         */
+        while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_HOT_MAXN)
+        {
+            // get the oldest entry from head
+            tb_co_scheduler_enter(scheduler);
+            tb_list_entry_ref_t entry = tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_HOT_MAXN? tb_list_entry_head(&scheduler->coroutines_dead) : tb_null;
+
+            // remove it from the dead coroutines
+            if (entry) tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            tb_co_scheduler_leave(scheduler);
+
+            // purge this coroutine
+            tb_check_break(entry);
+            tb_coroutine_purge((tb_coroutine_t*)tb_list_entry0(entry));
+
+            // append it to the purged coroutines
+            tb_co_scheduler_enter(scheduler);
+            tb_list_entry_insert_tail(&scheduler->coroutines_purged, entry);
+            tb_co_scheduler_leave(scheduler);
+        }
 
         // the dead coroutines is too much? free some coroutines
-        while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
+        while (tb_list_entry_size(&scheduler->coroutines_purged) > TB_SCHEDULER_DEAD_CACHE_MAXN)
         {
             // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
-            tb_assert(entry);
+            tb_co_scheduler_enter(scheduler);
+            tb_list_entry_ref_t entry = tb_list_entry_size(&scheduler->coroutines_purged) > TB_SCHEDULER_DEAD_CACHE_MAXN? tb_list_entry_head(&scheduler->coroutines_purged) : tb_null;
 
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // remove it from the purged coroutines
+            if (entry) tb_list_entry_remove_head(&scheduler->coroutines_purged);
+            tb_co_scheduler_leave(scheduler);
 
             // exit this coroutine
+            tb_check_break(entry);
             tb_coroutine_exit((tb_coroutine_t*)tb_list_entry0(entry));
         }
 
+        // notify the idle schedulers to steal it if there are more ready coroutines than us and the io loop
+        if (scheduler->group && ready_count > 2) tb_co_scheduler_notify(scheduler, tb_false);
+
         // ok
         ok = tb_true;
 
@@ -199,6 +264,7 @@ tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 #endif
 
     // get the next ready coroutine
+    tb_co_scheduler_enter(scheduler);
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
     if (coroutine_next != scheduler->running)
     {
@@ -217,6 +283,7 @@ tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
         // check
         tb_assert((tb_list_entry_ref_t)scheduler->running == tb_list_entry_head(&scheduler->coroutines_ready));
     }
+    tb_co_scheduler_leave(scheduler);
 
     // return it directly and continue to run this coroutine
     return tb_false;
@@ -229,8 +296,14 @@ tb_pointer_t tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t
     // trace
     tb_trace_d("resume coroutine(%p)", coroutine);
 
+    // get the owner scheduler, it may be suspended in the other thread for the multi-threaded scheduler
+    tb_co_scheduler_t* owner = scheduler->group? (tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine) : scheduler;
+    tb_assert(owner && owner->group == scheduler->group);
+
     // remove it from the suspend coroutines
-    tb_list_entry_remove(&scheduler->coroutines_suspend, (tb_list_entry_ref_t)coroutine);
+    tb_co_scheduler_enter(owner);
+    tb_list_entry_remove(&owner->coroutines_suspend, (tb_list_entry_ref_t)coroutine);
+    tb_co_scheduler_leave(owner);
 
     // get the passed private data from suspend(priv)
     tb_pointer_t retval = (tb_pointer_t)coroutine->rs_priv;
@@ -238,8 +311,17 @@ tb_pointer_t tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t
     // pass the user private data to suspend()
     coroutine->rs_priv = priv;
 
+    // migrate it to the current scheduler
+    coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
     // make it as ready
+    tb_co_scheduler_enter(scheduler);
     tb_co_scheduler_make_ready(scheduler, coroutine);
+    tb_size_t ready_count = tb_co_scheduler_ready_count(scheduler);
+    tb_co_scheduler_leave(scheduler);
+
+    // notify the idle schedulers to steal it if there are more ready coroutines than us and the io loop
+    if (scheduler->group && ready_count > 2) tb_co_scheduler_notify(scheduler, tb_false);
 
     // return it
     return retval;
@@ -262,16 +344,18 @@ tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t
 #endif
 
     // pass the private data to resume() first
-    scheduler->running->rs_priv = priv;
+    tb_coroutine_t* running = scheduler->running;
+    running->rs_priv = priv;
 
     // get the next ready coroutine first
+    tb_co_scheduler_enter(scheduler);
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
     // make the running coroutine as suspend
-    tb_co_scheduler_make_suspend(scheduler, scheduler->running);
+    tb_co_scheduler_make_suspend(scheduler, running);
 
     // switch to next coroutine
-    if (coroutine_next != scheduler->running) tb_co_scheduler_switch(scheduler, coroutine_next);
+    if (coroutine_next != running) tb_co_scheduler_switch(scheduler, coroutine_next);
     // no more coroutine?
     else
     {
@@ -282,11 +366,11 @@ tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t
         tb_co_scheduler_switch(scheduler, &scheduler->original);
     }
 
-    // check
-    tb_assert(scheduler->running);
-
-    // return the user private data from resume(priv)
-    return (tb_pointer_t)scheduler->running->rs_priv;
+    /* return the user private data from resume(priv)
+     *
+     * @note we cannot use the given scheduler now, because this coroutine may be resumed in the other thread
+     */
+    return (tb_pointer_t)running->rs_priv;
 }
 tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
 {
@@ -302,7 +386,12 @@ tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
     tb_coroutine_check(scheduler->running);
 #endif
 
+    // all coroutines in the group have been finished? notify all idle schedulers to exit loop
+    if (scheduler->group && !scheduler->running->pinned && tb_atomic32_fetch_and_sub(&scheduler->group->coroutines, 1) == 1)
+        tb_co_scheduler_notify(scheduler, tb_true);
+
     // get the next ready coroutine first
+    tb_co_scheduler_enter(scheduler);
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
     // make the running coroutine as dead
@@ -364,6 +453,117 @@ tb_void_t tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* c
 
     // update the context
     coroutine_from->context = from.context;
+
+    /* leave the scheduler lock entered before switching
+     *
+     * the current coroutine may be resumed in the other thread,
+     * so we need leave the lock of the from-coroutine's scheduler in the current thread
+     */
+    tb_co_scheduler_leave((tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine_from));
+}
+tb_bool_t tb_co_scheduler_steal(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert_and_check_return_val(group, tb_false);
+
+    // start from a random victim
+    scheduler->seed = scheduler->seed * 1103515245 + 12345;
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    tb_size_t start = (scheduler->seed >> 16) % n;
+    for (i = 0; i < n; i++)
+    {
+        // the victim
+        tb_co_scheduler_t* victim = group->schedulers[(start + i) % n];
+        tb_check_continue(victim && victim != scheduler);
+
+        // no ready coroutines except the running and pinned coroutines? we need not lock it
+        tb_check_continue(tb_co_scheduler_ready_count(victim) > 1);
+
+        // find a ready coroutine which is not running and not pinned
+        tb_coroutine_t* coroutine = tb_null;
+        tb_spinlock_enter(&victim->lock);
+        tb_list_entry_ref_t head = (tb_list_entry_ref_t)&victim->coroutines_ready;
+        tb_list_entry_ref_t entry = tb_list_entry_next(head);
+        for (; entry != head; entry = tb_list_entry_next(entry))
+        {
+            tb_coroutine_t* ready = (tb_coroutine_t*)tb_list_entry0(entry);
+            if (ready != victim->running && !ready->pinned)
+            {
+                tb_list_entry_remove(&victim->coroutines_ready, entry);
+                coroutine = ready;
+                break;
+            }
+        }
+        tb_spinlock_leave(&victim->lock);
+
+        // steal it
+        if (coroutine)
+        {
+            // trace
+            tb_trace_d("steal coroutine(%p) from scheduler[%lu] to scheduler[%lu]", coroutine, victim->id, scheduler->id);
+
+            // migrate it to the current scheduler
+            coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
+            // make it as ready
+            tb_spinlock_enter(&scheduler->lock);
+            tb_co_scheduler_make_ready(scheduler, coroutine);
+            tb_spinlock_leave(&scheduler->lock);
+            return tb_true;
+        }
+    }
+
+    // no ready coroutines
+    return tb_false;
+}
+tb_bool_t tb_co_scheduler_pin(tb_co_scheduler_t* scheduler, tb_bool_t pinned)
+{
+    // check
+    tb_assert(scheduler && scheduler->running && !tb_coroutine_is_original(scheduler->running));
+
+    // pin or unpin it, it's running now and will be never seen by the stealers until it has been made as ready
+    tb_bool_t pinned_prev = scheduler->running->pinned? tb_true : tb_false;
+    scheduler->running->pinned = pinned? 1 : 0;
+    return pinned_prev;
+}
+tb_void_t tb_co_scheduler_notify(tb_co_scheduler_t* scheduler, tb_bool_t all)
+{
+    // check
+    tb_co_scheduler_group_t* group = scheduler? scheduler->group : tb_null;
+    tb_assert_and_check_return(group);
+
+    /* no idle schedulers?
+     *
+     * we need a full barrier here to see the idle schedulers after making ready,
+     * the idle scheduler will try stealing again after marking idle
+     */
+    tb_memory_barrier();
+    tb_check_return(all || tb_atomic32_get(&group->idle_count) > 0);
+
+    // notify the idle schedulers
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    for (i = 1; i <= n; i++)
+    {
+        // the idle scheduler
+        tb_co_scheduler_t* idle = group->schedulers[(scheduler->id + i) % n];
+        tb_check_continue(idle && (all || idle != scheduler));
+
+        // wake up it if it's waiting io events
+        tb_int32_t is_idle = 1;
+        if (tb_atomic32_compare_and_swap(&idle->idle, &is_idle, 0))
+        {
+            // update the idle count
+            tb_atomic32_fetch_and_sub(&group->idle_count, 1);
+
+            // break the poller wait
+            tb_assert(idle->scheduler_io && idle->scheduler_io->poller);
+            tb_poller_spak(idle->scheduler_io->poller);
+            tb_check_break(all);
+        }
+    }
 }
 tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_poller_object_ref_t object, tb_size_t events, tb_long_t timeout)
 {
@@ -49,6 +49,12 @@ __tb_extern_c_enter__
 // get the io scheduler
 #define tb_co_scheduler_io(scheduler)                  ((scheduler)->scheduler_io)
 
+// enter the scheduler lock, only for the multi-threaded scheduler
+#define tb_co_scheduler_enter(scheduler)               do { if ((scheduler)->group) tb_spinlock_enter(&(scheduler)->lock); } while (0)
+
+// leave the scheduler lock, only for the multi-threaded scheduler
+#define tb_co_scheduler_leave(scheduler)               do { if ((scheduler)->group) tb_spinlock_leave(&(scheduler)->lock); } while (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -56,6 +62,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler group type
+struct __tb_co_scheduler_group_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {
@@ -71,12 +80,25 @@ typedef struct __tb_co_scheduler_t
     // the running coroutine
     tb_coroutine_t*                 running;
 
+    /* the scheduler group for the multi-threaded scheduler, it's null for the single-threaded scheduler
+     *
+     * each thread runs one scheduler of this group and the idle scheduler will steal the ready coroutines from the others,
+     * so all coroutine lists of this scheduler must be accessed in the lock
+     */
+    struct __tb_co_scheduler_group_t* group;
+
     // the io scheduler
     struct __tb_co_scheduler_io_t*  scheduler_io;
 
-    // the dead coroutines
+    /* the dead coroutines, their stacks are still hot and will be reused first
+     *
+     * dead: head (the oldest) -> .. -> tail (the newest, reuse it first)
+     */
     tb_list_entry_head_t            coroutines_dead;
 
+    // the dead coroutines which their stack pages have been purged
+    tb_list_entry_head_t            coroutines_purged;
+
     /* the ready coroutines
      *
      * ready: head -> ready -> .. -> running -> .. -> ready -> ..->
@@ -88,8 +110,41 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the scheduler id in the group
+    tb_size_t                       id;
+
+    // the random seed for stealing coroutines
+    tb_uint32_t                     seed;
+
+    // is idle? it's waiting io events in the io loop
+    tb_atomic32_t                   idle;
+
+    /* the lock for the coroutine lists
+     *
+     * we enter it before switching coroutine and leave it in the switched coroutine,
+     * so the other schedulers cannot steal a ready coroutine before its context has been saved.
+     */
+    tb_spinlock_t                   lock;
+
 }tb_co_scheduler_t;
 
+// the scheduler group type
+typedef struct __tb_co_scheduler_group_t
+{
+    // the alive coroutines count, exclude the pinned coroutines
+    tb_atomic32_t                   coroutines;
+
+    // the idle schedulers count
+    tb_atomic32_t                   idle_count;
+
+    // the schedulers count
+    tb_size_t                       count;
+
+    // the schedulers, the first scheduler is the main scheduler
+    tb_co_scheduler_t*              schedulers[1];
+
+}tb_co_scheduler_group_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -100,10 +155,11 @@ typedef struct __tb_co_scheduler_t
  * @param func              the coroutine function
  * @param priv              the passed user private data as the argument of function
  * @param stacksize         the stack size
+ * @param pinned            pin it to this scheduler? it will be never stolen by the other threads
  *
  * @return                  tb_true or tb_false
  */
-tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize, tb_bool_t pinned);
 
 /* yield the current coroutine
  *
@@ -148,12 +204,41 @@ tb_void_t                   tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
 tb_pointer_t                tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler, tb_long_t interval);
 
 /* switch to the given coroutine
+ *
+ * @note the scheduler lock must be entered before switching, and it will be left in the switched coroutine
  *
  * @param scheduler         the scheduler
  * @param coroutine         the coroutine
  */
 tb_void_t                   tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
 
+/* steal one ready coroutine from the other schedulers in the same group
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_steal(tb_co_scheduler_t* scheduler);
+
+/* pin the running coroutine to this scheduler or unpin it
+ *
+ * it will be never stolen by the other threads until it has been unpinned,
+ * and it must be restored to the previous pinned state before finishing.
+ *
+ * @param scheduler         the scheduler
+ * @param pinned            pin it?
+ *
+ * @return                  the previous pinned state
+ */
+tb_bool_t                   tb_co_scheduler_pin(tb_co_scheduler_t* scheduler, tb_bool_t pinned);
+
+/* notify the idle schedulers in the same group
+ *
+ * @param scheduler         the scheduler
+ * @param all               notify all idle schedulers? otherwise only notify one idle scheduler
+ */
+tb_void_t                   tb_co_scheduler_notify(tb_co_scheduler_t* scheduler, tb_bool_t all);
+
 /* wait io events
  *
  * @param scheduler         the scheduler
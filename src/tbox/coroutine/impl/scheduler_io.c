@@ -56,6 +56,87 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_void_t tb_co_scheduler_io_detach(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object, tb_co_pollerdata_io_ref_t pollerdata)
+{
+    /* remove this object from the poller if no coroutines are waiting it for the multi-threaded scheduler
+     *
+     * the resumed coroutine may be migrated to the other thread and close this object there,
+     * but the io_uring/poll poller still references it after closing it, so we cannot keep it in the poller of this thread.
+     * it will be inserted to the poller again in the next waiting, and we can get the current events of the edge-trigger mode again.
+     *
+     * the epoll/kqueue poller will remove the closed object automatically, so we keep it there, @see tb_co_scheduler_io_close_post()
+     */
+    if (scheduler_io->scheduler->group && !scheduler_io->keep_attached && !pollerdata->co_recv && !pollerdata->co_send && pollerdata->poller_events_wait)
+    {
+        // trace
+        tb_trace_d("object: %p, detach it from poller", object->ref.ptr);
+
+        // remove it
+        tb_poller_remove(scheduler_io->poller, object);
+        pollerdata->poller_events_wait = 0;
+        pollerdata->poller_events_save = 0;
+    }
+}
+static tb_void_t tb_co_scheduler_io_close_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object)
+{
+    // enter
+    tb_spinlock_enter(&scheduler_io->closed_lock);
+
+    // grow the closed objects
+    tb_size_t closed_count = (tb_size_t)tb_atomic32_get(&scheduler_io->closed_count);
+    if (closed_count >= scheduler_io->closed_maxn)
+    {
+        tb_size_t           closed_maxn = tb_max(closed_count + 16, scheduler_io->closed_maxn << 1);
+        tb_poller_object_t* closed_list = tb_ralloc_type(scheduler_io->closed_list, closed_maxn, tb_poller_object_t);
+        if (closed_list)
+        {
+            scheduler_io->closed_list = closed_list;
+            scheduler_io->closed_maxn = closed_maxn;
+        }
+    }
+
+    // post this object, it will be detached in the thread of this io scheduler
+    if (closed_count < scheduler_io->closed_maxn)
+    {
+        scheduler_io->closed_list[closed_count] = *object;
+        tb_atomic32_set(&scheduler_io->closed_count, (tb_int32_t)(closed_count + 1));
+    }
+
+    // leave
+    tb_spinlock_leave(&scheduler_io->closed_lock);
+}
+static tb_void_t tb_co_scheduler_io_close_done(tb_co_scheduler_io_ref_t scheduler_io)
+{
+    // no objects have been closed in the other threads?
+    tb_check_return(tb_atomic32_get(&scheduler_io->closed_count) > 0);
+
+    // enter
+    tb_spinlock_enter(&scheduler_io->closed_lock);
+
+    /* detach the closed objects, they may be attached to our poller before migrating the coroutine,
+     * and they have been removed from the epoll/kqueue poller by closing them, so we only reset the poller object data
+     */
+    tb_size_t i = 0;
+    tb_size_t n = (tb_size_t)tb_atomic32_get(&scheduler_io->closed_count);
+    for (i = 0; i < n; i++)
+    {
+        tb_poller_object_ref_t      object = &scheduler_io->closed_list[i];
+        tb_co_pollerdata_io_ref_t   pollerdata = (tb_co_pollerdata_io_ref_t)tb_pollerdata_get(&scheduler_io->pollerdata, object);
+        if (pollerdata && pollerdata->poller_events_wait)
+        {
+            // trace
+            tb_trace_d("object: %p, detach it from poller, it has been closed in the other thread", object->ref.ptr);
+
+            // reset it
+            pollerdata->poller_events_wait = 0;
+            pollerdata->poller_events_save = 0;
+        }
+    }
+    tb_atomic32_set(&scheduler_io->closed_count, 0);
+
+    // leave
+    tb_spinlock_leave(&scheduler_io->closed_lock);
+}
 static tb_void_t tb_co_scheduler_io_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_size_t events)
 {
     // exists the timer task? remove it
@@ -105,6 +186,7 @@ static tb_void_t tb_co_scheduler_io_timeout(tb_bool_t killed, tb_cpointer_t priv
                     pollerdata->co_recv = tb_null;
                 if (coroutine == pollerdata->co_send)
                     pollerdata->co_send = tb_null;
+                tb_co_scheduler_io_detach(scheduler_io, &coroutine->rs.wait.object, pollerdata);
             }
         }
 
@@ -112,6 +194,22 @@ static tb_void_t tb_co_scheduler_io_timeout(tb_bool_t killed, tb_cpointer_t priv
         tb_co_scheduler_io_resume(scheduler, coroutine, TB_POLLER_EVENT_NONE);
     }
 }
+static tb_void_t tb_co_scheduler_io_complete(tb_poller_ioreq_ref_t ioreq)
+{
+    // check
+    tb_coroutine_t* coroutine = (tb_coroutine_t*)ioreq->priv;
+    tb_assert(coroutine);
+
+    // get scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine);
+    tb_assert(scheduler);
+
+    // trace
+    tb_trace_d("coroutine(%p): io request(%lu) completed: %ld", coroutine, ioreq->code, ioreq->result);
+
+    // resume the coroutine, the result has been saved to the io request
+    tb_co_scheduler_io_resume(scheduler, coroutine, TB_POLLER_EVENT_NONE);
+}
 static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_poller_object_ref_t object, tb_long_t events, tb_cpointer_t priv)
 {
     // check
@@ -182,8 +280,24 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_poller_obj
             events &= ~TB_POLLER_EVENT_SEND;
         }
 
+        /* no coroutines are waiting this object and we keep it attached for the multi-threaded scheduler? detach it now
+         *
+         * the coroutine may have been migrated to the other thread and wait this object in the poller there,
+         * so we remove it instead of waking up this thread for each event. it will be inserted again if it waits in this thread,
+         * and we can get the current events of the edge-trigger mode again.
+         */
+        if (!co_recv && !co_send && !pollerdata->co_recv && !pollerdata->co_send && scheduler_io->keep_attached)
+        {
+            // trace
+            tb_trace_d("object: %p, detach it from poller, no coroutines are waiting it", object->ref.ptr);
+
+            // remove it
+            tb_poller_remove(scheduler_io->poller, object);
+            pollerdata->poller_events_wait = 0;
+            pollerdata->poller_events_save = 0;
+        }
         // no coroutines are waiting? cache this events
-        if ((events & TB_POLLER_EVENT_RECV) || (events & TB_POLLER_EVENT_SEND))
+        else if ((events & TB_POLLER_EVENT_RECV) || (events & TB_POLLER_EVENT_SEND))
         {
             // trace
             tb_trace_d("object: %p, cache events %lu", object->ref.ptr, events);
@@ -193,6 +307,9 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_poller_obj
             pollerdata->poller_events_save = (tb_uint16_t)events_prev_save;
         }
     }
+
+    // detach this object from the poller if no coroutines are waiting it
+    tb_co_scheduler_io_detach(scheduler_io, object, pollerdata);
 }
 static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t scheduler_io)
 {
@@ -225,6 +342,9 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     tb_poller_ref_t poller = scheduler_io->poller;
     tb_assert_and_check_return(poller);
 
+    // the scheduler group for the multi-threaded scheduler
+    tb_co_scheduler_group_t* group = scheduler->group;
+
     // loop
     while (!scheduler->stopped)
     {
@@ -235,8 +355,17 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
             if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
         }
 
+        // is multi-threaded scheduler?
+        if (group)
+        {
+            // steal the ready coroutines from the other threads first
+            if (tb_co_scheduler_steal(scheduler)) continue;
+
+            // all coroutines have been finished? loop end
+            tb_check_break(tb_atomic32_get(&group->coroutines) > 0);
+        }
         // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+        else tb_check_break(tb_co_scheduler_suspend_count(scheduler));
 
         // the delay
         tb_size_t delay = tb_timer_delay(scheduler_io->timer);
@@ -247,8 +376,38 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
         // trace
         tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", tb_min(delay, ldelay), tb_co_scheduler_suspend_count(scheduler));
 
+        /* mark this scheduler as idle and try stealing again,
+         * the other threads will break the poller wait if there are new ready coroutines or all coroutines have been finished
+         */
+        if (group)
+        {
+            tb_atomic32_set(&scheduler->idle, 1);
+            tb_atomic32_fetch_and_add(&group->idle_count, 1);
+            if (tb_co_scheduler_steal(scheduler) || tb_atomic32_get(&group->coroutines) <= 0)
+            {
+                tb_int32_t is_idle = 1;
+                if (tb_atomic32_compare_and_swap(&scheduler->idle, &is_idle, 0))
+                    tb_atomic32_fetch_and_sub(&group->idle_count, 1);
+                continue;
+            }
+        }
+
+        // detach the objects closed in the other threads
+        if (scheduler_io->keep_attached) tb_co_scheduler_io_close_done(scheduler_io);
+
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0)
+        tb_long_t wait = tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay));
+
+        // clear the idle state if it has been not notified
+        if (group)
+        {
+            tb_int32_t is_idle = 1;
+            if (tb_atomic32_compare_and_swap(&scheduler->idle, &is_idle, 0))
+                tb_atomic32_fetch_and_sub(&group->idle_count, 1);
+        }
+
+        // failed?
+        if (wait < 0)
         {
             tb_trace_e("loop: wait poller failed!");
             break;
@@ -294,6 +453,10 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // attach poller
         tb_poller_attach(scheduler_io->poller);
 
+        // keep the objects attached to the poller after waiting them if the poller can remove the closed objects automatically
+        tb_size_t poller_type = tb_poller_type(scheduler_io->poller);
+        scheduler_io->keep_attached = scheduler->group && (poller_type == TB_POLLER_TYPE_EPOLL || poller_type == TB_POLLER_TYPE_KQUEUE);
+
         // init poller object data pool
         scheduler_io->pollerdata_pool = tb_fixed_pool_init(tb_null, TB_SCHEDULER_IO_POLLERDATA_GROW, sizeof(tb_co_pollerdata_io_t), tb_null, tb_null, tb_null);
         tb_assert_and_check_break(scheduler_io->pollerdata_pool);
@@ -301,8 +464,11 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // init poller object data
         tb_pollerdata_init(&scheduler_io->pollerdata);
 
+        // init the lock of the closed objects
+        if (!tb_spinlock_init(&scheduler_io->closed_lock)) break;
+
         // start the io loop coroutine
-        if (!tb_co_scheduler_start(scheduler_io->scheduler, tb_co_scheduler_io_loop, scheduler_io, 0)) break;
+        if (!tb_co_scheduler_start(scheduler_io->scheduler, tb_co_scheduler_io_loop, scheduler_io, 0, tb_true)) break;
 
         // ok
         ok = tb_true;
@@ -328,6 +494,11 @@ tb_void_t tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t scheduler_io)
     // exit poller object data
     tb_pollerdata_exit(&scheduler_io->pollerdata);
 
+    // exit the closed objects
+    if (scheduler_io->closed_list) tb_free(scheduler_io->closed_list);
+    scheduler_io->closed_list = tb_null;
+    tb_spinlock_exit(&scheduler_io->closed_lock);
+
     // exit poller object data pool
     if (scheduler_io->pollerdata_pool) tb_fixed_pool_exit(scheduler_io->pollerdata_pool);
     scheduler_io->pollerdata_pool = tb_null;
@@ -437,6 +608,9 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_poll
     // trace
     tb_trace_d("coroutine(%p): wait events(%lu) with %ld ms for object(%p) ..", coroutine, events, timeout, object->ref.ptr);
 
+    // detach the objects closed in the other threads first, this object may be reused from a closed object
+    if (scheduler_io->keep_attached) tb_co_scheduler_io_close_done(scheduler_io);
+
     // get and allocate a poller object data
     tb_co_pollerdata_io_ref_t pollerdata = (tb_co_pollerdata_io_ref_t)tb_pollerdata_get(&scheduler_io->pollerdata, object);
     if (!pollerdata)
@@ -689,6 +863,35 @@ tb_long_t tb_co_scheduler_io_wait_fwatcher(tb_co_scheduler_io_ref_t scheduler_io
     if (ok > 0 && pevent) *pevent = *((tb_fwatcher_event_t*)coroutine->rs.wait.object_event);
     return ok;
 }
+tb_bool_t tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_ioreq_ref_t ioreq, tb_long_t timeout)
+{
+    // check
+    tb_assert(scheduler_io && ioreq && scheduler_io->poller && scheduler_io->scheduler);
+
+    // have been stopped?
+    tb_check_return_val(!scheduler_io->scheduler->stopped, tb_false);
+
+    // get the current coroutine
+    tb_coroutine_t* coroutine = tb_co_scheduler_running(scheduler_io->scheduler);
+    tb_assert(coroutine);
+
+    // trace
+    tb_trace_d("coroutine(%p): post io request(%lu) with %ld ms for socket(%p) ..", coroutine, ioreq->code, timeout, ioreq->sock);
+
+    // post it to the poller, it will be submitted in the next waiting
+    ioreq->result   = 0;
+    ioreq->func     = tb_co_scheduler_io_complete;
+    ioreq->priv     = coroutine;
+    if (!tb_poller_post(scheduler_io->poller, ioreq, timeout)) return tb_false;
+
+    // the timeout has been linked to this request by the poller, so we need not post a timer task
+    coroutine->rs.wait.task         = tb_null;
+    coroutine->rs.wait.object.type  = TB_POLLER_OBJECT_NONE;
+
+    // suspend the current coroutine until the request has been completed
+    tb_co_scheduler_suspend(scheduler_io->scheduler, tb_null);
+    return tb_true;
+}
 tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object)
 {
     // check
@@ -719,6 +922,25 @@ tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_po
         return tb_true;
     }
 
+    /* the object may be still attached to the pollers of the other threads for the multi-threaded scheduler,
+     * because we keep it in the poller after waiting and the coroutine may be migrated to this thread.
+     * so we post it to the other threads and they will detach it before the next waiting.
+     */
+    tb_co_scheduler_group_t* group = scheduler_io->scheduler->group;
+    if (group && scheduler_io->keep_attached)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            tb_co_scheduler_t* scheduler = group->schedulers[i];
+            if (scheduler && scheduler != scheduler_io->scheduler && scheduler->scheduler_io)
+                tb_co_scheduler_io_close_post((tb_co_scheduler_io_ref_t)scheduler->scheduler_io, object);
+        }
+
+        // detach the objects closed in the other threads first
+        tb_co_scheduler_io_close_done(scheduler_io);
+    }
+
     // reset the pollerdata data
     tb_co_pollerdata_io_ref_t pollerdata = (tb_co_pollerdata_io_ref_t)tb_pollerdata_get(&scheduler_io->pollerdata, object);
     if (pollerdata)
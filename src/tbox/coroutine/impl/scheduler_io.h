@@ -28,6 +28,7 @@
 #include "scheduler.h"
 #include "../../memory/fixed_pool.h"
 #include "../../platform/poller.h"
+#include "../../platform/impl/poller.h"
 #include "../../platform/impl/pollerdata.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +81,24 @@ typedef struct __tb_co_scheduler_io_t
     // the poller data pool
     tb_fixed_pool_ref_t pollerdata_pool;
 
+    /* keep the objects attached to the poller after waiting them for the multi-threaded scheduler?
+     *
+     * we only keep them for the epoll/kqueue poller, because it will remove the closed objects automatically.
+     */
+    tb_bool_t           keep_attached;
+
+    // the objects closed in the other threads of the multi-threaded scheduler, we need detach them in this thread
+    tb_poller_object_t* closed_list;
+
+    // the closed objects maxn
+    tb_size_t           closed_maxn;
+
+    // the closed objects count, we can read it without lock
+    tb_atomic32_t       closed_count;
+
+    // the lock of the closed objects
+    tb_spinlock_t       closed_lock;
+
 }tb_co_scheduler_io_t, *tb_co_scheduler_io_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -158,6 +177,19 @@ tb_long_t                   tb_co_scheduler_io_wait_proc(tb_co_scheduler_io_ref_
  */
 tb_long_t                   tb_co_scheduler_io_wait_fwatcher(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_object_ref_t object, tb_fwatcher_event_t* pevent, tb_long_t timeout);
 
+/*! post an io request and wait its completion
+ *
+ * the current coroutine will be resumed with the result in ioreq->result if the poller can complete it directly (.e.g io_uring),
+ * otherwise it will return tb_false directly and we need wait io events and do io operations by ourselves.
+ *
+ * @param scheduler_io      the io scheduler
+ * @param ioreq             the io request
+ * @param timeout           the timeout, infinity: -1, the result will be -ECANCELED if be timeout
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_ioreq_ref_t ioreq, tb_long_t timeout);
+
 /*! cancel io events for the given poller object
  *
  * @param scheduler_io      the io scheduler
@@ -89,6 +89,9 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init dead coroutines
         tb_list_entry_init(&scheduler->coroutines_dead, tb_coroutine_t, entry, tb_null);
 
+        // init purged coroutines
+        tb_list_entry_init(&scheduler->coroutines_purged, tb_coroutine_t, entry, tb_null);
+
         // init ready coroutines
         tb_list_entry_init(&scheduler->coroutines_ready, tb_coroutine_t, entry, tb_null);
 
@@ -101,6 +104,9 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init running
         scheduler->running = &scheduler->original;
 
+        // init lock
+        if (!tb_spinlock_init(&scheduler->lock)) break;
+
         // ok
         ok = tb_true;
 
@@ -117,12 +123,94 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
     // ok?
     return (tb_co_scheduler_ref_t)scheduler;
 }
+tb_co_scheduler_ref_t tb_co_scheduler_init_mt(tb_size_t nthreads)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // uses the cpu count if be zero
+        if (!nthreads) nthreads = tb_cpu_count();
+        nthreads = tb_min(nthreads, TB_CO_SCHEDULER_THREAD_MAXN);
+        tb_assert_and_check_break(nthreads);
+
+        // only one thread? uses the single-threaded scheduler, no locking and stealing are needed
+        if (nthreads == 1) return tb_co_scheduler_init();
+
+        // make group
+        group = (tb_co_scheduler_group_t*)tb_malloc0(sizeof(tb_co_scheduler_group_t) + (nthreads - 1) * sizeof(tb_co_scheduler_t*));
+        tb_assert_and_check_break(group);
+
+        // init schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < nthreads; i++)
+        {
+            // init scheduler
+            tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_init();
+            tb_assert_and_check_break(scheduler);
+
+            // attach it to the group
+            scheduler->group    = group;
+            scheduler->id       = i;
+            scheduler->seed     = (tb_uint32_t)(i * 2654435761u + 1);
+            group->schedulers[i] = scheduler;
+            group->count++;
+        }
+        tb_check_break(i == nthreads);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit all schedulers
+        if (group)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < group->count; i++)
+            {
+                group->schedulers[i]->stopped = tb_true;
+                group->schedulers[i]->group = tb_null;
+                tb_co_scheduler_exit((tb_co_scheduler_ref_t)group->schedulers[i]);
+            }
+            tb_free(group);
+        }
+        group = tb_null;
+    }
+
+    // ok? return the main scheduler
+    return group? (tb_co_scheduler_ref_t)group->schedulers[0] : tb_null;
+}
 tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
 {
     // check
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
+    // is the main scheduler of the multi-threaded scheduler? exit all schedulers in this group
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        // check
+        tb_assert_and_check_return(scheduler == group->schedulers[0]);
+
+        // exit the other schedulers
+        tb_size_t i = 0;
+        for (i = 1; i < group->count; i++)
+        {
+            group->schedulers[i]->group = tb_null;
+            tb_co_scheduler_exit((tb_co_scheduler_ref_t)group->schedulers[i]);
+        }
+
+        // exit group
+        scheduler->group = tb_null;
+        tb_free(group);
+    }
+
     // must be stopped
     tb_assert(scheduler->stopped);
 
@@ -140,6 +228,9 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // free all dead coroutines
     tb_co_scheduler_free(&scheduler->coroutines_dead);
 
+    // free all purged coroutines
+    tb_co_scheduler_free(&scheduler->coroutines_purged);
+
     // free all ready coroutines
     tb_co_scheduler_free(&scheduler->coroutines_ready);
 
@@ -149,12 +240,18 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // exit dead coroutines
     tb_list_entry_exit(&scheduler->coroutines_dead);
 
+    // exit purged coroutines
+    tb_list_entry_exit(&scheduler->coroutines_purged);
+
     // exit ready coroutines
     tb_list_entry_exit(&scheduler->coroutines_ready);
 
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit lock
+    tb_spinlock_exit(&scheduler->lock);
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -164,16 +261,32 @@ tb_void_t tb_co_scheduler_kill(tb_co_scheduler_ref_t self)
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
+    // kill all schedulers in the group for the multi-threaded scheduler
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (group)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            // stop it
+            tb_co_scheduler_t* scheduler_killed = group->schedulers[i];
+            scheduler_killed->stopped = tb_true;
+
+            // kill the io scheduler
+            if (scheduler_killed->scheduler_io) tb_co_scheduler_io_kill(scheduler_killed->scheduler_io);
+        }
+        return ;
+    }
+
     // stop it
     scheduler->stopped = tb_true;
 
     // kill the io scheduler
     if (scheduler->scheduler_io) tb_co_scheduler_io_kill(scheduler->scheduler_io);
 }
-tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
+static tb_void_t tb_co_scheduler_loop_run(tb_co_scheduler_t* scheduler, tb_bool_t exclusive)
 {
     // check
-    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
     tb_assert_and_check_return(scheduler);
 
 #ifdef __tb_thread_local__
@@ -187,21 +300,32 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
         if (!tb_thread_local_init(&g_scheduler_self, tb_null)) return ;
 
         // update and overide the current scheduler
-        tb_thread_local_set(&g_scheduler_self, self);
+        tb_thread_local_set(&g_scheduler_self, scheduler);
     }
 #endif
 
 #ifdef TB_CONFIG_OS_WINDOWS
     // we need attach poller in the current thread first for iocp/windows
     tb_co_scheduler_io_need(scheduler);
+#else
+    // we need the io loop to steal coroutines and wait events in the idle thread for the multi-threaded scheduler
+    if (scheduler->group) tb_co_scheduler_io_need(scheduler);
 #endif
 
     // schedule all ready coroutines
-    while (tb_list_entry_size(&scheduler->coroutines_ready))
+    while (1)
     {
         // check
         tb_assert(tb_coroutine_is_original(scheduler->running));
 
+        // no more ready coroutines?
+        tb_co_scheduler_enter(scheduler);
+        if (!tb_list_entry_size(&scheduler->coroutines_ready))
+        {
+            tb_co_scheduler_leave(scheduler);
+            break;
+        }
+
         // get the next entry from head
         tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_ready);
         tb_assert(entry);
@@ -228,6 +352,66 @@ tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
     }
 #endif
 }
+static tb_int_t tb_co_scheduler_loop_thread(tb_cpointer_t priv)
+{
+    // run the scheduler loop in this thread
+    tb_co_scheduler_loop_run((tb_co_scheduler_t*)priv, tb_false);
+    return 0;
+}
+tb_void_t tb_co_scheduler_loop(tb_co_scheduler_ref_t self, tb_bool_t exclusive)
+{
+    // check
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)self;
+    tb_assert_and_check_return(scheduler);
+
+    // is single-threaded scheduler? run it directly
+    tb_co_scheduler_group_t* group = scheduler->group;
+    if (!group)
+    {
+        tb_co_scheduler_loop_run(scheduler, exclusive);
+        return ;
+    }
+
+    // check
+    tb_assert_and_check_return(scheduler == group->schedulers[0]);
+
+    // start the other schedulers in the worker threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_CO_SCHEDULER_THREAD_MAXN];
+    tb_size_t       nthreads = tb_min(group->count, tb_arrayn(threads));
+    for (i = 1; i < nthreads; i++)
+    {
+        threads[i] = tb_thread_init(__tb_lstring__("co_scheduler"), tb_co_scheduler_loop_thread, group->schedulers[i], 0);
+        if (!threads[i])
+        {
+            // trace
+            tb_trace_e("loop: start the thread of scheduler[%lu] failed, run it with %lu threads!", i, i);
+
+            /* we run all coroutines in the started threads
+             *
+             * the schedulers without threads have not run any coroutines and have no io loop,
+             * and the new coroutines are only started or stolen by the running schedulers, so we only need stop them.
+             */
+            tb_size_t j = 0;
+            for (j = i; j < nthreads; j++) group->schedulers[j]->stopped = tb_true;
+            nthreads = i;
+            break;
+        }
+    }
+
+    // run the main scheduler in the current thread, the exclusive mode is not supported
+    tb_co_scheduler_loop_run(scheduler, tb_false);
+
+    // wait the other schedulers
+    for (i = 1; i < nthreads; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+}
 tb_co_scheduler_ref_t tb_co_scheduler_self()
 {
     // get self scheduler on the current thread
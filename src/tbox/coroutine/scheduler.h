@@ -32,6 +32,17 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum threads count of the multi-threaded scheduler
+#ifdef __tb_small__
+#   define TB_CO_SCHEDULER_THREAD_MAXN      (16)
+#else
+#   define TB_CO_SCHEDULER_THREAD_MAXN      (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -49,6 +60,22 @@ typedef __tb_typeref__(co_scheduler);
  */
 tb_co_scheduler_ref_t   tb_co_scheduler_init(tb_noarg_t);
 
+/*! init the multi-threaded scheduler
+ *
+ * it will run one scheduler loop per thread in tb_co_scheduler_loop(),
+ * each thread has its own ready coroutines and io poller, the idle thread will steal the ready coroutines from the others,
+ * so the coroutine may be resumed in the other thread after waiting io events.
+ *
+ * @note the coroutine lock, semaphore and channel are not thread-safe,
+ * we cannot share them between the coroutines in the multi-threaded scheduler
+ *
+ * @param nthreads      the threads count, uses the cpu count if be zero
+ *                      it is the same as tb_co_scheduler_init() if there is only one thread
+ *
+ * @return              the main scheduler
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_init_mt(tb_size_t nthreads);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
@@ -66,6 +93,7 @@ tb_void_t               tb_co_scheduler_kill(tb_co_scheduler_ref_t scheduler);
  * @param schedule      the scheduler
  * @param exclusive     enable exclusive mode, we need ensure only one loop() be called at the same time,
  *                      but it will be faster using thr global scheduler instead of TLS storage
+ *                      (it will be ignored for the multi-threaded scheduler)
  */
 tb_void_t               tb_co_scheduler_loop(tb_co_scheduler_ref_t schedule, tb_bool_t exclusive);
 
@@ -24,6 +24,32 @@
  * includes
  */
 #include "crc32.h"
+#include "../utils/bits.h"
+#include "../platform/cpu.h"
+#include "../platform/thread.h"
+#include "../platform/atomic32.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the pclmulqdq and sse4.2 kernels? they are selected at runtime
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_ARCH_SSE2) \
+        && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)) && !defined(TB_CONFIG_MICRO_ENABLE) \
+        && (defined(TB_COMPILER_IS_CLANG) || TB_COMPILER_VERSION_BE(4, 9))
+#   define TB_CRC32_SIMD_ENABLE
+#   define __tb_pclmul__                    __attribute__((target("pclmul")))
+#   define __tb_sse42__                     __attribute__((target("sse4.2")))
+#   include <emmintrin.h>
+#   include <wmmintrin.h>
+#   include <nmmintrin.h>
+#endif
+
+// the crc32 table index
+#define TB_CRC32_TABLE_IEEE                 (0)
+#define TB_CRC32_TABLE_IEEE_LE              (1)
+#define TB_CRC32_TABLE_CASTAGNOLI           (2)
+#define TB_CRC32_TABLE_MAXN                 (3)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -132,10 +158,88 @@ tb_uint32_t const g_crc32_le_table[] =
 ,	0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
+// the crc32c(Castagnoli) table
+tb_uint32_t const g_crc32c_table[] =
+{
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c
+,	0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b
+,	0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c
+,	0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384
+,	0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc
+,	0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a
+,	0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512
+,	0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa
+,	0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad
+,	0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a
+,	0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf
+,	0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957
+,	0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f
+,	0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927
+,	0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f
+,	0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7
+,	0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e
+,	0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859
+,	0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e
+,	0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6
+,	0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de
+,	0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c
+,	0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4
+,	0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c
+,	0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b
+,	0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c
+,	0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5
+,	0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d
+,	0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975
+,	0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d
+,	0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905
+,	0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed
+,	0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8
+,	0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff
+,	0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8
+,	0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540
+,	0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78
+,	0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee
+,	0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6
+,	0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e
+,	0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69
+,	0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e
+,	0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+// the slicing-by-8 tables, slice[k][i] is the crc of the byte i followed by k zero bytes
+static tb_uint32_t      g_crc32_slice[TB_CRC32_TABLE_MAXN][8][256];
+
+// the slicing-by-8 tables have been made?
+static tb_atomic32_t    g_crc32_slice_once = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const table[])
+static tb_bool_t tb_crc32_slice_make(tb_cpointer_t priv)
+{
+    // the byte tables
+    static tb_uint32_t const* s_tables[TB_CRC32_TABLE_MAXN] = { g_crc32_table, g_crc32_le_table, g_crc32c_table };
+
+    // make the slicing tables from the byte tables
+    tb_size_t i = 0;
+    tb_size_t k = 0;
+    tb_size_t t = 0;
+    for (t = 0; t < TB_CRC32_TABLE_MAXN; t++)
+    {
+        tb_uint32_t const*  table = s_tables[t];
+        tb_uint32_t       (*slice)[256] = g_crc32_slice[t];
+        for (i = 0; i < 256; i++) slice[0][i] = table[i];
+        for (k = 1; k < 8; k++)
+        {
+            for (i = 0; i < 256; i++)
+                slice[k][i] = (slice[k - 1][i] >> 8) ^ table[(tb_uint8_t)slice[k - 1][i]];
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_uint32_t tb_crc32_make_bytes(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const table[])
 {
     // done
 #if defined(TB_ARCH_ARM) && !defined(TB_ARCH_ARM64)
@@ -149,6 +253,161 @@ static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data,
     // ok
     return crc32;
 }
+static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_size_t index)
+{
+    // the byte table
+    tb_uint32_t const* table = index == TB_CRC32_TABLE_IEEE? g_crc32_table : (index == TB_CRC32_TABLE_IEEE_LE? g_crc32_le_table : g_crc32c_table);
+
+    // slicing-by-8 for the long data
+    if (size >= 16 && (tb_atomic32_get(&g_crc32_slice_once) == 2 || tb_thread_once(&g_crc32_slice_once, tb_crc32_slice_make, tb_null)))
+    {
+        tb_uint32_t const   (*slice)[256] = (tb_uint32_t const (*)[256])g_crc32_slice[index];
+        tb_byte_t const*    ie = data + (size & ~7);
+        while (data < ie)
+        {
+            tb_uint32_t one = crc32 ^ tb_bits_get_u32_le(data);
+            tb_uint32_t two = tb_bits_get_u32_le(data + 4);
+            crc32   =   slice[7][one & 0xff] ^ slice[6][(one >> 8) & 0xff] ^ slice[5][(one >> 16) & 0xff] ^ slice[4][one >> 24]
+                    ^   slice[3][two & 0xff] ^ slice[2][(two >> 8) & 0xff] ^ slice[1][(two >> 16) & 0xff] ^ slice[0][two >> 24];
+            data += 8;
+        }
+        size &= 7;
+    }
+
+    // the left bytes
+    return tb_crc32_make_bytes(crc32, data, size, table);
+}
+#ifdef TB_CRC32_SIMD_ENABLE
+/* fold the crc32 (IEEE LE) of the 16-bytes blocks using pclmulqdq, size must be >= 64 and be aligned by 16-bytes
+ *
+ * see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel),
+ * the constants are the bit-reflected x^n mod P(x) for the folding distances and the barrett reduction.
+ */
+static __tb_pclmul__ tb_uint32_t tb_crc32_le_make_pclmul(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // the folding constants
+    __m128i const k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    __m128i const k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    __m128i const k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    __m128i const poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    __m128i const mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    // load the first 64-bytes and xor the initial crc
+    __m128i x1 = _mm_xor_si128(_mm_loadu_si128((__m128i const*)(data + 0x00)), _mm_cvtsi32_si128((tb_int_t)crc32));
+    __m128i x2 = _mm_loadu_si128((__m128i const*)(data + 0x10));
+    __m128i x3 = _mm_loadu_si128((__m128i const*)(data + 0x20));
+    __m128i x4 = _mm_loadu_si128((__m128i const*)(data + 0x30));
+    __m128i x5;
+    data += 64;
+    size -= 64;
+
+    // fold the 64-bytes blocks in parallel
+    while (size >= 64)
+    {
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i const*)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((__m128i const*)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((__m128i const*)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((__m128i const*)(data + 0x30)));
+        data += 64;
+        size -= 64;
+    }
+
+    // fold them into 128-bits
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // fold the left 16-bytes blocks
+    while (size >= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((__m128i const*)data)), x5);
+        data += 16;
+        size -= 16;
+    }
+
+    // fold 128-bits to 64-bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // barrett reduce it to 32-bits
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // ok
+    return (tb_uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+/* make crc32c using the sse4.2 crc32 instruction
+ *
+ * it computes the same crc register as the table walk, so the seed need not be inverted here.
+ */
+static __tb_sse42__ tb_uint32_t tb_crc32c_make_sse42(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // align the data
+    while (size && ((tb_size_t)data & 7))
+    {
+        crc32 = _mm_crc32_u8(crc32, *data++);
+        size--;
+    }
+
+#ifdef TB_ARCH_x64
+    // done 8-bytes blocks
+    tb_uint64_t crc64 = crc32;
+    while (size >= 32)
+    {
+        crc64 = _mm_crc32_u64(crc64, ((tb_uint64_t const*)data)[0]);
+        crc64 = _mm_crc32_u64(crc64, ((tb_uint64_t const*)data)[1]);
+        crc64 = _mm_crc32_u64(crc64, ((tb_uint64_t const*)data)[2]);
+        crc64 = _mm_crc32_u64(crc64, ((tb_uint64_t const*)data)[3]);
+        data += 32;
+        size -= 32;
+    }
+    while (size >= 8)
+    {
+        crc64 = _mm_crc32_u64(crc64, *((tb_uint64_t const*)data));
+        data += 8;
+        size -= 8;
+    }
+    crc32 = (tb_uint32_t)crc64;
+#endif
+
+    // done 4-bytes blocks
+    while (size >= 4)
+    {
+        crc32 = _mm_crc32_u32(crc32, *((tb_uint32_t const*)data));
+        data += 4;
+        size -= 4;
+    }
+
+    // done the left bytes
+    while (size--) crc32 = _mm_crc32_u8(crc32, *data++);
+
+    // ok
+    return crc32;
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -160,7 +419,7 @@ tb_uint32_t tb_crc32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t see
     tb_assert_and_check_return_val(data, 0);
 
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_table);
+    return tb_crc32_make_impl(seed, data, size, TB_CRC32_TABLE_IEEE);
 }
 tb_uint32_t tb_crc32_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -175,8 +434,19 @@ tb_uint32_t tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t
     // check
     tb_assert_and_check_return_val(data, 0);
 
+#ifdef TB_CRC32_SIMD_ENABLE
+    // fold the 16-bytes blocks using pclmulqdq
+    if (size >= 64 && (tb_cpu_features() & TB_CPU_FEATURE_PCLMUL))
+    {
+        tb_size_t n = size & ~15;
+        seed = tb_crc32_le_make_pclmul(seed, data, n);
+        data += n;
+        size -= n;
+    }
+#endif
+
     // calculate it
-    return tb_crc32_make_impl(seed, data, size, g_crc32_le_table);
+    return tb_crc32_make_impl(seed, data, size, TB_CRC32_TABLE_IEEE_LE);
 }
 tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
 {
@@ -186,3 +456,25 @@ tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
     // make it
     return tb_crc32_le_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
 }
+tb_uint32_t tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+#ifdef TB_CRC32_SIMD_ENABLE
+    // uses the sse4.2 crc32 instruction
+    if (tb_cpu_features() & TB_CPU_FEATURE_SSE42)
+        return tb_crc32c_make_sse42(seed, data, size);
+#endif
+
+    // calculate it
+    return tb_crc32_make_impl(seed, data, size, TB_CRC32_TABLE_CASTAGNOLI);
+}
+tb_uint32_t tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, 0);
+
+    // make it
+    return tb_crc32c_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
+}
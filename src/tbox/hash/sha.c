@@ -25,11 +25,22 @@
  */
 #include "sha.h"
 #include "../utils/bits.h"
+#include "../platform/cpu.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
+// enable the sha extensions and avx2 kernels? they are selected at runtime
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_ARCH_SSE2) \
+        && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)) && !defined(TB_CONFIG_MICRO_ENABLE) \
+        && (defined(TB_COMPILER_IS_CLANG) || TB_COMPILER_VERSION_BE(4, 9))
+#   define TB_SHA_SIMD_ENABLE
+#   define __tb_sha_ni__                __attribute__((target("sha,sse4.1")))
+#   define __tb_avx2__                  __attribute__((target("avx2")))
+#   include <immintrin.h>
+#endif
+
 // rol
 #define TB_SHA_ROL(v, b)               (((v) << (b)) | ((v) >> (32 - (b))))
 
@@ -261,6 +272,462 @@ static tb_void_t tb_sha_transform_sha2(tb_uint32_t* state, tb_byte_t const buffe
     state[7] += h;
 }
 
+static tb_void_t tb_sha_transform_sha1_blocks(tb_uint32_t* state, tb_byte_t const* data, tb_size_t blocks)
+{
+    for (; blocks; blocks--, data += 64) tb_sha_transform_sha1(state, data);
+}
+static tb_void_t tb_sha_transform_sha2_blocks(tb_uint32_t* state, tb_byte_t const* data, tb_size_t blocks)
+{
+    for (; blocks; blocks--, data += 64) tb_sha_transform_sha2(state, data);
+}
+#ifdef TB_SHA_SIMD_ENABLE
+
+// rounds 4i .. 4i + 3 of sha1, m0 is the message words of these rounds and m1, m2, m3 are the next words
+#define TB_SHA1_NI_ROUNDS(i, e0, e1, m0, m1, m2, m3) \
+    if (i < 4) m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + (i << 4))), mask); \
+    if (i) e0 = _mm_sha1nexte_epu32(e0, m0); \
+    else e0 = _mm_add_epi32(e0, m0); \
+    e1 = abcd; \
+    if (i >= 3 && i <= 18) m1 = _mm_sha1msg2_epu32(m1, m0); \
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, (i / 5)); \
+    if (i >= 1 && i <= 16) m3 = _mm_sha1msg1_epu32(m3, m0); \
+    if (i >= 2 && i <= 17) m2 = _mm_xor_si128(m2, m0);
+
+// rounds 4i .. 4i + 3 of sha256, m0 is the message words of these rounds and m1, m2, m3 are the next words
+#define TB_SHA2_NI_ROUNDS(i, m0, m1, m2, m3) \
+    if (i < 4) m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(data + (i << 4))), mask); \
+    msg = _mm_add_epi32(m0, _mm_loadu_si128((__m128i const*)(g_sha_k256 + (i << 2)))); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+    if (i >= 3 && i <= 14) \
+    { \
+        m1 = _mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)); \
+        m1 = _mm_sha256msg2_epu32(m1, m0); \
+    } \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e)); \
+    if (i >= 1 && i <= 12) m3 = _mm_sha256msg1_epu32(m3, m0);
+
+// rotate the 32-bits lanes
+#define TB_SHA_X8_ROL(x, n)             _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define TB_SHA_X8_ROR(x, n)             _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+// the add operations of the 32-bits lanes
+#define TB_SHA_X8_ADD(a, b)             _mm256_add_epi32(a, b)
+#define TB_SHA_X8_ADD3(a, b, c)         _mm256_add_epi32(_mm256_add_epi32(a, b), c)
+
+// the lanes count
+#define TB_SHA_X8_LANES                 (8)
+
+// the multi-buffer lanes type, state[word][lane]
+typedef struct __tb_sha_x8_t
+{
+    // the lane states
+    tb_uint32_t                 state[8][TB_SHA_X8_LANES];
+
+    // the current block of each lane
+    tb_byte_t const*            block[TB_SHA_X8_LANES];
+
+    // the left data of each lane, only the full blocks
+    tb_byte_t const*            data[TB_SHA_X8_LANES];
+
+    // the left full blocks count of each lane
+    tb_size_t                   left[TB_SHA_X8_LANES];
+
+    // the padded tail blocks of each lane
+    tb_byte_t                   tail[TB_SHA_X8_LANES][128];
+
+    // the tail blocks count of each lane
+    tb_size_t                   tail_n[TB_SHA_X8_LANES];
+
+    // the left tail blocks count of each lane
+    tb_size_t                   tail_left[TB_SHA_X8_LANES];
+
+    // the message index of each lane, -1 if the lane is idle
+    tb_size_t                   index[TB_SHA_X8_LANES];
+
+}tb_sha_x8_t;
+
+/* transform sha1 using the intel sha extensions
+ *
+ * @see https://software.intel.com/en-us/articles/intel-sha-extensions
+ */
+static __tb_sha_ni__ tb_void_t tb_sha_transform_sha1_ni(tb_uint32_t* state, tb_byte_t const* data, tb_size_t blocks)
+{
+    // load state, abcd is reversed and e is in the highest word
+    __m128i const   mask = _mm_set_epi64x(0x0001020304050607ull, 0x08090a0b0c0d0e0full);
+    __m128i         abcd = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)state), 0x1b);
+    __m128i         e0 = _mm_set_epi32((tb_int_t)state[4], 0, 0, 0);
+    __m128i         e1;
+    __m128i         m0;
+    __m128i         m1;
+    __m128i         m2;
+    __m128i         m3;
+    for (; blocks; blocks--, data += 64)
+    {
+        // save state
+        __m128i abcd_save = abcd;
+        __m128i e0_save = e0;
+
+        // done 80 rounds
+        TB_SHA1_NI_ROUNDS(0,  e0, e1, m0, m1, m2, m3)
+        TB_SHA1_NI_ROUNDS(1,  e1, e0, m1, m2, m3, m0)
+        TB_SHA1_NI_ROUNDS(2,  e0, e1, m2, m3, m0, m1)
+        TB_SHA1_NI_ROUNDS(3,  e1, e0, m3, m0, m1, m2)
+        TB_SHA1_NI_ROUNDS(4,  e0, e1, m0, m1, m2, m3)
+        TB_SHA1_NI_ROUNDS(5,  e1, e0, m1, m2, m3, m0)
+        TB_SHA1_NI_ROUNDS(6,  e0, e1, m2, m3, m0, m1)
+        TB_SHA1_NI_ROUNDS(7,  e1, e0, m3, m0, m1, m2)
+        TB_SHA1_NI_ROUNDS(8,  e0, e1, m0, m1, m2, m3)
+        TB_SHA1_NI_ROUNDS(9,  e1, e0, m1, m2, m3, m0)
+        TB_SHA1_NI_ROUNDS(10, e0, e1, m2, m3, m0, m1)
+        TB_SHA1_NI_ROUNDS(11, e1, e0, m3, m0, m1, m2)
+        TB_SHA1_NI_ROUNDS(12, e0, e1, m0, m1, m2, m3)
+        TB_SHA1_NI_ROUNDS(13, e1, e0, m1, m2, m3, m0)
+        TB_SHA1_NI_ROUNDS(14, e0, e1, m2, m3, m0, m1)
+        TB_SHA1_NI_ROUNDS(15, e1, e0, m3, m0, m1, m2)
+        TB_SHA1_NI_ROUNDS(16, e0, e1, m0, m1, m2, m3)
+        TB_SHA1_NI_ROUNDS(17, e1, e0, m1, m2, m3, m0)
+        TB_SHA1_NI_ROUNDS(18, e0, e1, m2, m3, m0, m1)
+        TB_SHA1_NI_ROUNDS(19, e1, e0, m3, m0, m1, m2)
+
+        // update state
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    // save state
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = (tb_uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+/* transform sha256 using the intel sha extensions
+ *
+ * @see https://software.intel.com/en-us/articles/intel-sha-extensions
+ */
+static __tb_sha_ni__ tb_void_t tb_sha_transform_sha2_ni(tb_uint32_t* state, tb_byte_t const* data, tb_size_t blocks)
+{
+    // load state, state0 is abef and state1 is cdgh
+    __m128i const   mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+    __m128i         tmp = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)state), 0xb1);
+    __m128i         state1 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)(state + 4)), 0x1b);
+    __m128i         state0 = _mm_alignr_epi8(tmp, state1, 8);
+    __m128i         msg;
+    __m128i         m0;
+    __m128i         m1;
+    __m128i         m2;
+    __m128i         m3;
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+    for (; blocks; blocks--, data += 64)
+    {
+        // save state
+        __m128i state0_save = state0;
+        __m128i state1_save = state1;
+
+        // done 64 rounds
+        TB_SHA2_NI_ROUNDS(0,  m0, m1, m2, m3)
+        TB_SHA2_NI_ROUNDS(1,  m1, m2, m3, m0)
+        TB_SHA2_NI_ROUNDS(2,  m2, m3, m0, m1)
+        TB_SHA2_NI_ROUNDS(3,  m3, m0, m1, m2)
+        TB_SHA2_NI_ROUNDS(4,  m0, m1, m2, m3)
+        TB_SHA2_NI_ROUNDS(5,  m1, m2, m3, m0)
+        TB_SHA2_NI_ROUNDS(6,  m2, m3, m0, m1)
+        TB_SHA2_NI_ROUNDS(7,  m3, m0, m1, m2)
+        TB_SHA2_NI_ROUNDS(8,  m0, m1, m2, m3)
+        TB_SHA2_NI_ROUNDS(9,  m1, m2, m3, m0)
+        TB_SHA2_NI_ROUNDS(10, m2, m3, m0, m1)
+        TB_SHA2_NI_ROUNDS(11, m3, m0, m1, m2)
+        TB_SHA2_NI_ROUNDS(12, m0, m1, m2, m3)
+        TB_SHA2_NI_ROUNDS(13, m1, m2, m3, m0)
+        TB_SHA2_NI_ROUNDS(14, m2, m3, m0, m1)
+        TB_SHA2_NI_ROUNDS(15, m3, m0, m1, m2)
+
+        // update state
+        state0 = _mm_add_epi32(state0, state0_save);
+        state1 = _mm_add_epi32(state1, state1_save);
+    }
+
+    // save state
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128((__m128i*)state, _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128((__m128i*)(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+
+// load the 8 big-endian words at the given offset of all lane blocks and transpose them, w[i] is the word i of all lanes
+static __tb_avx2__ tb_void_t tb_sha_x8_load(__m256i w[8], tb_byte_t const* block[TB_SHA_X8_LANES], tb_size_t offset)
+{
+    // load the rows
+    __m256i const bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r0 = _mm256_loadu_si256((__m256i const*)(block[0] + offset));
+    __m256i r1 = _mm256_loadu_si256((__m256i const*)(block[1] + offset));
+    __m256i r2 = _mm256_loadu_si256((__m256i const*)(block[2] + offset));
+    __m256i r3 = _mm256_loadu_si256((__m256i const*)(block[3] + offset));
+    __m256i r4 = _mm256_loadu_si256((__m256i const*)(block[4] + offset));
+    __m256i r5 = _mm256_loadu_si256((__m256i const*)(block[5] + offset));
+    __m256i r6 = _mm256_loadu_si256((__m256i const*)(block[6] + offset));
+    __m256i r7 = _mm256_loadu_si256((__m256i const*)(block[7] + offset));
+
+    // transpose the 8x8 words
+    __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+    __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+    __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+    __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+    __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+    r0 = _mm256_unpacklo_epi64(t0, t2);
+    r1 = _mm256_unpackhi_epi64(t0, t2);
+    r2 = _mm256_unpacklo_epi64(t1, t3);
+    r3 = _mm256_unpackhi_epi64(t1, t3);
+    r4 = _mm256_unpacklo_epi64(t4, t6);
+    r5 = _mm256_unpackhi_epi64(t4, t6);
+    r6 = _mm256_unpacklo_epi64(t5, t7);
+    r7 = _mm256_unpackhi_epi64(t5, t7);
+    w[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x20), bswap);
+    w[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x20), bswap);
+    w[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x20), bswap);
+    w[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x20), bswap);
+    w[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r0, r4, 0x31), bswap);
+    w[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r1, r5, 0x31), bswap);
+    w[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r2, r6, 0x31), bswap);
+    w[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r3, r7, 0x31), bswap);
+}
+
+// transform the current blocks of 8 sha1 lanes using avx2
+static __tb_avx2__ tb_void_t tb_sha_x8_transform_sha1(tb_sha_x8_t* x8)
+{
+    // load the message words
+    __m256i w[16];
+    tb_sha_x8_load(w, x8->block, 0);
+    tb_sha_x8_load(w + 8, x8->block, 32);
+
+    // load state
+    __m256i a = _mm256_loadu_si256((__m256i const*)x8->state[0]);
+    __m256i b = _mm256_loadu_si256((__m256i const*)x8->state[1]);
+    __m256i c = _mm256_loadu_si256((__m256i const*)x8->state[2]);
+    __m256i d = _mm256_loadu_si256((__m256i const*)x8->state[3]);
+    __m256i e = _mm256_loadu_si256((__m256i const*)x8->state[4]);
+    __m256i a0 = a;
+    __m256i b0 = b;
+    __m256i c0 = c;
+    __m256i d0 = d;
+    __m256i e0 = e;
+
+    // done 80 rounds
+    tb_size_t i = 0;
+    for (i = 0; i < 80; i++)
+    {
+        // the message word
+        if (i >= 16)
+        {
+            __m256i x = _mm256_xor_si256(_mm256_xor_si256(w[(i - 3) & 15], w[(i - 8) & 15]), _mm256_xor_si256(w[(i - 14) & 15], w[i & 15]));
+            w[i & 15] = TB_SHA_X8_ROL(x, 1);
+        }
+
+        // the round function
+        __m256i f;
+        __m256i k;
+        if (i < 20)
+        {
+            f = _mm256_xor_si256(_mm256_andnot_si256(b, d), _mm256_and_si256(b, c));
+            k = _mm256_set1_epi32(0x5a827999);
+        }
+        else if (i < 40)
+        {
+            f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+            k = _mm256_set1_epi32(0x6ed9eba1);
+        }
+        else if (i < 60)
+        {
+            f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+            k = _mm256_set1_epi32((tb_int_t)0x8f1bbcdc);
+        }
+        else
+        {
+            f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+            k = _mm256_set1_epi32((tb_int_t)0xca62c1d6);
+        }
+
+        // rotate the state
+        __m256i t = TB_SHA_X8_ADD3(TB_SHA_X8_ROL(a, 5), f, e);
+        t = TB_SHA_X8_ADD3(t, k, w[i & 15]);
+        e = d;
+        d = c;
+        c = TB_SHA_X8_ROL(b, 30);
+        b = a;
+        a = t;
+    }
+
+    // save state
+    _mm256_storeu_si256((__m256i*)x8->state[0], TB_SHA_X8_ADD(a, a0));
+    _mm256_storeu_si256((__m256i*)x8->state[1], TB_SHA_X8_ADD(b, b0));
+    _mm256_storeu_si256((__m256i*)x8->state[2], TB_SHA_X8_ADD(c, c0));
+    _mm256_storeu_si256((__m256i*)x8->state[3], TB_SHA_X8_ADD(d, d0));
+    _mm256_storeu_si256((__m256i*)x8->state[4], TB_SHA_X8_ADD(e, e0));
+}
+
+// transform the current blocks of 8 sha256 lanes using avx2
+static __tb_avx2__ tb_void_t tb_sha_x8_transform_sha2(tb_sha_x8_t* x8)
+{
+    // load the message words
+    __m256i w[16];
+    tb_sha_x8_load(w, x8->block, 0);
+    tb_sha_x8_load(w + 8, x8->block, 32);
+
+    // load state
+    __m256i s[8];
+    __m256i a = s[0] = _mm256_loadu_si256((__m256i const*)x8->state[0]);
+    __m256i b = s[1] = _mm256_loadu_si256((__m256i const*)x8->state[1]);
+    __m256i c = s[2] = _mm256_loadu_si256((__m256i const*)x8->state[2]);
+    __m256i d = s[3] = _mm256_loadu_si256((__m256i const*)x8->state[3]);
+    __m256i e = s[4] = _mm256_loadu_si256((__m256i const*)x8->state[4]);
+    __m256i f = s[5] = _mm256_loadu_si256((__m256i const*)x8->state[5]);
+    __m256i g = s[6] = _mm256_loadu_si256((__m256i const*)x8->state[6]);
+    __m256i h = s[7] = _mm256_loadu_si256((__m256i const*)x8->state[7]);
+
+    // done 64 rounds
+    tb_size_t i = 0;
+    for (i = 0; i < 64; i++)
+    {
+        // the message word
+        if (i >= 16)
+        {
+            __m256i w2 = w[(i - 2) & 15];
+            __m256i w15 = w[(i - 15) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_X8_ROR(w15, 7), TB_SHA_X8_ROR(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_X8_ROR(w2, 17), TB_SHA_X8_ROR(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[i & 15] = TB_SHA_X8_ADD(TB_SHA_X8_ADD3(w[i & 15], s0, s1), w[(i - 7) & 15]);
+        }
+
+        // t1 = h + S1(e) + ch(e, f, g) + k[i] + w[i]
+        __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_X8_ROR(e, 6), TB_SHA_X8_ROR(e, 11)), TB_SHA_X8_ROR(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = TB_SHA_X8_ADD3(h, S1, ch);
+        t1 = TB_SHA_X8_ADD3(t1, _mm256_set1_epi32((tb_int_t)g_sha_k256[i]), w[i & 15]);
+
+        // t2 = S0(a) + maj(a, b, c)
+        __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(TB_SHA_X8_ROR(a, 2), TB_SHA_X8_ROR(a, 13)), TB_SHA_X8_ROR(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = TB_SHA_X8_ADD(S0, maj);
+
+        // rotate the state
+        h = g;
+        g = f;
+        f = e;
+        e = TB_SHA_X8_ADD(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = TB_SHA_X8_ADD(t1, t2);
+    }
+
+    // save state
+    _mm256_storeu_si256((__m256i*)x8->state[0], TB_SHA_X8_ADD(a, s[0]));
+    _mm256_storeu_si256((__m256i*)x8->state[1], TB_SHA_X8_ADD(b, s[1]));
+    _mm256_storeu_si256((__m256i*)x8->state[2], TB_SHA_X8_ADD(c, s[2]));
+    _mm256_storeu_si256((__m256i*)x8->state[3], TB_SHA_X8_ADD(d, s[3]));
+    _mm256_storeu_si256((__m256i*)x8->state[4], TB_SHA_X8_ADD(e, s[4]));
+    _mm256_storeu_si256((__m256i*)x8->state[5], TB_SHA_X8_ADD(f, s[5]));
+    _mm256_storeu_si256((__m256i*)x8->state[6], TB_SHA_X8_ADD(g, s[6]));
+    _mm256_storeu_si256((__m256i*)x8->state[7], TB_SHA_X8_ADD(h, s[7]));
+}
+
+// load the next message to the given lane
+static tb_void_t tb_sha_x8_lane_load(tb_sha_x8_t* x8, tb_size_t lane, tb_size_t index, tb_byte_t const* data, tb_size_t size, tb_uint32_t const* iv)
+{
+    // init state
+    tb_size_t i = 0;
+    for (i = 0; i < 8; i++) x8->state[i][lane] = iv[i];
+
+    // init the full blocks
+    x8->index[lane] = index;
+    x8->data[lane]  = data;
+    x8->left[lane]  = size >> 6;
+
+    // make the padded tail blocks: the left data, 0x80, zeros and the bits count
+    tb_size_t   left = size & 63;
+    tb_byte_t*  tail = x8->tail[lane];
+    if (left) tb_memcpy(tail, data + size - left, left);
+    tail[left] = 0x80;
+    x8->tail_n[lane] = left < 56? 1 : 2;
+    tb_memset(tail + left + 1, 0, (x8->tail_n[lane] << 6) - left - 9);
+    tb_bits_set_u64_be(tail + (x8->tail_n[lane] << 6) - 8, (tb_uint64_t)size << 3);
+    x8->tail_left[lane] = x8->tail_n[lane];
+}
+
+// make sha for the multiple messages using 8 avx2 lanes
+static tb_void_t tb_sha_make_multi_avx2(tb_sha_t* sha, tb_byte_t const** ibs, tb_size_t const* ins, tb_byte_t** obs, tb_size_t count)
+{
+    // the lanes, the idle lanes will hash a zero block
+    tb_sha_x8_t             x8;
+    static tb_byte_t const  s_zero[64] = {0};
+
+    // load the first messages
+    tb_size_t lane = 0;
+    tb_size_t next = 0;
+    tb_size_t busy = 0;
+    for (lane = 0; lane < TB_SHA_X8_LANES; lane++)
+    {
+        if (next < count)
+        {
+            tb_sha_x8_lane_load(&x8, lane, next, ibs[next], ins[next], sha->state);
+            next++;
+            busy++;
+        }
+        else x8.index[lane] = (tb_size_t)-1;
+    }
+
+    // done
+    while (busy)
+    {
+        // get the current block of each lane
+        for (lane = 0; lane < TB_SHA_X8_LANES; lane++)
+        {
+            if (x8.index[lane] == (tb_size_t)-1) x8.block[lane] = s_zero;
+            else if (x8.left[lane])
+            {
+                x8.block[lane] = x8.data[lane];
+                x8.data[lane] += 64;
+                x8.left[lane]--;
+            }
+            else
+            {
+                x8.block[lane] = x8.tail[lane] + ((x8.tail_n[lane] - x8.tail_left[lane]) << 6);
+                x8.tail_left[lane]--;
+            }
+        }
+
+        // transform them
+        if (sha->digest_len == 5) tb_sha_x8_transform_sha1(&x8);
+        else tb_sha_x8_transform_sha2(&x8);
+
+        // save the finished messages and load the next messages
+        for (lane = 0; lane < TB_SHA_X8_LANES; lane++)
+        {
+            // finished?
+            tb_size_t index = x8.index[lane];
+            if (index == (tb_size_t)-1 || x8.left[lane] || x8.tail_left[lane]) continue;
+
+            // save digest
+            tb_size_t i = 0;
+            for (i = 0; i < sha->digest_len; i++) tb_bits_set_u32_be(obs[index] + (i << 2), x8.state[i][lane]);
+
+            // load the next message
+            if (next < count)
+            {
+                tb_sha_x8_lane_load(&x8, lane, next, ibs[next], ins[next], sha->state);
+                next++;
+            }
+            else
+            {
+                x8.index[lane] = (tb_size_t)-1;
+                busy--;
+            }
+        }
+    }
+}
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -282,7 +749,7 @@ tb_void_t tb_sha_init(tb_sha_t* sha, tb_size_t mode)
         sha->state[2] = 0x98badcfe;
         sha->state[3] = 0x10325476;
         sha->state[4] = 0xc3d2e1f0;
-        sha->transform = tb_sha_transform_sha1;
+        sha->transform = tb_sha_transform_sha1_blocks;
         break;
     case TB_SHA_MODE_SHA2_224:
         sha->state[0] = 0xc1059ed8;
@@ -293,7 +760,7 @@ tb_void_t tb_sha_init(tb_sha_t* sha, tb_size_t mode)
         sha->state[5] = 0x68581511;
         sha->state[6] = 0x64f98fa7;
         sha->state[7] = 0xbefa4fa4;
-        sha->transform = tb_sha_transform_sha2;
+        sha->transform = tb_sha_transform_sha2_blocks;
         break;
     case TB_SHA_MODE_SHA2_256:
         sha->state[0] = 0x6a09e667;
@@ -304,13 +771,20 @@ tb_void_t tb_sha_init(tb_sha_t* sha, tb_size_t mode)
         sha->state[5] = 0x9b05688c;
         sha->state[6] = 0x1f83d9ab;
         sha->state[7] = 0x5be0cd19;
-        sha->transform = tb_sha_transform_sha2;
+        sha->transform = tb_sha_transform_sha2_blocks;
         break;
     default:
         tb_assert(0);
         break;
     }
     sha->count = 0;
+
+#ifdef TB_SHA_SIMD_ENABLE
+    // uses the sha extensions
+    tb_size_t features = tb_cpu_features();
+    if ((features & TB_CPU_FEATURE_SHA) && (features & TB_CPU_FEATURE_SSE41))
+        sha->transform = mode == TB_SHA_MODE_SHA1_160? tb_sha_transform_sha1_ni : tb_sha_transform_sha2_ni;
+#endif
 }
 tb_void_t tb_sha_exit(tb_sha_t* sha, tb_byte_t* data, tb_size_t size)
 {
@@ -320,9 +794,9 @@ tb_void_t tb_sha_exit(tb_sha_t* sha, tb_byte_t* data, tb_size_t size)
     // the count
     tb_hize_t count = tb_bits_be_to_ne_u64(sha->count << 3);
 
-    // spak
-    tb_sha_spak(sha, (tb_byte_t const*)"\200", 1);
-    while ((sha->count & 63) != 56) tb_sha_spak(sha, (tb_byte_t const*)"", 1);
+    // spak the padding: 0x80, zeros and the bits count
+    static tb_byte_t const s_padding[64] = {0x80};
+    tb_sha_spak(sha, s_padding, ((sha->count & 63) < 56? 56 : 120) - (sha->count & 63));
     tb_sha_spak(sha, (tb_byte_t*)&count, 8);
 
     // done
@@ -348,7 +822,7 @@ tb_void_t tb_sha_spak(tb_sha_t* sha, tb_byte_t const* data, tb_size_t size)
         sha->buffer[j++] = data[i];
         if (64 == j)
         {
-            sha->transform(sha->state, sha->buffer);
+            sha->transform(sha->state, sha->buffer, 1);
             j = 0;
         }
     }
@@ -356,9 +830,13 @@ tb_void_t tb_sha_spak(tb_sha_t* sha, tb_byte_t const* data, tb_size_t size)
     if ((j + size) > 63)
     {
         tb_memcpy(&sha->buffer[j], data, (i = 64 - j));
-        sha->transform(sha->state, sha->buffer);
-        for (; i + 63 < size; i += 64)
-            sha->transform(sha->state, &data[i]);
+        sha->transform(sha->state, sha->buffer, 1);
+        if (size - i > 63)
+        {
+            tb_size_t blocks = (size - i) >> 6;
+            sha->transform(sha->state, &data[i], blocks);
+            i += blocks << 6;
+        }
         j = 0;
     }
     else i = 0;
@@ -383,4 +861,37 @@ tb_size_t tb_sha_make(tb_size_t mode, tb_byte_t const* ib, tb_size_t in, tb_byte
     // ok?
     return (sha.digest_len << 2);
 }
+tb_void_t tb_sha_make_multi(tb_size_t mode, tb_byte_t const** ibs, tb_size_t const* ins, tb_byte_t** obs, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(ibs && ins && obs);
+
+#ifdef TB_SHA_SIMD_ENABLE
+    /* hash them in the avx2 lanes
+     *
+     * the sha256 extensions are faster than the avx2 lanes except for the tiny messages,
+     * but the avx2 lanes are still faster than the sha1 extensions.
+     */
+    tb_size_t features = tb_cpu_features();
+    if (count > 1 && (features & TB_CPU_FEATURE_AVX2) && (mode == TB_SHA_MODE_SHA1_160 || !(features & TB_CPU_FEATURE_SHA)))
+    {
+        // init the initial state
+        tb_sha_t sha;
+        tb_sha_init(&sha, mode);
 
+        // done
+        tb_sha_make_multi_avx2(&sha, ibs, ins, obs, count);
+        return ;
+    }
+#endif
+
+    // hash them one by one
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_sha_t sha;
+        tb_sha_init(&sha, mode);
+        tb_sha_spak(&sha, ibs[i], ins[i]);
+        tb_sha_exit(&sha, obs[i], sha.digest_len << 2);
+    }
+}
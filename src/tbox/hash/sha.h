@@ -43,7 +43,7 @@ typedef struct __tb_sha_t
     tb_hize_t       count;       //!< number of bytes in buffer
     tb_uint8_t      buffer[64];  //!< 512-bit buffer of input values used in hash updating
     tb_uint32_t     state[8];    //!< current hash value
-    tb_void_t       (*transform)(tb_uint32_t *state, tb_uint8_t const buffer[64]);
+    tb_void_t       (*transform)(tb_uint32_t *state, tb_uint8_t const* data, tb_size_t blocks);
 
 }tb_sha_t;
 
@@ -95,6 +95,27 @@ tb_void_t               tb_sha_spak(tb_sha_t* sha, tb_byte_t const* data, tb_siz
  */
 tb_size_t               tb_sha_make(tb_size_t mode, tb_byte_t const* ib, tb_size_t ip, tb_byte_t* ob, tb_size_t on);
 
+/*! make sha for the multiple independent messages
+ *
+ * the messages are hashed in parallel simd lanes (8 lanes for avx2) if the cpu supports it,
+ * it is faster than calling tb_sha_make() for each message if there are many small messages.
+ *
+ * @code
+ * tb_byte_t const*     ibs[3] = {data0, data1, data2};
+ * tb_size_t            ins[3] = {size0, size1, size2};
+ * tb_byte_t            digests[3][32];
+ * tb_byte_t*           obs[3] = {digests[0], digests[1], digests[2]};
+ * tb_sha_make_multi(TB_SHA_MODE_SHA2_256, ibs, ins, obs, 3);
+ * @endcode
+ *
+ * @param mode          the mode
+ * @param ibs           the input data list
+ * @param ins           the input size list
+ * @param obs           the output data list, the size of each output buffer must be >= (mode >> 3)
+ * @param count         the messages count
+ */
+tb_void_t               tb_sha_make_multi(tb_size_t mode, tb_byte_t const** ibs, tb_size_t const* ins, tb_byte_t** obs, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
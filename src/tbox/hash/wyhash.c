@@ -0,0 +1,189 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        wyhash.c
+ * @ingroup     hash
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "wyhash.h"
+#include "../utils/bits.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the wyhash secret, @see https://github.com/wangyi-fudan/wyhash (final version 4)
+static tb_uint64_t const g_wyhash_secret[4] =
+{
+    0x2d358dccaa6c78a5ull
+,   0x8bb84b93962eacc9ull
+,   0x4b33a62ed433d4a3ull
+,   0x4d5a2da51de1aa47ull
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline_force__ tb_void_t tb_wyhash_mum(tb_uint64_t* a, tb_uint64_t* b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (tb_uint64_t)r;
+    *b = (tb_uint64_t)(r >> 64);
+#else
+    // 64x64 => 128 bits using the 32-bits multiplications
+    tb_uint64_t ha = *a >> 32;
+    tb_uint64_t hb = *b >> 32;
+    tb_uint64_t la = (tb_uint32_t)*a;
+    tb_uint64_t lb = (tb_uint32_t)*b;
+    tb_uint64_t rh = ha * hb;
+    tb_uint64_t rm0 = ha * lb;
+    tb_uint64_t rm1 = hb * la;
+    tb_uint64_t rl = la * lb;
+    tb_uint64_t t = rl + (rm0 << 32);
+    tb_uint64_t c = t < rl;
+    tb_uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+static __tb_inline_force__ tb_uint64_t tb_wyhash_mix(tb_uint64_t a, tb_uint64_t b)
+{
+    tb_wyhash_mum(&a, &b);
+    return a ^ b;
+}
+static __tb_inline_force__ tb_uint64_t tb_wyhash_r8(tb_byte_t const* p)
+{
+    return tb_bits_get_u64_le(p);
+}
+static __tb_inline_force__ tb_uint64_t tb_wyhash_r4(tb_byte_t const* p)
+{
+    return tb_bits_get_u32_le(p);
+}
+static __tb_inline_force__ tb_uint64_t tb_wyhash_r3(tb_byte_t const* p, tb_size_t k)
+{
+    return (((tb_uint64_t)p[0]) << 16) | (((tb_uint64_t)p[k >> 1]) << 8) | p[k - 1];
+}
+static __tb_inline_force__ tb_void_t tb_wyhash_make_impl(tb_byte_t const* p, tb_size_t size, tb_uint64_t seed, tb_uint64_t* pa, tb_uint64_t* pb)
+{
+    // init seed
+    tb_uint64_t const* secret = g_wyhash_secret;
+    seed ^= tb_wyhash_mix(seed ^ secret[0], secret[1]);
+
+    // load the head and tail words for the short keys
+    tb_uint64_t a;
+    tb_uint64_t b;
+    if (__tb_likely__(size <= 16))
+    {
+        if (__tb_likely__(size >= 4))
+        {
+            a = (tb_wyhash_r4(p) << 32) | tb_wyhash_r4(p + ((size >> 3) << 2));
+            b = (tb_wyhash_r4(p + size - 4) << 32) | tb_wyhash_r4(p + size - 4 - ((size >> 3) << 2));
+        }
+        else if (__tb_likely__(size > 0))
+        {
+            a = tb_wyhash_r3(p, size);
+            b = 0;
+        }
+        else a = b = 0;
+    }
+    else
+    {
+        // mix 48-bytes blocks in three independent lanes
+        tb_size_t i = size;
+        if (__tb_unlikely__(i > 48))
+        {
+            tb_uint64_t see1 = seed;
+            tb_uint64_t see2 = seed;
+            do
+            {
+                seed = tb_wyhash_mix(tb_wyhash_r8(p) ^ secret[1], tb_wyhash_r8(p + 8) ^ seed);
+                see1 = tb_wyhash_mix(tb_wyhash_r8(p + 16) ^ secret[2], tb_wyhash_r8(p + 24) ^ see1);
+                see2 = tb_wyhash_mix(tb_wyhash_r8(p + 32) ^ secret[3], tb_wyhash_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+
+            } while (__tb_likely__(i > 48));
+            seed ^= see1 ^ see2;
+        }
+
+        // mix the left 16-bytes blocks
+        while (__tb_unlikely__(i > 16))
+        {
+            seed = tb_wyhash_mix(tb_wyhash_r8(p) ^ secret[1], tb_wyhash_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        // the last 16-bytes, it may overlap the previous block
+        a = tb_wyhash_r8(p + i - 16);
+        b = tb_wyhash_r8(p + i - 8);
+    }
+
+    // mix them
+    a ^= secret[1];
+    b ^= seed;
+    tb_wyhash_mum(&a, &b);
+
+    // save them
+    *pa = a ^ secret[0] ^ size;
+    *pb = b ^ secret[1];
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_uint64_t tb_wyhash_make(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(data || !size, 0);
+
+    // make it
+    tb_uint64_t a;
+    tb_uint64_t b;
+    tb_wyhash_make_impl(data, size, seed, &a, &b);
+    return tb_wyhash_mix(a, b);
+}
+tb_uint64_t tb_wyhash_make_from_cstr(tb_char_t const* cstr, tb_uint64_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, 0);
+
+    // make it
+    return tb_wyhash_make((tb_byte_t const*)cstr, tb_strlen(cstr), seed);
+}
+tb_void_t tb_wyhash_make128(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed, tb_uint64_t hash[2])
+{
+    // check
+    tb_assert_and_check_return(hash);
+    tb_assert_and_check_return(data || !size);
+
+    // make it
+    tb_uint64_t a;
+    tb_uint64_t b;
+    tb_wyhash_make_impl(data, size, seed, &a, &b);
+    tb_wyhash_mum(&a, &b);
+    hash[0] = a ^ b;
+
+    // make the second hash from the 128-bits product
+    hash[1] = tb_wyhash_mix(a ^ g_wyhash_secret[2], b ^ g_wyhash_secret[3]);
+}
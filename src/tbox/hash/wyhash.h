@@ -0,0 +1,78 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        wyhash.h
+ * @ingroup     hash
+ *
+ */
+#ifndef TB_HASH_WYHASH_H
+#define TB_HASH_WYHASH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! make wyhash
+ *
+ * it reads 8 or 16 bytes at a time and mixes them with the 64x64 => 128 bits multiplication,
+ * it is much faster than the byte-at-a-time hashes for the long keys.
+ *
+ * @param data      the data
+ * @param size      the size
+ * @param seed      the seed
+ *
+ * @return          the wyhash value
+ */
+tb_uint64_t         tb_wyhash_make(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed);
+
+/*! make wyhash from c-string
+ *
+ * @param cstr      the c-string
+ * @param seed      the seed
+ *
+ * @return          the wyhash value
+ */
+tb_uint64_t         tb_wyhash_make_from_cstr(tb_char_t const* cstr, tb_uint64_t seed);
+
+/*! make the 128-bits wyhash
+ *
+ * hash[0] is equal to tb_wyhash_make(data, size, seed) and hash[1] is another independent 64-bits hash,
+ * so we can get any number of hashes by the double hashing: hash[0] + i * hash[1]
+ *
+ * @param data      the data
+ * @param size      the size
+ * @param seed      the seed
+ * @param hash      the 128-bits hash value
+ */
+tb_void_t           tb_wyhash_make128(tb_byte_t const* data, tb_size_t size, tb_uint64_t seed, tb_uint64_t hash[2]);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
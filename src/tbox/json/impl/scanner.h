@@ -0,0 +1,170 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scanner.h
+ *
+ */
+#ifndef TB_JSON_IMPL_SCANNER_H
+#define TB_JSON_IMPL_SCANNER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include "../../platform/cpu.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the avx2 scanners? they are selected at runtime if the avx2 is not enabled for the whole build
+#if defined(TB_ARCH_AVX2)
+#   define TB_JSON_SCANNER_AVX2
+#   define __tb_json_avx2__
+#   include <immintrin.h>
+#elif defined(TB_ARCH_SSE2) && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)) && !defined(TB_CONFIG_MICRO_ENABLE) \
+        && (defined(TB_COMPILER_IS_CLANG) || TB_COMPILER_VERSION_BE(4, 9))
+#   define TB_JSON_SCANNER_AVX2
+#   define TB_JSON_SCANNER_AVX2_RUNTIME
+#   define __tb_json_avx2__                 __attribute__((target("avx2")))
+#   include <immintrin.h>
+#elif defined(TB_ARCH_SSE2)
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ *
+ * the json reader and the json object reader share these scanners,
+ * they are inlined here because the object module may be built without the json module.
+ */
+#ifdef TB_JSON_SCANNER_AVX2
+// scan the 32-bytes blocks of [p, e) with avx2, @see tb_json_scan_string()
+static __tb_inline__ __tb_json_avx2__ tb_byte_t const* tb_json_scan_string_avx2(tb_byte_t const* p, tb_byte_t const* e, tb_byte_t quote)
+{
+    __m256i q32 = _mm256_set1_epi8((tb_char_t)quote);
+    __m256i b32 = _mm256_set1_epi8('\\');
+    while (p + 32 <= e)
+    {
+        __m256i     v = _mm256_loadu_si256((__m256i const*)p);
+        tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, q32), _mm256_cmpeq_epi8(v, b32)));
+        if (m) return p + tb_bits_fb1_u32_le(m);
+        p += 32;
+    }
+    return p;
+}
+
+// scan the 32-bytes blocks of [p, e) with avx2, @see tb_json_scan_spaces()
+static __tb_inline__ __tb_json_avx2__ tb_byte_t const* tb_json_scan_spaces_avx2(tb_byte_t const* p, tb_byte_t const* e)
+{
+    __m256i s32 = _mm256_set1_epi8(' ');
+    __m256i t32 = _mm256_set1_epi8('\t');
+    __m256i r32 = _mm256_set1_epi8(4);
+    while (p + 32 <= e)
+    {
+        // ' ' or '\t' <= c <= '\r'
+        __m256i     v = _mm256_loadu_si256((__m256i const*)p);
+        __m256i     x = _mm256_sub_epi8(v, t32);
+        tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, s32), _mm256_cmpeq_epi8(_mm256_min_epu8(x, r32), x)));
+        if (m != 0xffffffff) return p + tb_bits_fb1_u32_le(~m);
+        p += 32;
+    }
+    return p;
+}
+#endif
+
+/* find the first quote or backslash character in [p, e)
+ *
+ * @param p         the data head
+ * @param e         the data tail
+ * @param quote     the quote character
+ *
+ * @return          the found position, e if not found
+ */
+static __tb_inline__ tb_byte_t const* tb_json_scan_string(tb_byte_t const* p, tb_byte_t const* e, tb_byte_t quote)
+{
+#if defined(TB_JSON_SCANNER_AVX2_RUNTIME)
+    if (p + 32 <= e && (tb_cpu_features() & TB_CPU_FEATURE_AVX2))
+        p = tb_json_scan_string_avx2(p, e, quote);
+#elif defined(TB_JSON_SCANNER_AVX2)
+    p = tb_json_scan_string_avx2(p, e, quote);
+#endif
+#if defined(TB_ARCH_SSE2)
+    __m128i q16 = _mm_set1_epi8((tb_char_t)quote);
+    __m128i b16 = _mm_set1_epi8('\\');
+    while (p + 16 <= e)
+    {
+        __m128i     v = _mm_loadu_si128((__m128i const*)p);
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, q16), _mm_cmpeq_epi8(v, b16)));
+        if (m) return p + tb_bits_fb1_u32_le(m);
+        p += 16;
+    }
+#endif
+    while (p < e && *p != quote && *p != '\\') p++;
+    return p;
+}
+
+/* find the first non-space character in [p, e), the space characters are the same as tb_isspace()
+ *
+ * @param p         the data head
+ * @param e         the data tail
+ *
+ * @return          the found position, e if not found
+ */
+static __tb_inline__ tb_byte_t const* tb_json_scan_spaces(tb_byte_t const* p, tb_byte_t const* e)
+{
+    /* we only enter the vectorized loop for the long spaces (e.g. indents),
+     * because there is only one space or no space between the most tokens
+     */
+    if (p < e && tb_isspace(*p))
+    {
+#if defined(TB_JSON_SCANNER_AVX2_RUNTIME)
+        if (p + 32 <= e && (tb_cpu_features() & TB_CPU_FEATURE_AVX2))
+            p = tb_json_scan_spaces_avx2(p, e);
+#elif defined(TB_JSON_SCANNER_AVX2)
+        p = tb_json_scan_spaces_avx2(p, e);
+#endif
+#if defined(TB_ARCH_SSE2)
+        __m128i s16 = _mm_set1_epi8(' ');
+        __m128i t16 = _mm_set1_epi8('\t');
+        __m128i r16 = _mm_set1_epi8(4);
+        while (p + 16 <= e)
+        {
+            // ' ' or '\t' <= c <= '\r'
+            __m128i     v = _mm_loadu_si128((__m128i const*)p);
+            __m128i     x = _mm_sub_epi8(v, t16);
+            tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, s16), _mm_cmpeq_epi8(_mm_min_epu8(x, r16), x)));
+            if (m != 0xffff) return p + tb_bits_fb1_u32_le(~m);
+            p += 16;
+        }
+#endif
+    }
+    while (p < e && tb_isspace(*p)) p++;
+    return p;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
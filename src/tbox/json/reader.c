@@ -0,0 +1,936 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        reader.c
+ * @ingroup     json
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                    "json_reader"
+#define TB_TRACE_MODULE_DEBUG                   (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "reader.h"
+#include "impl/scanner.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the peeked data maxn
+#ifdef __tb_small__
+#   define TB_JSON_READER_PEEK_MAXN             (8192)
+#else
+#   define TB_JSON_READER_PEEK_MAXN             (65536)
+#endif
+
+// the nested level maxn
+#ifdef __tb_small__
+#   define TB_JSON_READER_LEVEL_MAXN            (64)
+#else
+#   define TB_JSON_READER_LEVEL_MAXN            (512)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the json reader impl type
+typedef struct __tb_json_reader_impl_t
+{
+    // the event
+    tb_size_t               event;
+
+    // the level
+    tb_size_t               level;
+
+    // expect the object key?
+    tb_bool_t               bkey;
+
+    // is bowner of the stream?
+    tb_bool_t               bowner;
+
+    // the stream
+    tb_stream_ref_t         stream;
+
+    // the peeked data base, the data in [base, head) has been parsed but not been skipped in the stream
+    tb_byte_t const*        base;
+
+    // the peeked data head
+    tb_byte_t const*        head;
+
+    // the peeked data tail
+    tb_byte_t const*        tail;
+
+    // the data slice of the current token
+    tb_char_t const*        data;
+
+    // the data size of the current token
+    tb_size_t               size;
+
+    // the unescaped string buffer
+    tb_buffer_t             buffer;
+
+    // the container type of each level, '{' or '['
+    tb_byte_t               stack[TB_JSON_READER_LEVEL_MAXN];
+
+}tb_json_reader_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the character types, 1: number, 2: alpha
+static tb_byte_t const g_json_reader_ctypes[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0,
+    0, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+    0, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * scanner implementation
+ */
+
+// find the first quote or bracket character in [p, e)
+static __tb_inline__ tb_byte_t const* tb_json_reader_scan_structural(tb_byte_t const* p, tb_byte_t const* e)
+{
+#if defined(TB_ARCH_AVX2)
+    __m256i dq32 = _mm256_set1_epi8('\"');
+    __m256i sq32 = _mm256_set1_epi8('\'');
+    __m256i ob32 = _mm256_set1_epi8('[');
+    __m256i cb32 = _mm256_set1_epi8(']');
+    __m256i b32  = _mm256_set1_epi8(0x20);
+    while (p + 32 <= e)
+    {
+        // '{' and '}' are '[' and ']' with the 0x20 bit
+        __m256i     v = _mm256_loadu_si256((__m256i const*)p);
+        __m256i     l = _mm256_andnot_si256(b32, v);
+        __m256i     q = _mm256_or_si256(_mm256_cmpeq_epi8(v, dq32), _mm256_cmpeq_epi8(v, sq32));
+        __m256i     k = _mm256_or_si256(_mm256_cmpeq_epi8(l, ob32), _mm256_cmpeq_epi8(l, cb32));
+        tb_uint32_t m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(q, k));
+        if (m) return p + tb_bits_fb1_u32_le(m);
+        p += 32;
+    }
+#endif
+#if defined(TB_ARCH_SSE2)
+    __m128i dq16 = _mm_set1_epi8('\"');
+    __m128i sq16 = _mm_set1_epi8('\'');
+    __m128i ob16 = _mm_set1_epi8('[');
+    __m128i cb16 = _mm_set1_epi8(']');
+    __m128i b16  = _mm_set1_epi8(0x20);
+    while (p + 16 <= e)
+    {
+        // '{' and '}' are '[' and ']' with the 0x20 bit
+        __m128i     v = _mm_loadu_si128((__m128i const*)p);
+        __m128i     l = _mm_andnot_si128(b16, v);
+        __m128i     q = _mm_or_si128(_mm_cmpeq_epi8(v, dq16), _mm_cmpeq_epi8(v, sq16));
+        __m128i     k = _mm_or_si128(_mm_cmpeq_epi8(l, ob16), _mm_cmpeq_epi8(l, cb16));
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(q, k));
+        if (m) return p + tb_bits_fb1_u32_le(m);
+        p += 16;
+    }
+#endif
+    while (p < e && *p != '\"' && *p != '\'' && (*p | 0x20) != '{' && (*p | 0x20) != '}') p++;
+    return p;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * buffer implementation
+ */
+
+// skip the parsed data in the stream and clear the peeked data
+static tb_bool_t tb_json_reader_sync(tb_json_reader_impl_t* impl)
+{
+    // skip the parsed data
+    if (impl->head > impl->base && !tb_stream_skip(impl->stream, impl->head - impl->base))
+        return tb_false;
+
+    // clear the peeked data
+    impl->base = tb_null;
+    impl->head = tb_null;
+    impl->tail = tb_null;
+    return tb_true;
+}
+
+/* peek more data from the stream
+ *
+ * the data after *pkeep will be kept in the new peeked data if pkeep is not null,
+ * and *pkeep will be updated to the new address of the kept data.
+ *
+ * it returns tb_false if there is no more data, but the kept data are still accessible.
+ */
+static tb_bool_t tb_json_reader_fill(tb_json_reader_impl_t* impl, tb_byte_t const** pkeep)
+{
+    // skip the parsed data before the kept data
+    tb_byte_t const*    keep = pkeep? *pkeep : impl->tail;
+    tb_size_t           size = impl->tail - keep;
+    tb_size_t           left = impl->head - keep;
+    impl->head = keep;
+    if (!tb_json_reader_sync(impl)) return tb_false;
+
+    // peek data
+    tb_byte_t*  data = tb_null;
+    tb_long_t   real = 0;
+    if (size)
+    {
+        /* the kept data are still in the stream cache, we need more data after it to make them contiguous
+         *
+         * @note it may be failed at the end of the stream, but the left data will be cached
+         */
+        tb_size_t need = tb_max(size + TB_STREAM_BLOCK_MAXN, TB_JSON_READER_PEEK_MAXN);
+        tb_stream_need(impl->stream, &data, need);
+
+        // peek all data
+        real = tb_stream_peek(impl->stream, &data, need);
+        tb_check_return_val(real >= (tb_long_t)size, tb_false);
+    }
+    else
+    {
+        while (!(real = tb_stream_peek(impl->stream, &data, TB_JSON_READER_PEEK_MAXN)))
+        {
+            // no data? wait it
+            if (tb_stream_wait(impl->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(impl->stream)) <= 0)
+                return tb_false;
+        }
+        tb_check_return_val(real > 0, tb_false);
+    }
+
+    // save the peeked data
+    impl->base = data;
+    impl->head = data + left;
+    impl->tail = data + real;
+    if (pkeep) *pkeep = data;
+
+    // no more data? only the kept data is left
+    return real > (tb_long_t)size;
+}
+
+// skip spaces and peek the next character, -1: end
+static tb_long_t tb_json_reader_spaces(tb_json_reader_impl_t* impl)
+{
+    while (1)
+    {
+        // skip spaces in the peeked data
+        impl->head = tb_json_scan_spaces(impl->head, impl->tail);
+        if (impl->head < impl->tail) return *impl->head;
+
+        // peek more data
+        if (!tb_json_reader_fill(impl, tb_null)) return -1;
+    }
+    return -1;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * parser implementation
+ */
+static tb_byte_t* tb_json_reader_utf8_put(tb_byte_t* d, tb_uint32_t ch)
+{
+    // encode it to utf8
+    if (ch < 0x80) *d++ = (tb_byte_t)ch;
+    else if (ch < 0x800)
+    {
+        *d++ = (tb_byte_t)(0xc0 | (ch >> 6));
+        *d++ = (tb_byte_t)(0x80 | (ch & 0x3f));
+    }
+    else if (ch < 0x10000)
+    {
+        *d++ = (tb_byte_t)(0xe0 | (ch >> 12));
+        *d++ = (tb_byte_t)(0x80 | ((ch >> 6) & 0x3f));
+        *d++ = (tb_byte_t)(0x80 | (ch & 0x3f));
+    }
+    else
+    {
+        *d++ = (tb_byte_t)(0xf0 | (ch >> 18));
+        *d++ = (tb_byte_t)(0x80 | ((ch >> 12) & 0x3f));
+        *d++ = (tb_byte_t)(0x80 | ((ch >> 6) & 0x3f));
+        *d++ = (tb_byte_t)(0x80 | (ch & 0x3f));
+    }
+    return d;
+}
+static tb_uint32_t tb_json_reader_hex4(tb_byte_t const* p, tb_byte_t const* e, tb_bool_t* pok)
+{
+    // check
+    *pok = tb_false;
+    tb_check_return_val(p + 4 <= e, 0);
+
+    // parse it
+    tb_size_t   i = 0;
+    tb_uint32_t v = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tb_byte_t ch = p[i];
+        if (tb_isdigit10(ch)) v = (v << 4) | (ch - '0');
+        else if (ch >= 'a' && ch <= 'f') v = (v << 4) | (ch - 'a' + 10);
+        else if (ch >= 'A' && ch <= 'F') v = (v << 4) | (ch - 'A' + 10);
+        else return 0;
+    }
+    *pok = tb_true;
+    return v;
+}
+static tb_bool_t tb_json_reader_unescape(tb_json_reader_impl_t* impl, tb_byte_t const* p, tb_byte_t const* e)
+{
+    /* the unescaped string is not longer than the escaped string,
+     * .e.g \uXXXX (6 bytes) => utf8 (<= 3 bytes), \uXXXX\uXXXX (12 bytes) => utf8 (4 bytes)
+     */
+    tb_byte_t* data = tb_buffer_resize(&impl->buffer, e - p + 1);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // walk
+    tb_byte_t* d = data;
+    while (p < e)
+    {
+        // copy the characters before the backslash
+        tb_byte_t const* b = tb_json_scan_string(p, e, '\\');
+        if (b > p)
+        {
+            tb_memcpy(d, p, b - p);
+            d += b - p;
+        }
+        tb_check_break(b + 1 < e);
+
+        // the escaped character
+        p = b + 2;
+        switch (b[1])
+        {
+        case 'n': *d++ = '\n'; break;
+        case 't': *d++ = '\t'; break;
+        case 'r': *d++ = '\r'; break;
+        case 'b': *d++ = '\b'; break;
+        case 'f': *d++ = '\f'; break;
+        case 'u':
+            {
+                // the unicode character
+                tb_bool_t   ok = tb_false;
+                tb_uint32_t ch = tb_json_reader_hex4(p, e, &ok);
+                if (!ok)
+                {
+                    // only copy it
+                    *d++ = 'u';
+                    break;
+                }
+                p += 4;
+
+                // the surrogate pair?
+                if (ch >= 0xd800 && ch <= 0xdbff && p + 6 <= e && p[0] == '\\' && p[1] == 'u')
+                {
+                    tb_uint32_t lo = tb_json_reader_hex4(p + 2, e, &ok);
+                    if (ok && lo >= 0xdc00 && lo <= 0xdfff)
+                    {
+                        ch = 0x10000 + ((ch - 0xd800) << 10) + (lo - 0xdc00);
+                        p += 6;
+                    }
+                }
+
+                // encode it to utf8
+                d = tb_json_reader_utf8_put(d, ch);
+            }
+            break;
+        default:
+            // copy the escaped character, .e.g \" \\ \/
+            *d++ = b[1];
+            break;
+        }
+    }
+    *d = '\0';
+
+    // save the data slice
+    impl->data = (tb_char_t const*)data;
+    impl->size = d - data;
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_parse_string(tb_json_reader_impl_t* impl, tb_byte_t quote)
+{
+    // walk
+    tb_byte_t const*    start = impl->head;
+    tb_bool_t           escaped = tb_false;
+    while (1)
+    {
+        // find the next quote or backslash
+        tb_byte_t const* p = tb_json_scan_string(impl->head, impl->tail, quote);
+        if (p < impl->tail && *p == quote)
+        {
+            impl->head = p + 1;
+            if (escaped) return tb_json_reader_unescape(impl, start, p);
+            else
+            {
+                impl->data = (tb_char_t const*)start;
+                impl->size = p - start;
+            }
+            return tb_true;
+        }
+        // the escaped character?
+        else if (p + 1 < impl->tail)
+        {
+            impl->head = p + 2;
+            escaped = tb_true;
+        }
+        // need more data
+        else
+        {
+            impl->head = p;
+            if (!tb_json_reader_fill(impl, &start)) return tb_false;
+        }
+    }
+    return tb_false;
+}
+static tb_bool_t tb_json_reader_parse_literal(tb_json_reader_impl_t* impl, tb_bool_t number)
+{
+    // walk
+    tb_byte_t const* start = impl->head;
+    while (1)
+    {
+        // find the end of the literal
+        tb_byte_t const* p = impl->head;
+        tb_byte_t const* e = impl->tail;
+        tb_byte_t        t = number? 1 : 2;
+        while (p < e && (g_json_reader_ctypes[*p] & t)) p++;
+        impl->head = p;
+
+        // end?
+        if (p < e) break;
+
+        // need more data, the literal may be ended at the end of the stream
+        if (!tb_json_reader_fill(impl, &start))
+        {
+            // the stream has been failed?
+            tb_check_return_val(impl->tail && impl->head == impl->tail, tb_false);
+            break;
+        }
+    }
+
+    // save the data slice
+    impl->data = (tb_char_t const*)start;
+    impl->size = impl->head - start;
+    return impl->size? tb_true : tb_false;
+}
+static tb_bool_t tb_json_reader_skip_string(tb_json_reader_impl_t* impl, tb_byte_t quote)
+{
+    while (1)
+    {
+        // find the next quote or backslash
+        tb_byte_t const* p = tb_json_scan_string(impl->head, impl->tail, quote);
+        if (p < impl->tail)
+        {
+            // end?
+            impl->head = p + 1;
+            if (*p == quote) return tb_true;
+
+            // skip the escaped character
+            if (impl->head == impl->tail && !tb_json_reader_fill(impl, tb_null)) return tb_false;
+            impl->head++;
+        }
+        // need more data
+        else
+        {
+            impl->head = p;
+            if (!tb_json_reader_fill(impl, tb_null)) return tb_false;
+        }
+    }
+    return tb_false;
+}
+static tb_bool_t tb_json_reader_skip_container(tb_json_reader_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl->level, tb_false);
+
+    // walk
+    tb_size_t depth = 1;
+    while (depth)
+    {
+        // find the next quote or bracket
+        tb_byte_t const* p = tb_json_reader_scan_structural(impl->head, impl->tail);
+        if (p == impl->tail)
+        {
+            impl->head = p;
+            if (!tb_json_reader_fill(impl, tb_null)) return tb_false;
+            continue;
+        }
+
+        // done
+        impl->head = p + 1;
+        switch (*p)
+        {
+        case '\"':
+        case '\'':
+            if (!tb_json_reader_skip_string(impl, *p)) return tb_false;
+            break;
+        case '{':
+        case '[':
+            depth++;
+            break;
+        default:
+            depth--;
+            break;
+        }
+    }
+
+    // leave this container
+    impl->level--;
+    impl->event = (impl->stack[impl->level] == '{')? TB_JSON_READER_EVENT_OBJECT_END : TB_JSON_READER_EVENT_ARRAY_END;
+    impl->bkey = tb_false;
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_json_reader_ref_t tb_json_reader_init(tb_noarg_t)
+{
+    // init reader
+    tb_json_reader_impl_t* reader = tb_malloc0_type(tb_json_reader_impl_t);
+    tb_assert_and_check_return_val(reader, tb_null);
+
+    // init buffer
+    if (!tb_buffer_init(&reader->buffer))
+    {
+        tb_free(reader);
+        return tb_null;
+    }
+
+    // ok
+    return (tb_json_reader_ref_t)reader;
+}
+tb_void_t tb_json_reader_exit(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // clos it first
+    tb_json_reader_clos(reader);
+
+    // exit buffer
+    tb_buffer_exit(&impl->buffer);
+
+    // free it
+    tb_free(impl);
+}
+tb_bool_t tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && stream, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // check
+        tb_assert_and_check_break(!impl->stream);
+
+        // init state
+        impl->event     = TB_JSON_READER_EVENT_NONE;
+        impl->level     = 0;
+        impl->bkey      = tb_false;
+        impl->data      = tb_null;
+        impl->size      = 0;
+
+        // init owner
+        impl->bowner = bowner;
+
+        // init stream
+        impl->stream = stream;
+
+        // open the stream if be not opened, we will peek the file data from the mapping directly
+        if (!tb_stream_is_opened(impl->stream))
+        {
+            if (tb_stream_type(impl->stream) == TB_STREAM_TYPE_FILE) tb_stream_ctrl(impl->stream, TB_STREAM_CTRL_FILE_MMAP, tb_true);
+            if (!tb_stream_open(impl->stream)) break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? close it
+    if (!ok) tb_json_reader_clos(reader);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_json_reader_clos(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // clos the stream
+    if (impl->stream) tb_stream_clos(impl->stream);
+
+    // exit the stream
+    if (impl->stream && impl->bowner) tb_stream_exit(impl->stream);
+    impl->stream = tb_null;
+
+    // clear the peeked data
+    impl->base = tb_null;
+    impl->head = tb_null;
+    impl->tail = tb_null;
+
+    // clear state
+    impl->event     = TB_JSON_READER_EVENT_NONE;
+    impl->level     = 0;
+    impl->bkey      = tb_false;
+    impl->bowner    = tb_false;
+    impl->data      = tb_null;
+    impl->size      = 0;
+
+    // clear buffer
+    tb_buffer_clear(&impl->buffer);
+}
+tb_size_t tb_json_reader_next(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->stream, TB_JSON_READER_EVENT_NONE);
+
+    // clear the data slice
+    impl->data = tb_null;
+    impl->size = 0;
+
+    // walk
+    tb_size_t event = TB_JSON_READER_EVENT_NONE;
+    tb_bool_t failed = tb_false;
+    while (!event && !failed)
+    {
+        // skip spaces and get the next character
+        tb_long_t ch = tb_json_reader_spaces(impl);
+        tb_check_break(ch >= 0);
+
+        // done
+        switch (ch)
+        {
+        case '{':
+        case '[':
+            {
+                // check
+                tb_check_break_state(impl->level < TB_JSON_READER_LEVEL_MAXN, failed, tb_true);
+
+                // enter the object or array
+                impl->head++;
+                impl->stack[impl->level++] = (tb_byte_t)ch;
+                impl->bkey = (ch == '{');
+                event = (ch == '{')? TB_JSON_READER_EVENT_OBJECT_BEG : TB_JSON_READER_EVENT_ARRAY_BEG;
+            }
+            break;
+        case '}':
+        case ']':
+            {
+                // check
+                tb_byte_t type = (ch == '}')? '{' : '[';
+                tb_check_break_state(impl->level && impl->stack[impl->level - 1] == type, failed, tb_true);
+
+                // leave the object or array
+                impl->head++;
+                impl->level--;
+                impl->bkey = tb_false;
+                event = (ch == '}')? TB_JSON_READER_EVENT_OBJECT_END : TB_JSON_READER_EVENT_ARRAY_END;
+            }
+            break;
+        case ',':
+            {
+                // expect the next key if be in the object
+                impl->head++;
+                impl->bkey = (impl->level && impl->stack[impl->level - 1] == '{');
+            }
+            break;
+        case ':':
+            impl->head++;
+            break;
+        case '\"':
+        case '\'':
+            {
+                // parse string
+                impl->head++;
+                if (!tb_json_reader_parse_string(impl, (tb_byte_t)ch))
+                {
+                    failed = tb_true;
+                    break;
+                }
+
+                // is key?
+                event = impl->bkey? TB_JSON_READER_EVENT_KEY : TB_JSON_READER_EVENT_STRING;
+                impl->bkey = tb_false;
+            }
+            break;
+        default:
+            {
+                // parse number
+                if (tb_isdigit10(ch) || ch == '-' || ch == '+' || ch == '.')
+                {
+                    if (tb_json_reader_parse_literal(impl, tb_true)) event = TB_JSON_READER_EVENT_NUMBER;
+                    else failed = tb_true;
+                }
+                // parse true, false or null
+                else if (tb_isalpha(ch) && tb_json_reader_parse_literal(impl, tb_false))
+                {
+                    if (impl->size == 4 && !tb_strnicmp(impl->data, "null", 4)) event = TB_JSON_READER_EVENT_NULL;
+                    else if (impl->size == 4 && !tb_strnicmp(impl->data, "true", 4)) event = TB_JSON_READER_EVENT_BOOLEAN;
+                    else if (impl->size == 5 && !tb_strnicmp(impl->data, "false", 5)) event = TB_JSON_READER_EVENT_BOOLEAN;
+                    else failed = tb_true;
+                }
+                else failed = tb_true;
+            }
+            break;
+        }
+    }
+
+    // trace
+    tb_trace_d("event: %lu, level: %lu, data: %.*s", event, impl->level, (tb_int_t)impl->size, impl->data? impl->data : "");
+
+    // failed?
+    if (failed)
+    {
+        // trace
+        tb_trace_e("invalid json data at %llu", tb_stream_offset(impl->stream) + (impl->head - impl->base));
+        event = TB_JSON_READER_EVENT_NONE;
+    }
+
+    // save event
+    impl->event = event;
+    return event;
+}
+tb_bool_t tb_json_reader_skip(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->stream, tb_false);
+
+    // done
+    switch (impl->event)
+    {
+    case TB_JSON_READER_EVENT_KEY:
+        {
+            // read the value and skip it if be object or array
+            tb_size_t event = tb_json_reader_next(reader);
+            if (event == TB_JSON_READER_EVENT_OBJECT_BEG || event == TB_JSON_READER_EVENT_ARRAY_BEG)
+                return tb_json_reader_skip_container(impl);
+            return (event >= TB_JSON_READER_EVENT_STRING)? tb_true : tb_false;
+        }
+    case TB_JSON_READER_EVENT_OBJECT_BEG:
+    case TB_JSON_READER_EVENT_ARRAY_BEG:
+        return tb_json_reader_skip_container(impl);
+    default:
+        break;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_json_reader_goto(tb_json_reader_ref_t reader, tb_char_t const* path)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->stream && path, tb_false);
+
+    // trace
+    tb_trace_d("goto: %s", path);
+
+    // clear state
+    impl->base  = tb_null;
+    impl->head  = tb_null;
+    impl->tail  = tb_null;
+    impl->level = 0;
+    impl->bkey  = tb_false;
+    impl->event = TB_JSON_READER_EVENT_NONE;
+
+    // seek to the stream head
+    if (!tb_stream_seek(impl->stream, 0)) return tb_false;
+
+    // walk the path items
+    tb_bool_t           ok = tb_true;
+    tb_char_t const*    p = path;
+    while (ok)
+    {
+        // get the item name
+        while (*p == '/') p++;
+        tb_check_break(*p);
+        tb_char_t const* e = p;
+        while (*e && *e != '/') e++;
+        tb_size_t n = e - p;
+
+        // enter the object or array
+        tb_size_t event = tb_json_reader_next(reader);
+        if (event == TB_JSON_READER_EVENT_OBJECT_BEG)
+        {
+            // find the key and the next event will be its value
+            ok = tb_false;
+            while (tb_json_reader_next(reader) == TB_JSON_READER_EVENT_KEY)
+            {
+                if (impl->size == n && !tb_strncmp(impl->data, p, n))
+                {
+                    ok = tb_true;
+                    break;
+                }
+                if (!tb_json_reader_skip(reader)) break;
+            }
+        }
+        else if (event == TB_JSON_READER_EVENT_ARRAY_BEG)
+        {
+            // get the item index
+            tb_size_t           index = 0;
+            tb_char_t const*    q = p;
+            for (; q < e && tb_isdigit10(*q); q++) index = index * 10 + (*q - '0');
+            ok = (q == e)? tb_true : tb_false;
+
+            // skip the previous items
+            while (ok && index--)
+            {
+                event = tb_json_reader_next(reader);
+                if (event == TB_JSON_READER_EVENT_OBJECT_BEG || event == TB_JSON_READER_EVENT_ARRAY_BEG)
+                    ok = tb_json_reader_skip_container(impl);
+                else ok = (event >= TB_JSON_READER_EVENT_STRING)? tb_true : tb_false;
+            }
+
+            // the item exists? the next event will be it
+            if (ok)
+            {
+                tb_long_t ch = tb_json_reader_spaces(impl);
+                if (ch == ',')
+                {
+                    impl->head++;
+                    ch = tb_json_reader_spaces(impl);
+                }
+                ok = (ch >= 0 && ch != ']')? tb_true : tb_false;
+            }
+        }
+        else ok = tb_false;
+
+        // the next item
+        p = e;
+    }
+
+    // failed? restore to the stream head
+    if (!ok)
+    {
+        impl->base  = tb_null;
+        impl->head  = tb_null;
+        impl->tail  = tb_null;
+        impl->level = 0;
+        impl->bkey  = tb_false;
+        tb_stream_seek(impl->stream, 0);
+    }
+
+    // clear event
+    impl->event = TB_JSON_READER_EVENT_NONE;
+
+    // ok?
+    return ok;
+}
+tb_stream_ref_t tb_json_reader_stream(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // skip the parsed data for updating the stream offset
+    if (impl->stream) tb_json_reader_sync(impl);
+    return impl->stream;
+}
+tb_size_t tb_json_reader_level(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, 0);
+
+    return impl->level;
+}
+tb_char_t const* tb_json_reader_data(tb_json_reader_ref_t reader, tb_size_t* psize)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // save size
+    if (psize) *psize = impl->size;
+    return impl->data;
+}
+tb_sint64_t tb_json_reader_integer(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER && impl->data, 0);
+
+    // the number string
+    tb_char_t data[64];
+    tb_size_t size = tb_min(impl->size, sizeof(data) - 1);
+    tb_memcpy(data, impl->data, size);
+    data[size] = '\0';
+
+    // the integer value, json numbers are always decimal
+    return tb_s10toi64(data);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_double_t tb_json_reader_float(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER && impl->data, 0);
+
+    // the number string
+    tb_char_t data[64];
+    tb_size_t size = tb_min(impl->size, sizeof(data) - 1);
+    tb_memcpy(data, impl->data, size);
+    data[size] = '\0';
+
+    // the float value, json numbers are always decimal
+    tb_double_t value = tb_s10tod(data);
+
+    // has exponent? e.g. 1.5e-3
+    tb_char_t const* p = data;
+    while (*p && *p != 'e' && *p != 'E') p++;
+    if (*p)
+    {
+        tb_int32_t  exp = tb_s10toi32(p + 1);
+        tb_double_t base = 10.;
+        tb_uint32_t n = (tb_uint32_t)(exp < 0? -exp : exp);
+        tb_double_t scale = 1.;
+        for (; n; n >>= 1, base *= base)
+            if (n & 1) scale *= base;
+        value = exp < 0? value / scale : value * scale;
+    }
+    return value;
+}
+#endif
+tb_bool_t tb_json_reader_boolean(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_BOOLEAN && impl->data, tb_false);
+
+    // true?
+    return (impl->data[0] == 't' || impl->data[0] == 'T')? tb_true : tb_false;
+}
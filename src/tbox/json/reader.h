@@ -0,0 +1,240 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        reader.h
+ * @ingroup     json
+ *
+ */
+#ifndef TB_JSON_READER_H
+#define TB_JSON_READER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the json reader event type for iterator
+typedef enum __tb_json_reader_event_t
+{
+    TB_JSON_READER_EVENT_NONE                   = 0     //!< end or failed
+,   TB_JSON_READER_EVENT_OBJECT_BEG             = 1     //!< {
+,   TB_JSON_READER_EVENT_OBJECT_END             = 2     //!< }
+,   TB_JSON_READER_EVENT_ARRAY_BEG              = 3     //!< [
+,   TB_JSON_READER_EVENT_ARRAY_END              = 4     //!< ]
+,   TB_JSON_READER_EVENT_KEY                    = 5     //!< the object key
+,   TB_JSON_READER_EVENT_STRING                 = 6     //!< the string value
+,   TB_JSON_READER_EVENT_NUMBER                 = 7     //!< the number value
+,   TB_JSON_READER_EVENT_BOOLEAN                = 8     //!< true or false
+,   TB_JSON_READER_EVENT_NULL                   = 9     //!< null
+
+}tb_json_reader_event_t;
+
+/*! the json pull reader ref type
+ *
+ * it only parses the json tokens from the peeked stream data and never builds the objects,
+ * the key and string values are returned as the slices of the peeked data without copying them,
+ * so we can walk the large json document and only look at the interested values.
+ */
+typedef __tb_typeref__(json_reader);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the json reader
+ *
+ * @return              the reader
+ */
+tb_json_reader_ref_t    tb_json_reader_init(tb_noarg_t);
+
+/*! exit the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_exit(tb_json_reader_ref_t reader);
+
+/*! open the json reader
+ *
+ * @param reader        the json reader
+ * @param stream        the stream, will open it if be not opened
+ * @param bowner        the json reader is owner of the stream?
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner);
+
+/*! clos the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_clos(tb_json_reader_ref_t reader);
+
+/*! the next iterator for the json reader
+ *
+ * @param reader        the json reader
+ * @return              the iterator event
+ *
+ * @code
+ *
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // goto, .e.g /users/0/name
+            tb_bool_t ok = tb_true;
+            if (argv[2]) ok = tb_json_reader_goto(reader, argv[2]);
+
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            while (ok && (event = tb_json_reader_next(reader)))
+            {
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_KEY:
+                    {
+                        // only read the interested value
+                        tb_size_t           size = 0;
+                        tb_char_t const*    data = tb_json_reader_data(reader, &size);
+                        if (size == 4 && !tb_strncmp(data, "name", 4))
+                        {
+                            if (tb_json_reader_next(reader) == TB_JSON_READER_EVENT_STRING)
+                            {
+                                // the data is not terminated, copy it first
+                                tb_char_t name[256];
+                                data = tb_json_reader_data(reader, &size);
+                                size = tb_min(size, sizeof(name) - 1);
+                                tb_memcpy(name, data, size);
+                                name[size] = '\0';
+                                tb_printf("name: %s\n", name);
+                            }
+                        }
+                        // skip the other values
+                        else tb_json_reader_skip(reader);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+
+ * @endcode
+ */
+tb_size_t               tb_json_reader_next(tb_json_reader_ref_t reader);
+
+/*! skip the current value
+ *
+ * skip the value of the current key if the current event is TB_JSON_READER_EVENT_KEY,
+ * or skip the left items of the current object or array (including the end event) if the current event is the begin event.
+ * it only finds the brackets and quotes to skip the value quickly and does not parse the tokens.
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_skip(tb_json_reader_ref_t reader);
+
+/*! seek to the given value, .e.g /users/0/name
+ *
+ * the next event will be the given value after seeking to it,
+ * and the array item is indexed by the decimal number.
+ *
+ * @param reader        the json reader
+ * @param path          the json path, the root value if be "/"
+ *
+ * @return              tb_true or tb_false
+ *
+ * @note the stream will be reseted
+ */
+tb_bool_t               tb_json_reader_goto(tb_json_reader_ref_t reader, tb_char_t const* path);
+
+/*! the json stream
+ *
+ * @param reader        the json reader
+ * @return              the json stream
+ */
+tb_stream_ref_t         tb_json_reader_stream(tb_json_reader_ref_t reader);
+
+/*! the json level
+ *
+ * @param reader        the json reader
+ * @return              the nested level of the current object or array
+ */
+tb_size_t               tb_json_reader_level(tb_json_reader_ref_t reader);
+
+/*! the data slice of the current key, string or number
+ *
+ * the escaped characters of the key and string have been unescaped,
+ * it points to the peeked stream data directly if there are no escaped characters.
+ *
+ * @param reader        the json reader
+ * @param psize         the data size pointer
+ *
+ * @return              the data, it is not null-terminated and is only valid before the next event
+ */
+tb_char_t const*        tb_json_reader_data(tb_json_reader_ref_t reader, tb_size_t* psize);
+
+/*! the integer value of the current number
+ *
+ * the fraction and exponent parts will be ignored, e.g. 1.5e3 => 1
+ *
+ * @param reader        the json reader
+ *
+ * @return              the integer value
+ */
+tb_sint64_t             tb_json_reader_integer(tb_json_reader_ref_t reader);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! the float value of the current number
+ *
+ * @param reader        the json reader
+ *
+ * @return              the float value
+ */
+tb_double_t             tb_json_reader_float(tb_json_reader_ref_t reader);
+#endif
+
+/*! the boolean value of the current boolean
+ *
+ * @param reader        the json reader
+ *
+ * @return              the boolean value
+ */
+tb_bool_t               tb_json_reader_boolean(tb_json_reader_ref_t reader);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -24,12 +24,22 @@
  */
 #include "libc.h"
 #include "../stdio/printf_object.h"
+#include "../../platform/cpu.h"
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "../string/impl/x86/simd.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_bool_t tb_libc_init_env()
 {
+    // select the simd kernels of the string functions
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+    tb_libc_string_simd_init(tb_cpu_features());
+#endif
+
+    // ok
     return tb_true;
 }
 tb_void_t tb_libc_exit_env()
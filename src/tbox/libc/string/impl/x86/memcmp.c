@@ -23,11 +23,14 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+#   define TB_LIBC_STRING_IMPL_MEMCMP
+#elif defined(TB_ASSEMBLER_IS_GAS)
 //#     define TB_LIBC_STRING_IMPL_MEMCMP
 #endif
 
@@ -35,7 +38,16 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+static tb_long_t tb_memcmp_impl(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // done
+    return g_libc_string_simd.memcmp(s1, s2, n);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_long_t tb_memcmp_impl(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
 
@@ -0,0 +1,644 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simd.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "simd.h"
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+#   include "../../../../utils/bits.h"
+#   include "../../../../platform/cpu.h"
+#   include "../../../misc/ctype.h"
+#   include <emmintrin.h>
+#   ifdef TB_LIBC_STRING_SIMD_AVX2
+#       include <immintrin.h>
+#   endif
+#endif
+
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the minimum page size
+ *
+ * the aligned loads never cross the page boundary, so they can read the bytes after '\0' safely,
+ * but the unaligned loads near the page end need be split to the byte loads.
+ */
+#define TB_LIBC_STRING_SIMD_PAGE            (4096)
+
+// the search window of strstr, we need not get the whole length of the long string first
+#define TB_LIBC_STRING_SIMD_WINDOW          (4096)
+
+// the first set bit of the mask
+#define tb_libc_string_simd_fb1(mask)       __builtin_ctz(mask)
+
+// compile the avx2 kernels for the target
+#if defined(TB_LIBC_STRING_SIMD_AVX2) && !defined(TB_ARCH_AVX2)
+#   define __tb_avx2__                      __attribute__((target("avx2")))
+#else
+#   define __tb_avx2__
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_libc_string_simd_iequal(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    while (n--)
+    {
+        if (*p1 != *p2 && tb_tolower(*p1) != tb_tolower(*p2)) return tb_false;
+        p1++;
+        p2++;
+    }
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * sse2 kernels
+ */
+static __tb_inline_force__ __m128i tb_libc_string_simd_fold_sse2(__m128i v)
+{
+    // 'A' <= v <= 'Z'? v + 0x20 : v, the bytes >= 0x80 are negative and will be not changed
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_add_epi8(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+static __tb_no_sanitize_address__ tb_size_t tb_libc_string_simd_strlen_sse2(tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // scan the first aligned block and skip the bytes before s
+    __m128i const       zero = _mm_setzero_si128();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)15);
+    tb_uint32_t         mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), zero)) >> (s - p);
+    if (mask) return tb_libc_string_simd_fb1(mask);
+
+    // scan the blocks until p is aligned by 64 bytes
+    p += 16;
+    while ((tb_size_t)p & 63)
+    {
+        mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), zero));
+        if (mask) return (p - s) + tb_libc_string_simd_fb1(mask);
+        p += 16;
+    }
+
+    // scan 64 bytes each time, they are in the same page
+    while (1)
+    {
+        __m128i v0 = _mm_load_si128((__m128i const*)p);
+        __m128i v1 = _mm_load_si128((__m128i const*)(p + 16));
+        __m128i v2 = _mm_load_si128((__m128i const*)(p + 32));
+        __m128i v3 = _mm_load_si128((__m128i const*)(p + 48));
+        __m128i vm = _mm_min_epu8(_mm_min_epu8(v0, v1), _mm_min_epu8(v2, v3));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(vm, zero))) break;
+        p += 64;
+    }
+
+    // find '\0' in these 64 bytes
+    while (1)
+    {
+        mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), zero));
+        if (mask) return (p - s) + tb_libc_string_simd_fb1(mask);
+        p += 16;
+    }
+    return 0;
+}
+static __tb_no_sanitize_address__ tb_size_t tb_libc_string_simd_strnlen_sse2(tb_char_t const* s, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+    tb_check_return_val(n, 0);
+
+    // scan the first aligned block and skip the bytes before s
+    __m128i const       zero = _mm_setzero_si128();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)15);
+    tb_uint32_t         mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), zero)) >> (s - p);
+    tb_size_t           size = 0;
+    if (mask)
+    {
+        size = tb_libc_string_simd_fb1(mask);
+        return size < n? size : n;
+    }
+
+    // scan the next aligned blocks, the first byte of each block is always in the first n bytes
+    size = 16 - (s - p);
+    while (size < n)
+    {
+        mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)(s + size)), zero));
+        if (mask)
+        {
+            size += tb_libc_string_simd_fb1(mask);
+            return size < n? size : n;
+        }
+        size += 16;
+    }
+    return n;
+}
+static __tb_no_sanitize_address__ tb_char_t* tb_libc_string_simd_strnchr_sse2(tb_char_t const* s, tb_size_t n, tb_char_t c)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_null);
+    tb_check_return_val(n && c, tb_null);
+
+    // find c or '\0' in the first aligned block and skip the bytes before s
+    __m128i const       zero = _mm_setzero_si128();
+    __m128i const       vc = _mm_set1_epi8(c);
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)15);
+    __m128i             v = _mm_load_si128((__m128i const*)p);
+    tb_uint32_t         mask = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, vc))) >> (s - p);
+    tb_size_t           size = 0;
+    if (!mask)
+    {
+        // find it in the next aligned blocks
+        size = 16 - (s - p);
+        while (size < n)
+        {
+            v = _mm_load_si128((__m128i const*)(s + size));
+            mask = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, vc)));
+            if (mask) break;
+            size += 16;
+        }
+        tb_check_return_val(mask, tb_null);
+    }
+
+    // found c before '\0'?
+    size += tb_libc_string_simd_fb1(mask);
+    return (size < n && s[size] == c)? (tb_char_t*)s + size : tb_null;
+}
+static __tb_no_sanitize_address__ tb_long_t tb_libc_string_simd_strcmp_sse2(tb_char_t const* s1, tb_char_t const* s2)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // compare them
+    __m128i const       zero = _mm_setzero_si128();
+    tb_byte_t const*    p1 = (tb_byte_t const*)s1;
+    tb_byte_t const*    p2 = (tb_byte_t const*)s2;
+    while (1)
+    {
+        // the unaligned loads can be used before the page end of p1 and p2
+        tb_size_t left1 = TB_LIBC_STRING_SIMD_PAGE - ((tb_size_t)p1 & (TB_LIBC_STRING_SIMD_PAGE - 1));
+        tb_size_t left2 = TB_LIBC_STRING_SIMD_PAGE - ((tb_size_t)p2 & (TB_LIBC_STRING_SIMD_PAGE - 1));
+        tb_size_t left = tb_min(left1, left2);
+        while (left >= 16)
+        {
+            // find the first different byte or '\0'
+            __m128i     v1 = _mm_loadu_si128((__m128i const*)p1);
+            __m128i     v2 = _mm_loadu_si128((__m128i const*)p2);
+            tb_uint32_t mask = ((tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) ^ 0xffff) | (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v1, zero));
+            if (mask)
+            {
+                tb_size_t i = tb_libc_string_simd_fb1(mask);
+                return ((tb_long_t)p1[i]) - p2[i];
+            }
+            p1 += 16;
+            p2 += 16;
+            left -= 16;
+        }
+
+        // compare the left bytes one by one near the page end
+        while (left--)
+        {
+            if (*p1 != *p2 || !*p1) return ((tb_long_t)*p1) - *p2;
+            p1++;
+            p2++;
+        }
+    }
+    return 0;
+}
+static tb_long_t tb_libc_string_simd_memcmp_sse2(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // equal or empty?
+    if (s1 == s2 || !n) return 0;
+
+    // compare the short data
+    tb_byte_t const* p1 = (tb_byte_t const*)s1;
+    tb_byte_t const* p2 = (tb_byte_t const*)s2;
+    if (n < 16)
+    {
+        tb_long_t r = 0;
+        while (n-- && ((r = ((tb_long_t)(*p1++)) - *p2++) == 0)) ;
+        return r;
+    }
+
+    // compare 64 bytes each time
+    tb_size_t i = 0;
+    while (i + 64 <= n)
+    {
+        __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i)), _mm_loadu_si128((__m128i const*)(p2 + i)));
+        __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 16)), _mm_loadu_si128((__m128i const*)(p2 + i + 16)));
+        __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 32)), _mm_loadu_si128((__m128i const*)(p2 + i + 32)));
+        __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i + 48)), _mm_loadu_si128((__m128i const*)(p2 + i + 48)));
+        if ((tb_uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3))) != 0xffff) break;
+        i += 64;
+    }
+    tb_check_return_val(i < n, 0);
+
+    // find the first different byte, the last block may overlap the compared bytes
+    while (1)
+    {
+        if (i + 16 > n) i = n - 16;
+        tb_uint32_t mask = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + i)), _mm_loadu_si128((__m128i const*)(p2 + i)))) ^ 0xffff;
+        if (mask)
+        {
+            i += tb_libc_string_simd_fb1(mask);
+            return ((tb_long_t)p1[i]) - p2[i];
+        }
+        i += 16;
+        if (i >= n) break;
+    }
+    return 0;
+}
+static __tb_inline_force__ tb_char_t* tb_libc_string_simd_memmem_sse2_impl(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+    tb_check_return_val(n2, (tb_char_t*)s1);
+    tb_check_return_val(n1 >= n2, tb_null);
+
+    /* find the candidates which match the first and last bytes of s2, and verify the middle bytes
+     *
+     * s1: [i, i + 16) matches the first byte
+     *     [i + n2 - 1, i + n2 + 15) matches the last byte
+     */
+    tb_byte_t const*    p1 = (tb_byte_t const*)s1;
+    tb_byte_t const*    p2 = (tb_byte_t const*)s2;
+    tb_byte_t           first = icase? (tb_byte_t)tb_tolower(p2[0]) : p2[0];
+    tb_byte_t           last = icase? (tb_byte_t)tb_tolower(p2[n2 - 1]) : p2[n2 - 1];
+    __m128i const       vf = _mm_set1_epi8((tb_char_t)first);
+    __m128i const       vl = _mm_set1_epi8((tb_char_t)last);
+    tb_size_t           i = 0;
+    tb_size_t           maxi = n1 - n2;
+    while (i + 16 <= maxi + 1)
+    {
+        __m128i a = _mm_loadu_si128((__m128i const*)(p1 + i));
+        __m128i b = _mm_loadu_si128((__m128i const*)(p1 + i + n2 - 1));
+        if (icase)
+        {
+            a = tb_libc_string_simd_fold_sse2(a);
+            b = tb_libc_string_simd_fold_sse2(b);
+        }
+        tb_uint32_t mask = (tb_uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, vf), _mm_cmpeq_epi8(b, vl)));
+        while (mask)
+        {
+            tb_size_t k = i + tb_libc_string_simd_fb1(mask);
+            if (n2 <= 2 || (icase? tb_libc_string_simd_iequal(p1 + k + 1, p2 + 1, n2 - 2) : !tb_libc_string_simd_memcmp_sse2(p1 + k + 1, p2 + 1, n2 - 2)))
+                return (tb_char_t*)p1 + k;
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+
+    // find it in the left bytes
+    for (; i <= maxi; i++)
+    {
+        if (icase? tb_libc_string_simd_iequal(p1 + i, p2, n2) : !tb_libc_string_simd_memcmp_sse2(p1 + i, p2, n2))
+            return (tb_char_t*)p1 + i;
+    }
+    return tb_null;
+}
+static tb_char_t* tb_libc_string_simd_memmem_sse2(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2)
+{
+    return tb_libc_string_simd_memmem_sse2_impl(s1, n1, s2, n2, tb_false);
+}
+static tb_char_t* tb_libc_string_simd_memimem_sse2(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2)
+{
+    return tb_libc_string_simd_memmem_sse2_impl(s1, n1, s2, n2, tb_true);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * avx2 kernels
+ */
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static __tb_inline_force__ __tb_avx2__ __m256i tb_libc_string_simd_fold_avx2(__m256i v)
+{
+    // 'A' <= v <= 'Z'? v + 0x20 : v, the bytes >= 0x80 are negative and will be not changed
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_add_epi8(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+static __tb_no_sanitize_address__ __tb_avx2__ tb_size_t tb_libc_string_simd_strlen_avx2(tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // scan the first aligned block and skip the bytes before s
+    __m256i const       zero = _mm256_setzero_si256();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)31);
+    tb_uint32_t         mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), zero)) >> (s - p);
+    if (mask) return tb_libc_string_simd_fb1(mask);
+
+    // scan the blocks until p is aligned by 128 bytes
+    p += 32;
+    while ((tb_size_t)p & 127)
+    {
+        mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), zero));
+        if (mask) return (p - s) + tb_libc_string_simd_fb1(mask);
+        p += 32;
+    }
+
+    // scan 128 bytes each time, they are in the same page
+    while (1)
+    {
+        __m256i v0 = _mm256_load_si256((__m256i const*)p);
+        __m256i v1 = _mm256_load_si256((__m256i const*)(p + 32));
+        __m256i v2 = _mm256_load_si256((__m256i const*)(p + 64));
+        __m256i v3 = _mm256_load_si256((__m256i const*)(p + 96));
+        __m256i vm = _mm256_min_epu8(_mm256_min_epu8(v0, v1), _mm256_min_epu8(v2, v3));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(vm, zero))) break;
+        p += 128;
+    }
+
+    // find '\0' in these 128 bytes
+    while (1)
+    {
+        mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), zero));
+        if (mask) return (p - s) + tb_libc_string_simd_fb1(mask);
+        p += 32;
+    }
+    return 0;
+}
+static __tb_no_sanitize_address__ __tb_avx2__ tb_size_t tb_libc_string_simd_strnlen_avx2(tb_char_t const* s, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+    tb_check_return_val(n, 0);
+
+    // scan the first aligned block and skip the bytes before s
+    __m256i const       zero = _mm256_setzero_si256();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)31);
+    tb_uint32_t         mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), zero)) >> (s - p);
+    tb_size_t           size = 0;
+    if (mask)
+    {
+        size = tb_libc_string_simd_fb1(mask);
+        return size < n? size : n;
+    }
+
+    // scan the next aligned blocks, the first byte of each block is always in the first n bytes
+    size = 32 - (s - p);
+    while (size < n)
+    {
+        mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)(s + size)), zero));
+        if (mask)
+        {
+            size += tb_libc_string_simd_fb1(mask);
+            return size < n? size : n;
+        }
+        size += 32;
+    }
+    return n;
+}
+static __tb_no_sanitize_address__ __tb_avx2__ tb_char_t* tb_libc_string_simd_strnchr_avx2(tb_char_t const* s, tb_size_t n, tb_char_t c)
+{
+    // check
+    tb_assert_and_check_return_val(s, tb_null);
+    tb_check_return_val(n && c, tb_null);
+
+    // find c or '\0' in the first aligned block and skip the bytes before s
+    __m256i const       zero = _mm256_setzero_si256();
+    __m256i const       vc = _mm256_set1_epi8(c);
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)31);
+    __m256i             v = _mm256_load_si256((__m256i const*)p);
+    tb_uint32_t         mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, zero), _mm256_cmpeq_epi8(v, vc))) >> (s - p);
+    tb_size_t           size = 0;
+    if (!mask)
+    {
+        // find it in the next aligned blocks
+        size = 32 - (s - p);
+        while (size < n)
+        {
+            v = _mm256_load_si256((__m256i const*)(s + size));
+            mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, zero), _mm256_cmpeq_epi8(v, vc)));
+            if (mask) break;
+            size += 32;
+        }
+        tb_check_return_val(mask, tb_null);
+    }
+
+    // found c before '\0'?
+    size += tb_libc_string_simd_fb1(mask);
+    return (size < n && s[size] == c)? (tb_char_t*)s + size : tb_null;
+}
+static __tb_no_sanitize_address__ __tb_avx2__ tb_long_t tb_libc_string_simd_strcmp_avx2(tb_char_t const* s1, tb_char_t const* s2)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // compare them
+    __m256i const       zero = _mm256_setzero_si256();
+    tb_byte_t const*    p1 = (tb_byte_t const*)s1;
+    tb_byte_t const*    p2 = (tb_byte_t const*)s2;
+    while (1)
+    {
+        // the unaligned loads can be used before the page end of p1 and p2
+        tb_size_t left1 = TB_LIBC_STRING_SIMD_PAGE - ((tb_size_t)p1 & (TB_LIBC_STRING_SIMD_PAGE - 1));
+        tb_size_t left2 = TB_LIBC_STRING_SIMD_PAGE - ((tb_size_t)p2 & (TB_LIBC_STRING_SIMD_PAGE - 1));
+        tb_size_t left = tb_min(left1, left2);
+        while (left >= 32)
+        {
+            // find the first different byte or '\0'
+            __m256i     v1 = _mm256_loadu_si256((__m256i const*)p1);
+            __m256i     v2 = _mm256_loadu_si256((__m256i const*)p2);
+            tb_uint32_t mask = ~(tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)) | (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, zero));
+            if (mask)
+            {
+                tb_size_t i = tb_libc_string_simd_fb1(mask);
+                return ((tb_long_t)p1[i]) - p2[i];
+            }
+            p1 += 32;
+            p2 += 32;
+            left -= 32;
+        }
+
+        // compare the left bytes one by one near the page end
+        while (left--)
+        {
+            if (*p1 != *p2 || !*p1) return ((tb_long_t)*p1) - *p2;
+            p1++;
+            p2++;
+        }
+    }
+    return 0;
+}
+static __tb_avx2__ tb_long_t tb_libc_string_simd_memcmp_avx2(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, 0);
+
+    // equal or empty?
+    if (s1 == s2 || !n) return 0;
+
+    // compare the short data
+    tb_byte_t const* p1 = (tb_byte_t const*)s1;
+    tb_byte_t const* p2 = (tb_byte_t const*)s2;
+    if (n < 32) return tb_libc_string_simd_memcmp_sse2(s1, s2, n);
+
+    // compare 128 bytes each time
+    tb_size_t i = 0;
+    while (i + 128 <= n)
+    {
+        __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i)), _mm256_loadu_si256((__m256i const*)(p2 + i)));
+        __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 32)), _mm256_loadu_si256((__m256i const*)(p2 + i + 32)));
+        __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 64)), _mm256_loadu_si256((__m256i const*)(p2 + i + 64)));
+        __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i + 96)), _mm256_loadu_si256((__m256i const*)(p2 + i + 96)));
+        if ((tb_uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(e0, e1), _mm256_and_si256(e2, e3))) != 0xffffffff) break;
+        i += 128;
+    }
+    tb_check_return_val(i < n, 0);
+
+    // find the first different byte, the last block may overlap the compared bytes
+    while (1)
+    {
+        if (i + 32 > n) i = n - 32;
+        tb_uint32_t mask = ~(tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + i)), _mm256_loadu_si256((__m256i const*)(p2 + i))));
+        if (mask)
+        {
+            i += tb_libc_string_simd_fb1(mask);
+            return ((tb_long_t)p1[i]) - p2[i];
+        }
+        i += 32;
+        if (i >= n) break;
+    }
+    return 0;
+}
+static __tb_inline_force__ __tb_avx2__ tb_char_t* tb_libc_string_simd_memmem_avx2_impl(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+    tb_check_return_val(n2, (tb_char_t*)s1);
+    tb_check_return_val(n1 >= n2, tb_null);
+
+    /* find the candidates which match the first and last bytes of s2, and verify the middle bytes
+     *
+     * s1: [i, i + 32) matches the first byte
+     *     [i + n2 - 1, i + n2 + 31) matches the last byte
+     */
+    tb_byte_t const*    p1 = (tb_byte_t const*)s1;
+    tb_byte_t const*    p2 = (tb_byte_t const*)s2;
+    tb_byte_t           first = icase? (tb_byte_t)tb_tolower(p2[0]) : p2[0];
+    tb_byte_t           last = icase? (tb_byte_t)tb_tolower(p2[n2 - 1]) : p2[n2 - 1];
+    __m256i const       vf = _mm256_set1_epi8((tb_char_t)first);
+    __m256i const       vl = _mm256_set1_epi8((tb_char_t)last);
+    tb_size_t           i = 0;
+    tb_size_t           maxi = n1 - n2;
+    while (i + 32 <= maxi + 1)
+    {
+        __m256i a = _mm256_loadu_si256((__m256i const*)(p1 + i));
+        __m256i b = _mm256_loadu_si256((__m256i const*)(p1 + i + n2 - 1));
+        if (icase)
+        {
+            a = tb_libc_string_simd_fold_avx2(a);
+            b = tb_libc_string_simd_fold_avx2(b);
+        }
+        tb_uint32_t mask = (tb_uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, vf), _mm256_cmpeq_epi8(b, vl)));
+        while (mask)
+        {
+            tb_size_t k = i + tb_libc_string_simd_fb1(mask);
+            if (n2 <= 2 || (icase? tb_libc_string_simd_iequal(p1 + k + 1, p2 + 1, n2 - 2) : !tb_libc_string_simd_memcmp_avx2(p1 + k + 1, p2 + 1, n2 - 2)))
+                return (tb_char_t*)p1 + k;
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+
+    // find it in the left bytes
+    return i <= maxi? tb_libc_string_simd_memmem_sse2_impl(s1 + i, n1 - i, s2, n2, icase) : tb_null;
+}
+static __tb_avx2__ tb_char_t* tb_libc_string_simd_memmem_avx2(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2)
+{
+    return tb_libc_string_simd_memmem_avx2_impl(s1, n1, s2, n2, tb_false);
+}
+static __tb_avx2__ tb_char_t* tb_libc_string_simd_memimem_avx2(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2)
+{
+    return tb_libc_string_simd_memmem_avx2_impl(s1, n1, s2, n2, tb_true);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+tb_libc_string_simd_t g_libc_string_simd =
+{
+    tb_libc_string_simd_strlen_sse2
+,   tb_libc_string_simd_strnlen_sse2
+,   tb_libc_string_simd_strnchr_sse2
+,   tb_libc_string_simd_strcmp_sse2
+,   tb_libc_string_simd_memcmp_sse2
+,   tb_libc_string_simd_memmem_sse2
+,   tb_libc_string_simd_memimem_sse2
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_libc_string_simd_init(tb_size_t features)
+{
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+    // use the avx2 kernels?
+    if (features & TB_CPU_FEATURE_AVX2)
+    {
+        g_libc_string_simd.strlen   = tb_libc_string_simd_strlen_avx2;
+        g_libc_string_simd.strnlen  = tb_libc_string_simd_strnlen_avx2;
+        g_libc_string_simd.strnchr  = tb_libc_string_simd_strnchr_avx2;
+        g_libc_string_simd.strcmp   = tb_libc_string_simd_strcmp_avx2;
+        g_libc_string_simd.memcmp   = tb_libc_string_simd_memcmp_avx2;
+        g_libc_string_simd.memmem   = tb_libc_string_simd_memmem_avx2;
+        g_libc_string_simd.memimem  = tb_libc_string_simd_memimem_avx2;
+    }
+#endif
+}
+tb_char_t* tb_libc_string_simd_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_bool_t icase)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // the empty string will be found at the head
+    tb_size_t n2 = g_libc_string_simd.strlen(s2);
+    tb_check_return_val(n2, (tb_char_t*)s1);
+
+    /* find it window by window, the last n2 - 1 bytes of each window are also the head of the next window
+     *
+     * the window is not smaller than n2, so the overlapped bytes are scanned twice at most
+     */
+    tb_size_t window = tb_max(TB_LIBC_STRING_SIMD_WINDOW, n2);
+    tb_size_t base = 0;
+    while (base < n1)
+    {
+        // get the string length of this window
+        tb_size_t need = n1 - base;
+        if (need > window + n2 - 1) need = window + n2 - 1;
+        tb_size_t size = g_libc_string_simd.strnlen(s1 + base, need);
+
+        // find it in this window
+        tb_char_t* p = icase? g_libc_string_simd.memimem(s1 + base, size, s2, n2) : g_libc_string_simd.memmem(s1 + base, size, s2, n2);
+        tb_check_return_val(!p, p);
+
+        // end?
+        tb_check_break(size == need);
+        base += window;
+    }
+    return tb_null;
+}
+#endif
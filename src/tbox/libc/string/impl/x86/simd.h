@@ -0,0 +1,118 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simd.h
+ *
+ */
+#ifndef TB_LIBC_STRING_IMPL_x86_SIMD_H
+#define TB_LIBC_STRING_IMPL_x86_SIMD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the simd kernels? sse2 is the baseline and the avx2 kernels are selected at runtime
+#if defined(TB_ARCH_SSE2) && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)) && !defined(TB_CONFIG_MICRO_ENABLE)
+#   define TB_LIBC_STRING_SIMD_ENABLE
+#   if defined(TB_ARCH_AVX2) || defined(TB_COMPILER_IS_CLANG) || TB_COMPILER_VERSION_BE(4, 9)
+#       define TB_LIBC_STRING_SIMD_AVX2
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the simd kernels of the string functions
+ *
+ * they have the same semantics as the generic implementations, e.g. libc/string/strlen.c
+ */
+typedef struct __tb_libc_string_simd_t
+{
+    // get the string length
+    tb_size_t               (*strlen)(tb_char_t const* s);
+
+    // get the string length with the maximum size
+    tb_size_t               (*strnlen)(tb_char_t const* s, tb_size_t n);
+
+    // find the character before '\0' in the first n bytes, '\0' will be not found
+    tb_char_t*              (*strnchr)(tb_char_t const* s, tb_size_t n, tb_char_t c);
+
+    // compare the strings
+    tb_long_t               (*strcmp)(tb_char_t const* s1, tb_char_t const* s2);
+
+    // compare the memory
+    tb_long_t               (*memcmp)(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n);
+
+    // find the first n2 bytes of s2 in the first n1 bytes of s1
+    tb_char_t*              (*memmem)(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2);
+
+    // find the first n2 bytes of s2 in the first n1 bytes of s1 and ignore the ascii case
+    tb_char_t*              (*memimem)(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_size_t n2);
+
+}tb_libc_string_simd_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the selected simd kernels, the sse2 kernels will be used before tb_init()
+extern tb_libc_string_simd_t    g_libc_string_simd;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* select the simd kernels for the cpu features, it will be called in tb_init()
+ *
+ * @param features  the cpu features
+ */
+tb_void_t           tb_libc_string_simd_init(tb_size_t features);
+
+/* find s2 in the string s1 with the maximum size
+ *
+ * the long string will be searched window by window, so we need not get the whole length first
+ *
+ * @param s1        the string
+ * @param n1        the maximum size of s1, (tb_size_t)-1 if unlimited
+ * @param s2        the finded string
+ * @param icase     ignore the ascii case?
+ *
+ * @return          the position or tb_null
+ */
+tb_char_t*          tb_libc_string_simd_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2, tb_bool_t icase);
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -23,18 +23,31 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+#   define TB_LIBC_STRING_IMPL_STRCMP
+#elif defined(TB_ASSEMBLER_IS_GAS)
 //#     define TB_LIBC_STRING_IMPL_STRCMP
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+static tb_long_t tb_strcmp_impl(tb_char_t const* s1, tb_char_t const* s2)
+{
+    // check
+    if (s1 == s2) return 0;
+    tb_assert_and_check_return_val(s1 && s2, -1);
+
+    // done
+    return g_libc_string_simd.strcmp(s1, s2);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_long_t tb_strcmp_impl(tb_char_t const* s1, tb_char_t const* s2)
 {
     tb_assert_and_check_return_val(s1 && s2, 0);
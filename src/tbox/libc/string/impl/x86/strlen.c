@@ -23,18 +23,30 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+#   define TB_LIBC_STRING_IMPL_STRLEN
+#elif defined(TB_ASSEMBLER_IS_GAS)
 //#     define TB_LIBC_STRING_IMPL_STRLEN
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+static tb_size_t tb_strlen_impl(tb_char_t const* s)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // done
+    return g_libc_string_simd.strlen(s);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_size_t tb_strlen_impl(tb_char_t const* s)
 {
     tb_assert_and_check_return_val(s, 0);
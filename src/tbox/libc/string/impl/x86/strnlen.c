@@ -23,18 +23,30 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+#   define TB_LIBC_STRING_IMPL_STRNLEN
+#elif defined(TB_ASSEMBLER_IS_GAS)
 //#     define TB_LIBC_STRING_IMPL_STRNLEN
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_LIBC_STRING_SIMD_ENABLE)
+static tb_size_t tb_strnlen_impl(tb_char_t const* s, tb_size_t n)
+{
+    // check
+    tb_assert_and_check_return_val(s, 0);
+
+    // done
+    return g_libc_string_simd.strnlen(s, n);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_size_t tb_strnlen_impl(tb_char_t const* s, tb_size_t n)
 {
     tb_assert_and_check_return_val(s, 0);
@@ -26,7 +26,7 @@
 #include "string.h"
 #include "../../memory/impl/prefix.h"
 #ifndef TB_CONFIG_LIBC_HAVE_MEMCMP
-#   if defined(TB_ARCH_x86)
+#   if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
 #       include "impl/x86/memcmp.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/memcmp.c"
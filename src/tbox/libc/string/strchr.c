@@ -26,6 +26,8 @@
 #include "string.h"
 #ifdef TB_CONFIG_LIBC_HAVE_STRCHR
 #   include <string.h>
+#elif defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "impl/x86/simd.h"
 #endif
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -37,6 +39,12 @@ tb_char_t* tb_strchr(tb_char_t const* s, tb_char_t c)
     tb_assert(s);
     return (tb_char_t*)strchr(s, c);
 }
+#elif defined(TB_LIBC_STRING_SIMD_ENABLE)
+tb_char_t* tb_strchr(tb_char_t const* s, tb_char_t c)
+{
+    tb_assert_and_check_return_val(s, tb_null);
+    return g_libc_string_simd.strnchr(s, (tb_size_t)-1, c);
+}
 #else
 tb_char_t* tb_strchr(tb_char_t const* s, tb_char_t c)
 {
@@ -25,7 +25,7 @@
  */
 #include "string.h"
 #ifndef TB_CONFIG_LIBC_HAVE_STRCMP
-#   if defined(TB_ARCH_x86)
+#   if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
 #       include "impl/x86/strcmp.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/strcmp.c"
@@ -26,6 +26,8 @@
 #include "string.h"
 #ifdef TB_CONFIG_LIBC_HAVE_STRCASESTR
 #   include <string.h>
+#elif defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "impl/x86/simd.h"
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -39,6 +41,15 @@ tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
     tb_assert_and_check_return_val(s1 && s2, tb_null);
     return strcasestr(s1, s2);
 }
+#elif defined(TB_LIBC_STRING_SIMD_ENABLE)
+tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
+{
+    // check
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+
+    // find it using the simd kernels
+    return tb_libc_string_simd_strnstr(s1, (tb_size_t)-1, s2, tb_true);
+}
 #else
 tb_char_t* tb_stristr(tb_char_t const* s1, tb_char_t const* s2)
 {
@@ -24,6 +24,9 @@
  * includes
  */
 #include "string.h"
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "impl/x86/simd.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -34,6 +37,10 @@ tb_char_t* tb_strnchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
     // check
     tb_assert_and_check_return_val(s, tb_null);
 
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+    // find it using the simd kernel
+    return g_libc_string_simd.strnchr(s, n, c);
+#else
     // find
     tb_char_t const* e = s + n;
     while (s < e && *s)
@@ -43,4 +50,5 @@ tb_char_t* tb_strnchr(tb_char_t const* s, tb_size_t n, tb_char_t c)
 
     }
     return tb_null;
+#endif
 }
@@ -24,6 +24,9 @@
  * includes
  */
 #include "string.h"
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "impl/x86/simd.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -33,6 +36,10 @@ tb_char_t* tb_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
     // check
     tb_assert_and_check_return_val(s1 && s2 && n1, tb_null);
 
+#ifdef TB_LIBC_STRING_SIMD_ENABLE
+    // find it using the simd kernels
+    return tb_libc_string_simd_strnstr(s1, n1, s2, tb_false);
+#else
     // init
     __tb_register__ tb_char_t const*    s = s1;
     __tb_register__ tb_char_t const*    p = s2;
@@ -60,5 +67,6 @@ tb_char_t* tb_strnstr(tb_char_t const* s1, tb_size_t n1, tb_char_t const* s2)
 
     // no found
     return tb_null;
+#endif
 }
 
@@ -34,11 +34,78 @@
 #include "large_allocator.h"
 #include "default_allocator.h"
 #include "impl/prefix.h"
+#include "../platform/spinlock.h"
+#include "../platform/thread_local.h"
+#include "../platform/native_memory.h"
+#include "../container/list_entry.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the thread cache?
+ *
+ * we do not use it for the debug mode to keep the exact leak and overflow checking of the fixed pools
+ */
+#if !defined(__tb_debug__) && defined(__tb_thread_local__)
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ENABLE        (1)
+#else
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ENABLE        (0)
+#endif
+
+// the item maximum count of the magazine
+#define TB_DEFAULT_ALLOCATOR_MAGAZINE_ITEM_MAXN     (64)
+
+// the item minimum count of the magazine
+#define TB_DEFAULT_ALLOCATOR_MAGAZINE_ITEM_MINN     (8)
+
+// the space maximum of the magazine
+#define TB_DEFAULT_ALLOCATOR_MAGAZINE_SPACE_MAXN    (32 * 1024)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+// the magazine type of the thread cache for one size class
+typedef struct __tb_default_allocator_magazine_t
+{
+    // the item count
+    tb_size_t               count;
+
+    // the item maximum count
+    tb_size_t               maxn;
+
+    // the items
+    tb_pointer_t            items[TB_DEFAULT_ALLOCATOR_MAGAZINE_ITEM_MAXN];
+
+}tb_default_allocator_magazine_t;
+
+/* the thread cache type
+ *
+ * every thread has one magazine for each size class of the small allocator,
+ * so the common malloc and free are only to pop and push the magazine without any lock.
+ *
+ * we refill half of the magazine from the shared fixed pool if it's empty,
+ * and drain half of it to the shared fixed pool if it's full, only entering the lock once for each batch.
+ *
+ * the data freed from the other thread is pushed to the magazine of the current thread directly,
+ * because the data has no owner thread, and it will be returned to the shared fixed pool when this magazine is drained.
+ */
+typedef struct __tb_default_allocator_cache_t
+{
+    // the list entry
+    tb_list_entry_t                         entry;
+
+    // the allocator, it will be null after the allocator has been exited
+    struct __tb_default_allocator_t*        allocator;
+
+    // the magazines
+    tb_default_allocator_magazine_t         magazines[TB_SMALL_ALLOCATOR_CLASS_MAXN];
+
+}tb_default_allocator_cache_t, *tb_default_allocator_cache_ref_t;
+#endif
+
 // the default allocator type
 typedef struct __tb_default_allocator_t
 {
@@ -51,11 +118,221 @@ typedef struct __tb_default_allocator_t
     // the small allocator
     tb_allocator_ref_t      small_allocator;
 
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // enable the thread caches? only for the global default allocator
+    tb_bool_t               cache_enabled;
+
+    // the thread caches
+    tb_list_entry_head_t    caches;
+#endif
+
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+// the thread cache of the current thread
+static __tb_thread_local__ tb_default_allocator_cache_ref_t g_cache_self = tb_null;
+
+// the thread cache has been exited for the current thread?
+static __tb_thread_local__ tb_bool_t                        g_cache_exited = tb_false;
+
+// the thread local for freeing the thread cache after the thread was returned
+static tb_thread_local_t                                    g_cache_local = TB_THREAD_LOCAL_INIT;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+static tb_void_t tb_default_allocator_cache_drain(tb_default_allocator_ref_t allocator, tb_default_allocator_magazine_t* magazine, tb_size_t count)
+{
+    // check
+    tb_assert(allocator && magazine && count <= magazine->count);
+
+    // free the oldest items to the shared fixed pool, the recent items may be still hot in the cpu cache
+    tb_small_allocator_free_list(allocator->small_allocator, magazine->items, count);
+
+    // move the left items
+    magazine->count -= count;
+    if (magazine->count) tb_memmov_(magazine->items, magazine->items + count, magazine->count * sizeof(tb_pointer_t));
+}
+static tb_void_t tb_default_allocator_cache_exit(tb_default_allocator_cache_ref_t cache)
+{
+    // check
+    tb_assert_and_check_return(cache);
+
+    // the allocator has not been exited?
+    tb_default_allocator_ref_t allocator = cache->allocator;
+    if (allocator)
+    {
+        // drain all magazines
+        tb_size_t i = 0;
+        for (i = 0; i < TB_SMALL_ALLOCATOR_CLASS_MAXN; i++)
+        {
+            tb_default_allocator_magazine_t* magazine = &cache->magazines[i];
+            if (magazine->count) tb_default_allocator_cache_drain(allocator, magazine, magazine->count);
+        }
+
+        // remove this cache from the allocator
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_list_entry_remove(&allocator->caches, &cache->entry);
+        tb_spinlock_leave(&allocator->base.lock);
+    }
+
+    // exit it
+    tb_native_memory_free(cache);
+}
+static tb_void_t tb_default_allocator_cache_free(tb_cpointer_t priv)
+{
+    // check
+    tb_default_allocator_cache_ref_t cache = (tb_default_allocator_cache_ref_t)priv;
+    tb_check_return(cache);
+
+    // the current thread will not use the thread cache again
+    if (cache == g_cache_self)
+    {
+        g_cache_self    = tb_null;
+        g_cache_exited  = tb_true;
+    }
+
+    // exit it
+    tb_default_allocator_cache_exit(cache);
+}
+static tb_default_allocator_cache_ref_t tb_default_allocator_cache_init(tb_default_allocator_ref_t allocator)
+{
+    // check
+    tb_assert(allocator);
+
+    // the thread cache has been exited for the current thread or it is not enabled for this allocator?
+    tb_check_return_val(!g_cache_exited && allocator->cache_enabled, tb_null);
+
+    /* tbox must be running normally
+     *
+     * because this allocator may be called before tb_init() and the thread local environment is not ready now
+     */
+    tb_check_return_val(tb_pool_is_running(), tb_null);
+
+    // init the thread local, only once
+    if (!tb_thread_local_init(&g_cache_local, tb_default_allocator_cache_free)) return tb_null;
+
+    // done
+    tb_bool_t                           ok = tb_false;
+    tb_default_allocator_cache_ref_t    cache = tb_null;
+    do
+    {
+        // make cache
+        cache = (tb_default_allocator_cache_ref_t)tb_native_memory_malloc0(sizeof(tb_default_allocator_cache_t));
+        tb_assert_and_check_break(cache);
+
+        // init magazines, we cache less items for the larger size class
+        tb_size_t i = 0;
+        for (i = 0; i < TB_SMALL_ALLOCATOR_CLASS_MAXN; i++)
+        {
+            tb_size_t maxn = TB_DEFAULT_ALLOCATOR_MAGAZINE_SPACE_MAXN / tb_small_allocator_class_space(i);
+            cache->magazines[i].maxn = tb_max(tb_min(maxn, TB_DEFAULT_ALLOCATOR_MAGAZINE_ITEM_MAXN), TB_DEFAULT_ALLOCATOR_MAGAZINE_ITEM_MINN);
+        }
+
+        // save this cache to the allocator
+        cache->allocator = allocator;
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_list_entry_insert_tail(&allocator->caches, &cache->entry);
+        tb_spinlock_leave(&allocator->base.lock);
+
+        // save this cache to the current thread
+        if (!tb_thread_local_set(&g_cache_local, cache)) break;
+        g_cache_self = cache;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (cache) tb_default_allocator_cache_exit(cache);
+        cache = tb_null;
+
+        // do not try it again
+        g_cache_exited = tb_true;
+    }
+
+    // ok?
+    return cache;
+}
+static __tb_inline__ tb_default_allocator_cache_ref_t tb_default_allocator_cache(tb_default_allocator_ref_t allocator)
+{
+    // get the thread cache of the current thread
+    tb_default_allocator_cache_ref_t cache = g_cache_self;
+
+    // only use the cache of this allocator, we may have multiple default allocators
+    if (cache) return cache->allocator == allocator? cache : tb_null;
+
+    // init it
+    return tb_default_allocator_cache_init(allocator);
+}
+#endif
+static tb_pointer_t tb_default_allocator_small_malloc(tb_default_allocator_ref_t allocator, tb_size_t size __tb_debug_decl__)
+{
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // get the thread cache
+    tb_default_allocator_cache_ref_t cache = tb_default_allocator_cache(allocator);
+    if (cache)
+    {
+        // the magazine
+        tb_size_t                           index = tb_small_allocator_class(size, tb_null);
+        tb_default_allocator_magazine_t*    magazine = &cache->magazines[index];
+
+        // empty? refill half of it from the shared fixed pool
+        if (!magazine->count) magazine->count = tb_small_allocator_malloc_list_(allocator->small_allocator, index, magazine->items, magazine->maxn >> 1 __tb_debug_args__);
+
+        // pop it from the magazine
+        if (magazine->count)
+        {
+            // get data
+            tb_pointer_t data = magazine->items[--magazine->count];
+            tb_assert(data);
+
+            // update size
+            ((tb_pool_data_head_t*)data)[-1].size = size;
+
+            // ok
+            return data;
+        }
+    }
+#endif
+
+    // malloc it from the small allocator directly
+    return tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
+}
+static tb_bool_t tb_default_allocator_small_free(tb_default_allocator_ref_t allocator, tb_pointer_t data __tb_debug_decl__)
+{
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // get the thread cache
+    tb_default_allocator_cache_ref_t cache = tb_default_allocator_cache(allocator);
+    if (cache)
+    {
+        // the magazine
+        tb_default_allocator_magazine_t* magazine = &cache->magazines[tb_small_allocator_class(((tb_pool_data_head_t*)data)[-1].size, tb_null)];
+
+        // full? drain half of it to the shared fixed pool
+        if (magazine->count >= magazine->maxn) tb_default_allocator_cache_drain(allocator, magazine, magazine->maxn >> 1);
+
+        // push it to the magazine
+        magazine->items[magazine->count++] = data;
+
+        // ok
+        return tb_true;
+    }
+#endif
+
+    // free it to the small allocator directly
+    return tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
+}
 static tb_void_t tb_default_allocator_exit(tb_allocator_ref_t self)
 {
     // check
@@ -65,6 +342,20 @@ static tb_void_t tb_default_allocator_exit(tb_allocator_ref_t self)
     // enter
     tb_spinlock_enter(&allocator->base.lock);
 
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    /* detach all thread caches
+     *
+     * their data will be freed with the fixed pools,
+     * and they will be freed after their threads were returned
+     */
+    while (tb_list_entry_size(&allocator->caches))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&allocator->caches);
+        tb_list_entry_remove_head(&allocator->caches);
+        ((tb_default_allocator_cache_ref_t)tb_list_entry(&allocator->caches, entry))->allocator = tb_null;
+    }
+#endif
+
     // exit small allocator
     if (allocator->small_allocator) tb_allocator_exit(allocator->small_allocator);
     allocator->small_allocator = tb_null;
@@ -88,7 +379,7 @@ static tb_pointer_t tb_default_allocator_malloc(tb_allocator_ref_t self, tb_size
     tb_assert_and_check_return_val(allocator->large_allocator && allocator->small_allocator && size, tb_null);
 
     // done
-    return size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+    return size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_default_allocator_small_malloc(allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
 }
 static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
 {
@@ -107,7 +398,7 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
         if (!data)
         {
             // malloc it directly
-            data_new = size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+            data_new = size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_default_allocator_small_malloc(allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
             break;
         }
 
@@ -118,7 +409,29 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
 
         // small => small
         if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
+        {
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+            // same size class? only update size
+            if (tb_small_allocator_class(data_head->size, tb_null) == tb_small_allocator_class(size, tb_null))
+            {
+                data_head->size = size;
+                data_new = data;
+                break;
+            }
+
+            // make the new data
+            data_new = tb_default_allocator_small_malloc(allocator, size __tb_debug_args__);
+            tb_assert_and_check_break(data_new);
+
+            // copy the old data
+            tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+
+            // free the old data
+            tb_default_allocator_small_free(allocator, data __tb_debug_args__);
+#else
             data_new = tb_allocator_ralloc_(allocator->small_allocator, data, size __tb_debug_args__);
+#endif
+        }
         // small => large
         else if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
         {
@@ -130,13 +443,13 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
             tb_memcpy_(data_new, data, tb_min(data_head->size, size));
 
             // free the old data
-            tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
+            tb_default_allocator_small_free(allocator, data __tb_debug_args__);
         }
         // large => small
         else if (size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
         {
             // make the new data
-            data_new = tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
+            data_new = tb_default_allocator_small_malloc(allocator, size __tb_debug_args__);
             tb_assert_and_check_break(data_new);
 
             // copy the old data
@@ -171,7 +484,7 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
 
         // free it
-        ok = (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)? tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__) : tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+        ok = (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)? tb_default_allocator_small_free(allocator, data __tb_debug_args__) : tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
 
     } while (0);
 
@@ -237,6 +550,11 @@ static tb_handle_t tb_default_allocator_instance_init(tb_cpointer_t* ppriv)
         allocator = tb_default_allocator_init(large_allocator);
         tb_assert_and_check_break(allocator);
 
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // enable the thread caches for the global default allocator
+        ((tb_default_allocator_ref_t)allocator)->cache_enabled = tb_true;
+#endif
+
         // ok
         ok = tb_true;
 
@@ -317,7 +635,6 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_TYPE_DEFAULT;
-        allocator->base.flag            = TB_ALLOCATOR_FLAG_NONE;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
@@ -327,9 +644,19 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->base.have            = tb_default_allocator_have;
 #endif
 
+        /* we need not lock the whole allocator, because the small and large allocators have their own locks,
+         * and this lock is only used to maintain the thread caches.
+         */
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
+
         // init lock
         if (!tb_spinlock_init(&allocator->base.lock)) break;
 
+#if TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // init the thread caches
+        tb_list_entry_init(&allocator->caches, tb_default_allocator_cache_t, entry, tb_null);
+#endif
+
         // init allocator
         allocator->large_allocator = large_allocator;
         allocator->small_allocator = tb_small_allocator_init(large_allocator);
@@ -39,6 +39,9 @@ __tb_extern_c_enter__
  */
 
 /*! the global default allocator
+ *
+ * the small data (<=3KB) will be cached in the thread local magazines for each size class in the release mode,
+ * so the common malloc and free need not enter any lock.
  *
  * @param data              the buffer data, uses the native buffer if be null
  * @param size              the buffer size
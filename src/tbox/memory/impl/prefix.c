@@ -27,6 +27,10 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+tb_bool_t tb_pool_is_running()
+{
+    return tb_state() == TB_STATE_OK;
+}
 #ifdef __tb_debug__
 __tb_no_sanitize_address__ tb_size_t tb_pool_data_size(tb_cpointer_t data)
 {
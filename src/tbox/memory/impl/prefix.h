@@ -122,6 +122,12 @@ typedef struct __tb_pool_data_empty_head_t
  * interfaces
  */
 
+/* is tbox running normally? the allocators may be called before tb_init() or after tb_exit()
+ *
+ * @return                      tb_true or tb_false
+ */
+tb_bool_t                       tb_pool_is_running(tb_noarg_t);
+
 #ifdef __tb_debug__
 
 /* the data size
@@ -0,0 +1,598 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        iobuf.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "iobuf"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "iobuf.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the slices grow size
+#define TB_IOBUF_SLICES_GROW            (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the iobuf block type
+typedef struct __tb_iobuf_block_t
+{
+    // the reference count
+    tb_size_t               refn;
+
+    // the used size, the data after it is free and only can be pushed by the slice ending at it
+    tb_size_t               size;
+
+    // the data maxn
+    tb_size_t               maxn;
+
+    // the padding for aligning the block data
+    tb_size_t               padding;
+
+}tb_iobuf_block_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t* tb_iobuf_block_data(tb_iobuf_block_ref_t block)
+{
+    return (tb_byte_t*)((tb_iobuf_block_t*)block + 1);
+}
+static tb_iobuf_block_ref_t tb_iobuf_block_init(tb_size_t maxn)
+{
+    // make block
+    tb_iobuf_block_t* block = (tb_iobuf_block_t*)tb_malloc(sizeof(tb_iobuf_block_t) + maxn);
+    tb_assert_and_check_return_val(block, tb_null);
+
+    // init block
+    block->refn = 1;
+    block->size = 0;
+    block->maxn = maxn;
+
+    // ok
+    return (tb_iobuf_block_ref_t)block;
+}
+static __tb_inline__ tb_void_t tb_iobuf_block_retain(tb_iobuf_block_ref_t block)
+{
+    ((tb_iobuf_block_t*)block)->refn++;
+}
+static __tb_inline__ tb_void_t tb_iobuf_block_release(tb_iobuf_block_ref_t self)
+{
+    // check
+    tb_iobuf_block_t* block = (tb_iobuf_block_t*)self;
+    tb_assert_and_check_return(block && block->refn);
+
+    // free it if it's the last reference
+    if (!--block->refn) tb_free(block);
+}
+static __tb_inline__ tb_size_t tb_iobuf_slice_space(tb_iobuf_slice_t const* slice)
+{
+    // only the slice ending at the used data of the block can push data to it
+    tb_iobuf_block_t* block = (tb_iobuf_block_t*)slice->block;
+    return (slice->data + slice->size == tb_iobuf_block_data(slice->block) + block->size)? block->maxn - block->size : 0;
+}
+static tb_bool_t tb_iobuf_slices_grow(tb_iobuf_t* iobuf, tb_size_t front, tb_size_t back)
+{
+    // enough?
+    tb_check_return_val(iobuf->head < front || iobuf->head + iobuf->count + back > iobuf->maxn, tb_true);
+
+    // grow slices
+    tb_size_t need = front + iobuf->count + back;
+    if (need > iobuf->maxn)
+    {
+        tb_size_t           maxn = tb_max(need + TB_IOBUF_SLICES_GROW, iobuf->maxn << 1);
+        tb_iobuf_slice_t*   slices = tb_ralloc_type(iobuf->slices, maxn, tb_iobuf_slice_t);
+        tb_assert_and_check_return_val(slices, tb_false);
+
+        // update slices
+        iobuf->slices   = slices;
+        iobuf->maxn     = maxn;
+    }
+
+    // move the slice refs, the data will not be moved
+    if (iobuf->count && iobuf->head != front) tb_memmov(iobuf->slices + front, iobuf->slices + iobuf->head, iobuf->count * sizeof(tb_iobuf_slice_t));
+    iobuf->head = front;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_iobuf_slices_push(tb_iobuf_t* iobuf, tb_iobuf_block_ref_t block, tb_byte_t* data, tb_size_t size)
+{
+    // grow slices
+    if (!tb_iobuf_slices_grow(iobuf, 0, 1)) return tb_false;
+
+    // push it to the tail
+    tb_iobuf_slice_t* slice = iobuf->slices + iobuf->head + iobuf->count++;
+    slice->block    = block;
+    slice->data     = data;
+    slice->size     = size;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_iobuf_slices_trim(tb_iobuf_t* iobuf)
+{
+    // release the empty slices at the tail
+    while (iobuf->count && !iobuf->slices[iobuf->head + iobuf->count - 1].size)
+        tb_iobuf_block_release(iobuf->slices[iobuf->head + --iobuf->count].block);
+
+    // reset head
+    if (!iobuf->count) iobuf->head = 0;
+}
+static tb_iobuf_slice_t* tb_iobuf_slices_last(tb_iobuf_t* iobuf)
+{
+    return iobuf->count? iobuf->slices + iobuf->head + iobuf->count - 1 : tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_iobuf_init(tb_iobuf_ref_t iobuf, tb_size_t block)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, tb_false);
+
+    // init
+    tb_memset(iobuf, 0, sizeof(tb_iobuf_t));
+    iobuf->block_size = block? block : TB_IOBUF_BLOCK_SIZE;
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_iobuf_exit(tb_iobuf_ref_t iobuf)
+{
+    if (iobuf)
+    {
+        // clear it
+        tb_iobuf_clear(iobuf);
+
+        // exit slices
+        if (iobuf->slices) tb_free(iobuf->slices);
+        tb_memset(iobuf, 0, sizeof(tb_iobuf_t));
+    }
+}
+tb_void_t tb_iobuf_clear(tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_assert_and_check_return(iobuf);
+
+    // release all blocks
+    tb_size_t i = 0;
+    for (i = 0; i < iobuf->count; i++)
+        tb_iobuf_block_release(iobuf->slices[iobuf->head + i].block);
+
+    // clear it
+    iobuf->head     = 0;
+    iobuf->count    = 0;
+    iobuf->size     = 0;
+}
+tb_size_t tb_iobuf_size(tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, 0);
+
+    // the size
+    return iobuf->size;
+}
+tb_size_t tb_iobuf_slices(tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, 0);
+
+    // the slice count
+    return iobuf->count;
+}
+tb_bool_t tb_iobuf_null(tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, tb_true);
+
+    // is null?
+    return iobuf->size? tb_false : tb_true;
+}
+tb_long_t tb_iobuf_read(tb_iobuf_ref_t iobuf, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && data, -1);
+
+    // copy the head slices
+    tb_size_t read = 0;
+    tb_size_t i = 0;
+    for (i = 0; i < iobuf->count && read < size; i++)
+    {
+        tb_iobuf_slice_t const* slice = iobuf->slices + iobuf->head + i;
+        tb_size_t               copy = tb_min(slice->size, size - read);
+        if (copy) tb_memcpy(data + read, slice->data, copy);
+        read += copy;
+    }
+
+    // skip them
+    return tb_iobuf_skip(iobuf, read);
+}
+tb_long_t tb_iobuf_writ(tb_iobuf_ref_t iobuf, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && data, -1);
+
+    // copy data to the free space of the tail blocks
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        // enter the tail block
+        tb_size_t  push = 0;
+        tb_byte_t* tail = tb_iobuf_push_init(iobuf, &push);
+        tb_check_break(tail && push);
+
+        // copy data
+        push = tb_min(push, size - writ);
+        tb_memcpy(tail, data + writ, push);
+        writ += push;
+
+        // leave the tail block
+        tb_iobuf_push_exit(iobuf, push);
+    }
+
+    // ok?
+    return writ? (tb_long_t)writ : (size? -1 : 0);
+}
+tb_long_t tb_iobuf_skip(tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, -1);
+
+    // skip the head slices
+    tb_size_t skip = 0;
+    while (skip < size && iobuf->size)
+    {
+        // the head slice
+        tb_iobuf_slice_t* slice = iobuf->slices + iobuf->head;
+        tb_size_t         left = size - skip;
+
+        // skip the part of it?
+        if (slice->size > left)
+        {
+            slice->data += left;
+            slice->size -= left;
+            iobuf->size -= left;
+            skip += left;
+            break;
+        }
+
+        // skip the whole slice
+        skip += slice->size;
+        iobuf->size -= slice->size;
+
+        // the last slice and it's block is not shared? reuse it instead of freeing it
+        tb_iobuf_block_t* block = (tb_iobuf_block_t*)slice->block;
+        if (iobuf->count == 1 && block->refn == 1)
+        {
+            block->size = 0;
+            slice->data = tb_iobuf_block_data(slice->block);
+            slice->size = 0;
+            break;
+        }
+
+        // remove it
+        tb_iobuf_block_release(slice->block);
+        iobuf->head++;
+        iobuf->count--;
+    }
+
+    // reset head
+    if (!iobuf->count) iobuf->head = 0;
+
+    // ok
+    return (tb_long_t)skip;
+}
+tb_bool_t tb_iobuf_append(tb_iobuf_ref_t iobuf, tb_iobuf_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && other && iobuf != other, tb_false);
+
+    // remove the empty slices
+    tb_iobuf_slices_trim(iobuf);
+    tb_iobuf_slices_trim(other);
+    tb_check_return_val(other->count, tb_true);
+
+    // grow slices
+    if (!tb_iobuf_slices_grow(iobuf, 0, other->count)) return tb_false;
+
+    // move the slices of the other iobuf
+    tb_memcpy(iobuf->slices + iobuf->head + iobuf->count, other->slices + other->head, other->count * sizeof(tb_iobuf_slice_t));
+    iobuf->count += other->count;
+    iobuf->size += other->size;
+
+    // clear the other iobuf
+    other->head     = 0;
+    other->count    = 0;
+    other->size     = 0;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_iobuf_prepend(tb_iobuf_ref_t iobuf, tb_iobuf_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && other && iobuf != other, tb_false);
+
+    // remove the empty slices
+    tb_iobuf_slices_trim(iobuf);
+    tb_iobuf_slices_trim(other);
+    tb_check_return_val(other->count, tb_true);
+
+    // grow slices
+    if (!tb_iobuf_slices_grow(iobuf, other->count, 0)) return tb_false;
+
+    // move the slices of the other iobuf
+    iobuf->head -= other->count;
+    tb_memcpy(iobuf->slices + iobuf->head, other->slices + other->head, other->count * sizeof(tb_iobuf_slice_t));
+    iobuf->count += other->count;
+    iobuf->size += other->size;
+
+    // clear the other iobuf
+    other->head     = 0;
+    other->count    = 0;
+    other->size     = 0;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_iobuf_split(tb_iobuf_ref_t iobuf, tb_size_t size, tb_iobuf_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && other && iobuf != other, tb_false);
+    tb_check_return_val(size <= iobuf->size, tb_false);
+
+    // remove the empty slices of the other iobuf
+    tb_iobuf_slices_trim(other);
+
+    // move the head slices
+    while (size)
+    {
+        // the head slice
+        tb_iobuf_slice_t* slice = iobuf->slices + iobuf->head;
+
+        // split it? share the block
+        if (slice->size > size)
+        {
+            if (!tb_iobuf_slices_push(other, slice->block, slice->data, size)) return tb_false;
+            tb_iobuf_block_retain(slice->block);
+            slice->data += size;
+            slice->size -= size;
+            iobuf->size -= size;
+            other->size += size;
+            break;
+        }
+
+        // move the whole slice
+        if (!tb_iobuf_slices_push(other, slice->block, slice->data, slice->size)) return tb_false;
+        size -= slice->size;
+        iobuf->size -= slice->size;
+        other->size += slice->size;
+        iobuf->head++;
+        iobuf->count--;
+    }
+
+    // reset head
+    if (!iobuf->count) iobuf->head = 0;
+
+    // ok
+    return tb_true;
+}
+tb_byte_t* tb_iobuf_coalesce(tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, tb_null);
+    tb_check_return_val(size && size <= iobuf->size, tb_null);
+
+    // the head slice is enough?
+    tb_iobuf_slice_t* slice = iobuf->slices + iobuf->head;
+    if (slice->size >= size) return slice->data;
+
+    // make a new block for the head data
+    tb_iobuf_block_ref_t block = tb_iobuf_block_init(tb_max(size, iobuf->block_size));
+    tb_assert_and_check_return_val(block, tb_null);
+
+    // copy the head data to it
+    tb_byte_t*  data = tb_iobuf_block_data(block);
+    tb_size_t   copy = 0;
+    while (copy < size)
+    {
+        // copy the head slice
+        slice = iobuf->slices + iobuf->head;
+        tb_size_t need = tb_min(slice->size, size - copy);
+        tb_memcpy(data + copy, slice->data, need);
+        copy += need;
+
+        // copy the part of it?
+        if (need < slice->size)
+        {
+            slice->data += need;
+            slice->size -= need;
+            break;
+        }
+
+        // remove it
+        tb_iobuf_block_release(slice->block);
+        iobuf->head++;
+        iobuf->count--;
+    }
+
+    // insert the new block to the head, there is free slice ref before it now
+    ((tb_iobuf_block_t*)block)->size = size;
+    iobuf->head--;
+    iobuf->count++;
+    slice = iobuf->slices + iobuf->head;
+    slice->block    = block;
+    slice->data     = data;
+    slice->size     = size;
+
+    // ok
+    return data;
+}
+tb_byte_t* tb_iobuf_pull_init(tb_iobuf_ref_t iobuf, tb_size_t* size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, tb_null);
+
+    // null?
+    tb_check_return_val(iobuf->size, tb_null);
+
+    // the head slice
+    tb_iobuf_slice_t* slice = iobuf->slices + iobuf->head;
+    if (size) *size = slice->size;
+    return slice->data;
+}
+tb_void_t tb_iobuf_pull_exit(tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // skip the pulled data
+    tb_long_t skip = tb_iobuf_skip(iobuf, size);
+    tb_assert(skip == (tb_long_t)size); tb_used(skip);
+}
+tb_byte_t* tb_iobuf_push_init(tb_iobuf_ref_t iobuf, tb_size_t* size)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf, tb_null);
+
+    // the tail slice has free space?
+    tb_iobuf_slice_t* slice = tb_iobuf_slices_last(iobuf);
+    tb_size_t         space = slice? tb_iobuf_slice_space(slice) : 0;
+    if (!space)
+    {
+        // make a new block
+        tb_iobuf_block_ref_t block = tb_iobuf_block_init(iobuf->block_size);
+        tb_assert_and_check_return_val(block, tb_null);
+
+        // push an empty slice for it
+        if (!tb_iobuf_slices_push(iobuf, block, tb_iobuf_block_data(block), 0))
+        {
+            tb_iobuf_block_release(block);
+            return tb_null;
+        }
+
+        // the tail slice
+        slice = tb_iobuf_slices_last(iobuf);
+        space = iobuf->block_size;
+    }
+
+    // the free data
+    if (size) *size = space;
+    return slice->data + slice->size;
+}
+tb_void_t tb_iobuf_push_exit(tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(iobuf);
+
+    // find the first slice for pushing, the empty slices at the tail are reserved for it
+    tb_size_t tail = iobuf->head + iobuf->count;
+    tb_size_t push = tail;
+    while (push > iobuf->head && !iobuf->slices[push - 1].size) push--;
+    if (push > iobuf->head && push < tail && tb_iobuf_slice_space(iobuf->slices + push - 1)) push--;
+    else if (push == tail && push > iobuf->head) push--;
+
+    // commit the pushed data
+    for (; push < tail && size; push++)
+    {
+        tb_iobuf_slice_t* slice = iobuf->slices + push;
+        tb_size_t         need = tb_min(size, tb_iobuf_slice_space(slice));
+        slice->size += need;
+        ((tb_iobuf_block_t*)slice->block)->size += need;
+        iobuf->size += need;
+        size -= need;
+    }
+    tb_assert(!size);
+
+    // release the unused blocks, but keep the last block for reusing it if the iobuf is null
+    if (iobuf->size) tb_iobuf_slices_trim(iobuf);
+    else while (iobuf->count > 1) tb_iobuf_block_release(iobuf->slices[iobuf->head + --iobuf->count].block);
+}
+tb_size_t tb_iobuf_pull_iovec(tb_iobuf_ref_t iobuf, tb_iovec_t* list, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && list, 0);
+
+    // the head slices
+    tb_size_t i = 0;
+    for (i = 0; i < iobuf->count && i < maxn; i++)
+    {
+        tb_iobuf_slice_t const* slice = iobuf->slices + iobuf->head + i;
+        tb_check_break(slice->size);
+        list[i].data = slice->data;
+        list[i].size = (tb_iovec_size_t)slice->size;
+    }
+
+    // ok
+    return i;
+}
+tb_size_t tb_iobuf_push_iovec(tb_iobuf_ref_t iobuf, tb_iovec_t* list, tb_size_t maxn, tb_size_t need)
+{
+    // check
+    tb_assert_and_check_return_val(iobuf && list && maxn, 0);
+
+    // the free space of the tail slice
+    tb_size_t n = 0;
+    tb_size_t space = 0;
+    tb_iobuf_slice_t* slice = tb_iobuf_slices_last(iobuf);
+    if (slice && (space = tb_iobuf_slice_space(slice)))
+    {
+        list[n].data = slice->data + slice->size;
+        list[n].size = (tb_iovec_size_t)space;
+        n++;
+    }
+
+    // reserve the free blocks
+    while (space < need && n < maxn)
+    {
+        // make a new block
+        tb_iobuf_block_ref_t block = tb_iobuf_block_init(iobuf->block_size);
+        tb_assert_and_check_break(block);
+
+        // push an empty slice for it
+        tb_byte_t* data = tb_iobuf_block_data(block);
+        if (!tb_iobuf_slices_push(iobuf, block, data, 0))
+        {
+            tb_iobuf_block_release(block);
+            break;
+        }
+
+        // save it
+        list[n].data = data;
+        list[n].size = (tb_iovec_size_t)iobuf->block_size;
+        space += iobuf->block_size;
+        n++;
+    }
+
+    // ok
+    return n;
+}
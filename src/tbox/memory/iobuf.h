@@ -0,0 +1,299 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        iobuf.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_IOBUF_H
+#define TB_MEMORY_IOBUF_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../platform/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default block size
+#ifdef __tb_small__
+#   define TB_IOBUF_BLOCK_SIZE          (4096)
+#else
+#   define TB_IOBUF_BLOCK_SIZE          (8192)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the iobuf block ref type, the reference counted data block
+typedef __tb_typeref__(iobuf_block);
+
+/// the iobuf slice type
+typedef struct __tb_iobuf_slice_t
+{
+    /// the block
+    tb_iobuf_block_ref_t    block;
+
+    /// the slice data in the block
+    tb_byte_t*              data;
+
+    /// the slice size
+    tb_size_t               size;
+
+}tb_iobuf_slice_t;
+
+/*! the chained io buffer type
+ *
+ * the data is stored in a chain of slices which reference the shared data blocks,
+ * so the data can be appended, prepended and splitted without copying and moving it.
+ *
+ * <pre>
+ *
+ * slices:      [slice0]          [slice1]     [slice2]
+ *                 |                 |            |
+ * blocks:  |.....data....|    |..data..|    |..data..|...free...|
+ *                                                    |
+ *                                                   push
+ * </pre>
+ */
+typedef struct __tb_iobuf_t
+{
+    /// the slices
+    tb_iobuf_slice_t*       slices;
+
+    /// the head slice index
+    tb_size_t               head;
+
+    /// the slice count
+    tb_size_t               count;
+
+    /// the slice maxn
+    tb_size_t               maxn;
+
+    /// the data size
+    tb_size_t               size;
+
+    /// the block size
+    tb_size_t               block_size;
+
+}tb_iobuf_t, *tb_iobuf_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init iobuf
+ *
+ * @param iobuf     the iobuf
+ * @param block     the block size, uses the default size if be zero
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_iobuf_init(tb_iobuf_ref_t iobuf, tb_size_t block);
+
+/*! exit iobuf
+ *
+ * @param iobuf     the iobuf
+ */
+tb_void_t           tb_iobuf_exit(tb_iobuf_ref_t iobuf);
+
+/*! clear iobuf
+ *
+ * @param iobuf     the iobuf
+ */
+tb_void_t           tb_iobuf_clear(tb_iobuf_ref_t iobuf);
+
+/*! the data size
+ *
+ * @param iobuf     the iobuf
+ *
+ * @return          the data size
+ */
+tb_size_t           tb_iobuf_size(tb_iobuf_ref_t iobuf);
+
+/*! the slice count
+ *
+ * @param iobuf     the iobuf
+ *
+ * @return          the slice count
+ */
+tb_size_t           tb_iobuf_slices(tb_iobuf_ref_t iobuf);
+
+/*! is null?
+ *
+ * @param iobuf     the iobuf
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_iobuf_null(tb_iobuf_ref_t iobuf);
+
+/*! read data and remove it from the head
+ *
+ * @param iobuf     the iobuf
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the real size
+ */
+tb_long_t           tb_iobuf_read(tb_iobuf_ref_t iobuf, tb_byte_t* data, tb_size_t size);
+
+/*! copy data to the tail
+ *
+ * @param iobuf     the iobuf
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the real size, failed: -1
+ */
+tb_long_t           tb_iobuf_writ(tb_iobuf_ref_t iobuf, tb_byte_t const* data, tb_size_t size);
+
+/*! skip data from the head
+ *
+ * @param iobuf     the iobuf
+ * @param size      the size
+ *
+ * @return          the real size
+ */
+tb_long_t           tb_iobuf_skip(tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! move all data of the other iobuf to the tail without copying it
+ *
+ * @param iobuf     the iobuf
+ * @param other     the other iobuf, it will be cleared
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_iobuf_append(tb_iobuf_ref_t iobuf, tb_iobuf_ref_t other);
+
+/*! move all data of the other iobuf to the head without copying it
+ *
+ * @param iobuf     the iobuf
+ * @param other     the other iobuf, it will be cleared
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_iobuf_prepend(tb_iobuf_ref_t iobuf, tb_iobuf_ref_t other);
+
+/*! split the head data and move it to the tail of the other iobuf without copying it
+ *
+ * the block at the split point will be shared by both iobufs.
+ *
+ * @param iobuf     the iobuf
+ * @param size      the head size
+ * @param other     the other iobuf
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_iobuf_split(tb_iobuf_ref_t iobuf, tb_size_t size, tb_iobuf_ref_t other);
+
+/*! coalesce the head data to a contiguous block
+ *
+ * only the head slices which contain the given size will be copied,
+ * it does nothing if the head slice is large enough.
+ *
+ * @param iobuf     the iobuf
+ * @param size      the head size
+ *
+ * @return          the contiguous head data, tb_null if there is not enough data
+ */
+tb_byte_t*          tb_iobuf_coalesce(tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! enter iobuf for pulling the head slice
+ *
+ * @param iobuf     the iobuf
+ * @param size      the head slice size
+ *
+ * @return          the head slice data, tb_null if it's null
+ */
+tb_byte_t*          tb_iobuf_pull_init(tb_iobuf_ref_t iobuf, tb_size_t* size);
+
+/*! leave iobuf for pulling the head slice
+ *
+ * @param iobuf     the iobuf
+ * @param size      the pulled size
+ */
+tb_void_t           tb_iobuf_pull_exit(tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! enter iobuf for pushing data to the free space of the tail block
+ *
+ * @param iobuf     the iobuf
+ * @param size      the free size
+ *
+ * @return          the free data, tb_null if no memory
+ */
+tb_byte_t*          tb_iobuf_push_init(tb_iobuf_ref_t iobuf, tb_size_t* size);
+
+/*! leave iobuf for pushing data
+ *
+ * commit the pushed data of tb_iobuf_push_init() or tb_iobuf_push_iovec(),
+ * the unused free blocks will be released.
+ *
+ * @param iobuf     the iobuf
+ * @param size      the pushed size
+ */
+tb_void_t           tb_iobuf_push_exit(tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! get the iovec list of the head slices for writing them, e.g. tb_socket_sendv
+ *
+ * @code
+    tb_iovec_t list[16];
+    tb_size_t  size = tb_iobuf_pull_iovec(iobuf, list, tb_arrayn(list));
+    tb_long_t  real = tb_socket_sendv(sock, list, size);
+    if (real > 0) tb_iobuf_pull_exit(iobuf, real);
+ * @endcode
+ *
+ * @param iobuf     the iobuf
+ * @param list      the iovec list
+ * @param maxn      the iovec list maxn
+ *
+ * @return          the iovec count
+ */
+tb_size_t           tb_iobuf_pull_iovec(tb_iobuf_ref_t iobuf, tb_iovec_t* list, tb_size_t maxn);
+
+/*! get the iovec list of the free tail blocks for reading data into them, e.g. tb_socket_recvv
+ *
+ * @code
+    tb_iovec_t list[4];
+    tb_size_t  size = tb_iobuf_push_iovec(iobuf, list, tb_arrayn(list), 65536);
+    tb_long_t  real = tb_socket_recvv(sock, list, size);
+    tb_iobuf_push_exit(iobuf, real > 0? real : 0);
+ * @endcode
+ *
+ * @param iobuf     the iobuf
+ * @param list      the iovec list
+ * @param maxn      the iovec list maxn
+ * @param need      the needed free size
+ *
+ * @return          the iovec count, the free blocks will be allocated if not enough
+ */
+tb_size_t           tb_iobuf_push_iovec(tb_iobuf_ref_t iobuf, tb_iovec_t* list, tb_size_t maxn, tb_size_t need);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -30,6 +30,7 @@
 #include "allocator.h"
 #include "fixed_pool.h"
 #include "string_pool.h"
+#include "iobuf.h"
 #include "queue_buffer.h"
 #include "static_buffer.h"
 #include "large_allocator.h"
@@ -48,7 +48,7 @@ typedef struct __tb_small_allocator_t
     tb_allocator_ref_t      large_allocator;
 
     // the fixed pool
-    tb_fixed_pool_ref_t     fixed_pool[12];
+    tb_fixed_pool_ref_t     fixed_pool[TB_SMALL_ALLOCATOR_CLASS_MAXN];
 
 }tb_small_allocator_t, *tb_small_allocator_ref_t;
 
@@ -57,6 +57,26 @@ typedef struct __tb_small_allocator_t
  */
 __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large_allocator, tb_size_t slot_size, tb_size_t item_size, tb_bool_t for_small_allocator, tb_fixed_pool_item_init_func_t item_init, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the class index of the data size for [1, 512], indexed by (size - 1) >> 4
+ *
+ * 1-16B: 0, 17-32B: 1, 33-64B: 2, 65-96B: 3, 97-128B: 4, 129-192B: 5, 193-256B: 6, 257-384B: 7, 385-512B: 8
+ */
+static tb_uint8_t const g_small_allocator_class_index[32] =
+{
+    0, 1, 2, 2, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6
+,   7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8
+};
+
+// the class space
+static tb_uint16_t const g_small_allocator_class_space[TB_SMALL_ALLOCATOR_CLASS_MAXN] =
+{
+    16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072
+};
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -70,80 +90,8 @@ static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_
     do
     {
         // the fixed pool index
-        tb_size_t index = 0;
         tb_size_t space = 0;
-        if (size > 64 && size < 193)
-        {
-            if (size < 97)
-            {
-                index = 3;
-                space = 96;
-            }
-            else if (size > 128)
-            {
-                index = 5;
-                space = 192;
-            }
-            else
-            {
-                index = 4;
-                space = 128;
-            }
-        }
-        else if (size > 192 && size < 513)
-        {
-            if (size < 257)
-            {
-                index = 6;
-                space = 256;
-            }
-            else if (size > 384)
-            {
-                index = 8;
-                space = 512;
-            }
-            else
-            {
-                index = 7;
-                space = 384;
-            }
-        }
-        else if (size < 65)
-        {
-            if (size < 17)
-            {
-                index = 0;
-                space = 16;
-            }
-            else if (size > 32)
-            {
-                index = 2;
-                space = 64;
-            }
-            else
-            {
-                index = 1;
-                space = 32;
-            }
-        }
-        else
-        {
-            if (size < 1025)
-            {
-                index = 9;
-                space = 1024;
-            }
-            else if (size > 2048)
-            {
-                index = 11;
-                space = 3072;
-            }
-            else
-            {
-                index = 10;
-                space = 2048;
-            }
-        }
+        tb_size_t index = tb_small_allocator_class(size, &space);
 
         // trace
         tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
@@ -467,3 +415,89 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
     return (tb_allocator_ref_t)allocator;
 }
 
+tb_size_t tb_small_allocator_class(tb_size_t size, tb_size_t* space)
+{
+    // check
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+    // get the class index
+    tb_size_t index = size <= 512? g_small_allocator_class_index[(size - 1) >> 4] : (size <= 1024? 9 : (size <= 2048? 10 : 11));
+
+    // save the class space
+    if (space) *space = g_small_allocator_class_space[index];
+
+    // ok
+    return index;
+}
+tb_size_t tb_small_allocator_class_space(tb_size_t index)
+{
+    // check
+    tb_assert_and_check_return_val(index < TB_SMALL_ALLOCATOR_CLASS_MAXN, 0);
+
+    // get it
+    return g_small_allocator_class_space[index];
+}
+tb_size_t tb_small_allocator_malloc_list_(tb_allocator_ref_t self, tb_size_t index, tb_pointer_t* list, tb_size_t count __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->large_allocator && list && count, 0);
+    tb_assert_and_check_return_val(index < TB_SMALL_ALLOCATOR_CLASS_MAXN, 0);
+
+    // the class space
+    tb_size_t space = g_small_allocator_class_space[index];
+
+    // enter
+    tb_bool_t lockit = !(allocator->base.flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->base.lock);
+
+    // done
+    tb_size_t i = 0;
+    tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, space);
+    if (fixed_pool)
+    {
+        for (i = 0; i < count; i++)
+        {
+            // make data
+            tb_pointer_t data = tb_fixed_pool_malloc_(fixed_pool __tb_debug_args__);
+            tb_check_break(data);
+
+            // the data head
+            tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+            tb_assert(data_head->debug.magic == TB_POOL_DATA_MAGIC);
+
+            // use the whole class space
+            data_head->size = space;
+
+            // save it
+            list[i] = data;
+        }
+    }
+
+    // leave
+    if (lockit) tb_spinlock_leave(&allocator->base.lock);
+
+    // ok?
+    return i;
+}
+tb_void_t tb_small_allocator_free_list_(tb_allocator_ref_t self, tb_pointer_t* list, tb_size_t count __tb_debug_decl__)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->large_allocator && list);
+
+    // enter
+    tb_bool_t lockit = !(allocator->base.flag & TB_ALLOCATOR_FLAG_NOLOCK);
+    if (lockit) tb_spinlock_enter(&allocator->base.lock);
+
+    // free all data
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // free it
+        tb_assertf_and_check_continue(tb_small_allocator_free((tb_allocator_ref_t)allocator, list[i] __tb_debug_args__), "free(%p) failed!", list[i]);
+    }
+
+    // leave
+    if (lockit) tb_spinlock_leave(&allocator->base.lock);
+}
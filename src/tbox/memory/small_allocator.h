@@ -39,6 +39,13 @@ __tb_extern_c_enter__
 /// the data size maximum
 #define TB_SMALL_ALLOCATOR_DATA_MAXN        (3072)
 
+/// the size class count
+#define TB_SMALL_ALLOCATOR_CLASS_MAXN       (12)
+
+/// malloc and free the data list of the given size class
+#define tb_small_allocator_malloc_list(allocator, index, list, count)   tb_small_allocator_malloc_list_(allocator, index, list, count __tb_debug_vals__)
+#define tb_small_allocator_free_list(allocator, list, count)            tb_small_allocator_free_list_(allocator, list, count __tb_debug_vals__)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -81,6 +88,47 @@ __tb_extern_c_enter__
  */
 tb_allocator_ref_t          tb_small_allocator_init(tb_allocator_ref_t large_allocator);
 
+/*! get the size class of the given data size
+ *
+ * @param size              the data size, it must be in [1, TB_SMALL_ALLOCATOR_DATA_MAXN]
+ * @param space             the class space, optional
+ *
+ * @return                  the class index, it is in [0, TB_SMALL_ALLOCATOR_CLASS_MAXN)
+ */
+tb_size_t                   tb_small_allocator_class(tb_size_t size, tb_size_t* space);
+
+/*! get the space of the given size class
+ *
+ * @param index             the class index
+ *
+ * @return                  the class space
+ */
+tb_size_t                   tb_small_allocator_class_space(tb_size_t index);
+
+/*! malloc the data list from the given size class
+ *
+ * we only enter the lock once for all data,
+ * and the size of every data will be the whole class space.
+ *
+ * @param allocator         the small allocator
+ * @param index             the class index
+ * @param list              the data list
+ * @param count             the data count
+ *
+ * @return                  the real count
+ */
+tb_size_t                   tb_small_allocator_malloc_list_(tb_allocator_ref_t allocator, tb_size_t index, tb_pointer_t* list, tb_size_t count __tb_debug_decl__);
+
+/*! free the data list
+ *
+ * we only enter the lock once for all data.
+ *
+ * @param allocator         the small allocator
+ * @param list              the data list
+ * @param count             the data count
+ */
+tb_void_t                   tb_small_allocator_free_list_(tb_allocator_ref_t allocator, tb_pointer_t* list, tb_size_t count __tb_debug_decl__);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
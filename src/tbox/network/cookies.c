@@ -40,6 +40,24 @@
 #include "../algorithm/algorithm.h"
 #include "../container/container.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the expires heap grow
+#ifdef __tb_small__
+#   define TB_COOKIES_EXPIRES_GROW          (256)
+#else
+#   define TB_COOKIES_EXPIRES_GROW          (4096)
+#endif
+
+// the maximum removed entries count in the expires heap before compacting it
+#ifdef __tb_small__
+#   define TB_COOKIES_EXPIRES_DEAD_MAXN     (256)
+#else
+#   define TB_COOKIES_EXPIRES_DEAD_MAXN     (4096)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -71,22 +89,38 @@ typedef struct __tb_cookies_entry_t
     // is secure?
     tb_uint32_t             secure  : 1;
 
+    // the reference count, referenced by the domain list and the expires heap
+    tb_uint16_t             refn;
+
+    // has been removed from the domain list? it will be freed lazily by the expires heap
+    tb_uint16_t             removed;
+
 }tb_cookies_entry_t, *tb_cookies_entry_ref_t;
 
 // the cookies type
 typedef struct __tb_cookies_t
 {
-    // the lock
-    tb_spinlock_t           lock;
-
-    // the string element
-    tb_element_t            string_element;
+    // the lock, the readers only match cookies and the writers set or evict them
+    tb_rwspinlock_t         lock;
 
     // the string pool
     tb_string_pool_ref_t    string_pool;
 
-    // the cookie pool, key: "domain+path+name"
-    tb_hash_set_ref_t       cookie_pool;
+    /* the domain pool, key: "domain", value: the entry list of this domain
+     *
+     * the request domain only need to lookup its parent domains, e.g. "a.b.com" => "a.b.com", "b.com",
+     * so we need not walk all cookies
+     */
+    tb_hash_map_ref_t       domain_pool;
+
+    // the expires heap, the min expires time is at the top
+    tb_heap_ref_t           expires_heap;
+
+    // the removed entries count in the expires heap
+    tb_size_t               expires_dead;
+
+    // the cookies count
+    tb_size_t               size;
 
 }tb_cookies_t;
 
@@ -152,30 +186,6 @@ static tb_bool_t tb_cookies_get_domain_and_path_from_url(tb_char_t const* url, t
     // ok?
     return *pdomain? tb_true : tb_false;
 }
-static tb_bool_t tb_cookies_is_child_domain(tb_char_t const* parent, tb_char_t const* child)
-{
-    // check
-    tb_assert_and_check_return_val(parent && child, tb_false);
-
-    // init
-    tb_char_t const*    pb = parent;
-    tb_char_t const*    cb = child;
-    tb_size_t           pn = tb_strlen(pb);
-    tb_size_t           cn = tb_strlen(cb);
-    tb_assert_and_check_return_val(pn && cn, tb_false);
-
-    // is child?
-    tb_size_t           n = 0;
-    tb_char_t const*    pe = pb + pn - 1;
-    tb_char_t const*    ce = cb + cn - 1;
-    for (; pe >= pb && ce >= cb && *pe == *ce; pe--, ce--)
-    {
-        if (*ce == '.') n++;
-    }
-
-    // ok?
-    return (pe < pb && n >= 1 && (ce < cb || *ce == '.'))? tb_true : tb_false;
-}
 static tb_bool_t tb_cookies_is_child_path(tb_char_t const* parent, tb_char_t const* child)
 {
     // check
@@ -214,55 +224,199 @@ static tb_void_t tb_cookies_entry_exit(tb_cookies_t* cookies, tb_cookies_entry_r
     if (entry->value) tb_string_pool_remove(cookies->string_pool, entry->value);
     entry->value = tb_null;
 }
-static tb_void_t tb_cookies_entry_free(tb_element_ref_t element, tb_pointer_t buff)
+static tb_void_t tb_cookies_entry_release(tb_cookies_t* cookies, tb_cookies_entry_ref_t entry)
 {
     // check
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)buff;
-    tb_assert_and_check_return(element && entry);
+    tb_assert_and_check_return(cookies && entry && entry->refn);
+
+    // no references? exit it
+    if (!--entry->refn)
+    {
+        // exit it
+        tb_cookies_entry_exit(cookies, entry);
+
+        // free it
+        tb_free(entry);
+    }
+}
+static tb_void_t tb_cookies_entry_list_item_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
 
     // the cookies
     tb_cookies_t* cookies = (tb_cookies_t*)element->priv;
-    tb_assert_and_check_return(cookies && cookies->string_pool);
+    tb_assert_and_check_return(cookies);
 
-    // exit it
-    tb_cookies_entry_exit(cookies, entry);
+    // the entry
+    tb_cookies_entry_ref_t entry = *((tb_cookies_entry_ref_t*)buff);
+    if (entry)
+    {
+        // mark it as removed, it will be freed lazily if the expires heap still references it
+        entry->removed = 1;
+        if (entry->expires) cookies->expires_dead++;
+
+        // update the cookies count
+        if (cookies->size) cookies->size--;
+
+        // release it
+        tb_cookies_entry_release(cookies, entry);
+    }
+
+    // clear it
+    *((tb_pointer_t*)buff) = tb_null;
+}
+static tb_void_t tb_cookies_entry_list_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit the entry list
+    tb_vector_ref_t list = *((tb_vector_ref_t*)buff);
+    if (list) tb_vector_exit(list);
+
+    // clear it
+    *((tb_pointer_t*)buff) = tb_null;
 }
-static tb_size_t tb_cookies_entry_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
+static tb_size_t tb_cookies_entry_list_find(tb_vector_ref_t list, tb_char_t const* path, tb_char_t const* name)
 {
     // check
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)data;
-    tb_assert_and_check_return_val(element && entry && entry->domain, 0);
+    tb_assert_and_check_return_val(list, 0);
+
+    // find the entry with the same path and name
+    tb_size_t               i = 0;
+    tb_size_t               n = tb_vector_size(list);
+    tb_cookies_entry_ref_t* entries = (tb_cookies_entry_ref_t*)tb_vector_data(list);
+    for (i = 0; i < n; i++)
+    {
+        tb_cookies_entry_ref_t entry = entries[i];
+        if (    !tb_strcmp(entry->path? entry->path : "", path? path : "")
+            &&  !tb_strcmp(entry->name? entry->name : "", name? name : ""))
+            break;
+    }
+
+    // ok?
+    return i;
+}
+static tb_void_t tb_cookies_entry_list_remove(tb_cookies_t* cookies, tb_vector_ref_t list, tb_size_t itor, tb_char_t const* domain)
+{
+    // check
+    tb_assert_and_check_return(cookies && cookies->domain_pool && list && domain);
+
+    /* remove the entry from the list, or remove the whole list if it's the last entry
+     *
+     * @note the given domain must not be owned by the removed entry
+     */
+    if (tb_vector_size(list) > 1) tb_vector_remove(list, itor);
+    else tb_hash_map_remove(cookies->domain_pool, domain);
+}
+static tb_void_t tb_cookies_expires_item_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
 
     // the cookies
     tb_cookies_t* cookies = (tb_cookies_t*)element->priv;
-    tb_assert_and_check_return_val(cookies && cookies->string_element.hash, 0);
+    tb_assert_and_check_return(cookies);
+
+    // the entry
+    tb_cookies_entry_ref_t entry = *((tb_cookies_entry_ref_t*)buff);
+    if (entry)
+    {
+        // it has been removed? update the removed entries count
+        if (entry->removed && cookies->expires_dead) cookies->expires_dead--;
 
-    // compute the three hash values
-    tb_size_t v0 = cookies->string_element.hash(&cookies->string_element, entry->domain, mask, index);
-    tb_size_t v1 = entry->path? cookies->string_element.hash(&cookies->string_element, entry->path, mask, index) : 0;
-    tb_size_t v2 = entry->name? cookies->string_element.hash(&cookies->string_element, entry->name, mask, index) : 0;
+        // release it
+        tb_cookies_entry_release(cookies, entry);
+    }
 
-    // the hash value
-    return (v0 ^ v1 ^ v2) & mask;
+    // clear it
+    *((tb_pointer_t*)buff) = tb_null;
 }
-static tb_long_t tb_cookies_entry_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static tb_long_t tb_cookies_expires_item_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
 {
     // check
     tb_cookies_entry_ref_t lentry = (tb_cookies_entry_ref_t)ldata;
     tb_cookies_entry_ref_t rentry = (tb_cookies_entry_ref_t)rdata;
-    tb_assert_and_check_return_val(lentry && lentry->domain, 0);
-    tb_assert_and_check_return_val(rentry && rentry->domain, 0);
+    tb_assert(lentry && rentry);
 
-    // compare domain
-    tb_long_t ok = tb_strcmp(lentry->domain, rentry->domain);
-    tb_check_return_val(!ok, ok);
+    // compare expires
+    return lentry->expires < rentry->expires? -1 : (lentry->expires > rentry->expires);
+}
+static tb_element_t tb_cookies_expires_element(tb_cookies_t* cookies)
+{
+    // the entry pointer element sorted by the expires time
+    tb_element_t element = tb_element_ptr(tb_cookies_expires_item_free, cookies);
+    element.comp = tb_cookies_expires_item_comp;
+    return element;
+}
+static tb_bool_t tb_cookies_expires_check(tb_cookies_t* cookies, tb_time_t now)
+{
+    // check
+    tb_assert(cookies && cookies->expires_heap);
 
-    // compare domain
-    ok = tb_strcmp(lentry->path? lentry->path : "", rentry->path? rentry->path : "");
-    tb_check_return_val(!ok, ok);
+    // the top entry has been expired?
+    tb_cookies_entry_ref_t entry = tb_heap_size(cookies->expires_heap)? (tb_cookies_entry_ref_t)tb_heap_top(cookies->expires_heap) : tb_null;
+    return (entry && now >= entry->expires)? tb_true : tb_false;
+}
+static tb_void_t tb_cookies_expires_evict(tb_cookies_t* cookies, tb_time_t now)
+{
+    // check
+    tb_assert_and_check_return(cookies && cookies->domain_pool && cookies->expires_heap);
+
+    // remove all expired entries from the top of the expires heap
+    while (tb_cookies_expires_check(cookies, now))
+    {
+        // the top entry
+        tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)tb_heap_top(cookies->expires_heap);
+        tb_assert_and_check_break(entry);
 
-    // compare name
-    return tb_strcmp(lentry->name? lentry->name : "", rentry->name? rentry->name : "");
+        // remove it from the domain list if it has not been removed
+        if (!entry->removed)
+        {
+            // trace
+            tb_trace_d("expired: %s%s%s: %s = %s", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "");
+
+            // remove it, the entry is still referenced by the expires heap
+            tb_vector_ref_t list = (tb_vector_ref_t)tb_hash_map_get(cookies->domain_pool, entry->domain);
+            if (list)
+            {
+                tb_size_t               i = 0;
+                tb_size_t               n = tb_vector_size(list);
+                tb_cookies_entry_ref_t* entries = (tb_cookies_entry_ref_t*)tb_vector_data(list);
+                for (i = 0; i < n && entries[i] != entry; i++) ;
+                if (i < n) tb_cookies_entry_list_remove(cookies, list, i, entry->domain);
+            }
+        }
+
+        // pop it and release it
+        tb_heap_pop(cookies->expires_heap);
+    }
+}
+static tb_void_t tb_cookies_expires_compact(tb_cookies_t* cookies)
+{
+    // check
+    tb_assert_and_check_return(cookies && cookies->expires_heap);
+
+    // too few removed entries? only remove them lazily
+    tb_size_t size = tb_heap_size(cookies->expires_heap);
+    tb_check_return(cookies->expires_dead > TB_COOKIES_EXPIRES_DEAD_MAXN && cookies->expires_dead > (size >> 1));
+
+    // init a new expires heap
+    tb_heap_ref_t expires_heap = tb_heap_init(TB_COOKIES_EXPIRES_GROW, tb_cookies_expires_element(cookies));
+    tb_assert_and_check_return(expires_heap);
+
+    // move all alive entries to the new heap
+    tb_for_all_if (tb_cookies_entry_ref_t, entry, cookies->expires_heap, entry && !entry->removed)
+    {
+        entry->refn++;
+        tb_heap_put(expires_heap, entry);
+    }
+
+    // exit the old heap and release all entries
+    tb_heap_exit(cookies->expires_heap);
+    cookies->expires_heap = expires_heap;
+    tb_assert(!cookies->expires_dead);
 }
 static tb_bool_t tb_cookies_entry_init(tb_cookies_t* cookies, tb_cookies_entry_ref_t entry, tb_char_t const* domain, tb_char_t const* path, tb_bool_t secure, tb_char_t const* value)
 {
@@ -427,53 +581,6 @@ static tb_bool_t tb_cookies_entry_init(tb_cookies_t* cookies, tb_cookies_entry_r
     // ok
     return tb_true;
 }
-static tb_bool_t tb_cookies_entry_walk(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
-{
-    // check
-    tb_value_t* tuple = (tb_value_t*)value;
-    tb_assert(item && tuple);
-
-    // the entry
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)item;
-    tb_assert(entry && entry->domain);
-
-    // the domain
-    tb_char_t const* domain = tuple[0].cstr;
-
-    // the path
-    tb_char_t const* path = tuple[1].cstr;
-
-    // the secure
-    tb_size_t secure = tuple[2].ul;
-
-    // the value of key
-    tb_string_ref_t kvalue = (tb_string_ref_t)tuple[3].ptr;
-    tb_assert(kvalue);
-
-    // expired?
-    if (entry->expires && tb_cache_time() >= entry->expires)
-    {
-        // trace
-        tb_trace_d("expired: %s%s%s: %s = %s", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "");
-
-        // remove it
-        return tb_true;
-    }
-
-    // this cookies is at domain/path?
-    if (    tb_cookies_is_child_domain(entry->domain, domain)
-        &&  entry->path && entry->name
-        &&  tb_cookies_is_child_path(entry->path, path)
-        &&  entry->secure == secure)
-    {
-        // append "key=value; "
-        tb_string_cstrfcat(kvalue, "%s=%s; ", entry->name, entry->value? entry->value : "");
-    }
-
-    // continue
-    return tb_false;
-}
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -511,26 +618,19 @@ tb_cookies_ref_t tb_cookies_init()
         tb_assert_and_check_break(cookies);
 
         // init lock
-        if (!tb_spinlock_init(&cookies->lock)) break;
+        if (!tb_rwspinlock_init(&cookies->lock)) break;
 
         // init string pool
         cookies->string_pool = tb_string_pool_init(tb_true);
         tb_assert_and_check_break(cookies->string_pool);
 
-        // init cookie pool
-        tb_element_t element = tb_element_mem(sizeof(tb_cookies_entry_t), tb_cookies_entry_free, cookies);
-        element.hash = tb_cookies_entry_hash;
-        element.comp = tb_cookies_entry_comp;
-        cookies->cookie_pool = tb_hash_set_init(TB_HASH_SET_BUCKET_SIZE_MICRO, element);
-        tb_assert_and_check_break(cookies->cookie_pool);
+        // init domain pool
+        cookies->domain_pool = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_str(tb_true), tb_element_ptr(tb_cookies_entry_list_free, cookies));
+        tb_assert_and_check_break(cookies->domain_pool);
 
-        // init string element
-        cookies->string_element = tb_element_str(tb_true);
-
-        // register lock profiler
-#ifdef TB_LOCK_PROFILER_ENABLE
-        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&cookies->lock, TB_TRACE_MODULE_NAME);
-#endif
+        // init expires heap
+        cookies->expires_heap = tb_heap_init(TB_COOKIES_EXPIRES_GROW, tb_cookies_expires_element(cookies));
+        tb_assert_and_check_break(cookies->expires_heap);
 
         // ok
         ok = tb_true;
@@ -555,21 +655,25 @@ tb_void_t tb_cookies_exit(tb_cookies_ref_t self)
     tb_assert_and_check_return(cookies);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_rwspinlock_enter_write(&cookies->lock);
 
-    // exit cookie pool
-    if (cookies->cookie_pool) tb_hash_set_exit(cookies->cookie_pool);
-    cookies->cookie_pool = tb_null;
+    // exit domain pool
+    if (cookies->domain_pool) tb_hash_map_exit(cookies->domain_pool);
+    cookies->domain_pool = tb_null;
+
+    // exit expires heap
+    if (cookies->expires_heap) tb_heap_exit(cookies->expires_heap);
+    cookies->expires_heap = tb_null;
 
     // exit string pool
     if (cookies->string_pool) tb_string_pool_exit(cookies->string_pool);
     cookies->string_pool = tb_null;
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_rwspinlock_leave_write(&cookies->lock);
 
     // exit lock
-    tb_spinlock_exit(&cookies->lock);
+    tb_rwspinlock_exit(&cookies->lock);
 
     // exit it
     tb_free(cookies);
@@ -581,16 +685,21 @@ tb_void_t tb_cookies_clear(tb_cookies_ref_t self)
     tb_assert_and_check_return(cookies);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_rwspinlock_enter_write(&cookies->lock);
+
+    // clear domain pool
+    if (cookies->domain_pool) tb_hash_map_clear(cookies->domain_pool);
 
-    // clear cookie pool
-    if (cookies->cookie_pool) tb_hash_set_clear(cookies->cookie_pool);
+    // clear expires heap
+    if (cookies->expires_heap) tb_heap_clear(cookies->expires_heap);
+    cookies->expires_dead = 0;
+    cookies->size = 0;
 
     // clear string pool
     if (cookies->string_pool) tb_string_pool_clear(cookies->string_pool);
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_rwspinlock_leave_write(&cookies->lock);
 }
 tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char_t const* path, tb_bool_t secure, tb_char_t const* value)
 {
@@ -599,38 +708,80 @@ tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char
     tb_assert_and_check_return_val(cookies, tb_false);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_rwspinlock_enter_write(&cookies->lock);
 
     // done
-    tb_bool_t           ok = tb_false;
-    tb_cookies_entry_t  entry = {0};
+    tb_bool_t               ok = tb_false;
+    tb_cookies_entry_t      entry = {0};
+    tb_cookies_entry_ref_t  item = tb_null;
     do
     {
         // check
-        tb_assert_and_check_break(cookies->string_pool && cookies->cookie_pool);
+        tb_assert_and_check_break(cookies->string_pool && cookies->domain_pool && cookies->expires_heap);
 
         // init entry
         if (!tb_cookies_entry_init(cookies, &entry, domain, path, secure, value)) break;
 
-        // maxage is zero? remove it
-        if (!entry.maxage && !entry.storage)
+        // remove the old entry with the same domain, path and name
+        tb_vector_ref_t list = (tb_vector_ref_t)tb_hash_map_get(cookies->domain_pool, entry.domain);
+        if (list)
         {
-            // remove it
-            tb_hash_set_remove(cookies->cookie_pool, &entry);
-
-            // exit it
-            tb_cookies_entry_exit(cookies, &entry);
+            tb_size_t itor = tb_cookies_entry_list_find(list, entry.path, entry.name);
+            if (itor < tb_vector_size(list)) tb_cookies_entry_list_remove(cookies, list, itor, entry.domain);
         }
-        // set entry
-        else tb_hash_set_insert(cookies->cookie_pool, &entry);
 
-        // storage to file?
-        if (entry.storage)
+        // maxage is zero? only remove it
+        if (!entry.maxage && !entry.storage) tb_cookies_entry_exit(cookies, &entry);
+        else
         {
-            // TODO
-            tb_trace1_w("not supports storaging cookies to file now!");
+            // make item
+            item = tb_malloc0_type(tb_cookies_entry_t);
+            tb_assert_and_check_break(item);
+
+            // move the entry to the item
+            *item = entry;
+            item->refn = 1;
+            tb_memset(&entry, 0, sizeof(tb_cookies_entry_t));
+
+            // get the entry list of this domain or make it
+            list = (tb_vector_ref_t)tb_hash_map_get(cookies->domain_pool, item->domain);
+            if (!list)
+            {
+                // make list
+                list = tb_vector_init(4, tb_element_ptr(tb_cookies_entry_list_item_free, cookies));
+                tb_assert_and_check_break(list);
+
+                // save list
+                if (!tb_hash_map_insert(cookies->domain_pool, item->domain, list))
+                {
+                    tb_vector_exit(list);
+                    break;
+                }
+            }
+
+            // insert item, the list will release it
+            tb_vector_insert_tail(list, item);
+            cookies->size++;
+
+            // insert item to the expires heap
+            if (item->expires)
+            {
+                item->refn++;
+                tb_heap_put(cookies->expires_heap, item);
+            }
+
+            // storage to file?
+            if (item->storage)
+            {
+                // TODO
+                tb_trace1_w("not supports storaging cookies to file now!");
+            }
+            item = tb_null;
         }
 
+        // compact the expires heap if there are too many removed entries
+        tb_cookies_expires_compact(cookies);
+
         // ok
         ok = tb_true;
 
@@ -641,10 +792,11 @@ tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char
     {
         // exit it
         tb_cookies_entry_exit(cookies, &entry);
+        if (item) tb_cookies_entry_release(cookies, item);
     }
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_rwspinlock_leave_write(&cookies->lock);
 
     // ok?
     return ok;
@@ -680,44 +832,89 @@ tb_char_t const* tb_cookies_get(tb_cookies_ref_t self, tb_char_t const* domain,
     // clear value first
     tb_string_clear(value);
 
+    // no path? using the root path
+    if (!path || !path[0]) path = "/";
+
+    // skip '.'
+    if (*domain == '.') domain++;
+
+    // spak the cached time
+    tb_cache_time_spak();
+    tb_time_t now = tb_cache_time();
+
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_rwspinlock_enter_read(&cookies->lock);
+
+    // some cookies have been expired? evict them first
+    if (cookies->expires_heap && tb_cookies_expires_check(cookies, now))
+    {
+        // enter it for writing
+        tb_rwspinlock_leave_read(&cookies->lock);
+        tb_rwspinlock_enter_write(&cookies->lock);
+
+        // evict them
+        tb_cookies_expires_evict(cookies, now);
+
+        // enter it for reading again
+        tb_rwspinlock_leave_write(&cookies->lock);
+        tb_rwspinlock_enter_read(&cookies->lock);
+    }
 
     // done
     tb_bool_t ok = tb_false;
     do
     {
         // check
-        tb_assert_and_check_break(cookies->string_pool && cookies->cookie_pool);
-
-        // no path? using the root path
-        if (!path || !path[0]) path = "/";
-
-        // skip '.'
-        if (*domain == '.') domain++;
+        tb_assert_and_check_break(cookies->string_pool && cookies->domain_pool);
+
+        /* get the matched values from the entry lists of this domain and all parent domains
+         *
+         * e.g. "a.b.com" => "a.b.com", "b.com", but not "com"
+         */
+        tb_char_t const* p = domain;
+        while (p && *p)
+        {
+            // the parent domain need have one '.' at least
+            tb_char_t const* dot = tb_strchr(p, '.');
+            tb_check_break(dot);
 
-        // spak the cached time
-        tb_cache_time_spak();
+            // get the entry list of this domain
+            tb_vector_ref_t list = (tb_vector_ref_t)tb_hash_map_get(cookies->domain_pool, p);
+            if (list)
+            {
+                tb_size_t               i = 0;
+                tb_size_t               n = tb_vector_size(list);
+                tb_cookies_entry_ref_t* entries = (tb_cookies_entry_ref_t*)tb_vector_data(list);
+                for (i = 0; i < n; i++)
+                {
+                    // this cookies is at path and not expired?
+                    tb_cookies_entry_ref_t entry = entries[i];
+                    if (    entry->path && entry->name
+                        &&  entry->secure == (secure? 1 : 0)
+                        &&  (!entry->expires || now < entry->expires)
+                        &&  tb_cookies_is_child_path(entry->path, path))
+                    {
+                        // append "key=value; "
+                        tb_string_cstrfcat(value, "%s=%s; ", entry->name, entry->value? entry->value : "");
+                    }
+                }
+            }
 
-        // get the matched values
-        tb_value_t tuple[4];
-        tuple[0].cstr   = domain;
-        tuple[1].cstr   = path;
-        tuple[2].ul     = secure? 1 : 0;
-        tuple[3].ptr    = value;
-        tb_remove_if(cookies->cookie_pool, tb_cookies_entry_walk, tuple);
+            // the next parent domain
+            p = dot + 1;
+        }
 
         // ok
         ok = tb_true;
 
     } while (0);
 
+    // leave
+    tb_rwspinlock_leave_read(&cookies->lock);
+
     // failed?
     if (!ok) tb_string_clear(value);
 
-    // leave
-    tb_spinlock_leave(&cookies->lock);
-
     // ok?
     return tb_string_size(value)? tb_string_cstr(value) : tb_null;
 }
@@ -744,29 +941,31 @@ tb_void_t tb_cookies_dump(tb_cookies_ref_t self)
 {
     // check
     tb_cookies_t* cookies = (tb_cookies_t*)self;
-    tb_assert_and_check_return(cookies && cookies->cookie_pool);
+    tb_assert_and_check_return(cookies && cookies->domain_pool);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_rwspinlock_enter_read(&cookies->lock);
 
     // dump
     tb_trace_i("");
-    tb_trace_i("cookie: size: %lu", tb_hash_set_size(cookies->cookie_pool));
-    tb_for_all_if (tb_cookies_entry_ref_t, entry, cookies->cookie_pool, entry)
+    tb_trace_i("cookie: size: %lu, domains: %lu", cookies->size, tb_hash_map_size(cookies->domain_pool));
+    tb_for_all_if (tb_hash_map_item_ref_t, item, cookies->domain_pool, item && item->data)
     {
-        // the entry
-        tb_assert_and_check_continue(entry->domain);
+        tb_for_all_if (tb_cookies_entry_ref_t, entry, (tb_vector_ref_t)item->data, entry)
+        {
+            // the entry
+            tb_assert_and_check_continue(entry->domain);
 
-        // the date
-        tb_tm_t date = {0};
-        tb_gmtime(entry->expires, &date);
+            // the date
+            tb_tm_t date = {0};
+            tb_gmtime(entry->expires, &date);
 
-        // trace
-        tb_trace_i("%s%s%s: %s = %s, expires: %04ld-%02ld-%02ld %02ld:%02ld:%02ld GMT, week: %d", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "", date.year, date.month, date.mday, date.hour, date.minute, date.second, date.week);
+            // trace
+            tb_trace_i("%s%s%s: %s = %s, expires: %04ld-%02ld-%02ld %02ld:%02ld:%02ld GMT, week: %d", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "", date.year, date.month, date.mday, date.hour, date.minute, date.second, date.week);
+        }
     }
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_rwspinlock_leave_read(&cookies->lock);
 }
 #endif
-
@@ -45,40 +45,107 @@
 #   define TB_DNS_CACHE_MAXN        (256)
 #endif
 
+// the cache shards count, must be power of 2
+#ifdef __tb_small__
+#   define TB_DNS_CACHE_SHARDN      (4)
+#else
+#   define TB_DNS_CACHE_SHARDN      (16)
+#endif
+
+// the default ttl (seconds) if the dns answer has no ttl
+#define TB_DNS_CACHE_TTL            (600)
+
+// the minimum ttl (seconds)
+#define TB_DNS_CACHE_TTL_MIN        (10)
+
+// the maximum ttl (seconds)
+#define TB_DNS_CACHE_TTL_MAX        (86400)
+
+// the maximum ttl (seconds) of the negative host, e.g. NXDOMAIN
+#define TB_DNS_CACHE_TTL_NEGATIVE   (300)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the dns cache type
-typedef struct __tb_dns_cache_t
+// the dns cache addr type
+typedef struct __tb_dns_cache_addr_t
 {
-    // the hash
+    // the list entry
+    tb_list_entry_t         entry;
+
+    // the addr, it's empty if the host does not exist
+    tb_ipaddr_t             addr;
+
+    // the expired time
+    tb_time_t               expired;
+
+    // has been visited recently? the readers only set it and the writer clears it when evicting
+    tb_atomic32_t           visited;
+
+    // the name, e.g. "www.xxx.com\0"
+    tb_char_t               name[1];
+
+}tb_dns_cache_addr_t;
+
+/* the dns cache shard type
+ *
+ * the readers only lookup the hash and mark the visited addr, so they can enter it at the same time,
+ * and the writer evicts the addr by the clock list (second chance) for the approximate LRU order
+ *
+ * <pre>
+ * clock list: head [addr0(visited)] => [addr1] => [addr2(visited)] => ... => [addrN] tail
+ *                       |                |
+ *             clear and move to tail   evict
+ * </pre>
+ */
+typedef struct __tb_dns_cache_shard_t
+{
+    // the lock
+    tb_rwspinlock_t         lock;
+
+    // the hash, name => addr
     tb_hash_map_ref_t       hash;
 
-    // the times
-    tb_hize_t               times;
+    // the clock list, the newest addr is at the tail
+    tb_list_entry_head_t    list;
 
-    // the expired
-    tb_size_t               expired;
+    // the maxn
+    tb_size_t               maxn;
 
-}tb_dns_cache_t;
+    // the hit count
+    tb_atomic64_t           hit;
 
-// the dns cache addr type
-typedef struct __tb_dns_cache_addr_t
+    // the negative hit count
+    tb_atomic64_t           hit_negative;
+
+    // the miss count
+    tb_atomic64_t           miss;
+
+    // the evicted count
+    tb_atomic64_t           evict;
+
+}__tb_cacheline_aligned__ tb_dns_cache_shard_t;
+
+// the dns cache type
+typedef struct __tb_dns_cache_t
 {
-    // the addr
-    tb_ipaddr_t             addr;
+    // the shards
+    tb_dns_cache_shard_t    shards[TB_DNS_CACHE_SHARDN];
 
-    // the time
-    tb_size_t               time;
+    // the maxn
+    tb_size_t               maxn;
 
-}tb_dns_cache_addr_t;
+    // have been inited?
+    tb_bool_t               inited;
+
+}tb_dns_cache_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
-// the lock
+// the lock for init and exit
 static tb_spinlock_t        g_lock = TB_SPINLOCK_INIT;
 
 // the cache
@@ -87,36 +154,142 @@ static tb_dns_cache_t       g_cache = {0};
 /* //////////////////////////////////////////////////////////////////////////////////////
  * helper
  */
-static __tb_inline__ tb_size_t tb_dns_cache_now()
+static __tb_inline__ tb_time_t tb_dns_cache_now()
+{
+    return (tb_time_t)(tb_cache_time_spak() / 1000);
+}
+static tb_uint32_t tb_dns_cache_hash(tb_char_t const* name)
 {
-    return (tb_size_t)(tb_cache_time_spak() / 1000);
+    // the host name is case-insensitive, using fnv-1a
+    tb_uint32_t hash = 2166136261ul;
+    tb_byte_t const* p = (tb_byte_t const*)name;
+    for (; *p; p++)
+    {
+        hash ^= (tb_uint32_t)tb_tolower(*p);
+        hash *= 16777619ul;
+    }
+    return hash;
 }
-static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_size_t tb_dns_cache_name_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
 {
     // check
-    tb_assert(item);
+    tb_assert_and_check_return_val(data, 0);
 
-    // the dns cache address
-    tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)((tb_hash_map_item_ref_t)item)->data;
-    tb_assert(caddr);
+    // the hash value
+    return (tb_size_t)tb_dns_cache_hash((tb_char_t const*)data) & mask;
+}
+static tb_long_t tb_dns_cache_name_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    // check
+    tb_assert_and_check_return_val(ldata && rdata, 0);
 
-    // is expired?
-    tb_bool_t ok = tb_false;
-    if (caddr->time < g_cache.expired)
+    // compare it
+    return tb_stricmp((tb_char_t const*)ldata, (tb_char_t const*)rdata);
+}
+static __tb_inline__ tb_dns_cache_shard_t* tb_dns_cache_shard(tb_char_t const* name)
+{
+    // using the high bits, because the low bits are used by the hash buckets
+    return &g_cache.shards[(tb_dns_cache_hash(name) >> 24) & (TB_DNS_CACHE_SHARDN - 1)];
+}
+static tb_size_t tb_dns_cache_shard_maxn(tb_size_t maxn)
+{
+    // the maxn of each shard
+    return tb_max((maxn + TB_DNS_CACHE_SHARDN - 1) / TB_DNS_CACHE_SHARDN, 1);
+}
+static tb_void_t tb_dns_cache_shard_remove(tb_dns_cache_shard_t* shard, tb_dns_cache_addr_t* caddr)
+{
+    // check
+    tb_assert(shard && shard->hash && caddr);
+
+    // trace
+    tb_trace_d("del: %s => %{ipaddr}, expired: %ld, size: %u", caddr->name, &caddr->addr, caddr->expired, tb_hash_map_size(shard->hash));
+
+    // remove it from the hash and list
+    tb_hash_map_remove(shard->hash, caddr->name);
+    tb_list_entry_remove(&shard->list, &caddr->entry);
+
+    // exit it
+    tb_free(caddr);
+}
+static tb_void_t tb_dns_cache_shard_evict(tb_dns_cache_shard_t* shard, tb_size_t maxn, tb_time_t now)
+{
+    // check
+    tb_assert(shard);
+
+    /* evict addr from the head of the clock list until the size is less than maxn
+     *
+     * the visited addr will be given a second chance and be moved to the tail,
+     * so it will be done after walking the whole list once at most.
+     */
+    while (tb_list_entry_size(&shard->list) > maxn)
     {
-        // remove it
-        ok = tb_true;
+        // the oldest addr
+        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_list_entry(&shard->list, tb_list_entry_head(&shard->list));
+        tb_assert_and_check_break(caddr);
 
-        // trace
-        tb_trace_d("del: %s => %{ipaddr}, time: %u, size: %u", (tb_char_t const*)item->name, &caddr->addr, caddr->time, tb_hash_map_size(g_cache.hash));
+        // visited recently and not expired? give it a second chance
+        if (now < caddr->expired && tb_atomic32_get_explicit(&caddr->visited, TB_ATOMIC_RELAXED))
+        {
+            tb_atomic32_set_explicit(&caddr->visited, 0, TB_ATOMIC_RELAXED);
+            tb_list_entry_moveto_tail(&shard->list, &caddr->entry);
+            continue;
+        }
+
+        // evict it
+        tb_dns_cache_shard_remove(shard, caddr);
+        tb_atomic64_fetch_and_add_explicit(&shard->evict, 1, TB_ATOMIC_RELAXED);
+    }
+}
+static tb_void_t tb_dns_cache_shard_exit(tb_dns_cache_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
 
-        // update times
-        tb_assert(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
+    // exit hash
+    if (shard->hash) tb_hash_map_exit(shard->hash);
+    shard->hash = tb_null;
+
+    // exit all addrs
+    while (tb_list_entry_size(&shard->list))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&shard->list);
+        tb_list_entry_remove(&shard->list, entry);
+        tb_free(tb_list_entry(&shard->list, entry));
     }
+    tb_list_entry_exit(&shard->list);
 
-    // ok?
-    return ok;
+    // exit lock
+    tb_rwspinlock_exit(&shard->lock);
+}
+static tb_bool_t tb_dns_cache_shard_init(tb_dns_cache_shard_t* shard, tb_size_t maxn)
+{
+    // check
+    tb_assert(shard);
+
+    // init lock
+    if (!tb_rwspinlock_init(&shard->lock)) return tb_false;
+
+    // init list
+    tb_list_entry_init(&shard->list, tb_dns_cache_addr_t, entry, tb_null);
+
+    // init hash, the name is stored in the addr
+    tb_element_t element_name = tb_element_ptr(tb_null, tb_null);
+    element_name.hash = tb_dns_cache_name_hash;
+    element_name.comp = tb_dns_cache_name_comp;
+    shard->hash = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, element_name, tb_element_ptr(tb_null, tb_null));
+    tb_assert_and_check_return_val(shard->hash, tb_false);
+
+    // init maxn
+    shard->maxn = maxn;
+
+    // init stat
+    tb_atomic64_init(&shard->hit, 0);
+    tb_atomic64_init(&shard->hit_negative, 0);
+    tb_atomic64_init(&shard->miss, 0);
+    tb_atomic64_init(&shard->evict, 0);
+
+    // ok
+    return tb_true;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -131,11 +304,35 @@ tb_bool_t tb_dns_cache_init()
     tb_bool_t ok = tb_false;
     do
     {
-        // init hash
-        if (!g_cache.hash) g_cache.hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
-        tb_assert_and_check_break(g_cache.hash);
+        // have been inited?
+        if (g_cache.inited)
+        {
+            ok = tb_true;
+            break;
+        }
+
+        // init maxn
+        if (!g_cache.maxn) g_cache.maxn = TB_DNS_CACHE_MAXN;
+
+        // init shards
+        tb_size_t i = 0;
+        tb_size_t maxn = tb_dns_cache_shard_maxn(g_cache.maxn);
+        for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+        {
+            if (!tb_dns_cache_shard_init(&g_cache.shards[i], maxn)) break;
+        }
+
+        // failed? exit the inited shards and the failed shard
+        if (i < TB_DNS_CACHE_SHARDN)
+        {
+            tb_size_t j = 0;
+            for (j = 0; j <= i; j++)
+                tb_dns_cache_shard_exit(&g_cache.shards[j]);
+            break;
+        }
 
         // ok
+        g_cache.inited = tb_true;
         ok = tb_true;
 
     } while (0);
@@ -143,9 +340,6 @@ tb_bool_t tb_dns_cache_init()
     // leave
     tb_spinlock_leave(&g_lock);
 
-    // failed? exit it
-    if (!ok) tb_dns_cache_exit();
-
     // ok?
     return ok;
 }
@@ -154,135 +348,246 @@ tb_void_t tb_dns_cache_exit()
     // enter
     tb_spinlock_enter(&g_lock);
 
-    // exit hash
-    if (g_cache.hash) tb_hash_map_exit(g_cache.hash);
-    g_cache.hash = tb_null;
+    // exit shards
+    if (g_cache.inited)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+            tb_dns_cache_shard_exit(&g_cache.shards[i]);
+        g_cache.inited = tb_false;
+    }
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+}
+tb_void_t tb_dns_cache_limit(tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return(maxn);
 
-    // exit times
-    g_cache.times = 0;
+    // enter
+    tb_spinlock_enter(&g_lock);
 
-    // exit expired
-    g_cache.expired = 0;
+    // save maxn
+    g_cache.maxn = maxn;
+
+    // update the maxn of all shards and evict the extra addrs
+    if (g_cache.inited)
+    {
+        tb_size_t i = 0;
+        tb_time_t now = tb_dns_cache_now();
+        for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+        {
+            tb_dns_cache_shard_t* shard = &g_cache.shards[i];
+            tb_rwspinlock_enter_write(&shard->lock);
+            shard->maxn = tb_dns_cache_shard_maxn(maxn);
+            if (shard->hash) tb_dns_cache_shard_evict(shard, shard->maxn, now);
+            tb_rwspinlock_leave_write(&shard->lock);
+        }
+    }
 
     // leave
     tb_spinlock_leave(&g_lock);
 }
 tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    return tb_dns_cache_find(name, addr) > 0;
+}
+tb_long_t tb_dns_cache_find(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
     // check
-    tb_assert_and_check_return_val(name && addr, tb_false);
+    tb_assert_and_check_return_val(name, 0);
 
     // trace
     tb_trace_d("get: %s", name);
 
     // is addr?
-    tb_check_return_val(!tb_ipaddr_ip_cstr_set(addr, name, TB_IPADDR_FAMILY_NONE), tb_true);
+    if (addr)
+    {
+        tb_check_return_val(!tb_ipaddr_ip_cstr_set(addr, name, TB_IPADDR_FAMILY_NONE), 1);
+    }
 
     // is localhost?
     if (!tb_stricmp(name, "localhost"))
     {
         // save address
-        tb_ipaddr_ip_cstr_set(addr, "127.0.0.1", TB_IPADDR_FAMILY_IPV4);
+        if (addr) tb_ipaddr_ip_cstr_set(addr, "127.0.0.1", TB_IPADDR_FAMILY_IPV4);
 
         // ok
-        return tb_true;
+        return 1;
     }
 
     // clear address
-    tb_ipaddr_clear(addr);
+    if (addr) tb_ipaddr_clear(addr);
+
+    // check
+    tb_check_return_val(g_cache.inited, 0);
+
+    // the shard
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(name);
 
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_rwspinlock_enter_read(&shard->lock);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_long_t ok = 0;
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
+        tb_assert_and_check_break(shard->hash);
 
         // get the host address
-        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(g_cache.hash, name);
+        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, name);
         tb_check_break(caddr);
 
+        // expired? it will be evicted or updated by the writer
+        tb_time_t now = tb_dns_cache_now();
+        tb_check_break(now < caddr->expired);
+
         // trace
-        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &caddr->addr, caddr->time, tb_dns_cache_now(), tb_hash_map_size(g_cache.hash));
+        tb_trace_d("get: %s => %{ipaddr}, expired: %ld => %ld, size: %u", name, &caddr->addr, caddr->expired, now, tb_hash_map_size(shard->hash));
 
-        // update time
-        tb_assert_and_check_break(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-        caddr->time = tb_dns_cache_now();
-        g_cache.times += caddr->time;
+        // mark it as visited
+        if (!tb_atomic32_get_explicit(&caddr->visited, TB_ATOMIC_RELAXED))
+            tb_atomic32_set_explicit(&caddr->visited, 1, TB_ATOMIC_RELAXED);
+
+        // the host does not exist?
+        if (tb_ipaddr_ip_is_empty(&caddr->addr))
+        {
+            ok = -1;
+            break;
+        }
 
         // save address
-        tb_ipaddr_copy(addr, &caddr->addr);
+        if (addr) tb_ipaddr_copy(addr, &caddr->addr);
 
         // ok
-        ok = tb_true;
+        ok = 1;
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_rwspinlock_leave_read(&shard->lock);
+
+    // update stat
+    if (ok > 0) tb_atomic64_fetch_and_add_explicit(&shard->hit, 1, TB_ATOMIC_RELAXED);
+    else if (ok < 0) tb_atomic64_fetch_and_add_explicit(&shard->hit_negative, 1, TB_ATOMIC_RELAXED);
+    else tb_atomic64_fetch_and_add_explicit(&shard->miss, 1, TB_ATOMIC_RELAXED);
 
     // ok?
     return ok;
 }
 tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    // check address
+    tb_assert(addr && !tb_ipaddr_ip_is_empty(addr));
+
+    // set it with the default ttl
+    tb_dns_cache_set_ttl(name, addr, TB_DNS_CACHE_TTL);
+}
+tb_void_t tb_dns_cache_set_ttl(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t ttl)
 {
     // check
-    tb_assert_and_check_return(name && addr);
+    tb_assert_and_check_return(name && g_cache.inited);
 
-    // check address
-    tb_assert(!tb_ipaddr_ip_is_empty(addr));
+    // the host does not exist?
+    tb_bool_t negative = (!addr || tb_ipaddr_ip_is_empty(addr))? tb_true : tb_false;
 
     // trace
-    tb_trace_d("set: %s => %{ipaddr}", name, addr);
+    tb_trace_d("set: %s, negative: %d, ttl: %u", name, negative, ttl);
 
-    // init addr
-    tb_dns_cache_addr_t caddr;
-    caddr.time = tb_dns_cache_now();
-    tb_ipaddr_copy(&caddr.addr, addr);
+    // clamp ttl
+    if (ttl < TB_DNS_CACHE_TTL_MIN) ttl = TB_DNS_CACHE_TTL_MIN;
+    if (ttl > TB_DNS_CACHE_TTL_MAX) ttl = TB_DNS_CACHE_TTL_MAX;
+    if (negative && ttl > TB_DNS_CACHE_TTL_NEGATIVE) ttl = TB_DNS_CACHE_TTL_NEGATIVE;
+
+    // the expired time
+    tb_time_t now = tb_dns_cache_now();
+    tb_time_t expired = now + ttl;
+
+    // the shard
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(name);
 
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_rwspinlock_enter_write(&shard->lock);
 
     // done
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
+        tb_assert_and_check_break(shard->hash);
 
-        // remove the expired items if full
-        if (tb_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN)
+        // exists? update it
+        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, name);
+        if (caddr)
         {
-            // the expired time
-            g_cache.expired = ((tb_size_t)(g_cache.times / tb_hash_map_size(g_cache.hash)) + 1);
+            // update the addr, but a negative answer does not overwrite the unexpired addr
+            if (!negative) tb_ipaddr_copy(&caddr->addr, addr);
+            else if (now < caddr->expired && !tb_ipaddr_ip_is_empty(&caddr->addr)) break;
+            else tb_ipaddr_clear(&caddr->addr);
+            caddr->expired = expired;
+
+            // move it to the tail
+            tb_atomic32_set_explicit(&caddr->visited, 0, TB_ATOMIC_RELAXED);
+            tb_list_entry_moveto_tail(&shard->list, &caddr->entry);
+            break;
+        }
 
-            // check
-            tb_assert_and_check_break(g_cache.expired);
+        // remove the oldest addrs if full
+        if (shard->maxn) tb_dns_cache_shard_evict(shard, shard->maxn - 1, now);
 
-            // trace
-            tb_trace_d("expired: %lu", g_cache.expired);
+        // make addr
+        tb_size_t size = tb_strlen(name);
+        caddr = (tb_dns_cache_addr_t*)tb_malloc0(sizeof(tb_dns_cache_addr_t) + size);
+        tb_assert_and_check_break(caddr);
 
-            // remove the expired times
-            tb_remove_if(g_cache.hash, tb_dns_cache_clear, tb_null);
-        }
-
-        // check
-        tb_assert_and_check_break(tb_hash_map_size(g_cache.hash) < TB_DNS_CACHE_MAXN);
+        // init addr
+        if (negative) tb_ipaddr_clear(&caddr->addr);
+        else tb_ipaddr_copy(&caddr->addr, addr);
+        caddr->expired = expired;
+        tb_memcpy(caddr->name, name, size + 1);
 
         // save addr
-        tb_hash_map_insert(g_cache.hash, name, &caddr);
-
-        // update times
-        g_cache.times += caddr.time;
+        if (!tb_hash_map_insert(shard->hash, caddr->name, caddr))
+        {
+            tb_free(caddr);
+            break;
+        }
+        tb_list_entry_insert_tail(&shard->list, &caddr->entry);
 
         // trace
-        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &caddr.addr, caddr.time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("set: %s => %{ipaddr}, expired: %ld, size: %u", name, &caddr->addr, caddr->expired, tb_hash_map_size(shard->hash));
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_rwspinlock_leave_write(&shard->lock);
+}
+tb_void_t tb_dns_cache_stat(tb_dns_cache_stat_ref_t stat)
+{
+    // check
+    tb_assert_and_check_return(stat);
+
+    // init stat
+    tb_memset(stat, 0, sizeof(tb_dns_cache_stat_t));
+    stat->maxn = g_cache.maxn? g_cache.maxn : TB_DNS_CACHE_MAXN;
+    tb_check_return(g_cache.inited);
+
+    // sum the stat of all shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+    {
+        tb_dns_cache_shard_t* shard = &g_cache.shards[i];
+
+        // the size
+        tb_rwspinlock_enter_read(&shard->lock);
+        stat->size += tb_list_entry_size(&shard->list);
+        tb_rwspinlock_leave_read(&shard->lock);
+
+        // the counts
+        stat->hit           += (tb_hize_t)tb_atomic64_get_explicit(&shard->hit, TB_ATOMIC_RELAXED);
+        stat->hit_negative  += (tb_hize_t)tb_atomic64_get_explicit(&shard->hit_negative, TB_ATOMIC_RELAXED);
+        stat->miss          += (tb_hize_t)tb_atomic64_get_explicit(&shard->miss, TB_ATOMIC_RELAXED);
+        stat->evict         += (tb_hize_t)tb_atomic64_get_explicit(&shard->evict, TB_ATOMIC_RELAXED);
+    }
 }
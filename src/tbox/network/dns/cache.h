@@ -32,6 +32,33 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the dns cache stat type
+typedef struct __tb_dns_cache_stat_t
+{
+    /// the cached hosts count
+    tb_size_t               size;
+
+    /// the maximum hosts count
+    tb_size_t               maxn;
+
+    /// the hit count
+    tb_hize_t               hit;
+
+    /// the negative hit count, the cached host does not exist
+    tb_hize_t               hit_negative;
+
+    /// the miss count, includes the expired hosts
+    tb_hize_t               miss;
+
+    /// the evicted count
+    tb_hize_t               evict;
+
+}tb_dns_cache_stat_t, *tb_dns_cache_stat_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -47,6 +74,15 @@ tb_bool_t           tb_dns_cache_init(tb_noarg_t);
 /// exit the cache list
 tb_void_t           tb_dns_cache_exit(tb_noarg_t);
 
+/*! set the maximum hosts count of the cache
+ *
+ * the hosts are spread over some shards and evicted by the approximate LRU order,
+ * the extra hosts will be evicted immediately if the cache is shrinked.
+ *
+ * @param maxn      the maximum hosts count
+ */
+tb_void_t           tb_dns_cache_limit(tb_size_t maxn);
+
 /*! get addr from cache
  *
  * @param name      the host name
@@ -56,13 +92,36 @@ tb_void_t           tb_dns_cache_exit(tb_noarg_t);
  */
 tb_bool_t           tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
-/*! set addr to cache
+/*! find addr from cache
+ *
+ * @param name      the host name
+ * @param addr      the host addr, optional
+ *
+ * @return          found: 1, not cached: 0, the host does not exist: -1
+ */
+tb_long_t           tb_dns_cache_find(tb_char_t const* name, tb_ipaddr_ref_t addr);
+
+/*! set addr to cache with the default ttl
  *
  * @param name      the host name
  * @param addr      the host addr
  */
 tb_void_t           tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
+/*! set addr to cache with the given ttl
+ *
+ * @param name      the host name
+ * @param addr      the host addr, cache it negatively if it's null or empty (e.g. NXDOMAIN)
+ * @param ttl       the ttl (seconds) of the dns answer
+ */
+tb_void_t           tb_dns_cache_set_ttl(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t ttl);
+
+/*! get the cache stat
+ *
+ * @param stat      the stat
+ */
+tb_void_t           tb_dns_cache_stat(tb_dns_cache_stat_ref_t stat);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
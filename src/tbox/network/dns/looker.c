@@ -32,6 +32,8 @@
 #include "looker.h"
 #include "cache.h"
 #include "server.h"
+#include "resolver.h"
+#include "../impl/dns/packet.h"
 #include "../../string/string.h"
 #include "../../memory/memory.h"
 #include "../../network/network.h"
@@ -111,81 +113,8 @@ static tb_long_t tb_dns_looker_reqt(tb_dns_looker_t* looker)
         tb_assert_and_check_return_val(!looker->size, -1);
 
         // format query
-        tb_static_stream_t  stream;
-        tb_byte_t           rpkt[TB_DNS_RPKT_MAXN];
-        tb_size_t           size = 0;
-        tb_byte_t*          p = tb_null;
-        tb_static_stream_init(&stream, rpkt, TB_DNS_RPKT_MAXN);
-
-        // identification number
-        tb_static_stream_writ_u16_be(&stream, TB_DNS_HEADER_MAGIC);
-
-        /* 0x2104: 0 0000 001 0000 0000
-         *
-         * tb_uint16_t qr     :1;       // query/response flag
-         * tb_uint16_t opcode :4;       // purpose of message
-         * tb_uint16_t aa     :1;       // authoritive answer
-         * tb_uint16_t tc     :1;       // truncated message
-         * tb_uint16_t rd     :1;       // recursion desired
-
-         * tb_uint16_t ra     :1;       // recursion available
-         * tb_uint16_t z      :1;       // its z! reserved
-         * tb_uint16_t ad     :1;       // authenticated data
-         * tb_uint16_t cd     :1;       // checking disabled
-         * tb_uint16_t rcode  :4;       // response code
-         *
-         * this is a query
-         * this is a standard query
-         * not authoritive answer
-         * not truncated
-         * recursion desired
-         *
-         * recursion not available! hey we dont have it (lol)
-         *
-         */
-#if 1
-        tb_static_stream_writ_u16_be(&stream, 0x0100);
-#else
-        tb_static_stream_writ_u1(&stream, 0);          // this is a query
-        tb_static_stream_writ_ubits32(&stream, 0, 4);  // this is a standard query
-        tb_static_stream_writ_u1(&stream, 0);          // not authoritive answer
-        tb_static_stream_writ_u1(&stream, 0);          // not truncated
-        tb_static_stream_writ_u1(&stream, 1);          // recursion desired
-
-        tb_static_stream_writ_u1(&stream, 0);          // recursion not available! hey we dont have it (lol)
-        tb_static_stream_writ_u1(&stream, 0);
-        tb_static_stream_writ_u1(&stream, 0);
-        tb_static_stream_writ_u1(&stream, 0);
-        tb_static_stream_writ_ubits32(&stream, 0, 4);
-#endif
-
-        /* we have only one question
-         *
-         * tb_uint16_t question;        // number of question entries
-         * tb_uint16_t answer;          // number of answer entries
-         * tb_uint16_t authority;       // number of authority entries
-         * tb_uint16_t resource;        // number of resource entries
-         *
-         */
-        tb_static_stream_writ_u16_be(&stream, 1);
-        tb_static_stream_writ_u16_be(&stream, 0);
-        tb_static_stream_writ_u16_be(&stream, 0);
-        tb_static_stream_writ_u16_be(&stream, 0);
-
-        // set questions, see as tb_dns_question_t
-        // name + question1 + question2 + ...
-        tb_static_stream_writ_u8(&stream, '.');
-        p = (tb_byte_t*)tb_static_stream_writ_cstr(&stream, tb_static_string_cstr(&looker->name));
-
-        // only one question now.
-        tb_static_stream_writ_u16_be(&stream, 1);      // we are requesting the ipv4 address
-        tb_static_stream_writ_u16_be(&stream, 1);      // it's internet (lol)
-
-        // encode dns name
-        if (!p || !tb_dns_encode_name((tb_char_t*)p - 1)) return -1;
-
-        // size
-        size = tb_static_stream_offset(&stream);
+        tb_byte_t rpkt[TB_DNS_RPKT_MAXN];
+        tb_size_t size = tb_dns_packet_make_query(rpkt, sizeof(rpkt), TB_DNS_HEADER_MAGIC, tb_static_string_cstr(&looker->name));
         tb_assert_and_check_return_val(size, -1);
 
         // copy
@@ -264,208 +193,15 @@ static tb_long_t tb_dns_looker_reqt(tb_dns_looker_t* looker)
     tb_trace_d("request: ok");
     return 1;
 }
-static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr)
+static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr, tb_uint32_t* pttl, tb_size_t* prcode)
 {
     // the rpkt and size
     tb_byte_t const*    rpkt = tb_static_buffer_data(&looker->rpkt);
     tb_size_t           size = tb_static_buffer_size(&looker->rpkt);
     tb_assert_and_check_return_val(rpkt && size >= TB_DNS_HEADER_SIZE, tb_false);
 
-    // init stream
-    tb_static_stream_t stream;
-    tb_static_stream_init(&stream, (tb_byte_t*)rpkt, size);
-
-    // init header
-    tb_dns_header_t header;
-    header.id           = tb_static_stream_read_u16_be(&stream); tb_static_stream_skip(&stream, 2);
-    header.question     = tb_static_stream_read_u16_be(&stream);
-    header.answer       = tb_static_stream_read_u16_be(&stream);
-    header.authority    = tb_static_stream_read_u16_be(&stream);
-    header.resource     = tb_static_stream_read_u16_be(&stream);
-
-    // trace
-    tb_trace_d("response: size: %u",        size);
-    tb_trace_d("response: id: 0x%04x",      header.id);
-    tb_trace_d("response: question: %d",    header.question);
-    tb_trace_d("response: answer: %d",      header.answer);
-    tb_trace_d("response: authority: %d",   header.authority);
-    tb_trace_d("response: resource: %d",    header.resource);
-    tb_trace_d("");
-
-    // check header
-    tb_assert_and_check_return_val(header.id == TB_DNS_HEADER_MAGIC, tb_false);
-
-    // skip questions, only one question now.
-    // name + question1 + question2 + ...
-    tb_assert_and_check_return_val(header.question == 1, tb_false);
-#if 1
-    tb_static_stream_skip_cstr(&stream);
-    tb_static_stream_skip(&stream, 4);
-#else
-    tb_char_t* name = tb_static_stream_read_cstr(&stream);
-    //name = tb_dns_decode_name(name);
-    tb_assert_and_check_return_val(name, tb_false);
-    tb_static_stream_skip(&stream, 4);
-    tb_trace_d("response: name: %s", name);
-#endif
-
-    // decode answers
-    tb_size_t i = 0;
-    tb_size_t found = 0;
-    for (i = 0; i < header.answer; i++)
-    {
-        // decode answer
-        tb_dns_answer_t answer;
-        tb_trace_d("response: answer: %d", i);
-
-        // decode dns name
-        tb_char_t const* name = tb_dns_decode_name(&stream, answer.name); tb_used(name);
-        tb_trace_d("response: name: %s", name);
-
-        // decode resource
-        answer.res.type     = tb_static_stream_read_u16_be(&stream);
-        answer.res.class_   = tb_static_stream_read_u16_be(&stream);
-        answer.res.ttl      = tb_static_stream_read_u32_be(&stream);
-        answer.res.size     = tb_static_stream_read_u16_be(&stream);
-        tb_trace_d("response: type: %d",    answer.res.type);
-        tb_trace_d("response: class: %d",   answer.res.class_);
-        tb_trace_d("response: ttl: %d",     answer.res.ttl);
-        tb_trace_d("response: size: %d",    answer.res.size);
-
-        // is ipv4?
-        if (answer.res.type == 1)
-        {
-            // get ipv4
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
-
-            // trace
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
-
-            // save the first ip
-            if (!found)
-            {
-                // save it
-                if (addr)
-                {
-                    // init ipv4
-                    tb_ipv4_t ipv4;
-                    ipv4.u8[0] = b1;
-                    ipv4.u8[1] = b2;
-                    ipv4.u8[2] = b3;
-                    ipv4.u8[3] = b4;
-
-                    // save ipv4
-                    tb_ipaddr_ipv4_set(addr, &ipv4);
-                }
-
-                // found it
-                found = 1;
-
-                // trace
-                tb_trace_d("response: ");
-                break;
-            }
-        }
-        else
-        {
-            // decode rdata
-            answer.rdata = (tb_byte_t*)tb_dns_decode_name(&stream, answer.name);
-
-            // trace
-            tb_trace_d("response: alias: %s", answer.rdata? (tb_char_t const*)answer.rdata : "");
-        }
-
-        // trace
-        tb_trace_d("response: ");
-    }
-
-    // found it?
-    tb_check_return_val(found, tb_false);
-
-#if 0
-    // decode authorities
-    for (i = 0; i < header.authority; i++)
-    {
-        // decode answer
-        tb_dns_answer_t answer;
-        tb_trace_d("response: authority: %d", i);
-
-        // decode dns name
-        tb_char_t* name = tb_dns_decode_name(&stream, answer.name);
-        tb_trace_d("response: name: %s", name? name : "");
-
-        // decode resource
-        answer.res.type =   tb_static_stream_read_u16_be(&stream);
-        answer.res.class_ = tb_static_stream_read_u16_be(&stream);
-        answer.res.ttl =    tb_static_stream_read_u32_be(&stream);
-        answer.res.size =   tb_static_stream_read_u16_be(&stream);
-        tb_trace_d("response: type: %d",    answer.res.type);
-        tb_trace_d("response: class: %d",   answer.res.class_);
-        tb_trace_d("response: ttl: %d",     answer.res.ttl);
-        tb_trace_d("response: size: %d",    answer.res.size);
-
-        // is ipv4?
-        if (answer.res.type == 1)
-        {
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
-        }
-        else
-        {
-            // decode data
-            answer.rdata = tb_dns_decode_name(&stream, answer.name);
-            tb_trace_d("response: server: %s", answer.rdata? answer.rdata : "");
-        }
-        tb_trace_d("response: ");
-    }
-
-    for (i = 0; i < header.resource; i++)
-    {
-        // decode answer
-        tb_dns_answer_t answer;
-        tb_trace_d("response: resource: %d", i);
-
-        // decode dns name
-        tb_char_t* name = tb_dns_decode_name(&stream, answer.name);
-        tb_trace_d("response: name: %s", name? name : "");
-
-        // decode resource
-        answer.res.type =   tb_static_stream_read_u16_be(&stream);
-        answer.res.class_ = tb_static_stream_read_u16_be(&stream);
-        answer.res.ttl =    tb_static_stream_read_u32_be(&stream);
-        answer.res.size =   tb_static_stream_read_u16_be(&stream);
-        tb_trace_d("response: type: %d",    answer.res.type);
-        tb_trace_d("response: class: %d",   answer.res.class_);
-        tb_trace_d("response: ttl: %d",     answer.res.ttl);
-        tb_trace_d("response: size: %d",    answer.res.size);
-
-        // is ipv4?
-        if (answer.res.type == 1)
-        {
-            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
-            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
-            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
-        }
-        else
-        {
-            // decode data
-            answer.rdata = tb_dns_decode_name(&stream, answer.name);
-            tb_trace_d("response: alias: %s", answer.rdata? answer.rdata : "");
-        }
-        tb_trace_d("response: ");
-    }
-#endif
-
-    // ok
-    return tb_true;
+    // parse the answer
+    return tb_dns_packet_parse_answer(rpkt, size, TB_DNS_HEADER_MAGIC, tb_null, addr, pttl, prcode);
 }
 static tb_long_t tb_dns_looker_resp(tb_dns_looker_t* looker, tb_ipaddr_ref_t addr)
 {
@@ -508,13 +244,21 @@ static tb_long_t tb_dns_looker_resp(tb_dns_looker_t* looker, tb_ipaddr_ref_t add
     }
 
     // done
-    if (!tb_dns_looker_resp_done(looker, addr)) return -1;
+    tb_uint32_t ttl = 0;
+    tb_size_t   rcode = 0;
+    if (!tb_dns_looker_resp_done(looker, addr, &ttl, &rcode))
+    {
+        // the host does not exist? cache it negatively if the server has given the negative ttl
+        if (rcode == TB_DNS_RCODE_NXDOMAIN && ttl && tb_static_string_size(&looker->name))
+            tb_dns_cache_set_ttl(tb_static_string_cstr(&looker->name), tb_null, ttl);
+        return -1;
+    }
 
     // check
     tb_assert_and_check_return_val(tb_static_string_size(&looker->name) && !tb_ipaddr_ip_is_empty(addr), -1);
 
-    // save address to cache
-    tb_dns_cache_set(tb_static_string_cstr(&looker->name), addr);
+    // save address to cache with the ttl of the answer
+    tb_dns_cache_set_ttl(tb_static_string_cstr(&looker->name), addr, ttl);
 
     // finish it
     looker->step |= TB_DNS_LOOKER_STEP_RESP;
@@ -684,8 +428,13 @@ tb_bool_t tb_dns_looker_done(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // check
     tb_assert_and_check_return_val(name && addr, tb_false);
 
-    // try to lookup it from cache first
-    if (tb_dns_cache_get(name, addr)) return tb_true;
+    // try to lookup it from cache first, the host may not exist
+    tb_long_t cached = tb_dns_cache_find(name, addr);
+    if (cached) return cached > 0? tb_true : tb_false;
+
+    // lookup it using the resolver of this thread, the lookups of all coroutines will share one socket
+    tb_dns_resolver_ref_t resolver = tb_dns_resolver_self();
+    if (resolver) return tb_dns_resolver_done(resolver, name, addr);
 
     // init looker
     tb_dns_looker_ref_t looker = tb_dns_looker_init(name);
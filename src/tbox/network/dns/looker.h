@@ -77,7 +77,7 @@ tb_void_t           tb_dns_looker_exit(tb_dns_looker_ref_t looker);
 
 /*! lookup address from the host name, block
  *
- * try to look it from cache first
+ * try to look it from cache first, then look it using the resolver of the current thread
  *
  * @param name      the host name
  * @param addr      the address
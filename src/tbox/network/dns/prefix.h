@@ -46,6 +46,9 @@
 // the rpkt maximum size
 #define TB_DNS_RPKT_MAXN            (TB_DNS_HEADER_SIZE + TB_DNS_NAME_MAXN + 256)
 
+// the response code: name error, the host does not exist
+#define TB_DNS_RCODE_NXDOMAIN       (3)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
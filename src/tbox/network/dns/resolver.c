@@ -0,0 +1,770 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        resolver.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "dns_resolver"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "resolver.h"
+#include "cache.h"
+#include "server.h"
+#include "../impl/dns/packet.h"
+#include "../../libc/libc.h"
+#include "../../math/math.h"
+#include "../../utils/utils.h"
+#include "../../memory/memory.h"
+#include "../../platform/platform.h"
+#include "../../container/container.h"
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../../coroutine/coroutine.h"
+#   include "../../coroutine/impl/impl.h"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the timeout of each try
+#define TB_DNS_RESOLVER_TIMEOUT         (2000)
+
+// the tries of each server
+#define TB_DNS_RESOLVER_TRYN            (2)
+
+// the query packet maximum size
+#define TB_DNS_RESOLVER_QPKT_MAXN       (TB_DNS_HEADER_SIZE + TB_DNS_NAME_MAXN + 8)
+
+// the queries grow
+#ifdef __tb_small__
+#   define TB_DNS_RESOLVER_GROW         (16)
+#else
+#   define TB_DNS_RESOLVER_GROW         (64)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the dns resolver waiter type
+typedef struct __tb_dns_resolver_waiter_t
+{
+    // the next waiter
+    struct __tb_dns_resolver_waiter_t*  next;
+
+    // the func
+    tb_dns_resolver_func_t              func;
+
+    // the user private data
+    tb_cpointer_t                       priv;
+
+}tb_dns_resolver_waiter_t;
+
+// the dns resolver query type
+typedef struct __tb_dns_resolver_query_t
+{
+    // the list entry of the sending queries
+    tb_list_entry_t                     entry;
+
+    // the resolver
+    struct __tb_dns_resolver_t*         resolver;
+
+    // the timeout task
+    tb_ltimer_task_ref_t                task;
+
+    // the waiters
+    tb_dns_resolver_waiter_t*           waiters;
+
+    // the query id
+    tb_uint16_t                         id;
+
+    // the tried count
+    tb_uint16_t                         tryn;
+
+    // the packet size
+    tb_uint16_t                         size;
+
+    // is sending?
+    tb_uint16_t                         sending;
+
+    // the host name
+    tb_char_t                           name[TB_DNS_NAME_MAXN];
+
+    // the query packet
+    tb_byte_t                           data[TB_DNS_RESOLVER_QPKT_MAXN];
+
+}tb_dns_resolver_query_t;
+
+// the dns resolver result type for the blocking lookup
+typedef struct __tb_dns_resolver_result_t
+{
+    // the list entry of the followers
+    tb_list_entry_t                     entry;
+
+    // the address
+    tb_ipaddr_ref_t                     addr;
+
+    // the state, 0: pending, 1: ok, -1: failed
+    tb_long_t                           state;
+
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+    // the semaphore of the waiting coroutine
+    tb_co_semaphore_ref_t               semaphore;
+#endif
+
+}tb_dns_resolver_result_t;
+
+// the dns resolver type
+typedef struct __tb_dns_resolver_t
+{
+    // the socket
+    tb_socket_ref_t                     sock;
+
+    // the socket family
+    tb_size_t                           family;
+
+    // the timer for the query timeout
+    tb_ltimer_ref_t                     timer;
+
+    // the pending queries, name => query
+    tb_hash_map_ref_t                   names;
+
+    // the pending queries, id => query
+    tb_hash_map_ref_t                   ids;
+
+    // the sending queries
+    tb_list_entry_head_t                sends;
+
+    // the coroutines which are waiting for the driver
+    tb_list_entry_head_t                followers;
+
+    // is driving the blocking lookups?
+    tb_bool_t                           driving;
+
+    // the server list
+    tb_ipaddr_t                         list[2];
+
+    // the server count
+    tb_size_t                           maxn;
+
+    // the response packet
+    tb_byte_t                           rpkt[TB_DNS_RPKT_MAXN];
+
+}tb_dns_resolver_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the resolver of the current thread
+static tb_thread_local_t                g_resolver_self = TB_THREAD_LOCAL_INIT;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_dns_resolver_servers(tb_dns_resolver_t* resolver)
+{
+    // get the dns server list
+    tb_ipaddr_t list[2];
+    tb_size_t   maxn = tb_dns_server_get(list);
+    tb_check_return_val(maxn && maxn <= tb_arrayn(list), tb_false);
+
+    // the socket family, uses the family of the first server
+    tb_size_t family = tb_ipaddr_family(&list[0]);
+    if (family != resolver->family)
+    {
+        // exit the previous socket
+        if (resolver->sock) tb_socket_exit(resolver->sock);
+
+        // init a new socket for the family
+        resolver->family = family;
+        resolver->sock   = tb_socket_init(TB_SOCKET_TYPE_UDP, family);
+        tb_assert_and_check_return_val(resolver->sock, tb_false);
+    }
+
+    // save the servers of this family, we use only one socket
+    tb_size_t i = 0;
+    resolver->maxn = 0;
+    for (i = 0; i < maxn; i++)
+    {
+        if (tb_ipaddr_family(&list[i]) == family)
+            resolver->list[resolver->maxn++] = list[i];
+    }
+
+    // ok
+    return resolver->maxn;
+}
+static tb_void_t tb_dns_resolver_query_done(tb_dns_resolver_t* resolver, tb_dns_resolver_query_t* query, tb_ipaddr_ref_t addr)
+{
+    // trace
+    tb_trace_d("query: %s, id: %u, tryn: %u => %{ipaddr}", query->name, query->id, query->tryn, addr);
+
+    // remove it from the pending queries first, the func may post this name again
+    tb_hash_map_remove(resolver->ids, tb_u2p(query->id));
+    tb_hash_map_remove(resolver->names, query->name);
+    if (query->sending) tb_list_entry_remove(&resolver->sends, &query->entry);
+    query->sending = 0;
+
+    // exit the timeout task
+    if (query->task) tb_ltimer_task_exit(resolver->timer, query->task);
+    query->task = tb_null;
+
+    // done all waiters
+    tb_dns_resolver_waiter_t* waiter = query->waiters;
+    while (waiter)
+    {
+        tb_dns_resolver_waiter_t* next = waiter->next;
+        waiter->func((tb_dns_resolver_ref_t)resolver, query->name, addr, waiter->priv);
+        tb_free(waiter);
+        waiter = next;
+    }
+
+    // exit it
+    tb_free(query);
+}
+static tb_void_t tb_dns_resolver_query_next(tb_dns_resolver_t* resolver, tb_dns_resolver_query_t* query)
+{
+    // exit the timeout task of the previous try
+    if (query->task) tb_ltimer_task_exit(resolver->timer, query->task);
+    query->task = tb_null;
+
+    // no more tries? failed
+    if (++query->tryn >= resolver->maxn * TB_DNS_RESOLVER_TRYN)
+    {
+        tb_dns_resolver_query_done(resolver, query, tb_null);
+        return ;
+    }
+
+    // send it to the next server
+    if (!query->sending)
+    {
+        tb_list_entry_insert_tail(&resolver->sends, &query->entry);
+        query->sending = 1;
+    }
+}
+static tb_void_t tb_dns_resolver_query_timeout(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)priv;
+    tb_assert_and_check_return(query && query->resolver);
+
+    // trace
+    tb_trace_d("query: %s, id: %u, tryn: %u timeout", query->name, query->id, query->tryn);
+
+    // retry it
+    tb_dns_resolver_query_next(query->resolver, query);
+}
+static tb_dns_resolver_query_t* tb_dns_resolver_query_init(tb_dns_resolver_t* resolver, tb_char_t const* name)
+{
+    // too many pending queries?
+    tb_check_return_val(tb_hash_map_size(resolver->ids) < TB_MAXU16, tb_null);
+
+    // refresh the servers if be idle
+    if (!tb_hash_map_size(resolver->ids) && !tb_dns_resolver_servers(resolver)) return tb_null;
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_dns_resolver_query_t*    query = tb_null;
+    do
+    {
+        // make query
+        query = tb_malloc0_type(tb_dns_resolver_query_t);
+        tb_assert_and_check_break(query);
+
+        // init name
+        tb_strlcpy(query->name, name, sizeof(query->name));
+        query->resolver = resolver;
+
+        // make a random id which is not used, it's hard to be spoofed
+        do
+        {
+            query->id = (tb_uint16_t)tb_random_value();
+
+        } while (tb_hash_map_get(resolver->ids, tb_u2p(query->id)));
+
+        // make the query packet
+        query->size = (tb_uint16_t)tb_dns_packet_make_query(query->data, sizeof(query->data), query->id, query->name);
+        tb_check_break(query->size);
+
+        // save it
+        if (!tb_hash_map_insert(resolver->ids, tb_u2p(query->id), query)) break;
+        if (!tb_hash_map_insert(resolver->names, query->name, query))
+        {
+            tb_hash_map_remove(resolver->ids, tb_u2p(query->id));
+            break;
+        }
+
+        // send it
+        tb_list_entry_insert_tail(&resolver->sends, &query->entry);
+        query->sending = 1;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (query) tb_free(query);
+        query = tb_null;
+    }
+
+    // ok?
+    return query;
+}
+static tb_long_t tb_dns_resolver_reqt(tb_dns_resolver_t* resolver)
+{
+    // send all pending requests
+    while (tb_list_entry_size(&resolver->sends))
+    {
+        // the query
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->sends, tb_list_entry_head(&resolver->sends));
+        tb_assert_and_check_return_val(query && resolver->maxn, -1);
+
+        // the server, try all servers in turn
+        tb_ipaddr_ref_t addr = &resolver->list[query->tryn % resolver->maxn];
+
+        // trace
+        tb_trace_d("request: %s, id: %u, try %{ipaddr}", query->name, query->id, addr);
+
+        // send it
+        tb_long_t writ = tb_socket_usend(resolver->sock, addr, query->data, query->size);
+
+        // no buffer space? wait it
+        tb_check_break(writ);
+
+        // remove it from the sending queries
+        tb_list_entry_remove(&resolver->sends, &query->entry);
+        query->sending = 0;
+
+        // failed? try the next server, otherwise wait the response
+        if (writ != (tb_long_t)query->size) tb_dns_resolver_query_next(resolver, query);
+        else
+        {
+            query->task = tb_ltimer_task_init(resolver->timer, TB_DNS_RESOLVER_TIMEOUT, tb_false, tb_dns_resolver_query_timeout, query);
+            tb_assert_and_check_return_val(query->task, -1);
+        }
+    }
+
+    // ok
+    return 1;
+}
+static tb_void_t tb_dns_resolver_resp_done(tb_dns_resolver_t* resolver, tb_ipaddr_ref_t from, tb_size_t size)
+{
+    // check
+    tb_check_return(size >= TB_DNS_HEADER_SIZE);
+
+    // is the response of our server?
+    tb_size_t i = 0;
+    for (i = 0; i < resolver->maxn && !tb_ipaddr_is_equal(from, &resolver->list[i]); i++) ;
+    tb_check_return(i < resolver->maxn);
+
+    // get the pending query of this id
+    tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_hash_map_get(resolver->ids, tb_u2p(tb_bits_get_u16_be(resolver->rpkt)));
+    tb_check_return(query);
+
+    // parse it
+    tb_ipaddr_t addr;
+    tb_uint32_t ttl = 0;
+    tb_size_t   rcode = (tb_size_t)-1;
+    tb_ipaddr_clear(&addr);
+    if (tb_dns_packet_parse_answer(resolver->rpkt, size, query->id, query->name, &addr, &ttl, &rcode))
+    {
+        // save address to cache with the ttl of the answer
+        tb_dns_cache_set_ttl(query->name, &addr, ttl);
+
+        // ok
+        tb_dns_resolver_query_done(resolver, query, &addr);
+    }
+    // it's not the response of this query? ignore it
+    else if (rcode == (tb_size_t)-1) return ;
+    // the host does not exist? cache it negatively if the server has given the negative ttl
+    else if (rcode == TB_DNS_RCODE_NXDOMAIN)
+    {
+        if (ttl) tb_dns_cache_set_ttl(query->name, tb_null, ttl);
+        tb_dns_resolver_query_done(resolver, query, tb_null);
+    }
+    // no ipv4 address?
+    else if (!rcode) tb_dns_resolver_query_done(resolver, query, tb_null);
+    // the server has been failed? try the next server now
+    else tb_dns_resolver_query_next(resolver, query);
+}
+static tb_long_t tb_dns_resolver_resp(tb_dns_resolver_t* resolver)
+{
+    // recv all responses
+    while (tb_hash_map_size(resolver->ids))
+    {
+        // read data
+        tb_ipaddr_t from;
+        tb_long_t   read = tb_socket_urecv(resolver->sock, &from, resolver->rpkt, sizeof(resolver->rpkt));
+        tb_assert_and_check_return_val(read >= 0, -1);
+
+        // no data?
+        tb_check_break(read);
+
+        // done it
+        tb_dns_resolver_resp_done(resolver, &from, read);
+    }
+
+    // ok
+    return 1;
+}
+static tb_void_t tb_dns_resolver_post_cancel(tb_dns_resolver_t* resolver, tb_char_t const* name, tb_cpointer_t priv)
+{
+    // get the pending query
+    tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_hash_map_get(resolver->names, name);
+    tb_check_return(query);
+
+    // remove the waiter of this priv, the query will be finished without it
+    tb_dns_resolver_waiter_t** pwaiter = &query->waiters;
+    while (*pwaiter)
+    {
+        tb_dns_resolver_waiter_t* waiter = *pwaiter;
+        if (waiter->priv == priv)
+        {
+            *pwaiter = waiter->next;
+            tb_free(waiter);
+            break;
+        }
+        pwaiter = &waiter->next;
+    }
+}
+static tb_void_t tb_dns_resolver_done_func(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_ref_t addr, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_resolver_result_t* result = (tb_dns_resolver_result_t*)priv;
+    tb_assert_and_check_return(result && result->addr);
+
+    // save the result
+    if (addr) tb_ipaddr_ip_set(result->addr, addr);
+    result->state = addr? 1 : -1;
+
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+    // notify the waiting coroutine
+    if (result->semaphore) tb_co_semaphore_post(result->semaphore, 1);
+#endif
+}
+static tb_void_t tb_dns_resolver_self_free(tb_cpointer_t priv)
+{
+    if (priv) tb_dns_resolver_exit((tb_dns_resolver_ref_t)priv);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_dns_resolver_ref_t tb_dns_resolver_init()
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_dns_resolver_t*  resolver = tb_null;
+    do
+    {
+        // make resolver
+        resolver = tb_malloc0_type(tb_dns_resolver_t);
+        tb_assert_and_check_break(resolver);
+
+        // init the queries
+        tb_list_entry_init(&resolver->sends, tb_dns_resolver_query_t, entry, tb_null);
+        tb_list_entry_init(&resolver->followers, tb_dns_resolver_result_t, entry, tb_null);
+
+        // init the server list and socket
+        if (!tb_dns_resolver_servers(resolver)) break;
+
+        // init timer
+        resolver->timer = tb_ltimer_init(TB_DNS_RESOLVER_GROW, TB_LTIMER_TICK_100MS, tb_false);
+        tb_assert_and_check_break(resolver->timer);
+
+        // init the pending queries
+        resolver->ids = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_uint16(), tb_element_ptr(tb_null, tb_null));
+        resolver->names = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_false), tb_element_ptr(tb_null, tb_null));
+        tb_assert_and_check_break(resolver->ids && resolver->names);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (resolver) tb_dns_resolver_exit((tb_dns_resolver_ref_t)resolver);
+        resolver = tb_null;
+    }
+
+    // ok?
+    return (tb_dns_resolver_ref_t)resolver;
+}
+tb_void_t tb_dns_resolver_exit(tb_dns_resolver_ref_t self)
+{
+    // the resolver
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_check_return(resolver);
+
+    // fail all pending queries
+    while (resolver->ids && tb_hash_map_size(resolver->ids))
+    {
+        tb_hash_map_item_ref_t item = (tb_hash_map_item_ref_t)tb_iterator_item(resolver->ids, tb_iterator_head(resolver->ids));
+        tb_assert_and_check_break(item && item->data);
+        tb_dns_resolver_query_done(resolver, (tb_dns_resolver_query_t*)item->data, tb_null);
+    }
+
+    // exit the pending queries
+    if (resolver->ids) tb_hash_map_exit(resolver->ids);
+    if (resolver->names) tb_hash_map_exit(resolver->names);
+    resolver->ids = tb_null;
+    resolver->names = tb_null;
+
+    // exit timer
+    if (resolver->timer) tb_ltimer_exit(resolver->timer);
+    resolver->timer = tb_null;
+
+    // exit sock
+    if (resolver->sock) tb_socket_exit(resolver->sock);
+    resolver->sock = tb_null;
+
+    // exit it
+    tb_free(resolver);
+}
+tb_dns_resolver_ref_t tb_dns_resolver_self()
+{
+    // init self
+    if (!tb_thread_local_init(&g_resolver_self, tb_dns_resolver_self_free)) return tb_null;
+
+    // get the resolver of this thread
+    tb_dns_resolver_ref_t resolver = (tb_dns_resolver_ref_t)tb_thread_local_get(&g_resolver_self);
+    if (!resolver)
+    {
+        // init it
+        resolver = tb_dns_resolver_init();
+        tb_check_return_val(resolver, tb_null);
+
+        /* it may be switched to the other coroutine when getting the dns servers,
+         * so we need use the resolver if it has been created by the other coroutine
+         */
+        tb_dns_resolver_ref_t other = (tb_dns_resolver_ref_t)tb_thread_local_get(&g_resolver_self);
+        if (other || !tb_thread_local_set(&g_resolver_self, resolver))
+        {
+            tb_dns_resolver_exit(resolver);
+            resolver = other;
+        }
+    }
+
+    // ok?
+    return resolver;
+}
+tb_size_t tb_dns_resolver_size(tb_dns_resolver_ref_t self)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && resolver->ids, 0);
+
+    return tb_hash_map_size(resolver->ids);
+}
+tb_bool_t tb_dns_resolver_post(tb_dns_resolver_ref_t self, tb_char_t const* name, tb_dns_resolver_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && resolver->names && name && func, tb_false);
+    tb_check_return_val(tb_strlen(name) < TB_DNS_NAME_MAXN, tb_false);
+
+    // try to lookup it from cache first, the host may not exist
+    tb_ipaddr_t addr;
+    tb_ipaddr_clear(&addr);
+    tb_long_t cached = tb_dns_cache_find(name, &addr);
+    if (cached)
+    {
+        func(self, name, cached > 0? &addr : tb_null, priv);
+        return tb_true;
+    }
+
+    // make waiter
+    tb_dns_resolver_waiter_t* waiter = tb_malloc0_type(tb_dns_resolver_waiter_t);
+    tb_assert_and_check_return_val(waiter, tb_false);
+
+    // attempt to coalesce it to the pending query of the same name
+    tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_hash_map_get(resolver->names, name);
+    if (!query) query = tb_dns_resolver_query_init(resolver, name);
+    if (!query)
+    {
+        tb_free(waiter);
+        return tb_false;
+    }
+
+    // trace
+    tb_trace_d("post: %s, id: %u, waiters: %s", name, query->id, query->waiters? "more" : "one");
+
+    // wait it
+    waiter->func    = func;
+    waiter->priv    = priv;
+    waiter->next    = query->waiters;
+    query->waiters  = waiter;
+
+    // ok
+    return tb_true;
+}
+tb_long_t tb_dns_resolver_spak(tb_dns_resolver_ref_t self)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && resolver->sock && resolver->timer && resolver->ids, -1);
+
+    // retry the timed out queries
+    if (!tb_ltimer_spak(resolver->timer)) return -1;
+
+    // send requests
+    if (tb_dns_resolver_reqt(resolver) < 0) return -1;
+
+    // recv responses
+    if (tb_dns_resolver_resp(resolver) < 0) return -1;
+
+    // the pending queries count
+    return (tb_long_t)tb_hash_map_size(resolver->ids);
+}
+tb_long_t tb_dns_resolver_wait(tb_dns_resolver_ref_t self, tb_long_t timeout)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && resolver->sock && resolver->timer, -1);
+
+    // no pending queries? only wait the timeout
+    tb_size_t events = TB_SOCKET_EVENT_RECV;
+    if (tb_hash_map_size(resolver->ids))
+    {
+        // limit the timeout for the timer
+        tb_size_t delay = tb_ltimer_delay(resolver->timer);
+        if (timeout < 0 || (tb_size_t)timeout > delay) timeout = (tb_long_t)delay;
+
+        // wait the sending queries
+        if (tb_list_entry_size(&resolver->sends)) events |= TB_SOCKET_EVENT_SEND;
+    }
+
+    // wait it
+    return tb_socket_wait(resolver->sock, events, timeout);
+}
+tb_bool_t tb_dns_resolver_done(tb_dns_resolver_ref_t self, tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && name && addr, tb_false);
+
+    // init result
+    tb_dns_resolver_result_t result;
+    tb_memset(&result, 0, sizeof(result));
+    result.addr = addr;
+
+    // post it, it may be finished from cache
+    if (!tb_dns_resolver_post(self, name, tb_dns_resolver_done_func, &result)) return tb_false;
+
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+    /* we need follow the driver coroutine if be in coroutine
+     *
+     * this resolver and its followers are thread-local, so we pin it to the current scheduler
+     * to avoid being stolen by the other threads of the multi-threaded scheduler when it's waiting.
+     */
+    tb_co_scheduler_t*  scheduler = tb_null;
+    tb_bool_t           pinned = tb_false;
+    if (!result.state && tb_coroutine_self())
+    {
+        scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+        if (scheduler) pinned = tb_co_scheduler_pin(scheduler, tb_true);
+        result.semaphore = tb_co_semaphore_init(0);
+    }
+#endif
+
+    // wait it
+    while (!result.state)
+    {
+        /* drive all pending queries of this resolver
+         *
+         * only one coroutine can wait the socket, so the other coroutines will follow it,
+         * and it will be handed off to the next follower after the query of the driver has been finished.
+         */
+        if (!resolver->driving)
+        {
+            // spak and wait it
+            tb_long_t ok = 0;
+            resolver->driving = tb_true;
+            while (!result.state && (ok = tb_dns_resolver_spak(self)) > 0 && !result.state)
+            {
+                ok = tb_dns_resolver_wait(self, -1);
+                tb_check_break(ok >= 0);
+            }
+            resolver->driving = tb_false;
+
+            // failed? fail all pending queries and wake up all followers
+            if (ok < 0)
+            {
+                while (tb_hash_map_size(resolver->ids))
+                {
+                    tb_hash_map_item_ref_t item = (tb_hash_map_item_ref_t)tb_iterator_item(resolver->ids, tb_iterator_head(resolver->ids));
+                    tb_assert_and_check_break(item && item->data);
+                    tb_dns_resolver_query_done(resolver, (tb_dns_resolver_query_t*)item->data, tb_null);
+                }
+            }
+        }
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+        // follow the driver
+        else if (result.semaphore)
+        {
+            tb_list_entry_insert_tail(&resolver->followers, &result.entry);
+            tb_long_t ok = tb_co_semaphore_wait(result.semaphore, -1);
+            tb_list_entry_remove(&resolver->followers, &result.entry);
+            tb_assert_and_check_break(ok >= 0);
+        }
+#endif
+        // it's driving in the func of the other query? abort it
+        else break;
+    }
+
+    // aborted? cancel it
+    if (!result.state) tb_dns_resolver_post_cancel(resolver, name, &result);
+
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+    // hand off the driver to the next follower
+    if (!resolver->driving && tb_list_entry_size(&resolver->followers))
+    {
+        tb_dns_resolver_result_t* follower = (tb_dns_resolver_result_t*)tb_list_entry(&resolver->followers, tb_list_entry_head(&resolver->followers));
+        if (follower && follower->semaphore) tb_co_semaphore_post(follower->semaphore, 1);
+    }
+
+    // exit semaphore
+    if (result.semaphore) tb_co_semaphore_exit(result.semaphore);
+
+    // restore the pinned state
+    if (scheduler) tb_co_scheduler_pin(scheduler, pinned);
+#endif
+
+    // ok?
+    return result.state > 0;
+}
@@ -0,0 +1,150 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        resolver.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_DNS_RESOLVER_H
+#define TB_NETWORK_DNS_RESOLVER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the dns resolver type
+ *
+ * the resolver multiplexes all outstanding queries over one udp socket by the query id,
+ * the queries of the same host name will be coalesced to one query.
+ *
+ * each query will be timed out and retried across the dns servers,
+ * and the resolver is not thread-safe, please use one resolver for each thread.
+ */
+typedef __tb_typeref__(dns_resolver);
+
+/*! the dns resolver func type
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param addr      the address, tb_null if failed
+ * @param priv      the user private data
+ */
+typedef tb_void_t   (*tb_dns_resolver_func_t)(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_ref_t addr, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the resolver
+ *
+ * @return          the resolver
+ */
+tb_dns_resolver_ref_t   tb_dns_resolver_init(tb_noarg_t);
+
+/*! exit the resolver, all pending queries will be failed
+ *
+ * @param resolver  the resolver
+ */
+tb_void_t               tb_dns_resolver_exit(tb_dns_resolver_ref_t resolver);
+
+/*! get the resolver of the current thread, it will be exited when the thread exits
+ *
+ * the coroutines of the scheduler in this thread will share it.
+ *
+ * @return          the resolver
+ */
+tb_dns_resolver_ref_t   tb_dns_resolver_self(tb_noarg_t);
+
+/*! the pending queries count
+ *
+ * @param resolver  the resolver
+ *
+ * @return          the queries count
+ */
+tb_size_t               tb_dns_resolver_size(tb_dns_resolver_ref_t resolver);
+
+/*! post a query for looking ipv4 from the host name, non-block
+ *
+ * the func will be called in tb_dns_resolver_spak() after it has been finished,
+ * or it will be called immediately if the host name has been cached.
+ *
+ * @note please do not exit the resolver in the func
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param func      the done func
+ * @param priv      the user private data
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_dns_resolver_post(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_dns_resolver_func_t func, tb_cpointer_t priv);
+
+/*! spak the resolver, send the requests, dispatch the responses and retry the timed out queries
+ *
+ * @param resolver  the resolver
+ *
+ * @return          the pending queries count, failed: -1
+ */
+tb_long_t               tb_dns_resolver_spak(tb_dns_resolver_ref_t resolver);
+
+/*! wait the resolver
+ *
+ * the timeout will be limited by the timer tick if there are pending queries.
+ *
+ * @code
+    while (tb_dns_resolver_spak(resolver) > 0)
+    {
+        if (tb_dns_resolver_wait(resolver, -1) < 0) break;
+    }
+ * @endcode
+ *
+ * @param resolver  the resolver
+ * @param timeout   the timeout
+ *
+ * @return          > 0: has events, 0: timeout, -1: failed
+ */
+tb_long_t               tb_dns_resolver_wait(tb_dns_resolver_ref_t resolver, tb_long_t timeout);
+
+/*! lookup address from the host name, block
+ *
+ * try to look it from cache first, it will be waited in coroutine if be called in coroutine,
+ * and all coroutines of this scheduler will share the resolver socket.
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param addr      the address, only the ip will be set
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_dns_resolver_done(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_ref_t addr);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -75,6 +75,12 @@ typedef struct __tb_http_t
     // is opened?
     tb_bool_t           bopened;
 
+    // is the connection reused from the pool?
+    tb_bool_t           breused;
+
+    // the offset of the sock stream at the beginning of the content, no response: -1
+    tb_hong_t           content_offset;
+
     // the request data
     tb_string_t         request;
 
@@ -113,7 +119,25 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
         if (!tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SET_TIMEOUT, http->option.timeout)) break;
 
         // reset keep-alive and close socket first before connecting anthor host
-        if (host_changed && !tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false)) break;
+        if ((host_changed || http->option.pool) && !tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false)) break;
+
+        // get a warm connection from the pool first
+        http->breused = tb_false;
+        if (http->option.pool && host_new)
+        {
+            tb_socket_ref_t sock = tb_null;
+            tb_ssl_ref_t    ssl = tb_null;
+            if (tb_http_pool_get(http->option.pool, host_new, tb_url_port(&http->option.url), tb_url_ssl(&http->option.url), &sock, &ssl))
+            {
+                // attach it to the sock stream
+                if (!tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_ATTACH, sock, ssl))
+                {
+                    tb_http_pool_put(http->option.pool, host_new, tb_url_port(&http->option.url), tb_url_ssl(&http->option.url), sock, ssl);
+                    break;
+                }
+                http->breused = tb_true;
+            }
+        }
 
         // dump option
 #if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
@@ -121,10 +145,11 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
 #endif
 
         // trace
-        tb_trace_d("connect: ..");
+        tb_trace_d("connect: %s..", http->breused? "reuse " : "");
 
-        // clear status
-        tb_http_status_cler(&http->status, host_changed);
+        // clear status, the alived state of the pooled connection will be updated from the response
+        tb_http_status_cler(&http->status, host_changed || http->option.pool);
+        http->content_offset = -1;
 
         // open stream
         if (!tb_stream_open(http->stream)) break;
@@ -144,6 +169,77 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_method_is_idempotent(tb_size_t method)
+{
+    // the server may have done the request before closing the reused connection, so we only can re-send these methods
+    switch (method)
+    {
+    case TB_HTTP_METHOD_GET:
+    case TB_HTTP_METHOD_HEAD:
+    case TB_HTTP_METHOD_OPTIONS:
+    case TB_HTTP_METHOD_PUT:
+    case TB_HTTP_METHOD_DELETE:
+        return tb_true;
+    default:
+        return tb_false;
+    }
+}
+static tb_bool_t tb_http_content_is_read(tb_http_t* http)
+{
+    // check
+    tb_assert(http && http->sstream);
+
+    // no response?
+    tb_check_return_val(http->content_offset >= 0, tb_false);
+
+    // no content?
+    if (    http->option.method == TB_HTTP_METHOD_HEAD
+        ||  http->status.code == 204
+        ||  http->status.code == 304)
+        return tb_true;
+
+    // chunked? the last chunk has been read
+    if (http->status.bchunked)
+    {
+        tb_filter_ref_t filter = tb_null;
+        return (http->cstream && tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter) && filter && tb_filter_beof(filter))? tb_true : tb_false;
+    }
+
+    // all content has been read from the sock stream?
+    return (http->status.content_size >= 0 && (tb_hong_t)tb_stream_offset(http->sstream) == http->content_offset + http->status.content_size)? tb_true : tb_false;
+}
+static tb_bool_t tb_http_release(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->sstream, tb_false);
+
+    // the connection can be parked to the pool?
+    tb_bool_t park = tb_false;
+    if (http->option.pool)
+    {
+        // it's alived and we have read all content? keep it alive after closing stream
+        park = (http->status.balived && tb_http_content_is_read(http))? tb_true : tb_false;
+        if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, park)) return tb_false;
+    }
+
+    // close stream
+    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
+
+    // switch to sstream
+    http->stream = http->sstream;
+
+    // park the idle connection to the pool
+    if (park)
+    {
+        tb_socket_ref_t sock = tb_null;
+        tb_ssl_ref_t    ssl = tb_null;
+        if (tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_DETACH, &sock, &ssl))
+            tb_http_pool_put(http->option.pool, tb_url_host(&http->option.url), tb_url_port(&http->option.url), tb_url_ssl(&http->option.url), sock, ssl);
+    }
+
+    // ok
+    return tb_true;
+}
 static tb_bool_t tb_http_request_post(tb_size_t state, tb_hize_t offset, tb_hong_t size, tb_hize_t save, tb_size_t rate, tb_cpointer_t priv)
 {
     // check
@@ -197,8 +293,8 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         // init accept
         tb_hash_map_insert(http->head, "Accept", "*/*");
 
-        // init connection
-        tb_hash_map_insert(http->head, "Connection", http->status.balived? "keep-alive" : "close");
+        // init connection, keep it alive if we can park it to the pool
+        tb_hash_map_insert(http->head, "Connection", (http->status.balived || http->option.pool)? "keep-alive" : "close");
 
         // init cookies
         tb_bool_t cookie = tb_false;
@@ -417,6 +513,9 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
         tb_assert_and_check_return_val((*p - '0') < 2, tb_false);
         http->status.version = *p - '0';
 
+        // the connection of HTTP/1.1 is persistent by default, we can park it to the pool
+        if (http->option.pool) http->status.balived = http->status.version;
+
         // seek to the http code
         p++; while (tb_isspace(*p)) p++;
 
@@ -571,6 +670,9 @@ static tb_bool_t tb_http_response(tb_http_t* http)
             // end?
             if (!real)
             {
+                // save the offset of the content
+                http->content_offset = tb_stream_offset(http->sstream);
+
                 // switch to cstream if chunked
                 if (http->status.bchunked)
                 {
@@ -655,6 +757,39 @@ static tb_bool_t tb_http_response(tb_http_t* http)
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_done(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->stream, tb_false);
+
+    // done
+    tb_size_t tryn = 2;
+    while (tryn--)
+    {
+        // connect it
+        if (!tb_http_connect(http)) break;
+
+        // request and response it
+        if (tb_http_request(http) && tb_http_response(http)) return tb_true;
+
+        // the reused connection may have been closed by the server, try the idempotent request again using the other connection
+        tb_check_break(http->breused && !http->status.code && !tb_stream_is_killed(http->sstream));
+        tb_check_break(tb_http_method_is_idempotent(http->option.method));
+
+        // trace
+        tb_trace_d("done: the reused connection has been closed, try it again");
+
+        // close stream
+        if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false)) break;
+        if (http->stream && !tb_stream_clos(http->stream)) break;
+
+        // switch to sstream
+        http->stream = http->sstream;
+    }
+
+    // failed
+    return tb_false;
+}
 static tb_bool_t tb_http_redirect(tb_http_t* http)
 {
     // check
@@ -687,11 +822,8 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             tb_assert_pass_and_check_break(read == size);
         }
 
-        // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        // close stream and park the connection
+        if (!tb_http_release(http)) break;
 
         // get location url
         tb_char_t const* location = tb_string_cstr(&http->status.location);
@@ -716,14 +848,8 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             break;
         }
 
-        // connect it
-        if (!(ok = tb_http_connect(http))) break;
-
-        // request it
-        if (!(ok = tb_http_request(http))) break;
-
-        // response it
-        if (!(ok = tb_http_response(http))) break;
+        // connect, request and response it
+        if (!(ok = tb_http_done(http))) break;
     }
 
     // ok?
@@ -862,14 +988,8 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     tb_bool_t ok = tb_false;
     do
     {
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // connect, request and response it
+        if (!tb_http_done(http)) break;
 
         // redirect it
         if (!tb_http_redirect(http)) break;
@@ -880,14 +1000,7 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     } while (0);
 
     // failed? close it
-    if (!ok)
-    {
-        // close stream
-        if (http->stream) tb_stream_clos(http->stream);
-
-        // switch to sstream
-        http->stream = http->sstream;
-    }
+    if (!ok) tb_http_release(http);
 
     // is opened?
     http->bopened = ok;
@@ -904,11 +1017,8 @@ tb_bool_t tb_http_close(tb_http_ref_t self)
     // opened?
     tb_check_return_val(http->bopened, tb_true);
 
-    // close stream
-    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
-
-    // switch to sstream
-    http->stream = http->sstream;
+    // close stream and park the connection
+    if (!tb_http_release(http)) return tb_false;
 
     // clear opened
     http->bopened = tb_false;
@@ -933,10 +1043,7 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
     do
     {
         // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        if (!tb_http_release(http)) break;
 
         // trace
         tb_trace_d("seek: %llu", offset);
@@ -945,14 +1052,8 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
         http->option.range.bof = offset;
         http->option.range.eof = http->status.document_size > 0? http->status.document_size - 1 : 0;
 
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // connect, request and response it
+        if (!tb_http_done(http)) break;
 
         // ok
         ok = tb_true;
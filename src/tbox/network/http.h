@@ -26,6 +26,7 @@
  * includes
  */
 #include "cookies.h"
+#include "http_pool.h"
 #include "url.h"
 #include "../string/string.h"
 #include "../container/container.h"
@@ -150,6 +151,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_GET_POST_FUNC        = TB_HTTP_OPTION_CODE_GET(18)
 ,   TB_HTTP_OPTION_GET_POST_PRIV        = TB_HTTP_OPTION_CODE_GET(19)
 ,   TB_HTTP_OPTION_GET_POST_LRATE       = TB_HTTP_OPTION_CODE_GET(20)
+,   TB_HTTP_OPTION_GET_POOL             = TB_HTTP_OPTION_CODE_GET(21)
 
 ,   TB_HTTP_OPTION_SET_SSL              = TB_HTTP_OPTION_CODE_SET(1)
 ,   TB_HTTP_OPTION_SET_URL              = TB_HTTP_OPTION_CODE_SET(2)
@@ -171,6 +173,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_SET_POST_FUNC        = TB_HTTP_OPTION_CODE_SET(18)
 ,   TB_HTTP_OPTION_SET_POST_PRIV        = TB_HTTP_OPTION_CODE_SET(19)
 ,   TB_HTTP_OPTION_SET_POST_LRATE       = TB_HTTP_OPTION_CODE_SET(20)
+,   TB_HTTP_OPTION_SET_POOL             = TB_HTTP_OPTION_CODE_SET(21)
 
 }tb_http_option_e;
 
@@ -236,6 +239,9 @@ typedef struct __tb_http_option_t
     /// the cookies
     tb_cookies_ref_t    cookies;
 
+    /// the connection pool, the idle keep-alive connection will be parked to it and reused by the other http
+    tb_http_pool_ref_t  pool;
+
     /// the priv data
     tb_pointer_t        head_priv;
 
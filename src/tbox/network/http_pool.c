@@ -0,0 +1,551 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_pool.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "http_pool.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../container/container.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the connections grow
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_CONN_GROW           (16)
+#else
+#   define TB_HTTP_POOL_CONN_GROW           (64)
+#endif
+
+// the maximum closed connections count in one operation, the others will be closed next time
+#define TB_HTTP_POOL_CLOSE_MAXN             (16)
+
+// the key maxn, "scheme://host:port"
+#define TB_HTTP_POOL_KEY_MAXN               (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the http pool host type
+typedef struct __tb_http_pool_host_t
+{
+    // the idle connections of this host, the oldest connection is at the head
+    tb_list_entry_head_t    conns;
+
+    // the key
+    tb_char_t const*        key;
+
+}tb_http_pool_host_t, *tb_http_pool_host_ref_t;
+
+// the http pool connection type
+typedef struct __tb_http_pool_conn_t
+{
+    // the list entry of the host
+    tb_list_entry_t         entry;
+
+    // the list entry of all connections, the oldest connection is at the head
+    tb_list_entry_t         order;
+
+    // the host
+    tb_http_pool_host_ref_t host;
+
+    // the socket
+    tb_socket_ref_t         sock;
+
+    // the ssl
+    tb_ssl_ref_t            ssl;
+
+    // the parked time (ms)
+    tb_hong_t               time;
+
+}tb_http_pool_conn_t, *tb_http_pool_conn_ref_t;
+
+// the http pool type
+typedef struct __tb_http_pool_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the hosts, key: "scheme://host:port", value: the host
+    tb_hash_map_ref_t       hosts;
+
+    // the connections pool
+    tb_fixed_pool_ref_t     conns_pool;
+
+    // all idle connections
+    tb_list_entry_head_t    conns;
+
+    // the maximum idle connections count of each host
+    tb_size_t               host_maxn;
+
+    // the maximum idle connections count
+    tb_size_t               maxn;
+
+    // the idle timeout (ms)
+    tb_long_t               timeout;
+
+    // the stat
+    tb_http_pool_stat_t     stat;
+
+}tb_http_pool_t;
+
+// the closed connection type
+typedef struct __tb_http_pool_closed_t
+{
+    // the socket
+    tb_socket_ref_t         sock;
+
+    // the ssl
+    tb_ssl_ref_t            ssl;
+
+}tb_http_pool_closed_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_http_pool_host_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_http_pool_host_ref_t host = (tb_http_pool_host_ref_t)*((tb_pointer_t*)buff);
+    tb_assert_and_check_return(host);
+
+    // the connections have been removed
+    tb_assert(!tb_list_entry_size(&host->conns));
+
+    // exit it
+    tb_free(host);
+}
+static tb_size_t tb_http_pool_key(tb_char_t* key, tb_size_t maxn, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl)
+{
+    // make key
+    tb_long_t size = tb_snprintf(key, maxn, "%s://%s:%u", bssl? "https" : "http", host, port);
+    return (size > 0 && (tb_size_t)size < maxn)? (tb_size_t)size : 0;
+}
+static tb_void_t tb_http_pool_close(tb_socket_ref_t sock, tb_ssl_ref_t ssl)
+{
+#ifdef TB_SSL_ENABLE
+    // exit ssl, we need not send close_notify to the server
+    if (ssl) tb_ssl_exit(ssl);
+#else
+    tb_assert(!ssl);
+#endif
+
+    // exit socket
+    if (sock) tb_socket_exit(sock);
+}
+static tb_void_t tb_http_pool_close_all(tb_http_pool_closed_t* closed, tb_size_t count)
+{
+    // close the removed connections out of the lock
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+        tb_http_pool_close(closed[i].sock, closed[i].ssl);
+}
+static tb_void_t tb_http_pool_remove(tb_http_pool_t* pool, tb_http_pool_conn_ref_t conn, tb_http_pool_closed_t* closed)
+{
+    // check
+    tb_assert(pool && conn && conn->host);
+
+    // save the socket and ssl
+    if (closed)
+    {
+        closed->sock = conn->sock;
+        closed->ssl  = conn->ssl;
+    }
+
+    // remove it from the host and all connections
+    tb_http_pool_host_ref_t host = conn->host;
+    tb_list_entry_remove(&host->conns, &conn->entry);
+    tb_list_entry_remove(&pool->conns, &conn->order);
+
+    // remove this host if it has no connections
+    if (!tb_list_entry_size(&host->conns)) tb_hash_map_remove(pool->hosts, host->key);
+
+    // exit it
+    tb_fixed_pool_free(pool->conns_pool, conn);
+}
+static tb_size_t tb_http_pool_expire(tb_http_pool_t* pool, tb_hong_t now, tb_http_pool_closed_t* closed, tb_size_t maxn)
+{
+    // check
+    tb_assert(pool && closed);
+
+    // remove the expired connections from the oldest connection
+    tb_size_t count = 0;
+    while (count < maxn && tb_list_entry_size(&pool->conns))
+    {
+        // the oldest connection
+        tb_http_pool_conn_ref_t conn = (tb_http_pool_conn_ref_t)tb_list_entry(&pool->conns, tb_list_entry_head(&pool->conns));
+        tb_assert_and_check_break(conn);
+
+        // not expired? the others are newer
+        tb_check_break(now >= conn->time + pool->timeout);
+
+        // trace
+        tb_trace_d("expire: %s: sock: %p", conn->host->key, conn->sock);
+
+        // remove it
+        tb_http_pool_remove(pool, conn, &closed[count++]);
+        pool->stat.evict++;
+    }
+    return count;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * instance implementation
+ */
+static tb_handle_t tb_http_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    return (tb_handle_t)tb_http_pool_init(0, 0, 0);
+}
+static tb_void_t tb_http_pool_instance_exit(tb_handle_t pool, tb_cpointer_t priv)
+{
+    // dump it
+#ifdef __tb_debug__
+    tb_http_pool_dump((tb_http_pool_ref_t)pool);
+#endif
+
+    // exit it
+    tb_http_pool_exit((tb_http_pool_ref_t)pool);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface implementation
+ */
+tb_http_pool_ref_t tb_http_pool()
+{
+    return (tb_http_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_HTTP_POOL, tb_http_pool_instance_init, tb_http_pool_instance_exit, tb_null, tb_null);
+}
+tb_http_pool_ref_t tb_http_pool_init(tb_size_t host_maxn, tb_size_t maxn, tb_long_t timeout)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_http_pool_t* pool = tb_null;
+    do
+    {
+        // make pool
+        pool = tb_malloc0_type(tb_http_pool_t);
+        tb_assert_and_check_break(pool);
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+
+        // init hosts
+        pool->hosts = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_false), tb_element_ptr(tb_http_pool_host_free, tb_null));
+        tb_assert_and_check_break(pool->hosts);
+
+        // init connections pool
+        pool->conns_pool = tb_fixed_pool_init(tb_null, TB_HTTP_POOL_CONN_GROW, sizeof(tb_http_pool_conn_t), tb_null, tb_null, tb_null);
+        tb_assert_and_check_break(pool->conns_pool);
+
+        // init connections
+        tb_list_entry_init(&pool->conns, tb_http_pool_conn_t, order, tb_null);
+
+        // init limits
+        pool->host_maxn = host_maxn? host_maxn : TB_HTTP_POOL_HOST_MAXN;
+        pool->maxn      = maxn? maxn : TB_HTTP_POOL_MAXN;
+        pool->timeout   = timeout > 0? timeout : TB_HTTP_POOL_IDLE_TIMEOUT;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_http_pool_exit((tb_http_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_http_pool_ref_t)pool;
+}
+tb_void_t tb_http_pool_exit(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // close all connections
+    if (pool->hosts && pool->conns_pool) tb_http_pool_clear(self);
+
+    // exit hosts
+    if (pool->hosts) tb_hash_map_exit(pool->hosts);
+    pool->hosts = tb_null;
+
+    // exit connections pool
+    if (pool->conns_pool) tb_fixed_pool_exit(pool->conns_pool);
+    pool->conns_pool = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+tb_void_t tb_http_pool_clear(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // close all connections
+    tb_size_t               count = 0;
+    tb_http_pool_closed_t   closed[TB_HTTP_POOL_CLOSE_MAXN];
+    do
+    {
+        // remove some connections
+        tb_spinlock_enter(&pool->lock);
+        for (count = 0; count < tb_arrayn(closed) && tb_list_entry_size(&pool->conns); count++)
+            tb_http_pool_remove(pool, (tb_http_pool_conn_ref_t)tb_list_entry(&pool->conns, tb_list_entry_head(&pool->conns)), &closed[count]);
+        tb_spinlock_leave(&pool->lock);
+
+        // close them
+        tb_http_pool_close_all(closed, count);
+
+    } while (count);
+}
+tb_bool_t tb_http_pool_get(tb_http_pool_ref_t self, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t* psock, tb_ssl_ref_t* pssl)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return_val(pool && host && port && psock && pssl, tb_false);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    if (!tb_http_pool_key(key, sizeof(key), host, port, bssl)) return tb_false;
+
+    // done
+    tb_bool_t ok = tb_false;
+    tb_size_t stale = 0;
+    while (!ok)
+    {
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // remove the expired connections first
+        tb_http_pool_closed_t closed[TB_HTTP_POOL_CLOSE_MAXN];
+        tb_size_t             count = tb_http_pool_expire(pool, tb_mclock(), closed, tb_arrayn(closed));
+
+        // pop the newest connection of this host
+        tb_socket_ref_t         sock = tb_null;
+        tb_ssl_ref_t            ssl = tb_null;
+        tb_http_pool_host_ref_t phost = (tb_http_pool_host_ref_t)tb_hash_map_get(pool->hosts, key);
+        if (phost)
+        {
+            tb_http_pool_conn_ref_t conn = (tb_http_pool_conn_ref_t)tb_list_entry(&phost->conns, tb_list_entry_last(&phost->conns));
+            if (conn)
+            {
+                sock = conn->sock;
+                ssl  = conn->ssl;
+                tb_http_pool_remove(pool, conn, tb_null);
+            }
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+
+        // close the expired connections
+        tb_http_pool_close_all(closed, count);
+
+        // no idle connections?
+        tb_check_break(sock);
+
+        /* the idle connection must be not readable,
+         * otherwise it has been closed by the server or has the stale data
+         *
+         * we probe it after leaving the lock, because it may be yielded in coroutine
+         */
+        ok = !tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, 0);
+
+        // trace
+        tb_trace_d("get: %s: sock: %p: %s", key, sock, ok? "ok" : "stale");
+
+        // reuse it
+        if (ok)
+        {
+            *psock = sock;
+            *pssl  = ssl;
+        }
+        // close it and try the next connection
+        else
+        {
+            tb_http_pool_close(sock, ssl);
+            stale++;
+        }
+    }
+
+    // update the statistics
+    tb_spinlock_enter(&pool->lock);
+    if (ok) pool->stat.hit++;
+    else pool->stat.miss++;
+    pool->stat.stale += stale;
+    tb_spinlock_leave(&pool->lock);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_http_pool_put(tb_http_pool_ref_t self, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t sock, tb_ssl_ref_t ssl)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return_val(pool && host && port && sock, tb_false);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    if (!tb_http_pool_key(key, sizeof(key), host, port, bssl))
+    {
+        tb_http_pool_close(sock, ssl);
+        return tb_false;
+    }
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // remove the expired connections first, keep one slot for the evicted connection
+    tb_hong_t             now = tb_mclock();
+    tb_http_pool_closed_t closed[TB_HTTP_POOL_CLOSE_MAXN];
+    tb_size_t             count = tb_http_pool_expire(pool, now, closed, tb_arrayn(closed) - 1);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // this host is full? evict the oldest connection of this host
+        tb_http_pool_host_ref_t phost = (tb_http_pool_host_ref_t)tb_hash_map_get(pool->hosts, key);
+        if (phost && tb_list_entry_size(&phost->conns) >= pool->host_maxn)
+        {
+            tb_http_pool_conn_ref_t conn = (tb_http_pool_conn_ref_t)tb_list_entry(&phost->conns, tb_list_entry_head(&phost->conns));
+            if (tb_list_entry_size(&phost->conns) == 1) phost = tb_null;
+            tb_http_pool_remove(pool, conn, &closed[count++]);
+            pool->stat.evict++;
+        }
+        // the pool is full? evict the oldest connection of all hosts
+        else if (tb_list_entry_size(&pool->conns) >= pool->maxn)
+        {
+            tb_http_pool_conn_ref_t conn = (tb_http_pool_conn_ref_t)tb_list_entry(&pool->conns, tb_list_entry_head(&pool->conns));
+            if (conn->host == phost && tb_list_entry_size(&phost->conns) == 1) phost = tb_null;
+            tb_http_pool_remove(pool, conn, &closed[count++]);
+            pool->stat.evict++;
+        }
+
+        // make the host
+        if (!phost)
+        {
+            // make host with the key
+            tb_size_t size = tb_strlen(key);
+            phost = (tb_http_pool_host_ref_t)tb_malloc0(sizeof(tb_http_pool_host_t) + size + 1);
+            tb_assert_and_check_break(phost);
+
+            // init key
+            tb_char_t* phost_key = (tb_char_t*)(phost + 1);
+            tb_memcpy(phost_key, key, size + 1);
+            phost->key = phost_key;
+
+            // init connections
+            tb_list_entry_init(&phost->conns, tb_http_pool_conn_t, entry, tb_null);
+
+            // insert it
+            if (!tb_hash_map_insert(pool->hosts, key, phost))
+            {
+                tb_free(phost);
+                break;
+            }
+        }
+
+        // make connection
+        tb_http_pool_conn_ref_t conn = (tb_http_pool_conn_ref_t)tb_fixed_pool_malloc0(pool->conns_pool);
+        tb_assert_and_check_break(conn);
+
+        // init connection
+        conn->host = phost;
+        conn->sock = sock;
+        conn->ssl  = ssl;
+        conn->time = now;
+
+        // park it as the newest connection
+        tb_list_entry_insert_tail(&phost->conns, &conn->entry);
+        tb_list_entry_insert_tail(&pool->conns, &conn->order);
+        pool->stat.park++;
+
+        // trace
+        tb_trace_d("put: %s: sock: %p", key, sock);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // failed? close it
+    if (!ok) tb_http_pool_close(sock, ssl);
+
+    // close the expired and evicted connections
+    tb_http_pool_close_all(closed, count);
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_http_pool_stat(tb_http_pool_ref_t self, tb_http_pool_stat_ref_t stat)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool && stat);
+
+    // get stat
+    tb_spinlock_enter(&pool->lock);
+    *stat       = pool->stat;
+    stat->size  = tb_list_entry_size(&pool->conns);
+    stat->hosts = tb_hash_map_size(pool->hosts);
+    tb_spinlock_leave(&pool->lock);
+}
+#ifdef __tb_debug__
+tb_void_t tb_http_pool_dump(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // get stat
+    tb_http_pool_stat_t stat;
+    tb_http_pool_stat(self, &stat);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("http_pool: size: %lu, hosts: %lu", stat.size, stat.hosts);
+    tb_trace_i("http_pool: hit: %llu, miss: %llu, park: %llu, stale: %llu, evict: %llu", stat.hit, stat.miss, stat.park, stat.stale, stat.evict);
+}
+#endif
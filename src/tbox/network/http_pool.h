@@ -0,0 +1,179 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_pool.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_HTTP_POOL_H
+#define TB_NETWORK_HTTP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "ssl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default maximum idle connections count of each host
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_HOST_MAXN           (4)
+#else
+#   define TB_HTTP_POOL_HOST_MAXN           (8)
+#endif
+
+// the default maximum idle connections count
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_MAXN                (64)
+#else
+#   define TB_HTTP_POOL_MAXN                (512)
+#endif
+
+// the default idle timeout (ms)
+#define TB_HTTP_POOL_IDLE_TIMEOUT           (15000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the http pool stat type
+typedef struct __tb_http_pool_stat_t
+{
+    /// the idle connections count
+    tb_size_t               size;
+
+    /// the hosts count
+    tb_size_t               hosts;
+
+    /// the reused count
+    tb_hize_t               hit;
+
+    /// the miss count, no idle connection for this host
+    tb_hize_t               miss;
+
+    /// the parked count
+    tb_hize_t               park;
+
+    /// the stale count, the idle connection has been closed by the server
+    tb_hize_t               stale;
+
+    /// the evicted count, includes the expired connections
+    tb_hize_t               evict;
+
+}tb_http_pool_stat_t, *tb_http_pool_stat_ref_t;
+
+/// the http pool ref type
+typedef __tb_typeref__(http_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the http pool instance
+ *
+ * the idle keep-alive connections of all http are parked to it by default
+ *
+ * @return          the http pool
+ */
+tb_http_pool_ref_t  tb_http_pool(tb_noarg_t);
+
+/*! init the http pool
+ *
+ * the idle connections are keyed by "scheme://host:port",
+ * the oldest connection will be evicted if there are too many idle connections.
+ *
+ * @param host_maxn the maximum idle connections count of each host, uses the default value if be zero
+ * @param maxn      the maximum idle connections count, uses the default value if be zero
+ * @param timeout   the idle timeout (ms), uses the default value if be zero
+ *
+ * @return          the http pool
+ */
+tb_http_pool_ref_t  tb_http_pool_init(tb_size_t host_maxn, tb_size_t maxn, tb_long_t timeout);
+
+/*! exit the http pool and close all idle connections
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_exit(tb_http_pool_ref_t pool);
+
+/*! close all idle connections
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_clear(tb_http_pool_ref_t pool);
+
+/*! get a warm idle connection of the given host
+ *
+ * the newest connection will be reused first,
+ * and the connection which has been closed by the server or has the stale data will be discarded.
+ *
+ * @param pool      the http pool
+ * @param host      the host
+ * @param port      the port
+ * @param bssl      is ssl?
+ * @param psock     the socket
+ * @param pssl      the ssl of the socket, it will be null if not ssl
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_http_pool_get(tb_http_pool_ref_t pool, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t* psock, tb_ssl_ref_t* pssl);
+
+/*! park an idle connection of the given host
+ *
+ * the connection is owned by the pool after calling it,
+ * it will be closed immediately if the pool has been full.
+ *
+ * @param pool      the http pool
+ * @param host      the host
+ * @param port      the port
+ * @param bssl      is ssl?
+ * @param sock      the connected socket
+ * @param ssl       the opened ssl of the socket, it must be null if not ssl
+ *
+ * @return          tb_true if it has been parked, otherwise it has been closed
+ */
+tb_bool_t           tb_http_pool_put(tb_http_pool_ref_t pool, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl, tb_socket_ref_t sock, tb_ssl_ref_t ssl);
+
+/*! get the pool stat
+ *
+ * @param pool      the http pool
+ * @param stat      the stat
+ */
+tb_void_t           tb_http_pool_stat(tb_http_pool_ref_t pool, tb_http_pool_stat_ref_t stat);
+
+#ifdef __tb_debug__
+/*! dump the http pool
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_dump(tb_http_pool_ref_t pool);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,259 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        packet.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "dns_packet"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "packet.h"
+#include "../../../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_dns_packet_make_query(tb_byte_t* data, tb_size_t maxn, tb_uint16_t id, tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(data && name, 0);
+
+    // the header, name and question must be able to be stored
+    tb_size_t n = tb_strlen(name);
+    tb_assert_and_check_return_val(n && n < TB_DNS_NAME_MAXN && TB_DNS_HEADER_SIZE + n + 6 <= maxn, 0);
+
+    // init stream
+    tb_static_stream_t stream;
+    tb_static_stream_init(&stream, data, maxn);
+
+    // identification number
+    tb_static_stream_writ_u16_be(&stream, id);
+
+    /* 0x2104: 0 0000 001 0000 0000
+     *
+     * tb_uint16_t qr     :1;       // query/response flag
+     * tb_uint16_t opcode :4;       // purpose of message
+     * tb_uint16_t aa     :1;       // authoritive answer
+     * tb_uint16_t tc     :1;       // truncated message
+     * tb_uint16_t rd     :1;       // recursion desired
+
+     * tb_uint16_t ra     :1;       // recursion available
+     * tb_uint16_t z      :1;       // its z! reserved
+     * tb_uint16_t ad     :1;       // authenticated data
+     * tb_uint16_t cd     :1;       // checking disabled
+     * tb_uint16_t rcode  :4;       // response code
+     *
+     * this is a query
+     * this is a standard query
+     * not authoritive answer
+     * not truncated
+     * recursion desired
+     *
+     * recursion not available! hey we dont have it (lol)
+     *
+     */
+    tb_static_stream_writ_u16_be(&stream, 0x0100);
+
+    /* we have only one question
+     *
+     * tb_uint16_t question;        // number of question entries
+     * tb_uint16_t answer;          // number of answer entries
+     * tb_uint16_t authority;       // number of authority entries
+     * tb_uint16_t resource;        // number of resource entries
+     *
+     */
+    tb_static_stream_writ_u16_be(&stream, 1);
+    tb_static_stream_writ_u16_be(&stream, 0);
+    tb_static_stream_writ_u16_be(&stream, 0);
+    tb_static_stream_writ_u16_be(&stream, 0);
+
+    // set questions, see as tb_dns_question_t
+    // name + question1 + question2 + ...
+    tb_static_stream_writ_u8(&stream, '.');
+    tb_byte_t* p = (tb_byte_t*)tb_static_stream_writ_cstr(&stream, name);
+
+    // only one question now.
+    tb_static_stream_writ_u16_be(&stream, 1);      // we are requesting the ipv4 address
+    tb_static_stream_writ_u16_be(&stream, 1);      // it's internet (lol)
+
+    // encode dns name
+    if (!p || !tb_dns_encode_name((tb_char_t*)p - 1)) return 0;
+
+    // ok
+    return tb_static_stream_offset(&stream);
+}
+tb_bool_t tb_dns_packet_parse_answer(tb_byte_t const* data, tb_size_t size, tb_uint16_t id, tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t* pttl, tb_size_t* prcode)
+{
+    // check
+    tb_assert_and_check_return_val(data && size >= TB_DNS_HEADER_SIZE, tb_false);
+
+    // init stream
+    tb_static_stream_t stream;
+    tb_static_stream_init(&stream, (tb_byte_t*)data, size);
+
+    // init header
+    tb_dns_header_t header;
+    header.id           = tb_static_stream_read_u16_be(&stream);
+    header.rcode        = tb_static_stream_read_u16_be(&stream) & 0xf;
+    header.question     = tb_static_stream_read_u16_be(&stream);
+    header.answer       = tb_static_stream_read_u16_be(&stream);
+    header.authority    = tb_static_stream_read_u16_be(&stream);
+    header.resource     = tb_static_stream_read_u16_be(&stream);
+
+    // trace
+    tb_trace_d("response: size: %u",        size);
+    tb_trace_d("response: id: 0x%04x",      header.id);
+    tb_trace_d("response: rcode: %d",       header.rcode);
+    tb_trace_d("response: question: %d",    header.question);
+    tb_trace_d("response: answer: %d",      header.answer);
+    tb_trace_d("response: authority: %d",   header.authority);
+    tb_trace_d("response: resource: %d",    header.resource);
+    tb_trace_d("");
+
+    // check header
+    tb_check_return_val(header.id == id, tb_false);
+
+    // skip questions, only one question now.
+    // name + question1 + question2 + ...
+    tb_check_return_val(header.question == 1, tb_false);
+    if (name)
+    {
+        // it's the response of the other query with the same id? ignore it
+        tb_char_t qname[TB_DNS_NAME_MAXN];
+        if (!tb_dns_decode_name(&stream, qname) || tb_stricmp(qname, name)) return tb_false;
+    }
+    else tb_static_stream_skip_cstr(&stream);
+    tb_static_stream_skip(&stream, 4);
+
+    // save the response code
+    if (prcode) *prcode = header.rcode;
+
+    // decode answers
+    tb_size_t   i = 0;
+    tb_size_t   found = 0;
+    tb_uint32_t ttl = 0;
+    for (i = 0; i < header.answer; i++)
+    {
+        // decode answer
+        tb_dns_answer_t answer;
+        tb_trace_d("response: answer: %d", i);
+
+        // decode dns name
+        tb_char_t const* aname = tb_dns_decode_name(&stream, answer.name); tb_used(aname);
+        tb_trace_d("response: name: %s", aname);
+
+        // decode resource
+        answer.res.type     = tb_static_stream_read_u16_be(&stream);
+        answer.res.class_   = tb_static_stream_read_u16_be(&stream);
+        answer.res.ttl      = tb_static_stream_read_u32_be(&stream);
+        answer.res.size     = tb_static_stream_read_u16_be(&stream);
+        tb_trace_d("response: type: %d",    answer.res.type);
+        tb_trace_d("response: class: %d",   answer.res.class_);
+        tb_trace_d("response: ttl: %d",     answer.res.ttl);
+        tb_trace_d("response: size: %d",    answer.res.size);
+
+        // the minimum ttl of the alias chain and ipv4
+        if (!ttl || answer.res.ttl < ttl) ttl = answer.res.ttl;
+
+        // is ipv4?
+        if (answer.res.type == 1)
+        {
+            // get ipv4
+            tb_byte_t b1 = tb_static_stream_read_u8(&stream);
+            tb_byte_t b2 = tb_static_stream_read_u8(&stream);
+            tb_byte_t b3 = tb_static_stream_read_u8(&stream);
+            tb_byte_t b4 = tb_static_stream_read_u8(&stream);
+
+            // trace
+            tb_trace_d("response: ipv4: %u.%u.%u.%u", b1, b2, b3, b4);
+
+            // save it
+            if (addr)
+            {
+                // init ipv4
+                tb_ipv4_t ipv4;
+                ipv4.u8[0] = b1;
+                ipv4.u8[1] = b2;
+                ipv4.u8[2] = b3;
+                ipv4.u8[3] = b4;
+
+                // save ipv4
+                tb_ipaddr_ipv4_set(addr, &ipv4);
+            }
+
+            // found the first ip
+            found = 1;
+            break;
+        }
+        else
+        {
+            // decode rdata
+            answer.rdata = (tb_byte_t*)tb_dns_decode_name(&stream, answer.name);
+
+            // trace
+            tb_trace_d("response: alias: %s", answer.rdata? (tb_char_t const*)answer.rdata : "");
+        }
+    }
+
+    // the host does not exist? get the negative ttl from the soa record of the authorities
+    if (!found && header.rcode == TB_DNS_RCODE_NXDOMAIN)
+    {
+        for (i = 0; i < header.authority; i++)
+        {
+            // decode name
+            tb_dns_answer_t answer;
+            tb_dns_decode_name(&stream, answer.name);
+
+            // decode resource
+            answer.res.type     = tb_static_stream_read_u16_be(&stream);
+            answer.res.class_   = tb_static_stream_read_u16_be(&stream);
+            answer.res.ttl      = tb_static_stream_read_u32_be(&stream);
+            answer.res.size     = tb_static_stream_read_u16_be(&stream);
+
+            // is soa? mname + rname + serial + refresh + retry + expire + minimum
+            if (answer.res.type == 6)
+            {
+                tb_dns_decode_name(&stream, answer.name);
+                tb_dns_decode_name(&stream, answer.name);
+                tb_static_stream_skip(&stream, 16);
+                tb_uint32_t minimum = tb_static_stream_read_u32_be(&stream);
+
+                // the negative ttl
+                if (pttl) *pttl = tb_min(answer.res.ttl, minimum);
+                tb_trace_d("response: nxdomain, ttl: %u", tb_min(answer.res.ttl, minimum));
+                break;
+            }
+            else tb_static_stream_skip(&stream, answer.res.size);
+        }
+    }
+
+    // found it?
+    tb_check_return_val(found, tb_false);
+
+    // save ttl
+    if (pttl) *pttl = ttl;
+
+    // ok
+    return tb_true;
+}
@@ -0,0 +1,71 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        packet.h
+ *
+ */
+#ifndef TB_NETWORK_IMPL_DNS_PACKET_H
+#define TB_NETWORK_IMPL_DNS_PACKET_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* make the query packet for looking ipv4 from the host name
+ *
+ * @param data          the packet data
+ * @param maxn          the packet maxn
+ * @param id            the query id
+ * @param name          the host name
+ *
+ * @return              the packet size, failed: 0
+ */
+tb_size_t               tb_dns_packet_make_query(tb_byte_t* data, tb_size_t maxn, tb_uint16_t id, tb_char_t const* name);
+
+/* parse the first ipv4 address from the response packet
+ *
+ * the ttl is the minimum ttl of the answers if ok,
+ * or the negative ttl of the soa record if the host does not exist.
+ *
+ * @param data          the packet data
+ * @param size          the packet size
+ * @param id            the query id
+ * @param name          the queried host name for checking the question, optional
+ * @param addr          the address, optional
+ * @param pttl          the ttl, optional
+ * @param prcode        the response code, optional
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_dns_packet_parse_answer(tb_byte_t const* data, tb_size_t size, tb_uint16_t id, tb_char_t const* name, tb_ipaddr_ref_t addr, tb_uint32_t* pttl, tb_size_t* prcode);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -45,6 +45,7 @@ tb_bool_t tb_http_option_init(tb_http_option_t* option)
     option->version    = 1; // HTTP/1.1
     option->bunzip     = 0;
     option->cookies    = tb_null;
+    option->pool       = tb_http_pool();
 
     // init url
     if (!tb_url_init(&option->url)) return tb_false;
@@ -74,6 +75,9 @@ tb_void_t tb_http_option_exit(tb_http_option_t* option)
 
     // clear cookies
     option->cookies = tb_null;
+
+    // clear pool
+    option->pool = tb_null;
 }
 tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_list_t args)
 {
@@ -412,6 +416,24 @@ tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_li
             return tb_true;
         }
         break;
+    case TB_HTTP_OPTION_SET_POOL:
+        {
+            // set pool
+            option->pool = (tb_http_pool_ref_t)tb_va_arg(args, tb_http_pool_ref_t);
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_GET_POOL:
+        {
+            // ppool
+            tb_http_pool_ref_t* ppool = (tb_http_pool_ref_t*)tb_va_arg(args, tb_http_pool_ref_t*);
+            tb_assert_and_check_return_val(ppool, tb_false);
+
+            // get pool
+            *ppool = option->pool;
+            return tb_true;
+        }
+        break;
     case TB_HTTP_OPTION_SET_POST_URL:
         {
             // url
@@ -620,6 +642,7 @@ tb_void_t tb_http_option_dump(tb_http_option_t* option)
     tb_trace_i("option: redirect: %d",          option->redirect);
     tb_trace_i("option: range: %llu-%llu",      option->range.bof, option->range.eof);
     tb_trace_i("option: bunzip: %s",            option->bunzip? "true" : "false");
+    tb_trace_i("option: pool: %p",              option->pool);
 
     // dump head
     tb_char_t const*    head_data = (tb_char_t const*)tb_buffer_data(&option->head_data);
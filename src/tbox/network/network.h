@@ -35,6 +35,7 @@
 #include "hwaddr.h"
 #include "http.h"
 #include "cookies.h"
+#include "http_pool.h"
 #include "dns/dns.h"
 
 #endif
@@ -20,6 +20,7 @@
  *
  */
 
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * trace
  */
@@ -30,26 +31,196 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../algorithm/algorithm.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the grow of the items in the arena
+#define TB_OC_ARRAY_ITEMS_GROW      (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the array items type in the arena
+typedef struct __tb_oc_array_items_t
+{
+    // the iterator, it must be the first member
+    tb_iterator_t       itor;
+
+    // the arena
+    tb_oc_arena_ref_t   arena;
+
+    // the items data
+    tb_object_ref_t*    data;
+
+    // the items size
+    tb_size_t           size;
+
+    // the items maxn
+    tb_size_t           maxn;
+
+}tb_oc_array_items_t;
+
 // the array type
 typedef struct __tb_oc_array_t
 {
     // the object base
-    tb_object_t         base;
+    tb_object_t             base;
+
+    // the vector, it is null if the array is placed in the arena
+    tb_vector_ref_t         vector;
 
-    // the vector
-    tb_vector_ref_t     vector;
+    // the items in the arena
+    tb_oc_array_items_t*    items;
 
     // is increase refn?
-    tb_bool_t           incr;
+    tb_bool_t               incr;
 
 }tb_oc_array_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * items implementation
+ */
+static tb_size_t tb_oc_array_items_itor_size(tb_iterator_ref_t iterator)
+{
+    return ((tb_oc_array_items_t*)iterator)->size;
+}
+static tb_size_t tb_oc_array_items_itor_head(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_oc_array_items_itor_last(tb_iterator_ref_t iterator)
+{
+    // last
+    tb_size_t size = ((tb_oc_array_items_t*)iterator)->size;
+    return size? size - 1 : 0;
+}
+static tb_size_t tb_oc_array_items_itor_tail(tb_iterator_ref_t iterator)
+{
+    return ((tb_oc_array_items_t*)iterator)->size;
+}
+static tb_size_t tb_oc_array_items_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)iterator;
+    tb_assert_and_check_return_val(itor < items->size, items->size);
+
+    // next
+    return itor + 1;
+}
+static tb_size_t tb_oc_array_items_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)iterator;
+    tb_assert_and_check_return_val(itor && itor <= items->size, 0);
+
+    // prev
+    return itor - 1;
+}
+static tb_pointer_t tb_oc_array_items_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)iterator;
+    tb_assert_and_check_return_val(itor < items->size, tb_null);
+
+    // item
+    return (tb_pointer_t)items->data[itor];
+}
+static tb_void_t tb_oc_array_items_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)iterator;
+    tb_assert_and_check_return(itor < items->size && item && tb_oc_arena_holdable(items->arena, (tb_object_ref_t)item));
+
+    // copy
+    items->data[itor] = (tb_object_ref_t)item;
+}
+static tb_long_t tb_oc_array_items_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    return ((tb_size_t)litem > (tb_size_t)ritem) - ((tb_size_t)litem < (tb_size_t)ritem);
+}
+static tb_void_t tb_oc_array_items_nremove(tb_oc_array_items_t* items, tb_size_t index, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(index <= items->size && size <= items->size - index);
+
+    // remove them, the objects will be freed with the arena
+    if (index + size < items->size) tb_memmov_(items->data + index, items->data + index + size, (items->size - index - size) * sizeof(tb_object_ref_t));
+    items->size -= size;
+}
+static tb_void_t tb_oc_array_items_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    tb_oc_array_items_nremove((tb_oc_array_items_t*)iterator, itor, 1);
+}
+static tb_void_t tb_oc_array_items_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)iterator;
+
+    // remove the items
+    if (size) tb_oc_array_items_nremove(items, prev != items->size? prev + 1 : 0, size);
+}
+static tb_oc_array_items_t* tb_oc_array_items_init(tb_oc_arena_ref_t arena)
+{
+    // make items
+    tb_oc_array_items_t* items = (tb_oc_array_items_t*)tb_oc_arena_malloc0(arena, sizeof(tb_oc_array_items_t));
+    tb_assert_and_check_return_val(items, tb_null);
+
+    // init operation
+    static tb_iterator_op_t op =
+    {
+        tb_oc_array_items_itor_size
+    ,   tb_oc_array_items_itor_head
+    ,   tb_oc_array_items_itor_last
+    ,   tb_oc_array_items_itor_tail
+    ,   tb_oc_array_items_itor_prev
+    ,   tb_oc_array_items_itor_next
+    ,   tb_oc_array_items_itor_item
+    ,   tb_oc_array_items_itor_comp
+    ,   tb_oc_array_items_itor_copy
+    ,   tb_oc_array_items_itor_remove
+    ,   tb_oc_array_items_itor_nremove
+    };
+
+    // init iterator
+    items->itor.step    = sizeof(tb_object_ref_t);
+    items->itor.mode    = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_RACCESS | TB_ITERATOR_MODE_MUTABLE;
+    items->itor.op      = &op;
+    items->arena        = arena;
+
+    // ok
+    return items;
+}
+static tb_bool_t tb_oc_array_items_insert(tb_oc_array_items_t* items, tb_size_t index, tb_object_ref_t item)
+{
+    // check
+    tb_assert_and_check_return_val(index <= items->size, tb_false);
+
+    // the arena container only can hold the objects of the same tree
+    tb_assert_and_check_return_val(tb_oc_arena_holdable(items->arena, item), tb_false);
+
+    // grow data, the old data will be freed with the arena
+    if (items->size == items->maxn)
+    {
+        tb_size_t maxn = items->maxn? (items->maxn << 1) : TB_OC_ARRAY_ITEMS_GROW;
+        items->data = (tb_object_ref_t*)tb_oc_arena_ralloc(items->arena, items->data, items->maxn * sizeof(tb_object_ref_t), maxn * sizeof(tb_object_ref_t));
+        tb_assert_and_check_return_val(items->data, tb_false);
+        items->maxn = maxn;
+    }
+
+    // insert it
+    if (index < items->size) tb_memmov_(items->data + index + 1, items->data + index, (items->size - index) * sizeof(tb_object_ref_t));
+    items->data[index] = item;
+    items->size++;
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -65,7 +236,25 @@ static tb_object_ref_t tb_oc_array_copy(tb_object_ref_t object)
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, tb_null);
+    tb_assert_and_check_return_val(array && (array->vector || array->items), tb_null);
+
+    // in the arena? copy the items one by one
+    if (array->items)
+    {
+        // init copy
+        tb_object_ref_t copy = tb_oc_array_init(0, array->incr);
+        tb_assert_and_check_return_val(copy, tb_null);
+
+        // copy items and the copy will hold the references of them
+        tb_for_all (tb_object_ref_t, item, (tb_iterator_ref_t)array->items)
+        {
+            if (!array->incr) tb_object_retain(item);
+            tb_oc_array_append(copy, item);
+        }
+
+        // ok
+        return copy;
+    }
 
     // init copy
     tb_oc_array_t* copy = (tb_oc_array_t*)tb_oc_array_init(tb_vector_grow(array->vector), array->incr);
@@ -99,10 +288,12 @@ static tb_void_t tb_oc_array_exit(tb_object_ref_t object)
 static tb_void_t tb_oc_array_clear(tb_object_ref_t object)
 {
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return(array && array->vector);
+    tb_assert_and_check_return(array && (array->vector || array->items));
 
+    // clear items
+    if (array->items) array->items->size = 0;
     // clear vector
-    tb_vector_clear(array->vector);
+    else tb_vector_clear(array->vector);
 }
 static tb_oc_array_t* tb_oc_array_init_base()
 {
@@ -111,13 +302,10 @@ static tb_oc_array_t* tb_oc_array_init_base()
     tb_oc_array_t*  array = tb_null;
     do
     {
-        // make array
-        array = tb_malloc0_type(tb_oc_array_t);
+        // make array, it will be placed in the arena if we are reading an arena tree
+        array = (tb_oc_array_t*)tb_oc_arena_object_init(sizeof(tb_oc_array_t), TB_OBJECT_TYPE_ARRAY);
         tb_assert_and_check_break(array);
 
-        // init array
-        if (!tb_object_init((tb_object_ref_t)array, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_ARRAY)) break;
-
         // init base
         array->base.copy    = tb_oc_array_copy;
         array->base.exit    = tb_oc_array_exit;
@@ -154,12 +342,23 @@ tb_object_ref_t tb_oc_array_init(tb_size_t grow, tb_bool_t incr)
         array = tb_oc_array_init_base();
         tb_assert_and_check_break(array);
 
-        // init element
-        tb_element_t element = tb_element_obj();
-
-        // init vector
-        array->vector = tb_vector_init(grow, element);
-        tb_assert_and_check_break(array->vector);
+        // in the arena? the items will be placed in it too
+        tb_oc_arena_ref_t arena = tb_oc_arena_from_object((tb_object_ref_t)array);
+        if (arena)
+        {
+            // init items
+            array->items = tb_oc_array_items_init(arena);
+            tb_assert_and_check_break(array->items);
+        }
+        else
+        {
+            // init element
+            tb_element_t element = tb_element_obj();
+
+            // init vector
+            array->vector = tb_vector_init(grow, element);
+            tb_assert_and_check_break(array->vector);
+        }
 
         // init incr
         array->incr = incr;
@@ -173,7 +372,7 @@ tb_object_ref_t tb_oc_array_init(tb_size_t grow, tb_bool_t incr)
     if (!ok)
     {
         // exit it
-        if (array) tb_oc_array_exit((tb_object_ref_t)array);
+        if (array) tb_object_exit((tb_object_ref_t)array);
         array = tb_null;
     }
 
@@ -184,19 +383,19 @@ tb_size_t tb_oc_array_size(tb_object_ref_t object)
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, 0);
+    tb_assert_and_check_return_val(array && (array->vector || array->items), 0);
 
     // size
-    return tb_vector_size(array->vector);
+    return array->items? array->items->size : tb_vector_size(array->vector);
 }
 tb_object_ref_t tb_oc_array_item(tb_object_ref_t object, tb_size_t index)
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return_val(array && array->vector, tb_null);
+    tb_assert_and_check_return_val(array && (array->vector || array->items), tb_null);
 
     // item
-    return (tb_object_ref_t)tb_iterator_item(array->vector, index);
+    return array->items? (index < array->items->size? array->items->data[index] : tb_null) : (tb_object_ref_t)tb_iterator_item(array->vector, index);
 }
 tb_iterator_ref_t tb_oc_array_itor(tb_object_ref_t object)
 {
@@ -205,25 +404,27 @@ tb_iterator_ref_t tb_oc_array_itor(tb_object_ref_t object)
     tb_assert_and_check_return_val(array, tb_null);
 
     // iterator
-    return (tb_iterator_ref_t)array->vector;
+    return array->items? (tb_iterator_ref_t)array->items : (tb_iterator_ref_t)array->vector;
 }
 tb_void_t tb_oc_array_remove(tb_object_ref_t object, tb_size_t index)
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return(array && array->vector);
+    tb_assert_and_check_return(array && (array->vector || array->items));
 
     // remove
-    tb_vector_remove(array->vector, index);
+    if (array->items) tb_oc_array_items_nremove(array->items, index, 1);
+    else tb_vector_remove(array->vector, index);
 }
 tb_void_t tb_oc_array_append(tb_object_ref_t object, tb_object_ref_t item)
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && (array->vector || array->items) && item);
 
     // insert
-    tb_vector_insert_tail(array->vector, item);
+    if (array->items) tb_oc_array_items_insert(array->items, array->items->size, item);
+    else tb_vector_insert_tail(array->vector, item);
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -232,10 +433,11 @@ tb_void_t tb_oc_array_insert(tb_object_ref_t object, tb_size_t index, tb_object_
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && (array->vector || array->items) && item);
 
     // insert
-    tb_vector_insert_prev(array->vector, index, item);
+    if (array->items) tb_oc_array_items_insert(array->items, index, item);
+    else tb_vector_insert_prev(array->vector, index, item);
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -244,10 +446,11 @@ tb_void_t tb_oc_array_replace(tb_object_ref_t object, tb_size_t index, tb_object
 {
     // check
     tb_oc_array_t* array = tb_oc_array_cast(object);
-    tb_assert_and_check_return(array && array->vector && item);
+    tb_assert_and_check_return(array && (array->vector || array->items) && item);
 
     // replace
-    tb_vector_replace(array->vector, index, item);
+    if (array->items) tb_oc_array_items_itor_copy((tb_iterator_ref_t)array->items, index, item);
+    else tb_vector_replace(array->vector, index, item);
 
     // refn--
     if (!array->incr) tb_object_exit(item);
@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +77,12 @@ static tb_void_t tb_oc_data_clear(tb_object_ref_t object)
     tb_oc_data_t* data = tb_oc_data_cast(object);
     if (data) tb_buffer_clear(&data->buffer);
 }
+static tb_bool_t tb_oc_data_need(tb_oc_data_t* data, tb_size_t size)
+{
+    // in the arena? the data need be placed in it too
+    tb_oc_arena_ref_t arena = tb_oc_arena_from_object((tb_object_ref_t)data);
+    return arena? tb_oc_arena_buffer_need(arena, &data->buffer, size) : tb_true;
+}
 static tb_oc_data_t* tb_oc_data_init_base()
 {
     // done
@@ -83,13 +90,10 @@ static tb_oc_data_t* tb_oc_data_init_base()
     tb_oc_data_t*   data = tb_null;
     do
     {
-        // make data
-        data = tb_malloc0_type(tb_oc_data_t);
+        // make data, it will be placed in the arena if we are reading an arena tree
+        data = (tb_oc_data_t*)tb_oc_arena_object_init(sizeof(tb_oc_data_t), TB_OBJECT_TYPE_DATA);
         tb_assert_and_check_break(data);
 
-        // init data
-        if (!tb_object_init((tb_object_ref_t)data, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATA)) break;
-
         // init base
         data->base.copy     = tb_oc_data_copy;
         data->base.exit     = tb_oc_data_exit;
@@ -156,12 +160,20 @@ tb_object_ref_t tb_oc_data_init_from_data(tb_pointer_t addr, tb_size_t size)
     // init buffer
     if (!tb_buffer_init(&data->buffer))
     {
-        tb_oc_data_exit((tb_object_ref_t)data);
+        tb_object_exit((tb_object_ref_t)data);
         return tb_null;
     }
 
     // copy data
-    if (addr && size) tb_buffer_memncpy(&data->buffer, (tb_byte_t const*)addr, size);
+    if (addr && size)
+    {
+        if (!tb_oc_data_need(data, size))
+        {
+            tb_object_exit((tb_object_ref_t)data);
+            return tb_null;
+        }
+        tb_buffer_memncpy(&data->buffer, (tb_byte_t const*)addr, size);
+    }
 
     // ok
     return (tb_object_ref_t)data;
@@ -175,12 +187,20 @@ tb_object_ref_t tb_oc_data_init_from_buffer(tb_buffer_ref_t pbuf)
     // init buffer
     if (!tb_buffer_init(&data->buffer))
     {
-        tb_oc_data_exit((tb_object_ref_t)data);
+        tb_object_exit((tb_object_ref_t)data);
         return tb_null;
     }
 
     // copy data
-    if (pbuf) tb_buffer_memcpy(&data->buffer, pbuf);
+    if (pbuf)
+    {
+        if (!tb_oc_data_need(data, tb_buffer_size(pbuf)))
+        {
+            tb_object_exit((tb_object_ref_t)data);
+            return tb_null;
+        }
+        tb_buffer_memcpy(&data->buffer, pbuf);
+    }
 
     // ok
     return (tb_object_ref_t)data;
@@ -201,6 +221,7 @@ tb_bool_t tb_oc_data_setp(tb_object_ref_t object, tb_pointer_t addr, tb_size_t s
     tb_assert_and_check_return_val(data && addr, tb_false);
 
     // data
+    if (!tb_oc_data_need(data, size)) return tb_false;
     tb_buffer_memncpy(&data->buffer, (tb_byte_t const*)addr, size);
 
     // ok
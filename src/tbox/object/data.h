@@ -88,6 +88,8 @@ tb_bool_t           tb_oc_data_setp(tb_object_ref_t data, tb_pointer_t addr, tb_
 tb_size_t           tb_oc_data_size(tb_object_ref_t data);
 
 /*! the data buffer
+ *
+ * @note the buffer of the data object read by tb_object_read_arena() can not be resized
  *
  * @param data      the data object
  *
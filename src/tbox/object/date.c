@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -78,13 +79,10 @@ static tb_oc_date_t* tb_oc_date_init_base()
     tb_oc_date_t*   date = tb_null;
     do
     {
-        // make date
-        date = tb_malloc0_type(tb_oc_date_t);
+        // make date, it will be placed in the arena if we are reading an arena tree
+        date = (tb_oc_date_t*)tb_oc_arena_object_init(sizeof(tb_oc_date_t), TB_OBJECT_TYPE_DATE);
         tb_assert_and_check_break(date);
 
-        // init date
-        if (!tb_object_init((tb_object_ref_t)date, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATE)) break;
-
         // init base
         date->base.copy     = tb_oc_date_copy;
         date->base.exit     = tb_oc_date_exit;
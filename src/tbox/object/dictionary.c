@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../string/string.h"
 #include "../algorithm/algorithm.h"
 
@@ -42,27 +43,279 @@
 #   define TB_OC_DICTIONARY_SIZE_DEFAULT           TB_OC_DICTIONARY_SIZE_SMALL
 #endif
 
+// the grow of the items in the arena
+#define TB_OC_DICTIONARY_ITEMS_GROW             (8)
+
+// the items in the arena will be indexed by the hash slots if the items size is larger than it
+#define TB_OC_DICTIONARY_ITEMS_INDEX_MINN       (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+/* the dictionary items type in the arena
+ *
+ * the items are stored in the insertion order and indexed by the open addressing slots
+ */
+typedef struct __tb_oc_dictionary_items_t
+{
+    // the iterator, it must be the first member
+    tb_iterator_t               itor;
+
+    // the arena
+    tb_oc_arena_ref_t           arena;
+
+    // the items data
+    tb_oc_dictionary_item_t*    data;
+
+    // the items size
+    tb_size_t                   size;
+
+    // the items maxn
+    tb_size_t                   maxn;
+
+    // the hash slots, the slot is the item index + 1 and zero is empty
+    tb_uint32_t*                slots;
+
+    // the hash slots mask, it's zero if there are no slots
+    tb_size_t                   mask;
+
+}tb_oc_dictionary_items_t;
+
 // the dictionary type
 typedef struct __tb_oc_dictionary_t
 {
     // the object base
-    tb_object_t         base;
+    tb_object_t                 base;
 
     // the capacity size
-    tb_size_t           size;
+    tb_size_t                   size;
+
+    // the object hash, it is null if the dictionary is placed in the arena
+    tb_hash_map_ref_t           hash;
 
-    // the object hash
-    tb_hash_map_ref_t   hash;
+    // the items in the arena
+    tb_oc_dictionary_items_t*   items;
 
     // increase refn?
-    tb_bool_t           incr;
+    tb_bool_t                   incr;
 
 }tb_oc_dictionary_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * items implementation
+ */
+static tb_size_t tb_oc_dictionary_items_itor_size(tb_iterator_ref_t iterator)
+{
+    return ((tb_oc_dictionary_items_t*)iterator)->size;
+}
+static tb_size_t tb_oc_dictionary_items_itor_head(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_oc_dictionary_items_itor_last(tb_iterator_ref_t iterator)
+{
+    // last
+    tb_size_t size = ((tb_oc_dictionary_items_t*)iterator)->size;
+    return size? size - 1 : 0;
+}
+static tb_size_t tb_oc_dictionary_items_itor_tail(tb_iterator_ref_t iterator)
+{
+    return ((tb_oc_dictionary_items_t*)iterator)->size;
+}
+static tb_size_t tb_oc_dictionary_items_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)iterator;
+    tb_assert_and_check_return_val(itor < items->size, items->size);
+
+    // next
+    return itor + 1;
+}
+static tb_size_t tb_oc_dictionary_items_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)iterator;
+    tb_assert_and_check_return_val(itor && itor <= items->size, 0);
+
+    // prev
+    return itor - 1;
+}
+static tb_pointer_t tb_oc_dictionary_items_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)iterator;
+    tb_assert_and_check_return_val(itor < items->size, tb_null);
+
+    // item
+    return (tb_pointer_t)&items->data[itor];
+}
+static tb_void_t tb_oc_dictionary_items_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)iterator;
+    tb_assert_and_check_return(itor < items->size && item && tb_oc_arena_holdable(items->arena, (tb_object_ref_t)item));
+
+    // copy the value
+    items->data[itor].val = (tb_object_ref_t)item;
+}
+static tb_long_t tb_oc_dictionary_items_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert(litem && ritem);
+
+    // compare the keys
+    return tb_strcmp(((tb_oc_dictionary_item_t const*)litem)->key, ((tb_oc_dictionary_item_t const*)ritem)->key);
+}
+static __tb_inline__ tb_size_t tb_oc_dictionary_items_hash(tb_char_t const* key)
+{
+    // the fnv-1a hash
+    tb_uint32_t hash = 2166136261u;
+    while (*key) hash = (hash ^ (tb_byte_t)*key++) * 16777619u;
+    return (tb_size_t)hash;
+}
+static tb_bool_t tb_oc_dictionary_items_index(tb_oc_dictionary_items_t* items, tb_size_t maxn)
+{
+    // make slots, the old slots will be freed with the arena
+    tb_size_t mask = tb_align_pow2(maxn) - 1;
+    items->slots = (tb_uint32_t*)tb_oc_arena_malloc0(items->arena, (mask + 1) * sizeof(tb_uint32_t));
+    tb_assert_and_check_return_val(items->slots, tb_false);
+    items->mask = mask;
+
+    // index all items
+    tb_size_t i = 0;
+    for (i = 0; i < items->size; i++)
+    {
+        tb_size_t slot = tb_oc_dictionary_items_hash(items->data[i].key) & mask;
+        while (items->slots[slot]) slot = (slot + 1) & mask;
+        items->slots[slot] = (tb_uint32_t)(i + 1);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_long_t tb_oc_dictionary_items_find(tb_oc_dictionary_items_t* items, tb_char_t const* key, tb_size_t* pslot)
+{
+    // no slots? find it directly
+    if (!items->slots)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < items->size; i++)
+        {
+            if (!tb_strcmp(items->data[i].key, key)) return (tb_long_t)i;
+        }
+        return -1;
+    }
+
+    // find it from the slots
+    tb_size_t mask = items->mask;
+    tb_size_t slot = tb_oc_dictionary_items_hash(key) & mask;
+    tb_size_t index;
+    while ((index = items->slots[slot]))
+    {
+        if (!tb_strcmp(items->data[index - 1].key, key)) return (tb_long_t)index - 1;
+        slot = (slot + 1) & mask;
+    }
+
+    // save the empty slot
+    if (pslot) *pslot = slot;
+    return -1;
+}
+static tb_bool_t tb_oc_dictionary_items_insert(tb_oc_dictionary_items_t* items, tb_char_t const* key, tb_object_ref_t val)
+{
+    // the arena container only can hold the objects of the same tree
+    tb_assert_and_check_return_val(tb_oc_arena_holdable(items->arena, val), tb_false);
+
+    // exists? replace it
+    tb_size_t slot = 0;
+    tb_long_t index = tb_oc_dictionary_items_find(items, key, &slot);
+    if (index >= 0)
+    {
+        items->data[index].val = val;
+        return tb_true;
+    }
+
+    // grow data, the old data will be freed with the arena
+    if (items->size == items->maxn)
+    {
+        tb_size_t maxn = items->maxn? (items->maxn << 1) : TB_OC_DICTIONARY_ITEMS_GROW;
+        items->data = (tb_oc_dictionary_item_t*)tb_oc_arena_ralloc(items->arena, items->data, items->maxn * sizeof(tb_oc_dictionary_item_t), maxn * sizeof(tb_oc_dictionary_item_t));
+        tb_assert_and_check_return_val(items->data, tb_false);
+        items->maxn = maxn;
+    }
+
+    // append it
+    tb_oc_dictionary_item_t* item = &items->data[items->size];
+    item->key = tb_oc_arena_strdup(items->arena, key);
+    item->val = val;
+    tb_assert_and_check_return_val(item->key, tb_false);
+    items->size++;
+
+    // index it, we keep the load factor of the slots less than one half
+    if (items->slots && (items->size << 1) <= items->mask + 1)
+        items->slots[slot] = (tb_uint32_t)items->size;
+    else if (items->size > TB_OC_DICTIONARY_ITEMS_INDEX_MINN)
+        return tb_oc_dictionary_items_index(items, items->size << 2);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_oc_dictionary_items_nremove(tb_oc_dictionary_items_t* items, tb_size_t index, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(index <= items->size && size <= items->size - index);
+
+    // remove them, the objects will be freed with the arena
+    if (index + size < items->size) tb_memmov_(items->data + index, items->data + index + size, (items->size - index - size) * sizeof(tb_oc_dictionary_item_t));
+    items->size -= size;
+
+    // reindex the left items
+    if (items->slots) tb_oc_dictionary_items_index(items, items->mask + 1);
+}
+static tb_void_t tb_oc_dictionary_items_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    tb_oc_dictionary_items_nremove((tb_oc_dictionary_items_t*)iterator, itor, 1);
+}
+static tb_void_t tb_oc_dictionary_items_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)iterator;
+
+    // remove the items
+    if (size) tb_oc_dictionary_items_nremove(items, prev != items->size? prev + 1 : 0, size);
+}
+static tb_oc_dictionary_items_t* tb_oc_dictionary_items_init(tb_oc_arena_ref_t arena)
+{
+    // make items
+    tb_oc_dictionary_items_t* items = (tb_oc_dictionary_items_t*)tb_oc_arena_malloc0(arena, sizeof(tb_oc_dictionary_items_t));
+    tb_assert_and_check_return_val(items, tb_null);
+
+    // init operation
+    static tb_iterator_op_t op =
+    {
+        tb_oc_dictionary_items_itor_size
+    ,   tb_oc_dictionary_items_itor_head
+    ,   tb_oc_dictionary_items_itor_last
+    ,   tb_oc_dictionary_items_itor_tail
+    ,   tb_oc_dictionary_items_itor_prev
+    ,   tb_oc_dictionary_items_itor_next
+    ,   tb_oc_dictionary_items_itor_item
+    ,   tb_oc_dictionary_items_itor_comp
+    ,   tb_oc_dictionary_items_itor_copy
+    ,   tb_oc_dictionary_items_itor_remove
+    ,   tb_oc_dictionary_items_itor_nremove
+    };
+
+    // init iterator
+    items->itor.step    = sizeof(tb_oc_dictionary_item_t);
+    items->itor.mode    = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_MUTABLE;
+    items->itor.op      = &op;
+    items->arena        = arena;
+
+    // ok
+    return items;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -119,7 +372,8 @@ static tb_void_t tb_oc_dictionary_clear(tb_object_ref_t object)
     tb_assert_and_check_return(dictionary);
 
     // clear
-    if (dictionary->hash) tb_hash_map_clear(dictionary->hash);
+    if (dictionary->items) tb_oc_dictionary_items_nremove(dictionary->items, 0, dictionary->items->size);
+    else if (dictionary->hash) tb_hash_map_clear(dictionary->hash);
 }
 static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
 {
@@ -128,13 +382,10 @@ static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
     tb_oc_dictionary_t* dictionary = tb_null;
     do
     {
-        // make dictionary
-        dictionary = tb_malloc0_type(tb_oc_dictionary_t);
+        // make dictionary, it will be placed in the arena if we are reading an arena tree
+        dictionary = (tb_oc_dictionary_t*)tb_oc_arena_object_init(sizeof(tb_oc_dictionary_t), TB_OBJECT_TYPE_DICTIONARY);
         tb_assert_and_check_break(dictionary);
 
-        // init dictionary
-        if (!tb_object_init((tb_object_ref_t)dictionary, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DICTIONARY)) break;
-
         // init base
         dictionary->base.copy   = tb_oc_dictionary_copy;
         dictionary->base.exit   = tb_oc_dictionary_exit;
@@ -178,9 +429,20 @@ tb_object_ref_t tb_oc_dictionary_init(tb_size_t size, tb_bool_t incr)
         dictionary->size = size;
         dictionary->incr = incr;
 
-        // init hash
-        dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
-        tb_assert_and_check_break(dictionary->hash);
+        // in the arena? the items will be placed in it too
+        tb_oc_arena_ref_t arena = tb_oc_arena_from_object((tb_object_ref_t)dictionary);
+        if (arena)
+        {
+            // init items
+            dictionary->items = tb_oc_dictionary_items_init(arena);
+            tb_assert_and_check_break(dictionary->items);
+        }
+        else
+        {
+            // init hash
+            dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
+            tb_assert_and_check_break(dictionary->hash);
+        }
 
         // ok
         ok = tb_true;
@@ -191,7 +453,7 @@ tb_object_ref_t tb_oc_dictionary_init(tb_size_t size, tb_bool_t incr)
     if (!ok)
     {
         // exit it
-        if (dictionary) tb_oc_dictionary_exit((tb_object_ref_t)dictionary);
+        if (dictionary) tb_object_exit((tb_object_ref_t)dictionary);
         dictionary = tb_null;
     }
 
@@ -202,10 +464,10 @@ tb_size_t tb_oc_dictionary_size(tb_object_ref_t object)
 {
     // check
     tb_oc_dictionary_t* dictionary = tb_oc_dictionary_cast(object);
-    tb_assert_and_check_return_val(dictionary && dictionary->hash, 0);
+    tb_assert_and_check_return_val(dictionary && (dictionary->hash || dictionary->items), 0);
 
     // size
-    return tb_hash_map_size(dictionary->hash);
+    return dictionary->items? dictionary->items->size : tb_hash_map_size(dictionary->hash);
 }
 tb_iterator_ref_t tb_oc_dictionary_itor(tb_object_ref_t object)
 {
@@ -213,13 +475,20 @@ tb_iterator_ref_t tb_oc_dictionary_itor(tb_object_ref_t object)
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // iterator
-    return (tb_iterator_ref_t)dictionary->hash;
+    return dictionary->items? (tb_iterator_ref_t)dictionary->items : (tb_iterator_ref_t)dictionary->hash;
 }
 tb_object_ref_t tb_oc_dictionary_value(tb_object_ref_t object, tb_char_t const* key)
 {
     // check
     tb_oc_dictionary_t* dictionary = tb_oc_dictionary_cast(object);
-    tb_assert_and_check_return_val(dictionary && dictionary->hash && key, tb_null);
+    tb_assert_and_check_return_val(dictionary && (dictionary->hash || dictionary->items) && key, tb_null);
+
+    // in the arena?
+    if (dictionary->items)
+    {
+        tb_long_t index = tb_oc_dictionary_items_find(dictionary->items, key, tb_null);
+        return index >= 0? dictionary->items->data[index].val : tb_null;
+    }
 
     // value
     return (tb_object_ref_t)tb_hash_map_get(dictionary->hash, key);
@@ -228,7 +497,15 @@ tb_void_t tb_oc_dictionary_remove(tb_object_ref_t object, tb_char_t const* key)
 {
     // check
     tb_oc_dictionary_t* dictionary = tb_oc_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary && dictionary->hash && key);
+    tb_assert_and_check_return(dictionary && (dictionary->hash || dictionary->items) && key);
+
+    // in the arena?
+    if (dictionary->items)
+    {
+        tb_long_t index = tb_oc_dictionary_items_find(dictionary->items, key, tb_null);
+        if (index >= 0) tb_oc_dictionary_items_nremove(dictionary->items, index, 1);
+        return ;
+    }
 
     // del
     return tb_hash_map_remove(dictionary->hash, key);
@@ -237,10 +514,11 @@ tb_void_t tb_oc_dictionary_insert(tb_object_ref_t object, tb_char_t const* key,
 {
     // check
     tb_oc_dictionary_t* dictionary = tb_oc_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary && dictionary->hash && key && val);
+    tb_assert_and_check_return(dictionary && (dictionary->hash || dictionary->items) && key && val);
 
     // add
-    tb_hash_map_insert(dictionary->hash, key, val);
+    if (dictionary->items) tb_oc_dictionary_items_insert(dictionary->items, key, val);
+    else tb_hash_map_insert(dictionary->hash, key, val);
 
     // refn--
     if (!dictionary->incr) tb_object_exit(val);
@@ -0,0 +1,369 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "oc_arena"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+#include "../../platform/thread_local.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the first chunk size and the maximum chunk size
+#ifdef __tb_small__
+#   define TB_OC_ARENA_CHUNK_SIZE           (4096)
+#   define TB_OC_ARENA_CHUNK_MAXN           (65536)
+#else
+#   define TB_OC_ARENA_CHUNK_SIZE           (16384)
+#   define TB_OC_ARENA_CHUNK_MAXN           (1 << 20)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena chunk type
+typedef struct __tb_oc_arena_chunk_t
+{
+    // the next chunk
+    struct __tb_oc_arena_chunk_t*   next;
+
+    // the padding for aligning the chunk data
+    tb_size_t                       padding;
+
+}tb_oc_arena_chunk_t;
+
+// the arena type
+typedef struct __tb_oc_arena_t
+{
+    // the reference count of the whole tree
+    tb_size_t                       refn;
+
+    // is building the tree? the objects will not be released until it's finished
+    tb_bool_t                       building;
+
+    // the free data head of the current chunk
+    tb_byte_t*                      head;
+
+    // the free data tail of the current chunk
+    tb_byte_t*                      tail;
+
+    // the next chunk size
+    tb_size_t                       chunk_size;
+
+    // the chunks
+    tb_oc_arena_chunk_t*            chunks;
+
+}tb_oc_arena_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the arena of the current thread
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_oc_arena_t*   g_arena_self = tb_null;
+#else
+static tb_thread_local_t                    g_arena_self = TB_THREAD_LOCAL_INIT;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t tb_oc_arena_malloc_chunk(tb_oc_arena_t* arena, tb_size_t size)
+{
+    // the chunk size
+    tb_size_t chunk_size = arena->chunk_size;
+
+    // too large? make a dedicated chunk for it and keep the current chunk
+    tb_bool_t dedicated = size > (chunk_size >> 2);
+    if (dedicated) chunk_size = size;
+
+    // make chunk
+    tb_oc_arena_chunk_t* chunk = (tb_oc_arena_chunk_t*)tb_malloc(sizeof(tb_oc_arena_chunk_t) + chunk_size);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // the chunk data
+    tb_byte_t* data = (tb_byte_t*)(chunk + 1);
+
+    // dedicated? insert it after the current chunk
+    if (dedicated && arena->chunks)
+    {
+        chunk->next = arena->chunks->next;
+        arena->chunks->next = chunk;
+        return data;
+    }
+
+    // insert it to the head
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+
+    // update the free data
+    arena->head = data + size;
+    arena->tail = data + chunk_size;
+
+    // grow the next chunk size
+    if (arena->chunk_size < TB_OC_ARENA_CHUNK_MAXN) arena->chunk_size <<= 1;
+
+    // ok
+    return data;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_oc_arena_ref_t tb_oc_arena_init()
+{
+    // make arena
+    tb_oc_arena_t* arena = tb_malloc0_type(tb_oc_arena_t);
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // init arena
+    arena->refn         = 1;
+    arena->chunk_size   = TB_OC_ARENA_CHUNK_SIZE;
+
+    // ok
+    return (tb_oc_arena_ref_t)arena;
+}
+tb_void_t tb_oc_arena_exit(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena);
+
+    // exit chunks
+    tb_oc_arena_chunk_t* chunk = arena->chunks;
+    while (chunk)
+    {
+        tb_oc_arena_chunk_t* next = chunk->next;
+        tb_free(chunk);
+        chunk = next;
+    }
+
+    // exit it
+    tb_free(arena);
+}
+tb_oc_arena_ref_t tb_oc_arena_enter(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // the previous arena
+    tb_oc_arena_ref_t prev = tb_oc_arena_current();
+
+    // start to build the tree
+    arena->building = tb_true;
+
+    // save the current arena
+#ifdef __tb_thread_local__
+    g_arena_self = arena;
+#else
+    if (!tb_thread_local_init(&g_arena_self, tb_null)) return prev;
+    tb_thread_local_set(&g_arena_self, arena);
+#endif
+
+    // ok
+    return prev;
+}
+tb_void_t tb_oc_arena_leave(tb_oc_arena_ref_t self, tb_oc_arena_ref_t prev)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena);
+
+    // the tree has been built
+    arena->building = tb_false;
+
+    // restore the previous arena
+#ifdef __tb_thread_local__
+    g_arena_self = (tb_oc_arena_t*)prev;
+#else
+    tb_thread_local_set(&g_arena_self, prev);
+#endif
+}
+tb_oc_arena_ref_t tb_oc_arena_current()
+{
+#ifdef __tb_thread_local__
+    return (tb_oc_arena_ref_t)g_arena_self;
+#else
+    return (tb_oc_arena_ref_t)tb_thread_local_get(&g_arena_self);
+#endif
+}
+tb_pointer_t tb_oc_arena_malloc(tb_oc_arena_ref_t self, tb_size_t size)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // align size
+    size = tb_align8(size? size : 1);
+
+    // enough in the current chunk? bump it
+    if (size <= (tb_size_t)(arena->tail - arena->head))
+    {
+        tb_pointer_t data = arena->head;
+        arena->head += size;
+        return data;
+    }
+
+    // make data from the new chunk
+    return tb_oc_arena_malloc_chunk(arena, size);
+}
+tb_pointer_t tb_oc_arena_malloc0(tb_oc_arena_ref_t arena, tb_size_t size)
+{
+    // malloc it
+    tb_pointer_t data = tb_oc_arena_malloc(arena, size);
+    tb_assert_and_check_return_val(data, tb_null);
+
+    // clear it
+    tb_memset_(data, 0, size);
+
+    // ok
+    return data;
+}
+tb_pointer_t tb_oc_arena_ralloc(tb_oc_arena_ref_t self, tb_pointer_t data, tb_size_t osize, tb_size_t nsize)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return_val(arena && osize <= nsize, tb_null);
+
+    // the last data of the current chunk? grow it in place
+    tb_size_t oalign = tb_align8(osize? osize : 1);
+    tb_size_t nalign = tb_align8(nsize? nsize : 1);
+    if (data && (tb_byte_t*)data + oalign == arena->head && nalign - oalign <= (tb_size_t)(arena->tail - arena->head))
+    {
+        arena->head += nalign - oalign;
+        return data;
+    }
+
+    // make the new data
+    tb_pointer_t ndata = tb_oc_arena_malloc(self, nsize);
+    tb_assert_and_check_return_val(ndata, tb_null);
+
+    // copy the old data
+    if (data && osize) tb_memcpy_(ndata, data, osize);
+
+    // ok
+    return ndata;
+}
+tb_char_t* tb_oc_arena_strdup(tb_oc_arena_ref_t arena, tb_char_t const* cstr)
+{
+    // check
+    tb_assert_and_check_return_val(arena && cstr, tb_null);
+
+    // make it
+    tb_size_t   size = tb_strlen(cstr);
+    tb_char_t*  data = (tb_char_t*)tb_oc_arena_malloc(arena, size + 1);
+    tb_assert_and_check_return_val(data, tb_null);
+
+    // copy it
+    tb_memcpy_(data, cstr, size + 1);
+
+    // ok
+    return data;
+}
+tb_bool_t tb_oc_arena_buffer_need(tb_oc_arena_ref_t arena, tb_buffer_ref_t buffer, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(arena && buffer, tb_false);
+
+    // enough?
+    tb_check_return_val(maxn > buffer->maxn, tb_true);
+
+    // grow data
+    tb_byte_t* data = (tb_byte_t*)tb_oc_arena_malloc(arena, maxn);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // copy the old data
+    if (buffer->size) tb_memcpy_(data, buffer->data, buffer->size);
+
+    // update the buffer
+    buffer->data = data;
+    buffer->maxn = maxn;
+
+    // ok
+    return tb_true;
+}
+tb_object_ref_t tb_oc_arena_object_init(tb_size_t size, tb_size_t type)
+{
+    // the current arena
+    tb_oc_arena_ref_t arena = tb_oc_arena_current();
+
+    // make object
+    tb_object_ref_t object = (tb_object_ref_t)(arena? tb_oc_arena_malloc0(arena, size) : tb_malloc0(size));
+    tb_assert_and_check_return_val(object, tb_null);
+
+    // init object
+    if (!tb_object_init(object, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, type))
+    {
+        if (!arena) tb_free(object);
+        return tb_null;
+    }
+
+    // share the reference count of the arena
+    if (arena) object->refn = (tb_size_t)arena;
+
+    // ok
+    return object;
+}
+tb_void_t tb_oc_arena_retain(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena);
+
+    // the objects are owned by the tree when building it
+    tb_check_return(!arena->building);
+
+    // refn++
+    arena->refn++;
+}
+tb_void_t tb_oc_arena_release(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return(arena && arena->refn);
+
+    // the objects are owned by the tree when building it
+    tb_check_return(!arena->building);
+
+    // refn--, free the whole tree if it's the last one
+    if (!--arena->refn) tb_oc_arena_exit(self);
+}
+tb_size_t tb_oc_arena_refn(tb_oc_arena_ref_t self)
+{
+    // check
+    tb_oc_arena_t* arena = (tb_oc_arena_t*)self;
+    tb_assert_and_check_return_val(arena, 0);
+
+    // the reference count
+    return arena->refn;
+}
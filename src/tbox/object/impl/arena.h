@@ -0,0 +1,210 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_ARENA_H
+#define TB_OBJECT_IMPL_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the object arena ref type
+ *
+ * all objects of an arena tree are bump-allocated from the chunks of the arena,
+ * they share the reference count of the arena and are freed together when it becomes zero.
+ *
+ * <pre>
+ *
+ * chunks: |next|object|object|string|items|...|  ->  |next|object|keys|...|     |  -> ...
+ *                                                                           |
+ *                                                                          head
+ * </pre>
+ */
+typedef __tb_typeref__(oc_arena);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the arena
+ *
+ * @return          the arena, the reference count is one
+ */
+tb_oc_arena_ref_t   tb_oc_arena_init(tb_noarg_t);
+
+/* exit the arena and free all chunks
+ *
+ * @param arena     the arena
+ */
+tb_void_t           tb_oc_arena_exit(tb_oc_arena_ref_t arena);
+
+/* enter the arena, all objects created on the current thread will be placed in it
+ *
+ * @param arena     the arena
+ *
+ * @return          the previous arena of the current thread, pass it to tb_oc_arena_leave()
+ */
+tb_oc_arena_ref_t   tb_oc_arena_enter(tb_oc_arena_ref_t arena);
+
+/* leave the arena and restore the previous arena
+ *
+ * @param arena     the arena
+ * @param prev      the previous arena
+ */
+tb_void_t           tb_oc_arena_leave(tb_oc_arena_ref_t arena, tb_oc_arena_ref_t prev);
+
+/* the arena of the current thread
+ *
+ * @return          the arena, tb_null if we are not building an arena tree
+ */
+tb_oc_arena_ref_t   tb_oc_arena_current(tb_noarg_t);
+
+/* malloc data from the arena, it will be aligned by eight bytes
+ *
+ * @param arena     the arena
+ * @param size      the data size
+ *
+ * @return          the data
+ */
+tb_pointer_t        tb_oc_arena_malloc(tb_oc_arena_ref_t arena, tb_size_t size);
+
+/* malloc zeroed data from the arena
+ *
+ * @param arena     the arena
+ * @param size      the data size
+ *
+ * @return          the data
+ */
+tb_pointer_t        tb_oc_arena_malloc0(tb_oc_arena_ref_t arena, tb_size_t size);
+
+/* grow the data of the arena, the old data will not be freed until the arena is exited
+ *
+ * @param arena     the arena
+ * @param data      the old data, maybe null
+ * @param osize     the old data size
+ * @param nsize     the new data size
+ *
+ * @return          the new data
+ */
+tb_pointer_t        tb_oc_arena_ralloc(tb_oc_arena_ref_t arena, tb_pointer_t data, tb_size_t osize, tb_size_t nsize);
+
+/* duplicate the cstring to the arena
+ *
+ * @param arena     the arena
+ * @param cstr      the cstring
+ *
+ * @return          the new cstring
+ */
+tb_char_t*          tb_oc_arena_strdup(tb_oc_arena_ref_t arena, tb_char_t const* cstr);
+
+/* ensure the buffer has the given space, the grown data will be placed in the arena
+ *
+ * the buffer must not be resized or exited by tb_buffer_xxx() if it's data is in the arena
+ *
+ * @param arena     the arena
+ * @param buffer    the buffer
+ * @param maxn      the space size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_oc_arena_buffer_need(tb_oc_arena_ref_t arena, tb_buffer_ref_t buffer, tb_size_t maxn);
+
+/* make a zeroed object and init it
+ *
+ * the object will be placed in the current arena if we are building an arena tree,
+ * otherwise it will be allocated from the heap.
+ *
+ * @param size      the object size
+ * @param type      the object type
+ *
+ * @return          the object
+ */
+tb_object_ref_t     tb_oc_arena_object_init(tb_size_t size, tb_size_t type);
+
+/* retain the arena for the given arena object
+ *
+ * @param arena     the arena
+ */
+tb_void_t           tb_oc_arena_retain(tb_oc_arena_ref_t arena);
+
+/* release the arena for the given arena object, it will be exited if the reference count is zero
+ *
+ * @param arena     the arena
+ */
+tb_void_t           tb_oc_arena_release(tb_oc_arena_ref_t arena);
+
+/* the reference count of the arena
+ *
+ * @param arena     the arena
+ *
+ * @return          the reference count
+ */
+tb_size_t           tb_oc_arena_refn(tb_oc_arena_ref_t arena);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inline
+ */
+
+/* the arena of the object
+ *
+ * the arena objects share the reference count of the whole tree,
+ * so we save the arena in the refn field of them.
+ *
+ * @param object    the object
+ *
+ * @return          the arena, tb_null if it is not in the arena
+ */
+static __tb_inline__ tb_oc_arena_ref_t tb_oc_arena_from_object(tb_object_ref_t object)
+{
+    return (object->flag & TB_OBJECT_FLAG_ARENA)? (tb_oc_arena_ref_t)object->refn : tb_null;
+}
+
+/* can the arena container hold this item?
+ *
+ * the arena container does not own the references of the items,
+ * so it only can hold the items of the same arena and the readonly singletons.
+ *
+ * @param arena     the arena of the container
+ * @param item      the item
+ *
+ * @return          tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_oc_arena_holdable(tb_oc_arena_ref_t arena, tb_object_ref_t item)
+{
+    return (item->flag & TB_OBJECT_FLAG_READONLY) || tb_oc_arena_from_object(item) == arena;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
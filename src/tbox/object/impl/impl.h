@@ -26,6 +26,7 @@
  * includes
  */
 #include "object.h"
+#include "arena.h"
 #include "reader/reader.h"
 #include "writer/writer.h"
 
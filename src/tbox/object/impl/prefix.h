@@ -68,6 +68,9 @@ typedef struct __tb_oc_writer_t
     /// writ it
     tb_long_t                   (*writ)(tb_stream_ref_t stream, tb_object_ref_t object, tb_bool_t deflate);
 
+    /// writ it to the given data directly, optional
+    tb_long_t                   (*writ_to_data)(tb_byte_t* data, tb_size_t size, tb_object_ref_t object, tb_bool_t deflate);
+
 }tb_oc_writer_t;
 
 #endif
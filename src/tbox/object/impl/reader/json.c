@@ -31,6 +31,7 @@
  */
 #include "json.h"
 #include "reader.h"
+#include "../../../json/impl/scanner.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -43,201 +44,177 @@
 #   define TB_OC_JSON_READER_ARRAY_GROW             (256)
 #endif
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+/* the initial dictionary size
+ *
+ * the most json dictionaries only have a few keys and the hash map will grow the buckets automatically,
+ * so we need not clear and free the large bucket list for each small dictionary
  */
-static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type)
-{
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
+#define TB_OC_JSON_READER_DICTIONARY_SIZE           (8)
 
-    // init data
-    tb_static_string_t  data;
-    tb_char_t           buff[256];
-    if (!tb_static_string_init(&data, buff, 256)) return tb_null;
+// the peeked data maxn
+#ifdef __tb_small__
+#   define TB_OC_JSON_READER_PEEK_MAXN              (8192)
+#else
+#   define TB_OC_JSON_READER_PEEK_MAXN              (65536)
+#endif
 
-    // done
-    tb_object_ref_t null = tb_null;
-    do
-    {
-        // append character
-        tb_static_string_chrcat(&data, type);
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_object_ref_t tb_oc_json_reader_func_array(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_object_ref_t tb_oc_json_reader_func_boolean(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* reader, tb_char_t type);
 
-        // walk
-        tb_bool_t failed = tb_false;
-        while (!failed && tb_stream_left(reader->stream))
-        {
-            // need one character
-            tb_byte_t* p = tb_null;
-            if (!tb_stream_need(reader->stream, &p, 1) && p)
-            {
-                failed = tb_true;
-                break;
-            }
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * buffer implementation
+ */
 
-            // the character
-            tb_char_t ch = *p;
+// skip the parsed data in the stream and clear the peeked data
+static tb_bool_t tb_oc_json_reader_sync(tb_oc_json_reader_t* reader)
+{
+    // skip the parsed data
+    if (reader->head > reader->base && !tb_stream_skip(reader->stream, reader->head - reader->base))
+        return tb_false;
+
+    // clear the peeked data
+    reader->base = tb_null;
+    reader->head = tb_null;
+    reader->tail = tb_null;
+    return tb_true;
+}
 
-            // append character
-            if (tb_isalpha(ch)) tb_static_string_chrcat(&data, ch);
-            else break;
+// peek the next data window from the stream
+static tb_bool_t tb_oc_json_reader_fill(tb_oc_json_reader_t* reader)
+{
+    // skip the parsed data first
+    if (!tb_oc_json_reader_sync(reader)) return tb_false;
 
-            // skip it
-            tb_stream_skip(reader->stream, 1);
+    // peek data
+    while (1)
+    {
+        tb_byte_t* data = tb_null;
+        tb_long_t  real = tb_stream_peek(reader->stream, &data, TB_OC_JSON_READER_PEEK_MAXN);
+        if (real > 0)
+        {
+            reader->base = data;
+            reader->head = data;
+            reader->tail = data + real;
+            return tb_true;
+        }
+        // no data? wait it
+        else if (!real)
+        {
+            real = tb_stream_wait(reader->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(reader->stream));
+            tb_check_return_val(real > 0, tb_false);
         }
+        // failed or end
+        else return tb_false;
+    }
+    return tb_false;
+}
 
-        // failed?
-        tb_check_break(!failed);
+// peek the next character, -1: end
+static __tb_inline__ tb_long_t tb_oc_json_reader_peekc(tb_oc_json_reader_t* reader)
+{
+    return (reader->head < reader->tail || tb_oc_json_reader_fill(reader))? *reader->head : -1;
+}
 
-        // check
-        tb_assert_and_check_break(tb_static_string_size(&data));
+// read the next character, -1: end
+static __tb_inline__ tb_long_t tb_oc_json_reader_getc(tb_oc_json_reader_t* reader)
+{
+    return (reader->head < reader->tail || tb_oc_json_reader_fill(reader))? *reader->head++ : -1;
+}
 
-        // trace
-        tb_trace_d("null: %s", tb_static_string_cstr(&data));
+// skip spaces and peek the next character, -1: end
+static tb_long_t tb_oc_json_reader_spaces(tb_oc_json_reader_t* reader)
+{
+    while (1)
+    {
+        // skip spaces in the peeked data
+        reader->head = tb_json_scan_spaces(reader->head, reader->tail);
+        if (reader->head < reader->tail) return *reader->head;
 
-        // null?
-        if (!tb_stricmp(tb_static_string_cstr(&data), "null")) null = tb_oc_null_init();
+        // peek more data
+        if (!tb_oc_json_reader_fill(reader)) return -1;
+    }
+    return -1;
+}
 
-    } while (0);
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * reader implementation
+ */
+static tb_object_ref_t tb_oc_json_reader_read_value(tb_oc_json_reader_t* reader, tb_char_t type);
+static tb_bool_t tb_oc_json_reader_read_word(tb_oc_json_reader_t* reader, tb_char_t type, tb_static_string_ref_t data)
+{
+    // append character
+    tb_static_string_chrcat(data, type);
 
-    // exit data
-    tb_static_string_exit(&data);
+    // append the left alpha characters
+    tb_long_t ch;
+    while ((ch = tb_oc_json_reader_peekc(reader)) >= 0 && tb_isalpha(ch))
+    {
+        tb_static_string_chrcat(data, (tb_char_t)ch);
+        reader->head++;
+    }
 
     // ok?
-    return null;
+    return tb_static_string_size(data)? tb_true : tb_false;
 }
-static tb_object_ref_t tb_oc_json_reader_func_array(tb_oc_json_reader_t* reader, tb_char_t type)
+static tb_object_ref_t tb_oc_json_reader_read_null(tb_oc_json_reader_t* reader, tb_char_t type)
 {
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream && type == '[', tb_null);
-
-    // init array
-    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
-    tb_assert_and_check_return_val(array, tb_null);
+    // init data
+    tb_static_string_t  data;
+    tb_char_t           buff[256];
+    if (!tb_static_string_init(&data, buff, 256)) return tb_null;
 
     // done
-    tb_char_t ch;
-    tb_bool_t ok = tb_true;
-    while (ok && tb_stream_left(reader->stream))
+    tb_object_ref_t null = tb_null;
+    if (tb_oc_json_reader_read_word(reader, type, &data))
     {
-        // read one character
-        if (!tb_stream_bread_s8(reader->stream, (tb_sint8_t*)&ch)) break;
-
-        // end?
-        if (ch == ']') break;
-        // no space? skip ','
-        else if (!tb_isspace(ch) && ch != ',')
-        {
-            // the func
-            tb_oc_json_reader_func_t func = tb_oc_json_reader_func(ch);
-            tb_assert_and_check_break_state(func, ok, tb_false);
-
-            // read item
-            tb_object_ref_t item = func(reader, ch);
-            tb_assert_and_check_break_state(item, ok, tb_false);
+        // trace
+        tb_trace_d("null: %s", tb_static_string_cstr(&data));
 
-            // append item
-            tb_oc_array_append(array, item);
-        }
+        // null?
+        if (!tb_stricmp(tb_static_string_cstr(&data), "null")) null = tb_oc_null_init();
     }
 
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        if (array) tb_object_exit(array);
-        array = tb_null;
-    }
+    // exit data
+    tb_static_string_exit(&data);
 
     // ok?
-    return array;
+    return null;
 }
-static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader, tb_char_t type)
+static tb_object_ref_t tb_oc_json_reader_read_boolean(tb_oc_json_reader_t* reader, tb_char_t type)
 {
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream && (type == '\"' || type == '\''), tb_null);
-
     // init data
-    tb_string_t data;
-    if (!tb_string_init(&data)) return tb_null;
+    tb_static_string_t  data;
+    tb_char_t           buff[256];
+    if (!tb_static_string_init(&data, buff, 256)) return tb_null;
 
-    // walk
-    tb_char_t ch;
-    while (tb_stream_left(reader->stream))
+    // done
+    tb_object_ref_t boolean = tb_null;
+    if (tb_oc_json_reader_read_word(reader, type, &data))
     {
-        // read one character
-        if (!tb_stream_bread_s8(reader->stream, (tb_sint8_t*)&ch)) break;
-
-        // end?
-        if (ch == '\"' || ch == '\'') break;
-        // the escaped character?
-        else if (ch == '\\')
-        {
-            // read one character
-            if (!tb_stream_bread_s8(reader->stream, (tb_sint8_t*)&ch)) break;
-
-            // unicode?
-            if (ch == 'u')
-            {
-#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
-                // the unicode string
-                tb_char_t unicode_str[5];
-                if (!tb_stream_bread(reader->stream, (tb_byte_t*)unicode_str, 4)) break;
-                unicode_str[4] = '\0';
-
-                // the unicode value
-                tb_uint16_t unicode_val = tb_s16toi32(unicode_str);
-
-                // the utf8 stream
-                tb_char_t           utf8_data[16] = {0};
-                tb_static_stream_t  utf8_stream;
-                tb_static_stream_init(&utf8_stream, (tb_byte_t*)utf8_data, sizeof(utf8_data));
-
-                // the unicode stream
-                tb_static_stream_t  unicode_stream = {0};
-                tb_static_stream_init(&unicode_stream, (tb_byte_t*)&unicode_val, 2);
-
-                // unicode to utf8
-                tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
-                if (utf8_size > 0) tb_string_cstrncat(&data, utf8_data, utf8_size);
-#else
-                // trace
-                tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
+        // trace
+        tb_trace_d("boolean: %s", tb_static_string_cstr(&data));
 
-                // only append it
-                tb_string_chrcat(&data, ch);
-#endif
-            }
-            else if (ch == 'n') {
-                tb_string_chrcat(&data, '\n');
-            }
-            else if (ch == 't') {
-                tb_string_chrcat(&data, '\t');
-            }
-            // append escaped character
-            else tb_string_chrcat(&data, ch);
-        }
-        // append character
-        else tb_string_chrcat(&data, ch);
+        // true?
+        if (!tb_stricmp(tb_static_string_cstr(&data), "true")) boolean = tb_oc_boolean_init(tb_true);
+        // false?
+        else if (!tb_stricmp(tb_static_string_cstr(&data), "false")) boolean = tb_oc_boolean_init(tb_false);
     }
 
-    // init string
-    tb_object_ref_t string = tb_oc_string_init_from_cstr(tb_string_cstr(&data));
-
-    // trace
-    tb_trace_d("string: %s", tb_string_cstr(&data));
-
     // exit data
-    tb_string_exit(&data);
+    tb_static_string_exit(&data);
 
     // ok?
-    return string;
+    return boolean;
 }
-static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader, tb_char_t type)
+static tb_object_ref_t tb_oc_json_reader_read_number(tb_oc_json_reader_t* reader, tb_char_t type)
 {
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
-
     // init data
     tb_static_string_t  data;
     tb_char_t           buff[256];
@@ -251,22 +228,12 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
         tb_static_string_chrcat(&data, type);
 
         // walk
+        tb_long_t ch;
         tb_bool_t bs = (type == '-')? tb_true : tb_false;
         tb_bool_t bf = (type == '.')? tb_true : tb_false;
         tb_bool_t failed = tb_false;
-        while (!failed && tb_stream_left(reader->stream))
+        while ((ch = tb_oc_json_reader_peekc(reader)) >= 0)
         {
-            // need one character
-            tb_byte_t* p = tb_null;
-            if (!tb_stream_need(reader->stream, &p, 1) && p)
-            {
-                failed = tb_true;
-                break;
-            }
-
-            // the character
-            tb_char_t ch = *p;
-
             // is float?
             if (!bf && ch == '.') bf = tb_true;
             else if (bf && ch == '.')
@@ -277,11 +244,11 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
 
             // append character
             if (tb_isdigit10(ch) || ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+')
-                tb_static_string_chrcat(&data, ch);
+                tb_static_string_chrcat(&data, (tb_char_t)ch);
             else break;
 
             // skip it
-            tb_stream_skip(reader->stream, 1);
+            reader->head++;
         }
 
         // failed?
@@ -335,129 +302,176 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
     // ok?
     return number;
 }
-static tb_object_ref_t tb_oc_json_reader_func_boolean(tb_oc_json_reader_t* reader, tb_char_t type)
+static tb_void_t tb_oc_json_reader_read_cstr(tb_oc_json_reader_t* reader, tb_char_t quote, tb_string_ref_t data)
 {
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
+    // walk
+    tb_long_t ch;
+    while (1)
+    {
+        // peek more data?
+        if (reader->head == reader->tail && !tb_oc_json_reader_fill(reader)) break;
 
-    // init data
-    tb_static_string_t  data;
-    tb_char_t           buff[256];
-    if (!tb_static_string_init(&data, buff, 256)) return tb_null;
+        // append the characters before the next quote or backslash
+        tb_byte_t const* p = tb_json_scan_string(reader->head, reader->tail, (tb_byte_t)quote);
+        if (p > reader->head) tb_string_cstrncat(data, (tb_char_t const*)reader->head, p - reader->head);
+        reader->head = p;
+        tb_check_continue(p < reader->tail);
 
-    // done
-    tb_object_ref_t boolean = tb_null;
-    do
-    {
-        // append character
-        tb_static_string_chrcat(&data, type);
+        // end?
+        reader->head++;
+        if (*p == quote) break;
 
-        // walk
-        tb_bool_t failed = tb_false;
-        while (!failed && tb_stream_left(reader->stream))
+        // read the escaped character
+        if ((ch = tb_oc_json_reader_getc(reader)) < 0) break;
+
+        // unicode?
+        if (ch == 'u')
         {
-            // need one character
-            tb_byte_t* p = tb_null;
-            if (!tb_stream_need(reader->stream, &p, 1) && p)
-            {
-                failed = tb_true;
-                break;
-            }
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+            // the unicode string
+            tb_size_t i = 0;
+            tb_char_t unicode_str[5];
+            for (i = 0; i < 4 && (ch = tb_oc_json_reader_getc(reader)) >= 0; i++)
+                unicode_str[i] = (tb_char_t)ch;
+            if (i < 4) break;
+            unicode_str[4] = '\0';
+
+            // the unicode value
+            tb_uint16_t unicode_val = tb_s16toi32(unicode_str);
+
+            // the utf8 stream
+            tb_char_t           utf8_data[16] = {0};
+            tb_static_stream_t  utf8_stream;
+            tb_static_stream_init(&utf8_stream, (tb_byte_t*)utf8_data, sizeof(utf8_data));
+
+            // the unicode stream
+            tb_static_stream_t  unicode_stream = {0};
+            tb_static_stream_init(&unicode_stream, (tb_byte_t*)&unicode_val, 2);
+
+            // unicode to utf8
+            tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
+            if (utf8_size > 0) tb_string_cstrncat(data, utf8_data, utf8_size);
+#else
+            // trace
+            tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
 
-            // the character
-            tb_char_t ch = *p;
+            // only append it
+            tb_string_chrcat(data, (tb_char_t)ch);
+#endif
+        }
+        else if (ch == 'n') tb_string_chrcat(data, '\n');
+        else if (ch == 't') tb_string_chrcat(data, '\t');
+        else if (ch == 'r') tb_string_chrcat(data, '\r');
+        else if (ch == 'b') tb_string_chrcat(data, '\b');
+        else if (ch == 'f') tb_string_chrcat(data, '\f');
+        // append escaped character
+        else tb_string_chrcat(data, (tb_char_t)ch);
+    }
+}
+static tb_object_ref_t tb_oc_json_reader_read_string(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // init data
+    tb_string_t data;
+    if (!tb_string_init(&data)) return tb_null;
 
-            // append character
-            if (tb_isalpha(ch)) tb_static_string_chrcat(&data, ch);
-            else break;
+    // read string
+    tb_oc_json_reader_read_cstr(reader, type, &data);
 
-            // skip it
-            tb_stream_skip(reader->stream, 1);
-        }
+    // init string
+    tb_object_ref_t string = tb_oc_string_init_from_cstr(tb_string_cstr(&data));
 
-        // failed?
-        tb_check_break(!failed);
+    // trace
+    tb_trace_d("string: %s", tb_string_cstr(&data));
 
-        // check
-        tb_assert_and_check_break(tb_static_string_size(&data));
+    // exit data
+    tb_string_exit(&data);
 
-        // trace
-        tb_trace_d("boolean: %s", tb_static_string_cstr(&data));
+    // ok?
+    return string;
+}
+static tb_object_ref_t tb_oc_json_reader_read_array(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // init array
+    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
+    tb_assert_and_check_return_val(array, tb_null);
 
-        // true?
-        if (!tb_stricmp(tb_static_string_cstr(&data), "true")) boolean = tb_oc_boolean_init(tb_true);
-        // false?
-        else if (!tb_stricmp(tb_static_string_cstr(&data), "false")) boolean = tb_oc_boolean_init(tb_false);
+    // done
+    tb_long_t ch;
+    tb_bool_t ok = tb_true;
+    while (ok && (ch = tb_oc_json_reader_spaces(reader)) >= 0)
+    {
+        // skip it
+        reader->head++;
 
-    } while (0);
+        // end?
+        if (ch == ']') break;
+        // skip ','
+        else if (ch != ',')
+        {
+            // read item
+            tb_object_ref_t item = tb_oc_json_reader_read_value(reader, (tb_char_t)ch);
+            tb_assert_and_check_break_state(item, ok, tb_false);
 
-    // exit data
-    tb_static_string_exit(&data);
+            // append item
+            tb_oc_array_append(array, item);
+        }
+    }
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (array) tb_object_exit(array);
+        array = tb_null;
+    }
 
     // ok?
-    return boolean;
+    return array;
 }
-static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* reader, tb_char_t type)
+static tb_object_ref_t tb_oc_json_reader_read_dictionary(tb_oc_json_reader_t* reader, tb_char_t type)
 {
-    // check
-    tb_assert_and_check_return_val(reader && reader->stream && type == '{', tb_null);
-
     // init key name
-    tb_static_string_t  kname;
-    tb_char_t           kdata[8192];
-    if (!tb_static_string_init(&kname, kdata, 8192)) return tb_null;
+    tb_string_t kname;
+    if (!tb_string_init(&kname)) return tb_null;
 
     // init dictionary
-    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_object_ref_t dictionary = tb_oc_dictionary_init(TB_OC_JSON_READER_DICTIONARY_SIZE, tb_false);
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // walk
-    tb_char_t ch;
+    tb_long_t ch;
     tb_bool_t ok = tb_true;
-    tb_bool_t bkey = tb_false;
-    tb_size_t bstr = 0;
-    while (ok && tb_stream_left(reader->stream))
+    while (ok && (ch = tb_oc_json_reader_spaces(reader)) >= 0)
     {
-        // read one character
-        if (!tb_stream_bread_s8(reader->stream, (tb_sint8_t*)&ch)) break;
+        // skip it
+        reader->head++;
 
         // end?
         if (ch == '}') break;
-        // no space? skip ','
-        else if (!tb_isspace(ch) && ch != ',')
+        // skip ','
+        else if (ch != ',')
         {
-            // no key?
-            if (!bkey)
-            {
-                // is str?
-                if (ch == '\"' || ch == '\'') bstr = !bstr;
-                // is key end?
-                else if (!bstr && ch == ':') bkey = tb_true;
-                // append key
-                else if (bstr) tb_static_string_chrcat(&kname, ch);
-            }
-            // key ok? read val
-            else
-            {
-                // trace
-                tb_trace_d("key: %s", tb_static_string_cstr(&kname));
-
-                // the func
-                tb_oc_json_reader_func_t func = tb_oc_json_reader_func(ch);
-                tb_assert_and_check_break_state(func, ok, tb_false);
-
-                // read val
-                tb_object_ref_t val = func(reader, ch);
-                tb_assert_and_check_break_state(val, ok, tb_false);
-
-                // set key => val
-                tb_oc_dictionary_insert(dictionary, tb_static_string_cstr(&kname), val);
-
-                // reset key
-                bstr = 0;
-                bkey = tb_false;
-                tb_static_string_clear(&kname);
-            }
+            // read key
+            tb_assert_and_check_break_state(ch == '\"' || ch == '\'', ok, tb_false);
+            tb_string_clear(&kname);
+            tb_oc_json_reader_read_cstr(reader, (tb_char_t)ch, &kname);
+
+            // skip ':'
+            tb_assert_and_check_break_state(tb_oc_json_reader_spaces(reader) == ':', ok, tb_false);
+            reader->head++;
+
+            // trace
+            tb_trace_d("key: %s", tb_string_cstr(&kname));
+
+            // read val
+            ch = tb_oc_json_reader_spaces(reader);
+            tb_assert_and_check_break_state(ch >= 0, ok, tb_false);
+            reader->head++;
+            tb_object_ref_t val = tb_oc_json_reader_read_value(reader, (tb_char_t)ch);
+            tb_assert_and_check_break_state(val, ok, tb_false);
+
+            // set key => val
+            tb_oc_dictionary_insert(dictionary, tb_string_cstr(&kname), val);
         }
     }
 
@@ -470,11 +484,92 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     }
 
     // exit key name
-    tb_static_string_exit(&kname);
+    tb_string_exit(&kname);
 
     // ok?
     return dictionary;
 }
+static tb_object_ref_t tb_oc_json_reader_read_value(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // the func
+    tb_oc_json_reader_func_t func = tb_oc_json_reader_func(type);
+    tb_assert_and_check_return_val(func, tb_null);
+
+    // read it from the peeked data directly if be the builtin func
+    if (func == tb_oc_json_reader_func_string) return tb_oc_json_reader_read_string(reader, type);
+    else if (func == tb_oc_json_reader_func_number) return tb_oc_json_reader_read_number(reader, type);
+    else if (func == tb_oc_json_reader_func_dictionary) return tb_oc_json_reader_read_dictionary(reader, type);
+    else if (func == tb_oc_json_reader_func_array) return tb_oc_json_reader_read_array(reader, type);
+    else if (func == tb_oc_json_reader_func_boolean) return tb_oc_json_reader_read_boolean(reader, type);
+    else if (func == tb_oc_json_reader_func_null) return tb_oc_json_reader_read_null(reader, type);
+
+    // the hooked func will read the stream directly, so we need skip the parsed data first
+    return tb_oc_json_reader_sync(reader)? func(reader, type) : tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_null(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_func_array(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream && type == '[', tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_array(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream && (type == '\"' || type == '\''), tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_string(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_number(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_func_boolean(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream, tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_boolean(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && reader->stream && type == '{', tb_null);
+
+    // read it and skip the parsed data
+    tb_object_ref_t object = tb_oc_json_reader_read_dictionary(reader, type);
+    tb_oc_json_reader_sync(reader);
+    return object;
+}
 static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
 {
     // check
@@ -485,22 +580,16 @@ static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
     reader.stream = stream;
 
     // skip spaces
-    tb_char_t type = '\0';
-    while (tb_stream_left(stream))
-    {
-        if (!tb_stream_bread_s8(stream, (tb_sint8_t*)&type)) break;
-        if (!tb_isspace(type)) break;
-    }
-
-    // empty?
-    tb_check_return_val(tb_stream_left(stream), tb_null);
-
-    // the func
-    tb_oc_json_reader_func_t func = tb_oc_json_reader_func(type);
-    tb_assert_and_check_return_val(func, tb_null);
+    tb_long_t type = tb_oc_json_reader_spaces(&reader);
+    tb_check_return_val(type > 0, tb_null);
+    reader.head++;
 
     // read it
-    return func(&reader, type);
+    tb_object_ref_t object = tb_oc_json_reader_read_value(&reader, (tb_char_t)type);
+
+    // skip the parsed data
+    tb_oc_json_reader_sync(&reader);
+    return object;
 }
 static tb_size_t tb_oc_json_reader_probe(tb_stream_ref_t stream)
 {
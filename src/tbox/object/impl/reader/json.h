@@ -42,9 +42,22 @@ typedef struct __tb_oc_json_reader_t
     /// the stream
     tb_stream_ref_t              stream;
 
+    /// the peeked data base, the data in [base, head) has been parsed but not been skipped in the stream
+    tb_byte_t const*             base;
+
+    /// the peeked data head
+    tb_byte_t const*             head;
+
+    /// the peeked data tail
+    tb_byte_t const*             tail;
+
 }tb_oc_json_reader_t;
 
-/// the json reader func type
+/*! the json reader func type
+ *
+ * the stream has been positioned after the type character when calling the hooked func,
+ * so the custom func can read the left data from reader->stream directly.
+ */
 typedef tb_object_ref_t      (*tb_oc_json_reader_func_t)(tb_oc_json_reader_t* reader, tb_char_t type);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
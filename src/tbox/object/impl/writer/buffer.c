@@ -0,0 +1,404 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        buffer.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "oc_writer_buffer"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "buffer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the two digits of 00 - 99
+static tb_char_t const g_oc_writer_buffer_digits[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// convert the unsigned integer to the digits at the end of [data, tail), return the digits head
+static tb_char_t* tb_oc_writer_buffer_digits(tb_char_t* tail, tb_uint64_t value)
+{
+    // two digits per loop
+    tb_char_t* p = tail;
+    while (value >= 100)
+    {
+        tb_size_t i = (tb_size_t)(value % 100) << 1;
+        value /= 100;
+        *--p = g_oc_writer_buffer_digits[i + 1];
+        *--p = g_oc_writer_buffer_digits[i];
+    }
+
+    // the last one or two digits
+    if (value >= 10)
+    {
+        tb_size_t i = (tb_size_t)value << 1;
+        *--p = g_oc_writer_buffer_digits[i + 1];
+        *--p = g_oc_writer_buffer_digits[i];
+    }
+    else *--p = (tb_char_t)('0' + value);
+    return p;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_oc_writer_buffer_init(tb_oc_writer_buffer_t* buffer, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && stream, tb_false);
+
+    // init buffer
+    tb_memset(buffer, 0, sizeof(tb_oc_writer_buffer_t));
+    buffer->buff = tb_malloc_bytes(TB_OC_WRITER_BUFFER_MAXN);
+    tb_assert_and_check_return_val(buffer->buff, tb_false);
+
+    // init stream
+    buffer->stream  = stream;
+    buffer->data    = buffer->buff;
+    buffer->maxn    = TB_OC_WRITER_BUFFER_MAXN;
+    return tb_true;
+}
+tb_bool_t tb_oc_writer_buffer_init_from_data(tb_oc_writer_buffer_t* buffer, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && data && size, tb_false);
+
+    // init buffer
+    tb_memset(buffer, 0, sizeof(tb_oc_writer_buffer_t));
+    buffer->data    = data;
+    buffer->maxn    = size;
+    return tb_true;
+}
+tb_void_t tb_oc_writer_buffer_exit(tb_oc_writer_buffer_t* buffer)
+{
+    // check
+    tb_assert_and_check_return(buffer);
+
+    // exit the temporary data stream if the hooked func has been failed
+    if (buffer->odata && buffer->stream) tb_stream_exit(buffer->stream);
+
+    // exit the allocated buffer
+    if (buffer->buff) tb_free(buffer->buff);
+
+    // clear it
+    tb_memset(buffer, 0, sizeof(tb_oc_writer_buffer_t));
+}
+tb_bool_t tb_oc_writer_buffer_flush(tb_oc_writer_buffer_t* buffer)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_false);
+
+    // only flush it for the stream
+    if (buffer->stream && buffer->size)
+    {
+        if (!tb_stream_bwrit(buffer->stream, buffer->data, buffer->size)) return tb_false;
+        buffer->size = 0;
+    }
+    return tb_true;
+}
+tb_byte_t* tb_oc_writer_buffer_grow(tb_oc_writer_buffer_t* buffer, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_null);
+
+    // the given data is full?
+    tb_check_return_val(buffer->stream, tb_null);
+
+    // flush it
+    if (!tb_oc_writer_buffer_flush(buffer)) return tb_null;
+
+    // ok?
+    tb_assert_and_check_return_val(size <= buffer->maxn, tb_null);
+    return buffer->data;
+}
+tb_bool_t tb_oc_writer_buffer_writ_data(tb_oc_writer_buffer_t* buffer, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && (data || !size), tb_false);
+
+    // writ the large data to the stream directly
+    if (buffer->stream && size >= buffer->maxn)
+        return tb_oc_writer_buffer_flush(buffer) && tb_stream_bwrit(buffer->stream, data, size);
+
+    // copy data
+    while (size)
+    {
+        // flush it if be full
+        tb_size_t left = buffer->maxn - buffer->size;
+        if (!left)
+        {
+            if (!tb_oc_writer_buffer_grow(buffer, 1)) return tb_false;
+            continue;
+        }
+
+        // copy it
+        tb_size_t need = tb_min(left, size);
+        tb_memcpy_(buffer->data + buffer->size, data, need);
+        buffer->size += need;
+        data += need;
+        size -= need;
+    }
+    return tb_true;
+}
+tb_bool_t tb_oc_writer_buffer_fill_spaces(tb_oc_writer_buffer_t* buffer, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_false);
+
+    // fill spaces
+    while (size)
+    {
+        // flush it if be full
+        tb_size_t left = buffer->maxn - buffer->size;
+        if (!left)
+        {
+            if (!tb_oc_writer_buffer_grow(buffer, 1)) return tb_false;
+            continue;
+        }
+
+        // fill it
+        tb_size_t need = tb_min(left, size);
+        tb_memset_(buffer->data + buffer->size, ' ', need);
+        buffer->size += need;
+        size -= need;
+    }
+    return tb_true;
+}
+tb_bool_t tb_oc_writer_buffer_writ_uint64(tb_oc_writer_buffer_t* buffer, tb_uint64_t value)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_false);
+
+    // make digits
+    tb_char_t   data[32];
+    tb_char_t*  tail = data + sizeof(data);
+    tb_char_t*  head = tb_oc_writer_buffer_digits(tail, value);
+
+    // writ it
+    tb_size_t   size = tail - head;
+    tb_byte_t*  p = tb_oc_writer_buffer_need(buffer, size);
+    tb_check_return_val(p, tb_false);
+    tb_memcpy_(p, head, size);
+    buffer->size += size;
+    return tb_true;
+}
+tb_bool_t tb_oc_writer_buffer_writ_sint64(tb_oc_writer_buffer_t* buffer, tb_sint64_t value)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_false);
+
+    // make digits
+    tb_char_t   data[32];
+    tb_char_t*  tail = data + sizeof(data);
+    tb_char_t*  head = tb_oc_writer_buffer_digits(tail, value < 0? (tb_uint64_t)0 - (tb_uint64_t)value : (tb_uint64_t)value);
+    if (value < 0) *--head = '-';
+
+    // writ it
+    tb_size_t   size = tail - head;
+    tb_byte_t*  p = tb_oc_writer_buffer_need(buffer, size);
+    tb_check_return_val(p, tb_false);
+    tb_memcpy_(p, head, size);
+    buffer->size += size;
+    return tb_true;
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_bool_t tb_oc_writer_buffer_writ_double(tb_oc_writer_buffer_t* buffer, tb_double_t value)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_false);
+
+    // inf or nan?
+    if (tb_isinf(value)) return tb_oc_writer_buffer_writ_cstr(buffer, value < 0? "-inf" : "inf");
+    else if (tb_isnan(value)) return tb_oc_writer_buffer_writ_cstr(buffer, "nan");
+
+    // the sign
+    tb_char_t   data[64];
+    tb_char_t*  p = data;
+    if (value < 0)
+    {
+        *p++ = '-';
+        value = -value;
+    }
+
+    /* round? i.dddddd5 => i.ddddde
+     *
+     * @note we use the same algorithm as "%lf" of tb_vsnprintf for keeping the same output
+     */
+    if (value < 1e12 && ((tb_uint64_t)(value * 1000000 * 10) % 10) > 4)
+        value += 1. / 1000000;
+
+    // get integer & decimal, the large integer will be scaled for avoiding overflow
+    tb_size_t   zeros = 0;
+    tb_double_t decimal = 0;
+    tb_uint64_t integer = 0;
+    if (value < 9e18)
+    {
+        integer = (tb_uint64_t)value;
+        decimal = value - (tb_double_t)integer;
+    }
+    else
+    {
+        while (value >= 1e18 && zeros < 308)
+        {
+            value /= 10;
+            zeros++;
+        }
+        integer = (tb_uint64_t)value;
+    }
+
+    // append integer
+    tb_char_t*  tail = data + 32;
+    tb_char_t*  head = tb_oc_writer_buffer_digits(tail, integer);
+    tb_memmov(p, head, tail - head);
+    p += tail - head;
+
+    // append the scaled zeros of the large integer
+    if (zeros)
+    {
+        if (!tb_oc_writer_buffer_writ(buffer, (tb_byte_t const*)data, p - data)) return tb_false;
+        while (zeros--) if (!tb_oc_writer_buffer_writ_char(buffer, '0')) return tb_false;
+        p = data;
+    }
+
+    // append .
+    *p++ = '.';
+
+    // append six decimals
+    tb_size_t n = 0;
+    if (decimal != 0)
+    {
+        tb_long_t d = (tb_long_t)(decimal * 10);
+        do
+        {
+            *p++ = (tb_char_t)(d + '0');
+            decimal = decimal * 10 - d;
+            d = (tb_long_t)(decimal * 10);
+
+        } while (++n < 6);
+    }
+    for (; n < 6; n++) *p++ = '0';
+
+    // writ it
+    return tb_oc_writer_buffer_writ(buffer, (tb_byte_t const*)data, p - data);
+}
+#endif
+tb_bool_t tb_oc_writer_buffer_printf(tb_oc_writer_buffer_t* buffer, tb_char_t const* fmt, ...)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && fmt, tb_false);
+
+    // format data
+    tb_char_t data[256];
+    tb_size_t size = 0;
+    tb_vsnprintf_format(data, sizeof(data), fmt, &size);
+
+    // writ data
+    return tb_oc_writer_buffer_writ(buffer, (tb_byte_t const*)data, size);
+}
+tb_stream_ref_t tb_oc_writer_buffer_hook_enter(tb_oc_writer_buffer_t* buffer)
+{
+    // check
+    tb_assert_and_check_return_val(buffer, tb_null);
+
+    // flush the buffered data to the stream
+    if (buffer->stream)
+    {
+        if (!tb_oc_writer_buffer_flush(buffer)) return tb_null;
+    }
+    // we are writing the given data directly
+    else
+    {
+        // check
+        tb_check_return_val(buffer->size < buffer->maxn, tb_null);
+
+        // init the allocated buffer
+        if (!buffer->buff) buffer->buff = tb_malloc_bytes(TB_OC_WRITER_BUFFER_MAXN);
+        tb_assert_and_check_return_val(buffer->buff, tb_null);
+
+        // make a temporary data stream for the left data
+        tb_stream_ref_t stream = tb_stream_init_from_data(buffer->data + buffer->size, buffer->maxn - buffer->size);
+        tb_assert_and_check_return_val(stream, tb_null);
+        if (!tb_stream_open(stream))
+        {
+            tb_stream_exit(stream);
+            return tb_null;
+        }
+
+        // save the given data and write the temporary data stream
+        buffer->odata   = buffer->data;
+        buffer->osize   = buffer->size;
+        buffer->omaxn   = buffer->maxn;
+        buffer->stream  = stream;
+        buffer->data    = buffer->buff;
+        buffer->size    = 0;
+        buffer->maxn    = TB_OC_WRITER_BUFFER_MAXN;
+    }
+
+    // enter it
+    buffer->hooked++;
+    return buffer->stream;
+}
+tb_bool_t tb_oc_writer_buffer_hook_leave(tb_oc_writer_buffer_t* buffer)
+{
+    // check
+    tb_assert_and_check_return_val(buffer && buffer->hooked && buffer->stream, tb_false);
+
+    // flush the buffered data
+    tb_bool_t ok = tb_oc_writer_buffer_flush(buffer);
+
+    // leave the outermost hooked func and restore the given data?
+    if (!--buffer->hooked && buffer->odata)
+    {
+        // the written size of the temporary data stream
+        if (!tb_stream_sync(buffer->stream, tb_true)) ok = tb_false;
+        tb_size_t size = (tb_size_t)tb_stream_offset(buffer->stream);
+        tb_stream_exit(buffer->stream);
+
+        // restore the given data
+        buffer->stream  = tb_null;
+        buffer->data    = buffer->odata;
+        buffer->size    = buffer->osize + size;
+        buffer->maxn    = buffer->omaxn;
+        buffer->odata   = tb_null;
+        buffer->osize   = 0;
+        buffer->omaxn   = 0;
+    }
+    return ok;
+}
@@ -0,0 +1,297 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        buffer.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_WRITER_BUFFER_H
+#define TB_OBJECT_WRITER_BUFFER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the writer buffer maxn
+#ifdef __tb_small__
+#   define TB_OC_WRITER_BUFFER_MAXN         (8192)
+#else
+#   define TB_OC_WRITER_BUFFER_MAXN         (65536)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the object writer buffer type
+ *
+ * the text writers emit all tokens into it and it will be flushed to the stream only if it is full,
+ * or it writes the given data directly without stream, e.g. tb_object_writ_to_data()
+ */
+typedef struct __tb_oc_writer_buffer_t
+{
+    /// the stream, it will be null if we are writing the given data directly
+    tb_stream_ref_t             stream;
+
+    /// the data
+    tb_byte_t*                  data;
+
+    /// the data size
+    tb_size_t                   size;
+
+    /// the data maxn
+    tb_size_t                   maxn;
+
+    /// the hooked level
+    tb_size_t                   hooked;
+
+    /// the allocated buffer
+    tb_byte_t*                  buff;
+
+    /// the given data, it will be written by a temporary data stream in the hooked func
+    tb_byte_t*                  odata;
+
+    /// the given data size
+    tb_size_t                   osize;
+
+    /// the given data maxn
+    tb_size_t                   omaxn;
+
+}tb_oc_writer_buffer_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the writer buffer for the stream
+ *
+ * @param buffer        the writer buffer
+ * @param stream        the stream
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_init(tb_oc_writer_buffer_t* buffer, tb_stream_ref_t stream);
+
+/*! init the writer buffer for writing the given data directly
+ *
+ * @param buffer        the writer buffer
+ * @param data          the data
+ * @param size          the data size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_init_from_data(tb_oc_writer_buffer_t* buffer, tb_byte_t* data, tb_size_t size);
+
+/*! exit the writer buffer
+ *
+ * @param buffer        the writer buffer
+ */
+tb_void_t               tb_oc_writer_buffer_exit(tb_oc_writer_buffer_t* buffer);
+
+/*! flush the buffered data to the stream
+ *
+ * @param buffer        the writer buffer
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_flush(tb_oc_writer_buffer_t* buffer);
+
+/*! flush the buffered data and get the free space for writing the given size
+ *
+ * @param buffer        the writer buffer
+ * @param size          the needed size
+ *
+ * @return              the free space, it will be null if the given data is full
+ */
+tb_byte_t*              tb_oc_writer_buffer_grow(tb_oc_writer_buffer_t* buffer, tb_size_t size);
+
+/*! writ data, it will flush the buffered data if it is full and writ the large data to the stream directly
+ *
+ * @param buffer        the writer buffer
+ * @param data          the data
+ * @param size          the data size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_writ_data(tb_oc_writer_buffer_t* buffer, tb_byte_t const* data, tb_size_t size);
+
+/*! fill spaces, it will flush the buffered data if it is full
+ *
+ * @param buffer        the writer buffer
+ * @param size          the spaces count
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_fill_spaces(tb_oc_writer_buffer_t* buffer, tb_size_t size);
+
+/*! writ the unsigned integer
+ *
+ * @param buffer        the writer buffer
+ * @param value         the value
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_writ_uint64(tb_oc_writer_buffer_t* buffer, tb_uint64_t value);
+
+/*! writ the signed integer
+ *
+ * @param buffer        the writer buffer
+ * @param value         the value
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_writ_sint64(tb_oc_writer_buffer_t* buffer, tb_sint64_t value);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! writ the float value with six decimals, it is same as "%lf"
+ *
+ * @param buffer        the writer buffer
+ * @param value         the value
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_writ_double(tb_oc_writer_buffer_t* buffer, tb_double_t value);
+#endif
+
+/*! writ the format string
+ *
+ * @param buffer        the writer buffer
+ * @param fmt           the format string
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_printf(tb_oc_writer_buffer_t* buffer, tb_char_t const* fmt, ...);
+
+/*! enter the hooked func which will write the stream directly
+ *
+ * the buffered data will be flushed first, and we make a temporary data stream
+ * if we are writing the given data directly.
+ *
+ * @param buffer        the writer buffer
+ *
+ * @return              the stream for the hooked func
+ */
+tb_stream_ref_t         tb_oc_writer_buffer_hook_enter(tb_oc_writer_buffer_t* buffer);
+
+/*! leave the hooked func
+ *
+ * @param buffer        the writer buffer
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_oc_writer_buffer_hook_leave(tb_oc_writer_buffer_t* buffer);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/*! get the free space for writing the given size
+ *
+ * @param buffer        the writer buffer
+ * @param size          the needed size, it must be less than TB_OC_WRITER_BUFFER_MAXN
+ *
+ * @return              the free space, it will be null if the given data is full
+ */
+static __tb_inline__ tb_byte_t* tb_oc_writer_buffer_need(tb_oc_writer_buffer_t* buffer, tb_size_t size)
+{
+    return (buffer->size + size <= buffer->maxn)? buffer->data + buffer->size : tb_oc_writer_buffer_grow(buffer, size);
+}
+
+/*! writ data
+ *
+ * @param buffer        the writer buffer
+ * @param data          the data
+ * @param size          the data size
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_oc_writer_buffer_writ(tb_oc_writer_buffer_t* buffer, tb_byte_t const* data, tb_size_t size)
+{
+    // copy it to the buffer directly if there is enough space
+    if (buffer->size + size <= buffer->maxn)
+    {
+        tb_memcpy_(buffer->data + buffer->size, data, size);
+        buffer->size += size;
+        return tb_true;
+    }
+    return tb_oc_writer_buffer_writ_data(buffer, data, size);
+}
+
+/*! writ spaces
+ *
+ * @param buffer        the writer buffer
+ * @param size          the spaces count
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_oc_writer_buffer_writ_spaces(tb_oc_writer_buffer_t* buffer, tb_size_t size)
+{
+    // fill it to the buffer directly if there is enough space
+    if (buffer->size + size <= buffer->maxn)
+    {
+        tb_memset_(buffer->data + buffer->size, ' ', size);
+        buffer->size += size;
+        return tb_true;
+    }
+    return tb_oc_writer_buffer_fill_spaces(buffer, size);
+}
+
+/*! writ a character
+ *
+ * @param buffer        the writer buffer
+ * @param ch            the character
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_oc_writer_buffer_writ_char(tb_oc_writer_buffer_t* buffer, tb_char_t ch)
+{
+    tb_byte_t* p = tb_oc_writer_buffer_need(buffer, 1);
+    tb_check_return_val(p, tb_false);
+
+    *p = (tb_byte_t)ch;
+    buffer->size++;
+    return tb_true;
+}
+
+/*! writ the c-string
+ *
+ * @param buffer        the writer buffer
+ * @param cstr          the c-string
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t tb_oc_writer_buffer_writ_cstr(tb_oc_writer_buffer_t* buffer, tb_char_t const* cstr)
+{
+    return tb_oc_writer_buffer_writ(buffer, (tb_byte_t const*)cstr, tb_strlen(cstr));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -32,78 +32,128 @@
 #include "json.h"
 #include "writer.h"
 #include "../../../algorithm/algorithm.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_bool_t tb_oc_json_writer_func_null(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_func_array(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_func_string(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_func_number(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_func_boolean(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_func_dictionary(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_char_t const* tb_oc_json_escape_cstr(tb_char_t* data, tb_size_t maxn, tb_object_ref_t object)
+
+static __tb_inline__ tb_bool_t tb_oc_json_writer_writ_escape_char(tb_oc_json_writer_t* writer, tb_char_t ch)
+{
+    // get the free space
+    tb_byte_t* d = tb_oc_writer_buffer_need(&writer->buffer, 2);
+    tb_check_return_val(d, tb_false);
+
+    // writ the escaped character
+    d[0] = '\\';
+    switch (ch)
+    {
+    case '\n':  d[1] = 'n'; break;
+    case '\t':  d[1] = 't'; break;
+    default:    d[1] = (tb_byte_t)ch; break;
+    }
+    writer->buffer.size += 2;
+    return tb_true;
+}
+static tb_bool_t tb_oc_json_writer_writ_escape(tb_oc_json_writer_t* writer, tb_char_t const* data, tb_size_t size)
 {
-    tb_char_t const* sp = tb_oc_string_cstr(object);
-    tb_char_t const* se = sp + tb_oc_string_size(object);
-    tb_char_t*       dp = data;
-    tb_char_t const* de = data + maxn;
-    tb_char_t        ch;
-    while (sp < se && dp < de)
+    // writ "
+    if (!tb_oc_writer_buffer_writ_char(&writer->buffer, '\"')) return tb_false;
+
+    // writ the escaped string
+    tb_char_t const* p = data;
+    tb_char_t const* e = data + size;
+#ifdef TB_ARCH_SSE2
+    __m128i q16 = _mm_set1_epi8('\"');
+    __m128i b16 = _mm_set1_epi8('\\');
+    __m128i n16 = _mm_set1_epi8('\n');
+    __m128i t16 = _mm_set1_epi8('\t');
+    while (p + 16 <= e)
     {
-        ch = *sp++;
-        if (dp + 1 < de)
+        // get the free space, we write the left characters one by one if the given data is almost full
+        tb_byte_t* d = tb_oc_writer_buffer_need(&writer->buffer, 16);
+        tb_check_break(d);
+
+        // copy 16 characters to the buffer first and find the first character which need be escaped
+        __m128i     v = _mm_loadu_si128((__m128i const*)p);
+        __m128i     x = _mm_or_si128(_mm_cmpeq_epi8(v, q16), _mm_cmpeq_epi8(v, b16));
+        __m128i     y = _mm_or_si128(_mm_cmpeq_epi8(v, n16), _mm_cmpeq_epi8(v, t16));
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(x, y));
+        _mm_storeu_si128((__m128i*)d, v);
+        if (!m)
         {
-            if (ch == '\n')
-            {
-                *dp++ = '\\';
-                *dp++ = 'n';
-            }
-            else if (ch == '\t')
-            {
-                *dp++ = '\\';
-                *dp++ = 't';
-            }
-            else if (ch == '"')
-            {
-                *dp++ = '\\';
-                *dp++ = '"';
-            }
-            else if (ch == '\\')
-            {
-                *dp++ = '\\';
-                *dp++ = '\\';
-            }
-            else
-            {
-                *dp++ = ch;
-                continue;
-            }
+            writer->buffer.size += 16;
+            p += 16;
+            continue;
         }
-        else *dp++ = ch;
+
+        // only keep the characters before it
+        tb_size_t n = tb_bits_fb1_u32_le(m);
+        writer->buffer.size += n;
+        p += n;
+
+        // writ the escaped character
+        if (!tb_oc_json_writer_writ_escape_char(writer, *p++)) return tb_false;
+    }
+#endif
+    while (p < e)
+    {
+        // writ the characters which need not be escaped
+        tb_char_t const* q = p;
+        while (q < e && *q != '\"' && *q != '\\' && *q != '\n' && *q != '\t') q++;
+        if (q > p && !tb_oc_writer_buffer_writ(&writer->buffer, (tb_byte_t const*)p, q - p)) return tb_false;
+        tb_check_break(q < e);
+
+        // writ the escaped character
+        if (!tb_oc_json_writer_writ_escape_char(writer, *q)) return tb_false;
+        p = q + 1;
     }
-    if (dp < de) *dp = '\0';
-    return data;
+
+    // writ "
+    return tb_oc_writer_buffer_writ_char(&writer->buffer, '\"');
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * writer implementation
  */
-static tb_bool_t tb_oc_json_writer_func_null(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static __tb_inline__ tb_oc_json_writer_func_t tb_oc_json_writer_func_cached(tb_oc_json_writer_t* writer, tb_size_t type)
+{
+    // the builtin type? we cache it to avoid looking up the hooker for each object
+    if (type < tb_arrayn(writer->funcs))
+    {
+        if (!writer->funcs[type]) writer->funcs[type] = (tb_cpointer_t)tb_oc_json_writer_func(type);
+        return (tb_oc_json_writer_func_t)writer->funcs[type];
+    }
+    return tb_oc_json_writer_func(type);
+}
+static tb_bool_t tb_oc_json_writer_writ_value(tb_oc_json_writer_t* writer, tb_oc_json_writer_func_t func, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_json_writer_writ_null(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
-    if (tb_stream_printf(writer->stream, "null") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "null")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     return tb_true;
 }
-static tb_bool_t tb_oc_json_writer_func_array(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_json_writer_writ_array(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write array
     if (tb_oc_array_size(object))
     {
         // write begin
-        if (tb_stream_printf(writer->stream, "[") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_char(&writer->buffer, '[')) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // walk
         tb_for_all (tb_object_ref_t, item, tb_oc_array_itor(object))
@@ -112,138 +162,102 @@ static tb_bool_t tb_oc_json_writer_func_array(tb_oc_json_writer_t* writer, tb_ob
             if (item)
             {
                 // func
-                tb_oc_json_writer_func_t func = tb_oc_json_writer_func(item->type);
+                tb_oc_json_writer_func_t func = tb_oc_json_writer_func_cached(writer, item->type);
                 tb_assert_and_check_continue(func);
 
                 // write tab
                 if (item_itor != item_head)
                 {
-                    if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level, 2)) return tb_false;
-                    if (tb_stream_printf(writer->stream, ",") < 0) return tb_false;
-                    if (!tb_oc_writer_spaces(writer->stream, writer->deflate, 1, 1)) return tb_false;
+                    if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level, 2)) return tb_false;
+                    if (!tb_oc_writer_buffer_writ_char(&writer->buffer, ',')) return tb_false;
+                    if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, 1, 1)) return tb_false;
                 }
-                else if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level + 1, 2)) return tb_false;
+                else if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level + 1, 2)) return tb_false;
 
                 // write
-                if (!func(writer, item, level + 1)) return tb_false;
+                if (!tb_oc_json_writer_writ_value(writer, func, item, level + 1)) return tb_false;
             }
         }
 
         // write end
-        if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level, 2)) return tb_false;
-        if (tb_stream_printf(writer->stream, "]") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level, 2)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_char(&writer->buffer, ']')) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
-        if (tb_stream_printf(writer->stream, "[]") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "[]")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     return tb_true;
 }
-static tb_bool_t tb_oc_json_writer_func_string(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_json_writer_writ_string(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
-    tb_size_t size = tb_oc_string_size(object);
-    if (size)
-    {
-        tb_size_t maxn = (size * 3 / 2) + 16;
-        if (maxn > 8192)
-        {
-            tb_char_t* data = (tb_char_t*)tb_malloc(maxn);
-            tb_char_t const* cstr = data? tb_oc_json_escape_cstr(data, maxn, object) : tb_null;
-            if (cstr && tb_stream_printf(writer->stream, "\"%s\"", cstr) < 0) return tb_false;
-            tb_free(data);
-        }
-        else
-        {
-            tb_char_t data[8192];
-            tb_char_t const* cstr = tb_oc_json_escape_cstr(data, maxn, object);
-            if (cstr && tb_stream_printf(writer->stream, "\"%s\"", cstr) < 0) return tb_false;
-        }
-    }
-    else if (tb_stream_printf(writer->stream, "\"\"") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    // write
+    if (!tb_oc_json_writer_writ_escape(writer, tb_oc_string_cstr(object), tb_oc_string_size(object))) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     return tb_true;
 }
-static tb_bool_t tb_oc_json_writer_func_number(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_json_writer_writ_number(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
+    tb_bool_t ok = tb_true;
     switch (tb_oc_number_type(object))
     {
     case TB_OC_NUMBER_TYPE_UINT64:
-        if (tb_stream_printf(writer->stream, "%llu", tb_oc_number_uint64(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint64(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT64:
-        if (tb_stream_printf(writer->stream, "%lld", tb_oc_number_sint64(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint64(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT32:
-        if (tb_stream_printf(writer->stream, "%u", tb_oc_number_uint32(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint32(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT32:
-        if (tb_stream_printf(writer->stream, "%d", tb_oc_number_sint32(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint32(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT16:
-        if (tb_stream_printf(writer->stream, "%u", tb_oc_number_uint16(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint16(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT16:
-        if (tb_stream_printf(writer->stream, "%d", tb_oc_number_sint16(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint16(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT8:
-        if (tb_stream_printf(writer->stream, "%u", tb_oc_number_uint8(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint8(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT8:
-        if (tb_stream_printf(writer->stream, "%d", tb_oc_number_sint8(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint8(object));
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_OC_NUMBER_TYPE_FLOAT:
-        if (tb_stream_printf(writer->stream, "%f", tb_oc_number_float(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_double(&writer->buffer, tb_oc_number_float(object));
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
-        if (tb_stream_printf(writer->stream, "%lf", tb_oc_number_double(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_double(&writer->buffer, tb_oc_number_double(object));
         break;
 #endif
     default:
-        break;
+        return tb_true;
     }
-    return tb_true;
+
+    // write newline
+    return ok && tb_oc_writer_newline(&writer->buffer, writer->deflate);
 }
-static tb_bool_t tb_oc_json_writer_func_boolean(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_json_writer_writ_boolean(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
-    if (tb_stream_printf(writer->stream, "%s", tb_oc_boolean_bool(object)? "true" : "false") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, tb_oc_boolean_bool(object)? "true" : "false")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     return tb_true;
 }
-static tb_bool_t tb_oc_json_writer_func_dictionary(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_json_writer_writ_dictionary(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
     if (tb_oc_dictionary_size(object))
     {
         // write beg
-        if (tb_stream_printf(writer->stream, "{") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_char(&writer->buffer, '{')) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // walk
         tb_for_all (tb_oc_dictionary_item_t*, item, tb_oc_dictionary_itor(object))
@@ -252,46 +266,119 @@ static tb_bool_t tb_oc_json_writer_func_dictionary(tb_oc_json_writer_t* writer,
             if (item && item->key && item->val)
             {
                 // func
-                tb_oc_json_writer_func_t func = tb_oc_json_writer_func(item->val->type);
+                tb_oc_json_writer_func_t func = tb_oc_json_writer_func_cached(writer, item->val->type);
                 tb_assert_and_check_continue(func);
 
                 // write tab
                 if (item_itor != item_head)
                 {
-                    if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level, 2)) return tb_false;
-                    if (tb_stream_printf(writer->stream, ",") < 0) return tb_false;
-                    if (!tb_oc_writer_spaces(writer->stream, writer->deflate, 1, 1)) return tb_false;
+                    if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level, 2)) return tb_false;
+                    if (!tb_oc_writer_buffer_writ_char(&writer->buffer, ',')) return tb_false;
+                    if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, 1, 1)) return tb_false;
                 }
-                else if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level + 1, 2)) return tb_false;
+                else if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level + 1, 2)) return tb_false;
 
                 // write key
-                if (tb_stream_printf(writer->stream, "\"%s\":", item->key) < 0) return tb_false;
+                if (!tb_oc_json_writer_writ_escape(writer, item->key, tb_strlen(item->key))) return tb_false;
+                if (!tb_oc_writer_buffer_writ_char(&writer->buffer, ':')) return tb_false;
 
                 // write spaces
-                if (!writer->deflate) if (tb_stream_printf(writer->stream, " ") < 0) return tb_false;
+                if (!writer->deflate) if (!tb_oc_writer_buffer_writ_char(&writer->buffer, ' ')) return tb_false;
                 if (item->val->type == TB_OBJECT_TYPE_DICTIONARY || item->val->type == TB_OBJECT_TYPE_ARRAY)
                 {
-                    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
-                    if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level + 1, 2)) return tb_false;
+                    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
+                    if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level + 1, 2)) return tb_false;
                 }
 
                 // write value
-                if (!func(writer, item->val, level + 1)) return tb_false;
+                if (!tb_oc_json_writer_writ_value(writer, func, item->val, level + 1)) return tb_false;
             }
         }
 
         // write end
-        if (!tb_oc_writer_spaces(writer->stream, writer->deflate, level, 2)) return tb_false;
-        if (tb_stream_printf(writer->stream, "}") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_spaces(&writer->buffer, writer->deflate, level, 2)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_char(&writer->buffer, '}')) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
-        if (tb_stream_printf(writer->stream, "{}") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "{}")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     return tb_true;
 }
+static tb_bool_t tb_oc_json_writer_writ_value(tb_oc_json_writer_t* writer, tb_oc_json_writer_func_t func, tb_object_ref_t object, tb_size_t level)
+{
+    // write it to the buffer directly if be the builtin func
+    if (func == tb_oc_json_writer_func_string) return tb_oc_json_writer_writ_string(writer, object, level);
+    else if (func == tb_oc_json_writer_func_number) return tb_oc_json_writer_writ_number(writer, object, level);
+    else if (func == tb_oc_json_writer_func_dictionary) return tb_oc_json_writer_writ_dictionary(writer, object, level);
+    else if (func == tb_oc_json_writer_func_array) return tb_oc_json_writer_writ_array(writer, object, level);
+    else if (func == tb_oc_json_writer_func_boolean) return tb_oc_json_writer_writ_boolean(writer, object, level);
+    else if (func == tb_oc_json_writer_func_null) return tb_oc_json_writer_writ_null(writer, object, level);
+
+    // the hooked func will write the stream directly, so we need flush the buffered data first
+    writer->stream = tb_oc_writer_buffer_hook_enter(&writer->buffer);
+    tb_check_return_val(writer->stream, tb_false);
+
+    // write it
+    tb_bool_t ok = func(writer, object, level);
+    if (!tb_oc_writer_buffer_hook_leave(&writer->buffer)) ok = tb_false;
+    writer->stream = writer->buffer.stream;
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_oc_json_writer_func_null(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_null(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_json_writer_func_array(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_array(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_json_writer_func_string(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_string(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_json_writer_func_number(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_number(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_json_writer_func_boolean(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_boolean(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_json_writer_func_dictionary(tb_oc_json_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_json_writer_writ_dictionary(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
 static tb_long_t tb_oc_json_writer_done(tb_stream_ref_t stream, tb_object_ref_t object, tb_bool_t deflate)
 {
     // check
@@ -304,21 +391,50 @@ static tb_long_t tb_oc_json_writer_done(tb_stream_ref_t stream, tb_object_ref_t
 
     // func
     tb_oc_json_writer_func_t func = tb_oc_json_writer_func(object->type);
-    tb_assert_and_check_return_val(func, tb_false);
+    tb_assert_and_check_return_val(func, -1);
+
+    // init buffer
+    if (!tb_oc_writer_buffer_init(&writer.buffer, stream)) return -1;
 
     // the begin offset
     tb_hize_t bof = tb_stream_offset(stream);
 
-    // write
-    if (!func(&writer, object, 0)) return -1;
+    // write it and flush the buffered data
+    tb_bool_t ok = tb_oc_json_writer_writ_value(&writer, func, object, 0) && tb_oc_writer_buffer_flush(&writer.buffer);
+
+    // exit buffer
+    tb_oc_writer_buffer_exit(&writer.buffer);
 
     // sync
-    if (!tb_stream_sync(stream, tb_true)) return -1;
+    if (!ok || !tb_stream_sync(stream, tb_true)) return -1;
 
     // the end offset
     tb_hize_t eof = tb_stream_offset(stream);
     return eof >= bof? (tb_long_t)(eof - bof) : -1;
 }
+static tb_long_t tb_oc_json_writer_done_to_data(tb_byte_t* data, tb_size_t size, tb_object_ref_t object, tb_bool_t deflate)
+{
+    // check
+    tb_assert_and_check_return_val(object && data && size, -1);
+
+    // init writer
+    tb_oc_json_writer_t writer = {0};
+    writer.deflate  = deflate;
+
+    // func
+    tb_oc_json_writer_func_t func = tb_oc_json_writer_func(object->type);
+    tb_assert_and_check_return_val(func, -1);
+
+    // init buffer
+    if (!tb_oc_writer_buffer_init_from_data(&writer.buffer, data, size)) return -1;
+
+    // write it to the given data
+    tb_long_t writ = tb_oc_json_writer_writ_value(&writer, func, object, 0)? (tb_long_t)writer.buffer.size : -1;
+
+    // exit buffer
+    tb_oc_writer_buffer_exit(&writer.buffer);
+    return writ;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -329,7 +445,8 @@ tb_oc_writer_t* tb_oc_json_writer()
     static tb_oc_writer_t s_writer = {0};
 
     // init writer
-    s_writer.writ = tb_oc_json_writer_done;
+    s_writer.writ           = tb_oc_json_writer_done;
+    s_writer.writ_to_data   = tb_oc_json_writer_done_to_data;
 
     // init hooker
     s_writer.hooker = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_uint32(), tb_element_ptr(tb_null, tb_null));
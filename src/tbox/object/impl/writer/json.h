@@ -45,6 +45,12 @@ typedef struct __tb_oc_json_writer_t
     /// is deflate?
     tb_bool_t                   deflate;
 
+    /// the output buffer
+    tb_oc_writer_buffer_t       buffer;
+
+    /// the cached writer funcs of the builtin types
+    tb_cpointer_t               funcs[TB_OBJECT_TYPE_USER];
+
 }tb_oc_json_writer_t;
 
 /// the json writer func type
@@ -26,29 +26,24 @@
  * includes
  */
 #include "../prefix.h"
+#include "buffer.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
-static __tb_inline__ tb_bool_t tb_oc_writer_spaces(tb_stream_ref_t stream, tb_bool_t deflate, tb_size_t tab, tb_size_t width)
+static __tb_inline__ tb_bool_t tb_oc_writer_spaces(tb_oc_writer_buffer_t* buffer, tb_bool_t deflate, tb_size_t tab, tb_size_t width)
 {
     // write tab
-    if (!deflate)
-    {
-        tb_size_t spaces = tab * width;
-        while (spaces--) if (tb_stream_printf(stream, " ") < 0) return tb_false;
-    }
-    return tb_true;
+    return !deflate? tb_oc_writer_buffer_writ_spaces(buffer, tab * width) : tb_true;
 }
-static __tb_inline__ tb_bool_t tb_oc_writer_tab(tb_stream_ref_t stream, tb_bool_t deflate, tb_size_t tab)
+static __tb_inline__ tb_bool_t tb_oc_writer_tab(tb_oc_writer_buffer_t* buffer, tb_bool_t deflate, tb_size_t tab)
 {
-    return tb_oc_writer_spaces(stream, deflate, tab, 4);
+    return tb_oc_writer_spaces(buffer, deflate, tab, 4);
 }
-static __tb_inline__ tb_bool_t tb_oc_writer_newline(tb_stream_ref_t stream, tb_bool_t deflate)
+static __tb_inline__ tb_bool_t tb_oc_writer_newline(tb_oc_writer_buffer_t* buffer, tb_bool_t deflate)
 {
     // write newline
-    if (!deflate && tb_stream_printf(stream, __tb_newline__) < 0) return tb_false;
-    return tb_true;
+    return !deflate? tb_oc_writer_buffer_writ(buffer, (tb_byte_t const*)__tb_newline__, sizeof(__tb_newline__) - 1) : tb_true;
 }
 static __tb_inline__ tb_bool_t tb_oc_writer_bin_type_size(tb_stream_ref_t stream, tb_size_t type, tb_uint64_t size)
 {
@@ -88,3 +88,31 @@ tb_long_t tb_oc_writer_done(tb_object_ref_t object, tb_stream_ref_t stream, tb_s
     // writ it
     return writer->writ(stream, object, (format & TB_OBJECT_FORMAT_DEFLATE)? tb_true : tb_false);
 }
+tb_long_t tb_oc_writer_done_to_data(tb_object_ref_t object, tb_byte_t* data, tb_size_t size, tb_size_t format)
+{
+    // check
+    tb_assert_and_check_return_val(object && data && size, -1);
+
+    // the writer
+    tb_oc_writer_t* writer = tb_oc_writer_get(format);
+    tb_assert_and_check_return_val(writer && writer->writ, -1);
+
+    // writ it to the given data directly
+    tb_bool_t deflate = (format & TB_OBJECT_FORMAT_DEFLATE)? tb_true : tb_false;
+    if (writer->writ_to_data) return writer->writ_to_data(data, size, object, deflate);
+
+    // make stream
+    tb_long_t           writ = -1;
+    tb_stream_ref_t     stream = tb_stream_init_from_data(data, size);
+    if (stream)
+    {
+        // open and writ stream
+        if (tb_stream_open(stream)) writ = writer->writ(stream, object, deflate);
+
+        // exit stream
+        tb_stream_exit(stream);
+    }
+
+    // ok?
+    return writ;
+}
@@ -73,6 +73,19 @@ tb_void_t           tb_oc_writer_remove(tb_size_t format);
  */
 tb_long_t           tb_oc_writer_done(tb_object_ref_t object, tb_stream_ref_t stream, tb_size_t format);
 
+/*! done writer to the given data
+ *
+ * it will write the data directly without stream if the writer supports it
+ *
+ * @param object    the object
+ * @param data      the data
+ * @param size      the data size
+ * @param format    the object format
+ *
+ * @return          the writed size, failed: -1
+ */
+tb_long_t           tb_oc_writer_done_to_data(tb_object_ref_t object, tb_byte_t* data, tb_size_t size, tb_size_t format);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -34,74 +34,88 @@
 #include "../../../algorithm/algorithm.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * declaration
  */
-static tb_bool_t tb_oc_xml_writer_func_null(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
-{
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+static tb_bool_t tb_oc_xml_writer_func_null(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_date(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_data(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_array(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_string(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_number(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_boolean(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_func_dictionary(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level);
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * writer implementation
+ */
+static __tb_inline__ tb_oc_xml_writer_func_t tb_oc_xml_writer_func_cached(tb_oc_xml_writer_t* writer, tb_size_t type)
+{
+    // the builtin type? we cache it to avoid looking up the hooker for each object
+    if (type < tb_arrayn(writer->funcs))
+    {
+        if (!writer->funcs[type]) writer->funcs[type] = (tb_cpointer_t)tb_oc_xml_writer_func(type);
+        return (tb_oc_xml_writer_func_t)writer->funcs[type];
+    }
+    return tb_oc_xml_writer_func(type);
+}
+static tb_bool_t tb_oc_xml_writer_writ_value(tb_oc_xml_writer_t* writer, tb_oc_xml_writer_func_t func, tb_object_ref_t object, tb_size_t level);
+static tb_bool_t tb_oc_xml_writer_writ_null(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
     // write
-    if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-    if (tb_stream_printf(writer->stream, "<null/>") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<null/>")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_date(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_date(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // no empty?
     tb_time_t time = tb_oc_date_time(object);
     if (time > 0)
     {
         // write begin
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date>") < 0) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<date>")) return tb_false;
 
         // write date
         tb_tm_t date = {0};
         if (tb_localtime(time, &date))
         {
-            if (tb_stream_printf(writer->stream,  "%04ld-%02ld-%02ld %02ld:%02ld:%02ld"
-                                ,   date.year
-                                ,   date.month
-                                ,   date.mday
-                                ,   date.hour
-                                ,   date.minute
-                                ,   date.second) < 0) return tb_false;
+            if (!tb_oc_writer_buffer_printf(&writer->buffer,  "%04ld-%02ld-%02ld %02ld:%02ld:%02ld"
+                                        ,   date.year
+                                        ,   date.month
+                                        ,   date.mday
+                                        ,   date.hour
+                                        ,   date.minute
+                                        ,   date.second)) return tb_false;
         }
 
         // write end
-        if (tb_stream_printf(writer->stream, "</date>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</date>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
         // write
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<date/>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<date/>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_data(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_data(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // no empty?
     if (tb_oc_data_size(object))
     {
         // write begin
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<data>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // decode base64 data
         tb_byte_t const*    ib = (tb_byte_t const*)tb_oc_data_getp(object);
@@ -112,18 +126,19 @@ static tb_bool_t tb_oc_xml_writer_func_data(tb_oc_xml_writer_t* writer, tb_objec
         on = tb_base64_encode(ib, in, ob, on);
         tb_trace_d("base64: %u => %u", in, on);
 
-        // write data
+        // write data for each line
         tb_char_t const*    p = ob;
         tb_char_t const*    e = ob + on;
-        tb_size_t           n = 0;
-        for (; p < e && *p; p++, n++)
+        while (p < e)
         {
-            if (!(n & 63))
-            {
-                if (n) if (!tb_oc_writer_newline(writer->stream, writer->deflate)) break;
-                if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) break;
-            }
-            if (tb_stream_printf(writer->stream, "%c", *p) < 0) break;
+            // the line size
+            tb_size_t n = tb_min(e - p, 64);
+
+            // write line
+            if (p != ob) if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) break;
+            if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) break;
+            if (!tb_oc_writer_buffer_writ(&writer->buffer, (tb_byte_t const*)p, n)) break;
+            p += n;
         }
 
         // free the data
@@ -133,36 +148,33 @@ static tb_bool_t tb_oc_xml_writer_func_data(tb_oc_xml_writer_t* writer, tb_objec
         tb_check_return_val(p == e, tb_false);
 
         // write newline
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // write end
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</data>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</data>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
         // write
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<data/>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<data/>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_array(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_array(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
     if (tb_oc_array_size(object))
     {
         // write begin
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<array>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // walk
         tb_for_all (tb_object_ref_t, item, tb_oc_array_itor(object))
@@ -171,138 +183,125 @@ static tb_bool_t tb_oc_xml_writer_func_array(tb_oc_xml_writer_t* writer, tb_obje
             if (item)
             {
                 // func
-                tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func(item->type);
+                tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func_cached(writer, item->type);
                 tb_assert_and_check_continue(func);
 
                 // write
-                if (!func(writer, item, level + 1)) return tb_false;
+                if (!tb_oc_xml_writer_writ_value(writer, func, item, level + 1)) return tb_false;
             }
         }
 
         // write end
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</array>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</array>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<array/>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<array/>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_string(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_string(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
-    if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
+    if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
     if (tb_oc_string_size(object))
     {
-        if (tb_stream_printf(writer->stream, "<string>%s</string>", tb_oc_string_cstr(object)) < 0) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<string>")) return tb_false;
+        if (!tb_oc_writer_buffer_writ(&writer->buffer, (tb_byte_t const*)tb_oc_string_cstr(object), tb_oc_string_size(object))) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</string>")) return tb_false;
     }
-    else if (tb_stream_printf(writer->stream, "<string/>") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    else if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<string/>")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_number(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_number(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+    // check type
+    tb_size_t type = tb_oc_number_type(object);
+    tb_check_return_val(type != TB_OC_NUMBER_TYPE_NONE, tb_true);
+#ifndef TB_CONFIG_TYPE_HAVE_FLOAT
+    tb_check_return_val(type != TB_OC_NUMBER_TYPE_FLOAT && type != TB_OC_NUMBER_TYPE_DOUBLE, tb_true);
+#endif
 
-    // write
-    switch (tb_oc_number_type(object))
+    // write begin
+    if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<number>")) return tb_false;
+
+    // write value
+    tb_bool_t ok = tb_false;
+    switch (type)
     {
     case TB_OC_NUMBER_TYPE_UINT64:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%llu</number>", tb_oc_number_uint64(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint64(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT64:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lld</number>", tb_oc_number_sint64(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint64(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT32:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_oc_number_uint32(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint32(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT32:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_oc_number_sint32(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint32(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT16:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_oc_number_uint16(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint16(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT16:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_oc_number_sint16(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint16(object));
         break;
     case TB_OC_NUMBER_TYPE_UINT8:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%u</number>", tb_oc_number_uint8(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_uint64(&writer->buffer, tb_oc_number_uint8(object));
         break;
     case TB_OC_NUMBER_TYPE_SINT8:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%d</number>", tb_oc_number_sint8(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_sint64(&writer->buffer, tb_oc_number_sint8(object));
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_OC_NUMBER_TYPE_FLOAT:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%f</number>", tb_oc_number_float(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_double(&writer->buffer, tb_oc_number_float(object));
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lf</number>", tb_oc_number_double(object)) < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        ok = tb_oc_writer_buffer_writ_double(&writer->buffer, tb_oc_number_double(object));
         break;
 #endif
     default:
         break;
     }
+    tb_check_return_val(ok, tb_false);
+
+    // write end
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</number>")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_boolean(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_boolean(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
-    if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-    if (tb_stream_printf(writer->stream, "<%s/>", tb_oc_boolean_bool(object)? "true" : "false") < 0) return tb_false;
-    if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+    if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, tb_oc_boolean_bool(object)? "<true/>" : "<false/>")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
     // ok
     return tb_true;
 }
-static tb_bool_t tb_oc_xml_writer_func_dictionary(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+static tb_bool_t tb_oc_xml_writer_writ_dictionary(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
 {
-    // check
-    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
-
     // write
     if (tb_oc_dictionary_size(object))
     {
         // write begin
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<dict>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
         // walk
         tb_for_all (tb_oc_dictionary_item_t*, item, tb_oc_dictionary_itor(object))
@@ -311,34 +310,139 @@ static tb_bool_t tb_oc_xml_writer_func_dictionary(tb_oc_xml_writer_t* writer, tb
             if (item && item->key && item->val)
             {
                 // func
-                tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func(item->val->type);
+                tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func_cached(writer, item->val->type);
                 tb_assert_and_check_continue(func);
 
                 // write key
-                if (!tb_oc_writer_tab(writer->stream, writer->deflate, level + 1)) return tb_false;
-                if (tb_stream_printf(writer->stream, "<key>%s</key>", item->key) < 0) return tb_false;
-                if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+                if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level + 1)) return tb_false;
+                if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<key>")) return tb_false;
+                if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, item->key)) return tb_false;
+                if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</key>")) return tb_false;
+                if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
 
                 // write value
-                if (!func(writer, item->val, level + 1)) return tb_false;
+                if (!tb_oc_xml_writer_writ_value(writer, func, item->val, level + 1)) return tb_false;
             }
         }
 
         // write end
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "</dict>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "</dict>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
     else
     {
-        if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<dict/>") < 0) return tb_false;
-        if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
+        if (!tb_oc_writer_tab(&writer->buffer, writer->deflate, level)) return tb_false;
+        if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<dict/>")) return tb_false;
+        if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
     }
 
     // ok
     return tb_true;
 }
+static tb_bool_t tb_oc_xml_writer_writ_value(tb_oc_xml_writer_t* writer, tb_oc_xml_writer_func_t func, tb_object_ref_t object, tb_size_t level)
+{
+    // write it to the buffer directly if be the builtin func
+    if (func == tb_oc_xml_writer_func_string) return tb_oc_xml_writer_writ_string(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_number) return tb_oc_xml_writer_writ_number(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_dictionary) return tb_oc_xml_writer_writ_dictionary(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_array) return tb_oc_xml_writer_writ_array(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_boolean) return tb_oc_xml_writer_writ_boolean(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_data) return tb_oc_xml_writer_writ_data(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_date) return tb_oc_xml_writer_writ_date(writer, object, level);
+    else if (func == tb_oc_xml_writer_func_null) return tb_oc_xml_writer_writ_null(writer, object, level);
+
+    // the hooked func will write the stream directly, so we need flush the buffered data first
+    writer->stream = tb_oc_writer_buffer_hook_enter(&writer->buffer);
+    tb_check_return_val(writer->stream, tb_false);
+
+    // write it
+    tb_bool_t ok = func(writer, object, level);
+    if (!tb_oc_writer_buffer_hook_leave(&writer->buffer)) ok = tb_false;
+    writer->stream = writer->buffer.stream;
+    return ok;
+}
+static tb_bool_t tb_oc_xml_writer_writ_root(tb_oc_xml_writer_t* writer, tb_object_ref_t object)
+{
+    // func
+    tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func(object->type);
+    tb_assert_and_check_return_val(func, tb_false);
+
+    // write xml header
+    if (!tb_oc_writer_buffer_writ_cstr(&writer->buffer, "<?xml version=\"2.0\" encoding=\"utf-8\"?>")) return tb_false;
+    if (!tb_oc_writer_newline(&writer->buffer, writer->deflate)) return tb_false;
+
+    // write
+    return tb_oc_xml_writer_writ_value(writer, func, object, 0);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_oc_xml_writer_func_null(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_null(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_date(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_date(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_data(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_data(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_array(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_array(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_string(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_string(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_number(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_number(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_boolean(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_boolean(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
+static tb_bool_t tb_oc_xml_writer_func_dictionary(tb_oc_xml_writer_t* writer, tb_object_ref_t object, tb_size_t level)
+{
+    // check
+    tb_assert_and_check_return_val(writer && writer->stream, tb_false);
+
+    // write it and flush the buffered data
+    return tb_oc_xml_writer_writ_dictionary(writer, object, level) && tb_oc_writer_buffer_flush(&writer->buffer);
+}
 static tb_long_t tb_oc_xml_writer_done(tb_stream_ref_t stream, tb_object_ref_t object, tb_bool_t deflate)
 {
     // check
@@ -348,23 +452,19 @@ static tb_long_t tb_oc_xml_writer_done(tb_stream_ref_t stream, tb_object_ref_t o
     tb_oc_xml_writer_t writer = {0};
     writer.stream   = stream;
     writer.deflate  = deflate;
-
-    // func
-    tb_oc_xml_writer_func_t func = tb_oc_xml_writer_func(object->type);
-    tb_assert_and_check_return_val(func, -1);
+    if (!tb_oc_writer_buffer_init(&writer.buffer, stream)) return -1;
 
     // the begin offset
     tb_hize_t bof = tb_stream_offset(stream);
 
-    // write xml header
-    if (tb_stream_printf(stream, "<?xml version=\"2.0\" encoding=\"utf-8\"?>") < 0) return -1;
-    if (!tb_oc_writer_newline(stream, deflate)) return -1;
+    // write it and flush the buffered data
+    tb_bool_t ok = tb_oc_xml_writer_writ_root(&writer, object) && tb_oc_writer_buffer_flush(&writer.buffer);
 
-    // write
-    if (!func(&writer, object, 0)) return -1;
+    // exit buffer
+    tb_oc_writer_buffer_exit(&writer.buffer);
 
     // sync
-    if (!tb_stream_sync(stream, tb_true)) return -1;
+    if (!ok || !tb_stream_sync(stream, tb_true)) return -1;
 
     // the end offset
     tb_hize_t eof = tb_stream_offset(stream);
@@ -372,6 +472,25 @@ static tb_long_t tb_oc_xml_writer_done(tb_stream_ref_t stream, tb_object_ref_t o
     // ok?
     return eof >= bof? (tb_long_t)(eof - bof) : -1;
 }
+static tb_long_t tb_oc_xml_writer_done_to_data(tb_byte_t* data, tb_size_t size, tb_object_ref_t object, tb_bool_t deflate)
+{
+    // check
+    tb_assert_and_check_return_val(object && data && size, -1);
+
+    // init writer
+    tb_oc_xml_writer_t writer = {0};
+    writer.deflate  = deflate;
+    if (!tb_oc_writer_buffer_init_from_data(&writer.buffer, data, size)) return -1;
+
+    // write it to the given data
+    tb_long_t writ = tb_oc_xml_writer_writ_root(&writer, object)? (tb_long_t)writer.buffer.size : -1;
+
+    // exit buffer
+    tb_oc_writer_buffer_exit(&writer.buffer);
+
+    // ok?
+    return writ;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -382,7 +501,8 @@ tb_oc_writer_t* tb_oc_xml_writer()
     static tb_oc_writer_t s_writer = {0};
 
     // init writer
-    s_writer.writ = tb_oc_xml_writer_done;
+    s_writer.writ           = tb_oc_xml_writer_done;
+    s_writer.writ_to_data   = tb_oc_xml_writer_done_to_data;
 
     // init hooker
     s_writer.hooker = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_uint32(), tb_element_ptr(tb_null, tb_null));
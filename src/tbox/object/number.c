@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -187,13 +188,10 @@ static tb_oc_number_t* tb_oc_number_init_base()
     tb_oc_number_t* number = tb_null;
     do
     {
-        // make number
-        number = tb_malloc0_type(tb_oc_number_t);
+        // make number, it will be placed in the arena if we are reading an arena tree
+        number = (tb_oc_number_t*)tb_oc_arena_object_init(sizeof(tb_oc_number_t), TB_OBJECT_TYPE_NUMBER);
         tb_assert_and_check_break(number);
 
-        // init number
-        if (!tb_object_init((tb_object_ref_t)number, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_NUMBER)) break;
-
         // init base
         number->base.copy   = tb_oc_number_copy;
         number->base.exit   = tb_oc_number_exit;
@@ -32,6 +32,37 @@
 #include "object.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_object_ref_t tb_object_read_arena_done(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream && tb_stream_type(stream) == TB_STREAM_TYPE_DATA, tb_null);
+
+    // init arena
+    tb_oc_arena_ref_t arena = tb_oc_arena_init();
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    /* read the tree into the arena
+     *
+     * the current arena is thread-local, so we only read it from the memory stream here,
+     * it will be never suspended and resumed on the other thread when we are in coroutine.
+     */
+    tb_oc_arena_ref_t   prev = tb_oc_arena_enter(arena);
+    tb_object_ref_t     object = tb_oc_reader_done(stream);
+    tb_oc_arena_leave(arena, prev);
+
+    /* exit arena if failed or the root is not in the arena, .e.g the boolean singleton
+     *
+     * otherwise the root owns the arena and it will be exited when the root is released
+     */
+    if (!object || tb_oc_arena_from_object(object) != arena) tb_oc_arena_exit(arena);
+
+    // ok?
+    return object;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -57,6 +88,13 @@ tb_void_t tb_object_exit(tb_object_ref_t object)
     // readonly?
     tb_check_return(!(object->flag & TB_OBJECT_FLAG_READONLY));
 
+    // in the arena? release the whole tree
+    if (object->flag & TB_OBJECT_FLAG_ARENA)
+    {
+        tb_oc_arena_release(tb_oc_arena_from_object(object));
+        return ;
+    }
+
     // check refn
     tb_assert_and_check_return(object->refn);
 
@@ -277,6 +315,9 @@ tb_size_t tb_object_refn(tb_object_ref_t object)
     // check
     tb_assert_and_check_return_val(object, 0);
 
+    // in the arena? get the reference count of the whole tree
+    if (object->flag & TB_OBJECT_FLAG_ARENA) return tb_oc_arena_refn(tb_oc_arena_from_object(object));
+
     // get it
     return object->refn;
 }
@@ -288,6 +329,13 @@ tb_void_t tb_object_retain(tb_object_ref_t object)
     // readonly?
     tb_check_return(!(object->flag & TB_OBJECT_FLAG_READONLY));
 
+    // in the arena? retain the whole tree
+    if (object->flag & TB_OBJECT_FLAG_ARENA)
+    {
+        tb_oc_arena_retain(tb_oc_arena_from_object(object));
+        return ;
+    }
+
     // refn++
     object->refn++;
 }
@@ -311,6 +359,9 @@ tb_object_ref_t tb_object_read_from_url(tb_char_t const* url)
     tb_stream_ref_t stream = tb_stream_init_from_url(url);
     tb_assert_and_check_return_val(stream, tb_null);
 
+    // map the file, the readers will peek data from the mapping directly
+    if (tb_stream_type(stream) == TB_STREAM_TYPE_FILE) tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_MMAP, tb_true);
+
     // read object
     if (tb_stream_open(stream)) object = tb_object_read(stream);
 
@@ -341,6 +392,49 @@ tb_object_ref_t tb_object_read_from_data(tb_byte_t const* data, tb_size_t size)
     // ok?
     return object;
 }
+tb_object_ref_t tb_object_read_arena(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read it from the memory stream directly
+    if (tb_stream_type(stream) == TB_STREAM_TYPE_DATA) return tb_object_read_arena_done(stream);
+
+    // read all data first, the file or socket stream may be suspended in coroutine
+    tb_size_t   size = 0;
+    tb_byte_t*  data = tb_stream_bread_all(stream, tb_false, &size);
+    tb_check_return_val(data, tb_null);
+
+    // read object
+    tb_object_ref_t object = size? tb_object_read_arena_from_data(data, size) : tb_null;
+
+    // exit data
+    tb_free(data);
+
+    // ok?
+    return object;
+}
+tb_object_ref_t tb_object_read_arena_from_data(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_null);
+
+    // init
+    tb_object_ref_t object = tb_null;
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_data(data, size);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read object
+    if (tb_stream_open(stream)) object = tb_object_read_arena_done(stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
 tb_long_t tb_object_writ(tb_object_ref_t object, tb_stream_ref_t stream, tb_size_t format)
 {
     // check
@@ -383,19 +477,12 @@ tb_long_t tb_object_writ_to_data(tb_object_ref_t object, tb_byte_t* data, tb_siz
     // check
     tb_assert_and_check_return_val(object && data && size, -1);
 
-    // make stream
-    tb_long_t           writ = -1;
-    tb_stream_ref_t     stream = tb_stream_init_from_data(data, size);
-    if (stream)
-    {
-        // open and writ stream
-        if (tb_stream_open(stream)) writ = tb_object_writ(object, stream, format);
-
-        // exit stream
-        tb_stream_exit(stream);
-    }
+    // for xml
+#ifndef TB_CONFIG_MODULE_HAVE_XML
+    tb_assertf(format != TB_OBJECT_FORMAT_XML || format != TB_OBJECT_FORMAT_XPLIST, "please enable xml module first!");
+#endif
 
-    // ok?
-    return writ;
+    // writ it
+    return tb_oc_writer_done_to_data(object, data, size, format);
 }
 
@@ -109,6 +109,46 @@ tb_object_ref_t     tb_object_read_from_url(tb_char_t const* url);
  */
 tb_object_ref_t     tb_object_read_from_data(tb_byte_t const* data, tb_size_t size);
 
+/*! read object tree into an arena
+ *
+ * all objects of the tree, the dictionary keys, the array items and the string data
+ * are bump-allocated from one arena instead of allocating them one by one,
+ * and the whole tree will be freed at once when the root is released.
+ *
+ * the objects of the tree share the reference count of the root,
+ * so retaining any child will keep the whole tree alive.
+ *
+ * @note the arena containers only can hold the objects of the same tree and the boolean/null objects,
+ * please use tb_object_copy() to get a heap container if you want to insert other objects.
+ *
+ * @note the data of the non-memory stream will be read into memory first before building the tree.
+ *
+ * @code
+    tb_object_ref_t root = tb_object_read_arena(stream);
+    if (root)
+    {
+        // ...
+
+        // free the whole tree
+        tb_object_exit(root);
+    }
+ * @endcode
+ *
+ * @param stream    the stream
+ *
+ * @return          the root object
+ */
+tb_object_ref_t     tb_object_read_arena(tb_stream_ref_t stream);
+
+/*! read object tree into an arena from data
+ *
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the root object
+ */
+tb_object_ref_t     tb_object_read_arena_from_data(tb_byte_t const* data, tb_size_t size);
+
 /*! writ object
  *
  * @param object    the object
@@ -54,6 +54,7 @@ typedef enum __tb_object_flag_e
     TB_OBJECT_FLAG_NONE         = 0
 ,   TB_OBJECT_FLAG_READONLY     = 1
 ,   TB_OBJECT_FLAG_SINGLETON    = 2
+,   TB_OBJECT_FLAG_ARENA        = 4 //!< the object is placed in an arena and shares the reference count of the whole tree
 
 }tb_object_flag_e;
 
@@ -30,6 +30,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../string/string.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -90,6 +91,12 @@ static tb_void_t tb_oc_string_clear(tb_object_ref_t object)
         tb_string_clear(&string->str);
     }
 }
+static tb_bool_t tb_oc_string_need(tb_oc_string_t* string, tb_size_t size)
+{
+    // in the arena? the string data need be placed in it too
+    tb_oc_arena_ref_t arena = tb_oc_arena_from_object((tb_object_ref_t)string);
+    return arena? tb_oc_arena_buffer_need(arena, &string->str, size + 1) : tb_true;
+}
 static tb_oc_string_t* tb_oc_string_init_base()
 {
     // done
@@ -97,13 +104,10 @@ static tb_oc_string_t* tb_oc_string_init_base()
     tb_oc_string_t* string = tb_null;
     do
     {
-        // make string
-        string = tb_malloc0_type(tb_oc_string_t);
+        // make string, it will be placed in the arena if we are reading an arena tree
+        string = (tb_oc_string_t*)tb_oc_arena_object_init(sizeof(tb_oc_string_t), TB_OBJECT_TYPE_STRING);
         tb_assert_and_check_break(string);
 
-        // init string
-        if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_STRING)) break;
-
         // init base
         string->base.copy   = tb_oc_string_copy;
         string->base.exit   = tb_oc_string_exit;
@@ -144,7 +148,11 @@ tb_object_ref_t tb_oc_string_init_from_cstr(tb_char_t const* cstr)
         if (!tb_string_init(&string->str)) break;
 
         // copy string
-        if (cstr) tb_string_cstrcpy(&string->str, cstr);
+        if (cstr)
+        {
+            if (!tb_oc_string_need(string, tb_strlen(cstr))) break;
+            tb_string_cstrcpy(&string->str, cstr);
+        }
 
         // ok
         ok = tb_true;
@@ -155,7 +163,7 @@ tb_object_ref_t tb_oc_string_init_from_cstr(tb_char_t const* cstr)
     if (!ok)
     {
         // exit it
-        tb_oc_string_exit((tb_object_ref_t)string);
+        if (string) tb_object_exit((tb_object_ref_t)string);
         string = tb_null;
     }
 
@@ -177,7 +185,11 @@ tb_object_ref_t tb_oc_string_init_from_str(tb_string_ref_t str)
         if (!tb_string_init(&string->str)) break;
 
         // copy string
-        if (str) tb_string_strcpy(&string->str, str);
+        if (str)
+        {
+            if (!tb_oc_string_need(string, tb_string_size(str))) break;
+            tb_string_strcpy(&string->str, str);
+        }
 
         // ok
         ok = tb_true;
@@ -188,7 +200,7 @@ tb_object_ref_t tb_oc_string_init_from_str(tb_string_ref_t str)
     if (!ok)
     {
         // exit it
-        tb_oc_string_exit((tb_object_ref_t)string);
+        if (string) tb_object_exit((tb_object_ref_t)string);
         string = tb_null;
     }
 
@@ -211,6 +223,7 @@ tb_size_t tb_oc_string_cstr_set(tb_object_ref_t object, tb_char_t const* cstr)
     tb_assert_and_check_return_val(string && cstr, 0);
 
     // copy string
+    if (!tb_oc_string_need(string, tb_strlen(cstr))) return 0;
     tb_string_cstrcpy(&string->str, cstr);
 
     // ok?
@@ -24,6 +24,84 @@
  */
 #include "prefix.h"
 #include "cpu.h"
+#include "atomic.h"
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && \
+        (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG))
+#   include <cpuid.h>
+#   define TB_CPU_HAVE_CPUID
+#elif (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_COMPILER_IS_MSVC)
+#   define TB_CPU_HAVE_CPUID
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CPU_HAVE_CPUID
+static tb_void_t tb_cpu_cpuid(tb_uint32_t leaf, tb_uint32_t subleaf, tb_uint32_t regs[4])
+{
+#ifdef TB_COMPILER_IS_MSVC
+    tb_int_t info[4];
+    __cpuidex(info, (tb_int_t)leaf, (tb_int_t)subleaf);
+    regs[0] = (tb_uint32_t)info[0];
+    regs[1] = (tb_uint32_t)info[1];
+    regs[2] = (tb_uint32_t)info[2];
+    regs[3] = (tb_uint32_t)info[3];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+static tb_uint64_t tb_cpu_xgetbv(tb_uint32_t index)
+{
+#ifdef TB_COMPILER_IS_MSVC
+    return _xgetbv(index);
+#else
+    // old "as" does not support "xgetbv" opcode
+    tb_uint32_t eax = 0;
+    tb_uint32_t edx = 0;
+    __tb_asm__ __tb_volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (index));
+    return ((tb_uint64_t)edx << 32) | eax;
+#endif
+}
+static tb_size_t tb_cpu_features_detect()
+{
+    // get the maximum leaf
+    tb_uint32_t regs[4] = {0};
+    tb_cpu_cpuid(0, 0, regs);
+    tb_uint32_t maxleaf = regs[0];
+    tb_check_return_val(maxleaf >= 1, TB_CPU_FEATURE_NONE);
+
+    // get the features of the leaf 1
+    tb_size_t features = TB_CPU_FEATURE_NONE;
+    tb_cpu_cpuid(1, 0, regs);
+    tb_uint32_t ecx = regs[2];
+    tb_uint32_t edx = regs[3];
+    if (edx & (1 << 26)) features |= TB_CPU_FEATURE_SSE2;
+    if (ecx & (1 << 9))  features |= TB_CPU_FEATURE_SSSE3;
+    if (ecx & (1 << 19)) features |= TB_CPU_FEATURE_SSE41;
+    if (ecx & (1 << 20)) features |= TB_CPU_FEATURE_SSE42;
+    if (ecx & (1 << 23)) features |= TB_CPU_FEATURE_POPCNT;
+    if (ecx & (1 << 1))  features |= TB_CPU_FEATURE_PCLMUL;
+
+    /* the ymm registers can be used only if the os saves them on the context switch,
+     * so we need check osxsave and the xcr0 register
+     */
+    tb_bool_t ymm = tb_false;
+    if ((ecx & (1 << 27)) && (ecx & (1 << 28)))
+        ymm = (tb_cpu_xgetbv(0) & 0x6) == 0x6;
+    if (ymm) features |= TB_CPU_FEATURE_AVX;
+
+    // get the extended features of the leaf 7
+    if (maxleaf >= 7)
+    {
+        tb_cpu_cpuid(7, 0, regs);
+        tb_uint32_t ebx = regs[1];
+        if (ymm && (ebx & (1 << 5))) features |= TB_CPU_FEATURE_AVX2;
+        if (ebx & (1 << 8))  features |= TB_CPU_FEATURE_BMI2;
+        if (ebx & (1 << 29)) features |= TB_CPU_FEATURE_SHA;
+    }
+    return features;
+}
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -39,3 +117,19 @@ tb_size_t tb_cpu_count()
 }
 #endif
 
+tb_size_t tb_cpu_features()
+{
+#ifdef TB_CPU_HAVE_CPUID
+    // we will pre-initialize it in tb_platform_init()
+    static tb_atomic_t s_features = -1;
+    tb_size_t features = (tb_size_t)tb_atomic_get_explicit(&s_features, TB_ATOMIC_RELAXED);
+    if (features == (tb_size_t)-1)
+    {
+        features = tb_cpu_features_detect();
+        tb_atomic_set_explicit(&s_features, (tb_long_t)features, TB_ATOMIC_RELAXED);
+    }
+    return features;
+#else
+    return TB_CPU_FEATURE_NONE;
+#endif
+}
@@ -73,6 +73,27 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the cpu feature enum
+typedef enum __tb_cpu_feature_e
+{
+    TB_CPU_FEATURE_NONE         = 0
+,   TB_CPU_FEATURE_SSE2         = 1 << 0    //!< x86: sse2
+,   TB_CPU_FEATURE_SSSE3        = 1 << 1    //!< x86: ssse3
+,   TB_CPU_FEATURE_SSE41        = 1 << 2    //!< x86: sse4.1
+,   TB_CPU_FEATURE_SSE42        = 1 << 3    //!< x86: sse4.2
+,   TB_CPU_FEATURE_POPCNT       = 1 << 4    //!< x86: popcnt
+,   TB_CPU_FEATURE_PCLMUL       = 1 << 5    //!< x86: pclmulqdq
+,   TB_CPU_FEATURE_AVX          = 1 << 6    //!< x86: avx, the ymm state has been enabled by the os
+,   TB_CPU_FEATURE_AVX2         = 1 << 7    //!< x86: avx2, the ymm state has been enabled by the os
+,   TB_CPU_FEATURE_BMI2         = 1 << 8    //!< x86: bmi2
+,   TB_CPU_FEATURE_SHA          = 1 << 9    //!< x86: sha extensions
+
+}tb_cpu_feature_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -83,6 +104,21 @@ __tb_extern_c_enter__
  */
 tb_size_t               tb_cpu_count(tb_noarg_t);
 
+/*! the features of the current cpu
+ *
+ * it's detected once and cached, we will pre-initialize it in tb_platform_init()
+ *
+ * @code
+ * if (tb_cpu_features() & TB_CPU_FEATURE_AVX2)
+ * {
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @return              the feature flags, @see tb_cpu_feature_e
+ */
+tb_size_t               tb_cpu_features(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,91 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "filemap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#if defined(TB_CONFIG_OS_WINDOWS) && !defined(TB_COMPILER_LIKE_UNIX)
+#   include "windows/filemap.c"
+#elif defined(TB_CONFIG_POSIX_HAVE_MMAP)
+#   include "posix/filemap.c"
+#else
+tb_filemap_ref_t tb_filemap_init_from_file(tb_file_ref_t file, tb_size_t mode)
+{
+    tb_trace_noimpl();
+    return tb_null;
+}
+tb_void_t tb_filemap_exit(tb_filemap_ref_t filemap)
+{
+    tb_trace_noimpl();
+}
+tb_byte_t* tb_filemap_data(tb_filemap_ref_t filemap)
+{
+    tb_trace_noimpl();
+    return tb_null;
+}
+tb_size_t tb_filemap_size(tb_filemap_ref_t filemap)
+{
+    tb_trace_noimpl();
+    return 0;
+}
+tb_bool_t tb_filemap_advise(tb_filemap_ref_t filemap, tb_size_t advice, tb_size_t offset, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+tb_bool_t tb_filemap_sync(tb_filemap_ref_t filemap, tb_size_t offset, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_filemap_ref_t tb_filemap_init(tb_char_t const* path, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(path, tb_null);
+
+    // only supports the readonly and readwrite mode
+    mode &= (TB_FILE_MODE_RO | TB_FILE_MODE_RW);
+    tb_assert_and_check_return_val(mode, tb_null);
+
+    // open file
+    tb_file_ref_t file = tb_file_init(path, mode);
+    tb_check_return_val(file, tb_null);
+
+    // map it, the mapping is still valid after closing the file
+    tb_filemap_ref_t filemap = tb_filemap_init_from_file(file, mode);
+
+    // exit file
+    tb_file_exit(file);
+
+    // ok?
+    return filemap;
+}
@@ -0,0 +1,139 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_FILEMAP_H
+#define TB_PLATFORM_FILEMAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "file.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the file map ref type
+typedef __tb_typeref__(filemap);
+
+/// the file map advice enum
+typedef enum __tb_filemap_advice_e
+{
+    TB_FILEMAP_ADVICE_NORMAL        = 0     //!< no special treatment
+,   TB_FILEMAP_ADVICE_SEQUENTIAL    = 1     //!< expect sequential accesses, read ahead aggressively
+,   TB_FILEMAP_ADVICE_RANDOM        = 2     //!< expect random accesses, disable read ahead
+,   TB_FILEMAP_ADVICE_WILLNEED      = 3     //!< expect accesses in the near future, prefetch it
+,   TB_FILEMAP_ADVICE_DONTNEED      = 4     //!< do not expect accesses in the near future
+
+}tb_filemap_advice_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! map the whole file to the memory
+ *
+ * @code
+    tb_filemap_ref_t filemap = tb_filemap_init("/tmp/file", TB_FILE_MODE_RO);
+    if (filemap)
+    {
+        // parse the file data without copying it
+        tb_byte_t const* data = tb_filemap_data(filemap);
+        tb_size_t        size = tb_filemap_size(filemap);
+
+        // ...
+
+        // unmap it
+        tb_filemap_exit(filemap);
+    }
+ * @endcode
+ *
+ * @param path          the file path
+ * @param mode          the file mode, only supports TB_FILE_MODE_RO and TB_FILE_MODE_RW
+ *
+ * @return              the file map, it will be failed if the file is empty or too large to be mapped
+ */
+tb_filemap_ref_t        tb_filemap_init(tb_char_t const* path, tb_size_t mode);
+
+/*! map the whole opened file to the memory
+ *
+ * @param file          the file, it can be closed after mapping it
+ * @param mode          the file mode, only supports TB_FILE_MODE_RO and TB_FILE_MODE_RW
+ *
+ * @return              the file map
+ */
+tb_filemap_ref_t        tb_filemap_init_from_file(tb_file_ref_t file, tb_size_t mode);
+
+/*! unmap the file
+ *
+ * @param filemap       the file map
+ */
+tb_void_t               tb_filemap_exit(tb_filemap_ref_t filemap);
+
+/*! the mapped data
+ *
+ * @param filemap       the file map
+ *
+ * @return              the data address
+ */
+tb_byte_t*              tb_filemap_data(tb_filemap_ref_t filemap);
+
+/*! the mapped size
+ *
+ * @param filemap       the file map
+ *
+ * @return              the data size
+ */
+tb_size_t               tb_filemap_size(tb_filemap_ref_t filemap);
+
+/*! give advice about the accesses of the given range
+ *
+ * @param filemap       the file map
+ * @param advice        the advice, e.g. TB_FILEMAP_ADVICE_SEQUENTIAL
+ * @param offset        the range offset
+ * @param size          the range size, the whole left data if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_filemap_advise(tb_filemap_ref_t filemap, tb_size_t advice, tb_size_t offset, tb_size_t size);
+
+/*! flush the modified data of the given range to the file
+ *
+ * @param filemap       the file map
+ * @param offset        the range offset
+ * @param size          the range size, the whole left data if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_filemap_sync(tb_filemap_ref_t filemap, tb_size_t offset, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -74,9 +74,10 @@ tb_bool_t tb_platform_init_env(tb_handle_t priv)
     if (!tb_exception_init_env()) return tb_false;
 #endif
 
-    // init cpu count/cache
+    // init cpu count/features cache
 #ifndef TB_CONFIG_MICRO_ENABLE
     (tb_void_t)tb_cpu_count();
+    (tb_void_t)tb_cpu_features();
 #endif
 
     // init the global process group
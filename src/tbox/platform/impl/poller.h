@@ -48,6 +48,53 @@ typedef __tb_typeref__(poller_process);
 /// the fwatcher poller ref type
 typedef __tb_typeref__(poller_fwatcher);
 
+// the poller io request code enum
+typedef enum __tb_poller_iocode_e
+{
+    TB_POLLER_IOCODE_NONE       = 0
+,   TB_POLLER_IOCODE_RECV       = 1
+,   TB_POLLER_IOCODE_SEND       = 2
+,   TB_POLLER_IOCODE_ACPT       = 3
+,   TB_POLLER_IOCODE_CONN       = 4
+
+}tb_poller_iocode_e;
+
+/* the poller io request type
+ *
+ * it will be completed by the poller directly and the result is passed to the callback in tb_poller_wait(),
+ * so it must be kept until it has been completed.
+ */
+typedef struct __tb_poller_ioreq_t
+{
+    // the request code
+    tb_size_t                code;
+
+    // the socket
+    tb_socket_ref_t          sock;
+
+    // the data buffer for recv/send, or the native socket address for accept/connect
+    tb_pointer_t             data;
+
+    // the data size for recv/send
+    tb_size_t                size;
+
+    // the native socket address size for accept/connect
+    tb_uint32_t              addrlen;
+
+    // the timeout storage (seconds, nanoseconds) for the poller
+    tb_int64_t               timeout[2];
+
+    // the result, >= 0: ok, < 0: -errno
+    tb_long_t                result;
+
+    // the completion callback
+    tb_void_t                (*func)(struct __tb_poller_ioreq_t* ioreq);
+
+    // the user private data
+    tb_cpointer_t            priv;
+
+}tb_poller_ioreq_t, *tb_poller_ioreq_ref_t;
+
 // the poller type
 typedef struct __tb_poller_t
 {
@@ -133,6 +180,16 @@ typedef struct __tb_poller_t
      */
     tb_void_t                (*attach)(struct __tb_poller_t* poller);
 
+    /* post an io request and complete it in the next waiting (only for io_uring now)
+     *
+     * @param poller         the poller
+     * @param ioreq          the io request
+     * @param timeout        the timeout, infinity: -1, it will be canceled with -ECANCELED if be timeout
+     *
+     * @return               tb_true or tb_false
+     */
+    tb_bool_t                (*post)(struct __tb_poller_t* poller, tb_poller_ioreq_ref_t ioreq, tb_long_t timeout);
+
 }tb_poller_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -147,4 +204,12 @@ static __tb_inline__ tb_cpointer_t tb_poller_priv_set_object_type(tb_poller_obje
     return object->type == TB_POLLER_OBJECT_PIPE? (tb_cpointer_t)((tb_size_t)ptr | ((tb_size_t)0x1 << (TB_CPU_BITSIZE - 1))) : ptr;
 }
 
+// post an io request to the poller, it will fail if the poller can not complete io requests directly
+static __tb_inline__ tb_bool_t tb_poller_post(tb_poller_ref_t self, tb_poller_ioreq_ref_t ioreq, tb_long_t timeout)
+{
+    tb_poller_t* poller = (tb_poller_t*)self;
+    tb_assert_and_check_return_val(poller && ioreq && ioreq->func, tb_false);
+    return poller->post? poller->post(poller, ioreq, timeout) : tb_false;
+}
+
 #endif
@@ -0,0 +1,750 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller_iouring.c
+ *
+ */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../atomic.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the submission queue entries count
+#ifdef __tb_small__
+#   define TB_POLLER_IOURING_SQ_ENTRIES         (64)
+#else
+#   define TB_POLLER_IOURING_SQ_ENTRIES         (256)
+#endif
+
+// the rdhup event
+#ifndef POLLRDHUP
+#   define POLLRDHUP                            (0x2000)
+#endif
+
+// make the user data of the poll request from the object fd and generation
+#define tb_poller_iouring_udata(fd, gen)        (((tb_uint64_t)(gen) << 32) | (tb_uint32_t)(fd))
+
+// the user data flag of the io request, the generation of the poll request is only 31 bits
+#define TB_POLLER_IOURING_UDATA_IOREQ           ((tb_uint64_t)1 << 63)
+
+// the next generation of the poll request
+#define tb_poller_iouring_gen_next(gen)         ((((gen) + 1) & 0x7fffffff)? (((gen) + 1) & 0x7fffffff) : 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring poller object type
+typedef struct __tb_poller_iouring_object_t
+{
+    /* the generation of the poll request
+     *
+     * it will be changed after removing or modifying this object,
+     * so we can discard the stale completions of the previous poll requests
+     */
+    tb_uint32_t             gen;
+
+    // the poller events
+    tb_uint16_t             events;
+
+    // is inserted?
+    tb_uint16_t             inserted    : 1;
+
+    // is the poll request armed?
+    tb_uint16_t             armed       : 1;
+
+}tb_poller_iouring_object_t;
+
+// the io_uring poller type
+typedef struct __tb_poller_iouring_t
+{
+    // the poller base
+    tb_poller_t                 base;
+
+    // the pair sockets for spak, kill ..
+    tb_socket_ref_t             pair[2];
+
+    // the ring fd
+    tb_int_t                    ringfd;
+
+    // the submission queue ring
+    tb_byte_t*                  sq_ring;
+    tb_size_t                   sq_ring_size;
+    tb_uint32_t*                sq_head;
+    tb_uint32_t*                sq_tail;
+    tb_uint32_t*                sq_array;
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+
+    // the submission queue entries
+    struct io_uring_sqe*        sqes;
+    tb_size_t                   sqes_size;
+
+    // the pending submission entries count
+    tb_uint32_t                 sq_pending;
+
+    // can complete the io requests directly? the kernel need poll the non-blocking sockets internally
+    tb_bool_t                   fast_poll;
+
+    // the completion queue ring, it may be same as the submission queue ring
+    tb_byte_t*                  cq_ring;
+    tb_size_t                   cq_ring_size;
+    tb_uint32_t*                cq_head;
+    tb_uint32_t*                cq_tail;
+    tb_uint32_t                 cq_mask;
+    struct io_uring_cqe*        cqes;
+
+    // the objects, index: fd
+    tb_poller_iouring_object_t* objects;
+
+    // the objects count
+    tb_size_t                   objects_count;
+
+    // the socket data
+    tb_pollerdata_t             pollerdata;
+
+}tb_poller_iouring_t, *tb_poller_iouring_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_int_t tb_poller_iouring_setup(tb_uint32_t entries, struct io_uring_params* params)
+{
+    return (tb_int_t)syscall(__NR_io_uring_setup, entries, params);
+}
+static __tb_inline__ tb_int_t tb_poller_iouring_enter(tb_int_t ringfd, tb_uint32_t to_submit, tb_uint32_t min_complete, tb_uint32_t flags, tb_pointer_t arg, tb_size_t argsz)
+{
+    return (tb_int_t)syscall(__NR_io_uring_enter, ringfd, to_submit, min_complete, flags, arg, argsz);
+}
+static tb_uint32_t tb_poller_iouring_poll_events(tb_size_t events)
+{
+    tb_uint32_t poll_events = 0;
+    if (events & TB_POLLER_EVENT_RECV) poll_events |= POLLIN;
+    if (events & TB_POLLER_EVENT_SEND) poll_events |= POLLOUT;
+    if (events & TB_POLLER_EVENT_CLEAR) poll_events |= POLLRDHUP;
+    return poll_events;
+}
+static tb_bool_t tb_poller_iouring_submit(tb_poller_iouring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->ringfd >= 0);
+
+    // submit all pending entries
+    while (poller->sq_pending)
+    {
+        tb_int_t submitted = tb_poller_iouring_enter(poller->ringfd, poller->sq_pending, 0, 0, tb_null, 0);
+        if (submitted < 0)
+        {
+            // interrupted or busy? try it again
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+
+            // trace
+            tb_trace_e("submit %u entries failed, errno: %d", poller->sq_pending, errno);
+            return tb_false;
+        }
+        poller->sq_pending -= tb_min((tb_uint32_t)submitted, poller->sq_pending);
+    }
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_sqe_reserve(tb_poller_iouring_ref_t poller, tb_uint32_t count)
+{
+    // check
+    tb_assert(poller && poller->sq_entries && count <= poller->sq_entries);
+
+    // the submission queue is full? submit the pending entries first
+    tb_uint32_t tail = *poller->sq_tail;
+    if (tail - tb_atomic32_get_explicit((tb_atomic32_t*)poller->sq_head, TB_ATOMIC_ACQUIRE) + count > poller->sq_entries)
+    {
+        if (!tb_poller_iouring_submit(poller)) return tb_false;
+        tb_assert_and_check_return_val(tail - tb_atomic32_get_explicit((tb_atomic32_t*)poller->sq_head, TB_ATOMIC_ACQUIRE) + count <= poller->sq_entries, tb_false);
+    }
+    return tb_true;
+}
+static struct io_uring_sqe* tb_poller_iouring_sqe(tb_poller_iouring_ref_t poller)
+{
+    // reserve a free entry
+    if (!tb_poller_iouring_sqe_reserve(poller, 1)) return tb_null;
+
+    /* get a free entry
+     *
+     * the entries are mapped from the kernel, so we cannot use tb_memset() with the memory checking for the debug mode
+     */
+    tb_uint32_t          tail = *poller->sq_tail;
+    tb_uint32_t          index = tail & poller->sq_mask;
+    struct io_uring_sqe* sqe = &poller->sqes[index];
+    tb_memset_(sqe, 0, sizeof(struct io_uring_sqe));
+
+    /* commit it to the submission queue, it will be submitted in the next waiting
+     *
+     * we do not use SQPOLL, so the kernel only reads it in io_uring_enter() after we have filled it
+     */
+    poller->sq_array[index] = index;
+    tb_atomic32_set_explicit((tb_atomic32_t*)poller->sq_tail, tail + 1, TB_ATOMIC_RELEASE);
+    poller->sq_pending++;
+    return sqe;
+}
+static tb_bool_t tb_poller_iouring_poll_add(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_object_t* object)
+{
+    // get a free entry
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_check_return_val(sqe, tb_false);
+
+    // the poll events
+    tb_uint32_t poll_events = tb_poller_iouring_poll_events(object->events);
+#ifdef TB_WORDS_BIGENDIAN
+    poll_events = (poll_events << 16) | (poll_events >> 16);
+#endif
+
+    /* add the poll request
+     *
+     * we use the multishot poll request for the edge-trigger mode, it will post a completion for each wakeup,
+     * otherwise we re-arm the oneshot poll request after each completion for the level-trigger mode.
+     */
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = (tb_int_t)fd;
+    sqe->poll32_events  = poll_events;
+    sqe->user_data      = tb_poller_iouring_udata(fd, object->gen);
+    if ((object->events & TB_POLLER_EVENT_CLEAR) && !(object->events & TB_POLLER_EVENT_ONESHOT))
+        sqe->len = IORING_POLL_ADD_MULTI;
+
+    // armed
+    object->armed = 1;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_poll_remove(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_object_t* object)
+{
+    // not armed? only update the generation
+    tb_uint32_t gen = object->gen;
+    object->gen = tb_poller_iouring_gen_next(gen);
+    tb_check_return_val(object->armed, tb_true);
+
+    // get a free entry
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_check_return_val(sqe, tb_false);
+
+    // remove the previous poll request, we ignore the completion of the remove request (user_data: 0)
+    sqe->opcode     = IORING_OP_POLL_REMOVE;
+    sqe->fd         = -1;
+    sqe->addr       = tb_poller_iouring_udata(fd, gen);
+    sqe->user_data  = 0;
+
+    // not armed now
+    object->armed = 0;
+    return tb_true;
+}
+static tb_poller_iouring_object_t* tb_poller_iouring_object(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_bool_t grow)
+{
+    // check
+    tb_assert_and_check_return_val(fd >= 0, tb_null);
+
+    // grow objects
+    if (fd >= poller->objects_count)
+    {
+        tb_check_return_val(grow, tb_null);
+
+        // grow it
+        tb_size_t count = tb_align8(tb_max(fd + 1, poller->objects_count + (poller->objects_count >> 1)));
+        poller->objects = (tb_poller_iouring_object_t*)tb_ralloc(poller->objects, count * sizeof(tb_poller_iouring_object_t));
+        tb_assert_and_check_return_val(poller->objects, tb_null);
+
+        // init the new objects
+        tb_memset(poller->objects + poller->objects_count, 0, (count - poller->objects_count) * sizeof(tb_poller_iouring_object_t));
+        poller->objects_count = count;
+    }
+    return &poller->objects[fd];
+}
+static tb_void_t tb_poller_iouring_exit(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // exit pair sockets
+    if (poller->pair[0]) tb_socket_exit(poller->pair[0]);
+    if (poller->pair[1]) tb_socket_exit(poller->pair[1]);
+    poller->pair[0] = tb_null;
+    poller->pair[1] = tb_null;
+
+    // exit rings
+    if (poller->sqes) munmap(poller->sqes, poller->sqes_size);
+    if (poller->cq_ring && poller->cq_ring != poller->sq_ring) munmap(poller->cq_ring, poller->cq_ring_size);
+    if (poller->sq_ring) munmap(poller->sq_ring, poller->sq_ring_size);
+    poller->sqes    = tb_null;
+    poller->cq_ring = tb_null;
+    poller->sq_ring = tb_null;
+
+    // close the ring fd
+    if (poller->ringfd >= 0) close(poller->ringfd);
+    poller->ringfd = -1;
+
+    // exit objects
+    if (poller->objects) tb_free(poller->objects);
+    poller->objects         = tb_null;
+    poller->objects_count   = 0;
+
+    // exit socket data
+    tb_pollerdata_exit(&poller->pollerdata);
+
+    // free it
+    tb_free(poller);
+}
+static tb_void_t tb_poller_iouring_kill(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // kill it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
+}
+static tb_void_t tb_poller_iouring_spak(tb_poller_t* self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // post it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
+}
+static tb_bool_t tb_poller_iouring_insert(tb_poller_t* self, tb_poller_object_ref_t object, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the object
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_object_t* iouring_object = tb_poller_iouring_object(poller, fd, tb_true);
+    tb_assert_and_check_return_val(iouring_object, tb_false);
+
+    // has been inserted?
+    if (iouring_object->inserted)
+    {
+        // trace
+        tb_trace_e("insert object(%p) events: %lu failed, it has been inserted!", object->ref.ptr, events);
+        return tb_false;
+    }
+
+    // bind the object type to the private data
+    priv = tb_poller_priv_set_object_type(object, priv);
+
+    // bind user private data to object
+    if (!(events & TB_POLLER_EVENT_NOEXTRA) || object->type == TB_POLLER_OBJECT_PIPE)
+        tb_pollerdata_set(&poller->pollerdata, object, priv);
+
+    // add the poll request, it will be submitted in the next waiting
+    iouring_object->gen         = tb_poller_iouring_gen_next(iouring_object->gen);
+    iouring_object->events      = (tb_uint16_t)events;
+    iouring_object->inserted    = 1;
+    if (!tb_poller_iouring_poll_add(poller, fd, iouring_object))
+    {
+        // trace
+        tb_trace_e("insert object(%p) events: %lu failed!", object->ref.ptr, events);
+        iouring_object->inserted = 0;
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_remove(tb_poller_t* self, tb_poller_object_ref_t object)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the object
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_object_t* iouring_object = tb_poller_iouring_object(poller, fd, tb_false);
+    if (!iouring_object || !iouring_object->inserted)
+    {
+        // trace
+        tb_trace_e("remove object(%p) failed, it has been not inserted!", object->ref.ptr);
+        return tb_false;
+    }
+
+    // remove the poll request, it will be submitted in the next waiting
+    if (!tb_poller_iouring_poll_remove(poller, fd, iouring_object))
+    {
+        // trace
+        tb_trace_e("remove object(%p) failed!", object->ref.ptr);
+        return tb_false;
+    }
+    iouring_object->events      = 0;
+    iouring_object->inserted    = 0;
+
+    // remove user private data from this object
+    tb_pollerdata_reset(&poller->pollerdata, object);
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_modify(tb_poller_t* self, tb_poller_object_ref_t object, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && object, tb_false);
+
+    // get the object
+    tb_long_t                   fd = tb_ptr2fd(object->ref.ptr);
+    tb_poller_iouring_object_t* iouring_object = tb_poller_iouring_object(poller, fd, tb_false);
+    if (!iouring_object || !iouring_object->inserted)
+    {
+        // trace
+        tb_trace_e("modify object(%p) events: %lu failed, it has been not inserted!", object->ref.ptr, events);
+        return tb_false;
+    }
+
+    // bind the object type to the private data
+    priv = tb_poller_priv_set_object_type(object, priv);
+
+    // bind user private data to object
+    if (!(events & TB_POLLER_EVENT_NOEXTRA) || object->type == TB_POLLER_OBJECT_PIPE)
+        tb_pollerdata_set(&poller->pollerdata, object, priv);
+
+    // replace the previous poll request, they will be submitted in the next waiting
+    if (!tb_poller_iouring_poll_remove(poller, fd, iouring_object)) return tb_false;
+    iouring_object->events = (tb_uint16_t)events;
+    if (!tb_poller_iouring_poll_add(poller, fd, iouring_object))
+    {
+        // trace
+        tb_trace_e("modify object(%p) events: %lu failed!", object->ref.ptr, events);
+        return tb_false;
+    }
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_post(tb_poller_t* self, tb_poller_ioreq_ref_t ioreq, tb_long_t timeout)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && ioreq && ioreq->sock && ioreq->data, tb_false);
+
+    // the kernel cannot poll the non-blocking sockets internally? we need wait the readiness events
+    tb_check_return_val(poller->fast_poll, tb_false);
+
+    // unknown request?
+    tb_uint8_t opcode = IORING_OP_NOP;
+    switch (ioreq->code)
+    {
+    case TB_POLLER_IOCODE_RECV: opcode = IORING_OP_RECV;    break;
+    case TB_POLLER_IOCODE_SEND: opcode = IORING_OP_SEND;    break;
+    case TB_POLLER_IOCODE_ACPT: opcode = IORING_OP_ACCEPT;  break;
+    case TB_POLLER_IOCODE_CONN: opcode = IORING_OP_CONNECT; break;
+    default: break;
+    }
+    tb_assert_and_check_return_val(opcode != IORING_OP_NOP, tb_false);
+
+    // reserve the entries of the request and its linked timeout, they must be submitted together
+    if (!tb_poller_iouring_sqe_reserve(poller, timeout >= 0? 2 : 1)) return tb_false;
+
+    // get a free entry
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init the request
+    sqe->opcode     = opcode;
+    sqe->fd         = (tb_int_t)tb_sock2fd(ioreq->sock);
+    sqe->addr       = (tb_uint64_t)(tb_size_t)ioreq->data;
+    sqe->user_data  = (tb_uint64_t)(tb_size_t)ioreq | TB_POLLER_IOURING_UDATA_IOREQ;
+    switch (ioreq->code)
+    {
+    case TB_POLLER_IOCODE_RECV:
+        sqe->len            = (tb_uint32_t)ioreq->size;
+        break;
+    case TB_POLLER_IOCODE_SEND:
+        sqe->len            = (tb_uint32_t)ioreq->size;
+        sqe->msg_flags      = MSG_NOSIGNAL;
+        break;
+    case TB_POLLER_IOCODE_ACPT:
+        sqe->addr2          = (tb_uint64_t)(tb_size_t)&ioreq->addrlen;
+        sqe->accept_flags   = SOCK_NONBLOCK;
+        break;
+    case TB_POLLER_IOCODE_CONN:
+        sqe->off            = ioreq->addrlen;
+        break;
+    default:
+        break;
+    }
+
+    /* cancel this request with -ECANCELED if be timeout
+     *
+     * we ignore the completion of the linked timeout request (user_data: 0),
+     * and the timespec will be read when it's submitted in the next waiting, so we save it to the request.
+     */
+    if (timeout >= 0)
+    {
+        sqe->flags |= IOSQE_IO_LINK;
+
+        // get the timeout entry, it has been reserved
+        struct io_uring_sqe* sqe_timeout = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe_timeout, tb_false);
+
+        // init the linked timeout request
+        ioreq->timeout[0]       = timeout / 1000;
+        ioreq->timeout[1]       = (timeout % 1000) * 1000000;
+        sqe_timeout->opcode     = IORING_OP_LINK_TIMEOUT;
+        sqe_timeout->fd         = -1;
+        sqe_timeout->addr       = (tb_uint64_t)(tb_size_t)ioreq->timeout;
+        sqe_timeout->len        = 1;
+        sqe_timeout->user_data  = 0;
+    }
+    return tb_true;
+}
+static tb_long_t tb_poller_iouring_wait(tb_poller_t* self, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && func, -1);
+
+    /* submit all pending requests and wait completions in one system call
+     *
+     * we need not wait it if there are some completions now
+     */
+    tb_uint32_t head = *poller->cq_head;
+    if (head == tb_atomic32_get_explicit((tb_atomic32_t*)poller->cq_tail, TB_ATOMIC_ACQUIRE))
+    {
+        struct __kernel_timespec       ts;
+        struct io_uring_getevents_arg  arg;
+        tb_memset(&arg, 0, sizeof(arg));
+        if (timeout >= 0)
+        {
+            ts.tv_sec   = timeout / 1000;
+            ts.tv_nsec  = (timeout % 1000) * 1000000;
+            arg.ts      = (tb_uint64_t)(tb_size_t)&ts;
+        }
+        tb_int_t ok = tb_poller_iouring_enter(poller->ringfd, poller->sq_pending, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        if (ok >= 0) poller->sq_pending -= tb_min((tb_uint32_t)ok, poller->sq_pending);
+        else if (errno != ETIME && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            // trace
+            tb_trace_e("wait failed, errno: %d", errno);
+            return -1;
+        }
+    }
+    // submit all pending requests
+    else if (!tb_poller_iouring_submit(poller)) return -1;
+
+    // handle completions
+    tb_size_t           wait = 0;
+    tb_uint32_t         tail = tb_atomic32_get_explicit((tb_atomic32_t*)poller->cq_tail, TB_ATOMIC_ACQUIRE);
+    tb_socket_ref_t     pair = poller->pair[1];
+    tb_poller_object_t  object;
+    while (head != tail)
+    {
+        // get the completion
+        struct io_uring_cqe* cqe = &poller->cqes[head & poller->cq_mask];
+        tb_uint64_t udata = cqe->user_data;
+        tb_int_t    res = cqe->res;
+        tb_uint32_t flags = cqe->flags;
+
+        // free this completion entry
+        tb_atomic32_set_explicit((tb_atomic32_t*)poller->cq_head, ++head, TB_ATOMIC_RELEASE);
+
+        // is the completion of the remove or linked timeout request? ignore it
+        tb_check_continue(udata);
+
+        // is the completion of the io request? pass the result to it
+        if (udata & TB_POLLER_IOURING_UDATA_IOREQ)
+        {
+            tb_poller_ioreq_ref_t ioreq = (tb_poller_ioreq_ref_t)(tb_size_t)(udata & ~TB_POLLER_IOURING_UDATA_IOREQ);
+            tb_assert_and_check_continue(ioreq && ioreq->func);
+            ioreq->result = res;
+            ioreq->func(ioreq);
+            wait++;
+            continue ;
+        }
+
+        // get the object, ignore the stale completion of the removed or modified poll request
+        tb_long_t                   fd = (tb_long_t)(tb_uint32_t)udata;
+        tb_poller_iouring_object_t* iouring_object = tb_poller_iouring_object(poller, fd, tb_false);
+        tb_check_continue(iouring_object && iouring_object->inserted && iouring_object->gen == (tb_uint32_t)(udata >> 32));
+
+        // the poll request has been finished?
+        if (!(flags & IORING_CQE_F_MORE)) iouring_object->armed = 0;
+
+        // canceled? it's the previous poll request
+        tb_check_continue(res != -ECANCELED);
+
+        // init the object
+        object.ref.ptr = tb_fd2ptr(fd);
+
+        // spank socket events?
+        if (object.ref.sock == pair)
+        {
+            // read spak
+            tb_char_t spak = '\0';
+            if (res > 0 && (res & POLLIN))
+            {
+                if (1 != tb_socket_recv(pair, (tb_byte_t*)&spak, 1)) return -1;
+
+                // killed?
+                if (spak == 'k') return -1;
+            }
+
+            // re-arm the poll request
+            if (!iouring_object->armed && !tb_poller_iouring_poll_add(poller, fd, iouring_object)) return -1;
+            continue ;
+        }
+
+        // init events
+        tb_size_t events = TB_POLLER_EVENT_NONE;
+        if (res < 0) events = TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+        else
+        {
+            if (res & POLLIN) events |= TB_POLLER_EVENT_RECV;
+            if (res & POLLOUT) events |= TB_POLLER_EVENT_SEND;
+            if ((res & (POLLHUP | POLLERR)) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND)))
+                events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+
+            // connection closed for the edge trigger?
+            if (res & POLLRDHUP) events |= TB_POLLER_EVENT_EOF;
+        }
+
+        // re-arm the poll request if it's not oneshot, it's level-trigger or the multishot poll request has been terminated
+        if (!iouring_object->armed && res >= 0 && !(iouring_object->events & TB_POLLER_EVENT_ONESHOT))
+        {
+            if (!tb_poller_iouring_poll_add(poller, fd, iouring_object)) return -1;
+        }
+
+        // call event function
+        tb_cpointer_t priv = tb_pollerdata_get(&poller->pollerdata, &object);
+        object.type = tb_poller_priv_get_object_type(priv);
+        func((tb_poller_ref_t)self, &object, events, tb_poller_priv_get_original(priv));
+
+        // update the events count
+        wait++;
+    }
+
+    // ok
+    return wait;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_poller_t* tb_poller_iouring_init()
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_poller_iouring_ref_t     poller = tb_null;
+    do
+    {
+        // make poller
+        poller = tb_malloc0_type(tb_poller_iouring_t);
+        tb_assert_and_check_break(poller);
+
+        // init base
+        poller->base.type   = TB_POLLER_TYPE_IOURING;
+        poller->base.exit   = tb_poller_iouring_exit;
+        poller->base.kill   = tb_poller_iouring_kill;
+        poller->base.spak   = tb_poller_iouring_spak;
+        poller->base.wait   = tb_poller_iouring_wait;
+        poller->base.insert = tb_poller_iouring_insert;
+        poller->base.remove = tb_poller_iouring_remove;
+        poller->base.modify = tb_poller_iouring_modify;
+        poller->base.post   = tb_poller_iouring_post;
+        poller->base.supported_events = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_CLEAR | TB_POLLER_EVENT_ONESHOT;
+        poller->ringfd      = -1;
+
+        // init poller data
+        tb_pollerdata_init(&poller->pollerdata);
+
+        /* init io_uring
+         *
+         * we need the extended argument for waiting with timeout and the completions cannot be dropped,
+         * otherwise we will fall back to epoll.
+         */
+        struct io_uring_params params;
+        tb_memset(&params, 0, sizeof(params));
+        poller->ringfd = tb_poller_iouring_setup(TB_POLLER_IOURING_SQ_ENTRIES, &params);
+        tb_check_break(poller->ringfd >= 0);
+        tb_check_break((params.features & IORING_FEAT_NODROP) && (params.features & IORING_FEAT_EXT_ARG));
+        poller->fast_poll = (params.features & IORING_FEAT_FAST_POLL)? tb_true : tb_false;
+
+        // map the submission and completion queue rings
+        poller->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t);
+        poller->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            poller->sq_ring_size = tb_max(poller->sq_ring_size, poller->cq_ring_size);
+            poller->cq_ring_size = poller->sq_ring_size;
+        }
+        poller->sq_ring = (tb_byte_t*)mmap(tb_null, poller->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQ_RING);
+        if (poller->sq_ring == (tb_byte_t*)MAP_FAILED) poller->sq_ring = tb_null;
+        tb_assert_and_check_break(poller->sq_ring);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) poller->cq_ring = poller->sq_ring;
+        else
+        {
+            poller->cq_ring = (tb_byte_t*)mmap(tb_null, poller->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_CQ_RING);
+            if (poller->cq_ring == (tb_byte_t*)MAP_FAILED) poller->cq_ring = tb_null;
+            tb_assert_and_check_break(poller->cq_ring);
+        }
+
+        // map the submission queue entries
+        poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        poller->sqes = (struct io_uring_sqe*)mmap(tb_null, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQES);
+        if (poller->sqes == (struct io_uring_sqe*)MAP_FAILED) poller->sqes = tb_null;
+        tb_assert_and_check_break(poller->sqes);
+
+        // init the submission queue
+        poller->sq_head     = (tb_uint32_t*)(poller->sq_ring + params.sq_off.head);
+        poller->sq_tail     = (tb_uint32_t*)(poller->sq_ring + params.sq_off.tail);
+        poller->sq_array    = (tb_uint32_t*)(poller->sq_ring + params.sq_off.array);
+        poller->sq_mask     = *(tb_uint32_t*)(poller->sq_ring + params.sq_off.ring_mask);
+        poller->sq_entries  = *(tb_uint32_t*)(poller->sq_ring + params.sq_off.ring_entries);
+
+        // init the completion queue
+        poller->cq_head     = (tb_uint32_t*)(poller->cq_ring + params.cq_off.head);
+        poller->cq_tail     = (tb_uint32_t*)(poller->cq_ring + params.cq_off.tail);
+        poller->cq_mask     = *(tb_uint32_t*)(poller->cq_ring + params.cq_off.ring_mask);
+        poller->cqes        = (struct io_uring_cqe*)(poller->cq_ring + params.cq_off.cqes);
+
+        // init pair sockets
+        if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
+
+        // insert pair socket first
+        tb_poller_object_t object;
+        object.type = TB_POLLER_OBJECT_SOCK;
+        object.ref.sock = poller->pair[1];
+        if (!tb_poller_iouring_insert((tb_poller_t*)poller, &object, TB_POLLER_EVENT_RECV, tb_null)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (poller) tb_poller_iouring_exit((tb_poller_t*)poller);
+        poller = tb_null;
+    }
+
+    // ok?
+    return (tb_poller_t*)poller;
+}
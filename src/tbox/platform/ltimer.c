@@ -38,13 +38,33 @@
  * macros
  */
 
-// the timer wheel maxn
+// the root wheel bits
 #ifdef __tb_small__
-#   define TB_LTIMER_WHEEL_MAXN             (4096)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (6)
 #else
-#   define TB_LTIMER_WHEEL_MAXN             (8192)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (8)
 #endif
 
+// the node wheel bits
+#define TB_LTIMER_WHEEL_NODE_BITS           (6)
+
+// the node wheel levels
+#define TB_LTIMER_WHEEL_NODE_LEVELN         (4)
+
+// the root wheel maxn
+#define TB_LTIMER_WHEEL_ROOT_MAXN           (1 << TB_LTIMER_WHEEL_ROOT_BITS)
+#define TB_LTIMER_WHEEL_ROOT_MASK           (TB_LTIMER_WHEEL_ROOT_MAXN - 1)
+
+// the node wheel maxn
+#define TB_LTIMER_WHEEL_NODE_MAXN           (1 << TB_LTIMER_WHEEL_NODE_BITS)
+#define TB_LTIMER_WHEEL_NODE_MASK           (TB_LTIMER_WHEEL_NODE_MAXN - 1)
+
+// the total ticks of all wheels
+#define TB_LTIMER_WHEEL_TICKN               ((tb_hize_t)1 << (TB_LTIMER_WHEEL_ROOT_BITS + TB_LTIMER_WHEEL_NODE_BITS * TB_LTIMER_WHEEL_NODE_LEVELN))
+
+// the wheel shift of the given node level
+#define TB_LTIMER_WHEEL_NODE_SHIFT(level)   (TB_LTIMER_WHEEL_ROOT_BITS + TB_LTIMER_WHEEL_NODE_BITS * (level))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -52,6 +72,9 @@
 // the timer task type
 typedef struct __tb_ltimer_task_t
 {
+    // the list entry
+    tb_list_entry_t             entry;
+
     // the func
     tb_ltimer_task_func_t       func;
 
@@ -73,8 +96,8 @@ typedef struct __tb_ltimer_task_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
-    // the wheel index
-    tb_uint32_t                 windx;
+    // the wheel list, it will be null if the task is not in the wheel
+    tb_list_entry_head_ref_t    wlist;
 
 }tb_ltimer_task_t;
 
@@ -84,16 +107,21 @@ typedef struct __tb_ltimer_task_t
  *
  * tick: 1s
  *
- *           1s    1s   ..
- * wheel: |-----|-----|-----|-----|-----|-----|---- ... -----|  <= circle queue
- *                             timers
- *                 btime ==================> now
- *                       |     |     |
- *                       |     |     |
- *                       |     |     | => the same timeout timer_task list (vector)
- *                                   |
+ * root:  |-----|-----|-----|-----|-----|---- ... -----|       <= 256 ticks, one slot per tick
+ *           ^
+ *         wtick                  cascade to the root wheel
+ *                                        /|\
+ * node0: |-----------|-----------|--- ... ---|                <= 64 slots, 256 ticks per slot
+ *                                        /|\
+ * node1: |-----------------|-------- ... --------|           <= 64 slots, 256 * 64 ticks per slot
+ *  ...
+ * node3: |-----------------------|-- ... ------------------|  <= 64 slots, 256 * 64^3 ticks per slot
  *
  * </pre>
+ *
+ * the task is placed into the lowest level covering its delay and moved down (cascaded)
+ * when the root wheel passes the corresponding slot, so inserting and removing tasks are O(1)
+ * and the delay range is [now, now + 2^32 ticks), it will be clipped to the maximum range if overflow.
  */
 typedef struct __tb_ltimer_t
 {
@@ -106,7 +134,7 @@ typedef struct __tb_ltimer_t
     // is worked?
     tb_atomic32_t               work;
 
-    // the base time
+    // the base time of the current tick
     tb_hong_t                   btime;
 
     // cache time?
@@ -122,13 +150,16 @@ typedef struct __tb_ltimer_t
     tb_fixed_pool_ref_t         pool;
 
     // the expired tasks
-    tb_vector_ref_t             expired;
+    tb_list_entry_head_t        expired;
 
-    // the wheel
-    tb_vector_ref_t             wheel[TB_LTIMER_WHEEL_MAXN];
+    // the current tick
+    tb_hize_t                   wtick;
 
-    // the wheel base
-    tb_size_t                   wbase;
+    // the root wheel
+    tb_list_entry_head_t        wroot[TB_LTIMER_WHEEL_ROOT_MAXN];
+
+    // the node wheels
+    tb_list_entry_head_t        wnode[TB_LTIMER_WHEEL_NODE_LEVELN][TB_LTIMER_WHEEL_NODE_MAXN];
 
 }tb_ltimer_t;
 
@@ -148,171 +179,138 @@ static __tb_inline__ tb_hong_t tb_ltimer_now(tb_ltimer_t* timer)
     // using cached time
     return tb_cache_time_mclock();
 }
+static tb_void_t tb_ltimer_wheel_init(tb_ltimer_t* timer)
+{
+    // init the root wheel
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LTIMER_WHEEL_ROOT_MAXN; i++)
+        tb_list_entry_init(&timer->wroot[i], tb_ltimer_task_t, entry, tb_null);
+
+    // init the node wheels
+    tb_size_t level = 0;
+    for (level = 0; level < TB_LTIMER_WHEEL_NODE_LEVELN; level++)
+    {
+        for (i = 0; i < TB_LTIMER_WHEEL_NODE_MAXN; i++)
+            tb_list_entry_init(&timer->wnode[level][i], tb_ltimer_task_t, entry, tb_null);
+    }
+}
 static tb_bool_t tb_ltimer_add_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
 {
     // check
     tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
     tb_assert_and_check_return_val(timer_task && timer_task->func && timer_task->refn && timer_task->when, tb_false);
+    tb_assert_and_check_return_val(!timer_task->wlist, tb_false);
 
     // trace
     tb_trace_d("add: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // empty? move to the wheel head
-        if (!tb_fixed_pool_size(timer->pool))
-        {
-            timer->btime = tb_ltimer_now(timer);
-            timer->wbase = 0;
-        }
-
-        // trace
-        tb_trace_d("add: btime: %lld, wbase: %lu", timer->btime, timer->wbase);
-
-        // the timer difference
-        tb_hong_t tdiff = timer_task->when - timer->btime;
-        tb_assert_and_check_break(tdiff >= 0);
-
-        // trace
-        tb_trace_d("add: tdiff: %lld", tdiff);
-
-        // the wheel difference
-        tb_size_t wdiff = (tb_size_t)(tdiff / timer->tick);
-        tb_assert_and_check_break(wdiff < TB_LTIMER_WHEEL_MAXN);
-
-        // trace
-        tb_trace_d("add: wdiff: %lu", wdiff);
-
-        // the wheel index
-        tb_size_t windx = (timer->wbase + wdiff) & (TB_LTIMER_WHEEL_MAXN - 1);
-
-        // trace
-        tb_trace_d("add: windx: %lu", windx);
+    // the timer difference, the expired task will be done at the next spak
+    tb_hong_t tdiff = timer_task->when - timer->btime;
+    if (tdiff < 0) tdiff = 0;
 
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[windx];
-        if (!wlist) wlist = timer->wheel[windx] = tb_vector_init(timer->grow, tb_element_ptr(tb_null, tb_null));
-        tb_assert_and_check_break(wlist);
+    // the wheel difference, clip it to the maximum range
+    tb_hize_t wdiff = (tb_hize_t)tdiff / timer->tick;
+    if (wdiff >= TB_LTIMER_WHEEL_TICKN) wdiff = TB_LTIMER_WHEEL_TICKN - 1;
 
-        // save the wheel index
-        timer_task->windx = (tb_uint32_t)windx;
+    // the expired tick
+    tb_hize_t etick = timer->wtick + wdiff;
 
-        // add task to the wheel list
-        tb_vector_insert_tail(wlist, timer_task);
+    // trace
+    tb_trace_d("add: btime: %lld, wtick: %llu, wdiff: %llu", timer->btime, timer->wtick, wdiff);
 
-        // ok
-        ok = tb_true;
+    // get the wheel list
+    tb_list_entry_head_ref_t wlist = tb_null;
+    if (wdiff < TB_LTIMER_WHEEL_ROOT_MAXN) wlist = &timer->wroot[etick & TB_LTIMER_WHEEL_ROOT_MASK];
+    else
+    {
+        // find the lowest node wheel covering this difference
+        tb_size_t level = 0;
+        for (level = 0; level < TB_LTIMER_WHEEL_NODE_LEVELN - 1; level++)
+        {
+            if (wdiff < ((tb_hize_t)1 << TB_LTIMER_WHEEL_NODE_SHIFT(level + 1))) break;
+        }
+        wlist = &timer->wnode[level][(etick >> TB_LTIMER_WHEEL_NODE_SHIFT(level)) & TB_LTIMER_WHEEL_NODE_MASK];
+    }
 
-    } while (0);
+    // add task to the wheel list
+    tb_list_entry_insert_tail(wlist, &timer_task->entry);
+    timer_task->wlist = wlist;
 
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
-static tb_bool_t tb_ltimer_del_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
+static tb_void_t tb_ltimer_del_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
 {
     // check
-    tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
-    tb_assert_and_check_return_val(timer_task && timer_task->func && timer_task->refn && timer_task->when, tb_false);
+    tb_assert(timer && timer_task && timer_task->wlist);
 
     // trace
     tb_trace_d("del: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // check
-        tb_assert_and_check_break(timer_task->windx != -1 && timer_task->windx < tb_arrayn(timer->wheel));
-
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[timer_task->windx];
-        tb_assert_and_check_break(wlist);
-
-        // find the task from the wheel list
-        tb_size_t itor = tb_find_all(wlist, timer_task);
-        tb_assert_and_check_break(itor != tb_iterator_tail(wlist));
-
-        // del the task from the wheel list
-        tb_vector_remove(wlist, itor);
+    // del the task from the wheel list
+    tb_list_entry_remove(timer_task->wlist, &timer_task->entry);
+    timer_task->wlist = tb_null;
+}
+static tb_void_t tb_ltimer_cascade(tb_ltimer_t* timer, tb_size_t level)
+{
+    // the wheel list
+    tb_list_entry_head_ref_t wlist = &timer->wnode[level][(timer->wtick >> TB_LTIMER_WHEEL_NODE_SHIFT(level)) & TB_LTIMER_WHEEL_NODE_MASK];
+    tb_check_return(tb_list_entry_size(wlist));
 
-        // clear the wheel index
-        timer_task->windx = -1;
+    // trace
+    tb_trace_d("cascade: level: %lu, wtick: %llu, size: %lu", level, timer->wtick, tb_list_entry_size(wlist));
 
-        // ok
-        ok = tb_true;
+    // re-add all tasks to the lower wheels
+    while (tb_list_entry_size(wlist))
+    {
+        // get the task
+        tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry0(tb_list_entry_head(wlist));
 
-    } while (0);
+        // del the task
+        tb_ltimer_del_task(timer, timer_task);
 
-    // ok?
-    return ok;
+        // re-add it
+        tb_ltimer_add_task(timer, timer_task);
+    }
 }
-static tb_bool_t tb_ltimer_expired_task_done(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+static tb_void_t tb_ltimer_expire(tb_ltimer_t* timer)
 {
-    // the task
-    tb_ltimer_task_t const* timer_task = (tb_ltimer_task_t const*)item;
-
-    // done func
-    if (timer_task && timer_task->func)
+    // move all tasks of the current tick to the expired tasks
+    tb_list_entry_head_ref_t wlist = &timer->wroot[timer->wtick & TB_LTIMER_WHEEL_ROOT_MASK];
+    while (tb_list_entry_size(wlist))
     {
-        // trace
-        tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
+        // get the task
+        tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry0(tb_list_entry_head(wlist));
 
-        // done
-        timer_task->func(timer_task->killed? tb_true : tb_false, timer_task->priv);
-    }
+        // del the task
+        tb_ltimer_del_task(timer, timer_task);
 
-    // ok
-    return tb_true;
+        // add it to the expired tasks
+        tb_list_entry_insert_tail(&timer->expired, &timer_task->entry);
+    }
 }
-static tb_bool_t tb_ltimer_expired_task_exit(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+static tb_void_t tb_ltimer_expired_task_exit(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task, tb_hong_t now)
 {
-    // check
-    tb_ltimer_t*    timer = priv? (tb_ltimer_t*)(((tb_pointer_t*)priv)[0]) : tb_null;
-    tb_hong_t*      now = priv? (tb_hong_t*)(((tb_pointer_t*)priv)[1]) : tb_null;
-    tb_assert_and_check_return_val(timer && now, tb_false);
-
-    // the task
-    tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)item;
-    if (timer_task)
+    // repeat?
+    if (timer_task->repeat)
     {
-        // repeat?
-        if (timer_task->repeat)
-        {
-            // update when
-            timer_task->when = *now + timer_task->period;
+        // update when
+        timer_task->when = now + timer_task->period;
 
-            // continue the task
-            if (!tb_ltimer_add_task(timer, timer_task))
-            {
-                // trace
-                tb_trace_e("continue to add timer_task failed");
-            }
-        }
-        else
+        // continue the task
+        if (!tb_ltimer_add_task(timer, timer_task))
         {
-            // refn--
-            if (timer_task->refn > 1) timer_task->refn--;
-            // remove it from pool directly
-            else tb_fixed_pool_free(timer->pool, timer_task);
+            // trace
+            tb_trace_e("continue to add timer_task failed");
         }
     }
-
-    // ok
-    return tb_true;
-}
-static tb_void_t tb_ltimer_expired_list_exit(tb_element_ref_t element, tb_pointer_t buff)
-{
-    // check
-    tb_vector_ref_t list = buff? *((tb_vector_ref_t*)buff) : tb_null;
-    tb_assert_and_check_return(list);
-
-    // exit list
-    tb_vector_exit(list);
-
-    // clear it
-    *((tb_pointer_t*)buff) = tb_null;
+    else
+    {
+        // refn--
+        if (timer_task->refn > 1) timer_task->refn--;
+        // remove it from pool directly
+        else tb_fixed_pool_free(timer->pool, timer_task);
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -348,8 +346,10 @@ tb_ltimer_ref_t tb_ltimer_init(tb_size_t grow, tb_size_t tick, tb_bool_t ctime)
         tb_assert_and_check_break(timer->pool);
 
         // init the expired tasks
-        timer->expired      = tb_vector_init((TB_LTIMER_WHEEL_MAXN >> 3) + 8, tb_element_ptr(tb_ltimer_expired_list_exit, tb_null));
-        tb_assert_and_check_break(timer->expired);
+        tb_list_entry_init(&timer->expired, tb_ltimer_task_t, entry, tb_null);
+
+        // init wheels
+        tb_ltimer_wheel_init(timer);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -394,15 +394,8 @@ tb_void_t tb_ltimer_exit(tb_ltimer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // exit wheel
-    {
-        tb_size_t i = 0;
-        for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-        {
-            if (timer->wheel[i]) tb_vector_exit(timer->wheel[i]);
-            timer->wheel[i] = tb_null;
-        }
-    }
+    // exit wheels
+    tb_ltimer_wheel_init(timer);
 
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
@@ -412,8 +405,7 @@ tb_void_t tb_ltimer_exit(tb_ltimer_ref_t self)
     tb_spinlock_leave(&timer->lock);
 
     // exit the expired tasks
-    if (timer->expired) tb_vector_exit(timer->expired);
-    timer->expired = tb_null;
+    tb_list_entry_exit(&timer->expired);
 
     // exit lock
     tb_spinlock_exit(&timer->lock);
@@ -440,16 +432,10 @@ tb_void_t tb_ltimer_clear(tb_ltimer_ref_t self)
 
         // move to the wheel head
         timer->btime = tb_ltimer_now(timer);
-        timer->wbase = 0;
+        timer->wtick = 0;
 
-        // clear wheel
-        {
-            tb_size_t i = 0;
-            for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-            {
-                if (timer->wheel[i]) tb_vector_clear(timer->wheel[i]);
-            }
-        }
+        // clear wheels
+        tb_ltimer_wheel_init(timer);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -465,7 +451,8 @@ tb_size_t tb_ltimer_limit(tb_ltimer_ref_t self)
     tb_assert_and_check_return_val(timer, 0);
 
     // the self limit
-    return (TB_LTIMER_WHEEL_MAXN * timer->tick);
+    tb_hize_t limit = TB_LTIMER_WHEEL_TICKN * timer->tick;
+    return (tb_size_t)tb_min(limit, (tb_hize_t)TB_MAXS32);
 }
 tb_size_t tb_ltimer_delay(tb_ltimer_ref_t self)
 {
@@ -480,7 +467,7 @@ tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
 {
     // check
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->tick && timer->expired, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_flag_test_explicit(&timer->stop, TB_ATOMIC_RELAXED), tb_false);
@@ -506,71 +493,92 @@ tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
         if (!tb_fixed_pool_size(timer->pool))
         {
             timer->btime = now;
-            timer->wbase = 0;
+            timer->wtick = 0;
             ok = tb_true;
             break;
         }
 
         // the diff
-        tb_size_t diff = (tb_size_t)((now - timer->btime) / timer->tick);
+        tb_hize_t diff = (tb_hize_t)((now - timer->btime) / timer->tick);
 
         // trace
-        tb_trace_d("spak: btime: %lld, wbase: %lu, now: %lld, diff: %lu", timer->btime, timer->wbase, now, diff);
+        tb_trace_d("spak: btime: %lld, wtick: %llu, now: %lld, diff: %llu", timer->btime, timer->wtick, now, diff);
 
-        // walk the expired lists
-        tb_size_t i = 0;
-        tb_size_t n = tb_min(diff, TB_LTIMER_WHEEL_MAXN - 1);
-        for (i = 0; i <= n; i++)
-        {
-            // the wheel index
-            tb_size_t indx = (timer->wbase + i) & (TB_LTIMER_WHEEL_MAXN - 1);
+        // expire the tasks of the current tick, the tasks may be added to it after the last spak
+        tb_ltimer_expire(timer);
 
-            // the wheel list
-            tb_vector_ref_t list = timer->wheel[indx];
-            tb_check_continue(list && tb_vector_size(list));
+        // walk the passed ticks
+        while (diff--)
+        {
+            // next tick
+            timer->wtick++;
+            timer->btime += timer->tick;
 
-            // detach the wheel list to the expired tasks
-            tb_vector_insert_tail(timer->expired, list);
-            timer->wheel[indx] = tb_null;
-        }
+            // cascade the node wheels if the lower wheel has been turned a circle
+            tb_size_t level = 0;
+            for (level = 0; level < TB_LTIMER_WHEEL_NODE_LEVELN; level++)
+            {
+                // not turned a circle?
+                if (timer->wtick & (((tb_hize_t)1 << TB_LTIMER_WHEEL_NODE_SHIFT(level)) - 1)) break;
 
-        // update the base time
-        timer->btime = now;
+                // cascade it
+                tb_ltimer_cascade(timer, level);
+            }
 
-        // update the wheel base
-        timer->wbase = (timer->wbase + diff) & (TB_LTIMER_WHEEL_MAXN - 1);
+            // expire the tasks of this tick
+            tb_ltimer_expire(timer);
+        }
 
         // ok
         ok = tb_true;
 
     } while (0);
 
+    // detach the expired tasks
+    tb_list_entry_head_t expired;
+    tb_list_entry_init(&expired, tb_ltimer_task_t, entry, tb_null);
+    tb_list_entry_splice_tail(&expired, &timer->expired);
+
     // leave
     tb_spinlock_leave(&timer->lock);
 
     // ok? and exists expired tasks?
-    if (ok && tb_vector_size(timer->expired))
+    if (ok && tb_list_entry_size(&expired))
     {
-        // done all expired list
-        tb_for_all_if (tb_vector_ref_t, list, timer->expired, list)
+        // done all expired tasks
+        tb_for_all_if (tb_ltimer_task_t*, timer_task, tb_list_entry_itor(&expired), timer_task)
         {
-            // done the expired task
-            tb_walk_all(list, tb_ltimer_expired_task_done, tb_null);
+            // done func
+            tb_ltimer_task_func_t func = timer_task->func;
+            if (func)
+            {
+                // trace
+                tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
 
-            // enter
-            tb_spinlock_enter(&timer->lock);
+                // done
+                func(timer_task->killed? tb_true : tb_false, timer_task->priv);
+            }
+        }
 
-            // exit the expired task
-            tb_pointer_t data[2]; data[0] = (tb_pointer_t)self; data[1] = &now;
-            tb_walk_all(list, tb_ltimer_expired_task_exit, data);
+        // enter
+        tb_spinlock_enter(&timer->lock);
+
+        // exit all expired tasks
+        while (tb_list_entry_size(&expired))
+        {
+            // get the task
+            tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry0(tb_list_entry_head(&expired));
+
+            // del the task from the expired tasks
+            tb_list_entry_remove_head(&expired);
 
-            // leave
-            tb_spinlock_leave(&timer->lock);
+            // exit it
+            tb_ltimer_expired_task_exit(timer, timer_task, now);
         }
-    }
 
-    // clear expired
-    tb_vector_clear(timer->expired);
+        // leave
+        tb_spinlock_leave(&timer->lock);
+    }
 
     // ok?
     return ok;
@@ -637,7 +645,7 @@ tb_ltimer_task_ref_t tb_ltimer_task_init_at(tb_ltimer_ref_t self, tb_hize_t when
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
         timer_task->killed    = 0;
-        timer_task->windx     = -1;
+        timer_task->wlist     = tb_null;
 
         // add timer_task
         if (!tb_ltimer_add_task(timer, timer_task))
@@ -695,7 +703,7 @@ tb_void_t tb_ltimer_task_post_at(tb_ltimer_ref_t self, tb_hize_t when, tb_size_t
         timer_task->period    = period;
         timer_task->repeat    = repeat? 1 : 0;
         timer_task->killed    = 0;
-        timer_task->windx     = -1;
+        timer_task->wlist     = tb_null;
 
         // add task
         if (!tb_ltimer_add_task(timer, timer_task))
@@ -727,7 +735,17 @@ tb_void_t tb_ltimer_task_exit(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    if (timer_task->refn > 1)
+    /* remove it from the wheel and the pool directly if it's pending
+     *
+     * the cancelled keep-alive timeouts will not be left in the wheel and cascaded until they expire
+     */
+    if (timer_task->refn > 1 && timer_task->wlist)
+    {
+        tb_ltimer_del_task(timer, timer_task);
+        tb_fixed_pool_free(timer->pool, timer_task);
+    }
+    // it's being done in the expired tasks now? cancel it and it will be freed after done
+    else if (timer_task->refn > 1)
     {
         // refn--
         timer_task->refn--;
@@ -762,13 +780,11 @@ tb_void_t tb_ltimer_task_kill(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
         // expired or removed?
         tb_check_break(timer_task->refn == 2);
 
+        // has been expired and not be added to the wheel now?
+        tb_check_break(timer_task->wlist);
+
         // del the task first
-        if (!tb_ltimer_del_task(timer, timer_task))
-        {
-            // trace
-            tb_trace_e("del timer_task failed");
-            break;
-        }
+        tb_ltimer_del_task(timer, timer_task);
 
         // killed
         timer_task->killed = 1;
@@ -48,9 +48,11 @@
 #include "stdfile.h"
 #include "fwatcher.h"
 #include "filelock.h"
+#include "filemap.h"
 #include "syserror.h"
 #include "addrinfo.h"
 #include "spinlock.h"
+#include "rwspinlock.h"
 #include "hostname.h"
 #include "semaphore.h"
 #include "backtrace.h"
@@ -48,6 +48,10 @@
     && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT)
 #   include "linux/poller_epoll.c"
 #   define TB_POLLER_ENABLE_EPOLL
+#   if defined(TB_CONFIG_LINUX_HAVE_IO_URING_SETUP) && !defined(TB_CONFIG_MICRO_ENABLE)
+#       include "linux/poller_iouring.c"
+#       define TB_POLLER_ENABLE_IOURING
+#   endif
 #elif defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_BSD)
 #   include "bsd/poller_kqueue.c"
 #   define TB_POLLER_ENABLE_KQUEUE
@@ -89,7 +93,11 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
     do
     {
         // init poller
-#if defined(TB_POLLER_ENABLE_EPOLL)
+#if defined(TB_POLLER_ENABLE_IOURING)
+        // attempt to use io_uring first, we will fall back to epoll if it's not supported by the current kernel
+        poller = tb_poller_iouring_init();
+        if (!poller) poller = tb_poller_epoll_init();
+#elif defined(TB_POLLER_ENABLE_EPOLL)
         poller = tb_poller_epoll_init();
 #elif defined(TB_POLLER_ENABLE_KQUEUE)
         poller = tb_poller_kqueue_init();
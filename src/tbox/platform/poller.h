@@ -48,6 +48,7 @@ typedef enum __tb_poller_type_e
 ,   TB_POLLER_TYPE_EPOLL        = 3
 ,   TB_POLLER_TYPE_KQUEUE       = 4
 ,   TB_POLLER_TYPE_SELECT       = 5
+,   TB_POLLER_TYPE_IOURING      = 6
 
 }tb_poller_type_e;
 
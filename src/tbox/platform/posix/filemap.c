@@ -0,0 +1,203 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../filemap.h"
+#include "../page.h"
+#include "../../memory/memory.h"
+#include <sys/mman.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the file map type
+typedef struct __tb_filemap_t
+{
+    // the data
+    tb_byte_t*          data;
+
+    // the size
+    tb_size_t           size;
+
+    // the size of the readable page before the data, only for the debug mode
+    tb_size_t           head;
+
+}tb_filemap_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_filemap_range(tb_filemap_t* filemap, tb_size_t offset, tb_size_t size, tb_byte_t** pdata, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(filemap && filemap->data && offset <= filemap->size, tb_false);
+
+    // the whole left data?
+    if (!size || size > filemap->size - offset) size = filemap->size - offset;
+    tb_check_return_val(size, tb_false);
+
+    // align the range to the pages
+    tb_size_t pagesize = tb_page_size();
+    tb_size_t start = tb_align(offset, pagesize) == offset? offset : tb_align(offset, pagesize) - pagesize;
+    *pdata = filemap->data + start;
+    *psize = size + (offset - start);
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_filemap_ref_t tb_filemap_init_from_file(tb_file_ref_t file, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(file, tb_null);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_filemap_t*   filemap = tb_null;
+    do
+    {
+        // get the file size, we cannot map the empty file
+        tb_hize_t size = tb_file_size(file);
+        tb_check_break(size);
+
+        // too large to be mapped?
+        tb_check_break((tb_hize_t)(tb_size_t)size == size);
+
+        // make filemap
+        filemap = tb_malloc0_type(tb_filemap_t);
+        tb_assert_and_check_break(filemap);
+
+        // map it
+        tb_int_t prot = (mode & TB_FILE_MODE_RW)? (PROT_READ | PROT_WRITE) : PROT_READ;
+#ifdef __tb_debug__
+        /* the debug checks of tb_memcpy() and etc. will read the pool data head before the given data,
+         * so we reserve a readable page before the mapping to avoid crashing at the first page
+         */
+        tb_size_t       head = tb_page_size();
+        tb_pointer_t    base = mmap(tb_null, head + (tb_size_t)size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        tb_check_break(base && base != MAP_FAILED);
+        tb_pointer_t    data = mmap((tb_byte_t*)base + head, (tb_size_t)size, prot, MAP_SHARED | MAP_FIXED, tb_file2fd(file), 0);
+        if (!data || data == MAP_FAILED)
+        {
+            munmap(base, head + (tb_size_t)size);
+            break;
+        }
+        filemap->head = head;
+#else
+        tb_pointer_t data = mmap(tb_null, (tb_size_t)size, prot, MAP_SHARED, tb_file2fd(file), 0);
+        tb_check_break(data && data != MAP_FAILED);
+#endif
+
+        // save it
+        filemap->data = (tb_byte_t*)data;
+        filemap->size = (tb_size_t)size;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (filemap) tb_filemap_exit((tb_filemap_ref_t)filemap);
+        filemap = tb_null;
+    }
+
+    // ok?
+    return (tb_filemap_ref_t)filemap;
+}
+tb_void_t tb_filemap_exit(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return(filemap);
+
+    // unmap it
+    if (filemap->data) munmap(filemap->data - filemap->head, filemap->head + filemap->size);
+    filemap->data = tb_null;
+    filemap->size = 0;
+
+    // exit it
+    tb_free(filemap);
+}
+tb_byte_t* tb_filemap_data(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap, tb_null);
+
+    // the data
+    return filemap->data;
+}
+tb_size_t tb_filemap_size(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap, 0);
+
+    // the size
+    return filemap->size;
+}
+tb_bool_t tb_filemap_advise(tb_filemap_ref_t self, tb_size_t advice, tb_size_t offset, tb_size_t size)
+{
+    // get the page-aligned range
+    tb_byte_t* data = tb_null;
+    if (!tb_filemap_range((tb_filemap_t*)self, offset, size, &data, &size)) return tb_false;
+
+    // the advice
+    tb_int_t flags;
+    switch (advice)
+    {
+#ifdef MADV_SEQUENTIAL
+    case TB_FILEMAP_ADVICE_SEQUENTIAL:  flags = MADV_SEQUENTIAL;    break;
+#endif
+#ifdef MADV_RANDOM
+    case TB_FILEMAP_ADVICE_RANDOM:      flags = MADV_RANDOM;        break;
+#endif
+#ifdef MADV_WILLNEED
+    case TB_FILEMAP_ADVICE_WILLNEED:    flags = MADV_WILLNEED;      break;
+#endif
+#ifdef MADV_DONTNEED
+    case TB_FILEMAP_ADVICE_DONTNEED:    flags = MADV_DONTNEED;      break;
+#endif
+    case TB_FILEMAP_ADVICE_NORMAL:      flags = MADV_NORMAL;        break;
+    default:                            return tb_false;
+    }
+
+    // advise it
+    return !madvise(data, size, flags);
+}
+tb_bool_t tb_filemap_sync(tb_filemap_ref_t self, tb_size_t offset, tb_size_t size)
+{
+    // get the page-aligned range
+    tb_byte_t* data = tb_null;
+    if (!tb_filemap_range((tb_filemap_t*)self, offset, size, &data, &size)) return tb_false;
+
+    // sync it
+    return !msync(data, size, MS_SYNC);
+}
@@ -24,8 +24,10 @@
  */
 #include "prefix.h"
 #include "../virtual_memory.h"
+#include "../page.h"
 #include "../../memory/impl/prefix.h"
 #include <sys/mman.h>
+#include <errno.h>
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -34,6 +36,15 @@
 #   define MAP_ANONYMOUS MAP_ANON
 #endif
 
+// the extra flags of the guarded memory, we need not reserve the swap space and it's usually used as stack
+#if defined(MAP_NORESERVE) && defined(MAP_STACK)
+#   define TB_VIRTUAL_MEMORY_GUARD_FLAGS    (MAP_NORESERVE | MAP_STACK)
+#elif defined(MAP_NORESERVE)
+#   define TB_VIRTUAL_MEMORY_GUARD_FLAGS    (MAP_NORESERVE)
+#else
+#   define TB_VIRTUAL_MEMORY_GUARD_FLAGS    (0)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -48,7 +59,7 @@ tb_pointer_t tb_virtual_memory_malloc(tb_size_t size)
      * @note we use tb_pool_data_head_t to support tb_pool_data_size() when checking memory in debug mode
      */
     tb_pool_data_head_t* block = mmap(tb_null, sizeof(tb_pool_data_head_t) + size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (block)
+    if (block && block != (tb_pool_data_head_t*)MAP_FAILED)
     {
         block->size = size;
         return (tb_pointer_t)&block[1];
@@ -87,4 +98,65 @@ tb_bool_t tb_virtual_memory_free(tb_pointer_t data)
     }
     return tb_true;
 }
+tb_pointer_t tb_virtual_memory_guard_malloc(tb_size_t size)
+{
+    // check
+    tb_check_return_val(size, tb_null);
+
+    // align size
+    tb_size_t pagesize = tb_page_size();
+    size = tb_align(size, pagesize);
 
+    // map the guard page and data, the pages will be committed when they are touched first
+    tb_byte_t* base = (tb_byte_t*)mmap(tb_null, pagesize + size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | TB_VIRTUAL_MEMORY_GUARD_FLAGS, -1, 0);
+    tb_check_return_val(base && base != (tb_byte_t*)MAP_FAILED, tb_null);
+
+    /* protect the guard page
+     *
+     * each guard page will split the memory mappings, so it may be failed if the count of mappings reach vm.max_map_count,
+     * and we will keep this data without guard page instead of failing, it can be merged with the adjacent mappings.
+     */
+    mprotect(base, pagesize, PROT_NONE);
+    return base + pagesize;
+}
+tb_bool_t tb_virtual_memory_guard_free(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data, tb_true);
+
+    // unmap the guard page and data
+    tb_size_t pagesize = tb_page_size();
+    size = tb_align(size, pagesize);
+    if (munmap((tb_byte_t*)data - pagesize, pagesize + size) == 0)
+        return tb_true;
+
+    // trace
+    tb_trace_e("guard_free: %p, %lu failed, errno: %d", data, size, errno);
+
+    /* unmap a part of the merged mappings may be failed if the count of mappings reach vm.max_map_count,
+     * but the guard page is a standalone mapping after mprotect, so we can unmap it first without splitting
+     * and it will give a mapping slot back to unmap the data pages.
+     */
+    if (munmap((tb_byte_t*)data - pagesize, pagesize) == 0 && munmap(data, size) == 0)
+        return tb_true;
+
+    // we purge the data pages at least if it still fails
+    tb_trace_e("guard_free: %p, %lu failed again, errno: %d, purge it only", data, size, errno);
+    tb_virtual_memory_purge(data, size);
+    return tb_false;
+}
+tb_bool_t tb_virtual_memory_purge(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && !((tb_size_t)data & (tb_page_size() - 1)), tb_false);
+
+    // only purge the whole pages
+    size &= ~(tb_page_size() - 1);
+    tb_check_return_val(size, tb_true);
+
+#ifdef MADV_DONTNEED
+    return madvise(data, size, MADV_DONTNEED) == 0;
+#else
+    return tb_false;
+#endif
+}
@@ -0,0 +1,183 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        rwspinlock.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_RWSPINLOCK_H
+#define TB_PLATFORM_RWSPINLOCK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "cpu.h"
+#include "sched.h"
+#include "atomic32.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the initial value
+#define TB_RWSPINLOCK_INIT          (0)
+
+// the writer is holding the lock
+#define TB_RWSPINLOCK_WRITER        (0x40000000)
+
+// the writer is waiting for the readers, the new readers will be blocked
+#define TB_RWSPINLOCK_WAITING       (0x20000000)
+
+// the readers count mask
+#define TB_RWSPINLOCK_READERS       (0x1fffffff)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// wait some time before trying it again
+static __tb_inline_force__ tb_void_t tb_rwspinlock_wait(tb_size_t* ptries)
+{
+#if defined(tb_cpu_pause) && !defined(TB_CONFIG_MICRO_ENABLE)
+    // pause it first
+    if (*ptries < 2048 && tb_cpu_count() > 1)
+    {
+        tb_size_t i, n = ++*ptries;
+        for (i = 0; i < n; i++)
+            tb_cpu_pause();
+        return ;
+    }
+#endif
+
+    // yield it
+    tb_sched_yield();
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the read-write spinlock
+ *
+ * the readers can enter it at the same time and the writer is exclusive,
+ * the waiting writer will block the new readers to avoid starving it.
+ *
+ * @note it's not recursive and only suitable for the short critical sections.
+ *
+ * @param lock      the lock
+ *
+ * @return          tb_true or tb_false
+ */
+static __tb_inline_force__ tb_bool_t tb_rwspinlock_init(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+    tb_atomic32_init(lock, TB_RWSPINLOCK_INIT);
+    return tb_true;
+}
+
+/*! exit the read-write spinlock
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_rwspinlock_exit(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+    tb_atomic32_set_explicit(lock, TB_RWSPINLOCK_INIT, TB_ATOMIC_RELAXED);
+}
+
+/*! enter the read-write spinlock for reading
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_rwspinlock_enter_read(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+
+    // lock it
+    tb_size_t tries = 0;
+    while (1)
+    {
+        // no writer? increase the readers count
+        tb_int32_t value = tb_atomic32_get_explicit(lock, TB_ATOMIC_RELAXED);
+        if (!(value & (TB_RWSPINLOCK_WRITER | TB_RWSPINLOCK_WAITING)) && tb_atomic32_compare_and_swap(lock, &value, value + 1))
+            return ;
+
+        // wait it
+        tb_rwspinlock_wait(&tries);
+    }
+}
+
+/*! leave the read-write spinlock for reading
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_rwspinlock_leave_read(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock && (tb_atomic32_get(lock) & TB_RWSPINLOCK_READERS));
+
+    // decrease the readers count
+    tb_atomic32_fetch_and_sub_explicit(lock, 1, TB_ATOMIC_RELEASE);
+}
+
+/*! enter the read-write spinlock for writing
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_rwspinlock_enter_write(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+
+    // lock it
+    tb_size_t tries = 0;
+    while (1)
+    {
+        // no readers and writer? hold it
+        tb_int32_t value = tb_atomic32_get_explicit(lock, TB_ATOMIC_RELAXED);
+        if (!(value & (TB_RWSPINLOCK_WRITER | TB_RWSPINLOCK_READERS)))
+        {
+            if (tb_atomic32_compare_and_swap(lock, &value, TB_RWSPINLOCK_WRITER))
+                return ;
+        }
+        // mark the waiting writer to block the new readers
+        else if (!(value & TB_RWSPINLOCK_WAITING))
+            tb_atomic32_fetch_and_or(lock, TB_RWSPINLOCK_WAITING);
+
+        // wait it
+        tb_rwspinlock_wait(&tries);
+    }
+}
+
+/*! leave the read-write spinlock for writing
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_rwspinlock_leave_write(tb_rwspinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock && (tb_atomic32_get(lock) & TB_RWSPINLOCK_WRITER));
+
+    // clear the writer and keep the waiting flag of the other writers
+    tb_atomic32_fetch_and_and_explicit(lock, ~TB_RWSPINLOCK_WRITER, TB_ATOMIC_RELEASE);
+}
+
+#endif
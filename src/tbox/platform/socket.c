@@ -35,6 +35,18 @@
 #   include "../coroutine/coroutine.h"
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// can the io requests be completed by the io scheduler directly in coroutine?
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE) \
+        && defined(TB_CONFIG_POSIX_HAVE_SOCKET) \
+        && defined(TB_CONFIG_LINUX_HAVE_IO_URING_SETUP)
+#   define TB_SOCKET_HAVE_IOREQ
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -169,6 +181,33 @@ tb_long_t tb_socket_wait_impl(tb_socket_ref_t sock, tb_size_t events, tb_long_t
     return -1;
 }
 #endif
+#ifdef TB_SOCKET_HAVE_IOREQ
+/* post the io request to the io scheduler of the current coroutine and wait its completion
+ *
+ * @return          tb_false if it cannot be completed directly, we need wait io events instead
+ */
+static tb_bool_t tb_socket_post(tb_poller_ioreq_ref_t ioreq, tb_size_t code, tb_socket_ref_t sock, tb_pointer_t data, tb_size_t size, tb_long_t timeout)
+{
+    // not in coroutine?
+    tb_check_return_val(tb_coroutine_self(), tb_false);
+
+    // get the io scheduler
+    tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io_need(tb_null);
+    tb_check_return_val(scheduler_io, tb_false);
+
+    // post it
+    ioreq->code = code;
+    ioreq->sock = sock;
+    ioreq->data = data;
+    ioreq->size = size;
+    if (!tb_co_scheduler_io_post(scheduler_io, ioreq, timeout)) return tb_false;
+
+    /* the kernel has not polled this socket internally?
+     * we need wait io events instead, but it should not happen if the poller supports it
+     */
+    return ioreq->result != -EAGAIN;
+}
+#endif
 tb_long_t tb_socket_wait(tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout)
 {
 #ifndef TB_CONFIG_OS_WINDOWS
@@ -195,27 +234,14 @@ tb_bool_t tb_socket_brecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
 {
     // recv data
     tb_size_t recv = 0;
-    tb_long_t wait = 0;
     while (recv < size)
     {
         // recv it
-        tb_long_t real = tb_socket_recv(sock, data + recv, size - recv);
-
-        // has data?
-        if (real > 0)
-        {
-            recv += real;
-            wait = 0;
-        }
-        // no data? wait it
-        else if (!real && !wait)
-        {
-            // wait it
-            wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, -1);
-            tb_check_break(wait > 0);
-        }
-        // failed or end?
-        else break;
+        tb_long_t real = tb_socket_wrecv(sock, data + recv, size - recv, -1);
+        tb_check_break(real > 0);
+
+        // update the received size
+        recv += real;
     }
     return recv == size;
 }
@@ -223,27 +249,142 @@ tb_bool_t tb_socket_bsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t
 {
     // send data
     tb_size_t send = 0;
-    tb_long_t wait = 0;
     while (send < size)
     {
         // send it
-        tb_long_t real = tb_socket_send(sock, data + send, size - send);
-
-        // has data?
-        if (real > 0)
-        {
-            send += real;
-            wait = 0;
-        }
-        // no data? wait it
-        else if (!real && !wait)
-        {
-            // wait it
-            wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, -1);
-            tb_check_break(wait > 0);
-        }
-        // failed or end?
-        else break;
+        tb_long_t real = tb_socket_wsend(sock, data + send, size - send, -1);
+        tb_check_break(real > 0);
+
+        // update the sent size
+        send += real;
     }
     return send == size;
 }
+tb_long_t tb_socket_wrecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data, -1);
+    tb_check_return_val(size, 0);
+
+#ifdef TB_SOCKET_HAVE_IOREQ
+    // recv it in the io scheduler directly, the received size will be zero if the connection has been closed
+    tb_poller_ioreq_t ioreq;
+    if (tb_socket_post(&ioreq, TB_POLLER_IOCODE_RECV, sock, data, size, timeout))
+        return ioreq.result > 0? ioreq.result : (ioreq.result == -ECANCELED? 0 : -1);
+#endif
+
+    // recv it and wait it if there is no data
+    tb_long_t wait = 0;
+    while (1)
+    {
+        // recv it
+        tb_long_t real = tb_socket_recv(sock, data, size);
+        tb_check_return_val(!real, real);
+
+        // no data after waiting? the connection has been closed
+        tb_check_return_val(!wait, -1);
+
+        // wait it
+        wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, timeout);
+        tb_check_return_val(wait > 0, wait);
+    }
+    return -1;
+}
+tb_long_t tb_socket_wsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data, -1);
+    tb_check_return_val(size, 0);
+
+#ifdef TB_SOCKET_HAVE_IOREQ
+    // send it in the io scheduler directly
+    tb_poller_ioreq_t ioreq;
+    if (tb_socket_post(&ioreq, TB_POLLER_IOCODE_SEND, sock, (tb_pointer_t)data, size, timeout))
+        return ioreq.result > 0? ioreq.result : (ioreq.result == -ECANCELED? 0 : -1);
+#endif
+
+    // send it and wait it if the socket is not writable
+    tb_long_t wait = 0;
+    while (1)
+    {
+        // send it
+        tb_long_t real = tb_socket_send(sock, data, size);
+        tb_check_return_val(!real, real);
+
+        // cannot send data after waiting? failed
+        tb_check_return_val(!wait, -1);
+
+        // wait it
+        wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, timeout);
+        tb_check_return_val(wait > 0, wait);
+    }
+    return -1;
+}
+tb_socket_ref_t tb_socket_waccept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock, tb_null);
+
+#ifdef TB_SOCKET_HAVE_IOREQ
+    // accept it in the io scheduler directly, the client socket has been non-blocking
+    tb_poller_ioreq_t       ioreq;
+    struct sockaddr_storage d;
+    ioreq.addrlen = sizeof(d);
+    if (tb_socket_post(&ioreq, TB_POLLER_IOCODE_ACPT, sock, &d, 0, timeout))
+    {
+        // timeout or failed?
+        tb_check_return_val(ioreq.result >= 0, tb_null);
+
+        // disable the nagle's algorithm like tb_socket_accept()
+        tb_int_t enable = 1;
+        setsockopt((tb_int_t)ioreq.result, IPPROTO_TCP, TCP_NODELAY, (tb_char_t*)&enable, sizeof(enable));
+
+        // save address
+        if (addr) tb_sockaddr_save(addr, &d);
+        return tb_fd2sock(ioreq.result);
+    }
+#endif
+
+    // accept it and wait it if there is no client
+    tb_long_t wait = 0;
+    while (1)
+    {
+        // accept it
+        tb_socket_ref_t client = tb_socket_accept(sock, addr);
+        tb_check_return_val(!client, client);
+
+        // no client after waiting? failed
+        tb_check_return_val(!wait, tb_null);
+
+        // wait it
+        wait = tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, timeout);
+        tb_check_return_val(wait > 0, tb_null);
+    }
+    return tb_null;
+}
+tb_long_t tb_socket_wconnect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && addr, -1);
+
+#ifdef TB_SOCKET_HAVE_IOREQ
+    // connect it in the io scheduler directly
+    tb_poller_ioreq_t       ioreq;
+    struct sockaddr_storage d;
+    ioreq.addrlen = (tb_uint32_t)tb_sockaddr_load(&d, addr);
+    tb_assert_and_check_return_val(ioreq.addrlen, -1);
+    if (tb_socket_post(&ioreq, TB_POLLER_IOCODE_CONN, sock, &d, 0, timeout))
+        return (!ioreq.result || ioreq.result == -EISCONN)? 1 : (ioreq.result == -ECANCELED? 0 : -1);
+#endif
+
+    // connect it
+    tb_long_t ok = tb_socket_connect(sock, addr);
+    tb_check_return_val(!ok, ok);
+
+    // wait it
+    tb_long_t wait = tb_socket_wait(sock, TB_SOCKET_EVENT_CONN, timeout);
+    tb_check_return_val(wait > 0, wait);
+
+    // connect it again
+    return tb_socket_connect(sock, addr);
+}
@@ -249,6 +249,51 @@ tb_bool_t           tb_socket_brecv(tb_socket_ref_t sock, tb_byte_t* data, tb_si
  */
 tb_bool_t           tb_socket_bsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size);
 
+/*! recv the socket data for tcp and wait it if there is no data
+ *
+ * it will be completed by the io scheduler directly (.e.g io_uring) in coroutine,
+ * so the coroutine will be resumed with the received data.
+ *
+ * @param sock      the socket
+ * @param data      the data
+ * @param size      the size
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          the real size, 0: timeout, -1: failed or closed
+ */
+tb_long_t           tb_socket_wrecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout);
+
+/*! send the socket data for tcp and wait it if the socket is not writable
+ *
+ * @param sock      the socket
+ * @param data      the data
+ * @param size      the size
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          the real size, 0: timeout, -1: failed
+ */
+tb_long_t           tb_socket_wsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout);
+
+/*! accept socket and wait it if there is no client
+ *
+ * @param sock      the socket
+ * @param addr      the client address
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          the client socket, it will return tb_null if be timeout or failed
+ */
+tb_socket_ref_t     tb_socket_waccept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout);
+
+/*! connect the given client address and wait it
+ *
+ * @param sock      the socket
+ * @param addr      the client address
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          ok: 1, timeout: 0; failed: -1
+ */
+tb_long_t           tb_socket_wconnect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr, tb_long_t timeout);
+
 /*! recvv the socket data for tcp
  *
  * @param sock      the socket
@@ -46,18 +46,18 @@
 #   define TB_THREAD_POOL_WORKER_MAXN           (64)
 #endif
 
-// the jobs grow
+// the initial jobs size of the worker deque, must be power of 2
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_POOL_GROW        (256)
+#   define TB_THREAD_POOL_DEQUE_SIZE            (64)
 #else
-#   define TB_THREAD_POOL_JOBS_POOL_GROW        (512)
+#   define TB_THREAD_POOL_DEQUE_SIZE            (256)
 #endif
 
-// the working jobs grow
+// the maximum jobs count of pulling from the injector at once
 #ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_WORKING_GROW     (32)
+#   define TB_THREAD_POOL_JOBS_PULL_MAXN        (16)
 #else
-#   define TB_THREAD_POOL_JOBS_WORKING_GROW     (64)
+#   define TB_THREAD_POOL_JOBS_PULL_MAXN        (32)
 #endif
 
 // the jobs waiting maxn
@@ -67,13 +67,6 @@
 #   define TB_THREAD_POOL_JOBS_WAITING_MAXN     (1 << 20)
 #endif
 
-// the pull jobs time maxn
-#ifdef __tb_small__
-#   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (10000)
-#else
-#   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (20000)
-#endif
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -97,21 +90,49 @@ typedef struct __tb_thread_pool_job_t
      */
     tb_atomic32_t                       state;
 
-    // the entry
+    // the kill generation of the thread pool when this job was posted
+    tb_int32_t                          killgen;
+
+    // the entry for the injector
     tb_list_entry_t                     entry;
 
 }tb_thread_pool_job_t;
 
-// the thread pool job stats type
-typedef struct __tb_thread_pool_job_stats_t
+// the thread pool worker deque buffer type
+typedef struct __tb_thread_pool_deque_buffer_t
+{
+    // the previous buffer, we cannot free it before all workers have been exited because it may be stealing now
+    struct __tb_thread_pool_deque_buffer_t* prev;
+
+    // the jobs size, must be power of 2
+    tb_size_t                           size;
+
+    // the jobs
+    tb_atomic_t                         jobs[1];
+
+}tb_thread_pool_deque_buffer_t;
+
+/* the thread pool worker deque type
+ *
+ * it's a Chase-Lev work-stealing deque,
+ * only the owner worker pushes and pops jobs at the bottom without any lock,
+ * and the other workers steal jobs from the top by cas.
+ */
+typedef struct __tb_thread_pool_deque_t
 {
-    // the done count
-    tb_size_t                           done_count;
+    // the top index
+    tb_atomic_t                         top;
+
+    // the padding for the top and bottom index in the different cache lines
+    tb_byte_t                           pad[TB_L1_CACHE_BYTES];
+
+    // the bottom index
+    tb_atomic_t                         bottom;
 
-    // the done total time
-    tb_hize_t                           total_time;
+    // the buffer
+    tb_atomic_t                         buffer;
 
-}tb_thread_pool_job_stats_t;
+}tb_thread_pool_deque_t;
 
 // the thread pool worker priv type
 typedef struct __tb_thread_pool_worker_priv_t
@@ -136,14 +157,11 @@ typedef struct __tb_thread_pool_worker_t
     // the loop
     tb_thread_ref_t                     loop;
 
-    // the jobs
-    tb_vector_ref_t                     jobs;
-
-    // the pull time
-    tb_size_t                           pull;
+    // the jobs deque
+    tb_thread_pool_deque_t              jobs;
 
-    // the stats
-    tb_hash_map_ref_t                   stats;
+    // the random seed for stealing jobs
+    tb_uint32_t                         seed;
 
     // is stoped?
     tb_atomic_flag_t                    bstoped;
@@ -162,35 +180,58 @@ typedef struct __tb_thread_pool_impl_t
     // the worker maxn
     tb_size_t                           worker_maxn;
 
-    // the lock
+    // the lock for the injector and workers
     tb_spinlock_t                       lock;
 
-    // the jobs pool
-    tb_fixed_pool_ref_t                 jobs_pool;
+    // the jobs count
+    tb_atomic32_t                       jobs_count;
+
+    // the kill generation, all waiting jobs posted before it will be killed
+    tb_atomic32_t                       jobs_killgen;
 
-    // the urgent jobs
+    // the urgent jobs of the injector
     tb_list_entry_head_t                jobs_urgent;
 
-    // the waiting jobs
+    // the waiting jobs of the injector
     tb_list_entry_head_t                jobs_waiting;
 
-    // the pending jobs
-    tb_list_entry_head_t                jobs_pending;
+    // the injector jobs count, we can read it without lock
+    tb_atomic32_t                       jobs_injected;
+
+    // the urgent jobs count of the injector, we can read it without lock
+    tb_atomic32_t                       jobs_injected_urgent;
 
     // is stoped
-    tb_bool_t                           bstoped;
+    tb_atomic32_t                       bstoped;
+
+    // the idle workers count
+    tb_atomic32_t                       idle_count;
 
     // the semaphore
     tb_semaphore_ref_t                  semaphore;
 
     // the worker size
-    tb_size_t                           worker_size;
+    tb_atomic32_t                       worker_size;
 
     // the worker list
     tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
 
 }tb_thread_pool_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the worker of the current thread
+#ifdef __tb_thread_local__
+static __tb_thread_local__ tb_thread_pool_worker_t*    g_worker_self = tb_null;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -216,159 +257,250 @@ static tb_void_t tb_thread_pool_instance_kill(tb_handle_t pool, tb_cpointer_t pr
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * worker implementation
+ * deque implementation
  */
-static tb_bool_t tb_thread_pool_worker_walk_pull(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value, tb_bool_t* is_break)
+static tb_thread_pool_deque_buffer_t* tb_thread_pool_deque_buffer_init(tb_size_t size)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs && worker->stats && is_break);
-
-    // full?
-    if (worker->pull >= TB_THREAD_POOL_JOBS_PULL_TIME_MAXN)
-    {
-        // break it
-        *is_break = tb_true;
-        return tb_false;
-    }
+    // check
+    tb_assert(size && !(size & (size - 1)));
 
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // make buffer
+    tb_thread_pool_deque_buffer_t* buffer = (tb_thread_pool_deque_buffer_t*)tb_malloc0(sizeof(tb_thread_pool_deque_buffer_t) + (size - 1) * sizeof(tb_atomic_t));
+    tb_assert_and_check_return_val(buffer, tb_null);
 
-    // the pool
-    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-    tb_assert(impl);
+    // init buffer
+    buffer->size = size;
+    return buffer;
+}
+static tb_bool_t tb_thread_pool_deque_init(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque);
 
-    // append the job to the pending jobs
-    tb_list_entry_insert_tail(&impl->jobs_pending, &job->entry);
+    // init buffer
+    tb_thread_pool_deque_buffer_t* buffer = tb_thread_pool_deque_buffer_init(TB_THREAD_POOL_DEQUE_SIZE);
+    tb_assert_and_check_return_val(buffer, tb_false);
 
-    // append the job to the working jobs
-    tb_vector_insert_tail(worker->jobs, job);
+    // init deque
+    tb_atomic_init(&deque->top, 0);
+    tb_atomic_init(&deque->bottom, 0);
+    tb_atomic_init(&deque->buffer, (tb_long_t)buffer);
+    return tb_true;
+}
+static tb_void_t tb_thread_pool_deque_exit(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque);
 
-    // computate the job average time
-    tb_size_t average_time = 200;
-    if (tb_hash_map_size(worker->stats))
+    // exit all buffers
+    tb_thread_pool_deque_buffer_t* buffer = (tb_thread_pool_deque_buffer_t*)tb_atomic_get(&deque->buffer);
+    while (buffer)
     {
-        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-        if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
+        tb_thread_pool_deque_buffer_t* prev = buffer->prev;
+        tb_free(buffer);
+        buffer = prev;
     }
+    tb_atomic_set(&deque->buffer, 0);
+}
+static tb_size_t tb_thread_pool_deque_size(tb_thread_pool_deque_t* deque)
+{
+    // check
+    tb_assert(deque);
 
-    // update the pull time
-    worker->pull += average_time;
+    // get the approximate size
+    tb_long_t top = tb_atomic_get_explicit(&deque->top, TB_ATOMIC_ACQUIRE);
+    tb_long_t bottom = tb_atomic_get_explicit(&deque->bottom, TB_ATOMIC_ACQUIRE);
+    return bottom > top? (tb_size_t)(bottom - top) : 0;
+}
+static tb_bool_t tb_thread_pool_deque_push(tb_thread_pool_deque_t* deque, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(deque && job);
 
-    // trace
-    tb_trace_d("worker[%lu]: pull: task[%p:%s] from %s", worker->id, job->task.done, job->task.name, iterator == tb_list_entry_itor(&impl->jobs_waiting)? "waiting" : "urgent");
+    // get the bottom, top and buffer
+    tb_long_t                       bottom = tb_atomic_get_explicit(&deque->bottom, TB_ATOMIC_RELAXED);
+    tb_long_t                       top = tb_atomic_get_explicit(&deque->top, TB_ATOMIC_ACQUIRE);
+    tb_thread_pool_deque_buffer_t*  buffer = (tb_thread_pool_deque_buffer_t*)tb_atomic_get_explicit(&deque->buffer, TB_ATOMIC_RELAXED);
+    tb_assert(buffer);
+
+    // full? grow it
+    if (bottom - top > (tb_long_t)buffer->size - 1)
+    {
+        // make a larger buffer
+        tb_thread_pool_deque_buffer_t* buffer_new = tb_thread_pool_deque_buffer_init(buffer->size << 1);
+        tb_assert_and_check_return_val(buffer_new, tb_false);
+
+        // copy jobs
+        tb_long_t i;
+        for (i = top; i < bottom; i++)
+            tb_atomic_set_explicit(&buffer_new->jobs[i & (buffer_new->size - 1)], tb_atomic_get_explicit(&buffer->jobs[i & (buffer->size - 1)], TB_ATOMIC_RELAXED), TB_ATOMIC_RELAXED);
+
+        // keep the old buffer, some workers may be stealing from it now
+        buffer_new->prev = buffer;
 
-    // remove the job from the waiting or urgent jobs
+        // update buffer
+        tb_atomic_set_explicit(&deque->buffer, (tb_long_t)buffer_new, TB_ATOMIC_RELEASE);
+        buffer = buffer_new;
+    }
+
+    // push it
+    tb_atomic_set_explicit(&buffer->jobs[bottom & (buffer->size - 1)], (tb_long_t)job, TB_ATOMIC_RELAXED);
+    tb_atomic_set_explicit(&deque->bottom, bottom + 1, TB_ATOMIC_RELEASE);
     return tb_true;
 }
-static tb_bool_t tb_thread_pool_worker_walk_pull_and_clean(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_thread_pool_job_t* tb_thread_pool_deque_pop(tb_thread_pool_deque_t* deque)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs && worker->stats);
+    // check
+    tb_assert(deque);
 
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // reserve the bottom job
+    tb_long_t                       bottom = tb_atomic_get_explicit(&deque->bottom, TB_ATOMIC_RELAXED) - 1;
+    tb_thread_pool_deque_buffer_t*  buffer = (tb_thread_pool_deque_buffer_t*)tb_atomic_get_explicit(&deque->buffer, TB_ATOMIC_RELAXED);
+    tb_atomic_set_explicit(&deque->bottom, bottom, TB_ATOMIC_RELAXED);
+    tb_memory_barrier();
+    tb_long_t                       top = tb_atomic_get_explicit(&deque->top, TB_ATOMIC_RELAXED);
+
+    // empty? restore the bottom
+    if (top > bottom)
+    {
+        tb_atomic_set_explicit(&deque->bottom, bottom + 1, TB_ATOMIC_RELAXED);
+        return tb_null;
+    }
 
-    // the job state
-    tb_size_t state = tb_atomic32_get(&job->state);
+    // get the bottom job
+    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)tb_atomic_get_explicit(&buffer->jobs[bottom & (buffer->size - 1)], TB_ATOMIC_RELAXED);
 
-    // waiting and non-full? pull it
-    tb_bool_t ok = tb_false;
-    if (state == TB_STATE_WAITING && worker->pull < TB_THREAD_POOL_JOBS_PULL_TIME_MAXN)
+    // the last job? we need race with the stealing workers
+    if (top == bottom)
     {
-        // append the job to the working jobs
-        tb_vector_insert_tail(worker->jobs, job);
+        if (!tb_atomic_compare_and_swap_explicit(&deque->top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED))
+            job = tb_null;
+        tb_atomic_set_explicit(&deque->bottom, bottom + 1, TB_ATOMIC_RELAXED);
+    }
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_deque_steal(tb_thread_pool_deque_t* deque, tb_bool_t* aborted)
+{
+    // check
+    tb_assert(deque && aborted);
 
-        // computate the job average time
-        tb_size_t average_time = 200;
-        if (tb_hash_map_size(worker->stats))
-        {
-            tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-            if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
-        }
+    // get the top and bottom
+    tb_long_t top = tb_atomic_get_explicit(&deque->top, TB_ATOMIC_ACQUIRE);
+    tb_memory_barrier();
+    tb_long_t bottom = tb_atomic_get_explicit(&deque->bottom, TB_ATOMIC_ACQUIRE);
 
-        // update the pull time
-        worker->pull += average_time;
+    // empty?
+    tb_check_return_val(top < bottom, tb_null);
 
-        // trace
-        tb_trace_d("worker[%lu]: pull: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
+    // get the top job
+    tb_thread_pool_deque_buffer_t*  buffer = (tb_thread_pool_deque_buffer_t*)tb_atomic_get_explicit(&deque->buffer, TB_ATOMIC_ACQUIRE);
+    tb_thread_pool_job_t*           job = (tb_thread_pool_job_t*)tb_atomic_get_explicit(&buffer->jobs[top & (buffer->size - 1)], TB_ATOMIC_RELAXED);
+
+    // steal it, it may be taken by the owner or the other workers
+    if (!tb_atomic_compare_and_swap_explicit(&deque->top, &top, top + 1, TB_ATOMIC_SEQ_CST, TB_ATOMIC_RELAXED))
+    {
+        *aborted = tb_true;
+        return tb_null;
     }
-    // finished or killed? remove it
-    else if (state == TB_STATE_FINISHED || state == TB_STATE_KILLED)
+    return job;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * jobs implementation
+ */
+static tb_void_t tb_thread_pool_jobs_exit(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && job);
+
+    // refn--, free it if no one refers to it
+    if (tb_atomic32_fetch_and_sub(&job->refn, 1) == 1)
     {
         // trace
-        tb_trace_d("worker[%lu]: remove: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
+        tb_trace_d("task[%p:%s]: exit", job->task.done, job->task.name);
 
-        // exit the job
-        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+        // free it
+        tb_free(job);
 
-        // remove it from the waiting or urgent jobs
-        ok = tb_true;
+        // update the jobs count
+        tb_atomic32_fetch_and_sub(&impl->jobs_count, 1);
+    }
+}
+static tb_thread_pool_job_t* tb_thread_pool_jobs_init(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_int32_t refn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && task && task->done, tb_null);
 
-        // refn--
-        if (job->refn > 1) job->refn--;
-        // remove it from pool directly
-        else
-        {
-            // the pool
-            tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-            tb_assert(impl);
+    // too many jobs?
+    if (tb_atomic32_fetch_and_add(&impl->jobs_count, 1) + 1 >= TB_THREAD_POOL_JOBS_WAITING_MAXN)
+    {
+        // trace
+        tb_trace_e("too many jobs!");
 
-            // remove it from the jobs pool
-            tb_fixed_pool_free(impl->jobs_pool, job);
-        }
+        // restore the jobs count
+        tb_atomic32_fetch_and_sub(&impl->jobs_count, 1);
+        return tb_null;
     }
 
-    // remove it?
-    return ok;
+    // make job
+    tb_thread_pool_job_t* job = tb_malloc0_type(tb_thread_pool_job_t);
+    if (!job)
+    {
+        tb_atomic32_fetch_and_sub(&impl->jobs_count, 1);
+        return tb_null;
+    }
+
+    // init job
+    tb_atomic32_init(&job->refn, refn);
+    tb_atomic32_init(&job->state, TB_STATE_WAITING);
+    job->killgen    = tb_atomic32_get(&impl->jobs_killgen);
+    job->task       = *task;
+    return job;
 }
-static tb_bool_t tb_thread_pool_worker_walk_clean(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_void_t tb_thread_pool_jobs_done(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
 {
-    // the worker pull
-    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)value;
-    tb_assert(worker && worker->jobs);
-
-    // the job
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert(job);
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl && job && job->task.done);
 
-    // the job state
-    tb_size_t state = tb_atomic32_get(&job->state);
+    // this job has been killed by tb_thread_pool_task_kill_all()?
+    tb_int32_t state = TB_STATE_WAITING;
+    if (job->killgen != tb_atomic32_get(&impl->jobs_killgen))
+        tb_atomic32_compare_and_swap(&job->state, &state, TB_STATE_KILLING);
 
-    // finished or killed? remove it
-    tb_bool_t ok = tb_false;
-    if (state == TB_STATE_FINISHED || state == TB_STATE_KILLED)
+    // the job is waiting? work it
+    state = TB_STATE_WAITING;
+    if (tb_atomic32_compare_and_swap(&job->state, &state, TB_STATE_WORKING))
     {
         // trace
-        tb_trace_d("worker[%lu]: remove: task[%p:%s] from pending", worker->id, job->task.done, job->task.name);
-
-        // exit the job
-        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
 
-        // remove it from the pending jobs
-        ok = tb_true;
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
 
-        // refn--
-        if (job->refn > 1) job->refn--;
-        // remove it from pool directly
-        else
-        {
-            // the pool
-            tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
-            tb_assert(impl);
+        // update the job state
+        tb_atomic32_set(&job->state, TB_STATE_FINISHED);
+    }
+    // the job is killing? kill it
+    else if (state == TB_STATE_KILLING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: kill: task[%p:%s]", worker->id, job->task.done, job->task.name);
 
-            // remove it from the jobs pool
-            tb_fixed_pool_free(impl->jobs_pool, job);
-        }
+        // update the job state
+        tb_atomic32_set(&job->state, TB_STATE_KILLED);
     }
 
-    // remove it?
-    return ok;
+    // exit the private data of this job
+    if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+    // exit this job
+    tb_thread_pool_jobs_exit(impl, job);
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * worker implementation
+ */
 static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size_t post)
 {
     // check
@@ -381,6 +513,198 @@ static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size
     if (value >= 0 && (tb_size_t)value < post)
         tb_semaphore_post(impl->semaphore, post - value);
 }
+static tb_void_t tb_thread_pool_worker_wake(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    /* wake up one idle worker if exists
+     *
+     * we need a full barrier here to see the idle worker after posting job,
+     * the idle worker will check jobs again after updating the idle count.
+     */
+    tb_memory_barrier();
+    if (tb_atomic32_get(&impl->idle_count) > 0)
+        tb_thread_pool_worker_post(impl, 1);
+}
+static tb_void_t tb_thread_pool_worker_spawn(tb_thread_pool_impl_t* impl, tb_size_t jobs_count)
+{
+    // check
+    tb_assert(impl);
+
+    // no more worker?
+    tb_size_t worker_size = (tb_size_t)tb_atomic32_get(&impl->worker_size);
+    tb_check_return(worker_size < impl->worker_maxn && worker_size < jobs_count);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // init them if the workers have been not inited
+    worker_size = (tb_size_t)tb_atomic32_get(&impl->worker_size);
+    if (!tb_atomic32_get(&impl->bstoped) && worker_size < jobs_count)
+    {
+        tb_size_t i = worker_size;
+        tb_size_t n = tb_min(jobs_count, impl->worker_maxn);
+        for (; i < n; i++)
+        {
+            // the worker
+            tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+            // clear worker
+            tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
+
+            // init worker
+            tb_atomic_flag_clear_explicit(&worker->bstoped, TB_ATOMIC_RELAXED);
+            worker->id          = i;
+            worker->pool        = (tb_thread_pool_ref_t)impl;
+            worker->seed        = (tb_uint32_t)(i * 2654435761u + 1);
+            if (!tb_thread_pool_deque_init(&worker->jobs)) break;
+
+            // publish this worker before starting it, the other workers may steal jobs from it
+            tb_atomic32_set(&impl->worker_size, (tb_int32_t)(i + 1));
+
+            // start worker
+            worker->loop        = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
+            tb_assert_and_check_break(worker->loop);
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_pull(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // no injected jobs?
+    tb_check_return_val(tb_atomic32_get(&impl->jobs_injected) > 0, tb_null);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // pull the fair share of the injected jobs, the first job will be done directly and the others are pushed to our deque
+    tb_size_t               worker_size = tb_max((tb_size_t)tb_atomic32_get(&impl->worker_size), 1);
+    tb_size_t               jobs_size = tb_list_entry_size(&impl->jobs_urgent) + tb_list_entry_size(&impl->jobs_waiting);
+    tb_size_t               pull_size = tb_min(jobs_size / worker_size + 1, TB_THREAD_POOL_JOBS_PULL_MAXN);
+    tb_size_t               pull_count = 0;
+    tb_size_t               pull_urgent = 0;
+    tb_thread_pool_job_t*   job_first = tb_null;
+    while (pull_count < pull_size)
+    {
+        // pull from the urgent jobs first
+        tb_list_entry_head_ref_t jobs = tb_list_entry_size(&impl->jobs_urgent)? &impl->jobs_urgent : &impl->jobs_waiting;
+        tb_check_break(tb_list_entry_size(jobs));
+
+        // get the head job
+        tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)tb_list_entry(jobs, tb_list_entry_head(jobs));
+        tb_list_entry_remove_head(jobs);
+
+        // save the first job
+        if (!job_first) job_first = job;
+        // push it to our deque
+        else if (!tb_thread_pool_deque_push(&worker->jobs, job))
+        {
+            // failed? restore it
+            tb_list_entry_insert_head(jobs, &job->entry);
+            break;
+        }
+        if (jobs == &impl->jobs_urgent) pull_urgent++;
+        pull_count++;
+    }
+    tb_atomic32_fetch_and_sub(&impl->jobs_injected, (tb_int32_t)pull_count);
+    tb_atomic32_fetch_and_sub(&impl->jobs_injected_urgent, (tb_int32_t)pull_urgent);
+
+    // trace
+    tb_trace_d("worker[%lu]: pull: %lu jobs, urgent: %lu, waiting: %lu", worker->id, pull_count, tb_list_entry_size(&impl->jobs_urgent), tb_list_entry_size(&impl->jobs_waiting));
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // wake up the other idle worker to steal the pulled jobs
+    if (pull_count > 1) tb_thread_pool_worker_wake(impl);
+    return job_first;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_pull_urgent(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // no injected urgent jobs?
+    tb_check_return_val(tb_atomic32_get(&impl->jobs_injected_urgent) > 0, tb_null);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // pull the head urgent job, the other workers will pull the left urgent jobs before their local jobs too
+    tb_thread_pool_job_t* job = tb_null;
+    if (tb_list_entry_size(&impl->jobs_urgent))
+    {
+        job = (tb_thread_pool_job_t*)tb_list_entry(&impl->jobs_urgent, tb_list_entry_head(&impl->jobs_urgent));
+        tb_list_entry_remove_head(&impl->jobs_urgent);
+        tb_atomic32_fetch_and_sub(&impl->jobs_injected, 1);
+        tb_atomic32_fetch_and_sub(&impl->jobs_injected_urgent, 1);
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_steal(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // only one worker?
+    tb_size_t worker_size = (tb_size_t)tb_atomic32_get(&impl->worker_size);
+    tb_check_return_val(worker_size > 1, tb_null);
+
+    // try stealing from the random victims until all deques are empty
+    tb_bool_t aborted = tb_false;
+    do
+    {
+        // start from a random victim
+        aborted = tb_false;
+        worker->seed = worker->seed * 1103515245 + 12345;
+        tb_size_t i = 0;
+        tb_size_t start = (worker->seed >> 16) % worker_size;
+        for (i = 0; i < worker_size; i++)
+        {
+            // the victim
+            tb_thread_pool_worker_t* victim = &impl->worker_list[(start + i) % worker_size];
+            tb_check_continue(victim != worker);
+
+            // steal it
+            tb_thread_pool_job_t* job = tb_thread_pool_deque_steal(&victim->jobs, &aborted);
+            if (job) return job;
+        }
+
+    } while (aborted);
+
+    // no jobs
+    return tb_null;
+}
+static tb_bool_t tb_thread_pool_worker_has_jobs(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // has injected jobs?
+    if (tb_atomic32_get(&impl->jobs_injected) > 0) return tb_true;
+
+    // has jobs in the deques?
+    tb_size_t i = 0;
+    tb_size_t n = (tb_size_t)tb_atomic32_get(&impl->worker_size);
+    for (i = 0; i < n; i++)
+    {
+        if (tb_thread_pool_deque_size(&impl->worker_list[i].jobs)) return tb_true;
+    }
+    return tb_false;
+}
 static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 {
     // the worker
@@ -393,188 +717,63 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
     do
     {
         // check
-        tb_assert_and_check_break(worker && !worker->jobs && !worker->stats);
+        tb_assert_and_check_break(worker);
 
         // the pool
         tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
         tb_assert_and_check_break(impl && impl->semaphore);
 
-        // wait some time for leaving the lock
-        tb_msleep((worker->id + 1) * 20);
-
-        // init jobs
-        worker->jobs = tb_vector_init(TB_THREAD_POOL_JOBS_WORKING_GROW, tb_element_ptr(tb_null, tb_null));
-        tb_assert_and_check_break(worker->jobs);
-
-        // init stats
-        worker->stats = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_ptr(tb_null, tb_null), tb_element_mem(sizeof(tb_thread_pool_job_stats_t), tb_null, tb_null));
-        tb_assert_and_check_break(worker->stats);
+#ifdef __tb_thread_local__
+        // save the current worker
+        g_worker_self = worker;
+#endif
 
         // loop
         while (1)
         {
-            // pull jobs if be idle
-            if (!tb_vector_size(worker->jobs))
+            /* pull the urgent job from the injector first, then pop job from our deque,
+             * and pull job from the injector or steal it from the other workers if be idle
+             */
+            tb_thread_pool_job_t* job = tb_thread_pool_worker_pull_urgent(worker);
+            if (!job) job = tb_thread_pool_deque_pop(&worker->jobs);
+            if (!job) job = tb_thread_pool_worker_pull(worker);
+            if (!job) job = tb_thread_pool_worker_steal(worker);
+
+            // done job
+            if (job)
             {
-                // enter
-                tb_spinlock_enter(&impl->lock);
-
-                // init the pull time
-                worker->pull = 0;
-
-                // pull from the urgent jobs
-                if (tb_list_entry_size(&impl->jobs_urgent))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from urgent: %lu", worker->id, tb_list_entry_size(&impl->jobs_urgent));
-
-                    // pull it
-                    tb_remove_if_until(tb_list_entry_itor(&impl->jobs_urgent), tb_thread_pool_worker_walk_pull, worker);
-                }
-
-                // pull from the waiting jobs
-                if (tb_list_entry_size(&impl->jobs_waiting))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from waiting: %lu", worker->id, tb_list_entry_size(&impl->jobs_waiting));
-
-                    // pull it
-                    tb_remove_if_until(tb_list_entry_itor(&impl->jobs_waiting), tb_thread_pool_worker_walk_pull, worker);
-                }
-
-                // pull from the pending jobs and clean some finished and killed jobs
-                if (tb_list_entry_size(&impl->jobs_pending))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: try pulling from pending: %lu", worker->id, tb_list_entry_size(&impl->jobs_pending));
-
-                    // no jobs? try to pull from the pending jobs
-                    if (!tb_vector_size(worker->jobs))
-                        tb_remove_if(tb_list_entry_itor(&impl->jobs_pending), tb_thread_pool_worker_walk_pull_and_clean, worker);
-                    // clean some finished and killed jobs
-                    else tb_remove_if(tb_list_entry_itor(&impl->jobs_pending), tb_thread_pool_worker_walk_clean, worker);
-                }
-
-                // leave
-                tb_spinlock_leave(&impl->lock);
-
-                // idle? wait it
-                if (!tb_vector_size(worker->jobs))
-                {
-                    // killed?
-                    tb_check_break(!tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_RELAXED));
-
-                    // trace
-                    tb_trace_d("worker[%lu]: wait: ..", worker->id);
-
-                    // wait some time
-                    tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
-                    tb_assert_and_check_break(wait > 0);
-
-                    // trace
-                    tb_trace_d("worker[%lu]: wait: ok", worker->id);
-
-                    // continue it
-                    continue;
-                }
-                else
-                {
-#ifdef TB_TRACE_DEBUG
-                    // update the jobs urgent size
-                    tb_size_t jobs_urgent_size = tb_list_entry_size(&impl->jobs_urgent);
-
-                    // update the jobs waiting size
-                    tb_size_t jobs_waiting_size = tb_list_entry_size(&impl->jobs_waiting);
-
-                    // update the jobs pending size
-                    tb_size_t jobs_pending_size = tb_list_entry_size(&impl->jobs_pending);
-
-                    // trace
-                    tb_trace_d("worker[%lu]: pull: jobs: %lu, time: %lu ms, waiting: %lu, pending: %lu, urgent: %lu", worker->id, tb_vector_size(worker->jobs), worker->pull, jobs_waiting_size, jobs_pending_size, jobs_urgent_size);
-#endif
-                }
+                tb_thread_pool_jobs_done(worker, job);
+                continue;
             }
 
-            // done jobs
-            tb_for_all (tb_thread_pool_job_t*, job, worker->jobs)
-            {
-                // check
-                tb_assert_and_check_continue(job && job->task.done);
-
-                // the job is waiting? work it
-                tb_int32_t state = TB_STATE_WAITING;
-                if (tb_atomic32_compare_and_swap(&job->state, &state, TB_STATE_WORKING))
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
-
-                    // init the time
-                    tb_hong_t time = tb_cache_time_spak();
-
-                    // done the job
-                    job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
-
-                    // computate the time
-                    time = tb_cache_time_spak() - time;
-
-                    // exists? update time and count
-                    tb_size_t               itor;
-                    tb_hash_map_item_ref_t  item = tb_null;
-                    if (    ((itor = tb_hash_map_find(worker->stats, job->task.done)) != tb_iterator_tail(worker->stats))
-                        &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(worker->stats, itor)))
-                    {
-                        // the stats
-                        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)item->data;
-                        tb_assert_and_check_break(stats);
-
-                        // update the done count
-                        stats->done_count++;
-
-                        // update the total time
-                        stats->total_time += time;
-                    }
-
-                    // no item? add it
-                    if (!item)
-                    {
-                        // init stats
-                        tb_thread_pool_job_stats_t stats = {0};
-                        stats.done_count = 1;
-                        stats.total_time = time;
-
-                        // add stats
-                        tb_hash_map_insert(worker->stats, job->task.done, &stats);
-                    }
-
-#ifdef TB_TRACE_DEBUG
-                    tb_size_t done_count = 0;
-                    tb_hize_t total_time = 0;
-                    tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-                    if (stats)
-                    {
-                        done_count = stats->done_count;
-                        total_time = stats->total_time;
-                    }
-
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: time: %lld ms, average: %lld ms, count: %lu", worker->id, job->task.done, job->task.name, time, (total_time / (tb_hize_t)done_count), done_count);
-#endif
+            // killed?
+            tb_check_break(!tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_RELAXED));
 
-                    // update the job state
-                    tb_atomic32_set(&job->state, TB_STATE_FINISHED);
-                }
-                // the job is killing? work it
-                else if (state == TB_STATE_KILLING)
-                {
-                    // update the job state
-                    tb_atomic32_set(&job->state, TB_STATE_KILLED);
-                }
+            // be idle now, we need check jobs again to avoid missing the wakeup
+            tb_atomic32_fetch_and_add(&impl->idle_count, 1);
+            if (tb_thread_pool_worker_has_jobs(worker))
+            {
+                tb_atomic32_fetch_and_sub(&impl->idle_count, 1);
+                continue;
             }
 
-            // clear jobs
-            tb_vector_clear(worker->jobs);
+            // trace
+            tb_trace_d("worker[%lu]: wait: ..", worker->id);
+
+            // wait some time
+            tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+            tb_atomic32_fetch_and_sub(&impl->idle_count, 1);
+            tb_assert_and_check_break(wait > 0);
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ok", worker->id);
         }
 
+#ifdef __tb_thread_local__
+        // clear the current worker
+        g_worker_self = tb_null;
+#endif
+
     } while (0);
 
     // exit worker
@@ -601,14 +800,6 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
             priv->exit = tb_null;
             priv->priv = tb_null;
         }
-
-        // exit stats
-        if (worker->stats) tb_hash_map_exit(worker->stats);
-        worker->stats = tb_null;
-
-        // exit jobs
-        if (worker->jobs) tb_vector_exit(worker->jobs);
-        worker->jobs = tb_null;
     }
 
     // exit
@@ -616,131 +807,59 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * jobs implementation
+ * post implementation
  */
-static tb_bool_t tb_thread_pool_jobs_walk_kill_all(tb_pointer_t item, tb_cpointer_t priv)
-{
-    // check
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert_and_check_return_val(job, tb_false);
-
-    // trace
-    tb_trace_d("task[%p:%s]: kill: ..", job->task.done, job->task.name);
-
-    // kill it if be waiting
-    tb_atomic32_fetch_and_cmpset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
-
-    // ok
-    return tb_true;
-}
-#ifdef __tb_debug__
-static tb_bool_t tb_thread_pool_jobs_walk_dump_all(tb_pointer_t item, tb_cpointer_t priv)
+static tb_size_t tb_thread_pool_post_jobs(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t** jobs, tb_size_t size)
 {
     // check
-    tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)item;
-    tb_assert_and_check_return_val(job, tb_false);
-
-    // the state string
-    static tb_char_t const* s_state_cstr[] =
-    {
-        "waiting"
-    ,   "working"
-    ,   "killed"
-    ,   "finished"
-    };
-    tb_assert_and_check_return_val(job->state < tb_arrayn(s_state_cstr), tb_false);
-
-    // trace
-    tb_trace_d("    task[%p:%s]: refn: %lu, state: %s", job->task.done, job->task.name, job->refn, s_state_cstr[job->state]);
+    tb_assert_and_check_return_val(impl && jobs, 0);
 
-    // ok
-    return tb_true;
-}
-#endif
-static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t* post_size)
-{
-    // check
-    tb_assert_and_check_return_val(impl && task && task->done && post_size, tb_null);
-
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_thread_pool_job_t*   job = tb_null;
-    do
+    // post the non-urgent jobs to the deque of the current worker if we are in the worker of this pool
+    tb_size_t i = 0;
+    tb_size_t post = 0;
+#ifdef __tb_thread_local__
+    tb_thread_pool_worker_t* worker = g_worker_self;
+    if (worker && worker->pool == (tb_thread_pool_ref_t)impl)
     {
-        // check
-        tb_assert_and_check_break(tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN);
-
-        // make job
-        job = (tb_thread_pool_job_t*)tb_fixed_pool_malloc0(impl->jobs_pool);
-        tb_assert_and_check_break(job);
-
-        // init job
-        tb_atomic32_init(&job->refn, 1);
-        tb_atomic32_init(&job->state, TB_STATE_WAITING);
-        job->task   = *task;
-
-        // non-urgent job?
-        if (!task->urgent)
-        {
-            // post to the waiting jobs
-            tb_list_entry_insert_tail(&impl->jobs_waiting, &job->entry);
-        }
-        else
+        for (i = 0; i < size; i++)
         {
-            // post to the urgent jobs
-            tb_list_entry_insert_tail(&impl->jobs_urgent, &job->entry);
+            if (!jobs[i]->task.urgent && tb_thread_pool_deque_push(&worker->jobs, jobs[i]))
+            {
+                jobs[i] = tb_null;
+                post++;
+            }
         }
+    }
+#endif
 
-        // the waiting jobs count
-        tb_size_t jobs_waiting_count = tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent);
-        tb_assert_and_check_break(jobs_waiting_count);
-
-        // update the post size
-        if (*post_size < impl->worker_size) (*post_size)++;
-
-        // trace
-        tb_trace_d("task[%p:%s]: post: %lu: ..", task->done, task->name, *post_size);
+    // post the left jobs to the injector
+    if (post < size)
+    {
+        // enter
+        tb_spinlock_enter(&impl->lock);
 
-        // init them if the workers have been not inited
-        if (impl->worker_size < jobs_waiting_count)
+        // post them
+        for (i = 0; i < size; i++)
         {
-            tb_size_t i = impl->worker_size;
-            tb_size_t n = tb_min(jobs_waiting_count, impl->worker_maxn);
-            for (; i < n; i++)
+            tb_thread_pool_job_t* job = jobs[i];
+            if (job)
             {
-                // the worker
-                tb_thread_pool_worker_t* worker = &impl->worker_list[i];
-
-                // clear worker
-                tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
-
-                // init worker
-                tb_atomic_flag_clear_explicit(&worker->bstoped, TB_ATOMIC_RELAXED);
-                worker->id          = i;
-                worker->pool        = (tb_thread_pool_ref_t)impl;
-                worker->loop        = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
-                tb_assert_and_check_continue(worker->loop);
+                tb_list_entry_insert_tail(job->task.urgent? &impl->jobs_urgent : &impl->jobs_waiting, &job->entry);
+                tb_atomic32_fetch_and_add(&impl->jobs_injected, 1);
+                if (job->task.urgent) tb_atomic32_fetch_and_add(&impl->jobs_injected_urgent, 1);
+                post++;
             }
-
-            // update the worker size
-            impl->worker_size = i;
         }
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
-
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        tb_fixed_pool_free(impl->jobs_pool, job);
-        job = tb_null;
+        // leave
+        tb_spinlock_leave(&impl->lock);
     }
 
-    // ok?
-    return job;
+    // init more workers if necessary
+    tb_thread_pool_worker_spawn(impl, (tb_size_t)tb_atomic32_get(&impl->jobs_count));
+
+    // wake up the idle workers
+    tb_thread_pool_worker_wake(impl);
+    return post;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -772,12 +891,16 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         impl->stack         = stack;
 
         // init workers
-        impl->worker_size   = 0;
-        impl->worker_maxn   = worker_maxn;
+        impl->worker_maxn   = tb_min(worker_maxn, TB_THREAD_POOL_WORKER_MAXN);
+        tb_atomic32_init(&impl->worker_size, 0);
+        tb_atomic32_init(&impl->idle_count, 0);
+        tb_atomic32_init(&impl->bstoped, 0);
 
-        // init jobs pool
-        impl->jobs_pool     = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
-        tb_assert_and_check_break(impl->jobs_pool);
+        // init jobs
+        tb_atomic32_init(&impl->jobs_count, 0);
+        tb_atomic32_init(&impl->jobs_killgen, 0);
+        tb_atomic32_init(&impl->jobs_injected, 0);
+        tb_atomic32_init(&impl->jobs_injected_urgent, 0);
 
         // init jobs urgent
         tb_list_entry_init(&impl->jobs_urgent, tb_thread_pool_job_t, entry, tb_null);
@@ -785,9 +908,6 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         // init jobs waiting
         tb_list_entry_init(&impl->jobs_waiting, tb_thread_pool_job_t, entry, tb_null);
 
-        // init jobs pending
-        tb_list_entry_init(&impl->jobs_pending, tb_thread_pool_job_t, entry, tb_null);
-
         // init semaphore
         impl->semaphore = tb_semaphore_init(0);
         tb_assert_and_check_break(impl->semaphore);
@@ -834,10 +954,10 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
     }
 
     /* exit all workers
-     * need not lock it because the worker size will not be increase d
+     * need not lock it because the worker size will not be increased
      */
     tb_size_t i = 0;
-    tb_size_t n = impl->worker_size;
+    tb_size_t n = (tb_size_t)tb_atomic32_get(&impl->worker_size);
     for (i = 0; i < n; i++)
     {
         // the worker
@@ -859,24 +979,20 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
             worker->loop = tb_null;
         }
     }
-    impl->worker_size = 0;
+
+    // exit the worker deques after all workers have been exited, because they may be stealing
+    for (i = 0; i < n; i++) tb_thread_pool_deque_exit(&impl->worker_list[i].jobs);
+    tb_atomic32_set(&impl->worker_size, 0);
 
     // enter
     tb_spinlock_enter(&impl->lock);
 
-    // exit pending jobs
-    tb_list_entry_exit(&impl->jobs_pending);
-
     // exit waiting jobs
     tb_list_entry_exit(&impl->jobs_waiting);
 
     // exit urgent jobs
     tb_list_entry_exit(&impl->jobs_urgent);
 
-    // exit jobs pool
-    if (impl->jobs_pool) tb_fixed_pool_exit(impl->jobs_pool);
-    impl->jobs_pool = tb_null;
-
     // leave
     tb_spinlock_leave(&impl->lock);
 
@@ -907,24 +1023,24 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
 
     // kill it
     tb_size_t post = 0;
-    if (!impl->bstoped)
+    if (!tb_atomic32_get(&impl->bstoped))
     {
         // trace
         tb_trace_d("kill: ..");
 
         // stoped
-        impl->bstoped = tb_true;
+        tb_atomic32_set(&impl->bstoped, 1);
 
         // kill all workers
         tb_size_t i = 0;
-        tb_size_t n = impl->worker_size;
+        tb_size_t n = (tb_size_t)tb_atomic32_get(&impl->worker_size);
         for (i = 0; i < n; i++) tb_atomic_flag_test_and_set_explicit(&impl->worker_list[i].bstoped, TB_ATOMIC_RELAXED);
 
         // kill all jobs
-        if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        tb_atomic32_fetch_and_add(&impl->jobs_killgen, 1);
 
         // post it
-        post = impl->worker_size;
+        post = n;
     }
 
     // leave
@@ -939,17 +1055,8 @@ tb_size_t tb_thread_pool_worker_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
     // the worker size
-    tb_size_t worker_size = impl->worker_size;
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // ok?
-    return worker_size;
+    return (tb_size_t)tb_atomic32_get(&impl->worker_size);
 }
 tb_void_t tb_thread_pool_worker_setp(tb_thread_pool_worker_ref_t worker, tb_size_t index, tb_thread_pool_priv_exit_func_t exit, tb_cpointer_t priv)
 {
@@ -976,17 +1083,8 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
     // the task size
-    tb_size_t task_size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // ok?
-    return task_size;
+    return (tb_size_t)tb_atomic32_get(&impl->jobs_count);
 }
 tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* name, tb_thread_pool_task_done_func_t done, tb_thread_pool_task_exit_func_t exit, tb_cpointer_t priv, tb_bool_t urgent)
 {
@@ -994,44 +1092,23 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
-    // init the post size
-    tb_size_t post_size = 0;
-
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // stoped?
-        tb_check_break(!impl->bstoped);
-
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
-
-        // post task
-        tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
-        tb_assert_and_check_break(job);
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
+    // stoped?
+    tb_check_return_val(!tb_atomic32_get(&impl->bstoped), tb_false);
 
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
 
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
+    // init job
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_init(impl, &task, 1);
+    tb_check_return_val(job, tb_false);
 
-    // ok?
-    return ok;
+    // post it
+    return tb_thread_pool_post_jobs(impl, &job, 1) == 1;
 }
 tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_pool_task_t const* list, tb_size_t size)
 {
@@ -1039,29 +1116,24 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
-    // init the post size
-    tb_size_t post_size = 0;
-
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // done
-    tb_size_t ok = 0;
-    if (!impl->bstoped)
+    // post them with the batch size
+    tb_size_t               ok = 0;
+    tb_thread_pool_job_t*   jobs[TB_THREAD_POOL_JOBS_PULL_MAXN];
+    while (ok < size && !tb_atomic32_get(&impl->bstoped))
     {
-        for (ok = 0; ok < size; ok++)
+        // init jobs
+        tb_size_t i = 0;
+        tb_size_t n = tb_min(size - ok, tb_arrayn(jobs));
+        for (i = 0; i < n; i++)
         {
-            // post task
-            tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &list[ok], &post_size);
-            tb_assert_and_check_break(job);
+            jobs[i] = tb_thread_pool_jobs_init(impl, &list[ok + i], 1);
+            tb_assert_and_check_break(jobs[i]);
         }
-    }
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
 
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
+        // post them
+        if (i) ok += tb_thread_pool_post_jobs(impl, jobs, i);
+        tb_check_break(i == n);
+    }
 
     // ok?
     return ok;
@@ -1072,49 +1144,26 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
-    // init the post size
-    tb_size_t post_size = 0;
+    // stoped?
+    tb_check_return_val(!tb_atomic32_get(&impl->bstoped), tb_null);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
 
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_thread_pool_job_t*   job = tb_null;
-    do
-    {
-        // stoped?
-        tb_check_break(!impl->bstoped);
-
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
-
-        // post task
-        job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
-        tb_assert_and_check_break(job);
-
-        // refn++
-        job->refn++;
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
+    // init job, it will be referred by the task handle and the worker
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_init(impl, &task, 2);
+    tb_check_return_val(job, tb_null);
 
-    // leave
-    tb_spinlock_leave(&impl->lock);
-
-    // post the workers
-    if (ok && post_size) tb_thread_pool_worker_post(impl, post_size);
-    // failed?
-    else if (!ok) job = tb_null;
+    // post it
+    tb_thread_pool_job_t* post = job;
+    tb_thread_pool_post_jobs(impl, &post, 1);
 
-    // ok?
+    // ok
     return (tb_thread_pool_task_ref_t)job;
 }
 tb_void_t tb_thread_pool_task_kill(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task)
@@ -1135,15 +1184,12 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return(impl);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // kill all jobs
-    if (!impl->bstoped && impl->jobs_pool)
-        tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    /* kill all jobs
+     *
+     * all waiting jobs posted before it will be killed when the workers get them
+     */
+    if (!tb_atomic32_get(&impl->bstoped))
+        tb_atomic32_fetch_and_add(&impl->jobs_killgen, 1);
 }
 tb_long_t tb_thread_pool_task_wait(tb_thread_pool_ref_t pool, tb_thread_pool_task_ref_t task, tb_long_t timeout)
 {
@@ -1179,28 +1225,11 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
     tb_hong_t time = tb_cache_time_spak();
     while ((timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
-        // enter
-        tb_spinlock_enter(&impl->lock);
-
         // the jobs count
-        size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
+        size = (tb_size_t)tb_atomic32_get(&impl->jobs_count);
 
         // trace
-        tb_trace_d("wait: jobs: %lu, waiting: %lu, pending: %lu, urgent: %lu: .."
-                    , size
-                    , tb_list_entry_size(&impl->jobs_waiting)
-                    , tb_list_entry_size(&impl->jobs_pending)
-                    , tb_list_entry_size(&impl->jobs_urgent));
-
-#if 0
-        tb_for_all_if (tb_thread_pool_job_t*, job, tb_list_entry_itor(&impl->jobs_pending), job)
-        {
-            tb_trace_d("wait: job: %s from pending", tb_state_cstr(tb_atomic32_get(&job->state)));
-        }
-#endif
-
-        // leave
-        tb_spinlock_leave(&impl->lock);
+        tb_trace_d("wait: jobs: %lu, injected: %ld: ..", size, (tb_long_t)tb_atomic32_get(&impl->jobs_injected));
 
         // ok?
         tb_check_break(size);
@@ -1222,16 +1251,8 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
-    // enter
-    tb_spinlock_enter(&impl->lock);
-
-    // refn--
-    if (job->refn > 1) job->refn--;
-    // remove it from pool directly
-    else tb_fixed_pool_free(impl->jobs_pool, job);
-
-    // leave
-    tb_spinlock_leave(&impl->lock);
+    // exit it
+    tb_thread_pool_jobs_exit(impl, job);
 }
 #ifdef __tb_debug__
 tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
@@ -1244,36 +1265,30 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
     tb_spinlock_enter(&impl->lock);
 
     // dump workers
-    if (impl->worker_size)
+    tb_size_t worker_size = (tb_size_t)tb_atomic32_get(&impl->worker_size);
+    if (worker_size)
     {
         // trace
         tb_trace_i("");
-        tb_trace_i("workers: size: %lu, maxn: %lu", impl->worker_size, impl->worker_maxn);
+        tb_trace_i("workers: size: %lu, maxn: %lu, idle: %ld", worker_size, impl->worker_maxn, (tb_long_t)tb_atomic32_get(&impl->idle_count));
 
         // walk
         tb_size_t i = 0;
-        for (i = 0; i < impl->worker_size; i++)
+        for (i = 0; i < worker_size; i++)
         {
             // the worker
             tb_thread_pool_worker_t* worker = &impl->worker_list[i];
             tb_assert_and_check_break(worker);
 
             // dump worker
-            tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_RELAXED));
+            tb_trace_i("    worker: id: %lu, stoped: %ld, jobs: %lu", worker->id, (tb_long_t)tb_atomic_flag_test_explicit(&worker->bstoped, TB_ATOMIC_RELAXED), tb_thread_pool_deque_size(&worker->jobs));
         }
 
         // trace
         tb_trace_i("");
 
         // dump all jobs
-        if (impl->jobs_pool)
-        {
-            // trace
-            tb_trace_i("jobs: size: %lu", tb_fixed_pool_size(impl->jobs_pool));
-
-            // dump jobs
-            tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_dump_all, tb_null);
-        }
+        tb_trace_i("jobs: size: %ld, urgent: %lu, waiting: %lu", (tb_long_t)tb_atomic32_get(&impl->jobs_count), tb_list_entry_size(&impl->jobs_urgent), tb_list_entry_size(&impl->jobs_waiting));
     }
 
     // leave
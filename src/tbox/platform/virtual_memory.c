@@ -45,5 +45,17 @@ tb_bool_t tb_virtual_memory_free(tb_pointer_t data)
 {
     return tb_native_memory_free(data);
 }
+tb_pointer_t tb_virtual_memory_guard_malloc(tb_size_t size)
+{
+    return tb_native_memory_malloc(size);
+}
+tb_bool_t tb_virtual_memory_guard_free(tb_pointer_t data, tb_size_t size)
+{
+    return tb_native_memory_free(data);
+}
+tb_bool_t tb_virtual_memory_purge(tb_pointer_t data, tb_size_t size)
+{
+    return tb_false;
+}
 #endif
 
@@ -68,6 +68,43 @@ tb_pointer_t            tb_virtual_memory_ralloc(tb_pointer_t data, tb_size_t si
  */
 tb_bool_t               tb_virtual_memory_free(tb_pointer_t data);
 
+/*! malloc the guarded virtual memory, e.g. the coroutine stack
+ *
+ * the pages are committed lazily by the system when they are touched first,
+ * and there is an inaccessible guard page below the data, so we will get a hard fault if it's underflowed.
+ *
+ * <pre>
+ * | guard page | ......... size ......... |
+ *              |
+ *             data
+ * </pre>
+ *
+ * @param size          the size, it will be aligned by the page size
+ *
+ * @return              the data address
+ */
+tb_pointer_t            tb_virtual_memory_guard_malloc(tb_size_t size);
+
+/*! free the guarded virtual memory
+ *
+ * @param data          the data address
+ * @param size          the size passed to tb_virtual_memory_guard_malloc()
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_virtual_memory_guard_free(tb_pointer_t data, tb_size_t size);
+
+/*! purge the pages of the virtual memory and return them to the system
+ *
+ * the address range is still valid, but the data will be undefined and the pages will be committed again after touching them.
+ *
+ * @param data          the data address, it must be aligned by the page size
+ * @param size          the size, only the whole pages will be purged
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_virtual_memory_purge(tb_pointer_t data, tb_size_t size);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,159 @@
+/*!The Treasure Box Library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009-present, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        filemap.c
+ * @ingroup     platform
+ *
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../filemap.h"
+#include "../../memory/memory.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the file map type
+typedef struct __tb_filemap_t
+{
+    // the mapping handle
+    HANDLE              mapping;
+
+    // the data
+    tb_byte_t*          data;
+
+    // the size
+    tb_size_t           size;
+
+}tb_filemap_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_filemap_ref_t tb_filemap_init_from_file(tb_file_ref_t file, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(file, tb_null);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_filemap_t*   filemap = tb_null;
+    do
+    {
+        // get the file size, we cannot map the empty file
+        tb_hize_t size = tb_file_size(file);
+        tb_check_break(size);
+
+        // too large to be mapped?
+        tb_check_break((tb_hize_t)(tb_size_t)size == size);
+
+        // make filemap
+        filemap = tb_malloc0_type(tb_filemap_t);
+        tb_assert_and_check_break(filemap);
+
+        // create the file mapping, it holds a reference to the file handle
+        tb_bool_t rw = (mode & TB_FILE_MODE_RW)? tb_true : tb_false;
+        filemap->mapping = CreateFileMappingW((HANDLE)file, tb_null, rw? PAGE_READWRITE : PAGE_READONLY, 0, 0, tb_null);
+        tb_check_break(filemap->mapping);
+
+        // map it
+        filemap->data = (tb_byte_t*)MapViewOfFile(filemap->mapping, rw? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, (SIZE_T)size);
+        tb_check_break(filemap->data);
+
+        // save size
+        filemap->size = (tb_size_t)size;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (filemap) tb_filemap_exit((tb_filemap_ref_t)filemap);
+        filemap = tb_null;
+    }
+
+    // ok?
+    return (tb_filemap_ref_t)filemap;
+}
+tb_void_t tb_filemap_exit(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return(filemap);
+
+    // unmap it
+    if (filemap->data) UnmapViewOfFile(filemap->data);
+    filemap->data = tb_null;
+
+    // close the mapping
+    if (filemap->mapping) CloseHandle(filemap->mapping);
+    filemap->mapping = tb_null;
+
+    // exit it
+    tb_free(filemap);
+}
+tb_byte_t* tb_filemap_data(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap, tb_null);
+
+    // the data
+    return filemap->data;
+}
+tb_size_t tb_filemap_size(tb_filemap_ref_t self)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap, 0);
+
+    // the size
+    return filemap->size;
+}
+tb_bool_t tb_filemap_advise(tb_filemap_ref_t self, tb_size_t advice, tb_size_t offset, tb_size_t size)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap && filemap->data && offset <= filemap->size, tb_false);
+    tb_assert_and_check_return_val(advice <= TB_FILEMAP_ADVICE_DONTNEED, tb_false);
+
+    // the advice is only a hint and the cache manager already reads ahead for the mapped views
+    tb_used(size);
+    return tb_true;
+}
+tb_bool_t tb_filemap_sync(tb_filemap_ref_t self, tb_size_t offset, tb_size_t size)
+{
+    // check
+    tb_filemap_t* filemap = (tb_filemap_t*)self;
+    tb_assert_and_check_return_val(filemap && filemap->data && offset <= filemap->size, tb_false);
+
+    // the whole left data?
+    if (!size || size > filemap->size - offset) size = filemap->size - offset;
+    tb_check_return_val(size, tb_false);
+
+    // flush the view, it will be rounded to the pages
+    return FlushViewOfFile(filemap->data + offset, size)? tb_true : tb_false;
+}
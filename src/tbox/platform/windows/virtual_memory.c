@@ -24,6 +24,7 @@
  */
 #include "prefix.h"
 #include "../virtual_memory.h"
+#include "../page.h"
 #include "../../memory/impl/prefix.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -79,4 +80,44 @@ tb_bool_t tb_virtual_memory_free(tb_pointer_t data)
     }
     return tb_true;
 }
+tb_pointer_t tb_virtual_memory_guard_malloc(tb_size_t size)
+{
+    // check
+    tb_check_return_val(size, tb_null);
+
+    // align size
+    tb_size_t pagesize = tb_page_size();
+    size = tb_align(size, pagesize);
+
+    // reserve the guard page and data
+    tb_byte_t* base = (tb_byte_t*)VirtualAlloc(tb_null, pagesize + size, MEM_RESERVE, PAGE_NOACCESS);
+    tb_check_return_val(base, tb_null);
 
+    // commit the data, the physical pages will be allocated when they are touched first
+    if (!VirtualAlloc(base + pagesize, size, MEM_COMMIT, PAGE_READWRITE))
+    {
+        VirtualFree(base, 0, MEM_RELEASE);
+        return tb_null;
+    }
+    return base + pagesize;
+}
+tb_bool_t tb_virtual_memory_guard_free(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(data, tb_true);
+
+    // release the guard page and data
+    return VirtualFree((tb_byte_t*)data - tb_page_size(), 0, MEM_RELEASE);
+}
+tb_bool_t tb_virtual_memory_purge(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && !((tb_size_t)data & (tb_page_size() - 1)), tb_false);
+
+    // only purge the whole pages
+    size &= ~(tb_page_size() - 1);
+    tb_check_return_val(size, tb_true);
+
+    // reset these pages, the system can discard them without writing to the page file
+    return VirtualAlloc(data, size, MEM_RESET, PAGE_READWRITE) != tb_null;
+}
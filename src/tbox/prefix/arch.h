@@ -277,6 +277,9 @@
 #       undef TB_ARCH_STRING_2
 #       define TB_ARCH_STRING_2             "_sse3"
 #   endif
+#   if defined(__AVX2__)
+#       define TB_ARCH_AVX2
+#   endif
 #endif
 
 // vfp
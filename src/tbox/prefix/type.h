@@ -193,6 +193,12 @@ typedef tb_atomic_flag_t            tb_spinlock_t;
 /// the spinlock ref type
 typedef tb_spinlock_t*              tb_spinlock_ref_t;
 
+/// the read-write spinlock type
+typedef tb_atomic32_t               tb_rwspinlock_t;
+
+/// the read-write spinlock ref type
+typedef tb_rwspinlock_t*            tb_rwspinlock_ref_t;
+
 /// the pool ref type
 typedef __tb_typeref__(pool);
 
@@ -76,8 +76,17 @@ typedef struct __tb_stream_t
     // the offset
     tb_hize_t           offset;
 
-    // the cache
-    tb_queue_buffer_t   cache;
+    // the cache, the read data will be pushed to the tail blocks and be pulled from the head slices without moving it
+    tb_iobuf_t          cache;
+
+    // the cache maxn, no cache if be zero
+    tb_size_t           cache_maxn;
+
+    // the mapped data, we read it directly and bypass the cache if exists
+    tb_byte_t*          mdata;
+
+    // the mapped size
+    tb_size_t           msize;
 
     // wait
     tb_long_t           (*wait)(tb_stream_ref_t stream, tb_size_t wait, tb_long_t timeout);
@@ -23,6 +23,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../stream.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -53,6 +54,12 @@ typedef struct __tb_stream_file_t
     // is stream file?
     tb_bool_t           bstream;
 
+    // attempt to map the file?
+    tb_bool_t           bmmap;
+
+    // the file map
+    tb_filemap_ref_t    filemap;
+
 }tb_stream_file_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +100,22 @@ static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
     // init offset
     stream_file->offset = 0;
 
+    // map the readonly file? we will read the file as usual if it cannot be mapped
+    if (stream_file->bmmap && !stream_file->bstream && !(stream_file->mode & (TB_FILE_MODE_WO | TB_FILE_MODE_RW)))
+    {
+        stream_file->filemap = tb_filemap_init_from_file(stream_file->file, TB_FILE_MODE_RO);
+        if (stream_file->filemap)
+        {
+            // we will read it sequentially in most cases
+            tb_filemap_advise(stream_file->filemap, TB_FILEMAP_ADVICE_SEQUENTIAL, 0, 0);
+
+            // read data from the mapping directly
+            tb_stream_t* stream_impl = tb_stream_cast(stream);
+            stream_impl->mdata = tb_filemap_data(stream_file->filemap);
+            stream_impl->msize = tb_filemap_size(stream_file->filemap);
+        }
+    }
+
     // ok
     return tb_true;
 }
@@ -102,6 +125,10 @@ static tb_bool_t tb_stream_file_clos(tb_stream_ref_t stream)
     tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
     tb_assert_and_check_return_val(stream_file, tb_false);
 
+    // exit the file map
+    if (stream_file->filemap) tb_filemap_exit(stream_file->filemap);
+    stream_file->filemap = tb_null;
+
     // exit file
     if (stream_file->file && !tb_file_exit(stream_file->file)) return tb_false;
     stream_file->file = tb_null;
@@ -189,6 +216,12 @@ static tb_long_t tb_stream_file_wait(tb_stream_ref_t stream, tb_size_t wait, tb_
     {
         if (stream_file->bstream)
             events |= TB_STREAM_WAIT_READ;
+        else if (stream_file->filemap)
+        {
+            if (tb_stream_offset(stream) < tb_filemap_size(stream_file->filemap))
+                events |= TB_STREAM_WAIT_READ;
+            else events = -1;
+        }
         else
         {
             if (stream_file->offset < tb_file_size(stream_file->file))
@@ -257,6 +290,11 @@ static tb_bool_t tb_stream_file_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             stream_file->bstream = (tb_bool_t)tb_va_arg(args, tb_bool_t);
             return tb_true;
         }
+    case TB_STREAM_CTRL_FILE_MMAP:
+        {
+            stream_file->bmmap = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+            return tb_true;
+        }
     case TB_STREAM_CTRL_FILE_GET_FILE:
         {
             // the pfile
@@ -301,6 +339,7 @@ tb_stream_ref_t tb_stream_init_file()
         // init it
         stream_file->mode      = TB_FILE_MODE_RO;
         stream_file->bstream   = tb_false;
+        stream_file->bmmap     = tb_false;
         stream_file->read      = 0;
     }
 
@@ -560,6 +560,25 @@ static tb_bool_t tb_stream_http_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_GET_COOKIES, pcookies);
         }
         break;
+    case TB_STREAM_CTRL_HTTP_SET_POOL:
+        {
+            // pool
+            tb_http_pool_ref_t pool = (tb_http_pool_ref_t)tb_va_arg(args, tb_http_pool_ref_t);
+
+            // set pool
+            return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_SET_POOL, pool);
+        }
+        break;
+    case TB_STREAM_CTRL_HTTP_GET_POOL:
+        {
+            // ppool
+            tb_http_pool_ref_t* ppool = (tb_http_pool_ref_t*)tb_va_arg(args, tb_http_pool_ref_t*);
+            tb_assert_and_check_return_val(ppool, tb_false);
+
+            // get pool
+            return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_GET_POOL, ppool);
+        }
+        break;
     default:
         break;
     }
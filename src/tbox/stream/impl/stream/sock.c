@@ -29,6 +29,10 @@
  * includes
  */
 #include "prefix.h"
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+#   include "../../../coroutine/coroutine.h"
+#   include "../../../coroutine/impl/impl.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -57,7 +61,7 @@ typedef struct __tb_stream_sock_t
 #endif
 
     // the sock type
-    tb_uint32_t             type : 22;
+    tb_uint32_t             type : 21;
 
     // the try number
     tb_uint32_t             tryn : 8;
@@ -68,6 +72,9 @@ typedef struct __tb_stream_sock_t
     // is owner of socket
     tb_uint32_t             owner : 1;
 
+    // the socket has been attached and connected?
+    tb_uint32_t             attached : 1;
+
     // the wait event
     tb_long_t               wait;
 
@@ -119,6 +126,25 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
     }
 #endif
 
+    // reuse the attached or kept-alive socket? it has been connected
+    if (    stream_sock->sock
+        &&  stream_sock->type == TB_SOCKET_TYPE_TCP
+        &&  (stream_sock->attached || stream_sock->keep_alive))
+    {
+        // trace
+        tb_trace_d("sock(%p): reuse: %s", stream_sock->sock, tb_url_host(url));
+
+#ifdef TB_SSL_ENABLE
+        // update the ssl timeout
+        if (stream_sock->hssl) tb_ssl_set_timeout(stream_sock->hssl, tb_stream_timeout(stream));
+#endif
+
+        // ok
+        stream_sock->attached = 0;
+        tb_stream_state_set(stream, TB_STATE_OK);
+        return tb_true;
+    }
+
     // get address from the url
     tb_ipaddr_ref_t addr = tb_url_addr(url);
     tb_assert_and_check_return_val(addr, tb_false);
@@ -396,15 +422,15 @@ static tb_bool_t tb_stream_sock_clos(tb_stream_ref_t stream)
     tb_stream_sock_t* stream_sock = tb_stream_sock_cast(stream);
     tb_assert_and_check_return_val(stream_sock, tb_false);
 
+    // keep alive? not close it and keep the ssl session
+    tb_check_return_val(!stream_sock->keep_alive, tb_true);
+
 #ifdef TB_SSL_ENABLE
     // close ssl
     if (tb_url_ssl(tb_stream_url(stream)) && stream_sock->hssl)
         tb_ssl_close(stream_sock->hssl);
 #endif
 
-    // keep alive? not close it
-    tb_check_return_val(!stream_sock->keep_alive, tb_true);
-
     // exit socket
     if (stream_sock->owner)
     {
@@ -714,6 +740,82 @@ static tb_bool_t tb_stream_sock_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             *psock = stream_sock->sock;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_ATTACH:
+        {
+            // check
+            tb_assert_and_check_return_val(tb_stream_is_closed(stream), tb_false);
+            tb_assert_and_check_return_val(stream_sock->owner && stream_sock->type == TB_SOCKET_TYPE_TCP, tb_false);
+
+            // the connected socket
+            tb_socket_ref_t sock = (tb_socket_ref_t)tb_va_arg(args, tb_socket_ref_t);
+            tb_assert_and_check_return_val(sock, tb_false);
+
+            // the opened ssl, it must be null if not ssl
+            tb_ssl_ref_t ssl = (tb_ssl_ref_t)tb_va_arg(args, tb_ssl_ref_t);
+#ifndef TB_SSL_ENABLE
+            tb_assert_and_check_return_val(!ssl, tb_false);
+#endif
+
+#ifdef TB_SSL_ENABLE
+            // exit the previous ssl
+            if (stream_sock->hssl) tb_ssl_exit(stream_sock->hssl);
+            stream_sock->hssl = ssl;
+#endif
+
+            // exit the previous socket
+            if (stream_sock->sock) tb_socket_exit(stream_sock->sock);
+            stream_sock->sock = sock;
+
+            // it will be reused when opening stream
+            stream_sock->attached = 1;
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_SOCK_DETACH:
+        {
+            // check
+            tb_assert_and_check_return_val(tb_stream_is_closed(stream), tb_false);
+            tb_assert_and_check_return_val(stream_sock->owner && stream_sock->type == TB_SOCKET_TYPE_TCP, tb_false);
+
+            // the psock and pssl
+            tb_socket_ref_t*    psock = (tb_socket_ref_t*)tb_va_arg(args, tb_socket_ref_t*);
+            tb_ssl_ref_t*       pssl = (tb_ssl_ref_t*)tb_va_arg(args, tb_ssl_ref_t*);
+            tb_assert_and_check_return_val(psock && pssl, tb_false);
+
+            // no socket? it has been closed
+            tb_check_return_val(stream_sock->sock, tb_false);
+
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+            /* cancel it from the io scheduler of the current coroutine,
+             * because it may be reused in the other thread or scheduler
+             */
+            tb_pointer_t scheduler_io = tb_null;
+            tb_poller_object_t object;
+            object.type     = TB_POLLER_OBJECT_SOCK;
+            object.ref.sock = stream_sock->sock;
+#   ifndef TB_CONFIG_MICRO_ENABLE
+            if ((scheduler_io = tb_co_scheduler_io_self()) && tb_co_scheduler_io_cancel((tb_co_scheduler_io_ref_t)scheduler_io, &object)) {}
+            else
+#   endif
+            if ((scheduler_io = tb_lo_scheduler_io_self()) && tb_lo_scheduler_io_cancel((tb_lo_scheduler_io_ref_t)scheduler_io, &object)) {}
+#endif
+
+            // detach the socket
+            *psock = stream_sock->sock;
+            stream_sock->sock = tb_null;
+
+            // detach the ssl
+#ifdef TB_SSL_ENABLE
+            *pssl = stream_sock->hssl;
+            stream_sock->hssl = tb_null;
+#else
+            *pssl = tb_null;
+#endif
+
+            // clear it
+            stream_sock->keep_alive = 0;
+            stream_sock->attached = 0;
+            return tb_true;
+        }
     default:
         break;
     }
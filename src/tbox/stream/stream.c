@@ -85,8 +85,9 @@ tb_stream_ref_t tb_stream_init(     tb_size_t type
         // init url
         if (!tb_url_init(&stream->url)) break;
 
-        // init cache
-        if (!tb_queue_buffer_init(&stream->cache, cache)) break;
+        // init cache, we use the cache size as the block size to keep the cached data in one block mostly
+        if (!tb_iobuf_init(&stream->cache, cache)) break;
+        stream->cache_maxn = cache;
 
         // init func
         stream->open = open;
@@ -188,7 +189,7 @@ tb_void_t tb_stream_exit(tb_stream_ref_t self)
     if (stream->exit) stream->exit(self);
 
     // exit cache
-    tb_queue_buffer_exit(&stream->cache);
+    tb_iobuf_exit(&stream->cache);
 
     // exit url
     tb_url_exit(&stream->url);
@@ -215,13 +216,13 @@ tb_long_t tb_stream_wait(tb_stream_ref_t self, tb_size_t wait, tb_long_t timeout
     tb_check_return_val(!ok, ok);
 
     // cached?
-    if (tb_queue_buffer_maxn(&stream->cache))
+    if (stream->cache_maxn)
     {
         // have read cache?
-        if ((wait & TB_STREAM_WAIT_READ) && !stream->bwrited && !tb_queue_buffer_null(&stream->cache))
+        if ((wait & TB_STREAM_WAIT_READ) && !stream->bwrited && !tb_iobuf_null(&stream->cache))
             ok |= TB_STREAM_WAIT_READ;
         // have writ cache?
-        else if ((wait & TB_STREAM_WAIT_WRIT) && stream->bwrited && !tb_queue_buffer_full(&stream->cache))
+        else if ((wait & TB_STREAM_WAIT_WRIT) && stream->bwrited && tb_iobuf_size(&stream->cache) < stream->cache_maxn)
             ok |= TB_STREAM_WAIT_WRIT;
     }
 
@@ -621,6 +622,10 @@ tb_bool_t tb_stream_open(tb_stream_ref_t self)
     // init state
     stream->state = TB_STATE_OK;
 
+    // clear the mapped data, the stream will set it when opening if be mapped
+    stream->mdata = tb_null;
+    stream->msize = 0;
+
     // open it
     tb_bool_t ok = stream->open(self);
 
@@ -648,11 +653,13 @@ tb_bool_t tb_stream_clos(tb_stream_ref_t self)
     // clear state
     stream->offset = 0;
     stream->bwrited = 0;
+    stream->mdata = tb_null;
+    stream->msize = 0;
     stream->state = TB_STATE_OK;
     tb_atomic32_set(&stream->istate, TB_STATE_CLOSED);
 
     // clear cache
-    tb_queue_buffer_clear(&stream->cache);
+    tb_iobuf_clear(&stream->cache);
 
     // ok
     return tb_true;
@@ -669,42 +676,44 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // stoped?
     tb_assert_and_check_return_val(TB_STATE_OPENED == tb_atomic32_get(&stream->istate), tb_false);
 
+    // mapped? get data from the mapping directly
+    if (stream->mdata)
+    {
+        // not enough?
+        tb_check_return_val(stream->offset + size <= stream->msize, tb_false);
+
+        // save data
+        *data = stream->mdata + (tb_size_t)stream->offset;
+        return tb_true;
+    }
+
     // have writed cache? sync first
-    if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return tb_false;
+    if (stream->bwrited && !tb_iobuf_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return tb_false;
 
     // switch to the read cache mode
-    if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
+    if (stream->bwrited && tb_iobuf_null(&stream->cache)) stream->bwrited = 0;
 
     // check the cache mode, must be read cache
     tb_assert_and_check_return_val(!stream->bwrited, tb_false);
 
     // not enough? grow the cache first
-    if (tb_queue_buffer_maxn(&stream->cache) < size) tb_queue_buffer_resize(&stream->cache, size);
-
-    // check
-    tb_assert_and_check_return_val(tb_queue_buffer_maxn(&stream->cache) && size <= tb_queue_buffer_maxn(&stream->cache), tb_false);
-
-    // enough?
-    if (size <= tb_queue_buffer_size(&stream->cache))
-    {
-        // save data
-        *data = tb_queue_buffer_head(&stream->cache);
-        return tb_true;
-    }
-
-    // enter cache for push
-    tb_size_t   push = 0;
-    tb_size_t   need = size - tb_queue_buffer_size(&stream->cache);
-    tb_byte_t*  tail = tb_queue_buffer_push_init(&stream->cache, &push);
-    tb_assert_and_check_return_val(tail && push, tb_false);
-    if (push > need) push = need;
+    if (stream->cache_maxn < size) stream->cache_maxn = size;
 
     // fill cache
+    tb_size_t need = size - tb_min(size, tb_iobuf_size(&stream->cache));
     tb_size_t read = 0;
-    while (read < push && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
+    while (read < need && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
     {
+        // enter cache for push
+        tb_size_t   push = 0;
+        tb_byte_t*  tail = tb_iobuf_push_init(&stream->cache, &push);
+        tb_assert_and_check_break(tail && push);
+
         // read data
-        tb_long_t real = stream->read(self, tail + read, push - read);
+        tb_long_t real = stream->read(self, tail, tb_min(push, need - read));
+
+        // leave cache for push
+        tb_iobuf_push_exit(&stream->cache, real > 0? real : 0);
 
         // ok?
         if (real > 0)
@@ -724,11 +733,8 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
         else break;
     }
 
-    // leave cache for push
-    tb_queue_buffer_push_exit(&stream->cache, read);
-
     // not enough?
-    if (size > tb_queue_buffer_size(&stream->cache))
+    if (size > tb_iobuf_size(&stream->cache))
     {
         // killed? save state
         if (!stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
@@ -738,11 +744,11 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
         return tb_false;
     }
 
-    // save data
-    *data = tb_queue_buffer_head(&stream->cache);
+    // save data, only the data crossing the cache blocks will be copied
+    *data = tb_iobuf_coalesce(&stream->cache, size);
 
     // ok
-    return tb_true;
+    return *data? tb_true : tb_false;
 }
 tb_long_t tb_stream_peek(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
 {
@@ -756,50 +762,55 @@ tb_long_t tb_stream_peek(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // stoped?
     tb_assert_and_check_return_val(TB_STATE_OPENED == tb_atomic32_get(&stream->istate), -1);
 
+    // mapped? peek data from the mapping directly
+    if (stream->mdata)
+    {
+        // end? tb_stream_wait() will report it
+        tb_check_return_val(stream->offset < stream->msize, 0);
+
+        // save data
+        *data = stream->mdata + (tb_size_t)stream->offset;
+        return tb_min(size, stream->msize - (tb_size_t)stream->offset);
+    }
+
     // have writed cache? sync first
-    if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return -1;
+    if (stream->bwrited && !tb_iobuf_null(&stream->cache) && !tb_stream_sync(self, tb_false)) return -1;
 
     // switch to the read cache mode
-    if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
+    if (stream->bwrited && tb_iobuf_null(&stream->cache)) stream->bwrited = 0;
 
     // check the cache mode, must be read cache
     tb_assert_and_check_return_val(!stream->bwrited, -1);
 
     // not enough? grow the cache first
-    if (tb_queue_buffer_maxn(&stream->cache) < size) tb_queue_buffer_resize(&stream->cache, size);
-
-    // check
-    tb_assert_and_check_return_val(tb_queue_buffer_maxn(&stream->cache) && size <= tb_queue_buffer_maxn(&stream->cache), -1);
+    if (stream->cache_maxn < size) stream->cache_maxn = size;
 
     // attempt to peek data from cache directly?
-    tb_size_t cached_size = tb_queue_buffer_size(&stream->cache);
+    tb_size_t cached_size = tb_iobuf_size(&stream->cache);
     if (cached_size)
     {
-        *data = tb_queue_buffer_head(&stream->cache);
-        return tb_min(size, cached_size);
+        cached_size = tb_min(size, cached_size);
+        *data = tb_iobuf_coalesce(&stream->cache, cached_size);
+        return *data? cached_size : -1;
     }
 
-    // cache is null now.
-    tb_assert(tb_queue_buffer_null(&stream->cache));
-
     // enter cache for push
     tb_size_t   push = 0;
-    tb_byte_t*  tail = tb_queue_buffer_push_init(&stream->cache, &push);
+    tb_byte_t*  tail = tb_iobuf_push_init(&stream->cache, &push);
     tb_assert_and_check_return_val(tail && push, -1);
 
     // push data to cache from self
     tb_assert(stream->read);
     tb_long_t real = stream->read(self, tail, push);
+
+    // leave cache for push
+    tb_iobuf_push_exit(&stream->cache, real > 0? real : 0);
     tb_check_return_val(real >= 0, -1);
 
-    // peek data from cache
+    // peek data from cache, it's in the tail block
     if (real > 0)
     {
-        // leave cache for push
-        tb_queue_buffer_push_exit(&stream->cache, real);
-
-        // peek data from cache again
-        *data = tb_queue_buffer_head(&stream->cache);
+        *data = tail;
         return tb_min(size, real);
     }
     // need wait
@@ -821,42 +832,57 @@ tb_long_t tb_stream_read(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     tb_long_t read = 0;
     do
     {
-        if (tb_queue_buffer_maxn(&stream->cache))
+        if (stream->mdata)
+        {
+            // copy data from the mapping directly
+            tb_size_t left = stream->offset < stream->msize? stream->msize - (tb_size_t)stream->offset : 0;
+            read = (tb_long_t)tb_min(size, left);
+            if (read) tb_memcpy(data, stream->mdata + (tb_size_t)stream->offset, read);
+        }
+        else if (stream->cache_maxn)
         {
             // switch to the read cache mode
-            if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
+            if (stream->bwrited && tb_iobuf_null(&stream->cache)) stream->bwrited = 0;
 
             // check the cache mode, must be read cache
             tb_assert_and_check_return_val(!stream->bwrited, -1);
 
             // read data from cache first
-            read = tb_queue_buffer_read(&stream->cache, data, size);
+            read = tb_iobuf_read(&stream->cache, data, size);
             tb_check_return_val(read >= 0, -1);
 
             // ok?
             tb_check_break(!read);
 
             // cache is null now.
-            tb_assert_and_check_return_val(tb_queue_buffer_null(&stream->cache), -1);
+            tb_assert_and_check_return_val(tb_iobuf_null(&stream->cache), -1);
+
+            // the reading size is larger than the cache? read it directly instead of copying it twice
+            if (size >= stream->cache_maxn)
+            {
+                read = stream->read(self, data, size);
+                tb_check_return_val(read >= 0, -1);
+                break;
+            }
 
             // enter cache for push
             tb_size_t   push = 0;
-            tb_byte_t*  tail = tb_queue_buffer_push_init(&stream->cache, &push);
+            tb_byte_t*  tail = tb_iobuf_push_init(&stream->cache, &push);
             tb_assert_and_check_return_val(tail && push, -1);
 
             // push data to cache from self
             tb_assert(stream->read);
             tb_long_t   real = stream->read(self, tail, push);
+
+            // leave cache for push
+            tb_iobuf_push_exit(&stream->cache, real > 0? real : 0);
             tb_check_return_val(real >= 0, -1);
 
             // read the left data from cache
             if (real > 0)
             {
-                // leave cache for push
-                tb_queue_buffer_push_exit(&stream->cache, real);
-
                 // read cache
-                real = tb_queue_buffer_read(&stream->cache, data + read, tb_min(real, size - read));
+                real = tb_iobuf_read(&stream->cache, data + read, tb_min(real, size - read));
                 tb_check_return_val(real >= 0, -1);
 
                 // save read
@@ -894,27 +920,28 @@ tb_long_t tb_stream_writ(tb_stream_ref_t self, tb_byte_t const* data, tb_size_t
     tb_long_t writ = 0;
     do
     {
-        if (tb_queue_buffer_maxn(&stream->cache))
+        if (stream->cache_maxn)
         {
             // switch to the writ cache mode
-            if (!stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 1;
+            if (!stream->bwrited && tb_iobuf_null(&stream->cache)) stream->bwrited = 1;
 
             // check the cache mode, must be writ cache
             tb_assert_and_check_return_val(stream->bwrited, -1);
 
             // writ data to cache first
-            writ = tb_queue_buffer_writ(&stream->cache, data, size);
-            tb_check_return_val(writ >= 0, -1);
+            tb_size_t cached_size = tb_iobuf_size(&stream->cache);
+            if (cached_size < stream->cache_maxn)
+            {
+                writ = tb_iobuf_writ(&stream->cache, data, tb_min(size, stream->cache_maxn - cached_size));
+                tb_check_return_val(writ >= 0, -1);
+            }
 
             // ok?
             tb_check_break(!writ);
 
-            // cache is full now.
-            tb_assert_and_check_return_val(tb_queue_buffer_full(&stream->cache), -1);
-
-            // enter cache for pull
+            // enter cache for pull, the cache is full now
             tb_size_t   pull = 0;
-            tb_byte_t*  head = tb_queue_buffer_pull_init(&stream->cache, &pull);
+            tb_byte_t*  head = tb_iobuf_pull_init(&stream->cache, &pull);
             tb_assert_and_check_return_val(head && pull, -1);
 
             // pull data to self from cache
@@ -925,10 +952,10 @@ tb_long_t tb_stream_writ(tb_stream_ref_t self, tb_byte_t const* data, tb_size_t
             if (real > 0)
             {
                 // leave cache for pull
-                tb_queue_buffer_pull_exit(&stream->cache, real);
+                tb_iobuf_pull_exit(&stream->cache, real);
 
                 // writ cache
-                real = tb_queue_buffer_writ(&stream->cache, data + writ, tb_min(real, size - writ));
+                real = tb_iobuf_writ(&stream->cache, data + writ, tb_min(real, size - writ));
                 tb_check_return_val(real >= 0, -1);
 
                 // save writ
@@ -958,7 +985,7 @@ tb_bool_t tb_stream_bread(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     tb_check_return_val(size, tb_true);
 
     // have writed cache? sync first
-    if (stream->bwrited && !tb_queue_buffer_null(&stream->cache) && !tb_stream_sync(self, tb_false))
+    if (stream->bwrited && !tb_iobuf_null(&stream->cache) && !tb_stream_sync(self, tb_false))
         return tb_false;
 
     // check the left
@@ -1024,6 +1051,188 @@ tb_bool_t tb_stream_bwrit(tb_stream_ref_t self, tb_byte_t const* data, tb_size_t
     // ok?
     return (writ == size? tb_true : tb_false);
 }
+tb_long_t tb_stream_read_iobuf(tb_stream_ref_t self, tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(iobuf, -1);
+
+    // no size?
+    tb_check_return_val(size, 0);
+
+    // check self
+    tb_assert_and_check_return_val(stream && tb_stream_is_opened(self) && stream->read, -1);
+
+    // done
+    tb_long_t read = 0;
+    do
+    {
+        if (stream->mdata)
+        {
+            // copy data from the mapping
+            tb_size_t left = stream->offset < stream->msize? stream->msize - (tb_size_t)stream->offset : 0;
+            if (left) read = tb_iobuf_writ(iobuf, stream->mdata + (tb_size_t)stream->offset, tb_min(size, left));
+            tb_check_return_val(read >= 0, -1);
+            break;
+        }
+
+        // has cached data?
+        if (stream->cache_maxn)
+        {
+            // switch to the read cache mode
+            if (stream->bwrited && tb_iobuf_null(&stream->cache)) stream->bwrited = 0;
+
+            // check the cache mode, must be read cache
+            tb_assert_and_check_return_val(!stream->bwrited, -1);
+
+            // move the cached slices to the iobuf first, it has been peeked and the data will not be copied
+            tb_size_t cached_size = tb_iobuf_size(&stream->cache);
+            if (cached_size)
+            {
+                read = tb_min(cached_size, size);
+                tb_check_return_val(tb_iobuf_split(&stream->cache, read, iobuf), -1);
+                break;
+            }
+        }
+
+        // enter the tail block of the iobuf
+        tb_size_t   push = 0;
+        tb_byte_t*  tail = tb_iobuf_push_init(iobuf, &push);
+        tb_assert_and_check_return_val(tail && push, -1);
+
+        // read data to the iobuf directly
+        read = stream->read(self, tail, tb_min(push, size));
+
+        // leave the tail block
+        tb_iobuf_push_exit(iobuf, read > 0? read : 0);
+        tb_check_return_val(read >= 0, -1);
+
+    } while (0);
+
+    // update offset
+    stream->offset += read;
+
+    // ok
+    return read;
+}
+tb_long_t tb_stream_writ_iobuf(tb_stream_ref_t self, tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(iobuf, -1);
+
+    // no data?
+    tb_check_return_val(!tb_iobuf_null(iobuf), 0);
+
+    // check self
+    tb_assert_and_check_return_val(stream && tb_stream_is_opened(self) && stream->writ, -1);
+
+    // the cache has the writed data? writ the slices to it for keeping the order
+    tb_bool_t cached = stream->cache_maxn && !tb_iobuf_null(&stream->cache);
+
+    // writ the head slices
+    tb_long_t writ = 0;
+    while (!tb_iobuf_null(iobuf))
+    {
+        // enter the head slice
+        tb_size_t   pull = 0;
+        tb_byte_t*  head = tb_iobuf_pull_init(iobuf, &pull);
+        tb_assert_and_check_break(head && pull);
+
+        // writ it
+        tb_long_t real = -1;
+        if (cached) real = tb_stream_writ(self, head, pull);
+        else
+        {
+            real = stream->writ(self, head, pull);
+            if (real > 0) stream->offset += real;
+        }
+
+        // failed?
+        if (real < 0)
+        {
+            if (!writ) writ = -1;
+            break;
+        }
+
+        // leave the head slice
+        if (real) tb_iobuf_pull_exit(iobuf, real);
+        writ += real;
+
+        // no more space?
+        tb_check_break(real == pull);
+    }
+
+    // ok
+    return writ;
+}
+tb_bool_t tb_stream_bread_iobuf(tb_stream_ref_t self, tb_iobuf_ref_t iobuf, tb_size_t size)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(stream && iobuf, tb_false);
+
+    // check the left
+    tb_hize_t left = tb_stream_left(self);
+    tb_check_return_val(size <= left, tb_false);
+
+    // read data to the iobuf
+    tb_size_t read = 0;
+    while (read < size && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
+    {
+        // read data
+        tb_long_t real = tb_stream_read_iobuf(self, iobuf, size - read);
+        if (real > 0) read += real;
+        else if (!real)
+        {
+            // wait
+            real = tb_stream_wait(self, TB_STREAM_WAIT_READ, tb_stream_timeout(self));
+            tb_check_break(real > 0);
+
+            // has read?
+            tb_assert_and_check_break(real & TB_STREAM_WAIT_READ);
+        }
+        else break;
+    }
+
+    // killed? save state
+    if (read != size && !stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
+        stream->state = TB_STATE_KILLED;
+
+    // ok?
+    return (read == size? tb_true : tb_false);
+}
+tb_bool_t tb_stream_bwrit_iobuf(tb_stream_ref_t self, tb_iobuf_ref_t iobuf)
+{
+    // check
+    tb_stream_t* stream = tb_stream_cast(self);
+    tb_assert_and_check_return_val(stream && iobuf, tb_false);
+
+    // writ the iobuf data
+    while (!tb_iobuf_null(iobuf) && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
+    {
+        // writ data
+        tb_long_t real = tb_stream_writ_iobuf(self, iobuf);
+        if (real > 0) continue;
+        else if (!real)
+        {
+            // wait
+            real = tb_stream_wait(self, TB_STREAM_WAIT_WRIT, tb_stream_timeout(self));
+            tb_check_break(real > 0);
+
+            // has writ?
+            tb_assert_and_check_break(real & TB_STREAM_WAIT_WRIT);
+        }
+        else break;
+    }
+
+    // killed? save state
+    if (!tb_iobuf_null(iobuf) && !stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
+        stream->state = TB_STATE_KILLED;
+
+    // ok?
+    return tb_iobuf_null(iobuf);
+}
 tb_bool_t tb_stream_sync(tb_stream_ref_t self, tb_bool_t bclosing)
 {
     // check
@@ -1034,31 +1243,30 @@ tb_bool_t tb_stream_sync(tb_stream_ref_t self, tb_bool_t bclosing)
     tb_assert_and_check_return_val((TB_STATE_OPENED == tb_atomic32_get(&stream->istate)), tb_false);
 
     // cached? sync cache first
-    if (tb_queue_buffer_maxn(&stream->cache))
+    if (stream->cache_maxn)
     {
         // have data?
-        if (!tb_queue_buffer_null(&stream->cache))
+        if (!tb_iobuf_null(&stream->cache))
         {
             // check: must be writed cache
             tb_assert_and_check_return_val(stream->bwrited, tb_false);
 
-            // enter cache for pull
-            tb_size_t   size = 0;
-            tb_byte_t*  head = tb_queue_buffer_pull_init(&stream->cache, &size);
-            tb_assert_and_check_return_val(head && size, tb_false);
-
             // writ cache data to self
-            tb_size_t   writ = 0;
-            while (writ < size && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
+            while (!tb_iobuf_null(&stream->cache) && (TB_STATE_OPENED == tb_atomic32_get(&stream->istate)))
             {
+                // enter cache for pull
+                tb_size_t   size = 0;
+                tb_byte_t*  head = tb_iobuf_pull_init(&stream->cache, &size);
+                tb_assert_and_check_break(head && size);
+
                 // writ
-                tb_long_t real = stream->writ(self, head + writ, size - writ);
+                tb_long_t real = stream->writ(self, head, size);
 
                 // ok?
                 if (real > 0)
                 {
-                    // save writ
-                    writ += real;
+                    // leave cache for pull
+                    tb_iobuf_pull_exit(&stream->cache, real);
                 }
                 // no data?
                 else if (!real)
@@ -1073,11 +1281,8 @@ tb_bool_t tb_stream_sync(tb_stream_ref_t self, tb_bool_t bclosing)
                 else break;
             }
 
-            // leave cache for pull
-            tb_queue_buffer_pull_exit(&stream->cache, writ);
-
             // cache be not cleared?
-            if (!tb_queue_buffer_null(&stream->cache))
+            if (!tb_iobuf_null(&stream->cache))
             {
                 // killed? save state
                 if (!stream->state && (TB_STATE_KILLING == tb_atomic32_get(&stream->istate)))
@@ -1117,7 +1322,7 @@ tb_bool_t tb_stream_seek(tb_stream_ref_t self, tb_hize_t offset)
     if (stream->bwrited)
     {
         // check cache, must not cache or empty cache
-        tb_assert_and_check_return_val(!tb_queue_buffer_maxn(&stream->cache) || tb_queue_buffer_null(&stream->cache), tb_false);
+        tb_assert_and_check_return_val(!stream->cache_maxn || tb_iobuf_null(&stream->cache), tb_false);
 
         // seek it
         tb_bool_t ok = stream->seek? stream->seek(self, offset) : tb_false;
@@ -1128,16 +1333,24 @@ tb_bool_t tb_stream_seek(tb_stream_ref_t self, tb_hize_t offset)
     // for reading
     else
     {
-        // cached? try to seek it at the cache
+        // mapped? only update the offset
         tb_bool_t ok = tb_false;
-        if (tb_queue_buffer_maxn(&stream->cache))
+        if (stream->mdata)
         {
-            tb_size_t   pull = 0;
-            tb_byte_t*  data = tb_queue_buffer_pull_init(&stream->cache, &pull);
-            if (data && pull && offset > curt && offset <= curt + pull)
+            // save offset
+            stream->offset = tb_min(offset, stream->msize);
+
+            // ok
+            ok = tb_true;
+        }
+        // cached? try to seek it at the cache
+        else if (stream->cache_maxn)
+        {
+            tb_size_t cached_size = tb_iobuf_size(&stream->cache);
+            if (cached_size && offset > curt && offset <= curt + cached_size)
             {
                 // seek it at the cache
-                tb_queue_buffer_pull_exit(&stream->cache, (tb_size_t)(offset - curt));
+                tb_iobuf_skip(&stream->cache, (tb_size_t)(offset - curt));
 
                 // save offset
                 stream->offset = offset;
@@ -1161,7 +1374,7 @@ tb_bool_t tb_stream_seek(tb_stream_ref_t self, tb_hize_t offset)
                 stream->offset = offset;
 
                 // clear cache
-                tb_queue_buffer_clear(&stream->cache);
+                tb_iobuf_clear(&stream->cache);
             }
         }
 
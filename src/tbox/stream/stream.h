@@ -650,6 +650,46 @@ tb_bool_t               tb_stream_bread(tb_stream_ref_t stream, tb_byte_t* data,
  */
 tb_bool_t               tb_stream_bwrit(tb_stream_ref_t stream, tb_byte_t const* data, tb_size_t size);
 
+/*! read data to the tail of the iobuf, non-blocking
+ *
+ * the data will be read to the free space of the iobuf blocks directly without the stream cache.
+ *
+ * @param stream        the stream
+ * @param iobuf         the iobuf
+ * @param size          the maximum size
+ *
+ * @return              the real size or -1
+ */
+tb_long_t               tb_stream_read_iobuf(tb_stream_ref_t stream, tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! writ the iobuf data and remove the writed data from it, non-blocking
+ *
+ * @param stream        the stream
+ * @param iobuf         the iobuf
+ *
+ * @return              the real size or -1
+ */
+tb_long_t               tb_stream_writ_iobuf(tb_stream_ref_t stream, tb_iobuf_ref_t iobuf);
+
+/*! block read data to the tail of the iobuf
+ *
+ * @param stream        the stream
+ * @param iobuf         the iobuf
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_stream_bread_iobuf(tb_stream_ref_t stream, tb_iobuf_ref_t iobuf, tb_size_t size);
+
+/*! block writ all data of the iobuf
+ *
+ * @param stream        the stream
+ * @param iobuf         the iobuf
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_stream_bwrit_iobuf(tb_stream_ref_t stream, tb_iobuf_ref_t iobuf);
+
 /*! sync stream
  *
  * @param stream        the stream
@@ -663,6 +703,9 @@ tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosin
  *
  * @note it will not update offset, if you want to use block mode, please use tb_stream_peek()
  *
+ * if the file stream is mapped by TB_STREAM_CTRL_FILE_MMAP, the returned data points to the mapping directly
+ * without copying it, so it must not be modified.
+ *
  * @code
 
     // need 16-bytes data
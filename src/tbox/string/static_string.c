@@ -289,9 +289,10 @@ tb_char_t const* tb_static_string_cstrncpy(tb_static_string_ref_t string, tb_cha
     // check
     tb_assert_and_check_return_val(string && s && n, tb_null);
 
-    // done
-    tb_char_t* p = (tb_char_t*)tb_static_buffer_memncpy(string, (tb_byte_t const*)s, n + 1);
-    if (p) p[tb_static_string_size(string)] = '\0';
+    // copy it and append '\0', we cannot read s[n] because s may be not terminated
+    tb_char_t* p = (tb_char_t*)tb_static_buffer_memncpy(string, (tb_byte_t const*)s, n);
+    if (p) p = (tb_char_t*)tb_static_buffer_resize(string, n + 1);
+    if (p) p[n] = '\0';
     return p;
 }
 tb_char_t const* tb_static_string_cstrfcpy(tb_static_string_ref_t string, tb_char_t const* fmt, ...)
@@ -345,9 +346,11 @@ tb_char_t const* tb_static_string_cstrncat(tb_static_string_ref_t string, tb_cha
     // check
     tb_assert_and_check_return_val(string && s && n, tb_null);
 
-    // done
-    tb_char_t* p = (tb_char_t*)tb_static_buffer_memncpyp(string, tb_static_string_size(string), (tb_byte_t const*)s, n + 1);
-    if (p) p[tb_static_string_size(string)] = '\0';
+    // append it and '\0', we cannot read s[n] because s may be not terminated
+    tb_size_t   size = tb_static_string_size(string);
+    tb_char_t*  p = (tb_char_t*)tb_static_buffer_memncpyp(string, size, (tb_byte_t const*)s, n);
+    if (p) p = (tb_char_t*)tb_static_buffer_resize(string, size + n + 1);
+    if (p) p[size + n] = '\0';
     return p;
 }
 tb_char_t const* tb_static_string_cstrfcat(tb_static_string_ref_t string, tb_char_t const* fmt, ...)
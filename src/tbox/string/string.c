@@ -291,8 +291,10 @@ tb_char_t const* tb_string_cstrncpy(tb_string_ref_t string, tb_char_t const* s,
     tb_assert_and_check_return_val(string && s, tb_null);
     tb_check_return_val(n, tb_string_cstr(string));
 
-    tb_char_t* p = (tb_char_t*)tb_buffer_memncpy(string, (tb_byte_t const*)s, n + 1);
-    if (p) p[tb_string_size(string)] = '\0';
+    // copy it and append '\0', we cannot read s[n] because s may be not terminated
+    tb_char_t* p = (tb_char_t*)tb_buffer_memncpy(string, (tb_byte_t const*)s, n);
+    if (p) p = (tb_char_t*)tb_buffer_resize(string, n + 1);
+    if (p) p[n] = '\0';
     return p;
 }
 tb_char_t const* tb_string_cstrfcpy(tb_string_ref_t string, tb_char_t const* fmt, ...)
@@ -349,9 +351,11 @@ tb_char_t const* tb_string_cstrncat(tb_string_ref_t string, tb_char_t const* s,
     tb_assert_and_check_return_val(string && s, tb_null);
     tb_check_return_val(n, tb_string_cstr(string));
 
-    // done
-    tb_char_t* p = (tb_char_t*)tb_buffer_memncpyp(string, tb_string_size(string), (tb_byte_t const*)s, n + 1);
-    if (p) p[tb_string_size(string)] = '\0';
+    // append it and '\0', we cannot read s[n] because s may be not terminated
+    tb_size_t   size = tb_string_size(string);
+    tb_char_t*  p = (tb_char_t*)tb_buffer_memncpyp(string, size, (tb_byte_t const*)s, n);
+    if (p) p = (tb_char_t*)tb_buffer_resize(string, size + n + 1);
+    if (p) p[size + n] = '\0';
     return p;
 }
 tb_char_t const* tb_string_cstrfcat(tb_string_ref_t string, tb_char_t const* fmt, ...)
@@ -27,6 +27,7 @@
 #include "prefix.h"
 #include "zip/zip.h"
 #include "xml/xml.h"
+#include "json/json.h"
 #include "libm/libm.h"
 #include "libc/libc.h"
 #include "math/math.h"
@@ -50,13 +50,14 @@ target("tbox")
     add_options("info", "float", "wchar", "exception", "force-utf8", "deprecated")
 
     -- add modules
-    add_options("xml", "zip", "hash", "regex", "coroutine", "object", "charset", "database")
+    add_options("xml", "json", "zip", "hash", "regex", "coroutine", "object", "charset", "database")
 
     -- add the common source files
     add_files("*.c")
-    add_files("hash/bkdr.c", "hash/fnv32.c", "hash/adler32.c")
+    add_files("hash/bkdr.c", "hash/fnv32.c", "hash/adler32.c", "hash/wyhash.c")
     add_files("math/**.c")
     add_files("libc/**.c|string/impl/**.c")
+    add_files("libc/string/impl/x86/simd.c")
     add_files("utils/*.c|option.c")
     add_files("prefix/**.c")
     add_files("memory/**.c")
@@ -79,6 +80,9 @@ target("tbox")
     -- add the source files for the xml module
     if has_config("xml") then add_files("xml/**.c") end
 
+    -- add the source files for the json module
+    if has_config("json") then add_files("json/**.c") end
+
     -- add the source files for the regex module
     if has_config("regex") then add_files("regex/*.c") end
 
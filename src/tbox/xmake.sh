@@ -31,12 +31,14 @@ target "tbox"
     add_files "hash/bkdr.c"
     add_files "hash/fnv32.c"
     add_files "hash/adler32.c"
+    add_files "hash/wyhash.c"
     add_files "math/**.c"
     add_files "libc/misc/*.c"
     add_files "libc/misc/time/*.c"
     add_files "libc/stdio/*.c"
     add_files "libc/stdlib/*.c"
     add_files "libc/string/*.c"
+    add_files "libc/string/impl/x86/simd.c"
     add_files "libc/impl/*.c"
     add_files "utils/base32.c"
     add_files "utils/base64.c"
@@ -57,6 +59,7 @@ target "tbox"
     add_files "network/*.c"
     add_files "network/impl/*.c"
     add_files "network/impl/http/*.c"
+    add_files "network/impl/dns/*.c"
     add_files "network/dns/*.c"
     add_files "algorithm/**.c"
     add_files "container/*.c"
@@ -87,6 +90,7 @@ target "tbox"
     add_files "platform/event.c"
     add_files "platform/file.c"
     add_files "platform/filelock.c"
+    add_files "platform/filemap.c"
     add_files "platform/fwatcher.c"
     add_files "platform/hostname.c"
     add_files "platform/ifaddrs.c"
@@ -167,6 +171,11 @@ target "tbox"
         add_files "xml/**.c"
     fi
 
+    # add the source files for the json module
+    if has_config "json"; then
+        add_files "json/**.c"
+    fi
+
     # add the source files for the regex module
     if has_config "regex"; then
         add_files "regex/*.c"
@@ -214,6 +223,7 @@ target "tbox"
         add_files "object/impl/writer/json.c"
         add_files "object/impl/writer/bplist.c"
         add_files "object/impl/writer/writer.c"
+        add_files "object/impl/writer/buffer.c"
         add_files "utils/option.c"
         add_files "container/element/obj.c"
         if has_config "xml"; then
@@ -241,8 +241,12 @@ tb_bool_t tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream,
         // init the reader stream
         impl->rstream = stream;
 
-        // open the reader stream if be not opened
-        if (!tb_stream_is_opened(impl->rstream) && !tb_stream_open(impl->rstream)) break;
+        // open the reader stream if be not opened, we will peek the file data from the mapping directly
+        if (!tb_stream_is_opened(impl->rstream))
+        {
+            if (tb_stream_type(impl->rstream) == TB_STREAM_TYPE_FILE) tb_stream_ctrl(impl->rstream, TB_STREAM_CTRL_FILE_MMAP, tb_true);
+            if (!tb_stream_open(impl->rstream)) break;
+        }
 
         // clear text
         tb_string_clear(&impl->text);
@@ -94,7 +94,7 @@ option("force-utf8")
 option_end()
 
 -- add modules
-for _, name in ipairs({"xml", "zip", "hash", "regex", "object", "charset", "database", "coroutine"}) do
+for _, name in ipairs({"xml", "json", "zip", "hash", "regex", "object", "charset", "database", "coroutine"}) do
     option(name)
         set_default(true)
         set_showmenu(true)
@@ -94,7 +94,7 @@ basic_options
 
 # we disable all modules by default, but we can use `./configure --hash=y` to enable it
 module_options() {
-    local modules="xml zip hash regex object charset database coroutine"
+    local modules="xml json zip hash regex object charset database coroutine"
     for name in ${modules}; do
         string_toupper "${name}"; local name_upper="${_ret}"
         option "${name}" "The ${name} module" false
@@ -279,6 +279,11 @@ check_interfaces() {
 
     # add the interfaces for linux
     check_module_cfuncs "linux" "sys/inotify.h" "inotify_init"
+    check_module_csnippets "linux_io_uring_setup" "TB_CONFIG_LINUX_HAVE_IO_URING_SETUP" \
+        "#include <linux/io_uring.h>\n
+         #include <sys/syscall.h>\n
+         #include <unistd.h>\n
+         void test() {struct io_uring_getevents_arg arg; syscall(__NR_io_uring_setup, IORING_POLL_ADD_MULTI, &arg);}"
 
     # add the interfaces for sigsetjmp
     check_module_csnippets "libc_sigsetjmp" "TB_CONFIG_LIBC_HAVE_SIGSETJMP" \
@@ -269,6 +269,7 @@ function _check_interfaces(target)
     -- add the interfaces for linux
     if target:is_plat("linux", "android") then
         _check_module_cfuncs(target, "linux", {"sys/inotify.h"}, "inotify_init")
+        _check_module_cfuncs(target, "linux", {"linux/io_uring.h", "sys/syscall.h", "unistd.h"}, "io_uring_setup{struct io_uring_getevents_arg arg; syscall(__NR_io_uring_setup, IORING_POLL_ADD_MULTI, &arg);}")
     end
 
     -- add the interfaces for valgrind